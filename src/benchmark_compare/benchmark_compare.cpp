@@ -0,0 +1,419 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark_compare.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <numbers>
+#include <numeric>
+#include <ranges>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+/** Largest sample size for which the exact Mann-Whitney distribution is used */
+constexpr size_t kExactSampleLimit = 20;
+
+/** Bytes in a MiB, memory is displayed in MiB */
+constexpr double kBytesPerMiB = 1024.0 * 1024.0;
+
+/** Image metrics written by the image metrics render technique where higher values are better */
+bool IsHigherBetter(string_view const metric)
+{
+    return metric == "PSNR" || metric == "SSIM";
+}
+
+/** Used for timings where lower values are always better */
+bool IsNeverHigherBetter(string_view const /*metric*/)
+{
+    return false;
+}
+
+double Mean(vector<double> const &values) noexcept
+{
+    return values.empty()
+             ? 0.0
+             : accumulate(values.cbegin(), values.cend(), 0.0) / static_cast<double>(values.size());
+}
+
+double Median(vector<double> values)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    auto const middle = values.begin() + static_cast<ptrdiff_t>(values.size() / 2);
+    ranges::nth_element(values, middle);
+    double ret = *middle;
+    if (values.size() % 2 == 0)
+    {
+        ret = (ret + *max_element(values.begin(), middle)) * 0.5;
+    }
+    return ret;
+}
+
+/**
+ * Get the probability of a Mann-Whitney U statistic at least as large as the one observed.
+ * @param higherCount Size of the sample the statistic counts wins for.
+ * @param lowerCount  Size of the other sample.
+ * @param u           The observed statistic (number of pairs where the first sample is larger).
+ * @return The p-value.
+ */
+double ExactUpperTail(size_t const higherCount, size_t const lowerCount, size_t const u)
+{
+    // counts[m][n][u] is the number of orderings of m and n values giving statistic u, built using the
+    // recurrence on whether the largest value belongs to the first (adds n wins) or the second sample
+    vector<vector<vector<double>>> counts(higherCount + 1, vector<vector<double>>(lowerCount + 1));
+    for (size_t m = 0; m <= higherCount; ++m)
+    {
+        for (size_t n = 0; n <= lowerCount; ++n)
+        {
+            auto &current = counts[m][n];
+            current.assign(m * n + 1, 0.0);
+            if (m == 0 || n == 0)
+            {
+                current[0] = 1.0;
+                continue;
+            }
+            for (size_t i = 0; i < counts[m][n - 1].size(); ++i)
+            {
+                current[i] += counts[m][n - 1][i];
+            }
+            for (size_t i = 0; i < counts[m - 1][n].size(); ++i)
+            {
+                current[i + n] += counts[m - 1][n][i];
+            }
+        }
+    }
+    auto const  &distribution = counts[higherCount][lowerCount];
+    double const total        = accumulate(distribution.cbegin(), distribution.cend(), 0.0);
+    auto const   first        = distribution.cbegin() + static_cast<ptrdiff_t>(min(u, distribution.size()));
+    double const tail         = accumulate(first, distribution.cend(), 0.0);
+    return tail / total;
+}
+
+/** Relative change of a value, positive if it got worse */
+double RelativeChange(double const baseline, double const current, bool const higherIsBetter) noexcept
+{
+    double change = 0.0;
+    if (baseline != 0.0)
+    {
+        change = (current - baseline) / fabs(baseline);
+    }
+    else if (current != 0.0)
+    {
+        change = copysign(numeric_limits<double>::infinity(), current);
+    }
+    return higherIsBetter ? -change : change;
+}
+
+/**
+ * Compare a metric, using a Mann-Whitney test on the samples to check any change beyond the tolerance is
+ * significant.
+ * @note If the samples are too small to ever be significant then only the tolerance is used.
+ */
+MetricComparison CompareSamples(string name, string unit, vector<double> const &baselineSamples,
+    vector<double> const &currentSamples, double const baseline, double const current,
+    bool const higherIsBetter, double const tolerance, double const alpha)
+{
+    MetricComparison ret {
+        .name = std::move(name), .unit = std::move(unit), .baseline = baseline, .current = current};
+    bool const   testable = MannWhitneyMinimumPValue(baselineSamples.size(), currentSamples.size()) < alpha;
+    double const change   = RelativeChange(baseline, current, higherIsBetter);
+    if (change > tolerance)
+    {
+        if (testable)
+        {
+            ret.pValue = higherIsBetter ? MannWhitneyTest(currentSamples, baselineSamples)
+                                        : MannWhitneyTest(baselineSamples, currentSamples);
+        }
+        ret.status = !testable || ret.pValue < alpha ? CompareStatus::Regressed : CompareStatus::Unchanged;
+    }
+    else if (change < -tolerance)
+    {
+        if (testable)
+        {
+            ret.pValue = higherIsBetter ? MannWhitneyTest(baselineSamples, currentSamples)
+                                        : MannWhitneyTest(currentSamples, baselineSamples);
+        }
+        ret.status = !testable || ret.pValue < alpha ? CompareStatus::Improved : CompareStatus::Unchanged;
+    }
+    return ret;
+}
+
+/** Compare a single value of each result against a relative tolerance */
+MetricComparison CompareValues(string name, string unit, double const baseline, double const current,
+    bool const higherIsBetter, double const tolerance)
+{
+    return CompareSamples(
+        std::move(name), std::move(unit), {}, {}, baseline, current, higherIsBetter, tolerance, 0.0);
+}
+
+/** Compare samples of metrics that may only exist in one of the results */
+void CompareSampleSets(string_view const prefix, string_view const unit,
+    map<string, pair<vector<double>, vector<double>>> const &samples, bool (*isHigherBetter)(string_view),
+    double const tolerance, double const alpha, double const minimum, vector<MetricComparison> &comparisons)
+{
+    for (auto const &[name, values] : samples)
+    {
+        auto const &[baselineSamples, currentSamples] = values;
+        double const baseline                         = Mean(baselineSamples);
+        double const current                          = Mean(currentSamples);
+        if (!baselineSamples.empty() && !currentSamples.empty() && max(baseline, current) < minimum)
+        {
+            continue;
+        }
+        auto comparison = CompareSamples(string(prefix) + name, string(unit), baselineSamples, currentSamples,
+            baseline, current, isHigherBetter(name), tolerance, alpha);
+        if (baselineSamples.empty())
+        {
+            comparison.status = CompareStatus::Added;
+        }
+        else if (currentSamples.empty())
+        {
+            comparison.status = CompareStatus::Removed;
+        }
+        comparisons.push_back(std::move(comparison));
+    }
+}
+
+/** Get the peak memory usage over all repetitions */
+BenchmarkMemory GetPeakMemory(BenchmarkResult const &result, string const &owner)
+{
+    BenchmarkMemory ret;
+    for (auto const &repetition : result.repetitions)
+    {
+        BenchmarkMemory const *usage = &repetition.memory;
+        if (!owner.empty())
+        {
+            auto const found = repetition.memoryOwners.find(owner);
+            if (found == repetition.memoryOwners.cend())
+            {
+                continue;
+            }
+            usage = &found->second;
+        }
+        ret.gpuPeakBytes = max(ret.gpuPeakBytes, usage->gpuPeakBytes);
+        ret.cpuPeakBytes = max(ret.cpuPeakBytes, usage->cpuPeakBytes);
+    }
+    return ret;
+}
+} // unnamed namespace
+
+double MannWhitneyTest(vector<double> const &lower, vector<double> const &higher)
+{
+    if (lower.empty() || higher.empty())
+    {
+        return 1.0;
+    }
+
+    // Rank the combined samples, tied values all receive the average of their ranks
+    vector<pair<double, bool>> combined; // Value and whether it belongs to the higher sample
+    combined.reserve(lower.size() + higher.size());
+    for (double const value : lower)
+    {
+        combined.emplace_back(value, false);
+    }
+    for (double const value : higher)
+    {
+        combined.emplace_back(value, true);
+    }
+    ranges::sort(combined);
+    double rankSum       = 0.0;
+    double tieCorrection = 0.0;
+    for (size_t i = 0; i < combined.size();)
+    {
+        size_t j = i + 1;
+        while (j < combined.size() && combined[j].first == combined[i].first)
+        {
+            ++j;
+        }
+        double const rank = static_cast<double>(i + 1 + j) * 0.5;
+        for (size_t k = i; k < j; ++k)
+        {
+            rankSum += combined[k].second ? rank : 0.0;
+        }
+        auto const ties = static_cast<double>(j - i);
+        tieCorrection += ties * ties * ties - ties;
+        i = j;
+    }
+    auto const   lowerCount  = static_cast<double>(lower.size());
+    auto const   higherCount = static_cast<double>(higher.size());
+    double const u           = rankSum - higherCount * (higherCount + 1.0) * 0.5;
+
+    if (tieCorrection == 0.0 && lower.size() <= kExactSampleLimit && higher.size() <= kExactSampleLimit)
+    {
+        return ExactUpperTail(higher.size(), lower.size(), static_cast<size_t>(lround(u)));
+    }
+
+    // Normal approximation with tie and continuity correction
+    double const count    = lowerCount + higherCount;
+    double const variance =
+        lowerCount * higherCount / 12.0 * ((count + 1.0) - tieCorrection / (count * (count - 1.0)));
+    if (variance <= 0.0)
+    {
+        // All values are identical
+        return 1.0;
+    }
+    double const z = (u - lowerCount * higherCount * 0.5 - 0.5) / sqrt(variance);
+    return 0.5 * erfc(z / numbers::sqrt2);
+}
+
+double MannWhitneyMinimumPValue(size_t const lowerCount, size_t const higherCount) noexcept
+{
+    // The most extreme ordering is one of C(n1 + n2, n1) equally likely orderings
+    auto const n1 = static_cast<double>(lowerCount);
+    auto const n2 = static_cast<double>(higherCount);
+    return exp(lgamma(n1 + 1.0) + lgamma(n2 + 1.0) - lgamma(n1 + n2 + 1.0));
+}
+
+vector<MetricComparison> CompareResults(
+    BenchmarkResult const &baseline, BenchmarkResult const &current, CompareTolerances const &tolerances)
+{
+    vector<MetricComparison> ret;
+
+    // Frame times of every frame are pooled over all repetitions
+    vector<double> baselineFrames;
+    vector<double> currentFrames;
+    for (auto const &repetition : baseline.repetitions)
+    {
+        ranges::copy(repetition.frameTimes, back_inserter(baselineFrames));
+    }
+    for (auto const &repetition : current.repetitions)
+    {
+        ranges::copy(repetition.frameTimes, back_inserter(currentFrames));
+    }
+    ret.push_back(CompareSamples("Frame time (median)", "ms", baselineFrames, currentFrames,
+        Median(baselineFrames), Median(currentFrames), false, tolerances.frameTime, tolerances.alpha));
+
+    // Per-pass GPU times are only available as the mean of each repetition
+    map<string, pair<vector<double>, vector<double>>> passes;
+    for (auto const &repetition : baseline.repetitions)
+    {
+        for (auto const &[name, timing] : repetition.timestamps)
+        {
+            passes[name].first.push_back(timing.mean);
+        }
+    }
+    for (auto const &repetition : current.repetitions)
+    {
+        for (auto const &[name, timing] : repetition.timestamps)
+        {
+            passes[name].second.push_back(timing.mean);
+        }
+    }
+    CompareSampleSets("GPU ", "ms", passes, IsNeverHigherBetter, tolerances.gpuTime, tolerances.alpha,
+        tolerances.minimumGpuTime, ret);
+
+    // Memory is deterministic so only the peak over all repetitions is compared
+    map<string, int> owners = {
+        {"", 0}
+    };
+    for (auto const *result : {&baseline, &current})
+    {
+        for (auto const &repetition : result->repetitions)
+        {
+            for (auto const &owner : repetition.memoryOwners | views::keys)
+            {
+                owners[owner] |= result == &baseline ? 1 : 2;
+            }
+        }
+    }
+    for (auto const &[owner, presence] : owners)
+    {
+        auto const   baselineMemory = GetPeakMemory(baseline, owner);
+        auto const   currentMemory  = GetPeakMemory(current, owner);
+        string const name           = owner.empty() ? "Total" : owner;
+        for (auto const &[type, baselineBytes, currentBytes] :
+            {tuple("GPU", baselineMemory.gpuPeakBytes, currentMemory.gpuPeakBytes),
+                tuple("CPU", baselineMemory.cpuPeakBytes, currentMemory.cpuPeakBytes)})
+        {
+            if (baselineBytes == 0 && currentBytes == 0)
+            {
+                continue;
+            }
+            auto comparison = CompareValues(string("Memory ") + type + " peak (" + name + ")", "MiB",
+                static_cast<double>(baselineBytes) / kBytesPerMiB,
+                static_cast<double>(currentBytes) / kBytesPerMiB, false, tolerances.memory);
+            if (presence == 2)
+            {
+                comparison.status = CompareStatus::Added;
+            }
+            else if (presence == 1)
+            {
+                comparison.status = CompareStatus::Removed;
+            }
+            ret.push_back(std::move(comparison));
+        }
+    }
+
+    // Image metrics are stored as the mean over all measured frames
+    map<string, pair<vector<double>, vector<double>>> metrics;
+    for (auto const &[name, value] : baseline.imageMetrics)
+    {
+        metrics[name].first.push_back(value);
+    }
+    for (auto const &[name, value] : current.imageMetrics)
+    {
+        metrics[name].second.push_back(value);
+    }
+    CompareSampleSets("Image ", "", metrics, IsHigherBetter, tolerances.imageQuality, tolerances.alpha,
+        -numeric_limits<double>::infinity(), ret);
+    return ret;
+}
+
+bool CompareImageMetricsFiles(filesystem::path const &baselineFile, filesystem::path const &currentFile,
+    CompareTolerances const &tolerances, vector<MetricComparison> &comparisons)
+{
+    vector<pair<string, vector<double>>> baselineMetrics;
+    vector<pair<string, vector<double>>> currentMetrics;
+    uint32_t                             baselineFrames = 0;
+    uint32_t                             currentFrames  = 0;
+    if (!ReadImageMetrics(baselineFile, baselineMetrics, baselineFrames)
+        || !ReadImageMetrics(currentFile, currentMetrics, currentFrames))
+    {
+        return false;
+    }
+    for (auto const &[name, baselineValues] : baselineMetrics)
+    {
+        auto const currentValues =
+            ranges::find_if(currentMetrics, [&name](auto const &metric) { return metric.first == name; });
+        if (currentValues == currentMetrics.cend())
+        {
+            continue;
+        }
+        bool const higherIsBetter = IsHigherBetter(name);
+        // Each frame is treated as a sample
+        comparisons.push_back(CompareSamples("Image " + name, "", baselineValues, currentValues->second,
+            Mean(baselineValues), Mean(currentValues->second), higherIsBetter, tolerances.imageQuality,
+            tolerances.alpha));
+    }
+    return true;
+}
@@ -0,0 +1,102 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "benchmark_suite.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/** Outcome of comparing a single metric between baseline and current results. */
+enum class CompareStatus : uint8_t
+{
+    Unchanged, /**< Difference within tolerance or not statistically significant */
+    Improved,
+    Regressed,
+    Added,   /**< Only present in the current results */
+    Removed, /**< Only present in the baseline results */
+};
+
+/** Thresholds used to decide whether a change is a regression. */
+struct CompareTolerances
+{
+    double alpha          = 0.01; /**< Significance level of statistical tests */
+    double frameTime      = 0.05; /**< Allowed relative increase in median frame time */
+    double gpuTime        = 0.05; /**< Allowed relative increase in mean GPU time of each pass */
+    double memory         = 0.01; /**< Allowed relative increase in peak memory */
+    double imageQuality   = 0.01; /**< Allowed relative worsening of each image metric */
+    double minimumGpuTime = 0.05; /**< GPU passes faster than this (ms) in both results are not compared */
+};
+
+/** Result of comparing a single metric. */
+struct MetricComparison
+{
+    std::string   name;     /**< Metric name */
+    std::string   unit;     /**< Unit the values are displayed in */
+    double        baseline = 0.0;
+    double        current  = 0.0;
+    double        pValue   = -1.0; /**< P-value of the change, negative if no statistical test was used */
+    CompareStatus status   = CompareStatus::Unchanged;
+};
+
+/**
+ * One-sided Mann-Whitney U test that values in a sample are stochastically greater than another.
+ * @note Uses the exact distribution for small samples without ties and the normal approximation (with tie
+ * and continuity correction) otherwise.
+ * @param lower  Sample expected to have the lower values under the alternative hypothesis.
+ * @param higher Sample expected to have the higher values under the alternative hypothesis.
+ * @return The p-value, 1 if either sample is empty.
+ */
+[[nodiscard]] double MannWhitneyTest(std::vector<double> const &lower, std::vector<double> const &higher);
+
+/**
+ * Get the smallest p-value a Mann-Whitney test can produce for the given sample sizes.
+ * @param lowerCount  Size of the first sample.
+ * @param higherCount Size of the second sample.
+ * @return The p-value.
+ */
+[[nodiscard]] double MannWhitneyMinimumPValue(size_t lowerCount, size_t higherCount) noexcept;
+
+/**
+ * Compare frame time, per-pass GPU time, memory and image metrics of two benchmark results.
+ * @param baseline   The baseline results.
+ * @param current    The results to check for regressions.
+ * @param tolerances The regression thresholds.
+ * @return The comparison of each metric.
+ */
+[[nodiscard]] std::vector<MetricComparison> CompareResults(
+    BenchmarkResult const &baseline, BenchmarkResult const &current, CompareTolerances const &tolerances);
+
+/**
+ * Compare two image metrics CSV files as written by the image metrics render technique.
+ * @note Each frame of a file is treated as a sample of each metric.
+ * @param      baselineFile The baseline CSV file.
+ * @param      currentFile  The CSV file to check for regressions.
+ * @param      tolerances   The regression thresholds.
+ * @param [out] comparisons  The comparison of each metric.
+ * @return True if successful, False if either file could not be read.
+ */
+[[nodiscard]] bool CompareImageMetricsFiles(std::filesystem::path const &baselineFile,
+    std::filesystem::path const &currentFile, CompareTolerances const &tolerances,
+    std::vector<MetricComparison> &comparisons);
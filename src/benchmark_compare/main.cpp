@@ -0,0 +1,228 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark_compare.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+char const *GetStatusName(CompareStatus const status) noexcept
+{
+    switch (status)
+    {
+    case CompareStatus::Improved: return "improved";
+    case CompareStatus::Regressed: return "REGRESSED";
+    case CompareStatus::Added: return "added";
+    case CompareStatus::Removed: return "removed";
+    case CompareStatus::Unchanged: [[fallthrough]];
+    default: return "ok";
+    }
+}
+
+/**
+ * Prints a table of comparisons.
+ * @param title       Name of the compared results.
+ * @param comparisons The comparison of each metric.
+ * @param printAll    True to print every metric, otherwise only those that changed.
+ * @return The number of regressed metrics.
+ */
+uint32_t PrintComparisons(
+    string const &title, vector<MetricComparison> const &comparisons, bool const printAll)
+{
+    uint32_t regressions = 0;
+    bool     printTitle  = true;
+    for (auto const &comparison : comparisons)
+    {
+        regressions += comparison.status == CompareStatus::Regressed ? 1 : 0;
+        if (!printAll && comparison.status == CompareStatus::Unchanged)
+        {
+            continue;
+        }
+        if (printTitle)
+        {
+            cout << title << '\n';
+            printTitle = false;
+        }
+        string change = "new";
+        if (comparison.baseline != 0.0)
+        {
+            array<char, 32> buffer {};
+            snprintf(buffer.data(), buffer.size(), "%+.2f%%",
+                (comparison.current - comparison.baseline) / fabs(comparison.baseline) * 100.0);
+            change = buffer.data();
+        }
+        string pValue;
+        if (comparison.pValue >= 0.0)
+        {
+            array<char, 32> buffer {};
+            snprintf(buffer.data(), buffer.size(), "p=%.3g", comparison.pValue);
+            pValue = buffer.data();
+        }
+        array<char, 256> line {};
+        snprintf(line.data(), line.size(), "  %-9s  %-40s %12.4f -> %12.4f %-3s  %9s  %s\n",
+            GetStatusName(comparison.status), comparison.name.c_str(), comparison.baseline,
+            comparison.current, comparison.unit.c_str(), change.c_str(), pValue.c_str());
+        cout << line.data();
+    }
+    return regressions;
+}
+
+/**
+ * Warns if two results were measured using different settings.
+ * @param baseline The baseline results.
+ * @param current  The current results.
+ */
+void CheckConfiguration(BenchmarkResult const &baseline, BenchmarkResult const &current)
+{
+    if (baseline.frames != current.frames || baseline.configuration.width != current.configuration.width
+        || baseline.configuration.height != current.configuration.height
+        || baseline.configuration.renderer != current.configuration.renderer)
+    {
+        cerr << "Warning: Comparing results of different benchmark configurations: "
+             << baseline.configuration.getName() << " vs " << current.configuration.getName() << endl;
+    }
+}
+} // unnamed namespace
+
+int main(int argc, char **argv)
+{
+    CLI::App app {"Capsaicin - Benchmark Compare"};
+    app.footer("Exit code is 0 if there are no regressions, 1 if any metric regressed or a baseline result "
+               "is missing and 2 on error.");
+
+    filesystem::path baselinePath;
+    filesystem::path currentPath;
+    app.add_option("baseline", baselinePath,
+           "Baseline benchmark suite results (.json), results directory or image metrics file (.csv)")
+        ->required()
+        ->check(CLI::ExistingPath);
+    app.add_option("current", currentPath, "Results to check for regressions, must match the baseline type")
+        ->required()
+        ->check(CLI::ExistingPath);
+    CompareTolerances tolerances;
+    double            frameTimeTolerance    = tolerances.frameTime * 100.0;
+    double            gpuTimeTolerance      = tolerances.gpuTime * 100.0;
+    double            memoryTolerance       = tolerances.memory * 100.0;
+    double            imageQualityTolerance = tolerances.imageQuality * 100.0;
+    app.add_option("--alpha", tolerances.alpha, "Significance level of the Mann-Whitney tests")
+        ->check(CLI::Range(0.0, 1.0))
+        ->capture_default_str();
+    app.add_option("--frame-time-tolerance", frameTimeTolerance, "Allowed increase in median frame time (%)")
+        ->check(CLI::NonNegativeNumber)
+        ->capture_default_str();
+    app.add_option("--gpu-time-tolerance", gpuTimeTolerance, "Allowed increase in GPU time of each pass (%)")
+        ->check(CLI::NonNegativeNumber)
+        ->capture_default_str();
+    app.add_option("--memory-tolerance", memoryTolerance, "Allowed increase in peak memory (%)")
+        ->check(CLI::NonNegativeNumber)
+        ->capture_default_str();
+    app.add_option("--image-tolerance", imageQualityTolerance, "Allowed worsening of each image metric (%)")
+        ->check(CLI::NonNegativeNumber)
+        ->capture_default_str();
+    app.add_option("--min-gpu-time", tolerances.minimumGpuTime,
+           "GPU passes shorter than this (ms) are ignored as their timings are dominated by noise")
+        ->check(CLI::NonNegativeNumber)
+        ->capture_default_str();
+    bool printAll = false;
+    app.add_flag("--all", printAll, "Print every compared metric instead of only those that changed");
+
+    CLI11_PARSE(app, argc, argv);
+    tolerances.frameTime    = frameTimeTolerance / 100.0;
+    tolerances.gpuTime      = gpuTimeTolerance / 100.0;
+    tolerances.memory       = memoryTolerance / 100.0;
+    tolerances.imageQuality = imageQualityTolerance / 100.0;
+
+    // Pair up the files to compare, directories are matched by file name
+    vector<pair<filesystem::path, filesystem::path>> files;
+    uint32_t                                         failures = 0;
+    if (is_directory(baselinePath) && is_directory(currentPath))
+    {
+        for (auto const &entry : filesystem::directory_iterator(baselinePath))
+        {
+            if (entry.path().extension() != ".json")
+            {
+                continue;
+            }
+            filesystem::path const currentFile = currentPath / entry.path().filename();
+            if (!exists(currentFile))
+            {
+                cout << "Missing results: " << currentFile.string() << '\n';
+                ++failures;
+                continue;
+            }
+            files.emplace_back(entry.path(), currentFile);
+        }
+        ranges::sort(files);
+    }
+    else if (is_regular_file(baselinePath) && is_regular_file(currentPath)
+             && baselinePath.extension() == currentPath.extension())
+    {
+        files.emplace_back(baselinePath, currentPath);
+    }
+    else
+    {
+        cerr << "Baseline and current results must both be directories or files of the same type" << endl;
+        return 2;
+    }
+
+    for (auto const &[baselineFile, currentFile] : files)
+    {
+        vector<MetricComparison> comparisons;
+        if (baselineFile.extension() == ".csv")
+        {
+            if (!CompareImageMetricsFiles(baselineFile, currentFile, tolerances, comparisons))
+            {
+                cerr << "Failed to read image metrics: " << baselineFile.string() << ", "
+                     << currentFile.string() << endl;
+                return 2;
+            }
+        }
+        else
+        {
+            BenchmarkResult baseline;
+            BenchmarkResult current;
+            string          error;
+            if (!BenchmarkResult::Load(baselineFile, baseline, error)
+                || !BenchmarkResult::Load(currentFile, current, error))
+            {
+                cerr << "Failed to load benchmark results: " << error << endl;
+                return 2;
+            }
+            CheckConfiguration(baseline, current);
+            comparisons = CompareResults(baseline, current, tolerances);
+        }
+        failures += PrintComparisons(baselineFile.filename().string(), comparisons, printAll);
+    }
+
+    cout << files.size() << " result(s) compared, " << failures << " regression(s)" << endl;
+    return failures > 0 ? 1 : 0;
+}
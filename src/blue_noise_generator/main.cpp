@@ -0,0 +1,469 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "blue_noise_tables.h"
+#include "task_scheduler.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/** Number of random Heaviside integrands used to compare pixel estimates */
+constexpr uint32_t kTestIntegrandCount = 64;
+
+/** Radius of the toroidal pixel neighbourhood used to evaluate the energy of each pixel */
+constexpr int32_t kNeighbourhoodRadius = 4;
+
+/** Spatial and sample space standard deviations of the energy function (Georgiev and Fajardo 2016) */
+constexpr float kSigmaImage  = 2.1F;
+constexpr float kSigmaSample = 1.0F;
+
+struct Settings
+{
+    uint32_t tileSize           = 128;
+    uint32_t sampleCount        = 256;
+    uint32_t dimensionCount     = 256;
+    uint32_t tileDimensionCount = 8;
+    uint32_t samplesPerPixel    = 1;  /**< Number of samples each pixel estimate is optimised for */
+    uint32_t iterations         = 32; /**< Number of swap passes over each tile */
+    uint32_t seed               = 0;
+};
+
+/** A Heaviside step integrand over [0,1)^2, 1 on the side of the line where (x,y).normal < offset */
+struct Heaviside
+{
+    float normalX = 1.0F;
+    float normalY = 0.0F;
+    float offset  = 0.0F;
+};
+
+uint32_t Hash(uint32_t value) noexcept
+{
+    // https://nullprogram.com/blog/2018/07/31/ (lowbias32)
+    value ^= value >> 16;
+    value *= 0x7FEB352DU;
+    value ^= value >> 15;
+    value *= 0x846CA68BU;
+    value ^= value >> 16;
+    return value;
+}
+
+/**
+ * Multiplies 2 polynomials over GF(2) modulo another.
+ * @param a, b    The polynomials to multiply (each bit is a coefficient), of lower degree than the modulus.
+ * @param modulus The modulus polynomial.
+ * @param degree  Degree of the modulus polynomial.
+ * @return The product.
+ */
+uint64_t MultiplyModulo(uint64_t a, uint64_t b, uint64_t const modulus, uint32_t const degree) noexcept
+{
+    uint64_t ret = 0;
+    for (; b != 0; b >>= 1)
+    {
+        if ((b & 1) != 0)
+        {
+            ret ^= a;
+        }
+        a <<= 1;
+        if (((a >> degree) & 1) != 0)
+        {
+            a ^= modulus;
+        }
+    }
+    return ret;
+}
+
+/** Calculates x^power modulo a polynomial over GF(2). */
+uint64_t PowerModulo(uint64_t power, uint64_t const modulus, uint32_t const degree) noexcept
+{
+    uint64_t ret  = 1;
+    uint64_t base = degree > 1 ? 2 : 2 ^ modulus;
+    for (; power != 0; power >>= 1)
+    {
+        if ((power & 1) != 0)
+        {
+            ret = MultiplyModulo(ret, base, modulus, degree);
+        }
+        base = MultiplyModulo(base, base, modulus, degree);
+    }
+    return ret;
+}
+
+/** Checks if a polynomial over GF(2) is primitive, i.e. x has order 2^degree-1 modulo the polynomial. */
+bool IsPrimitive(uint64_t const polynomial, uint32_t const degree) noexcept
+{
+    if ((polynomial & 1) == 0)
+    {
+        return false;
+    }
+    uint64_t const order = (uint64_t {1} << degree) - 1;
+    if (PowerModulo(order, polynomial, degree) != 1)
+    {
+        return false;
+    }
+    uint64_t remaining = order;
+    for (uint64_t factor = 2; factor * factor <= remaining; ++factor)
+    {
+        if (remaining % factor != 0)
+        {
+            continue;
+        }
+        if (PowerModulo(order / factor, polynomial, degree) == 1)
+        {
+            return false;
+        }
+        while (remaining % factor == 0)
+        {
+            remaining /= factor;
+        }
+    }
+    return remaining == 1 || remaining == order || PowerModulo(order / remaining, polynomial, degree) != 1;
+}
+
+/**
+ * Generates the Owen scrambled Sobol sequence.
+ * Dimensions beyond the first use primitive polynomials in order of increasing degree with random odd
+ * initial direction numbers, each dimension is then scrambled with a hash based nested uniform scramble.
+ * @param settings The generator settings.
+ * @param tables   The tables to fill.
+ */
+void GenerateSobol(Settings const &settings, BlueNoiseTables &tables)
+{
+    uint32_t const bitCount = tables.getValueBits();
+    mt19937        random(settings.seed);
+    tables.sobol.resize(static_cast<size_t>(settings.sampleCount) * settings.dimensionCount);
+
+    array<uint32_t, 32> directions {};
+    uint32_t            degree     = 1;
+    uint64_t            polynomial = (uint64_t {1} << degree) | 1;
+    for (uint32_t dimension = 0; dimension < settings.dimensionCount; ++dimension)
+    {
+        if (dimension == 0)
+        {
+            // Van der Corput sequence
+            for (uint32_t i = 0; i < 32; ++i)
+            {
+                directions[i] = 1U << (31 - i);
+            }
+        }
+        else
+        {
+            while (!IsPrimitive(polynomial, degree))
+            {
+                polynomial += 2;
+                if ((polynomial >> (degree + 1)) != 0)
+                {
+                    ++degree;
+                    polynomial = (uint64_t {1} << degree) | 1;
+                }
+            }
+            // Initial direction numbers m_k are random odd values less than 2^k
+            array<uint32_t, 32> m {};
+            for (uint32_t k = 0; k < min(degree, 32U); ++k)
+            {
+                m[k] = (random() & ((2U << k) - 1)) | 1U;
+            }
+            for (uint32_t k = degree; k < 32; ++k)
+            {
+                m[k] = m[k - degree] ^ (m[k - degree] << degree);
+                for (uint32_t j = 1; j < degree; ++j)
+                {
+                    if (((polynomial >> (degree - j)) & 1) != 0)
+                    {
+                        m[k] ^= m[k - j] << j;
+                    }
+                }
+            }
+            for (uint32_t k = 0; k < 32; ++k)
+            {
+                directions[k] = m[k] << (31 - k);
+            }
+            polynomial += 2;
+        }
+
+        uint32_t const scrambleSeed = random();
+        for (uint32_t sample = 0; sample < settings.sampleCount; ++sample)
+        {
+            uint32_t value = 0;
+            for (uint32_t bit = 0; sample >> bit != 0; ++bit)
+            {
+                value ^= ((sample >> bit) & 1) != 0 ? directions[bit] : 0;
+            }
+            // Flip each bit based on a hash of all more significant bits
+            uint32_t flip = 0;
+            for (uint32_t bit = 0; bit < bitCount; ++bit)
+            {
+                uint32_t const prefix = bit == 0 ? 0 : value >> (32 - bit);
+                flip |= (Hash(prefix ^ Hash(scrambleSeed + bit)) & 1) << (31 - bit);
+            }
+            tables.sobol[static_cast<size_t>(sample) * settings.dimensionCount + dimension] =
+                (value ^ flip) >> (32 - bitCount);
+        }
+    }
+}
+
+/**
+ * Optimises the scrambling keys of a group of 1 or 2 tile dimensions so that the error of each pixel's
+ * estimate is distributed as blue noise in screen space (Heitz et al. 2019).
+ * Keys are swapped between nearby pixels whenever this reduces the energy of both pixels.
+ * @param settings  The generator settings.
+ * @param dimension The first tile dimension of the group.
+ * @param group     Number of dimensions in the group (1 or 2).
+ * @param tables    The tables to update.
+ * @return The energy before and after optimisation.
+ */
+pair<double, double> OptimiseScrambling(
+    Settings const &settings, uint32_t const dimension, uint32_t const group, BlueNoiseTables &tables)
+{
+    uint32_t const tileSize   = settings.tileSize;
+    uint32_t const pixelCount = tileSize * tileSize;
+    float const    scale      = 1.0F / static_cast<float>(settings.sampleCount);
+    mt19937        random(Hash(settings.seed ^ Hash(dimension)));
+
+    array<Heaviside, kTestIntegrandCount> integrands;
+    uniform_real_distribution<float>      uniform(0.0F, 1.0F);
+    for (auto &integrand : integrands)
+    {
+        float const angle = uniform(random) * 6.28318530718F;
+        float const x     = uniform(random);
+        float const y     = uniform(random);
+        integrand.normalX = group == 1 ? 1.0F : cos(angle);
+        integrand.normalY = group == 1 ? 0.0F : sin(angle);
+        integrand.offset  = integrand.normalX * x + integrand.normalY * y;
+    }
+
+    // Estimates only depend on a pixel's keys so are swapped along with them
+    auto const getKey = [&](uint32_t const pixel, uint32_t const offset) -> uint32_t & {
+        size_t const index = static_cast<size_t>(pixel) * settings.tileDimensionCount + dimension + offset;
+        return tables.scramblingTile[index];
+    };
+    vector<float> estimates(static_cast<size_t>(pixelCount) * kTestIntegrandCount);
+    for (uint32_t pixel = 0; pixel < pixelCount; ++pixel)
+    {
+        float *estimate = &estimates[static_cast<size_t>(pixel) * kTestIntegrandCount];
+        for (uint32_t sample = 0; sample < settings.samplesPerPixel; ++sample)
+        {
+            size_t const row = static_cast<size_t>(sample) * settings.dimensionCount + dimension;
+            uint32_t const valueX = tables.sobol[row] ^ getKey(pixel, 0);
+            uint32_t const valueY = group == 1 ? 0 : tables.sobol[row + 1] ^ getKey(pixel, 1);
+            float const    x      = (0.5F + static_cast<float>(valueX)) * scale;
+            float const    y      = group == 1 ? 0.0F : (0.5F + static_cast<float>(valueY)) * scale;
+            for (uint32_t i = 0; i < kTestIntegrandCount; ++i)
+            {
+                auto const &integrand = integrands[i];
+                bool const  inside    = x * integrand.normalX + y * integrand.normalY < integrand.offset;
+                estimate[i] += inside ? 1.0F : 0.0F;
+            }
+        }
+        for (uint32_t i = 0; i < kTestIntegrandCount; ++i)
+        {
+            estimate[i] /= static_cast<float>(settings.samplesPerPixel);
+        }
+    }
+
+    constexpr int32_t                   kDiameter = 2 * kNeighbourhoodRadius + 1;
+    array<float, kDiameter * kDiameter> spatialWeights {};
+    for (int32_t y = -kNeighbourhoodRadius; y <= kNeighbourhoodRadius; ++y)
+    {
+        for (int32_t x = -kNeighbourhoodRadius; x <= kNeighbourhoodRadius; ++x)
+        {
+            spatialWeights[(y + kNeighbourhoodRadius) * kDiameter + x + kNeighbourhoodRadius] =
+                exp(-static_cast<float>(x * x + y * y) / (kSigmaImage * kSigmaImage));
+        }
+    }
+    auto const wrap = [tileSize](int32_t const value) {
+        return static_cast<uint32_t>(value) & (tileSize - 1);
+    };
+    // Energy between a pixel (using the estimate of another pixel) and all its neighbours
+    auto const getEnergy = [&](uint32_t const pixel, uint32_t const estimatePixel) {
+        float const *estimate = &estimates[static_cast<size_t>(estimatePixel) * kTestIntegrandCount];
+        auto const   px       = static_cast<int32_t>(pixel % tileSize);
+        auto const   py       = static_cast<int32_t>(pixel / tileSize);
+        float        energy   = 0.0F;
+        for (int32_t y = -kNeighbourhoodRadius; y <= kNeighbourhoodRadius; ++y)
+        {
+            for (int32_t x = -kNeighbourhoodRadius; x <= kNeighbourhoodRadius; ++x)
+            {
+                uint32_t const neighbour = wrap(px + x) + wrap(py + y) * tileSize;
+                if (neighbour == pixel)
+                {
+                    continue;
+                }
+                float const *other =
+                    &estimates[static_cast<size_t>(neighbour == estimatePixel ? pixel : neighbour)
+                               * kTestIntegrandCount];
+                float distance = 0.0F;
+                for (uint32_t i = 0; i < kTestIntegrandCount; ++i)
+                {
+                    distance += (estimate[i] - other[i]) * (estimate[i] - other[i]);
+                }
+                distance /= static_cast<float>(kTestIntegrandCount) * kSigmaSample * kSigmaSample;
+                energy += spatialWeights[(y + kNeighbourhoodRadius) * kDiameter + x + kNeighbourhoodRadius]
+                        * exp(-distance);
+            }
+        }
+        return energy;
+    };
+    auto const getTotalEnergy = [&] {
+        double energy = 0.0;
+        for (uint32_t pixel = 0; pixel < pixelCount; ++pixel)
+        {
+            energy += getEnergy(pixel, pixel);
+        }
+        return energy;
+    };
+
+    double const                      initialEnergy = getTotalEnergy();
+    vector<uint32_t>                  order(pixelCount);
+    uniform_int_distribution<int32_t> offset(-kNeighbourhoodRadius, kNeighbourhoodRadius);
+    iota(order.begin(), order.end(), 0U);
+    for (uint32_t iteration = 0; iteration < settings.iterations; ++iteration)
+    {
+        shuffle(order.begin(), order.end(), random);
+        for (uint32_t const pixel : order)
+        {
+            int32_t const  x     = static_cast<int32_t>(pixel % tileSize) + offset(random);
+            int32_t const  y     = static_cast<int32_t>(pixel / tileSize) + offset(random);
+            uint32_t const other = wrap(x) + wrap(y) * tileSize;
+            if (other == pixel)
+            {
+                continue;
+            }
+            // The energy between the 2 pixels themselves is unchanged by a swap so is ignored
+            float const current = getEnergy(pixel, pixel) + getEnergy(other, other);
+            float const swapped = getEnergy(pixel, other) + getEnergy(other, pixel);
+            if (swapped < current)
+            {
+                swap_ranges(&estimates[static_cast<size_t>(pixel) * kTestIntegrandCount],
+                    &estimates[static_cast<size_t>(pixel + 1) * kTestIntegrandCount],
+                    &estimates[static_cast<size_t>(other) * kTestIntegrandCount]);
+                for (uint32_t i = 0; i < group; ++i)
+                {
+                    swap(getKey(pixel, i), getKey(other, i));
+                }
+            }
+        }
+    }
+    return {initialEnergy, getTotalEnergy()};
+}
+} // unnamed namespace
+
+int main(int argc, char **argv)
+{
+    CLI::App app {"Capsaicin - Blue Noise Generator"};
+
+    Settings         settings;
+    filesystem::path outputPath = "blue_noise_sampler_samples.bin";
+    app.add_option("--output", outputPath, "File to write the generated tables to")->capture_default_str();
+    app.add_option("--tile-size", settings.tileSize, "Width and height of the screen space tile (power of 2)")
+        ->capture_default_str();
+    app.add_option("--samples", settings.sampleCount, "Number of samples in the sequence (power of 2)")
+        ->capture_default_str();
+    app.add_option(
+           "--dimensions", settings.dimensionCount, "Number of dimensions in the sequence (power of 2)")
+        ->capture_default_str();
+    app.add_option("--tile-dimensions", settings.tileDimensionCount,
+           "Number of dimensions optimised in screen space, consecutive pairs are optimised as 2D")
+        ->capture_default_str();
+    app.add_option("--spp", settings.samplesPerPixel, "Number of samples per pixel to optimise for")
+        ->capture_default_str();
+    app.add_option("--iterations", settings.iterations, "Number of optimisation passes over each tile")
+        ->capture_default_str();
+    app.add_option("--seed", settings.seed, "Random seed")->capture_default_str();
+    bool compress = false;
+    app.add_flag("--compress", compress, "Run-length encode tables where this reduces their size");
+    uint32_t workerThreads = ~0U;
+    app.add_option("--worker-threads", workerThreads,
+        "Number of task scheduler worker threads (default based on hardware concurrency)");
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (!has_single_bit(settings.tileSize) || !has_single_bit(settings.sampleCount)
+        || !has_single_bit(settings.dimensionCount) || settings.tileDimensionCount == 0
+        || settings.tileDimensionCount > settings.dimensionCount || settings.samplesPerPixel == 0
+        || settings.samplesPerPixel > settings.sampleCount)
+    {
+        cerr << "Invalid settings: sizes must be powers of 2, tile dimensions must not exceed dimensions and "
+                "samples per pixel must not exceed samples"
+             << endl;
+        return 1;
+    }
+
+    auto const      start = chrono::steady_clock::now();
+    BlueNoiseTables tables;
+    tables.sampleCount        = settings.sampleCount;
+    tables.dimensionCount     = settings.dimensionCount;
+    tables.tileSize           = settings.tileSize;
+    tables.tileDimensionCount = settings.tileDimensionCount;
+    GenerateSobol(settings, tables);
+
+    // Ranking keys are only required when optimising progressive sample counts, all pixels use the same
+    // sample order so that the first samples of every pixel form the optimised estimate
+    size_t const tileValueCount =
+        static_cast<size_t>(settings.tileSize) * settings.tileSize * settings.tileDimensionCount;
+    tables.rankingTile.assign(tileValueCount, 0);
+    tables.scramblingTile.resize(tileValueCount);
+    mt19937 random(settings.seed);
+    ranges::generate(tables.scramblingTile, [&] { return random() & (settings.sampleCount - 1); });
+
+    // Each group of dimensions is independent so groups are optimised in parallel
+    uint32_t const               groupCount = (settings.tileDimensionCount + 1) / 2;
+    vector<pair<double, double>> energies(groupCount);
+    TaskScheduler::Get().setWorkerCount(workerThreads, false);
+    TaskScheduler::Get().parallelFor(
+        0U, groupCount,
+        [&](uint32_t const group) {
+            uint32_t const dimension = group * 2;
+            energies[group]          = OptimiseScrambling(
+                settings, dimension, min(2U, settings.tileDimensionCount - dimension), tables);
+        },
+        1);
+    TaskScheduler::Get().shutdown();
+    double const elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    for (uint32_t group = 0; group < groupCount; ++group)
+    {
+        cerr << "Dimensions " << group * 2 << "-" << min(group * 2 + 1, settings.tileDimensionCount - 1)
+             << ": energy " << energies[group].first << " -> " << energies[group].second << endl;
+    }
+    if (!tables.save(outputPath, compress))
+    {
+        cerr << "Failed to write output file: " << outputPath.string() << endl;
+        return 1;
+    }
+    cerr << "Generated " << outputPath.string() << " (" << filesystem::file_size(outputPath) << " bytes) in "
+         << elapsed << " s" << endl;
+    return 0;
+}
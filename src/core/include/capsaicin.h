@@ -22,11 +22,13 @@ THE SOFTWARE.
 #pragma once
 
 #include "capsaicin_export.h"
+#include "capsaicin_types.h"
 
 #include <filesystem>
 #include <gfx_imgui.h>
 #include <glm/glm.hpp>
 #include <map>
+#include <string>
 #include <string_view>
 #include <variant>
 
@@ -143,6 +145,32 @@ CAPSAICIN_EXPORT void SetSceneCameraFOV(float FOVY) noexcept;
  */
 CAPSAICIN_EXPORT void SetSceneCameraRange(glm::vec2 const &nearFar) noexcept;
 
+/**
+ * Starts recording the position, orientation, FOV and jitter of the active camera each rendered frame.
+ * @note Any previously recorded or playing camera path is discarded.
+ */
+CAPSAICIN_EXPORT void StartCameraPathRecording() noexcept;
+
+/**
+ * Stops recording the camera path and saves it to disk.
+ * @param file_path Full pathname to the file to save as (.campath).
+ * @return True if successful, False otherwise.
+ */
+CAPSAICIN_EXPORT bool StopCameraPathRecording(std::filesystem::path const &file_path) noexcept;
+
+/**
+ * Plays back a recorded camera path, overriding the active camera each rendered frame.
+ * The path is interpolated so that it can be played back over a different number of frames than it was
+ * recorded with, recorded jitter is only replayed when the frame counts match.
+ * @param file_path   Full pathname to the camera path to load.
+ * @param frame_count Number of frames to play the path back over, 0 to use the recorded frame count.
+ * @return True if successful, False otherwise.
+ */
+CAPSAICIN_EXPORT bool PlayCameraPath(std::filesystem::path const &file_path, uint32_t frame_count) noexcept;
+
+/** Stops any currently playing camera path, the camera remains at its current position. */
+CAPSAICIN_EXPORT void StopCameraPath() noexcept;
+
 /**
  * Gets the currently set environment map.
  * @return The current environment map name.
@@ -212,6 +240,29 @@ CAPSAICIN_EXPORT double GetFrameTime() noexcept;
  */
 CAPSAICIN_EXPORT double GetAverageFrameTime() noexcept;
 
+/**
+ * Get statistics of all frame times recorded since the last reset.
+ * @return The frame time statistics.
+ */
+CAPSAICIN_EXPORT TimingStatistics GetFrameTimeStatistics() noexcept;
+
+/**
+ * Get statistics of each GPU timestamp recorded since the last reset.
+ * @return The statistics for each timestamp, nested timestamps are named 'parent/child'.
+ */
+CAPSAICIN_EXPORT std::map<std::string, TimingStatistics> GetTimestampStatistics() noexcept;
+
+/** Discard all currently recorded frame time and GPU timestamp statistics. */
+CAPSAICIN_EXPORT void ResetFrameStatistics() noexcept;
+
+/**
+ * Saves all currently recorded frame time and GPU timestamp statistics to disk.
+ * @param file_path Full pathname to the file to save as, a '.json' extension writes JSON otherwise CSV is
+ * used.
+ * @return True if successful, False otherwise.
+ */
+CAPSAICIN_EXPORT bool SaveFrameStatistics(std::filesystem::path const &file_path) noexcept;
+
 /**
  * Check if the current scene has any usable animations.
  * @return True if animations are present, False otherwise.
@@ -353,6 +404,23 @@ CAPSAICIN_EXPORT uint32_t GetTriangleCount() noexcept;
  */
 CAPSAICIN_EXPORT uint64_t GetBvhDataSize() noexcept;
 
+/**
+ * Gets the memory used by the buffers and textures allocated by each component and render technique.
+ * @note Resources created directly by Capsaicin are reported under 'Capsaicin', shared textures and buffers
+ * under 'Shared Resources' and scene data under 'Scene'.
+ * @return The memory usage for each owner.
+ */
+CAPSAICIN_EXPORT std::map<std::string, MemoryUsage> GetMemoryUsage() noexcept;
+
+/**
+ * Gets the combined memory used by all buffers and textures allocated by Capsaicin.
+ * @return The total memory usage.
+ */
+CAPSAICIN_EXPORT MemoryUsage GetTotalMemoryUsage() noexcept;
+
+/** Reset all memory usage high-water marks to the current memory usage. */
+CAPSAICIN_EXPORT void ResetMemoryPeaks() noexcept;
+
 /**
  * Gets the dimensions/resolution of the currently active window.
  * @return The window width and height.
@@ -454,6 +522,19 @@ CAPSAICIN_EXPORT void Terminate() noexcept;
  */
 CAPSAICIN_EXPORT void ReloadShaders() noexcept;
 
+/**
+ * Enable/disable automatic reloading of shaders whenever their source files are modified.
+ * @note Only the components/techniques using a modified file are re-initialised.
+ * @param enabled True to enable, False to disable.
+ */
+CAPSAICIN_EXPORT void SetShaderHotReload(bool enabled) noexcept;
+
+/**
+ * Check if shaders are automatically reloaded when their source files are modified.
+ * @return True if enabled, False otherwise.
+ */
+CAPSAICIN_EXPORT bool GetShaderHotReload() noexcept;
+
 /**
  * Saves an debug view to disk.
  * @param file_path Full pathname to the file to save as.
@@ -462,6 +543,17 @@ CAPSAICIN_EXPORT void ReloadShaders() noexcept;
 CAPSAICIN_EXPORT void DumpDebugView(
     std::filesystem::path const &file_path, std::string_view const &view) noexcept;
 
+/**
+ * Saves multiple AOVs to a single multi-layer EXR file.
+ * All AOVs are read back together and written as separate layers (e.g. 'Normal.R', 'Normal.G'...). The
+ * camera matrices ('worldToCamera', 'worldToNDC'), 'cameraJitter' and 'frameIndex' are stored in the header.
+ * @param file_path Full pathname to the file to save as (must have a .exr extension).
+ * @param aovs      The AOVs to save (get available from GetAOVs()), must have equal dimensions.
+ * @return True if successful, False otherwise.
+ */
+CAPSAICIN_EXPORT bool DumpAOVs(
+    std::filesystem::path const &file_path, std::vector<std::string_view> const &aovs) noexcept;
+
 /**
  * Saves current camera attributes to disk.
  * @param file_path   Full pathname to the file to save as.
@@ -469,4 +561,78 @@ CAPSAICIN_EXPORT void DumpDebugView(
  */
 CAPSAICIN_EXPORT void DumpCamera(std::filesystem::path const &file_path, bool jittered) noexcept;
 
+/**
+ * Waits for all pending debug view dumps to be written to disk.
+ * @note Dumps are written asynchronously, call before reading back any dumped files.
+ */
+CAPSAICIN_EXPORT void FlushDumps() noexcept;
+
+/**
+ * Opens a frame sequence file that subsequent AppendFrameSequence calls write to.
+ * Sequences store many frames in a single file and are intended for long benchmark captures.
+ * @param file_path Full pathname to the file to save as, .capseq for raw planar float16/uint8 frames with a
+ *                  frame index or .y4m for 8bit tone-mapped video.
+ * @return True if successful, False otherwise.
+ */
+CAPSAICIN_EXPORT bool OpenFrameSequence(std::filesystem::path const &file_path) noexcept;
+
+/**
+ * Appends the current contents of a debug view to the open frame sequence.
+ * @param view The debug view to save (get available from @GetDebugViews() or @GetAOVs()).
+ * @return True if successful, False otherwise.
+ */
+CAPSAICIN_EXPORT bool AppendFrameSequence(std::string_view const &view) noexcept;
+
+/** Writes all pending frames and closes the open frame sequence. */
+CAPSAICIN_EXPORT void CloseFrameSequence() noexcept;
+
+/**
+ * Sets the compression used for any subsequent EXR dumps.
+ * @param compression The compression type (default PIZ).
+ */
+CAPSAICIN_EXPORT void SetEXRCompression(EXRCompression compression) noexcept;
+
+/**
+ * Gets the compression used for EXR dumps.
+ * @return The compression type.
+ */
+CAPSAICIN_EXPORT EXRCompression GetEXRCompression() noexcept;
+
+/**
+ * Enable or disable recording of CPU and GPU profiling events.
+ * @note Has no effect if the library was built without CAPSAICIN_ENABLE_CPU_PROFILER.
+ * @param enable True to enable profiling.
+ */
+CAPSAICIN_EXPORT void SetProfilingEnabled(bool enable) noexcept;
+
+/**
+ * Check if profiling events are currently being recorded.
+ * @return True if enabled, False otherwise.
+ */
+CAPSAICIN_EXPORT bool GetProfilingEnabled() noexcept;
+
+/**
+ * Saves all recorded profiling events to disk.
+ * @note The output uses the Chrome trace event format and can be viewed using chrome://tracing or
+ * https://ui.perfetto.dev.
+ * @param file_path Full pathname to the file to save as.
+ * @return True if successful, False otherwise.
+ */
+CAPSAICIN_EXPORT bool DumpProfile(std::filesystem::path const &file_path) noexcept;
+
+/**
+ * Sets the number of worker threads used for parallel CPU work (scene updates, hashing and dumps).
+ * @note May be called before Initialize, must not be called while a frame is being rendered.
+ * @param worker_count Number of worker threads, ~0 to select based on hardware concurrency and 0 to execute
+ *  all work serially on the calling thread.
+ * @param pin_threads  (Optional) True to pin each worker thread to a separate logical processor.
+ */
+CAPSAICIN_EXPORT void SetWorkerThreads(uint32_t worker_count, bool pin_threads = false) noexcept;
+
+/**
+ * Gets the number of worker threads used for parallel CPU work.
+ * @return The worker count.
+ */
+CAPSAICIN_EXPORT uint32_t GetWorkerThreadCount() noexcept;
+
 } // namespace Capsaicin
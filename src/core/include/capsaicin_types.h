@@ -0,0 +1,61 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+
+// Plain data types shared with the host library, must not include gfx or glm
+namespace Capsaicin
+{
+/** Summary statistics of a timed value collected over multiple frames (all times in milliseconds). */
+struct TimingStatistics
+{
+    uint64_t count             = 0;   /**< Number of frames the value was recorded for */
+    double   mean              = 0.0; /**< Arithmetic mean */
+    double   standardDeviation = 0.0; /**< Sample standard deviation */
+    double   minimum           = 0.0; /**< Smallest recorded value */
+    double   maximum           = 0.0; /**< Largest recorded value */
+    double   p50               = 0.0; /**< Median (approximate, within 1% relative error) */
+    double   p90               = 0.0; /**< 90th percentile (approximate, within 1% relative error) */
+    double   p99               = 0.0; /**< 99th percentile (approximate, within 1% relative error) */
+    uint64_t stutterCount      = 0;   /**< Number of values more than double the recent moving average */
+};
+
+/** Memory used by a set of GPU resources. */
+struct MemoryUsage
+{
+    uint64_t gpuBytes        = 0; /**< Current device local memory (bytes) */
+    uint64_t gpuPeakBytes    = 0; /**< High-water mark of device local memory (bytes) */
+    uint64_t cpuBytes        = 0; /**< Current CPU visible upload/readback memory (bytes) */
+    uint64_t cpuPeakBytes    = 0; /**< High-water mark of CPU visible memory (bytes) */
+    uint32_t allocationCount = 0; /**< Number of currently allocated resources */
+};
+
+/** Compression used when saving EXR images. */
+enum class EXRCompression : uint8_t
+{
+    None,  /**< Uncompressed, fastest to write but largest files */
+    ZIP,   /**< Lossless deflate compression of 16 scanline blocks */
+    PIZ,   /**< Lossless wavelet compression, smallest lossless files for noisy HDR images */
+    Lossy, /**< ZIP compression with 32bit float channels reduced to 16bit half precision */
+};
+} // namespace Capsaicin
@@ -0,0 +1,125 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "async_writer.h"
+
+#include <algorithm>
+
+namespace Capsaicin
+{
+AsyncWriter::AsyncWriter(uint32_t const threadCountIn, uint32_t const maxQueuedIn) noexcept
+    : threadCount(
+          threadCountIn > 0 ? threadCountIn : std::clamp(std::thread::hardware_concurrency() / 2, 1U, 8U))
+    , maxQueued(maxQueuedIn > 0 ? maxQueuedIn : 2 * threadCount)
+{}
+
+AsyncWriter::~AsyncWriter() noexcept
+{
+    {
+        std::scoped_lock const scopedLock(lock);
+        stopping = true;
+    }
+    taskAdded.notify_all();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+std::future<void> AsyncWriter::push(std::function<void()> task) noexcept
+{
+    std::packaged_task<void()> packagedTask(std::move(task));
+    auto                       ret = packagedTask.get_future();
+    try
+    {
+        std::unique_lock uniqueLock(lock);
+        if (threads.empty())
+        {
+            startThreads();
+        }
+        taskRemoved.wait(uniqueLock, [this] { return tasks.size() < maxQueued; });
+        tasks.emplace_back(std::move(packagedTask));
+    }
+    catch (...)
+    {
+        // Fall back to executing on the calling thread if no worker is available
+        if (packagedTask.valid())
+        {
+            packagedTask();
+        }
+        return ret;
+    }
+    taskAdded.notify_one();
+    return ret;
+}
+
+void AsyncWriter::flush() noexcept
+{
+    try
+    {
+        std::unique_lock uniqueLock(lock);
+        taskRemoved.wait(uniqueLock, [this] { return tasks.empty() && activeCount == 0; });
+    }
+    catch (...)
+    {}
+}
+
+uint32_t AsyncWriter::getPendingCount() const noexcept
+{
+    std::scoped_lock const scopedLock(lock);
+    return static_cast<uint32_t>(tasks.size()) + activeCount;
+}
+
+void AsyncWriter::startThreads()
+{
+    threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(&AsyncWriter::workerLoop, this);
+    }
+}
+
+void AsyncWriter::workerLoop() noexcept
+{
+    std::unique_lock uniqueLock(lock);
+    while (true)
+    {
+        taskAdded.wait(uniqueLock, [this] { return stopping || !tasks.empty(); });
+        if (tasks.empty())
+        {
+            return; // only exit once all remaining tasks have been executed
+        }
+        auto task = std::move(tasks.front());
+        tasks.pop_front();
+        ++activeCount;
+        uniqueLock.unlock();
+        taskRemoved.notify_all();
+
+        // Exceptions are stored in the tasks future
+        task();
+
+        uniqueLock.lock();
+        --activeCount;
+        taskRemoved.notify_all();
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,89 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Bounded queue of tasks executed on a pool of dedicated worker threads.
+ * Used to move slow operations such as image encoding and file writes off the render thread. The queue
+ * applies back-pressure by blocking the producer whenever too many tasks are waiting.
+ */
+class AsyncWriter
+{
+public:
+    /**
+     * Constructor.
+     * @param threadCountIn (Optional) Number of worker threads, 0 to select based on hardware concurrency.
+     * @param maxQueuedIn   (Optional) Maximum number of waiting tasks before push blocks, 0 for 2x threads.
+     */
+    explicit AsyncWriter(uint32_t threadCountIn = 0, uint32_t maxQueuedIn = 0) noexcept;
+
+    /** Destructor, waits for all queued tasks to complete. */
+    ~AsyncWriter() noexcept;
+
+    AsyncWriter(AsyncWriter const &other)                = delete;
+    AsyncWriter(AsyncWriter &&other) noexcept            = delete;
+    AsyncWriter &operator=(AsyncWriter const &other)     = delete;
+    AsyncWriter &operator=(AsyncWriter &&other) noexcept = delete;
+
+    /**
+     * Queue a new task, blocks while the queue is full.
+     * @note Worker threads are created on first use.
+     * @param task The task to execute.
+     * @return Future that becomes ready once the task has completed.
+     */
+    std::future<void> push(std::function<void()> task) noexcept;
+
+    /** Wait until all queued and executing tasks have completed. */
+    void flush() noexcept;
+
+    /**
+     * Gets the number of tasks that are either waiting or executing.
+     * @return The task count.
+     */
+    [[nodiscard]] uint32_t getPendingCount() const noexcept;
+
+private:
+    void startThreads();
+    void workerLoop() noexcept;
+
+    mutable std::mutex                     lock;
+    std::condition_variable                taskAdded;   /**< Signalled when a task is queued or on exit */
+    std::condition_variable                taskRemoved; /**< Signalled when a task is taken or completed */
+    std::deque<std::packaged_task<void()>> tasks;
+    std::vector<std::thread>               threads;
+    uint32_t                               threadCount = 0;
+    uint32_t                               maxQueued   = 0;
+    uint32_t                               activeCount = 0; /**< Number of tasks currently executing */
+    bool                                   stopping    = false;
+};
+} // namespace Capsaicin
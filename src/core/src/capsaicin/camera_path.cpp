@@ -0,0 +1,183 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "camera_path.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace Capsaicin
+{
+static_assert(sizeof(CameraPathSample) == 48, "Camera path samples must not contain padding");
+
+namespace
+{
+/** Header stored at the start of a camera path file, followed by each sample */
+struct CameraPathHeader
+{
+    std::array<char, 8> magic       = CameraPath::kMagic;
+    uint32_t            version     = CameraPath::kVersion;
+    uint32_t            sampleCount = 0;
+};
+
+/**
+ * Interpolates between the two central points of a uniform Catmull-Rom spline segment.
+ * @param p0 The point before the segment.
+ * @param p1 The start of the segment.
+ * @param p2 The end of the segment.
+ * @param p3 The point after the segment.
+ * @param t  The position within the segment (range [0, 1]).
+ * @return The interpolated point.
+ */
+glm::vec3 CatmullRom(glm::vec3 const &p0, glm::vec3 const &p1, glm::vec3 const &p2, glm::vec3 const &p3,
+    float const t) noexcept
+{
+    float const t2 = t * t;
+    float const t3 = t2 * t;
+    return 0.5F
+         * ((2.0F * p1) + (p2 - p0) * t + (2.0F * p0 - 5.0F * p1 + 4.0F * p2 - p3) * t2
+             + (3.0F * p1 - p0 - 3.0F * p2 + p3) * t3);
+}
+
+/**
+ * Normalised linear interpolation between two directions.
+ * @param a The start direction.
+ * @param b The end direction.
+ * @param t The interpolation amount (range [0, 1]).
+ * @return The interpolated direction, a if the directions are opposite.
+ */
+glm::vec3 NLerp(glm::vec3 const &a, glm::vec3 const &b, float const t) noexcept
+{
+    glm::vec3 const direction = glm::mix(a, b, t);
+    float const     length    = glm::length(direction);
+    return length > 1.0e-6F ? direction / length : a;
+}
+} // unnamed namespace
+
+void CameraPath::addSample(CameraPathSample const &sample) noexcept
+{
+    try
+    {
+        samples.push_back(sample);
+    }
+    catch (...)
+    {}
+}
+
+CameraPathSample CameraPath::evaluate(uint32_t const frame, uint32_t const frameCount) const noexcept
+{
+    if (samples.empty())
+    {
+        return {};
+    }
+    auto const sampleCount = static_cast<uint32_t>(samples.size());
+    if (frameCount == sampleCount || frameCount <= 1 || sampleCount == 1)
+    {
+        return samples[std::min(frame, sampleCount - 1)];
+    }
+
+    // Map the frame onto the recorded samples so the first and last frames match the path end points
+    double const position = static_cast<double>(std::min(frame, frameCount - 1))
+                          * static_cast<double>(sampleCount - 1) / static_cast<double>(frameCount - 1);
+    auto const  segment = std::min(static_cast<uint32_t>(position), sampleCount - 2);
+    float const t       = static_cast<float>(position - static_cast<double>(segment));
+
+    CameraPathSample const &p1 = samples[segment];
+    CameraPathSample const &p2 = samples[segment + 1];
+    // Extrapolate missing end points so the path keeps a constant velocity at either end
+    glm::vec3 const p0 = segment > 0 ? samples[segment - 1].position : 2.0F * p1.position - p2.position;
+    glm::vec3 const p3 =
+        segment + 2 < sampleCount ? samples[segment + 2].position : 2.0F * p2.position - p1.position;
+
+    CameraPathSample ret;
+    ret.position = CatmullRom(p0, p1.position, p2.position, p3, t);
+    ret.forward  = NLerp(p1.forward, p2.forward, t);
+    // Keep up perpendicular to the view direction as independent interpolation can skew the basis
+    glm::vec3 const up    = NLerp(p1.up, p2.up, t);
+    glm::vec3 const right = glm::cross(ret.forward, up);
+    ret.up     = glm::length(right) > 1.0e-6F ? glm::normalize(glm::cross(right, ret.forward)) : up;
+    ret.fovY   = glm::mix(p1.fovY, p2.fovY, t);
+    ret.jitter = t < 0.5F ? p1.jitter : p2.jitter;
+    return ret;
+}
+
+uint32_t CameraPath::getSampleCount() const noexcept
+{
+    return static_cast<uint32_t>(samples.size());
+}
+
+void CameraPath::clear() noexcept
+{
+    samples.clear();
+}
+
+bool CameraPath::save(std::filesystem::path const &filePath) const noexcept
+{
+    try
+    {
+        std::ofstream file(filePath, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        CameraPathHeader header;
+        header.sampleCount = static_cast<uint32_t>(samples.size());
+        file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+        file.write(reinterpret_cast<char const *>(samples.data()),
+            static_cast<std::streamsize>(samples.size() * sizeof(CameraPathSample)));
+        return file.good();
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool CameraPath::load(std::filesystem::path const &filePath) noexcept
+{
+    try
+    {
+        samples.clear();
+        std::ifstream file(filePath, std::ios::binary);
+        CameraPathHeader header;
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != kMagic
+            || header.version != kVersion)
+        {
+            return false;
+        }
+        samples.resize(header.sampleCount);
+        if (!file.read(reinterpret_cast<char *>(samples.data()),
+                static_cast<std::streamsize>(samples.size() * sizeof(CameraPathSample))))
+        {
+            samples.clear();
+            return false;
+        }
+        return true;
+    }
+    catch (...)
+    {
+        samples.clear();
+        return false;
+    }
+}
+} // namespace Capsaicin
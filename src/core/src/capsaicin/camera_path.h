@@ -0,0 +1,95 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Capsaicin
+{
+/** Camera state of a single recorded frame */
+struct CameraPathSample
+{
+    glm::vec3 position; /**< World space camera position */
+    glm::vec3 forward;  /**< Normalised view direction */
+    glm::vec3 up;       /**< Normalised up direction */
+    float     fovY;     /**< Vertical field of view (radians) */
+    glm::vec2 jitter;   /**< Sub-pixel jitter offset (pixels, range [-0.5, 0.5]) */
+};
+
+/**
+ * A camera fly-through recorded one sample per frame.
+ * Paths are stored in a compact little endian binary file (.campath) and can be evaluated at any frame count,
+ * positions use Catmull-Rom interpolation and orientations are normalised linear interpolations between the
+ * neighbouring samples. Evaluating a path with the recorded frame count returns each sample unmodified.
+ */
+class CameraPath
+{
+public:
+    static constexpr std::array<char, 8> kMagic   = {'C', 'A', 'P', 'C', 'A', 'M', '\0', '\0'};
+    static constexpr uint32_t            kVersion = 1;
+
+    /**
+     * Appends a new sample to the end of the path.
+     * @param sample The camera state of the new frame.
+     */
+    void addSample(CameraPathSample const &sample) noexcept;
+
+    /**
+     * Gets the camera state at a given frame when playing back the path over a number of frames.
+     * @note Jitter is not interpolated, the value of the nearest sample is returned.
+     * @param frame      The frame to evaluate (range [0, frameCount)), later frames return the last sample.
+     * @param frameCount The total number of frames the path is played back over.
+     * @return The camera state, default initialised if the path is empty.
+     */
+    [[nodiscard]] CameraPathSample evaluate(uint32_t frame, uint32_t frameCount) const noexcept;
+
+    /**
+     * Gets the number of recorded samples.
+     * @return The sample count.
+     */
+    [[nodiscard]] uint32_t getSampleCount() const noexcept;
+
+    /** Remove all samples. */
+    void clear() noexcept;
+
+    /**
+     * Saves the path to disk.
+     * @param filePath Full pathname to the file to save as.
+     * @return True if successful, False otherwise.
+     */
+    [[nodiscard]] bool save(std::filesystem::path const &filePath) const noexcept;
+
+    /**
+     * Loads a path from disk replacing any existing samples.
+     * @param filePath Full pathname to the file to load.
+     * @return True if successful, False otherwise.
+     */
+    bool load(std::filesystem::path const &filePath) noexcept;
+
+private:
+    std::vector<CameraPathSample> samples;
+};
+} // namespace Capsaicin
@@ -22,6 +22,7 @@ THE SOFTWARE.
 #include "capsaicin.h"
 
 #include "capsaicin_internal.h"
+#include "task_scheduler.h"
 
 namespace
 {
@@ -168,6 +169,40 @@ void SetSceneCameraRange(glm::vec2 const &nearFar) noexcept
     }
 }
 
+void StartCameraPathRecording() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        g_renderer->startCameraPathRecording();
+    }
+}
+
+bool StopCameraPathRecording(std::filesystem::path const &file_path) noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->stopCameraPathRecording(file_path);
+    }
+    return false;
+}
+
+bool PlayCameraPath(std::filesystem::path const &file_path, uint32_t const frame_count) noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->playCameraPath(file_path, frame_count);
+    }
+    return false;
+}
+
+void StopCameraPath() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        g_renderer->stopCameraPath();
+    }
+}
+
 std::filesystem::path GetCurrentEnvironmentMap() noexcept
 {
     if (g_renderer != nullptr)
@@ -266,6 +301,41 @@ double GetAverageFrameTime() noexcept
     return 0.0;
 }
 
+TimingStatistics GetFrameTimeStatistics() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->getFrameTimeStatistics();
+    }
+    return {};
+}
+
+std::map<std::string, TimingStatistics> GetTimestampStatistics() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->getTimestampStatistics();
+    }
+    return {};
+}
+
+void ResetFrameStatistics() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        g_renderer->resetFrameStatistics();
+    }
+}
+
+bool SaveFrameStatistics(std::filesystem::path const &file_path) noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->saveFrameStatistics(file_path);
+    }
+    return false;
+}
+
 bool HasAnimation() noexcept
 {
     if (g_renderer != nullptr)
@@ -469,6 +539,32 @@ uint64_t GetBvhDataSize() noexcept
     return 0;
 }
 
+std::map<std::string, MemoryUsage> GetMemoryUsage() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->getMemoryUsage();
+    }
+    return {};
+}
+
+MemoryUsage GetTotalMemoryUsage() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->getTotalMemoryUsage();
+    }
+    return {};
+}
+
+void ResetMemoryPeaks() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        g_renderer->resetMemoryPeaks();
+    }
+}
+
 std::pair<uint32_t, uint32_t> GetWindowDimensions() noexcept
 {
     auto const ret = (g_renderer != nullptr) ? g_renderer->getWindowDimensions() : uint2(0);
@@ -503,6 +599,8 @@ void Terminate() noexcept
 {
     delete g_renderer;
     g_renderer = nullptr;
+    // Worker threads must not outlive the library as they can not be joined during unload
+    TaskScheduler::Get().shutdown();
 }
 
 void ReloadShaders() noexcept
@@ -513,6 +611,23 @@ void ReloadShaders() noexcept
     }
 }
 
+void SetShaderHotReload(bool const enabled) noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        g_renderer->setShaderHotReload(enabled);
+    }
+}
+
+bool GetShaderHotReload() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->getShaderHotReload();
+    }
+    return false;
+}
+
 void DumpDebugView(std::filesystem::path const &file_path, std::string_view const &view) noexcept
 {
     if (g_renderer != nullptr)
@@ -521,6 +636,15 @@ void DumpDebugView(std::filesystem::path const &file_path, std::string_view cons
     }
 }
 
+bool DumpAOVs(std::filesystem::path const &file_path, std::vector<std::string_view> const &aovs) noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->dumpAOVs(file_path, aovs);
+    }
+    return false;
+}
+
 void DumpCamera(std::filesystem::path const &file_path, bool const jittered) noexcept
 {
     if (g_renderer != nullptr)
@@ -529,4 +653,91 @@ void DumpCamera(std::filesystem::path const &file_path, bool const jittered) noe
     }
 }
 
+void FlushDumps() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        g_renderer->flushDumps();
+    }
+}
+
+bool OpenFrameSequence(std::filesystem::path const &file_path) noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->openFrameSequence(file_path);
+    }
+    return false;
+}
+
+bool AppendFrameSequence(std::string_view const &view) noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->appendFrameSequence(view);
+    }
+    return false;
+}
+
+void CloseFrameSequence() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        g_renderer->closeFrameSequence();
+    }
+}
+
+void SetEXRCompression(EXRCompression const compression) noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        g_renderer->setEXRCompression(compression);
+    }
+}
+
+EXRCompression GetEXRCompression() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->getEXRCompression();
+    }
+    return {};
+}
+
+void SetProfilingEnabled(bool const enable) noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        g_renderer->setProfilingEnabled(enable);
+    }
+}
+
+bool GetProfilingEnabled() noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->getProfilingEnabled();
+    }
+    return false;
+}
+
+bool DumpProfile(std::filesystem::path const &file_path) noexcept
+{
+    if (g_renderer != nullptr)
+    {
+        return g_renderer->dumpProfile(file_path);
+    }
+    return false;
+}
+
+void SetWorkerThreads(uint32_t const worker_count, bool const pin_threads) noexcept
+{
+    TaskScheduler::Get().setWorkerCount(worker_count, pin_threads);
+}
+
+uint32_t GetWorkerThreadCount() noexcept
+{
+    return TaskScheduler::Get().getWorkerCount();
+}
+
 } // namespace Capsaicin
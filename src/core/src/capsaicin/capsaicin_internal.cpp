@@ -23,13 +23,14 @@ THE SOFTWARE.
 
 #include "common_functions.inl"
 #include "components/light_builder/light_builder.h"
+#include "cpu_profiler.h"
 #include "render_technique.h"
+#include "task_scheduler.h"
 
 #include <chrono>
 #include <filesystem>
 #include <gfx_imgui.h>
 #include <imgui_stdlib.h>
-#include <ppl.h>
 
 namespace Capsaicin
 {
@@ -88,7 +89,32 @@ double CapsaicinInternal::getFrameTime() const noexcept
 
 double CapsaicinInternal::getAverageFrameTime() const noexcept
 {
-    return frameGraph.getAverageValue();
+    return frame_statistics_.getAverageFrameTime() / 1000.0;
+}
+
+TimingStatistics CapsaicinInternal::getFrameTimeStatistics() const noexcept
+{
+    return frame_statistics_.getFrameTimeStatistics().getStatistics();
+}
+
+std::map<std::string, TimingStatistics> CapsaicinInternal::getTimestampStatistics() const noexcept
+{
+    return frame_statistics_.getTimestampStatistics();
+}
+
+void CapsaicinInternal::resetFrameStatistics() noexcept
+{
+    frame_statistics_.reset();
+}
+
+bool CapsaicinInternal::saveFrameStatistics(std::filesystem::path const &filePath) const noexcept
+{
+    if (!frame_statistics_.save(filePath))
+    {
+        GFX_PRINTLN("Error: Failed to write frame statistics to '%s'", filePath.string().c_str());
+        return false;
+    }
+    return true;
 }
 
 bool CapsaicinInternal::hasAnimation() const noexcept
@@ -228,6 +254,11 @@ bool CapsaicinInternal::getEnvironmentMapUpdated() const noexcept
     return environment_map_updated_;
 }
 
+uint64_t CapsaicinInternal::getEnvironmentMapHash() const noexcept
+{
+    return environment_map_hash_;
+}
+
 std::vector<std::string_view> CapsaicinInternal::getSharedTextures() const noexcept
 {
     std::vector<std::string_view> textures;
@@ -247,6 +278,8 @@ bool CapsaicinInternal::hasSharedTexture(std::string_view const &texture) const
 bool CapsaicinInternal::checkSharedTexture(
     std::string_view const &texture, uint2 const dimensions, uint32_t const mips)
 {
+    MemoryTracker::OwnerScope const memoryOwner(MemoryTracker::kSharedOwner);
+
     if (auto const i = std::ranges::find_if(
             shared_textures_, [&texture](auto const &item) { return item.first == texture; });
         i != shared_textures_.end())
@@ -264,15 +297,14 @@ bool CapsaicinInternal::checkSharedTexture(
             GfxTexture        newTexture;
             if (autoSize)
             {
-                newTexture =
-                    gfxCreateTexture2D(gfx_, render_dimensions_.x, render_dimensions_.y, format, mips);
+                newTexture = CreateTexture2D(gfx_, render_dimensions_.x, render_dimensions_.y, format, mips);
             }
             else
             {
-                newTexture = gfxCreateTexture2D(gfx_, dimensions.x, dimensions.y, format, mips);
+                newTexture = CreateTexture2D(gfx_, dimensions.x, dimensions.y, format, mips);
             }
             newTexture.setName(name);
-            gfxDestroyTexture(gfx_, i->second);
+            DestroyTexture(gfx_, i->second);
             i->second = newTexture;
             return !!i->second;
         }
@@ -324,6 +356,8 @@ bool CapsaicinInternal::hasSharedBuffer(std::string_view const &buffer) const no
 bool CapsaicinInternal::checkSharedBuffer(
     std::string_view const &buffer, uint64_t const size, bool const exactSize, bool const copy)
 {
+    MemoryTracker::OwnerScope const memoryOwner(MemoryTracker::kSharedOwner);
+
     if (auto const i = std::ranges::find_if(
             shared_buffers_, [&buffer](auto const &item) { return item.first == buffer; });
         i != shared_buffers_.end())
@@ -334,14 +368,14 @@ bool CapsaicinInternal::checkSharedBuffer(
         }
         auto const *const name      = i->second.getName();
         auto const        stride    = i->second.getStride();
-        GfxBuffer         newBuffer = gfxCreateBuffer(gfx_, size);
+        GfxBuffer         newBuffer = CreateBuffer(gfx_, size);
         if (copy)
         {
             gfxCommandCopyBuffer(gfx_, newBuffer, 0, i->second, 0, i->second.getSize());
         }
         newBuffer.setName(name);
         newBuffer.setStride(stride);
-        gfxDestroyBuffer(gfx_, i->second);
+        DestroyBuffer(gfx_, i->second);
         i->second = newBuffer;
         return !!i->second;
     }
@@ -405,7 +439,7 @@ bool CapsaicinInternal::setRenderer(std::string_view const &name) noexcept
         renderer_      = nullptr;
         renderer_name_ = "";
     }
-    frameGraph.reset();
+    frame_statistics_.reset();
     setupRenderTechniques(*renderer);
     return true;
 }
@@ -518,6 +552,36 @@ uint64_t CapsaicinInternal::getBvhDataSize() const noexcept
     return bvh_data_size;
 }
 
+std::map<std::string, MemoryUsage> CapsaicinInternal::getMemoryUsage() const noexcept
+{
+    return MemoryTracker::Get().getUsages();
+}
+
+MemoryUsage CapsaicinInternal::getTotalMemoryUsage() const noexcept
+{
+    return MemoryTracker::Get().getTotalUsage();
+}
+
+void CapsaicinInternal::resetMemoryPeaks() noexcept
+{
+    MemoryTracker::Get().resetPeaks();
+}
+
+ReadbackPool &CapsaicinInternal::getReadbackPool() const noexcept
+{
+    return readback_pool_;
+}
+
+LutCache &CapsaicinInternal::getLutCache() const noexcept
+{
+    return lut_cache_;
+}
+
+GPULutCache &CapsaicinInternal::getGPULutCache() const noexcept
+{
+    return gpu_lut_cache_;
+}
+
 GfxBuffer CapsaicinInternal::getInstanceBuffer() const
 {
     return instance_buffer_;
@@ -658,13 +722,13 @@ GfxBuffer CapsaicinInternal::allocateConstantBuffer(uint64_t const size)
 
     if (constant_buffer_pool_cursor >= constant_buffer_pool.getSize())
     {
-        gfxDestroyBuffer(gfx_, constant_buffer_pool);
+        DestroyBuffer(gfx_, constant_buffer_pool);
 
         uint64_t constant_buffer_pool_size = constant_buffer_pool_cursor;
         constant_buffer_pool_size += (constant_buffer_pool_size + 2) >> 1;
         constant_buffer_pool_size = GFX_ALIGN(constant_buffer_pool_size, 65536);
 
-        constant_buffer_pool = gfxCreateBuffer(gfx_, constant_buffer_pool_size, nullptr, kGfxCpuAccess_Write);
+        constant_buffer_pool = CreateBuffer(gfx_, constant_buffer_pool_size, nullptr, kGfxCpuAccess_Write);
 
         char buffer[256];
         GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_ConstantBufferPool%u", gfxGetBackBufferIndex(gfx_));
@@ -686,7 +750,7 @@ GfxTexture CapsaicinInternal::createRenderTexture(
     auto const dimensions = scale == 1.0F ? render_dimensions_ : uint2(float2(render_dimensions_) * scale);
     mips = mips == UINT_MAX ? std::max(gfxCalculateMipCount(dimensions.x, dimensions.y), 1U) : mips;
     constexpr float clear[] = {0.0F, 0.0F, 0.0F, 0.0F};
-    auto            ret     = gfxCreateTexture2D(
+    auto            ret     = CreateTexture2D(
         gfx_, dimensions.x, dimensions.y, format, mips, (format != DXGI_FORMAT_D32_FLOAT) ? nullptr : clear);
     ret.setName(name.data());
     return ret;
@@ -701,9 +765,9 @@ GfxTexture CapsaicinInternal::resizeRenderTexture(
     mips                     = (mips == UINT_MAX || (mips == 0 && texture.getMipLevels() > 1))
                                  ? gfxCalculateMipCount(dimensions.x, dimensions.y)
                                  : ((mips == 0) ? 1 : mips);
-    auto ret = gfxCreateTexture2D(gfx_, dimensions.x, dimensions.y, format, mips, texture.getClearValue());
+    auto ret = CreateTexture2D(gfx_, dimensions.x, dimensions.y, format, mips, texture.getClearValue());
     ret.setName(name);
-    gfxDestroyTexture(gfx_, texture);
+    DestroyTexture(gfx_, texture);
     if (clear)
     {
         gfxCommandClearTexture(gfx_, ret);
@@ -717,7 +781,7 @@ GfxTexture CapsaicinInternal::createWindowTexture(
     auto const dimensions = scale == 1.0F ? window_dimensions_ : uint2(float2(window_dimensions_) * scale);
     mips = mips == UINT_MAX ? std::max(gfxCalculateMipCount(dimensions.x, dimensions.y), 1U) : mips;
     constexpr float clearValue[] = {0.0F, 0.0F, 0.0F, 0.0F};
-    auto            ret          = gfxCreateTexture2D(gfx_, dimensions.x, dimensions.y, format, mips,
+    auto            ret          = CreateTexture2D(gfx_, dimensions.x, dimensions.y, format, mips,
         (format != DXGI_FORMAT_D32_FLOAT) ? nullptr : clearValue);
     ret.setName(name.data());
     return ret;
@@ -732,9 +796,9 @@ GfxTexture CapsaicinInternal::resizeWindowTexture(
     mips                     = (mips == UINT_MAX || (mips == 0 && texture.getMipLevels() > 1))
                                  ? gfxCalculateMipCount(dimensions.x, dimensions.y)
                                  : ((mips == 0) ? 1 : mips);
-    auto ret = gfxCreateTexture2D(gfx_, dimensions.x, dimensions.y, format, mips, texture.getClearValue());
+    auto ret = CreateTexture2D(gfx_, dimensions.x, dimensions.y, format, mips, texture.getClearValue());
     ret.setName(name);
-    gfxDestroyTexture(gfx_, texture);
+    DestroyTexture(gfx_, texture);
     if (clear)
     {
         gfxCommandClearTexture(gfx_, ret);
@@ -742,13 +806,134 @@ GfxTexture CapsaicinInternal::resizeWindowTexture(
     return ret;
 }
 
-GfxProgram CapsaicinInternal::createProgram(char const *file_name) const noexcept
+GfxProgram CapsaicinInternal::createProgram(
+    char const *file_name, std::string_view const &owner) const noexcept
 {
     auto const  shaderPaths      = getShaderPaths();
     char const *include_paths[3] = {shaderPaths[0].c_str(), shaderPaths[1].c_str(), shaderPaths[2].c_str()};
+    // Record which component/technique uses the program so that it can be reloaded when its source changes
+    try
+    {
+        program_owners_[ShaderDependencies::Normalise(shader_path_ + file_name)].emplace(owner);
+    }
+    catch (...)
+    {}
     return gfxCreateProgram(gfx_, file_name, shader_path_.c_str(), nullptr, include_paths, 3U);
 }
 
+uint64_t CapsaicinInternal::getProgramHash(char const *file_name) const noexcept
+{
+    try
+    {
+        return shader_dependencies_.getHash(shader_dependencies_.getProgramClosure(shader_path_ + file_name));
+    }
+    catch (...)
+    {}
+    return 0;
+}
+
+void CapsaicinInternal::scanShaderSources() noexcept
+{
+    CAPSAICIN_PROFILE_FUNCTION();
+    auto const                         shaderPaths = getShaderPaths();
+    std::vector<std::filesystem::path> includePaths(shaderPaths.cbegin(), shaderPaths.cend());
+    shader_dependencies_.setIncludePaths(includePaths);
+
+    // Reading and parsing each file is independent so can be performed in parallel
+    auto const                            files = ShaderDependencies::FindShaderFiles(shader_path_);
+    std::vector<ShaderDependencies::File> scanned(files.size());
+    TaskScheduler::Get().parallelFor(size_t {0}, files.size(),
+        [&](size_t const index) { scanned[index] = shader_dependencies_.scanFile(files[index]); });
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        shader_dependencies_.addFile(files[i], std::move(scanned[i]));
+    }
+}
+
+void CapsaicinInternal::reloadModifiedShaders() noexcept
+{
+    // Polling file modification times is cheap but there is no need to do it every frame
+    constexpr double checkInterval = 0.5;
+    if (current_time_ - shader_check_time_ < checkInterval)
+    {
+        return;
+    }
+    shader_check_time_  = current_time_;
+    auto const modified = shader_dependencies_.updateModifiedFiles();
+    if (modified.empty())
+    {
+        return;
+    }
+    CAPSAICIN_PROFILE_FUNCTION();
+
+    // Find the owners of every program whose include closure contains a modified file
+    std::set<std::string_view> owners;
+    bool                       reloadAll = false;
+    for (auto const &file : modified)
+    {
+        GFX_PRINTLN("Shader source '%s' modified", file.string().c_str());
+        for (auto program : shader_dependencies_.getDependents(file))
+        {
+            if (std::ranges::find(ShaderDependencies::kProgramExtensions, program.extension().string())
+                == ShaderDependencies::kProgramExtensions.cend())
+            {
+                continue; // not a program stage
+            }
+            program.replace_extension();
+            if (auto const programOwners = program_owners_.find(program);
+                programOwners != program_owners_.end())
+            {
+                owners.insert(programOwners->second.cbegin(), programOwners->second.cend());
+            }
+            else
+            {
+                // Programs not created through createProgram (e.g. utilities) have unknown owners
+                reloadAll = true;
+            }
+        }
+    }
+    if (reloadAll || owners.contains(MemoryTracker::kDefaultOwner))
+    {
+        reloadShaders();
+        return;
+    }
+    if (owners.empty())
+    {
+        return; // modified file is not used by any current program
+    }
+
+    // Re-initialise only the affected components/techniques, dependencies are kept in their existing order
+    gfxFinish(gfx_); // flush & sync
+    for (auto const &[name, component] : components_)
+    {
+        if (owners.contains(component->getName()))
+        {
+            component->setGfxContext(gfx_);
+            component->terminate();
+            MemoryTracker::OwnerScope const memoryOwner(component->getName());
+            if (!component->init(*this))
+            {
+                GFX_PRINTLN("Error: Failed to initialise component: %s", name.data());
+            }
+        }
+    }
+    for (auto const &render_technique : render_techniques_)
+    {
+        if (owners.contains(render_technique->getName()))
+        {
+            render_technique->setGfxContext(gfx_);
+            render_technique->terminate();
+            MemoryTracker::OwnerScope const memoryOwner(render_technique->getName());
+            if (!render_technique->init(*this))
+            {
+                GFX_PRINTLN(
+                    "Error: Failed to initialise render technique: %s", render_technique->getName().data());
+            }
+        }
+    }
+    resetRenderState();
+}
+
 void CapsaicinInternal::initialize(GfxContext const &gfx, ImGuiContext *imgui_context)
 {
     if (!gfx)
@@ -789,6 +974,7 @@ void CapsaicinInternal::initialize(GfxContext const &gfx, ImGuiContext *imgui_co
         GFX_PRINTLN("Could not find directory containing shader source files");
         return;
     }
+    scanShaderSources();
 
     sbt_stride_in_entries_[kGfxShaderGroupType_Raygen]   = 1;
     sbt_stride_in_entries_[kGfxShaderGroupType_Miss]     = 2;
@@ -796,21 +982,28 @@ void CapsaicinInternal::initialize(GfxContext const &gfx, ImGuiContext *imgui_co
     sbt_stride_in_entries_[kGfxShaderGroupType_Callable] = 1;
 
     gfx_ = gfx;
+    readback_pool_.initialise(gfx_);
+    gpu_lut_cache_.initialise(gfx_, getShaderPaths());
 
-    blit_program_ = createProgram("capsaicin/blit");
+    blit_program_ = createProgram("capsaicin/blit", MemoryTracker::kDefaultOwner);
     blit_kernel_  = gfxCreateGraphicsKernel(gfx, blit_program_);
 
-    generate_animated_vertices_program_ = createProgram("capsaicin/generate_animated_vertices");
+    generate_animated_vertices_program_ =
+        createProgram("capsaicin/generate_animated_vertices", MemoryTracker::kDefaultOwner);
     generate_animated_vertices_kernel_  = gfxCreateComputeKernel(gfx, generate_animated_vertices_program_);
 
     window_dimensions_ = uint2(gfxGetBackBufferWidth(gfx), gfxGetBackBufferHeight(gfx));
     setRenderDimensionsScale(render_scale_);
 
+    CPUProfiler::Get().setThreadName("Render");
+
     ImGui::SetCurrentContext(imgui_context);
 }
 
 void CapsaicinInternal::render()
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+
     // Update current frame time
     auto const previousTime = current_time_;
     auto const wallTime     = std::chrono::duration_cast<std::chrono::microseconds>(
@@ -818,6 +1011,12 @@ void CapsaicinInternal::render()
     current_time_ = static_cast<double>(wallTime.count()) / 1000000.0;
     frame_time_   = current_time_ - previousTime;
 
+    // Apply any shader source changes before work for the new frame is recorded
+    if (shader_hot_reload_)
+    {
+        reloadModifiedShaders();
+    }
+
     // Check if manual frame increment/decrement has been applied
 
     if (bool const manual_play = play_time_ != play_time_old_;
@@ -826,7 +1025,19 @@ void CapsaicinInternal::render()
         // Start a new frame
         ++frame_index_;
 
-        frameGraph.addValue(frame_time_);
+        // The first frame has no valid previous time
+        if (previousTime != 0.0)
+        {
+            frame_statistics_.addFrameTime(frame_time_ * 1000.0);
+        }
+
+        auto &profiler = CPUProfiler::Get();
+        profiler.setFrameIndex(frame_index_);
+
+        // GPU timestamps are read back from the previous frame so are placed starting at that frames start
+        uint64_t   gpuTime    = profile_frame_start_;
+        bool const profileGPU = profiler.getEnabled() && gpuTime != 0;
+        profile_frame_start_  = profiler.now();
 
         constant_buffer_pool_cursor_ = 0;
         auto const currentWindow     = uint2(gfxGetBackBufferWidth(gfx_), gfxGetBackBufferHeight(gfx_));
@@ -873,6 +1084,7 @@ void CapsaicinInternal::render()
             }
             else
             {
+                MemoryTracker::OwnerScope const memoryOwner(MemoryTracker::kSharedOwner);
                 for (auto &i : shared_textures_)
                 {
                     if (i.first != "ColorScaled")
@@ -894,9 +1106,12 @@ void CapsaicinInternal::render()
         for (auto const &component : components_)
         {
             component.second->setGfxContext(gfx_);
+            recordTimestamps(*component.second, profileGPU, gpuTime);
             component.second->resetQueries();
             {
                 Component::TimedSection const timed_section(*component.second, component.second->getName());
+                CAPSAICIN_PROFILE_SCOPE(component.second->getName());
+                MemoryTracker::OwnerScope const memoryOwner(component.second->getName());
                 component.second->run(*this);
             }
         }
@@ -905,10 +1120,13 @@ void CapsaicinInternal::render()
         for (auto const &render_technique : render_techniques_)
         {
             render_technique->setGfxContext(gfx_);
+            recordTimestamps(*render_technique, profileGPU, gpuTime);
             render_technique->resetQueries();
             {
                 RenderTechnique::TimedSection const timed_section(
                     *render_technique, render_technique->getName());
+                CAPSAICIN_PROFILE_SCOPE(render_technique->getName());
+                MemoryTracker::OwnerScope const memoryOwner(render_technique->getName());
                 render_technique->render(*this);
             }
         }
@@ -952,7 +1170,8 @@ void CapsaicinInternal::render()
                 auto const &debug_texture = getSharedTexture("Debug");
                 if (!debug_depth_kernel_)
                 {
-                    debug_depth_program_    = createProgram("capsaicin/debug_depth");
+                    debug_depth_program_ =
+                        createProgram("capsaicin/debug_depth", MemoryTracker::kDefaultOwner);
                     GfxDrawState const draw = {};
                     gfxDrawStateSetColorTarget(draw, 0, debug_texture.getFormat());
                     debug_depth_kernel_ = gfxCreateGraphicsKernel(gfx_, debug_depth_program_, draw);
@@ -1000,33 +1219,11 @@ void CapsaicinInternal::render()
         gfxCommandDraw(gfx_, 3);
     }
 
-    // Dump buffers for past dump requests (takes X frames to be become available)
-    uint32_t dump_available_buffer_count = 0;
-    for (auto &dump_in_flight_buffer : dump_in_flight_buffers_)
-    {
-        if (uint32_t &dump_frame_index = std::get<5>(dump_in_flight_buffer); dump_frame_index == 0)
-        {
-            dump_available_buffer_count++;
-        }
-        else
-        {
-            --dump_frame_index;
-        }
-    }
-
-    // Write out each available buffer in parallel
-    concurrency::parallel_for(0U, dump_available_buffer_count, 1U, [&](uint32_t const buffer_index) {
-        auto const &buffer = dump_in_flight_buffers_[buffer_index];
-        saveImage(std::get<0>(buffer), std::get<1>(buffer), std::get<2>(buffer), std::get<3>(buffer),
-            std::get<4>(buffer));
-    });
+    // Queue writes for past dump requests (takes X frames to be become available)
+    processDumpRequests(false);
 
-    for (uint32_t available_buffer_index = 0; available_buffer_index < dump_available_buffer_count;
-         available_buffer_index++)
-    {
-        gfxDestroyBuffer(gfx_, std::get<0>(dump_in_flight_buffers_.front()));
-        dump_in_flight_buffers_.pop_front();
-    }
+    // Complete finished readbacks and recycle their buffers
+    readback_pool_.update();
 }
 
 void CapsaicinInternal::renderGUI(bool const readOnly)
@@ -1071,10 +1268,12 @@ void CapsaicinInternal::renderGUI(bool const readOnly)
             renderStockGUI();
             for (auto const &component : components_)
             {
+                MemoryTracker::OwnerScope const memoryOwner(component.second->getName());
                 component.second->renderGUI(*this);
             }
             for (auto const &render_technique : render_techniques_)
             {
+                MemoryTracker::OwnerScope const memoryOwner(render_technique->getName());
                 render_technique->renderGUI(*this);
             }
         }
@@ -1151,11 +1350,24 @@ void CapsaicinInternal::renderGUI(bool const readOnly)
         ImGui::SameLine();
         std::string const graphName = std::format("{:.2f}", frame_time_ * 1000.0) + " ms ("
                                     + std::format("{:.2f}", 1.0 / frame_time_) + " fps)";
-        ImGui::PlotLines("", Graph::GetValueAtIndex, &frameGraph,
-            static_cast<int>(frameGraph.getValueCount()), 0, graphName.c_str(), 0.0F, FLT_MAX,
+        ImGui::PlotLines("", FrameStatistics::GetHistoryValue, &frame_statistics_,
+            static_cast<int>(frame_statistics_.getHistoryCount()), 0, graphName.c_str(), 0.0F, FLT_MAX,
             ImVec2(150, 20));
         ImGui::PopID();
 
+        // Output frame time distribution over the entire run
+        auto const frameStatistics = frame_statistics_.getFrameTimeStatistics().getStatistics();
+        ImGui::PushID("Frame time percentiles");
+        ImGui::Text("%-28s:", "Frame time p50/p90/p99");
+        ImGui::SameLine();
+        ImGui::Text("%.2f / %.2f / %.2f ms", frameStatistics.p50, frameStatistics.p90, frameStatistics.p99);
+        ImGui::PopID();
+        ImGui::PushID("Stutters");
+        ImGui::Text("%-28s:", "Stutters");
+        ImGui::SameLine();
+        ImGui::Text("%llu", static_cast<unsigned long long>(frameStatistics.stutterCount));
+        ImGui::PopID();
+
         // Out put current frame number
         ImGui::PushID("Frame");
         ImGui::Text("%-28s:", "Frame");
@@ -1164,6 +1376,32 @@ void CapsaicinInternal::renderGUI(bool const readOnly)
         ImGui::PopID();
     }
 
+    // Display the memory used by each component/technique
+    if (ImGui::CollapsingHeader("Memory", ImGuiTreeNodeFlags_None))
+    {
+        auto const displayUsage = [](char const *name, MemoryUsage const &usage) {
+            constexpr double toMiB = 1.0 / (1024.0 * 1024.0);
+            ImGui::Text("%-25s: %7.1f MiB (peak %7.1f MiB)", name,
+                static_cast<double>(usage.gpuBytes) * toMiB, static_cast<double>(usage.gpuPeakBytes) * toMiB);
+            if (usage.cpuPeakBytes > 0)
+            {
+                ImGui::Text("%-25s: %7.1f MiB (peak %7.1f MiB)", "  Upload/Readback",
+                    static_cast<double>(usage.cpuBytes) * toMiB,
+                    static_cast<double>(usage.cpuPeakBytes) * toMiB);
+            }
+        };
+        for (auto const &[owner, usage] : getMemoryUsage())
+        {
+            displayUsage(owner.c_str(), usage);
+        }
+        ImGui::Separator();
+        displayUsage("Total", getTotalMemoryUsage());
+        if (!readOnly && ImGui::Button("Reset Peaks"))
+        {
+            resetMemoryPeaks();
+        }
+    }
+
     if (!readOnly)
     {
         // As not all techniques/components will expose there settings in a visible way through their own
@@ -1247,23 +1485,17 @@ void CapsaicinInternal::terminate() noexcept
 {
     gfxFinish(gfx_); // flush & sync
 
-    // Dump remaining buffers, they are all available after gfxFinish
-    concurrency::parallel_for(
-        0U, static_cast<uint32_t>(dump_in_flight_buffers_.size()), 1U, [&](uint32_t const buffer_index) {
-            auto const &buffer = dump_in_flight_buffers_[buffer_index];
-            saveImage(std::get<0>(buffer), std::get<1>(buffer), std::get<2>(buffer), std::get<3>(buffer),
-                std::get<4>(buffer).c_str());
-        });
-
-    while (!dump_in_flight_buffers_.empty())
-    {
-        gfxDestroyBuffer(gfx_, std::get<0>(dump_in_flight_buffers_.front()));
-        dump_in_flight_buffers_.pop_front();
-    }
+    // Write remaining dump requests, they are all available after gfxFinish
+    processDumpRequests(true);
+    closeFrameSequence();
+    readback_pool_.flush();
+    lut_cache_.flush();
 
     render_techniques_.clear();
     components_.clear();
     renderer_ = nullptr;
+    readback_pool_.clear();
+    gpu_lut_cache_.terminate();
 
     gfxDestroyKernel(gfx_, blit_kernel_);
     gfxDestroyProgram(gfx_, blit_program_);
@@ -1272,21 +1504,21 @@ void CapsaicinInternal::terminate() noexcept
     gfxDestroyKernel(gfx_, generate_animated_vertices_kernel_);
     gfxDestroyProgram(gfx_, generate_animated_vertices_program_);
 
-    gfxDestroyBuffer(gfx_, camera_matrices_buffer_[0]);
-    gfxDestroyBuffer(gfx_, camera_matrices_buffer_[1]);
-    gfxDestroyBuffer(gfx_, index_buffer_);
-    gfxDestroyBuffer(gfx_, vertex_buffer_);
-    gfxDestroyBuffer(gfx_, vertex_source_buffer_);
-    gfxDestroyBuffer(gfx_, instance_buffer_);
-    gfxDestroyBuffer(gfx_, material_buffer_);
-    gfxDestroyBuffer(gfx_, transform_buffer_);
-    gfxDestroyBuffer(gfx_, instance_id_buffer_);
-    gfxDestroyBuffer(gfx_, prev_transform_buffer_);
-    gfxDestroyBuffer(gfx_, morph_weight_buffer_);
-    gfxDestroyBuffer(gfx_, joint_buffer_);
-    gfxDestroyBuffer(gfx_, joint_matrices_buffer_);
-
-    gfxDestroyTexture(gfx_, environment_buffer_);
+    DestroyBuffer(gfx_, camera_matrices_buffer_[0]);
+    DestroyBuffer(gfx_, camera_matrices_buffer_[1]);
+    DestroyBuffer(gfx_, index_buffer_);
+    DestroyBuffer(gfx_, vertex_buffer_);
+    DestroyBuffer(gfx_, vertex_source_buffer_);
+    DestroyBuffer(gfx_, instance_buffer_);
+    DestroyBuffer(gfx_, material_buffer_);
+    DestroyBuffer(gfx_, transform_buffer_);
+    DestroyBuffer(gfx_, instance_id_buffer_);
+    DestroyBuffer(gfx_, prev_transform_buffer_);
+    DestroyBuffer(gfx_, morph_weight_buffer_);
+    DestroyBuffer(gfx_, joint_buffer_);
+    DestroyBuffer(gfx_, joint_matrices_buffer_);
+
+    DestroyTexture(gfx_, environment_buffer_);
 
     gfxDestroySamplerState(gfx_, linear_sampler_);
     gfxDestroySamplerState(gfx_, linear_wrap_sampler_);
@@ -1297,7 +1529,7 @@ void CapsaicinInternal::terminate() noexcept
 
     for (auto const &i : shared_textures_)
     {
-        gfxDestroyTexture(gfx_, i.second);
+        DestroyTexture(gfx_, i.second);
     }
     shared_textures_.clear();
     backup_shared_textures_.clear();
@@ -1307,19 +1539,19 @@ void CapsaicinInternal::terminate() noexcept
 
     for (auto const &i : shared_buffers_)
     {
-        gfxDestroyBuffer(gfx_, i.second);
+        DestroyBuffer(gfx_, i.second);
     }
     shared_buffers_.clear();
 
     for (GfxTexture const &texture : texture_atlas_)
     {
-        gfxDestroyTexture(gfx_, texture);
+        DestroyTexture(gfx_, texture);
     }
     texture_atlas_.clear();
 
     for (GfxBuffer const &constant_buffer_pool : constant_buffer_pools_)
     {
-        gfxDestroyBuffer(gfx_, constant_buffer_pool);
+        DestroyBuffer(gfx_, constant_buffer_pool);
     }
     memset(constant_buffer_pools_, 0, sizeof(constant_buffer_pools_));
 
@@ -1327,8 +1559,20 @@ void CapsaicinInternal::terminate() noexcept
     scene_ = {};
 }
 
+void CapsaicinInternal::setShaderHotReload(bool const enabled) noexcept
+{
+    shader_hot_reload_ = enabled;
+}
+
+bool CapsaicinInternal::getShaderHotReload() const noexcept
+{
+    return shader_hot_reload_;
+}
+
 void CapsaicinInternal::reloadShaders() noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+
     // Instead of just recompiling kernels we re-initialise all component/techniques. This has the side
     // effect of not only recompiling kernels but also re-initialising old data that may no longer contain
     // correct values
@@ -1352,6 +1596,7 @@ void CapsaicinInternal::reloadShaders() noexcept
     // Re-initialise the components/techniques
     for (auto const &i : components_)
     {
+        MemoryTracker::OwnerScope const memoryOwner(i.first);
         if (!i.second->init(*this))
         {
             GFX_PRINTLN("Error: Failed to initialise component: %s", i.first.data());
@@ -1359,6 +1604,7 @@ void CapsaicinInternal::reloadShaders() noexcept
     }
     for (auto const &i : render_techniques_)
     {
+        MemoryTracker::OwnerScope const memoryOwner(i->getName());
         if (!i->init(*this))
         {
             GFX_PRINTLN("Error: Failed to initialise render technique: %s", i->getName().data());
@@ -1392,6 +1638,66 @@ ComponentList CapsaicinInternal::getStockComponents() const noexcept
     return {};
 }
 
+void CapsaicinInternal::recordTimestamps(
+    Timeable const &timeable, bool const profile, uint64_t &gpuTime) noexcept
+{
+    auto          &profiler = CPUProfiler::Get();
+    auto const    &queries  = timeable.getTimestampQueries();
+    uint32_t const queryCount =
+        std::min(timeable.getTimestampQueryCount(), static_cast<uint32_t>(queries.size()));
+    // The first query covers the entire timeable, any remaining ones are nested sections executed in order
+    uint64_t childTime = gpuTime;
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        // Durations are returned in milliseconds
+        auto const duration = static_cast<double>(gfxTimestampQueryGetDuration(gfx_, queries[i].query));
+        frame_statistics_.addTimestamp(i > 0 ? queries[0].name : "", queries[i].name, duration);
+        if (profile)
+        {
+            auto const durationNs = static_cast<uint64_t>(duration * 1000000.0);
+            if (i == 0)
+            {
+                profiler.addEvent(queries[0].name, gpuTime, gpuTime + durationNs, CPUProfiler::Track::GPU);
+                gpuTime += durationNs;
+            }
+            else
+            {
+                profiler.addEvent(
+                    queries[i].name, childTime, childTime + durationNs, CPUProfiler::Track::GPU);
+                childTime += durationNs;
+            }
+        }
+    }
+}
+
+void CapsaicinInternal::setProfilingEnabled(bool const enable) noexcept
+{
+#if defined(CAPSAICIN_ENABLE_CPU_PROFILER) && CAPSAICIN_ENABLE_CPU_PROFILER
+    CPUProfiler::Get().setEnabled(enable);
+    profile_frame_start_ = 0;
+#else
+    if (enable)
+    {
+        GFX_PRINTLN("Warning: Profiling requested but CAPSAICIN_ENABLE_CPU_PROFILER was not enabled");
+    }
+#endif
+}
+
+bool CapsaicinInternal::getProfilingEnabled() const noexcept
+{
+    return CPUProfiler::Get().getEnabled();
+}
+
+bool CapsaicinInternal::dumpProfile(std::filesystem::path const &filePath) const noexcept
+{
+    if (!CPUProfiler::Get().saveChromeTrace(filePath))
+    {
+        GFX_PRINTLN("Error: Failed to write profile to '%s'", filePath.string().c_str());
+        return false;
+    }
+    return true;
+}
+
 SharedBufferList CapsaicinInternal::getStockSharedBuffers() const noexcept
 {
     SharedBufferList ret;
@@ -1427,16 +1733,19 @@ void CapsaicinInternal::renderStockGUI() noexcept
 
 void CapsaicinInternal::negotiateRenderTechniques() noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+    MemoryTracker::OwnerScope const memoryOwner(MemoryTracker::kSharedOwner);
+
     // Delete old shared textures and buffers
     for (auto const &i : shared_buffers_)
     {
-        gfxDestroyBuffer(gfx_, i.second);
+        DestroyBuffer(gfx_, i.second);
     }
     shared_buffers_.clear();
     clear_shared_buffers_.clear();
     for (auto const &i : shared_textures_)
     {
-        gfxDestroyTexture(gfx_, i.second);
+        DestroyTexture(gfx_, i.second);
     }
     shared_textures_.clear();
     backup_shared_textures_.clear();
@@ -1628,7 +1937,7 @@ void CapsaicinInternal::negotiateRenderTechniques() noexcept
             }
 
             // Create new buffer
-            GfxBuffer buffer     = gfxCreateBuffer(gfx_, i.second.size);
+            GfxBuffer buffer     = CreateBuffer(gfx_, i.second.size);
             auto      bufferName = std::string(i.first);
             bufferName += "SharedBuffer";
             buffer.setName(bufferName.c_str());
@@ -1952,7 +2261,7 @@ void CapsaicinInternal::negotiateRenderTechniques() noexcept
             GfxTexture           texture;
             if (all(greaterThan(textureParams.dimensions, uint2(0))))
             {
-                texture = gfxCreateTexture2D(gfx_, textureParams.dimensions.x, textureParams.dimensions.y,
+                texture = CreateTexture2D(gfx_, textureParams.dimensions.x, textureParams.dimensions.y,
                     textureParams.format,
                     textureParams.mips
                         ? gfxCalculateMipCount(textureParams.dimensions.x, textureParams.dimensions.y)
@@ -1966,7 +2275,7 @@ void CapsaicinInternal::negotiateRenderTechniques() noexcept
                 auto textureDimensions =
                     (textureName != "ColorScaled") ? render_dimensions_ : window_dimensions_;
                 texture =
-                    gfxCreateTexture2D(gfx_, textureDimensions.x, textureDimensions.y, textureParams.format,
+                    CreateTexture2D(gfx_, textureDimensions.x, textureDimensions.y, textureParams.format,
                         textureParams.mips
                             ? gfxCalculateMipCount(textureParams.dimensions.x, textureParams.dimensions.y)
                             : 1,
@@ -1983,7 +2292,7 @@ void CapsaicinInternal::negotiateRenderTechniques() noexcept
                 GfxTexture texture2;
                 if (all(greaterThan(textureParams.dimensions, uint2(0))))
                 {
-                    texture2 = gfxCreateTexture2D(gfx_, textureParams.dimensions.x,
+                    texture2 = CreateTexture2D(gfx_, textureParams.dimensions.x,
                         textureParams.dimensions.y, textureParams.format,
                         textureParams.mips
                             ? gfxCalculateMipCount(textureParams.dimensions.x, textureParams.dimensions.y)
@@ -1994,7 +2303,7 @@ void CapsaicinInternal::negotiateRenderTechniques() noexcept
                 {
                     auto textureDimensions =
                         (textureName != "ColorScaled") ? render_dimensions_ : window_dimensions_;
-                    texture2 = gfxCreateTexture2D(gfx_, textureDimensions.x, textureDimensions.y,
+                    texture2 = CreateTexture2D(gfx_, textureDimensions.x, textureDimensions.y,
                         textureParams.format,
                         textureParams.mips
                             ? gfxCalculateMipCount(textureParams.dimensions.x, textureParams.dimensions.y)
@@ -2084,6 +2393,8 @@ void CapsaicinInternal::negotiateRenderTechniques() noexcept
 
 void CapsaicinInternal::setupRenderTechniques(std::string_view const &name) noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+
     // Clear any existing shared textures
     for (auto const &i : shared_textures_)
     {
@@ -2092,6 +2403,7 @@ void CapsaicinInternal::setupRenderTechniques(std::string_view const &name) noex
 
     // Delete any existing render techniques
     render_techniques_.clear();
+    program_owners_.clear();
 
     gfxFinish(gfx_); // flush & sync
 
@@ -2234,6 +2546,7 @@ void CapsaicinInternal::setupRenderTechniques(std::string_view const &name) noex
         for (auto const &i : components_)
         {
             i.second->setGfxContext(gfx_);
+            MemoryTracker::OwnerScope const memoryOwner(i.first);
             if (!i.second->init(*this))
             {
                 GFX_PRINTLN("Error: Failed to initialise component: %s", i.first.data());
@@ -2244,6 +2557,7 @@ void CapsaicinInternal::setupRenderTechniques(std::string_view const &name) noex
         for (auto const &i : render_techniques_)
         {
             i->setGfxContext(gfx_);
+            MemoryTracker::OwnerScope const memoryOwner(i->getName());
             if (!i->init(*this))
             {
                 GFX_PRINTLN("Error: Failed to initialise render technique: %s", i->getName().data());
@@ -21,15 +21,25 @@ THE SOFTWARE.
 ********************************************************************/
 #pragma once
 
+#include "async_writer.h"
+#include "camera_path.h"
 #include "capsaicin.h"
+#include "cpu_environment_map.h"
+#include "frame_sequence.h"
+#include "frame_statistics.h"
+#include "gpu_lut_cache.h"
+#include "gpu_memory.h"
 #include "gpu_shared.h"
-#include "graph.h"
+#include "lut_cache.h"
+#include "readback_pool.h"
 #include "renderer.h"
+#include "shader_dependencies.h"
 
 #include <deque>
 #include <filesystem>
 #include <gfx_imgui.h>
 #include <gfx_scene.h>
+#include <set>
 
 namespace Capsaicin
 {
@@ -98,6 +108,28 @@ class CapsaicinInternal
      */
     [[nodiscard]] double getAverageFrameTime() const noexcept;
 
+    /**
+     * Get statistics of all frame times recorded since the last reset.
+     * @return The frame time statistics.
+     */
+    [[nodiscard]] TimingStatistics getFrameTimeStatistics() const noexcept;
+
+    /**
+     * Get statistics of each GPU timestamp recorded since the last reset.
+     * @return The statistics for each timestamp, nested timestamps are named 'parent/child'.
+     */
+    [[nodiscard]] std::map<std::string, TimingStatistics> getTimestampStatistics() const noexcept;
+
+    /** Discard all currently recorded frame time and GPU timestamp statistics. */
+    void resetFrameStatistics() noexcept;
+
+    /**
+     * Saves all currently recorded frame time and GPU timestamp statistics to disk.
+     * @param filePath Full pathname to the file to save as (.json for JSON, otherwise CSV).
+     * @return True if successful, False otherwise.
+     */
+    bool saveFrameStatistics(std::filesystem::path const &filePath) const noexcept;
+
     /**
      * Check if the current scene has any usable animations.
      * @return True if animations are present, False otherwise.
@@ -259,6 +291,13 @@ class CapsaicinInternal
      */
     [[nodiscard]] bool getEnvironmentMapUpdated() const noexcept;
 
+    /**
+     * Gets a hash of all inputs used to generate the current environment buffer.
+     * Used to key cached data derived from the environment map.
+     * @return The hash, zero if there is no environment map or its source file could not be read.
+     */
+    [[nodiscard]] uint64_t getEnvironmentMapHash() const noexcept;
+
     /**
      * Gets the list of currently available shared textures.
      * @return The shared texture list.
@@ -445,6 +484,32 @@ class CapsaicinInternal
      */
     void setSceneCameraRange(glm::vec2 const &nearFar) noexcept;
 
+    /**
+     * Starts recording the state of the active camera each rendered frame.
+     * @note Any previously recorded or playing camera path is discarded.
+     */
+    void startCameraPathRecording() noexcept;
+
+    /**
+     * Stops recording the camera path and saves it to disk.
+     * @param filePath Full pathname to the file to save as.
+     * @return True if successful, False otherwise.
+     */
+    bool stopCameraPathRecording(std::filesystem::path const &filePath) noexcept;
+
+    /**
+     * Plays back a recorded camera path, overriding the active camera each rendered frame.
+     * @note Recorded jitter is only used when the frame count matches the recording, otherwise the path is
+     * interpolated and the normal jitter sequence is used.
+     * @param filePath   Full pathname to the camera path to load.
+     * @param frameCount Number of frames to play the path back over, 0 to use the recorded frame count.
+     * @return True if successful, False otherwise.
+     */
+    bool playCameraPath(std::filesystem::path const &filePath, uint32_t frameCount) noexcept;
+
+    /** Stops any currently playing camera path, the camera remains at its current position. */
+    void stopCameraPath() noexcept;
+
     /**
      * Gets the currently set environment map.
      * @return The current environment map name.
@@ -647,6 +712,40 @@ class CapsaicinInternal
      */
     [[nodiscard]] uint64_t getBvhDataSize() const noexcept;
 
+    /**
+     * Gets the memory used by the buffers and textures allocated by each component and render technique.
+     * @return The memory usage for each owner.
+     */
+    [[nodiscard]] std::map<std::string, MemoryUsage> getMemoryUsage() const noexcept;
+
+    /**
+     * Gets the combined memory used by all buffers and textures allocated by Capsaicin.
+     * @return The total memory usage.
+     */
+    [[nodiscard]] MemoryUsage getTotalMemoryUsage() const noexcept;
+
+    /** Reset all memory usage high-water marks to the current memory usage. */
+    void resetMemoryPeaks() noexcept;
+
+    /**
+     * Gets the pool of readback buffers used for all CPU readbacks.
+     * @return The readback pool.
+     */
+    [[nodiscard]] ReadbackPool &getReadbackPool() const noexcept;
+
+    /**
+     * Gets the disk cache used for precomputed lookup textures.
+     * @return The lookup table cache.
+     */
+    [[nodiscard]] LutCache &getLutCache() const noexcept;
+
+    /**
+     * Gets the helper used to load lookup textures from, and save them to, the lookup table cache.
+     * @note Shared so that its program and kernels are only created once, check isValid() before use.
+     * @return The GPU lookup table cache helper.
+     */
+    [[nodiscard]] GPULutCache &getGPULutCache() const noexcept;
+
     [[nodiscard]] GfxBuffer                    getInstanceBuffer() const;
     [[nodiscard]] std::vector<Instance> const &getInstanceData() const;
     [[nodiscard]] GfxBuffer                    getInstanceIdBuffer() const;
@@ -752,9 +851,20 @@ class CapsaicinInternal
     /**
      * Create a new program using provided file name.
      * @param file_name     Name of the program.
+     * @param owner         Name of the component/technique using the program, used to reload it when its
+     *                      source files change.
      * @return New program.
      */
-    [[nodiscard]] GfxProgram createProgram(char const *file_name) const noexcept;
+    [[nodiscard]] GfxProgram createProgram(
+        char const *file_name, std::string_view const &owner) const noexcept;
+
+    /**
+     * Gets a combined hash of all source files used by a program.
+     * Used to invalidate cached data generated by the program whenever its source changes.
+     * @param file_name Name of the program (as passed to createProgram).
+     * @return The hash.
+     */
+    [[nodiscard]] uint64_t getProgramHash(char const *file_name) const noexcept;
 
     /**
      * Initializes Capsaicin. Must be called before any other functions.
@@ -784,6 +894,19 @@ class CapsaicinInternal
      */
     void reloadShaders() noexcept;
 
+    /**
+     * Enable/disable automatic reloading of shaders whenever their source files are modified.
+     * @note Only the components/techniques using a modified file are re-initialised.
+     * @param enabled True to enable, False to disable.
+     */
+    void setShaderHotReload(bool enabled) noexcept;
+
+    /**
+     * Check if shaders are automatically reloaded when their source files are modified.
+     * @return True if enabled, False otherwise.
+     */
+    [[nodiscard]] bool getShaderHotReload() const noexcept;
+
     /**
      * Saves an debug view to disk.
      * @param filePath Full pathname to the file to save as.
@@ -791,6 +914,16 @@ class CapsaicinInternal
      */
     void dumpDebugView(std::filesystem::path const &filePath, std::string_view const &texture);
 
+    /**
+     * Saves multiple AOVs to a single multi-layer EXR file.
+     * All AOVs are read back using a single buffer, each is written as a separate layer with channels named
+     * 'AOV.R', 'AOV.G' etc. Camera matrices and the frame index are stored as header attributes.
+     * @param filePath Full pathname to the file to save as (must have a .exr extension).
+     * @param aovs     The shared textures to save, must all have the same dimensions.
+     * @return True if successful, False if any AOV is invalid.
+     */
+    bool dumpAOVs(std::filesystem::path const &filePath, std::vector<std::string_view> const &aovs);
+
     /**
      * Saves current camera attributes to disk.
      * @param filePath   Full pathname to the file to save as.
@@ -798,6 +931,62 @@ class CapsaicinInternal
      */
     void dumpCamera(std::filesystem::path const &filePath, bool jittered) const;
 
+    /**
+     * Waits for all pending debug view dumps to be written to disk.
+     * @note Dumps are otherwise written asynchronously several frames after being requested.
+     */
+    void flushDumps() noexcept;
+
+    /**
+     * Opens a frame sequence file that subsequent appendFrameSequence calls write to.
+     * Any currently open sequence is closed first.
+     * @param filePath Full pathname to the file to save as (.capseq for raw planes, .y4m for 8bit video).
+     * @return True if successful, False otherwise.
+     */
+    bool openFrameSequence(std::filesystem::path const &filePath) noexcept;
+
+    /**
+     * Appends the current contents of a debug view to the open frame sequence.
+     * @note The first frame determines the dimensions and format that all later frames must match.
+     * @param texture The buffer to save (get available from @getSharedTextures()).
+     * @return True if successful, False otherwise.
+     */
+    bool appendFrameSequence(std::string_view const &texture) noexcept;
+
+    /** Writes all pending frames and closes the open frame sequence. */
+    void closeFrameSequence() noexcept;
+
+    /**
+     * Sets the compression used for any subsequent EXR dumps.
+     * @param compression The compression type.
+     */
+    void setEXRCompression(EXRCompression compression) noexcept;
+
+    /**
+     * Gets the compression used for EXR dumps.
+     * @return The compression type.
+     */
+    [[nodiscard]] EXRCompression getEXRCompression() const noexcept;
+
+    /**
+     * Enable or disable recording of CPU and GPU profiling events.
+     * @param enable True to enable profiling.
+     */
+    void setProfilingEnabled(bool enable) noexcept;
+
+    /**
+     * Check if profiling events are currently being recorded.
+     * @return True if enabled, False otherwise.
+     */
+    [[nodiscard]] bool getProfilingEnabled() const noexcept;
+
+    /**
+     * Saves all recorded profiling events to disk as a Chrome trace.
+     * @param filePath Full pathname to the file to save as.
+     * @return True if successful, False otherwise.
+     */
+    bool dumpProfile(std::filesystem::path const &filePath) const noexcept;
+
 private:
     /*
      * Gets configuration options specific to capsaicin itself.
@@ -828,6 +1017,14 @@ class CapsaicinInternal
      */
     [[nodiscard]] ComponentList getStockComponents() const noexcept;
 
+    /**
+     * Adds the previous frames GPU timestamps of a timeable to the frame statistics and profiler GPU track.
+     * @param timeable         The timeable to read timestamps from.
+     * @param profile          True to also add the timestamps to the profiler.
+     * @param [in,out] gpuTime Profiler time to place the timestamps at, advanced by the total duration.
+     */
+    void recordTimestamps(Timeable const &timeable, bool profile, uint64_t &gpuTime) noexcept;
+
     /**
      * Gets a list of any shared buffers specific to capsaicin itself.
      * @return A list of all supported buffers.
@@ -865,6 +1062,18 @@ class CapsaicinInternal
      */
     void setupRenderTechniques(std::string_view const &name) noexcept;
 
+    /**
+     * Scan all shader source files to find their contents and include dependencies.
+     * Files are scanned in parallel, any files not found here are scanned on demand later.
+     */
+    void scanShaderSources() noexcept;
+
+    /**
+     * Check for modified shader source files and re-initialise any components/techniques that use them.
+     * Should only be called at the start of a frame.
+     */
+    void reloadModifiedShaders() noexcept;
+
     /**
      * Reset current frame index and duration state.
      * This should be called whenever any renderer or scene changes are made.
@@ -876,17 +1085,6 @@ class CapsaicinInternal
      */
     void resetRenderState() const noexcept;
 
-    void dumpBuffer(char const *file_path, GfxTexture dump_buffer);
-    void saveImage(GfxBuffer dump_buffer, uint32_t dump_buffer_width, uint32_t dump_buffer_height,
-        char const *file_path);
-    void saveEXR(GfxBuffer dump_buffer, uint32_t dump_buffer_width, uint32_t dump_buffer_height,
-        char const *exr_file_path);
-    void saveJPG(GfxBuffer dump_buffer, uint32_t dump_buffer_width, uint32_t dump_buffer_height,
-        char const *jpg_file_path);
-    void savePNG(GfxBuffer dump_buffer, uint32_t dump_buffer_width,
-        uint32_t dump_buffer_height, char const *png_file_path);
-    void dumpCamera(char const *file_path, CameraMatrices const &camera_matrices, float camera_jitter_x,
-        float camera_jitter_y);
     /**
      * Reset any internal events to their default state.
      */
@@ -973,15 +1171,76 @@ class CapsaicinInternal
      */
     void updateSceneBVH(bool animationGPUUpdated) noexcept;
 
-    void dumpTexture(std::filesystem::path const &filePath, GfxTexture const &texture);
-    void saveImage(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
+    /** A single texture within a dump readback buffer */
+    struct DumpLayer
+    {
+        std::string name;   /**< Name of the EXR layer, empty for single texture dumps */
+        DXGI_FORMAT format; /**< Format of the texture data */
+        uint64_t    offset; /**< Offset of the texture data within the readback buffer (bytes) */
+    };
+
+    /** Additional attributes written to the header of multi-layer EXR dumps and frame sequence indices */
+    struct DumpMetadata
+    {
+        glm::mat4 view;           /**< World to camera transform */
+        glm::mat4 viewProjection; /**< World to NDC transform */
+        glm::vec2 jitter;         /**< Sub-pixel camera jitter */
+        uint32_t  frameIndex;
+        float     frameTime;      /**< Frame time (ms) */
+    };
+
+    /**
+     * Gets the texture that should be dumped for a debug view.
+     * @param texture  The debug view or AOV name.
+     * @param isSDR    True if the output format is low dynamic range and should use the tone-mapped output.
+     * @return The texture.
+     */
+    [[nodiscard]] GfxTexture getDumpTexture(std::string_view const &texture, bool isSDR) const;
+
+    /**
+     * Gets the current frame attributes stored with dumps.
+     * @return The metadata.
+     */
+    [[nodiscard]] DumpMetadata getDumpMetadata() const noexcept;
+
+    /**
+     * Queue a texture to be read back and saved.
+     * @param filePath Full pathname to the file to save as, ignored for sequence frames.
+     * @param texture  The texture to save.
+     * @param sequence True to append the texture to the open frame sequence.
+     * @return True if successful, False otherwise.
+     */
+    bool dumpTexture(std::filesystem::path const &filePath, GfxTexture const &texture, bool sequence);
+
+    /**
+     * Converts a read back texture and appends it to the open frame sequence.
+     * @note Called on the frame sequence writer thread.
+     * @param bufferData   The texture data.
+     * @param bufferFormat Format of the texture data.
+     * @param metadata     Attributes of the frame the texture was read back from.
+     */
+    void writeSequenceFrame(
+        void const *bufferData, DXGI_FORMAT bufferFormat, DumpMetadata const &metadata) noexcept;
+
+    /**
+     * Queue writes for all in flight dump requests whose readback has completed.
+     * Encoding and writing is performed on the dump writer threads, readback buffers are released once
+     * their write has finished.
+     * @param flush True to queue all requests regardless of remaining delay and wait for them to complete.
+     */
+    void processDumpRequests(bool flush) noexcept;
+
+    static void saveImage(void const *bufferData, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
+        uint32_t dumpBufferHeight, std::filesystem::path const &filePath, EXRCompression compression);
+    static void saveEXR(void const *bufferData, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
+        uint32_t dumpBufferHeight, std::filesystem::path const &filePath, EXRCompression compression);
+    static void saveEXRLayers(void const *bufferData, std::vector<DumpLayer> const &layers,
+        uint32_t dumpBufferWidth, uint32_t dumpBufferHeight, DumpMetadata const &metadata,
+        std::filesystem::path const &filePath, EXRCompression compression);
+    static void saveJPG(void const *bufferData, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
         uint32_t dumpBufferHeight, std::filesystem::path const &filePath);
-    void saveEXR(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
+    static void savePNG(void const *bufferData, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
         uint32_t dumpBufferHeight, std::filesystem::path const &filePath);
-    void saveJPG(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
-        uint32_t dumpBufferHeight, std::filesystem::path const &filePath) const;
-    void savePNG(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
-        uint32_t dumpBufferHeight, std::filesystem::path const &filePath) const;
     void dumpCamera(CameraMatrices const &cameraMatrices, float cameraJitterX, float cameraJitterY,
         std::filesystem::path const &filePath) const;
 
@@ -1008,9 +1267,17 @@ class CapsaicinInternal
     bool   materials_updated_         = true;
     bool   instances_updated_         = true;
 
-    GfxContext  gfx_; /**< The graphics context to be used. */
-    std::string shader_path_;
-    std::string third_party_shader_path_;
+    GfxContext         gfx_; /**< The graphics context to be used. */
+    std::string        shader_path_;
+    std::string        third_party_shader_path_;
+    mutable ShaderDependencies shader_dependencies_; /**< Contents and includes of all shader source files */
+
+    /** Components/techniques that created each program (keyed by program path) */
+    mutable std::map<std::filesystem::path, std::set<std::string>> program_owners_;
+
+    bool   shader_hot_reload_ = false; /**< Automatically reload shaders when source files change */
+    double shader_check_time_ = 0.0;   /**< Time that source files were last checked for changes */
+
     float render_scale_      = 1.0F; /**< The ratio between render resolution and display/window resolution */
     uint2 render_dimensions_ = uint2(0); /**< The normal rendering resolution */
     uint2 window_dimensions_ =
@@ -1021,13 +1288,17 @@ class CapsaicinInternal
     GfxTexture                         environment_buffer_;
     std::vector<std::filesystem::path> scene_files_;
     std::filesystem::path              environment_map_file_;
-    uint2 environment_map_source_dimensions_ {}; /** Original size of source envMap */
+    CPUEnvironmentMap environment_map_source_;        /**< Decoded source, empty if loaded from cache */
+    uint64_t          environment_map_file_hash_ = 0; /**< Hash of the contents of environment_map_file_ */
+    uint64_t          environment_map_hash_      = 0; /**< Hash of all inputs used to generate the cube map */
 
     uint32_t frame_index_ =
         std::numeric_limits<uint32_t>::max(); /**< Current frame number (incremented each render call) */
     double current_time_ = 0.0;               /**< Current wall clock time used for timing (seconds) */
     double frame_time_   = 0.0;               /**< Elapsed frame time for most recent frame (seconds) */
 
+    uint64_t profile_frame_start_ = 0; /**< Profiler time that the most recent frame was started at */
+
     bool   play_paused_           = true;  /**< Current animation play/paused state (True if paused) */
     bool   play_fixed_framerate_  = false; /**< Current animation playback mode (True if fixed frame rate) */
     double play_time_             = 0.0F;  /**< Current animation absolute playback position (s) */
@@ -1044,6 +1315,12 @@ class CapsaicinInternal
     float2    camera_jitter_ {};        /**< Jitter applied to camera matrices (x, y) respectively */
     GfxCamera camera_prev_;             /**< Camera used in the previous frame */
 
+    CameraPath camera_path_;                     /**< Camera path being recorded or played back */
+    bool       camera_path_recording_   = false;
+    bool       camera_path_playing_     = false;
+    uint32_t   camera_path_frame_       = 0;     /**< Current frame of camera path playback */
+    uint32_t   camera_path_frame_count_ = 0;     /**< Number of frames the path is played back over */
+
     RenderOptionList options_; /**< Options for controlling the operation of each render technique */
 
     std::vector<std::unique_ptr<RenderTechnique>>
@@ -1124,11 +1401,36 @@ class CapsaicinInternal
     // Scene statistics for currently loaded scene
     uint32_t triangle_count_ = 0;
 
-    Graph frameGraph; /**< The stored frame history graph */
+    FrameStatistics frame_statistics_; /**< Frame time and GPU timestamp statistics */
+
+    struct DumpRequest
+    {
+        GfxBuffer              buffer;         /**< Readback buffer the textures are copied into */
+        std::vector<DumpLayer> layers;
+        uint32_t               width;
+        uint32_t               height;
+        std::filesystem::path  filePath;
+        DumpMetadata           metadata;
+        EXRCompression         compression;    /**< EXR compression selected when the dump was requested */
+        bool                   sequence;       /**< Append to the open frame sequence instead of filePath */
+        uint32_t               remainingDelay; /**< Frames until the readback is available */
+        std::future<void>      written;        /**< Valid once the write has been queued */
+    };
+
+    std::deque<DumpRequest> dump_in_flight_buffers_; /**< In flight dumpDebugView requests */
+    AsyncWriter             dump_writer_;            /**< Encodes and writes dumped images to disk */
+    EXRCompression          dump_exr_compression_ = EXRCompression::PIZ;
+    mutable LutCache        lut_cache_;     /**< Must outlive readback_pool_ as callbacks may use it */
+    mutable GPULutCache     gpu_lut_cache_; /**< Shared pack/unpack kernels for lookup textures */
+    mutable ReadbackPool    readback_pool_; /**< Shared readback buffers for dumps and GPUReadback */
+
+    std::filesystem::path frame_sequence_path_;                             /**< Empty if none is open */
+    DXGI_FORMAT           frame_sequence_format_     = DXGI_FORMAT_UNKNOWN; /**< Format of the first frame */
+    uint2                 frame_sequence_dimensions_ = uint2(0);
+    FrameSequenceWriter   frame_sequence_;                                  /**< Writer thread only */
+    std::vector<uint8_t>  frame_sequence_planes_;                           /**< Reused conversion buffer */
+    AsyncWriter           frame_sequence_writer_ {1};                       /**< Writes frames in order */
 
-    std::deque<std::tuple<GfxBuffer, DXGI_FORMAT, uint32_t /*width*/, uint32_t /*height*/,
-        std::filesystem::path, uint32_t /*remainingDelay*/>>
-               dump_in_flight_buffers_; /**< In flight dumpDebugView requests */
     GfxKernel  generate_animated_vertices_kernel_;
     GfxProgram generate_animated_vertices_program_;
 };
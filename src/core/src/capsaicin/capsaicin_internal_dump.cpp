@@ -20,7 +20,13 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ********************************************************************/
 #include "capsaicin_internal.h"
+#include "cpu_profiler.h"
+#include "exr_writer.h"
+#include "pixel_conversion.h"
 
+#include <array>
+#include <chrono>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <stb_image_write.h>
@@ -28,41 +34,6 @@ THE SOFTWARE.
 
 namespace Capsaicin
 {
-
-static uint32_t GetBitsPerPixel(const DXGI_FORMAT format) noexcept
-{
-    switch (format)
-    {
-    case DXGI_FORMAT_R32G32B32A32_FLOAT: [[fallthrough]];
-    case DXGI_FORMAT_R32G32B32A32_UINT: return 128;
-    case DXGI_FORMAT_R32G32B32_FLOAT: [[fallthrough]];
-    case DXGI_FORMAT_R32G32B32_UINT: return 96;
-    case DXGI_FORMAT_R16G16B16A16_FLOAT: [[fallthrough]];
-    case DXGI_FORMAT_R16G16B16A16_UNORM: [[fallthrough]];
-    case DXGI_FORMAT_R16G16B16A16_UINT: [[fallthrough]];
-    case DXGI_FORMAT_R32G32_FLOAT: [[fallthrough]];
-    case DXGI_FORMAT_R32G32_UINT: return 64;
-    case DXGI_FORMAT_R8G8B8A8_UNORM: [[fallthrough]];
-    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB: [[fallthrough]];
-    case DXGI_FORMAT_R8G8B8A8_UINT: [[fallthrough]];
-    case DXGI_FORMAT_R16G16_FLOAT: [[fallthrough]];
-    case DXGI_FORMAT_R16G16_UNORM: [[fallthrough]];
-    case DXGI_FORMAT_R16G16_UINT: [[fallthrough]];
-    case DXGI_FORMAT_D32_FLOAT: [[fallthrough]];
-    case DXGI_FORMAT_R32_FLOAT: [[fallthrough]];
-    case DXGI_FORMAT_R32_UINT: return 32;
-    case DXGI_FORMAT_R8G8_UNORM: [[fallthrough]];
-    case DXGI_FORMAT_R8G8_UINT: [[fallthrough]];
-    case DXGI_FORMAT_R16_FLOAT: [[fallthrough]];
-    case DXGI_FORMAT_D16_UNORM: [[fallthrough]];
-    case DXGI_FORMAT_R16_UNORM: [[fallthrough]];
-    case DXGI_FORMAT_R16_UINT: return 16;
-    case DXGI_FORMAT_R8_UNORM: [[fallthrough]];
-    case DXGI_FORMAT_R8_UINT: return 8;
-    default: return 0;
-    }
-}
-
 static uint32_t GetNumChannels(const DXGI_FORMAT format) noexcept
 {
     switch (format)
@@ -170,118 +141,85 @@ static T ConvertType(TFrom source) noexcept
     }
 }
 
-void CapsaicinInternal::dumpDebugView(std::filesystem::path const &filePath, std::string_view const &texture)
-{
-    if (filePath.has_extension())
-    {
-        if (hasSharedTexture(texture))
-        {
-            GfxTexture dump_buffer = getSharedTexture(texture);
-            if (texture != "Color" && texture != "ColorScaled")
-            {
-                // Check extension, with non HDR image writes we want to output the tone-mapped image
-                // instead of the raw AOV data
-                auto extension = filePath.extension().string();
-                std::ranges::transform(extension, extension.begin(), tolower);
-                if (extension == ".jpg" || extension == ".jpeg" || extension == ".png")
-                {
-                    dump_buffer = currentView;
-                }
-            }
-            dumpTexture(filePath, dump_buffer);
-        }
-        else
-        {
-            // Any dump request that is not an AOV should be a debug view. Debug views write to the debug
-            // target so dump that
-            dumpTexture(filePath, getSharedTexture("Debug"));
-        }
-    }
-}
-
-// clang-format off
-void CapsaicinInternal::dumpCamera(std::filesystem::path const &filePath, bool const jittered) const
-{
-    dumpCamera(camera_matrices_[jittered], jittered ? camera_jitter_.x : 0.F,
-        jittered ? camera_jitter_.y : 0.F, filePath);
-}
-
-void CapsaicinInternal::dumpTexture(std::filesystem::path const &filePath, GfxTexture const &texture)
-{
-    uint32_t const dumpBufferWidth =
-        texture.getWidth() > 0 ? texture.getWidth() : gfxGetBackBufferWidth(gfx_);
-    uint32_t const dumpBufferHeight =
-        texture.getHeight() > 0 ? texture.getHeight() : gfxGetBackBufferHeight(gfx_);
-    uint32_t       dump_buffer_size = dumpBufferWidth * dumpBufferHeight;
-    uint32_t const bytesPerPixel    = GetBitsPerPixel(texture.getFormat()) / 8;
-    GFX_ASSERT(bytesPerPixel != 0);
-    dump_buffer_size *= bytesPerPixel;
-
-    GfxBuffer dumpBuffer = gfxCreateBuffer(gfx_, dump_buffer_size, nullptr, kGfxCpuAccess_Read);
-    dumpBuffer.setStride(bytesPerPixel);
-    dumpBuffer.setName("Capsaicin_DumpBuffer");
-    gfxCommandCopyTextureToBuffer(gfx_, dumpBuffer, texture);
+/** Number of pixels converted at a time, small enough for intermediate data to remain in cache */
+constexpr size_t kConversionChunkSize = 1024;
 
-    dump_in_flight_buffers_.emplace_back(dumpBuffer, texture.getFormat(), dumpBufferWidth, dumpBufferHeight,
-        filePath, gfxGetBackBufferCount(gfx_));
-}
-
-void CapsaicinInternal::saveImage(GfxBuffer const &dumpBuffer, const DXGI_FORMAT bufferFormat,
-    uint32_t const dumpBufferWidth, uint32_t const dumpBufferHeight, std::filesystem::path const &filePath)
+/**
+ * Quantizes interleaved pixel data to 8bit RGB.
+ * @param source       The interleaved pixel data.
+ * @param channelCount Number of channels in each source pixel (range [1, 4]).
+ * @param pixelCount   Number of pixels to quantize.
+ * @param destination  Output RGB data, channels missing from the source are set to zero.
+ */
+template<typename T>
+static void QuantizeToRGB8(
+    T const *source, uint32_t const channelCount, size_t const pixelCount, uint8_t *destination) noexcept
 {
-    if (filePath.has_extension())
+    std::array<float, kConversionChunkSize * 4>   values;
+    std::array<uint8_t, kConversionChunkSize * 4> quantized;
+    for (size_t first = 0; first < pixelCount; first += kConversionChunkSize)
     {
-        auto extension = filePath.extension().string();
-        std::ranges::transform(extension, extension.begin(), tolower);
-        if (extension == ".jpg" || extension == ".jpeg")
+        size_t const count      = std::min(kConversionChunkSize, pixelCount - first);
+        size_t const valueCount = count * channelCount;
+        T const     *chunk      = source + first * channelCount;
+        if constexpr (std::is_same_v<T, float>)
         {
-            saveJPG(dumpBuffer, bufferFormat, dumpBufferWidth, dumpBufferHeight, filePath);
+            ConvertFloatToUnorm8(chunk, quantized.data(), valueCount);
         }
-        else if (extension == ".png")
+        else if constexpr (std::is_same_v<T, Half>)
         {
-            savePNG(dumpBuffer, bufferFormat, dumpBufferWidth, dumpBufferHeight, filePath);
+            ConvertHalfToFloat(reinterpret_cast<uint16_t const *>(chunk), values.data(), valueCount);
+            ConvertFloatToUnorm8(values.data(), quantized.data(), valueCount);
         }
-        else if (extension == ".exr")
+        else if constexpr (std::is_same_v<T, uint16_t>)
         {
-            saveEXR(dumpBuffer, bufferFormat, dumpBufferWidth, dumpBufferHeight, filePath);
+            ConvertUnormToFloat(chunk, values.data(), valueCount);
+            ConvertFloatToUnorm8(values.data(), quantized.data(), valueCount);
         }
         else
         {
-            GFX_PRINT_ERROR(kGfxResult_InvalidParameter, "Can't save '%s': Unknown file extension",
-                filePath.string().c_str());
+            std::ranges::transform(chunk, chunk + valueCount, quantized.begin(), ConvertType<uint8_t, T>);
+        }
+        for (size_t pixel = 0; pixel < count; ++pixel)
+        {
+            uint8_t *rgb = destination + (first + pixel) * 3;
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                rgb[channel] = channel < channelCount ? quantized[pixel * channelCount + channel] : 0;
+            }
         }
     }
 }
 
-void CapsaicinInternal::saveEXR(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferFormat,
-    uint32_t dumpBufferWidth, uint32_t dumpBufferHeight, std::filesystem::path const &filePath)
+/** A single planar channel of an EXR image */
+struct EXRChannel
+{
+    std::string          name;
+    int                  pixelType = TINYEXR_PIXELTYPE_FLOAT;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * Converts interleaved texture data into planar EXR channels.
+ * @param bufferData   The texture data.
+ * @param bufferFormat Format of the texture data.
+ * @param pixelCount   Number of pixels in the texture.
+ * @param prefix       Prefix added to each channel name.
+ * @param channels     Output list the new channels are appended to.
+ */
+static void AddEXRChannels(void const *bufferData, DXGI_FORMAT const bufferFormat, uint32_t const pixelCount,
+    std::string const &prefix, std::vector<EXRChannel> &channels)
 {
     uint32_t const inputChannelCount = GetNumChannels(bufferFormat);
     GFX_ASSERT(inputChannelCount > 0 && inputChannelCount <= 4);
     // We use 16bit float buffers for most color buffers, as such the 4th component is unused and can be
     // ignored This may cause issues if we ever use all 4 components of a R16G16B16A16 float buffer, but it
     // works for now
-    uint32_t const    channelCount = bufferFormat == DXGI_FORMAT_R16G16B16A16_FLOAT ? 3 : inputChannelCount;
-    std::vector<char> channelNames(channelCount);
-    switch (channelCount)
-    {
-    case 1: channelNames = {'R'}; break;
-    case 2: channelNames = {'G', 'R'}; break;
-    case 3:
-        channelNames = {'B', 'G', 'R'}; // EXR readers often expect a specific order for RGB channels
-        break;
-    default:
-        channelNames = {'A', 'B', 'G', 'R'}; // EXR readers expect Alpha first
-        // EXR readers default assume pre-multiplied alpha, we do not convert RGB to pre-multiplied to keep
-        // values identical to their internal format. This may cause visual differences when viewing the files
-        break;
-    }
+    uint32_t const channelCount = bufferFormat == DXGI_FORMAT_R16G16B16A16_FLOAT ? 3 : inputChannelCount;
+    // EXR readers default assume pre-multiplied alpha, we do not convert RGB to pre-multiplied to keep
+    // values identical to their internal format. This may cause visual differences when viewing the files
+    constexpr std::array<char, 4> channelNames = {'R', 'G', 'B', 'A'};
 
-    // Image
-    void const    *bufferData         = gfxBufferGetData(gfx_, dumpBuffer);
-    uint32_t const imageWidth         = dumpBufferWidth;
-    uint32_t const imageHeight        = dumpBufferHeight;
-    uint32_t const imagePixelCount    = dumpBufferWidth * dumpBufferHeight;
     uint32_t const bitsPerChannel     = GetBitsPerPixel(bufferFormat) / inputChannelCount;
     int            pixelType          = TINYEXR_PIXELTYPE_FLOAT;
     bool           requiresConversion = false;
@@ -300,52 +238,46 @@ void CapsaicinInternal::saveEXR(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferF
         requiresConversion = true;
     }
 
-    // Header
-    std::vector<EXRChannelInfo> channelInfos;
-    std::vector<int>            pixelTypes;
-    std::vector<int>            requestedPixelTypes;
-    for (char const &channel_name : channelNames)
+    size_t const firstChannel = channels.size();
+    for (uint32_t channel = 0; channel < channelCount; ++channel)
     {
-        auto &channelInfo   = channelInfos.emplace_back();
-        channelInfo.name[0] = channel_name;
-        channelInfo.name[1] = '\0';
-        pixelTypes.push_back(pixelType);
-        requestedPixelTypes.push_back(pixelType);
+        channels.push_back(EXRChannel {prefix + channelNames[channel], pixelType, {}});
     }
-
-    EXRHeader exrHeader;
-    InitEXRHeader(&exrHeader);
-    exrHeader.compression_type      = TINYEXR_COMPRESSIONTYPE_PIZ;
-    exrHeader.num_channels          = static_cast<int>(channelCount);
-    exrHeader.channels              = channelInfos.data();
-    exrHeader.pixel_types           = pixelTypes.data();
-    exrHeader.requested_pixel_types = requestedPixelTypes.data();
-
-    std::vector<unsigned char *>      images(channelNames.size());
-    std::vector<std::vector<uint8_t>> image_channels(channelNames.size());
     auto fillImages = [&]<typename T, typename TFrom>(TFrom const *dumpBufferData) {
-        uint32_t channel = 0;
-        for (char const &channel_name : channelNames)
+        // Output plane for each input channel, channels not written to the file are left as nullptr
+        std::array<T *, 4> planes = {};
+        for (uint32_t channel = 0; channel < channelCount; ++channel)
+        {
+            auto &imageChannel = channels[firstChannel + channel].data;
+            imageChannel.resize(pixelCount * sizeof(T));
+            planes[channel] = reinterpret_cast<T *>(imageChannel.data());
+        }
+        if constexpr (std::is_same_v<T, TFrom>)
+        {
+            SplitChannels(dumpBufferData, inputChannelCount, planes.data(), pixelCount);
+        }
+        else
         {
-            int channelOffset = 0;
-            switch (channel_name)
+            // Split into small planar chunks and then convert each chunk directly into its output plane
+            std::array<std::array<TFrom, kConversionChunkSize>, 4> chunkPlanes;
+            std::array<TFrom *, 4>                                 splitPlanes = {};
+            for (uint32_t offset = 0; offset < 4; ++offset)
             {
-            case 'R': channelOffset = 0; break;
-            case 'G': channelOffset = 1; break;
-            case 'B': channelOffset = 2; break;
-            case 'A': channelOffset = 3; break;
-            default: assert(false);
+                splitPlanes[offset] = planes[offset] != nullptr ? chunkPlanes[offset].data() : nullptr;
             }
-            auto &imageChannel = image_channels[channel];
-            imageChannel.resize(imagePixelCount * sizeof(T));
-            images[channel] = imageChannel.data();
-            for (size_t pixel_index = 0; pixel_index < imagePixelCount; ++pixel_index)
+            for (size_t first = 0; first < pixelCount; first += kConversionChunkSize)
             {
-                auto val =
-                    dumpBufferData[inputChannelCount * pixel_index + static_cast<size_t>(channelOffset)];
-                reinterpret_cast<T *>(imageChannel.data())[pixel_index] = ConvertType<T, TFrom>(val);
+                size_t const count = std::min(kConversionChunkSize, pixelCount - first);
+                SplitChannels(
+                    dumpBufferData + first * inputChannelCount, inputChannelCount, splitPlanes.data(), count);
+                for (uint32_t offset = 0; offset < 4; ++offset)
+                {
+                    if (planes[offset] != nullptr)
+                    {
+                        ConvertUnormToFloat(chunkPlanes[offset].data(), planes[offset] + first, count);
+                    }
+                }
             }
-            ++channel;
         }
     };
     if (requiresConversion)
@@ -367,36 +299,645 @@ void CapsaicinInternal::saveEXR(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferF
     {
         fillImages.operator()<uint16_t, uint16_t>(static_cast<uint16_t const *>(bufferData));
     }
+}
+
+/**
+ * Gets the layout of the frames stored in a frame sequence.
+ * @param bufferFormat Format of the texture data.
+ * @param isY4M        True if frames are written as 8bit RGB video.
+ * @param channelCount Output number of channels stored for each pixel.
+ * @param pixelType    Output type of each stored value.
+ * @return True if the format is supported, False otherwise.
+ */
+static bool GetFrameSequenceLayout(DXGI_FORMAT const bufferFormat, bool const isY4M, uint32_t &channelCount,
+    FrameSequencePixelType &pixelType) noexcept
+{
+    uint32_t const inputChannelCount = GetNumChannels(bufferFormat);
+    if (inputChannelCount == 0)
+    {
+        return false;
+    }
+    if (isY4M)
+    {
+        channelCount = 3;
+        pixelType    = FrameSequencePixelType::UInt8;
+        return true;
+    }
+    // Matches EXR dumps, the alpha channel of 16bit float color buffers is unused
+    channelCount = bufferFormat == DXGI_FORMAT_R16G16B16A16_FLOAT ? 3 : inputChannelCount;
+    uint32_t const bitsPerChannel = GetBitsPerPixel(bufferFormat) / inputChannelCount;
+    if (IsFormatFloat(bufferFormat) || bitsPerChannel == 16)
+    {
+        pixelType = FrameSequencePixelType::Float16;
+        return true;
+    }
+    if (bitsPerChannel == 8)
+    {
+        pixelType = FrameSequencePixelType::UInt8;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Converts interleaved texture data into the planar layout stored in a frame sequence.
+ * @param bufferData   The texture data.
+ * @param bufferFormat Format of the texture data.
+ * @param header       Header of the sequence, the layout must come from GetFrameSequenceLayout.
+ * @param isY4M        True if frames are written as 8bit RGB video.
+ * @param planes       Output frame data.
+ */
+static void ConvertToFrameSequencePlanes(void const *bufferData, DXGI_FORMAT const bufferFormat,
+    FrameSequenceHeader const &header, bool const isY4M, uint8_t *planes) noexcept
+{
+    size_t const   pixelCount        = static_cast<size_t>(header.width) * header.height;
+    uint32_t const inputChannelCount = GetNumChannels(bufferFormat);
+    uint32_t const bitsPerChannel    = GetBitsPerPixel(bufferFormat) / inputChannelCount;
+    bool const     isFloatFormat     = IsFormatFloat(bufferFormat);
+    if (isY4M)
+    {
+        // Quantize a chunk at a time to interleaved RGB and then split into the output planes
+        std::array<uint8_t, kConversionChunkSize * 3> rgb;
+        auto quantize = [&]<typename T>(T const *dumpBufferData) {
+            for (size_t first = 0; first < pixelCount; first += kConversionChunkSize)
+            {
+                size_t const count = std::min(kConversionChunkSize, pixelCount - first);
+                QuantizeToRGB8(
+                    dumpBufferData + first * inputChannelCount, inputChannelCount, count, rgb.data());
+                std::array<uint8_t *, 3> const destinations = {
+                    planes + first, planes + pixelCount + first, planes + 2 * pixelCount + first};
+                SplitChannels(rgb.data(), 3, destinations.data(), count);
+            }
+        };
+        if (bitsPerChannel == 32 && isFloatFormat)
+        {
+            quantize(static_cast<float const *>(bufferData));
+        }
+        else if (bitsPerChannel == 32)
+        {
+            quantize(static_cast<uint32_t const *>(bufferData));
+        }
+        else if (bitsPerChannel == 16 && isFloatFormat)
+        {
+            quantize(static_cast<Half const *>(bufferData));
+        }
+        else if (bitsPerChannel == 16)
+        {
+            quantize(static_cast<uint16_t const *>(bufferData));
+        }
+        else if (bitsPerChannel == 8)
+        {
+            quantize(static_cast<uint8_t const *>(bufferData));
+        }
+        return;
+    }
+
+    // Output plane for each input channel, channels not stored in the sequence are left as nullptr
+    uint64_t const bytesPerValue = header.pixelType == FrameSequencePixelType::Float16 ? 2 : 1;
+    std::array<uint8_t *, 4> outputs       = {};
+    for (uint32_t channel = 0; channel < header.channelCount; ++channel)
+    {
+        outputs[channel] = planes + channel * pixelCount * bytesPerValue;
+    }
+    if (header.pixelType == FrameSequencePixelType::UInt8 || (bitsPerChannel == 16 && isFloatFormat))
+    {
+        // Values are stored unmodified
+        if (bitsPerChannel == 8)
+        {
+            SplitChannels(
+                static_cast<uint8_t const *>(bufferData), inputChannelCount, outputs.data(), pixelCount);
+        }
+        else
+        {
+            std::array<uint16_t *, 4> destinations = {};
+            std::ranges::transform(outputs, destinations.begin(),
+                [](uint8_t *output) { return reinterpret_cast<uint16_t *>(output); });
+            SplitChannels(static_cast<uint16_t const *>(bufferData), inputChannelCount, destinations.data(),
+                pixelCount);
+        }
+        return;
+    }
+
+    // Split into small planar chunks and then convert each chunk directly into its output plane
+    std::array<std::array<float, kConversionChunkSize>, 4>    chunkPlanes;
+    std::array<std::array<uint16_t, kConversionChunkSize>, 4> unormPlanes;
+    std::array<float *, 4>                                    splitPlanes      = {};
+    std::array<uint16_t *, 4>                                 splitUnormPlanes = {};
+    for (uint32_t channel = 0; channel < 4; ++channel)
+    {
+        splitPlanes[channel]      = outputs[channel] != nullptr ? chunkPlanes[channel].data() : nullptr;
+        splitUnormPlanes[channel] = outputs[channel] != nullptr ? unormPlanes[channel].data() : nullptr;
+    }
+    for (size_t first = 0; first < pixelCount; first += kConversionChunkSize)
+    {
+        size_t const count = std::min(kConversionChunkSize, pixelCount - first);
+        if (isFloatFormat)
+        {
+            SplitChannels(static_cast<float const *>(bufferData) + first * inputChannelCount,
+                inputChannelCount, splitPlanes.data(), count);
+        }
+        else
+        {
+            SplitChannels(static_cast<uint16_t const *>(bufferData) + first * inputChannelCount,
+                inputChannelCount, splitUnormPlanes.data(), count);
+        }
+        for (uint32_t channel = 0; channel < header.channelCount; ++channel)
+        {
+            if (!isFloatFormat)
+            {
+                ConvertUnormToFloat(unormPlanes[channel].data(), chunkPlanes[channel].data(), count);
+            }
+            ConvertFloatToHalf(
+                chunkPlanes[channel].data(), reinterpret_cast<uint16_t *>(outputs[channel]) + first, count);
+        }
+    }
+}
+
+/**
+ * Creates an EXR header attribute.
+ * @note The attribute references the value directly so it must remain valid until the image is saved.
+ * @param name  The attribute name.
+ * @param type  The EXR attribute type name.
+ * @param value The attribute value.
+ * @return The attribute.
+ */
+template<typename T>
+static EXRAttribute MakeEXRAttribute(char const *name, char const *type, T const &value) noexcept
+{
+    EXRAttribute attribute {};
+    std::strncpy(attribute.name, name, sizeof(attribute.name) - 1);
+    std::strncpy(attribute.type, type, sizeof(attribute.type) - 1);
+    // tinyexr only reads attribute values when saving
+    attribute.value = const_cast<unsigned char *>(reinterpret_cast<unsigned char const *>(&value));
+    attribute.size  = static_cast<int>(sizeof(T));
+    return attribute;
+}
+
+/**
+ * Saves planar channels to an EXR file.
+ * @param channels    The channels to save, sorted in place into the alphabetical order EXR readers expect.
+ * @param width       The image width.
+ * @param height      The image height.
+ * @param attributes  Additional header attributes.
+ * @param filePath    Full pathname to the file to save as.
+ * @param compression The compression type.
+ */
+static void SaveEXRChannels(std::vector<EXRChannel> &channels, uint32_t const width, uint32_t const height,
+    std::vector<EXRAttribute> attributes, std::filesystem::path const &filePath,
+    EXRCompression const compression)
+{
+    std::ranges::sort(channels, {}, &EXRChannel::name);
+
+    // Header
+    std::vector<EXRChannelInfo>  channelInfos;
+    std::vector<int>             pixelTypes;
+    std::vector<int>             requestedPixelTypes;
+    std::vector<unsigned char *> images;
+    for (auto &channel : channels)
+    {
+        auto &channelInfo = channelInfos.emplace_back();
+        std::strncpy(channelInfo.name, channel.name.c_str(), sizeof(channelInfo.name) - 1);
+        pixelTypes.push_back(channel.pixelType);
+        // Lossy compression stores full precision floats as half
+        bool const toHalf =
+            compression == EXRCompression::Lossy && channel.pixelType == TINYEXR_PIXELTYPE_FLOAT;
+        requestedPixelTypes.push_back(toHalf ? TINYEXR_PIXELTYPE_HALF : channel.pixelType);
+        images.push_back(channel.data.data());
+    }
+
+    EXRHeader exrHeader;
+    InitEXRHeader(&exrHeader);
+    switch (compression)
+    {
+    case EXRCompression::None: exrHeader.compression_type = TINYEXR_COMPRESSIONTYPE_NONE; break;
+    case EXRCompression::PIZ: exrHeader.compression_type = TINYEXR_COMPRESSIONTYPE_PIZ; break;
+    case EXRCompression::ZIP: [[fallthrough]];
+    case EXRCompression::Lossy: [[fallthrough]];
+    default: exrHeader.compression_type = TINYEXR_COMPRESSIONTYPE_ZIP; break;
+    }
+    exrHeader.num_channels          = static_cast<int>(channels.size());
+    exrHeader.channels              = channelInfos.data();
+    exrHeader.pixel_types           = pixelTypes.data();
+    exrHeader.requested_pixel_types = requestedPixelTypes.data();
+    exrHeader.num_custom_attributes = static_cast<int>(attributes.size());
+    exrHeader.custom_attributes     = attributes.empty() ? nullptr : attributes.data();
 
     EXRImage exrImage;
     InitEXRImage(&exrImage);
-    exrImage.num_channels = static_cast<int32_t>(channelCount);
+    exrImage.num_channels = static_cast<int32_t>(channels.size());
     exrImage.images       = images.data();
-    exrImage.width        = static_cast<int32_t>(imageWidth);
-    exrImage.height       = static_cast<int32_t>(imageHeight);
+    exrImage.width        = static_cast<int32_t>(width);
+    exrImage.height       = static_cast<int32_t>(height);
+
+    SaveEXRImageParallel(exrImage, exrHeader, filePath);
+}
+
+void CapsaicinInternal::dumpDebugView(std::filesystem::path const &filePath, std::string_view const &texture)
+{
+    if (filePath.has_extension())
+    {
+        // Check extension, with non HDR image writes we want to output the tone-mapped image instead of the
+        // raw AOV data
+        auto extension = filePath.extension().string();
+        std::ranges::transform(extension, extension.begin(), tolower);
+        bool const isSDR = extension == ".jpg" || extension == ".jpeg" || extension == ".png";
+        dumpTexture(filePath, getDumpTexture(texture, isSDR), false);
+    }
+}
+
+GfxTexture CapsaicinInternal::getDumpTexture(std::string_view const &texture, bool const isSDR) const
+{
+    if (hasSharedTexture(texture))
+    {
+        if (isSDR && texture != "Color" && texture != "ColorScaled")
+        {
+            return currentView;
+        }
+        return getSharedTexture(texture);
+    }
+    // Any dump request that is not an AOV should be a debug view. Debug views write to the debug target so
+    // dump that
+    return getSharedTexture("Debug");
+}
+
+CapsaicinInternal::DumpMetadata CapsaicinInternal::getDumpMetadata() const noexcept
+{
+    return DumpMetadata {glm::mat4(camera_matrices_[0].view), glm::mat4(camera_matrices_[0].view_projection),
+        camera_jitter_, frame_index_, static_cast<float>(frame_time_ * 1000.0)};
+}
+
+// clang-format off
+void CapsaicinInternal::dumpCamera(std::filesystem::path const &filePath, bool const jittered) const
+{
+    dumpCamera(camera_matrices_[jittered], jittered ? camera_jitter_.x : 0.F,
+        jittered ? camera_jitter_.y : 0.F, filePath);
+}
+
+bool CapsaicinInternal::dumpTexture(
+    std::filesystem::path const &filePath, GfxTexture const &texture, bool const sequence)
+{
+    uint32_t const dumpBufferWidth =
+        texture.getWidth() > 0 ? texture.getWidth() : gfxGetBackBufferWidth(gfx_);
+    uint32_t const dumpBufferHeight =
+        texture.getHeight() > 0 ? texture.getHeight() : gfxGetBackBufferHeight(gfx_);
+    uint32_t       dump_buffer_size = dumpBufferWidth * dumpBufferHeight;
+    uint32_t const bytesPerPixel    = GetBitsPerPixel(texture.getFormat()) / 8;
+    if (bytesPerPixel == 0 || GetNumChannels(texture.getFormat()) == 0)
+    {
+        GFX_PRINTLN("Error: Texture format of '%s' is not supported for dumping", texture.getName());
+        return false;
+    }
+    dump_buffer_size *= bytesPerPixel;
+
+    // Pooled readback buffers are reused between dumps, the stride must be set on every use
+    GfxBuffer dumpBuffer = readback_pool_.acquire(dump_buffer_size);
+    if (!dumpBuffer)
+    {
+        GFX_PRINTLN("Error: Failed to create readback buffer for dumping '%s'", texture.getName());
+        return false;
+    }
+    dumpBuffer.setStride(bytesPerPixel);
+    gfxCommandCopyTextureToBuffer(gfx_, dumpBuffer, texture);
+
+    dump_in_flight_buffers_.push_back(DumpRequest {dumpBuffer, {DumpLayer {{}, texture.getFormat(), 0}},
+        dumpBufferWidth, dumpBufferHeight, filePath, getDumpMetadata(), dump_exr_compression_, sequence,
+        gfxGetBackBufferCount(gfx_), {}});
+    return true;
+}
+
+bool CapsaicinInternal::dumpAOVs(
+    std::filesystem::path const &filePath, std::vector<std::string_view> const &aovs)
+{
+    auto extension = filePath.extension().string();
+    std::ranges::transform(extension, extension.begin(), tolower);
+    if (extension != ".exr")
+    {
+        GFX_PRINT_ERROR(kGfxResult_InvalidParameter, "Can't save '%s': AOVs can only be saved as EXR",
+            filePath.string().c_str());
+        return false;
+    }
+    if (aovs.empty())
+    {
+        return false;
+    }
+
+    // Place each AOV at an aligned offset within a single shared readback buffer
+    std::vector<DumpLayer>  layers;
+    std::vector<GfxTexture> textures;
+    uint64_t                dumpBufferSize = 0;
+    for (auto const &aov : aovs)
+    {
+        if (!hasSharedTexture(aov))
+        {
+            GFX_PRINT_ERROR(kGfxResult_InvalidParameter, "Can't save '%s': Unknown AOV '%s'",
+                filePath.string().c_str(), std::string(aov).c_str());
+            return false;
+        }
+        GfxTexture const texture = getSharedTexture(aov);
+        if (uint32_t const bitsPerPixel = GetBitsPerPixel(texture.getFormat());
+            bitsPerPixel == 0 || GetNumChannels(texture.getFormat()) == 0)
+        {
+            GFX_PRINTLN("Error: Texture format of '%s' is not supported for dumping", texture.getName());
+            return false;
+        }
+        if (!textures.empty()
+            && (texture.getWidth() != textures.front().getWidth()
+                || texture.getHeight() != textures.front().getHeight()))
+        {
+            GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
+                "Can't save '%s': AOV '%s' does not match the dimensions of '%s'", filePath.string().c_str(),
+                std::string(aov).c_str(), layers.front().name.c_str());
+            return false;
+        }
+        dumpBufferSize = GFX_ALIGN(dumpBufferSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+        layers.push_back(DumpLayer {std::string(aov), texture.getFormat(), dumpBufferSize});
+        textures.push_back(texture);
+        dumpBufferSize += static_cast<uint64_t>(texture.getWidth()) * texture.getHeight()
+                        * (GetBitsPerPixel(texture.getFormat()) / 8);
+    }
+
+    // Copy all AOVs within the same submission
+    GfxBuffer const dumpBuffer = readback_pool_.acquire(dumpBufferSize);
+    if (!dumpBuffer)
+    {
+        GFX_PRINTLN("Error: Failed to create readback buffer for AOV dump");
+        return false;
+    }
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        uint64_t const layerSize = (i + 1 < layers.size() ? layers[i + 1].offset : dumpBufferSize)
+                                 - layers[i].offset;
+        GfxBuffer layerBuffer = gfxCreateBufferRange(gfx_, dumpBuffer, layers[i].offset, layerSize);
+        layerBuffer.setStride(GetBitsPerPixel(layers[i].format) / 8);
+        gfxCommandCopyTextureToBuffer(gfx_, layerBuffer, textures[i]);
+        DestroyBuffer(gfx_, layerBuffer);
+    }
+
+    dump_in_flight_buffers_.push_back(DumpRequest {dumpBuffer, std::move(layers), textures.front().getWidth(),
+        textures.front().getHeight(), filePath, getDumpMetadata(), dump_exr_compression_, false,
+        gfxGetBackBufferCount(gfx_), {}});
+    return true;
+}
+
+void CapsaicinInternal::flushDumps() noexcept
+{
+    gfxFinish(gfx_); // all readbacks are available after sync
+    processDumpRequests(true);
+}
+
+void CapsaicinInternal::setEXRCompression(EXRCompression const compression) noexcept
+{
+    dump_exr_compression_ = compression;
+}
+
+EXRCompression CapsaicinInternal::getEXRCompression() const noexcept
+{
+    return dump_exr_compression_;
+}
+
+bool CapsaicinInternal::openFrameSequence(std::filesystem::path const &filePath) noexcept
+{
+    closeFrameSequence();
+    try
+    {
+        auto extension = filePath.extension().string();
+        std::ranges::transform(extension, extension.begin(), tolower);
+        if (extension != ".capseq" && extension != ".y4m")
+        {
+            GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
+                "Can't save '%s': Frame sequences can only be saved as .capseq or .y4m",
+                filePath.string().c_str());
+            return false;
+        }
+        // The file is created once the first frame is appended and its dimensions are known
+        frame_sequence_path_ = filePath;
+        frame_sequence_path_.replace_extension(extension);
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
 
-    char const *err = nullptr;
-    if (int const ret = SaveEXRImageToFile(&exrImage, &exrHeader, filePath.string().c_str(), &err);
-        ret != TINYEXR_SUCCESS)
+bool CapsaicinInternal::appendFrameSequence(std::string_view const &texture) noexcept
+{
+    try
     {
-        if (err != nullptr)
+        if (frame_sequence_path_.empty())
+        {
+            GFX_PRINT_ERROR(kGfxResult_InvalidOperation, "Can't append frame: No frame sequence is open");
+            return false;
+        }
+        bool const        isY4M           = frame_sequence_path_.extension() != ".capseq";
+        GfxTexture const  sequenceTexture = getDumpTexture(texture, isY4M);
+        DXGI_FORMAT const format          = sequenceTexture.getFormat();
+        uint2 const       dimensions      = uint2(
+            sequenceTexture.getWidth() > 0 ? sequenceTexture.getWidth() : gfxGetBackBufferWidth(gfx_),
+            sequenceTexture.getHeight() > 0 ? sequenceTexture.getHeight() : gfxGetBackBufferHeight(gfx_));
+        if (!frame_sequence_.isOpen())
+        {
+            uint32_t               channelCount = 0;
+            FrameSequencePixelType pixelType    = FrameSequencePixelType::UInt8;
+            if (!GetFrameSequenceLayout(format, isY4M, channelCount, pixelType))
+            {
+                GFX_PRINTLN("Error: Texture format of '%s' is not supported for frame sequences",
+                    sequenceTexture.getName());
+                return false;
+            }
+            // No frames are queued yet so the writer thread is idle
+            if (!frame_sequence_.open(
+                    frame_sequence_path_, dimensions.x, dimensions.y, channelCount, pixelType))
+            {
+                GFX_PRINTLN(
+                    "Error: Failed to open frame sequence '%s'", frame_sequence_path_.string().c_str());
+                return false;
+            }
+            frame_sequence_format_     = format;
+            frame_sequence_dimensions_ = dimensions;
+        }
+        else if (format != frame_sequence_format_ || dimensions != frame_sequence_dimensions_)
         {
-            GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s': %s", filePath.string().c_str(), err);
-            FreeEXRErrorMessage(err);
+            GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
+                "Can't append '%s': Frame does not match the format and dimensions of the frame sequence",
+                std::string(texture).c_str());
+            return false;
+        }
+        return dumpTexture({}, sequenceTexture, true);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+void CapsaicinInternal::closeFrameSequence() noexcept
+{
+    if (frame_sequence_path_.empty())
+    {
+        return;
+    }
+    if (frame_sequence_.isOpen())
+    {
+        gfxFinish(gfx_); // all readbacks are available after sync
+        processDumpRequests(true);
+        if (!frame_sequence_.close())
+        {
+            GFX_PRINTLN("Error: Failed to write frame sequence '%s'", frame_sequence_path_.string().c_str());
+        }
+    }
+    frame_sequence_path_.clear();
+    frame_sequence_format_     = DXGI_FORMAT_UNKNOWN;
+    frame_sequence_dimensions_ = uint2(0);
+}
+
+void CapsaicinInternal::processDumpRequests(bool const flush) noexcept
+{
+    for (auto &request : dump_in_flight_buffers_)
+    {
+        if (request.written.valid())
+        {
+            continue;
+        }
+        if (!flush && request.remainingDelay > 0)
+        {
+            --request.remainingDelay;
+            continue;
+        }
+        // Readback memory is mapped for the lifetime of the buffer so the writer can read it in place, the
+        // buffer is only released once the write has completed
+        void const *bufferData = gfxBufferGetData(gfx_, request.buffer);
+        if (request.sequence)
+        {
+            // Frames are appended on a dedicated single thread to keep them in order
+            request.written = frame_sequence_writer_.push(
+                [this, bufferData, format = request.layers.front().format, metadata = request.metadata] {
+                    CAPSAICIN_PROFILE_SCOPE("AppendFrameSequence");
+                    writeSequenceFrame(bufferData, format, metadata);
+                });
+            continue;
+        }
+        request.written =
+            dump_writer_.push([bufferData, layers = request.layers, width = request.width,
+                                  height = request.height, filePath = request.filePath,
+                                  metadata = request.metadata, compression = request.compression] {
+                CAPSAICIN_PROFILE_SCOPE("SaveImage");
+                if (layers.size() == 1 && layers.front().name.empty())
+                {
+                    saveImage(bufferData, layers.front().format, width, height, filePath, compression);
+                }
+                else
+                {
+                    saveEXRLayers(bufferData, layers, width, height, metadata, filePath, compression);
+                }
+            });
+    }
+    if (flush)
+    {
+        dump_writer_.flush();
+        frame_sequence_writer_.flush();
+    }
+
+    // Release buffers whose writes have completed, these may finish out of order
+    for (auto request = dump_in_flight_buffers_.begin(); request != dump_in_flight_buffers_.end();)
+    {
+        if (request->written.valid()
+            && request->written.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            readback_pool_.release(request->buffer);
+            request = dump_in_flight_buffers_.erase(request);
         }
         else
         {
-            GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s'", filePath.string().c_str());
+            ++request;
         }
     }
 }
 
-void CapsaicinInternal::saveJPG(GfxBuffer const &dumpBuffer, const DXGI_FORMAT bufferFormat,
-    uint32_t const dumpBufferWidth, uint32_t const dumpBufferHeight,
-    std::filesystem::path const &filePath) const
+void CapsaicinInternal::writeSequenceFrame(
+    void const *bufferData, DXGI_FORMAT const bufferFormat, DumpMetadata const &metadata) noexcept
+{
+    try
+    {
+        // The sequence path is only modified while the writer thread is idle
+        FrameSequenceHeader const &header = frame_sequence_.getHeader();
+        bool const                 isY4M  = frame_sequence_path_.extension() != ".capseq";
+        frame_sequence_planes_.resize(GetFrameSequenceFrameSize(header));
+        ConvertToFrameSequencePlanes(bufferData, bufferFormat, header, isY4M, frame_sequence_planes_.data());
+        if (!frame_sequence_.appendFrame(
+                frame_sequence_planes_.data(), metadata.frameIndex, metadata.frameTime))
+        {
+            GFX_PRINTLN("Error: Failed to append frame %u to frame sequence", metadata.frameIndex);
+        }
+    }
+    catch (...)
+    {
+        GFX_PRINTLN("Error: Failed to append frame %u to frame sequence", metadata.frameIndex);
+    }
+}
+
+void CapsaicinInternal::saveImage(void const *bufferData, const DXGI_FORMAT bufferFormat,
+    uint32_t const dumpBufferWidth, uint32_t const dumpBufferHeight, std::filesystem::path const &filePath,
+    EXRCompression const compression)
+{
+    if (filePath.has_extension())
+    {
+        auto extension = filePath.extension().string();
+        std::ranges::transform(extension, extension.begin(), tolower);
+        if (extension == ".jpg" || extension == ".jpeg")
+        {
+            saveJPG(bufferData, bufferFormat, dumpBufferWidth, dumpBufferHeight, filePath);
+        }
+        else if (extension == ".png")
+        {
+            savePNG(bufferData, bufferFormat, dumpBufferWidth, dumpBufferHeight, filePath);
+        }
+        else if (extension == ".exr")
+        {
+            saveEXR(bufferData, bufferFormat, dumpBufferWidth, dumpBufferHeight, filePath, compression);
+        }
+        else
+        {
+            GFX_PRINT_ERROR(kGfxResult_InvalidParameter, "Can't save '%s': Unknown file extension",
+                filePath.string().c_str());
+        }
+    }
+}
+
+void CapsaicinInternal::saveEXR(void const *bufferData, DXGI_FORMAT bufferFormat,
+    uint32_t dumpBufferWidth, uint32_t dumpBufferHeight, std::filesystem::path const &filePath,
+    EXRCompression const compression)
+{
+    std::vector<EXRChannel> channels;
+    AddEXRChannels(bufferData, bufferFormat, dumpBufferWidth * dumpBufferHeight, {}, channels);
+    SaveEXRChannels(channels, dumpBufferWidth, dumpBufferHeight, {}, filePath, compression);
+}
+
+void CapsaicinInternal::saveEXRLayers(void const *bufferData, std::vector<DumpLayer> const &layers,
+    uint32_t const dumpBufferWidth, uint32_t const dumpBufferHeight, DumpMetadata const &metadata,
+    std::filesystem::path const &filePath, EXRCompression const compression)
+{
+    std::vector<EXRChannel> channels;
+    for (auto const &layer : layers)
+    {
+        AddEXRChannels(static_cast<uint8_t const *>(bufferData) + layer.offset, layer.format,
+            dumpBufferWidth * dumpBufferHeight, layer.name + '.', channels);
+    }
+
+    // Standard OpenEXR matrix attributes use row vectors, which matches the memory layout of the column
+    // major glm matrices
+    std::vector<EXRAttribute> attributes;
+    attributes.push_back(MakeEXRAttribute("worldToCamera", "m44f", metadata.view));
+    attributes.push_back(MakeEXRAttribute("worldToNDC", "m44f", metadata.viewProjection));
+    attributes.push_back(MakeEXRAttribute("cameraJitter", "v2f", metadata.jitter));
+    attributes.push_back(MakeEXRAttribute("frameIndex", "int", metadata.frameIndex));
+    SaveEXRChannels(channels, dumpBufferWidth, dumpBufferHeight, attributes, filePath, compression);
+}
+
+void CapsaicinInternal::saveJPG(void const *bufferData, const DXGI_FORMAT bufferFormat,
+    uint32_t const dumpBufferWidth, uint32_t const dumpBufferHeight, std::filesystem::path const &filePath)
 {
     // Image
-    void const    *bufferData      = gfxBufferGetData(gfx_, dumpBuffer);
     uint32_t const imageWidth      = dumpBufferWidth;
     uint32_t const imageHeight     = dumpBufferHeight;
     uint32_t const imagePixelCount = dumpBufferWidth * dumpBufferHeight;
@@ -417,17 +958,7 @@ void CapsaicinInternal::saveJPG(GfxBuffer const &dumpBuffer, const DXGI_FORMAT b
     {
         std::vector<unsigned char> imageData(static_cast<size_t>(imageWidth) * imageHeight * 3);
         auto                       quantize = [&]<typename T>(T const *dumpBufferData) {
-            for (size_t pixelIndex = 0; pixelIndex < imagePixelCount; ++pixelIndex)
-            {
-                imageData[3 * pixelIndex + 0] =
-                    ConvertType<uint8_t, T>(dumpBufferData[channelCount * pixelIndex + 0]);
-                imageData[3 * pixelIndex + 1] =
-                    channelCount > 1 ? ConvertType<uint8_t, T>(dumpBufferData[channelCount * pixelIndex + 1])
-                                                           : 0;
-                imageData[3 * pixelIndex + 2] =
-                    channelCount > 2 ? ConvertType<uint8_t, T>(dumpBufferData[channelCount * pixelIndex + 2])
-                                                           : 0;
-            }
+            QuantizeToRGB8(dumpBufferData, channelCount, imagePixelCount, imageData.data());
         };
 
         if (bool const isFloatFormat = IsFormatFloat(bufferFormat); bitsPerChannel == 32 && isFloatFormat)
@@ -460,11 +991,10 @@ void CapsaicinInternal::saveJPG(GfxBuffer const &dumpBuffer, const DXGI_FORMAT b
     }
 }
 
-void CapsaicinInternal::savePNG(GfxBuffer const &dumpBuffer, const DXGI_FORMAT bufferFormat, uint32_t const dumpBufferWidth,
-    uint32_t const dumpBufferHeight, std::filesystem::path const &filePath) const
+void CapsaicinInternal::savePNG(void const *bufferData, const DXGI_FORMAT bufferFormat, uint32_t const dumpBufferWidth,
+    uint32_t const dumpBufferHeight, std::filesystem::path const &filePath)
 {
     // Image
-    void const    *bufferData      = gfxBufferGetData(gfx_, dumpBuffer);
     uint32_t const imageWidth       = dumpBufferWidth;
     uint32_t const imageHeight      = dumpBufferHeight;
     uint32_t const imagePixelCount = dumpBufferWidth * dumpBufferHeight;
@@ -484,17 +1014,7 @@ void CapsaicinInternal::savePNG(GfxBuffer const &dumpBuffer, const DXGI_FORMAT b
     {
         std::vector<unsigned char> imageData(static_cast<size_t>(imageWidth) * imageHeight * 3);
         auto                       quantize = [&]<typename T>(T const *dumpBufferData) {
-            for (size_t pixelIndex = 0; pixelIndex < imagePixelCount; ++pixelIndex)
-            {
-                imageData[3 * pixelIndex + 0] =
-                    ConvertType<uint8_t, T>(dumpBufferData[channelCount * pixelIndex + 0]);
-                imageData[3 * pixelIndex + 1] =
-                    channelCount > 1 ? ConvertType<uint8_t, T>(dumpBufferData[channelCount * pixelIndex + 1])
-                                                           : 0;
-                imageData[3 * pixelIndex + 2] =
-                    channelCount > 2 ? ConvertType<uint8_t, T>(dumpBufferData[channelCount * pixelIndex + 2])
-                                                           : 0;
-            }
+            QuantizeToRGB8(dumpBufferData, channelCount, imagePixelCount, imageData.data());
         };
 
         if (bool const isFloatFormat = IsFormatFloat(bufferFormat); bitsPerChannel == 32 && isFloatFormat)
@@ -22,18 +22,95 @@ THE SOFTWARE.
 
 #include "capsaicin_internal.h"
 #include "common_functions.inl"
+#include "cpu_mip.h"
+#include "cpu_profiler.h"
+#include "gpu_lut_cache.h"
 #include "hash_reduce.h"
+#include "pixel_conversion.h"
 
 #include <cmath>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <glm/gtc/matrix_transform.hpp>
 #include <meshoptimizer.h>
-#include <numbers>
 #include <yaml-cpp/yaml.h>
 
 namespace Capsaicin
 {
+/**
+ * Gets the CPU mip type used to generate mips for an image.
+ * @param image The image to generate mips for.
+ * @param type  Output mip type.
+ * @return True if the image format can be mipped on the CPU, False otherwise.
+ */
+static bool GetCPUMipType(GfxImage const &image, CPUMip::Type &type) noexcept
+{
+    switch (image.format)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB: type = CPUMip::Type::sRGBA; break;
+    case DXGI_FORMAT_R8G8B8A8_UNORM: type = CPUMip::Type::RGBA; break;
+    case DXGI_FORMAT_R8G8_UNORM: type = CPUMip::Type::RG; break;
+    case DXGI_FORMAT_R8_UNORM: type = CPUMip::Type::R; break;
+    default: return false;
+    }
+    return image.bytes_per_channel == 1 && image.channel_count == CPUMip::GetChannelCount(type);
+}
+
+/**
+ * Decodes an environment map image into linear float values.
+ * @param image          The source image.
+ * @param environmentMap Output decoded environment map.
+ * @return True if the image format can be decoded, False otherwise.
+ */
+static bool DecodeEnvironmentMap(GfxImage const &image, CPUEnvironmentMap &environmentMap) noexcept
+{
+    size_t const count = static_cast<size_t>(image.width) * image.height * image.channel_count;
+    if (image.data.size() < count * image.bytes_per_channel)
+    {
+        return false;
+    }
+    std::vector<float> values;
+    try
+    {
+        values.resize(count);
+    }
+    catch (...)
+    {
+        return false;
+    }
+    switch (image.bytes_per_channel)
+    {
+    case 4: std::memcpy(values.data(), image.data.data(), count * sizeof(float)); break;
+    case 2:
+        if (image.format == DXGI_FORMAT_R16G16B16A16_UNORM)
+        {
+            ConvertUnormToFloat(reinterpret_cast<uint16_t const *>(image.data.data()), values.data(), count);
+        }
+        else
+        {
+            ConvertHalfToFloat(reinterpret_cast<uint16_t const *>(image.data.data()), values.data(), count);
+        }
+        break;
+    case 1:
+        ConvertUnormToFloat(image.data.data(), values.data(), count);
+        if (image.format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                float &value = values[i];
+                if (i % 4 != 3)
+                {
+                    value = value <= 0.04045F ? value / 12.92F : std::pow((value + 0.055F) / 1.055F, 2.4F);
+                }
+            }
+        }
+        break;
+    default: return false;
+    }
+    return environmentMap.initialise(image.width, image.height, image.channel_count, values);
+}
+
 std::vector<std::filesystem::path> const &CapsaicinInternal::getCurrentScenes() const noexcept
 {
     return scene_files_;
@@ -93,6 +170,7 @@ bool CapsaicinInternal::setScene(std::filesystem::path const &fileName) noexcept
         for (auto const &[name, component] : components_)
         {
             component->setGfxContext(gfx_);
+            MemoryTracker::OwnerScope const memoryOwner(component->getName());
             if (!component->init(*this))
             {
                 GFX_PRINTLN("Error: Failed to initialise component: %s", name.data());
@@ -103,6 +181,7 @@ bool CapsaicinInternal::setScene(std::filesystem::path const &fileName) noexcept
         for (auto const &i : render_techniques_)
         {
             i->setGfxContext(gfx_);
+            MemoryTracker::OwnerScope const memoryOwner(i->getName());
             if (!i->init(*this))
             {
                 GFX_PRINTLN("Error: Failed to initialise render technique: %s", i->getName().data());
@@ -231,6 +310,50 @@ void CapsaicinInternal::setSceneCameraRange(glm::vec2 const &nearFar) noexcept
     camera.farZ       = nearFar.y;
 }
 
+void CapsaicinInternal::startCameraPathRecording() noexcept
+{
+    camera_path_.clear();
+    camera_path_playing_   = false;
+    camera_path_recording_ = true;
+}
+
+bool CapsaicinInternal::stopCameraPathRecording(std::filesystem::path const &filePath) noexcept
+{
+    if (!camera_path_recording_)
+    {
+        GFX_PRINT_ERROR(kGfxResult_InvalidOperation, "Can't save camera path: No camera path is recording");
+        return false;
+    }
+    camera_path_recording_ = false;
+    if (!camera_path_.save(filePath))
+    {
+        GFX_PRINTLN("Error: Failed to save camera path '%s'", filePath.string().c_str());
+        return false;
+    }
+    return true;
+}
+
+bool CapsaicinInternal::playCameraPath(
+    std::filesystem::path const &filePath, uint32_t const frameCount) noexcept
+{
+    camera_path_recording_ = false;
+    camera_path_playing_   = false;
+    if (!camera_path_.load(filePath) || camera_path_.getSampleCount() == 0)
+    {
+        GFX_PRINTLN("Error: Failed to load camera path '%s'", filePath.string().c_str());
+        return false;
+    }
+    camera_path_playing_     = true;
+    camera_path_frame_       = 0;
+    camera_path_frame_count_ = frameCount > 0 ? frameCount : camera_path_.getSampleCount();
+    return true;
+}
+
+void CapsaicinInternal::stopCameraPath() noexcept
+{
+    camera_path_playing_ = false;
+}
+
 std::filesystem::path CapsaicinInternal::getCurrentEnvironmentMap() const noexcept
 {
     return environment_map_file_;
@@ -281,6 +404,8 @@ GfxCamera const &CapsaicinInternal::getCamera() const
 
 bool CapsaicinInternal::loadSceneFile(std::filesystem::path const &fileName, bool const append) noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+
     // Normalise file name and standardise path separators
     std::filesystem::path const normFileName = fileName.lexically_normal().generic_string();
 
@@ -483,167 +608,149 @@ bool CapsaicinInternal::createBlankScene() noexcept
 
 bool CapsaicinInternal::generateEnvironmentMap(std::filesystem::path const &fileName) noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+    MemoryTracker::OwnerScope const memoryOwner(MemoryTracker::kSceneOwner);
+
     if (fileName.empty())
     {
         // If empty file requested then just use blank environment map
-        environment_map_file_ = "";
+        environment_map_file_      = "";
+        environment_map_file_hash_ = 0;
+        environment_map_hash_      = 0;
+        environment_map_source_.clear();
 
         // Remove the old environment map
         if (!!environment_buffer_)
         {
-            gfxDestroyTexture(gfx_, environment_buffer_);
+            DestroyTexture(gfx_, environment_buffer_);
             environment_buffer_      = {};
             environment_map_updated_ = true;
         }
         return true;
     }
 
-    // Scale environment buffer to screen resolution
-    uint32_t const maxWidth        = std::max(render_dimensions_.x, render_dimensions_.y);
-    uint32_t const floorWidth      = std::bit_floor(maxWidth);
-    uint32_t const ceilWidth       = std::bit_ceil(maxWidth);
-    uint32_t       environmentSize = (maxWidth - floorWidth >= ceilWidth - maxWidth) ? ceilWidth : floorWidth;
-
-    if (environment_map_file_ == fileName)
+    // The cache key covers everything the generated cube map depends on, the source file is only hashed when
+    // it changes as large environment maps take a noticeable amount of time to read
+    bool const sameFile = environment_map_file_ == fileName;
+    uint64_t   fileHash = sameFile ? environment_map_file_hash_ : 0;
+    if (!sameFile && !LutCache::HashFile(fileName, fileHash))
     {
-        environmentSize = std::min((maxWidth == render_dimensions_.x ? environment_map_source_dimensions_.x
-                                                                     : environment_map_source_dimensions_.y)
-                                       / 2,
-            environmentSize);
+        fileHash = 0;
+    }
+    LutCache::Key const key =
+        CPUEnvironmentMap::GetCubeMapKey(fileHash, render_dimensions_.x, render_dimensions_.y);
+    uint64_t const environmentHash = fileHash != 0 ? key.getHash() : 0;
 
-        // Need to check if we actually need to resize based on render dimensions
-        if (environment_buffer_.getWidth() == environmentSize)
+    if (sameFile)
+    {
+        if (environmentHash != 0 && environmentHash == environment_map_hash_)
         {
             // Nothing needs doing
             return true;
         }
+        if (environment_map_source_.isValid())
+        {
+            // Need to check if we actually need to resize based on render dimensions
+            if (environment_buffer_.getWidth()
+                == CPUEnvironmentMap::GetCubeMapSize(render_dimensions_.x, render_dimensions_.y,
+                    environment_map_source_.getWidth(), environment_map_source_.getHeight()))
+            {
+                // Nothing needs doing
+                environment_map_hash_ = environmentHash;
+                return true;
+            }
+        }
     }
-
-    // Load in the environment map
-    std::string const fileNameString = fileName.string();
-    if (gfxSceneImport(scene_, fileNameString.c_str()) != kGfxResult_NoError)
+    else
     {
-        return false;
+        environment_map_source_.clear();
     }
-    auto const environmentMap = gfxSceneFindObjectByAssetFile<GfxImage>(scene_, fileNameString.c_str());
-    if (!environmentMap)
+
+    if (!gpu_lut_cache_.isValid())
     {
-        GFX_PRINTLN("Failed to find valid environment map source file: %s", fileNameString.c_str());
         return false;
     }
 
-    // Remove the old environment cube map
-    if (!!environment_buffer_)
+    // Check for a previously generated cube map, this avoids decoding the source image altogether
+    LutCache::Description  description;
+    std::vector<std::byte> data;
+    bool                   generated = false;
+    if (environmentHash == 0 || lut_cache_.getDirectory().empty() || !lut_cache_.load(key, description, data)
+        || description
+               != CPUEnvironmentMap::GetCubeMapDescription(
+                   description.width, gfxCalculateMipCount(description.width)))
     {
-        gfxDestroyTexture(gfx_, environment_buffer_);
-        environment_buffer_ = {};
-    }
-    environment_map_updated_ = true;
-    environment_map_file_    = fileName;
-
-    // Get source dimensions
-    uint32_t const environment_map_width  = environmentMap->width;
-    uint32_t const environment_map_height = environmentMap->height;
-    environment_map_source_dimensions_    = uint2(environment_map_width, environment_map_height);
-    uint32_t const environment_map_mip_count =
-        gfxCalculateMipCount(environment_map_width, environment_map_height);
-    uint32_t const environment_map_channel_count     = environmentMap->channel_count;
-    uint32_t const environment_map_bytes_per_channel = environmentMap->bytes_per_channel;
+        // Load in the environment map, the decoded source is kept so that resizing does not need to reload it
+        if (!environment_map_source_.isValid())
+        {
+            std::string const fileNameString = fileName.string();
+            if (gfxSceneImport(scene_, fileNameString.c_str()) != kGfxResult_NoError)
+            {
+                return false;
+            }
+            auto const environmentMap =
+                gfxSceneFindObjectByAssetFile<GfxImage>(scene_, fileNameString.c_str());
+            if (!environmentMap)
+            {
+                GFX_PRINTLN("Failed to find valid environment map source file: %s", fileNameString.c_str());
+                return false;
+            }
+            bool const decoded = DecodeEnvironmentMap(*environmentMap, environment_map_source_);
+            gfxSceneDestroyImage(scene_, gfxSceneGetImageHandle(scene_, environmentMap.getIndex()));
+            if (!decoded)
+            {
+                GFX_PRINTLN("Unsupported environment map format: %s", fileNameString.c_str());
+                return false;
+            }
+        }
 
-    // Scale environment buffer to screen resolution without exceeding the resolution of the source
-    environmentSize =
-        std::min((maxWidth == render_dimensions_.x ? environmentMap->width : environmentMap->height) / 2,
-            environmentSize);
+        // Scale environment buffer to screen resolution without exceeding the resolution of the source
+        uint32_t const environmentSize = CPUEnvironmentMap::GetCubeMapSize(render_dimensions_.x,
+            render_dimensions_.y, environment_map_source_.getWidth(), environment_map_source_.getHeight());
+        description =
+            CPUEnvironmentMap::GetCubeMapDescription(environmentSize, gfxCalculateMipCount(environmentSize));
+        std::vector<float> cubeMap;
+        if (!environment_map_source_.generateCubeMap(environmentSize, description.mipCount, cubeMap))
+        {
+            return false;
+        }
+        data.resize(cubeMap.size() * sizeof(uint16_t));
+        ConvertFloatToHalf(cubeMap.data(), reinterpret_cast<uint16_t *>(data.data()), cubeMap.size());
+        generated = true;
+    }
 
     // Create environment cube map texture
-    uint32_t const environment_buffer_mips = gfxCalculateMipCount(environmentSize);
-    environment_buffer_ =
-        gfxCreateTextureCube(gfx_, environmentSize, DXGI_FORMAT_R16G16B16A16_FLOAT, environment_buffer_mips);
-    environment_buffer_.setName("Capsaicin_EnvironmentBuffer");
-
-    GfxTexture const environment_map = gfxCreateTexture2D(gfx_, environment_map_width, environment_map_height,
-        environmentMap->format, environment_map_mip_count);
+    if (!!environment_buffer_)
     {
-        GfxBuffer const upload_buffer = gfxCreateBuffer(gfx_,
-            static_cast<size_t>(environment_map_width) * environment_map_height
-                * environment_map_channel_count * environment_map_bytes_per_channel,
-            environmentMap->data.data(), kGfxCpuAccess_Write);
-        gfxCommandCopyBufferToTexture(gfx_, environment_map, upload_buffer);
-        gfxCommandGenerateMips(gfx_, environment_map);
-        gfxDestroyBuffer(gfx_, upload_buffer);
+        DestroyTexture(gfx_, environment_buffer_);
     }
-
-    constexpr std::array forward_vectors = {glm::dvec3(-1.0, 0.0, 0.0), glm::dvec3(1.0, 0.0, 0.0),
-        glm::dvec3(0.0, 1.0, 0.0), glm::dvec3(0.0, -1.0, 0.0), glm::dvec3(0.0, 0.0, -1.0),
-        glm::dvec3(0.0, 0.0, 1.0)};
-
-    constexpr std::array up_vectors = {glm::dvec3(0.0, -1.0, 0.0), glm::dvec3(0.0, -1.0, 0.0),
-        glm::dvec3(0.0, 0.0, -1.0), glm::dvec3(0.0, 0.0, 1.0), glm::dvec3(0.0, -1.0, 0.0),
-
-        glm::dvec3(0.0, -1.0, 0.0)};
+    environment_buffer_ = CreateTextureCube(
+        gfx_, description.width, DXGI_FORMAT_R16G16B16A16_FLOAT, description.mipCount);
+    environment_buffer_.setName("Capsaicin_EnvironmentBuffer");
+    environment_map_updated_   = true;
+    environment_map_file_      = fileName;
+    environment_map_file_hash_ = fileHash;
+    environment_map_hash_      = environmentHash;
     {
-        GfxCommandEvent const command_event(gfx_, "GenerateEnvironmentMap");
-        GfxProgram const      convolve_ibl_program_ = createProgram("capsaicin/convolve_ibl");
-        for (uint32_t cubemap_face = 0; cubemap_face < 6; ++cubemap_face)
-        {
-            GfxDrawState const draw_sky_state = {};
-            gfxDrawStateSetColorTarget(draw_sky_state, 0, environment_buffer_.getFormat());
-
-            GfxKernel const draw_sky_kernel =
-                gfxCreateGraphicsKernel(gfx_, convolve_ibl_program_, draw_sky_state, "DrawSky");
-
-            uint2 const buffer_dimensions = {environment_buffer_.getWidth(), environment_buffer_.getHeight()};
-
-            glm::dmat4 const view =
-                lookAt(glm::dvec3(0.0), forward_vectors[cubemap_face], up_vectors[cubemap_face]);
-            glm::dmat4 const proj = glm::perspective(std::numbers::pi_v<double> / 2.0, 1.0, 0.1, 1e4);
-            auto const       view_proj_inv = glm::mat4(inverse(proj * view));
-
-            gfxProgramSetParameter(gfx_, convolve_ibl_program_, "g_BufferDimensions", buffer_dimensions);
-            gfxProgramSetParameter(gfx_, convolve_ibl_program_, "g_ViewProjectionInverse", view_proj_inv);
-
-            gfxProgramSetParameter(gfx_, convolve_ibl_program_, "g_EnvironmentMap", environment_map);
-
-            gfxProgramSetParameter(gfx_, convolve_ibl_program_, "g_LinearSampler", linear_sampler_);
-
-            gfxCommandBindColorTarget(gfx_, 0, environment_buffer_, 0, cubemap_face);
-            gfxCommandBindKernel(gfx_, draw_sky_kernel);
-            gfxCommandDraw(gfx_, 3);
-
-            gfxDestroyKernel(gfx_, draw_sky_kernel);
-        }
-
-        GfxKernel const blur_sky_kernel = gfxCreateComputeKernel(gfx_, convolve_ibl_program_, "BlurSky");
-
-        for (uint32_t mip_level = 1; mip_level < environment_buffer_mips; ++mip_level)
+        GfxCommandEvent const command_event(gfx_, "UploadEnvironmentMap");
+        if (!gpu_lut_cache_.upload(environment_buffer_, data))
         {
-            gfxProgramSetParameter(
-                gfx_, convolve_ibl_program_, "g_InEnvironmentBuffer", environment_buffer_, mip_level - 1);
-            gfxProgramSetParameter(
-                gfx_, convolve_ibl_program_, "g_OutEnvironmentBuffer", environment_buffer_, mip_level);
-
-            uint32_t const *num_threads = gfxKernelGetNumThreads(gfx_, blur_sky_kernel);
-            uint32_t const  num_groups_x =
-                (GFX_MAX(environmentSize >> mip_level, 1U) + num_threads[0] - 1) / num_threads[0];
-            uint32_t const num_groups_y =
-                (GFX_MAX(environmentSize >> mip_level, 1U) + num_threads[1] - 1) / num_threads[1];
-            constexpr uint32_t num_groups_z = 6; // blur all faces
-
-            gfxCommandBindKernel(gfx_, blur_sky_kernel);
-            gfxCommandDispatch(gfx_, num_groups_x, num_groups_y, num_groups_z);
+            return false;
         }
-        gfxDestroyKernel(gfx_, blur_sky_kernel);
-        gfxDestroyProgram(gfx_, convolve_ibl_program_);
     }
 
-    auto const handle = gfxSceneGetImageHandle(scene_, environmentMap.getIndex());
-    gfxSceneDestroyImage(scene_, handle);
-    gfxDestroyTexture(gfx_, environment_map);
+    // Entries are written in the background as data is already in its cached form
+    if (generated && environmentHash != 0 && !lut_cache_.getDirectory().empty())
+    {
+        lut_cache_.saveAsync(key, description, std::move(data));
+    }
     return true;
 }
 
 void CapsaicinInternal::updateScene() noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+
     // Run the animations
     if (!play_paused_ || (play_time_ != play_time_old_))
     {
@@ -663,8 +770,24 @@ void CapsaicinInternal::updateScene() noexcept
         updateSceneAnimations();
     }
 
-    // Calculate the camera matrices for this frame
+    // Apply the camera path before calculating the camera matrices for this frame
+    if (camera_path_playing_)
+    {
+        CameraPathSample const sample = camera_path_.evaluate(camera_path_frame_, camera_path_frame_count_);
+        setSceneCameraView(sample.position, sample.forward, sample.up);
+        setSceneCameraFOV(sample.fovY);
+    }
     updateSceneCameraMatrices();
+    if (camera_path_playing_)
+    {
+        ++camera_path_frame_;
+    }
+    else if (camera_path_recording_)
+    {
+        auto const [position, forward, up] = getSceneCameraView();
+        camera_path_.addSample({position, forward, up, getSceneCameraFOV(),
+            camera_jitter_ * static_cast<float2>(render_dimensions_) / float2(2.0F, -2.0F)});
+    }
 
     // Resize environment map if needed
     if (render_dimensions_updated_ && !environment_map_updated_)
@@ -712,6 +835,8 @@ void CapsaicinInternal::updateScene() noexcept
 
 void CapsaicinInternal::updateSceneAnimations() noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+
     uint32_t const animation_count = gfxSceneGetAnimationCount(scene_);
     for (uint32_t animation_index = 0; animation_index < animation_count; ++animation_index)
     {
@@ -727,6 +852,8 @@ void CapsaicinInternal::updateSceneAnimations() noexcept
 
 void CapsaicinInternal::updateSceneCameraMatrices() noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+
     uint32_t const jitter_index = jitter_frame_index_ != ~0U ? jitter_frame_index_ : frame_index_;
     if (render_dimensions_updated_)
     {
@@ -854,6 +981,11 @@ void CapsaicinInternal::updateSceneCameraMatrices() noexcept
     }
     camera_jitter_ = float2(CalculateHaltonNumber((jitter_index % jitter_phase_count_) + 1, 2),
         CalculateHaltonNumber((jitter_index % jitter_phase_count_) + 1, 3));
+    if (camera_path_playing_ && camera_path_frame_count_ == camera_path_.getSampleCount())
+    {
+        // Replay the recorded jitter so that playback matches the recorded frames exactly
+        camera_jitter_ = camera_path_.evaluate(camera_path_frame_, camera_path_frame_count_).jitter + 0.5F;
+    }
     camera_jitter_ =
         ((camera_jitter_ - 0.5F) * float2(2.0F, -2.0F)) / static_cast<float2>(render_dimensions_);
     for (uint32_t i = 0; i < 2; ++i)
@@ -897,7 +1029,7 @@ void CapsaicinInternal::updateSceneCameraMatrices() noexcept
 
         // Update camera matrices
         {
-            gfxDestroyBuffer(gfx_, camera_matrices_buffer_[i]);
+            DestroyBuffer(gfx_, camera_matrices_buffer_[i]);
             camera_matrices_buffer_[i] = allocateConstantBuffer<CameraMatrices>(1);
             memcpy(gfxBufferGetData(gfx_, camera_matrices_buffer_[i]), &camera_matrices_[i],
                 sizeof(camera_matrices_[i]));
@@ -908,6 +1040,9 @@ void CapsaicinInternal::updateSceneCameraMatrices() noexcept
 
 void CapsaicinInternal::updateSceneMeshes() noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+    MemoryTracker::OwnerScope const memoryOwner(MemoryTracker::kSceneOwner);
+
     // Check whether we need to re-build our mesh data
     auto const mesh_hash = mesh_hash_;
     if (frame_index_ == 0 || animation_updated_)
@@ -1322,47 +1457,47 @@ void CapsaicinInternal::updateSceneMeshes() noexcept
         }
 
         // Copy data into GPU buffers
-        gfxDestroyBuffer(gfx_, index_buffer_);
+        DestroyBuffer(gfx_, index_buffer_);
         index_buffer_ =
-            gfxCreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(index_data.size()), index_data.data());
+            CreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(index_data.size()), index_data.data());
         index_buffer_.setName("IndexBuffer");
-        gfxDestroyBuffer(gfx_, vertex_buffer_);
+        DestroyBuffer(gfx_, vertex_buffer_);
         vertex_buffer_ =
-            gfxCreateBuffer<Vertex>(gfx_, static_cast<uint32_t>(vertex_data.size()), vertex_data.data());
+            CreateBuffer<Vertex>(gfx_, static_cast<uint32_t>(vertex_data.size()), vertex_data.data());
         vertex_buffer_.setName("VertexBuffer");
-        gfxDestroyBuffer(gfx_, vertex_source_buffer_);
-        vertex_source_buffer_ = gfxCreateBuffer<Vertex>(
+        DestroyBuffer(gfx_, vertex_source_buffer_);
+        vertex_source_buffer_ = CreateBuffer<Vertex>(
             gfx_, static_cast<uint32_t>(vertex_source_data.size()), vertex_source_data.data());
         vertex_source_buffer_.setName("VertexSourceBuffer");
-        gfxDestroyBuffer(gfx_, joint_buffer_);
+        DestroyBuffer(gfx_, joint_buffer_);
         joint_buffer_ =
-            gfxCreateBuffer<Joint>(gfx_, static_cast<uint32_t>(joint_data.size()), joint_data.data());
+            CreateBuffer<Joint>(gfx_, static_cast<uint32_t>(joint_data.size()), joint_data.data());
         joint_buffer_.setName("JointBuffer");
-        gfxDestroyBuffer(gfx_, joint_matrices_buffer_);
-        joint_matrices_buffer_ = gfxCreateBuffer<glm::mat4>(gfx_, joint_matrix_count);
+        DestroyBuffer(gfx_, joint_matrices_buffer_);
+        joint_matrices_buffer_ = CreateBuffer<glm::mat4>(gfx_, joint_matrix_count);
         if (hasMeshlets)
         {
             // Resizing must be exact as otherwise the copy buffer command will fail
             checkSharedBuffer("Meshlets", meshlet_data.size() * sizeof(Meshlet), true);
-            GfxBuffer upload_buffer = gfxCreateBuffer<Meshlet>(
+            GfxBuffer upload_buffer = CreateBuffer<Meshlet>(
                 gfx_, static_cast<uint32_t>(meshlet_data.size()), meshlet_data.data(), kGfxCpuAccess_Write);
             gfxCommandCopyBuffer(gfx_, getSharedBuffer("Meshlets"), upload_buffer);
-            gfxDestroyBuffer(gfx_, upload_buffer);
+            DestroyBuffer(gfx_, upload_buffer);
 
             checkSharedBuffer("MeshletPack", meshlet_pack_data.size() * sizeof(uint32_t), true);
-            upload_buffer = gfxCreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(meshlet_pack_data.size()),
+            upload_buffer = CreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(meshlet_pack_data.size()),
                 meshlet_pack_data.data(), kGfxCpuAccess_Write);
             gfxCommandCopyBuffer(gfx_, getSharedBuffer("MeshletPack"), upload_buffer);
-            gfxDestroyBuffer(gfx_, upload_buffer);
+            DestroyBuffer(gfx_, upload_buffer);
 
             if (hasMeshletCull)
             {
                 checkSharedBuffer("MeshletCull", meshlet_cull_data.size() * sizeof(MeshletCull), true);
                 upload_buffer =
-                    gfxCreateBuffer<MeshletCull>(gfx_, static_cast<uint32_t>(meshlet_cull_data.size()),
+                    CreateBuffer<MeshletCull>(gfx_, static_cast<uint32_t>(meshlet_cull_data.size()),
                         meshlet_cull_data.data(), kGfxCpuAccess_Write);
                 gfxCommandCopyBuffer(gfx_, getSharedBuffer("MeshletCull"), upload_buffer);
-                gfxDestroyBuffer(gfx_, upload_buffer);
+                DestroyBuffer(gfx_, upload_buffer);
             }
         }
 
@@ -1376,6 +1511,9 @@ void CapsaicinInternal::updateSceneMeshes() noexcept
 
 void CapsaicinInternal::updateSceneInstances() noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+    MemoryTracker::OwnerScope const memoryOwner(MemoryTracker::kSceneOwner);
+
     // Update the instance information
     if (instances_updated_ || mesh_updated_)
     {
@@ -1436,8 +1574,8 @@ void CapsaicinInternal::updateSceneInstances() noexcept
         }
 
         // Update GPU instance buffer
-        gfxDestroyBuffer(gfx_, instance_buffer_);
-        instance_buffer_ = gfxCreateBuffer<Instance>(
+        DestroyBuffer(gfx_, instance_buffer_);
+        instance_buffer_ = CreateBuffer<Instance>(
             gfx_, static_cast<uint32_t>(instance_data_.size()), instance_data_.data());
         instance_buffer_.setName("InstanceBuffer");
 
@@ -1451,9 +1589,9 @@ void CapsaicinInternal::updateSceneInstances() noexcept
 
         if (!instance_id_buffer_ || instance_id_data_.size() != instance_id_buffer_.getSize())
         {
-            gfxDestroyBuffer(gfx_, instance_id_buffer_);
+            DestroyBuffer(gfx_, instance_id_buffer_);
             instance_id_buffer_ =
-                gfxCreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(instance_id_data_.size()));
+                CreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(instance_id_data_.size()));
             instance_id_buffer_.setName("InstanceIDBuffer");
         }
         else
@@ -1464,14 +1602,14 @@ void CapsaicinInternal::updateSceneInstances() noexcept
             memcpy(gfxBufferGetData(gfx_, instance_id_buffer), instance_id_data_.data(),
                 instance_id_data_.size() * sizeof(uint32_t));
             gfxCommandCopyBuffer(gfx_, instance_id_buffer_, instance_id_buffer);
-            gfxDestroyBuffer(gfx_, instance_id_buffer);
+            DestroyBuffer(gfx_, instance_id_buffer);
         }
 
         // Update the morph weight buffer (as morphs are applied per instance)
         if (morph_weight_buffer_.getCount() != static_cast<uint32_t>(morph_weight_count))
         {
-            gfxDestroyBuffer(gfx_, morph_weight_buffer_);
-            morph_weight_buffer_ = gfxCreateBuffer<float>(gfx_, static_cast<uint32_t>(morph_weight_count));
+            DestroyBuffer(gfx_, morph_weight_buffer_);
+            morph_weight_buffer_ = CreateBuffer<float>(gfx_, static_cast<uint32_t>(morph_weight_count));
             morph_weight_buffer_.setName("MorphWeightBuffer");
         }
     }
@@ -1479,6 +1617,9 @@ void CapsaicinInternal::updateSceneInstances() noexcept
 
 void CapsaicinInternal::updateSceneTransforms() noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+    MemoryTracker::OwnerScope const memoryOwner(MemoryTracker::kSceneOwner);
+
     GfxInstance const *instances      = gfxSceneGetObjects<GfxInstance>(scene_);
     uint32_t const     instance_count = gfxSceneGetObjectCount<GfxInstance>(scene_);
     // Check whether we need to re-build our transform data
@@ -1532,15 +1673,15 @@ void CapsaicinInternal::updateSceneTransforms() noexcept
         }
 
         // Update the transform buffer
-        gfxDestroyBuffer(gfx_, transform_buffer_);
-        transform_buffer_ = gfxCreateBuffer<glm::mat4x3>(
+        DestroyBuffer(gfx_, transform_buffer_);
+        transform_buffer_ = CreateBuffer<glm::mat4x3>(
             gfx_, static_cast<uint32_t>(transform_data.size()), transform_data.data());
         transform_buffer_.setName("TransformBuffer");
         if (prev_transform_buffer_.getCount() != static_cast<uint32_t>(transform_data.size()))
         {
             // Previous transform buffer should match current due to rebuild
-            gfxDestroyBuffer(gfx_, prev_transform_buffer_);
-            prev_transform_buffer_ = gfxCreateBuffer<glm::mat4x3>(gfx_, transform_buffer_.getCount());
+            DestroyBuffer(gfx_, prev_transform_buffer_);
+            prev_transform_buffer_ = CreateBuffer<glm::mat4x3>(gfx_, transform_buffer_.getCount());
             prev_transform_buffer_.setName("PrevTransformBuffer");
             gfxCommandCopyBuffer(gfx_, prev_transform_buffer_, transform_buffer_);
         }
@@ -1556,6 +1697,9 @@ void CapsaicinInternal::updateSceneTransforms() noexcept
 
 void CapsaicinInternal::updateSceneMaterials() noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+    MemoryTracker::OwnerScope const memoryOwner(MemoryTracker::kSceneOwner);
+
     if (mesh_updated_) // Currently we don't support changing materials without also changing meshes
     {
         size_t const material_hash = material_hash_;
@@ -1566,7 +1710,7 @@ void CapsaicinInternal::updateSceneMaterials() noexcept
         if (materials_updated_)
         {
             // Rebuild materials buffer
-            gfxDestroyBuffer(gfx_, material_buffer_);
+            DestroyBuffer(gfx_, material_buffer_);
 
             GfxMaterial const    *materials      = gfxSceneGetObjects<GfxMaterial>(scene_);
             uint32_t const        material_count = gfxSceneGetObjectCount<GfxMaterial>(scene_);
@@ -1602,14 +1746,14 @@ void CapsaicinInternal::updateSceneMaterials() noexcept
                 material_data[material_index] = material;
             }
 
-            material_buffer_ = gfxCreateBuffer<Material>(
+            material_buffer_ = CreateBuffer<Material>(
                 gfx_, static_cast<uint32_t>(material_data.size()), material_data.data());
             material_buffer_.setName("Capsaicin_MaterialBuffer");
 
             // Rebuild texture atlas for all used materials
             for (GfxTexture const &texture : texture_atlas_)
             {
-                gfxDestroyTexture(gfx_, texture);
+                DestroyTexture(gfx_, texture);
             }
             texture_atlas_.clear();
 
@@ -1634,7 +1778,7 @@ void CapsaicinInternal::updateSceneMaterials() noexcept
                 uint32_t const    image_mips     = gfxCalculateMipCount(image_width, image_height);
                 uint32_t const    image_channels = image_ref->channel_count;
 
-                texture = gfxCreateTexture2D(gfx_, image_width, image_height, format, image_mips);
+                texture = CreateTexture2D(gfx_, image_width, image_height, format, image_mips);
                 texture.setName(gfxSceneGetObjectMetadata<GfxImage>(scene_, image_ref).getObjectName());
 
                 if ((image_ref->width == 0) || (image_ref->height == 0))
@@ -1649,21 +1793,38 @@ void CapsaicinInternal::updateSceneMaterials() noexcept
                                                      * image_channels * image_ref->bytes_per_channel;
                     uint64_t texture_size =
                         !gfxImageIsFormatCompressed(*image_ref) ? uncompressed_size : image_ref->data.size();
-                    bool const mips = (image_ref->flags & kGfxImageFlag_HasMipLevels) != 0;
+                    bool mips = (image_ref->flags & kGfxImageFlag_HasMipLevels) != 0;
                     if (mips && !gfxImageIsFormatCompressed(*image_ref))
                     {
                         texture_size += texture_size / 3;
                     }
                     texture_size = GFX_MIN(texture_size, image_ref->data.size());
+
+                    // Pre-bake mips on the CPU so the complete chain is uploaded along with the image
+                    std::vector<uint8_t> mip_data;
+                    CPUMip::Type         mip_type = CPUMip::Type::sRGBA;
+                    if (!mips && !gfxImageIsFormatCompressed(*image_ref) && image_mips > 1
+                        && uncompressed_size <= image_ref->data.size() && GetCPUMipType(*image_ref, mip_type))
+                    {
+                        mip_data.resize(
+                            CPUMip::GetMipChainSize(image_width, image_height, image_channels, image_mips));
+                        memcpy(mip_data.data(), image_data, uncompressed_size);
+                        mips = CPUMip::Mip(mip_data.data(), image_width, image_height, mip_type, image_mips);
+                        if (mips)
+                        {
+                            image_data   = mip_data.data();
+                            texture_size = mip_data.size();
+                        }
+                    }
                     GfxBuffer const texture_data =
-                        gfxCreateBuffer(gfx_, texture_size, image_data, kGfxCpuAccess_Write);
+                        CreateBuffer(gfx_, texture_size, image_data, kGfxCpuAccess_Write);
 
                     gfxCommandCopyBufferToTexture(gfx_, texture, texture_data);
                     if (!mips && !gfxImageIsFormatCompressed(*image_ref))
                     {
                         gfxCommandGenerateMips(gfx_, texture);
                     }
-                    gfxDestroyBuffer(gfx_, texture_data);
+                    DestroyBuffer(gfx_, texture_data);
                 }
             }
         }
@@ -1672,6 +1833,9 @@ void CapsaicinInternal::updateSceneMaterials() noexcept
 
 bool CapsaicinInternal::updateSceneAnimatedGeometry() noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+    MemoryTracker::OwnerScope const memoryOwner(MemoryTracker::kSceneOwner);
+
     bool ret = false;
     if ((joint_matrices_buffer_.getCount() > 0 || morph_weight_buffer_.getCount() > 0)
         && (frame_index_ == 0 || animation_updated_ || mesh_updated_ || instances_updated_))
@@ -1693,8 +1857,8 @@ bool CapsaicinInternal::updateSceneAnimatedGeometry() noexcept
         {
             // Load joint matrices to GPU buffer
             GfxCommandEvent const command_event(gfx_, "UpdateJointMatrices");
-            gfxDestroyBuffer(gfx_, joint_matrices_buffer_);
-            joint_matrices_buffer_ = gfxCreateBuffer<glm::mat4>(
+            DestroyBuffer(gfx_, joint_matrices_buffer_);
+            joint_matrices_buffer_ = CreateBuffer<glm::mat4>(
                 gfx_, static_cast<uint32_t>(joint_matrices_data.size()), joint_matrices_data.data());
         }
 
@@ -1710,8 +1874,8 @@ bool CapsaicinInternal::updateSceneAnimatedGeometry() noexcept
         {
             // Load morph weights to GPU buffer
             GfxCommandEvent const command_event(gfx_, "UpdateMorphWeights");
-            gfxDestroyBuffer(gfx_, morph_weight_buffer_);
-            morph_weight_buffer_ = gfxCreateBuffer<float>(
+            DestroyBuffer(gfx_, morph_weight_buffer_);
+            morph_weight_buffer_ = CreateBuffer<float>(
                 gfx_, static_cast<uint32_t>(morph_weight_data.size()), morph_weight_data.data());
         }
 
@@ -1785,6 +1949,8 @@ bool CapsaicinInternal::updateSceneAnimatedGeometry() noexcept
 
 void CapsaicinInternal::updateSceneBVH(bool const animationGPUUpdated) noexcept
 {
+    CAPSAICIN_PROFILE_FUNCTION();
+
     if (animationGPUUpdated || mesh_updated_ || transform_updated_ || instances_updated_)
     {
         GfxCommandEvent const command_event(gfx_, "BuildBVH");
@@ -1876,8 +2042,8 @@ void CapsaicinInternal::updateSceneBVH(bool const animationGPUUpdated) noexcept
 
                 gfxRaytracingPrimitiveBuild(gfx_, rt_mesh, index_buffer, vertex_buffer, 0, opaqueFlag);
 
-                gfxDestroyBuffer(gfx_, index_buffer);
-                gfxDestroyBuffer(gfx_, vertex_buffer);
+                DestroyBuffer(gfx_, index_buffer);
+                DestroyBuffer(gfx_, vertex_buffer);
             }
             else
             {
@@ -1902,8 +2068,8 @@ void CapsaicinInternal::updateSceneBVH(bool const animationGPUUpdated) noexcept
 
                     gfxRaytracingPrimitiveUpdate(gfx_, rt_mesh, index_buffer, vertex_buffer, sizeof(Vertex));
 
-                    gfxDestroyBuffer(gfx_, index_buffer);
-                    gfxDestroyBuffer(gfx_, vertex_buffer);
+                    DestroyBuffer(gfx_, index_buffer);
+                    DestroyBuffer(gfx_, vertex_buffer);
                 }
             }
         }
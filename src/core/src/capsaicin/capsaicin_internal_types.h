@@ -159,4 +159,60 @@ using ComponentList = std::vector<std::string_view>;
 
 using Option           = std::variant<bool, uint32_t, int32_t, float, std::string>;
 using RenderOptionList = std::map<std::string_view, Option>;
+
+/**
+ * Gets the number of bits used to store each pixel of a texture format.
+ * @param format The texture format.
+ * @return The bits per pixel (average per pixel for block compressed formats), zero if unknown.
+ */
+inline uint32_t GetBitsPerPixel(DXGI_FORMAT const format) noexcept
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R32G32B32A32_FLOAT: [[fallthrough]];
+    case DXGI_FORMAT_R32G32B32A32_UINT: return 128;
+    case DXGI_FORMAT_R32G32B32_FLOAT: [[fallthrough]];
+    case DXGI_FORMAT_R32G32B32_UINT: return 96;
+    case DXGI_FORMAT_R16G16B16A16_FLOAT: [[fallthrough]];
+    case DXGI_FORMAT_R16G16B16A16_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_R16G16B16A16_UINT: [[fallthrough]];
+    case DXGI_FORMAT_R32G32_FLOAT: [[fallthrough]];
+    case DXGI_FORMAT_R32G32_UINT: return 64;
+    case DXGI_FORMAT_R8G8B8A8_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB: [[fallthrough]];
+    case DXGI_FORMAT_R8G8B8A8_UINT: [[fallthrough]];
+    case DXGI_FORMAT_R16G16_FLOAT: [[fallthrough]];
+    case DXGI_FORMAT_R16G16_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_R16G16_UINT: [[fallthrough]];
+    case DXGI_FORMAT_R11G11B10_FLOAT: [[fallthrough]];
+    case DXGI_FORMAT_R10G10B10A2_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_D32_FLOAT: [[fallthrough]];
+    case DXGI_FORMAT_R32_FLOAT: [[fallthrough]];
+    case DXGI_FORMAT_R32_UINT: return 32;
+    case DXGI_FORMAT_R8G8_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_R8G8_UINT: [[fallthrough]];
+    case DXGI_FORMAT_R16_FLOAT: [[fallthrough]];
+    case DXGI_FORMAT_D16_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_R16_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_R16_UINT: return 16;
+    case DXGI_FORMAT_R8_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_R8_SNORM: [[fallthrough]];
+    case DXGI_FORMAT_R8_UINT: [[fallthrough]];
+    case DXGI_FORMAT_BC2_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_BC2_UNORM_SRGB: [[fallthrough]];
+    case DXGI_FORMAT_BC3_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_BC3_UNORM_SRGB: [[fallthrough]];
+    case DXGI_FORMAT_BC5_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_BC5_SNORM: [[fallthrough]];
+    case DXGI_FORMAT_BC6H_UF16: [[fallthrough]];
+    case DXGI_FORMAT_BC6H_SF16: [[fallthrough]];
+    case DXGI_FORMAT_BC7_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_BC7_UNORM_SRGB: return 8;
+    case DXGI_FORMAT_BC1_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_BC1_UNORM_SRGB: [[fallthrough]];
+    case DXGI_FORMAT_BC4_UNORM: [[fallthrough]];
+    case DXGI_FORMAT_BC4_SNORM: return 4;
+    default: return 0;
+    }
+}
 } // namespace Capsaicin
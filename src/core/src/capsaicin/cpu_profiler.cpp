@@ -0,0 +1,266 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_profiler.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace Capsaicin
+{
+namespace
+{
+thread_local void *g_threadBuffer = nullptr; /**< Cached pointer to the calling threads ring buffer */
+
+/**
+ * Write a string to a JSON stream escaping any invalid characters.
+ * @param stream The output stream.
+ * @param string The string to write.
+ */
+void WriteJSONString(std::ostream &stream, std::string_view const &string)
+{
+    stream << '"';
+    for (char const c : string)
+    {
+        switch (c)
+        {
+        case '"': stream << "\\\""; break;
+        case '\\': stream << "\\\\"; break;
+        case '\n': stream << "\\n"; break;
+        case '\t': stream << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) >= 0x20)
+            {
+                stream << c;
+            }
+            break;
+        }
+    }
+    stream << '"';
+}
+} // unnamed namespace
+
+CPUProfiler::ScopedEvent::ScopedEvent(std::string_view const &eventName) noexcept
+    : name(eventName)
+{
+    if (auto const &profiler = Get(); profiler.getEnabled())
+    {
+        start = profiler.now();
+    }
+}
+
+CPUProfiler::ScopedEvent::~ScopedEvent() noexcept
+{
+    if (start != std::numeric_limits<uint64_t>::max())
+    {
+        auto &profiler = Get();
+        profiler.addEvent(name, start, profiler.now());
+    }
+}
+
+CPUProfiler::CPUProfiler() noexcept
+    : epoch_(std::chrono::steady_clock::now())
+{}
+
+CPUProfiler &CPUProfiler::Get() noexcept
+{
+    static CPUProfiler profiler;
+    return profiler;
+}
+
+void CPUProfiler::setEnabled(bool const enable) noexcept
+{
+    enabled_.store(enable, std::memory_order_relaxed);
+}
+
+void CPUProfiler::setFrameIndex(uint32_t const frameIndex) noexcept
+{
+    frameIndex_.store(frameIndex, std::memory_order_relaxed);
+}
+
+void CPUProfiler::setThreadName(std::string_view const &threadName) noexcept
+{
+    auto &buffer = getThreadBuffer();
+    try
+    {
+        std::scoped_lock const lock(bufferLock_);
+        buffer.threadName = threadName;
+    }
+    catch (...)
+    {}
+}
+
+uint64_t CPUProfiler::now() const noexcept
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch_)
+            .count());
+}
+
+void CPUProfiler::addEvent(
+    std::string_view const &name, uint64_t const start, uint64_t const end, Track const track) noexcept
+{
+    auto          &buffer = getThreadBuffer();
+    uint64_t const head   = buffer.head.load(std::memory_order_relaxed);
+    Slot          &slot   = buffer.slots[head % kThreadBufferSize];
+    // Invalidate the slot before overwriting it, readers check the sequence before and after copying
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name.data(), std::memory_order_relaxed);
+    slot.nameLength.store(name.size(), std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.duration.store(end > start ? end - start : 0, std::memory_order_relaxed);
+    slot.frame.store(frameIndex_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    slot.track.store(track, std::memory_order_relaxed);
+    slot.sequence.store(head + 1, std::memory_order_release);
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void CPUProfiler::reset() noexcept
+{
+    std::scoped_lock const lock(bufferLock_);
+    for (auto const &buffer : buffers_)
+    {
+        buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+std::vector<CPUProfiler::ThreadEvents> CPUProfiler::getEvents() const noexcept
+{
+    std::vector<ThreadEvents> ret;
+    try
+    {
+        std::scoped_lock const lock(bufferLock_);
+        for (auto const &buffer : buffers_)
+        {
+            uint64_t const head   = buffer->head.load(std::memory_order_acquire);
+            uint64_t const oldest = head > kThreadBufferSize ? head - kThreadBufferSize : 0;
+            uint64_t const first  = std::max(buffer->tail.load(std::memory_order_relaxed), oldest);
+            if (first >= head)
+            {
+                continue;
+            }
+            ThreadEvents threadEvents {buffer->threadIndex, buffer->threadName, {}};
+            threadEvents.events.reserve(head - first);
+            for (uint64_t i = first; i < head; ++i)
+            {
+                // The owning thread may overwrite slots while they are copied, in which case the sequence no
+                // longer matches the event index. Everything older than an overwritten event is discarded as
+                // well so that the copy is always a contiguous range of the most recent events.
+                Slot const &slot = buffer->slots[i % kThreadBufferSize];
+                if (slot.sequence.load(std::memory_order_acquire) != i + 1)
+                {
+                    threadEvents.events.clear();
+                    continue;
+                }
+                Event       event;
+                char const *name = slot.name.load(std::memory_order_relaxed);
+                event.name       = std::string_view(name, slot.nameLength.load(std::memory_order_relaxed));
+                event.start      = slot.start.load(std::memory_order_relaxed);
+                event.duration   = slot.duration.load(std::memory_order_relaxed);
+                event.frame      = slot.frame.load(std::memory_order_relaxed);
+                event.track      = slot.track.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != i + 1)
+                {
+                    threadEvents.events.clear();
+                    continue;
+                }
+                threadEvents.events.push_back(event);
+            }
+            if (!threadEvents.events.empty())
+            {
+                ret.emplace_back(std::move(threadEvents));
+            }
+        }
+    }
+    catch (...)
+    {}
+    return ret;
+}
+
+bool CPUProfiler::saveChromeTrace(std::filesystem::path const &filePath) const noexcept
+{
+    try
+    {
+        std::ofstream file(filePath);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        auto const threads = getEvents();
+
+        // Chrome trace times are in microseconds
+        auto const toMicroseconds = [](uint64_t const nanoseconds) {
+            return static_cast<double>(nanoseconds) / 1000.0;
+        };
+        constexpr uint32_t cpuProcess = 0;
+        constexpr uint32_t gpuProcess = 1;
+        file.precision(3);
+        file << std::fixed;
+        file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << '\n';
+        file << R"({"name": "process_name", "ph": "M", "pid": )" << cpuProcess
+             << R"(, "tid": 0, "args": {"name": "CPU"}},)" << '\n';
+        file << R"({"name": "process_name", "ph": "M", "pid": )" << gpuProcess
+             << R"(, "tid": 0, "args": {"name": "GPU"}})";
+        for (auto const &[threadIndex, threadName, events] : threads)
+        {
+            file << ",\n" << R"({"name": "thread_name", "ph": "M", "pid": )" << cpuProcess
+                 << ", \"tid\": " << threadIndex << R"(, "args": {"name": )";
+            WriteJSONString(file,
+                !threadName.empty() ? threadName : std::string("Thread ") + std::to_string(threadIndex));
+            file << "}}";
+            for (auto const &event : events)
+            {
+                bool const isGPU = event.track == Track::GPU;
+                file << ",\n" << "{\"name\": ";
+                WriteJSONString(file, event.name);
+                file << ", \"cat\": \"" << (isGPU ? "gpu" : "cpu") << R"(", "ph": "X", "ts": )"
+                     << toMicroseconds(event.start) << ", \"dur\": " << toMicroseconds(event.duration)
+                     << ", \"pid\": " << (isGPU ? gpuProcess : cpuProcess)
+                     << ", \"tid\": " << (isGPU ? 0 : threadIndex)
+                     << ", \"args\": {\"frame\": " << event.frame << "}}";
+            }
+        }
+        file << '\n' << "]}" << '\n';
+        return file.good();
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+CPUProfiler::ThreadBuffer &CPUProfiler::getThreadBuffer() noexcept
+{
+    if (g_threadBuffer == nullptr)
+    {
+        // First use on this thread, the buffer is owned by the profiler so that its events outlive the thread
+        auto                   buffer = std::make_unique<ThreadBuffer>();
+        std::scoped_lock const lock(bufferLock_);
+        buffer->threadIndex = static_cast<uint32_t>(buffers_.size());
+        g_threadBuffer      = buffer.get();
+        buffers_.emplace_back(std::move(buffer));
+    }
+    return *static_cast<ThreadBuffer *>(g_threadBuffer);
+}
+} // namespace Capsaicin
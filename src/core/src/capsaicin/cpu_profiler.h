@@ -0,0 +1,215 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Hierarchical CPU profiler.
+ * Timed scopes are written into a fixed size ring buffer owned by the recording thread so that recording
+ * never takes a lock. Nesting is not stored explicitly as it can be recovered from the event time ranges.
+ * GPU timestamps can be added to the same timeline so that both can be viewed together.
+ */
+class CPUProfiler
+{
+public:
+    /** The timeline an event is displayed on */
+    enum class Track : uint32_t
+    {
+        CPU,
+        GPU,
+    };
+
+    struct Event
+    {
+        std::string_view name;         /**< Event name (must point to storage with static lifetime) */
+        uint64_t         start    = 0; /**< Start time (nanoseconds since profiler creation) */
+        uint64_t         duration = 0; /**< Duration (nanoseconds) */
+        uint32_t         frame    = 0; /**< Frame index the event was recorded in */
+        Track            track    = Track::CPU;
+    };
+
+    struct ThreadEvents
+    {
+        uint32_t           threadIndex = 0; /**< Sequential index assigned to the recording thread */
+        std::string        threadName;      /**< Optional name of the recording thread */
+        std::vector<Event> events;          /**< The recorded events (in recording order) */
+    };
+
+    /** Scoped timer that records an event covering its lifetime. */
+    class ScopedEvent
+    {
+    public:
+        explicit ScopedEvent(std::string_view const &eventName) noexcept;
+        ~ScopedEvent() noexcept;
+
+        ScopedEvent(ScopedEvent const &other)                = delete;
+        ScopedEvent(ScopedEvent &&other) noexcept            = delete;
+        ScopedEvent &operator=(ScopedEvent const &other)     = delete;
+        ScopedEvent &operator=(ScopedEvent &&other) noexcept = delete;
+
+    private:
+        std::string_view name;
+        uint64_t         start = std::numeric_limits<uint64_t>::max();
+    };
+
+    /** Number of events each thread can hold before the oldest events are overwritten */
+    static constexpr uint32_t kThreadBufferSize = 1U << 14U;
+
+    CPUProfiler(CPUProfiler const &other)                = delete;
+    CPUProfiler(CPUProfiler &&other) noexcept            = delete;
+    CPUProfiler &operator=(CPUProfiler const &other)     = delete;
+    CPUProfiler &operator=(CPUProfiler &&other) noexcept = delete;
+
+    /**
+     * Gets the global profiler instance.
+     * @return The profiler.
+     */
+    static CPUProfiler &Get() noexcept;
+
+    /**
+     * Enable or disable recording of new events.
+     * @param enable True to enable recording.
+     */
+    void setEnabled(bool enable) noexcept;
+
+    /**
+     * Check if events are currently being recorded.
+     * @return True if enabled, False otherwise.
+     */
+    [[nodiscard]] bool getEnabled() const noexcept
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Set the frame index that newly recorded events are tagged with.
+     * @param frameIndex The current frame index.
+     */
+    void setFrameIndex(uint32_t frameIndex) noexcept;
+
+    /**
+     * Set the display name of the calling thread.
+     * @param threadName The name of the thread.
+     */
+    void setThreadName(std::string_view const &threadName) noexcept;
+
+    /**
+     * Gets the current profiler time.
+     * @return The time in nanoseconds since the profiler was created.
+     */
+    [[nodiscard]] uint64_t now() const noexcept;
+
+    /**
+     * Record a new event into the calling threads buffer.
+     * @param name  The name of the event (must point to storage with static lifetime).
+     * @param start The event start time (from @now()).
+     * @param end   The event end time (from @now()).
+     * @param track (Optional) The timeline to display the event on.
+     */
+    void addEvent(
+        std::string_view const &name, uint64_t start, uint64_t end, Track track = Track::CPU) noexcept;
+
+    /** Discard all currently recorded events. */
+    void reset() noexcept;
+
+    /**
+     * Gets a copy of all currently recorded events.
+     * @return The list of events for each thread that has recorded events.
+     */
+    [[nodiscard]] std::vector<ThreadEvents> getEvents() const noexcept;
+
+    /**
+     * Saves all currently recorded events to disk using the Chrome trace event format.
+     * @note The output can be viewed using chrome://tracing or https://ui.perfetto.dev.
+     * @param filePath Full pathname to the file to save as.
+     * @return True if successful, False otherwise.
+     */
+    [[nodiscard]] bool saveChromeTrace(std::filesystem::path const &filePath) const noexcept;
+
+private:
+    CPUProfiler() noexcept;
+    ~CPUProfiler() noexcept = default;
+
+    /**
+     * Ring buffer slot holding a single event.
+     * Slots are published using a sequence lock so that other threads can copy them while the owning thread
+     * keeps recording, all fields are atomics so that concurrent copies are never a data race.
+     */
+    struct Slot
+    {
+        std::atomic<uint64_t>     sequence   = 0; /**< Index of the stored event + 1, 0 while being written */
+        std::atomic<char const *> name       = nullptr;
+        std::atomic<size_t>       nameLength = 0;
+        std::atomic<uint64_t>     start      = 0;
+        std::atomic<uint64_t>     duration   = 0;
+        std::atomic<uint32_t>     frame      = 0;
+        std::atomic<Track>        track      = Track::CPU;
+    };
+
+    struct ThreadBuffer
+    {
+        uint32_t                            threadIndex = 0;
+        std::string                         threadName;
+        std::array<Slot, kThreadBufferSize> slots;
+        std::atomic<uint64_t>               head = 0; /**< Total number of events ever written */
+        std::atomic<uint64_t>               tail = 0; /**< First event still valid after a reset */
+    };
+
+    /**
+     * Gets the ring buffer owned by the calling thread, creating it on first use.
+     * @return The threads buffer.
+     */
+    ThreadBuffer &getThreadBuffer() noexcept;
+
+    std::chrono::steady_clock::time_point      epoch_; /**< Time that all events are relative to */
+    std::atomic<bool>                          enabled_    = false;
+    std::atomic<uint32_t>                      frameIndex_ = 0;
+    mutable std::mutex                         bufferLock_; /**< Only used when creating new thread buffers */
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+};
+} // namespace Capsaicin
+
+#if defined(CAPSAICIN_ENABLE_CPU_PROFILER) && CAPSAICIN_ENABLE_CPU_PROFILER
+#    define CAPSAICIN_PROFILE_CONCAT_INNER(a, b) a##b
+#    define CAPSAICIN_PROFILE_CONCAT(a, b)       CAPSAICIN_PROFILE_CONCAT_INNER(a, b)
+/** Record the CPU time spent until the end of the current scope */
+#    define CAPSAICIN_PROFILE_SCOPE(name)                                                                  \
+        Capsaicin::CPUProfiler::ScopedEvent const CAPSAICIN_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+/** Record the CPU time spent in the current function */
+#    define CAPSAICIN_PROFILE_FUNCTION() CAPSAICIN_PROFILE_SCOPE(__func__)
+#else
+#    define CAPSAICIN_PROFILE_SCOPE(name) static_cast<void>(0)
+#    define CAPSAICIN_PROFILE_FUNCTION()  static_cast<void>(0)
+#endif
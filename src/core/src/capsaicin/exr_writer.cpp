@@ -0,0 +1,290 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "exr_writer.h"
+
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <gfx.h>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin
+{
+namespace
+{
+/** Minimum number of compressed blocks in each band, avoids splitting small images */
+constexpr uint32_t kMinBlocksPerBand = 4;
+
+/** A band of scanlines encoded as a standalone EXR file */
+struct EncodedBand
+{
+    unsigned char        *memory              = nullptr; /**< Encoded file allocated by tinyexr */
+    size_t                size                = 0;
+    char const           *error               = nullptr; /**< Error message allocated by tinyexr */
+    size_t                headerSize          = 0;       /**< Offset of the line offset table */
+    size_t                dataWindowOffset    = 0;       /**< Offset of the dataWindow attribute value */
+    size_t                displayWindowOffset = 0;       /**< Offset of the displayWindow attribute value */
+    int32_t               minY                = 0;       /**< First scanline of the band data window */
+    std::vector<uint64_t> chunkOffsets;                  /**< File offset of each compressed block */
+};
+
+/**
+ * Gets the number of scanlines stored in each compressed block.
+ * @param compressionType The tinyexr compression type.
+ * @return The scanline count, 0 if splitting is not supported for the compression type.
+ */
+uint32_t GetScanlinesPerBlock(int const compressionType) noexcept
+{
+    switch (compressionType)
+    {
+    case TINYEXR_COMPRESSIONTYPE_NONE: [[fallthrough]];
+    case TINYEXR_COMPRESSIONTYPE_RLE: [[fallthrough]];
+    case TINYEXR_COMPRESSIONTYPE_ZIPS: return 1;
+    case TINYEXR_COMPRESSIONTYPE_ZIP: return 16;
+    case TINYEXR_COMPRESSIONTYPE_PIZ: return 32;
+    default: return 0;
+    }
+}
+
+template<typename T>
+T Read(unsigned char const *data) noexcept
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+template<typename T>
+void Write(unsigned char *data, T const value) noexcept
+{
+    std::memcpy(data, &value, sizeof(T));
+}
+
+/**
+ * Reads the header and line offset table of an encoded single part scanline file.
+ * @param band          The encoded band.
+ * @param linesPerBlock Number of scanlines stored in each block.
+ * @return True if successful, False if the file layout was not recognised.
+ */
+bool ParseBand(EncodedBand &band, uint32_t const linesPerBlock) noexcept
+{
+    unsigned char const *data = band.memory;
+    size_t const         size = band.size;
+    // Magic number and version, tiled, deep and multi-part files are not supported
+    if (size < 8 || Read<uint32_t>(data) != 20000630U || data[4] != 2 || (data[5] & 0x1A) != 0)
+    {
+        return false;
+    }
+    auto const readString = [&](size_t &position) -> std::string_view {
+        auto const *end =
+            static_cast<unsigned char const *>(std::memchr(data + position, 0, size - position));
+        if (end == nullptr)
+        {
+            return {};
+        }
+        std::string_view const ret(reinterpret_cast<char const *>(data + position),
+            static_cast<size_t>(end - (data + position)));
+        position += ret.size() + 1;
+        return ret;
+    };
+    int32_t maxY     = -1;
+    size_t  position = 8;
+    while (position < size)
+    {
+        std::string_view const name = readString(position);
+        if (name.empty())
+        {
+            break; // null byte marking the end of the header
+        }
+        std::string_view const type = readString(position);
+        if (type.empty() || position + 4 > size)
+        {
+            return false;
+        }
+        auto const attributeSize = static_cast<size_t>(Read<uint32_t>(data + position));
+        position += 4;
+        if (position + attributeSize > size)
+        {
+            return false;
+        }
+        if (type == "box2i" && attributeSize == 16)
+        {
+            if (name == "dataWindow")
+            {
+                band.dataWindowOffset = position;
+                band.minY             = Read<int32_t>(data + position + 4);
+                maxY                  = Read<int32_t>(data + position + 12);
+            }
+            else if (name == "displayWindow")
+            {
+                band.displayWindowOffset = position;
+            }
+        }
+        position += attributeSize;
+    }
+    if (band.dataWindowOffset == 0 || maxY < band.minY)
+    {
+        return false;
+    }
+    band.headerSize         = position;
+    size_t const chunkCount = (static_cast<size_t>(maxY - band.minY) + linesPerBlock) / linesPerBlock;
+    if (position + chunkCount * 8 > size)
+    {
+        return false;
+    }
+    band.chunkOffsets.resize(chunkCount);
+    for (auto &offset : band.chunkOffsets)
+    {
+        offset = Read<uint64_t>(data + position);
+        position += 8;
+        if (offset + 8 > size || offset + 8 + Read<uint32_t>(data + offset + 4) > size)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // unnamed namespace
+
+bool SaveEXRImageParallel(
+    EXRImage const &image, EXRHeader const &header, std::filesystem::path const &filePath) noexcept
+{
+    uint32_t const linesPerBlock = GetScanlinesPerBlock(header.compression_type);
+    uint32_t const height        = static_cast<uint32_t>(std::max(image.height, 0));
+    uint32_t const blockCount    = linesPerBlock > 0 ? (height + linesPerBlock - 1) / linesPerBlock : 0;
+    uint32_t       bandCount =
+        std::min(TaskScheduler::Get().getWorkerCount() + 1, blockCount / kMinBlocksPerBand);
+    if (bandCount <= 1 || image.tiles != nullptr)
+    {
+        // Not worth splitting, save directly
+        char const *err = nullptr;
+        if (SaveEXRImageToFile(&image, &header, filePath.string().c_str(), &err) != TINYEXR_SUCCESS)
+        {
+            GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s': %s", filePath.string().c_str(),
+                err != nullptr ? err : "Unknown error");
+            FreeEXRErrorMessage(err);
+            return false;
+        }
+        return true;
+    }
+    // Bands must start on a block boundary so that the joined blocks are identical to a serial save
+    uint32_t const bandHeight = (blockCount + bandCount - 1) / bandCount * linesPerBlock;
+    bandCount                 = (height + bandHeight - 1) / bandHeight;
+
+    std::vector<EncodedBand> bands(bandCount);
+    TaskScheduler::Get().parallelFor(0U, bandCount, [&](uint32_t const bandIndex) {
+        uint32_t const firstLine = bandIndex * bandHeight;
+        EXRImage       bandImage = image;
+        bandImage.height         = static_cast<int>(std::min(bandHeight, height - firstLine));
+        std::vector<unsigned char *> channels(static_cast<size_t>(image.num_channels));
+        for (size_t channel = 0; channel < channels.size(); ++channel)
+        {
+            size_t const valueSize = header.pixel_types[channel] == TINYEXR_PIXELTYPE_HALF ? 2 : 4;
+            channels[channel] =
+                image.images[channel] + static_cast<size_t>(firstLine) * image.width * valueSize;
+        }
+        bandImage.images = channels.data();
+        auto &band       = bands[bandIndex];
+        band.size        = SaveEXRImageToMemory(&bandImage, &header, &band.memory, &band.error);
+        if (band.size > 0 && !ParseBand(band, linesPerBlock))
+        {
+            band.size = 0;
+        }
+    });
+
+    bool ret = true;
+    try
+    {
+        size_t chunkCount = 0;
+        size_t dataSize   = 0;
+        for (auto const &band : bands)
+        {
+            if (band.size == 0)
+            {
+                GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s': %s", filePath.string().c_str(),
+                    band.error != nullptr ? band.error : "Failed to encode image");
+                ret = false;
+                break;
+            }
+            chunkCount += band.chunkOffsets.size();
+            dataSize += band.size;
+        }
+        if (ret)
+        {
+            // Use the header of the first band extended to cover the full image height
+            auto const           &first = bands.front();
+            std::vector<uint64_t> offsets;
+            offsets.reserve(chunkCount);
+            std::vector<unsigned char> output(first.memory, first.memory + first.headerSize);
+            output.reserve(dataSize);
+            int32_t const maxY = first.minY + static_cast<int32_t>(height) - 1;
+            Write(output.data() + first.dataWindowOffset + 12, maxY);
+            if (first.displayWindowOffset != 0)
+            {
+                Write(output.data() + first.displayWindowOffset + 12, maxY);
+            }
+            output.resize(output.size() + chunkCount * 8);
+            for (uint32_t bandIndex = 0; bandIndex < bandCount; ++bandIndex)
+            {
+                auto const &band = bands[bandIndex];
+                for (uint64_t const chunkOffset : band.chunkOffsets)
+                {
+                    // Move the chunk scanline from band to image space
+                    unsigned char const *chunk = band.memory + chunkOffset;
+                    int32_t const        line  = Read<int32_t>(chunk) - band.minY + first.minY
+                                       + static_cast<int32_t>(bandIndex * bandHeight);
+                    size_t const chunkSize = 8 + static_cast<size_t>(Read<uint32_t>(chunk + 4));
+                    offsets.push_back(output.size());
+                    output.insert(output.end(), chunk, chunk + chunkSize);
+                    Write(output.data() + offsets.back(), line);
+                }
+            }
+            std::memcpy(output.data() + first.headerSize, offsets.data(), offsets.size() * 8);
+
+            std::ofstream file(filePath, std::ios::binary);
+            file.write(
+                reinterpret_cast<char const *>(output.data()), static_cast<std::streamsize>(output.size()));
+            if (!file.good())
+            {
+                GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s'", filePath.string().c_str());
+                ret = false;
+            }
+        }
+    }
+    catch (...)
+    {
+        GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s'", filePath.string().c_str());
+        ret = false;
+    }
+    for (auto const &band : bands)
+    {
+        std::free(band.memory);
+        FreeEXRErrorMessage(band.error);
+    }
+    return ret;
+}
+} // namespace Capsaicin
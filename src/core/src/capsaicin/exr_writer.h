@@ -21,26 +21,20 @@ THE SOFTWARE.
 ********************************************************************/
 #pragma once
 
-#include <array>
+#include <filesystem>
+#include <tinyexr.h>
 
 namespace Capsaicin
 {
-class Graph
-{
-public:
-    Graph() noexcept = default;
-
-    [[nodiscard]] uint32_t getValueCount() const noexcept;
-    void                   addValue(double value) noexcept;
-    [[nodiscard]] double   getLastAddedValue() const noexcept;
-    [[nodiscard]] double   getValueAtIndex(uint32_t index) const noexcept;
-    [[nodiscard]] double   getAverageValue() const noexcept;
-    void                   reset() noexcept;
-
-    static float GetValueAtIndex(void *object, int32_t index) noexcept;
-
-private:
-    uint32_t                current = 0;     /**< The current cursor into values circular buffer */
-    std::array<double, 256> values  = {0.0}; /**< The stored list of values */
-};
+/**
+ * Saves an EXR image to disk, compressing blocks of scanlines in parallel.
+ * The image is split into horizontal bands that are each encoded on a separate thread, the compressed
+ * blocks of every band are then joined into a single scanline image identical in layout to a serial save.
+ * @param image    The image to save (planar channels).
+ * @param header   The image header, pixel types must describe the planar channel data.
+ * @param filePath Full pathname to the file to save as.
+ * @return True if successful, False otherwise.
+ */
+bool SaveEXRImageParallel(
+    EXRImage const &image, EXRHeader const &header, std::filesystem::path const &filePath) noexcept;
 } // namespace Capsaicin
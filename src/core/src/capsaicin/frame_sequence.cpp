@@ -0,0 +1,468 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "frame_sequence.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <new>
+#include <string>
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <cstdio>
+#endif
+
+namespace Capsaicin
+{
+static_assert(sizeof(FrameSequenceHeader) == 48, "Frame sequence header must not contain padding");
+static_assert(sizeof(FrameSequenceIndexEntry) == 16, "Frame sequence index must not contain padding");
+static_assert(sizeof(FrameSequenceHeader) <= FrameSequenceWriter::kBlockSize);
+static_assert(FrameSequenceWriter::kStagingSize % FrameSequenceWriter::kBlockSize == 0);
+
+namespace
+{
+/** Number of pixels converted to YUV at a time */
+constexpr size_t kY4MChunkSize = 4096;
+
+/** Releases memory allocated with block alignment */
+struct AlignedDelete
+{
+    void operator()(uint8_t *memory) const noexcept
+    {
+        ::operator delete[](memory, std::align_val_t(FrameSequenceWriter::kBlockSize));
+    }
+};
+
+/**
+ * Converts a single channel of planar RGB data to YCbCr using BT.709 limited range coefficients.
+ * @param planes      The R, G and B planes.
+ * @param channel     The output channel (0 for Y, 1 for Cb, 2 for Cr).
+ * @param first       Index of the first pixel to convert.
+ * @param count       Number of pixels to convert.
+ * @param destination Output converted values.
+ */
+void ConvertRGBToYCbCr(std::array<uint8_t const *, 3> const &planes, uint32_t const channel,
+    size_t const first, size_t const count, uint8_t *destination) noexcept
+{
+    constexpr float kr        = 0.2126F;
+    constexpr float kb        = 0.0722F;
+    constexpr float kg        = 1.0F - kr - kb;
+    constexpr float lumaScale = 219.0F / 255.0F;
+    constexpr float blueScale = 224.0F / 255.0F / (2.0F * (1.0F - kb));
+    constexpr float redScale  = 224.0F / 255.0F / (2.0F * (1.0F - kr));
+
+    // Weights of R, G and B followed by the offset, offsets include 0.5 so that truncation rounds to nearest
+    constexpr float weights[3][4] = {
+        {kr * lumaScale, kg * lumaScale, kb * lumaScale, 16.5F},
+        {-kr * blueScale, -kg * blueScale, (1.0F - kb) * blueScale, 128.5F},
+        {(1.0F - kr) * redScale, -kg * redScale, -kb * redScale, 128.5F},
+    };
+    float const *weight = weights[channel];
+    for (size_t pixel = first; pixel < first + count; ++pixel)
+    {
+        float const value = weight[0] * static_cast<float>(planes[0][pixel])
+                          + weight[1] * static_cast<float>(planes[1][pixel])
+                          + weight[2] * static_cast<float>(planes[2][pixel]) + weight[3];
+        *destination++    = static_cast<uint8_t>(std::clamp(value, 0.0F, 255.0F));
+    }
+}
+} // unnamed namespace
+
+uint64_t GetFrameSequenceFrameSize(FrameSequenceHeader const &header) noexcept
+{
+    uint64_t const bytesPerValue = header.pixelType == FrameSequencePixelType::Float16 ? 2 : 1;
+    return static_cast<uint64_t>(header.width) * header.height * header.channelCount * bytesPerValue;
+}
+
+/**
+ * Output file that stages writes in a block aligned buffer so that data reaches the disk in large
+ * sequential chunks. Unbuffered files bypass the OS file cache, all writes to them must be made in whole
+ * blocks.
+ */
+struct FrameSequenceWriter::File
+{
+    File()                                   = default;
+    File(File const &other)                  = delete;
+    File(File &&other) noexcept              = delete;
+    File &operator=(File const &other)       = delete;
+    File &operator=(File &&other) noexcept   = delete;
+
+    ~File() noexcept { close(); }
+
+    bool open(std::filesystem::path const &filePath, bool const unbufferedIn) noexcept
+    {
+        staging.reset(new (std::align_val_t(kBlockSize), std::nothrow) uint8_t[kStagingSize]);
+        if (!staging)
+        {
+            return false;
+        }
+        unbuffered = unbufferedIn;
+#ifdef _WIN32
+        DWORD const flags =
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN | (unbuffered ? FILE_FLAG_NO_BUFFERING : 0);
+        handle = CreateFileW(
+            filePath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, flags, nullptr);
+        return handle != INVALID_HANDLE_VALUE;
+#else
+        handle = std::fopen(filePath.c_str(), "wb");
+        if (handle == nullptr)
+        {
+            return false;
+        }
+        // Writes are already staged so the C runtime buffer only adds a copy
+        std::setvbuf(handle, nullptr, _IONBF, 0);
+        return true;
+#endif
+    }
+
+    bool write(void const *data, size_t size) noexcept
+    {
+        auto const *source = static_cast<uint8_t const *>(data);
+        while (size > 0)
+        {
+            size_t const count = std::min(size, static_cast<size_t>(kStagingSize - stagedSize));
+            std::memcpy(staging.get() + stagedSize, source, count);
+            stagedSize += count;
+            position += count;
+            source += count;
+            size -= count;
+            if (stagedSize == kStagingSize && !flush())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool pad(uint64_t const alignment) noexcept
+    {
+        uint64_t const padding = (alignment - position % alignment) % alignment;
+        for (uint64_t written = 0; written < padding;)
+        {
+            size_t const count = std::min(
+                static_cast<size_t>(padding - written), static_cast<size_t>(kStagingSize - stagedSize));
+            std::memset(staging.get() + stagedSize, 0, count);
+            stagedSize += count;
+            position += count;
+            written += count;
+            if (stagedSize == kStagingSize && !flush())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool flush() noexcept
+    {
+        bool const ret = writeAt(position - stagedSize, staging.get(), stagedSize);
+        stagedSize     = 0;
+        return ret;
+    }
+
+    bool writeAt(uint64_t const offset, void const *data, size_t const size) noexcept
+    {
+        if (size == 0)
+        {
+            return true;
+        }
+        if (unbuffered && (offset % kBlockSize != 0 || size % kBlockSize != 0))
+        {
+            return false;
+        }
+#ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        overlapped.Offset     = static_cast<DWORD>(offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD written         = 0;
+        return WriteFile(handle, data, static_cast<DWORD>(size), &written, &overlapped) != FALSE
+            && written == size;
+#else
+        return fseeko(handle, static_cast<off_t>(offset), SEEK_SET) == 0
+            && std::fwrite(data, 1, size, handle) == size;
+#endif
+    }
+
+    bool close() noexcept
+    {
+        bool ret = true;
+#ifdef _WIN32
+        if (handle != INVALID_HANDLE_VALUE)
+        {
+            ret    = CloseHandle(handle) != FALSE;
+            handle = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (handle != nullptr)
+        {
+            ret    = std::fclose(handle) == 0;
+            handle = nullptr;
+        }
+#endif
+        staging.reset();
+        stagedSize = 0;
+        position   = 0;
+        return ret;
+    }
+
+    std::unique_ptr<uint8_t[], AlignedDelete> staging;
+    size_t                                    stagedSize = 0; /**< Bytes waiting in the staging buffer */
+    uint64_t                                  position   = 0; /**< Bytes written including staged data */
+    bool                                      unbuffered = false;
+#ifdef _WIN32
+    HANDLE handle = INVALID_HANDLE_VALUE;
+#else
+    std::FILE *handle = nullptr;
+#endif
+};
+
+FrameSequenceWriter::FrameSequenceWriter() noexcept = default;
+
+FrameSequenceWriter::~FrameSequenceWriter() noexcept
+{
+    close();
+}
+
+bool FrameSequenceWriter::open(std::filesystem::path const &filePath, uint32_t const width,
+    uint32_t const height, uint32_t const channelCount, FrameSequencePixelType const pixelType) noexcept
+{
+    close();
+    try
+    {
+        auto extension = filePath.extension().string();
+        std::ranges::transform(extension, extension.begin(), tolower);
+        isY4M = extension != ".capseq";
+        if (width == 0 || height == 0 || channelCount == 0 || channelCount > 4
+            || (isY4M && (channelCount != 3 || pixelType != FrameSequencePixelType::UInt8)))
+        {
+            return false;
+        }
+        header              = {};
+        header.width        = width;
+        header.height       = height;
+        header.channelCount = channelCount;
+        header.pixelType    = pixelType;
+        header.frameStride =
+            (GetFrameSequenceFrameSize(header) + kBlockSize - 1) / kBlockSize * kBlockSize;
+        index.clear();
+        failed = false;
+
+        file = std::make_unique<File>();
+        if (!file->open(filePath, !isY4M))
+        {
+            file.reset();
+            return false;
+        }
+        if (isY4M)
+        {
+            std::string const y4mHeader = "YUV4MPEG2 W" + std::to_string(width) + " H"
+                                        + std::to_string(height) + " F" + std::to_string(kY4MFrameRate)
+                                        + ":1 Ip A1:1 C444\n";
+            failed = !file->write(y4mHeader.data(), y4mHeader.size());
+        }
+        else
+        {
+            // Write a placeholder header, the final values are written once the sequence is closed
+            failed = !file->write(&header, sizeof(header)) || !file->pad(kBlockSize);
+        }
+        return !failed;
+    }
+    catch (...)
+    {
+        file.reset();
+        return false;
+    }
+}
+
+bool FrameSequenceWriter::appendFrame(
+    void const *planes, uint32_t const frameIndex, float const frameTime) noexcept
+{
+    if (!file || failed)
+    {
+        return false;
+    }
+    try
+    {
+        index.push_back({file->position, frameIndex, frameTime});
+    }
+    catch (...)
+    {
+        failed = true;
+        return false;
+    }
+    failed = !(isY4M ? appendY4MFrame(planes) : appendRawFrame(planes));
+    return !failed;
+}
+
+bool FrameSequenceWriter::close() noexcept
+{
+    if (!file)
+    {
+        return true;
+    }
+    bool ret = !failed;
+    if (ret && !isY4M)
+    {
+        // Append the index table and then rewrite the header with its location
+        header.frameCount  = static_cast<uint32_t>(index.size());
+        header.indexOffset = file->position;
+        ret = file->write(index.data(), index.size() * sizeof(FrameSequenceIndexEntry))
+           && file->pad(kBlockSize) && file->flush();
+        if (ret)
+        {
+            std::memset(file->staging.get(), 0, kBlockSize);
+            std::memcpy(file->staging.get(), &header, sizeof(header));
+            ret = file->writeAt(0, file->staging.get(), kBlockSize);
+        }
+    }
+    else if (ret)
+    {
+        ret = file->flush();
+    }
+    ret = file->close() && ret;
+    file.reset();
+    index.clear();
+    return ret;
+}
+
+bool FrameSequenceWriter::isOpen() const noexcept
+{
+    return file != nullptr;
+}
+
+FrameSequenceHeader const &FrameSequenceWriter::getHeader() const noexcept
+{
+    return header;
+}
+
+bool FrameSequenceWriter::appendRawFrame(void const *planes) noexcept
+{
+    return file->write(planes, GetFrameSequenceFrameSize(header)) && file->pad(kBlockSize);
+}
+
+bool FrameSequenceWriter::appendY4MFrame(void const *planes) noexcept
+{
+    constexpr std::string_view frameHeader = "FRAME\n";
+    if (!file->write(frameHeader.data(), frameHeader.size()))
+    {
+        return false;
+    }
+    size_t const                         pixelCount = static_cast<size_t>(header.width) * header.height;
+    auto const                          *rgb        = static_cast<uint8_t const *>(planes);
+    std::array<uint8_t const *, 3> const rgbPlanes  = {rgb, rgb + pixelCount, rgb + 2 * pixelCount};
+    std::array<uint8_t, kY4MChunkSize>   converted;
+    for (uint32_t channel = 0; channel < 3; ++channel)
+    {
+        for (size_t first = 0; first < pixelCount; first += kY4MChunkSize)
+        {
+            size_t const count = std::min(kY4MChunkSize, pixelCount - first);
+            ConvertRGBToYCbCr(rgbPlanes, channel, first, count, converted.data());
+            if (!file->write(converted.data(), count))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool FrameSequenceReader::open(std::filesystem::path const &filePath) noexcept
+{
+    try
+    {
+        index.clear();
+        file.close();
+        file.open(filePath, std::ios::binary);
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))
+            || header.magic != FrameSequenceHeader::kMagic || header.version != FrameSequenceHeader::kVersion
+            || header.channelCount == 0 || header.channelCount > 4
+            || (header.pixelType != FrameSequencePixelType::UInt8
+                && header.pixelType != FrameSequencePixelType::Float16)
+            || header.frameStride < GetFrameSequenceFrameSize(header) || header.frameStride == 0)
+        {
+            return false;
+        }
+        if (header.indexOffset != 0)
+        {
+            index.resize(header.frameCount);
+            file.seekg(static_cast<std::streamoff>(header.indexOffset));
+            return static_cast<bool>(file.read(reinterpret_cast<char *>(index.data()),
+                static_cast<std::streamsize>(index.size() * sizeof(FrameSequenceIndexEntry))));
+        }
+
+        // The sequence was not closed so recover all complete frames, frame indices and times are unknown
+        uint64_t const fileSize = std::filesystem::file_size(filePath);
+        uint64_t const frames =
+            fileSize > FrameSequenceWriter::kBlockSize
+                ? (fileSize - FrameSequenceWriter::kBlockSize) / header.frameStride
+                : 0;
+        for (uint32_t frame = 0; frame < frames; ++frame)
+        {
+            index.push_back({FrameSequenceWriter::kBlockSize + frame * header.frameStride, frame, 0.0F});
+        }
+        header.frameCount = static_cast<uint32_t>(index.size());
+        return true;
+    }
+    catch (...)
+    {
+        index.clear();
+        return false;
+    }
+}
+
+FrameSequenceHeader const &FrameSequenceReader::getHeader() const noexcept
+{
+    return header;
+}
+
+uint32_t FrameSequenceReader::getFrameCount() const noexcept
+{
+    return static_cast<uint32_t>(index.size());
+}
+
+FrameSequenceIndexEntry const &FrameSequenceReader::getIndexEntry(uint32_t const frame) const noexcept
+{
+    return index[frame];
+}
+
+bool FrameSequenceReader::readFrame(uint32_t const frame, void *planes) noexcept
+{
+    if (frame >= index.size())
+    {
+        return false;
+    }
+    try
+    {
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(index[frame].offset));
+        return static_cast<bool>(file.read(
+            static_cast<char *>(planes), static_cast<std::streamsize>(GetFrameSequenceFrameSize(header))));
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+} // namespace Capsaicin
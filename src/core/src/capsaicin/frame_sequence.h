@@ -0,0 +1,197 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace Capsaicin
+{
+/** Type of each value stored in the planes of a raw frame sequence */
+enum class FrameSequencePixelType : uint32_t
+{
+    UInt8   = 0, /**< 8bit normalised unsigned integer */
+    Float16 = 1, /**< IEEE 754 half precision */
+};
+
+/**
+ * Header stored at the start of a raw frame sequence (.capseq) file, all values are little endian.
+ * The header occupies the first block of the file and is followed by each frame, every frame starts on a
+ * block boundary and stores each channel as a separate contiguous plane. An index table containing an entry
+ * for each frame follows the last frame.
+ */
+struct FrameSequenceHeader
+{
+    static constexpr std::array<char, 8> kMagic   = {'C', 'A', 'P', 'S', 'E', 'Q', '\0', '\0'};
+    static constexpr uint32_t            kVersion = 1;
+
+    std::array<char, 8>    magic        = kMagic;
+    uint32_t               version      = kVersion;
+    uint32_t               width        = 0;
+    uint32_t               height       = 0;
+    uint32_t               channelCount = 0;
+    FrameSequencePixelType pixelType    = FrameSequencePixelType::UInt8;
+    uint32_t               frameCount   = 0; /**< Zero if the sequence was not closed */
+    uint64_t               frameStride  = 0; /**< Distance between the start of each frame (bytes) */
+    uint64_t               indexOffset  = 0; /**< File offset of the index table, zero if not closed */
+};
+
+/** Entry within the index table of a raw frame sequence */
+struct FrameSequenceIndexEntry
+{
+    uint64_t offset;     /**< File offset of the frame data */
+    uint32_t frameIndex; /**< Index of the frame within the renderer */
+    float    frameTime;  /**< Frame time (ms) */
+};
+
+/**
+ * Gets the size of the plane data of a single frame.
+ * @param header The sequence header.
+ * @return The frame size (bytes), excluding any padding.
+ */
+uint64_t GetFrameSequenceFrameSize(FrameSequenceHeader const &header) noexcept;
+
+/**
+ * Appends frames to a single sequence file using large sequential writes.
+ * Raw sequences (.capseq) are written with unbuffered I/O where supported, any other extension is written as
+ * an uncompressed 8bit YUV 4:4:4 (BT.709 limited range) Y4M video.
+ */
+class FrameSequenceWriter
+{
+public:
+    /** Alignment of all frame data within raw sequences, must be a multiple of the disk sector size */
+    static constexpr uint64_t kBlockSize = 4096;
+    /** Size of the write staging buffer, frames are written to disk in chunks of this size */
+    static constexpr uint64_t kStagingSize = 8 * 1024 * 1024;
+    /** Frame rate stored in Y4M headers */
+    static constexpr uint32_t kY4MFrameRate = 60;
+
+    FrameSequenceWriter() noexcept;
+    ~FrameSequenceWriter() noexcept;
+
+    FrameSequenceWriter(FrameSequenceWriter const &other)                = delete;
+    FrameSequenceWriter(FrameSequenceWriter &&other) noexcept            = delete;
+    FrameSequenceWriter &operator=(FrameSequenceWriter const &other)     = delete;
+    FrameSequenceWriter &operator=(FrameSequenceWriter &&other) noexcept = delete;
+
+    /**
+     * Create a new sequence file, any currently open sequence is closed first.
+     * @note Y4M sequences require 3 UInt8 channels that are interpreted as RGB.
+     * @param filePath     Full pathname to the file to create.
+     * @param width        The width of each frame.
+     * @param height       The height of each frame.
+     * @param channelCount Number of channels stored for each pixel (range [1, 4]).
+     * @param pixelType    Type of each stored value.
+     * @return True if successful, False otherwise.
+     */
+    bool open(std::filesystem::path const &filePath, uint32_t width, uint32_t height, uint32_t channelCount,
+        FrameSequencePixelType pixelType) noexcept;
+
+    /**
+     * Appends a new frame to the sequence.
+     * @param planes     The frame data, each channel stored as a separate plane one after the other.
+     * @param frameIndex Index of the frame within the renderer.
+     * @param frameTime  Frame time (ms).
+     * @return True if successful, False otherwise.
+     */
+    bool appendFrame(void const *planes, uint32_t frameIndex, float frameTime) noexcept;
+
+    /**
+     * Writes any remaining data and closes the sequence.
+     * @return True if successful, False if any write failed.
+     */
+    bool close() noexcept;
+
+    /**
+     * Check if a sequence is currently open.
+     * @return True if open.
+     */
+    [[nodiscard]] bool isOpen() const noexcept;
+
+    /**
+     * Gets the header of the open sequence.
+     * @return The header.
+     */
+    [[nodiscard]] FrameSequenceHeader const &getHeader() const noexcept;
+
+private:
+    struct File;
+
+    bool appendRawFrame(void const *planes) noexcept;
+    bool appendY4MFrame(void const *planes) noexcept;
+
+    std::unique_ptr<File>                file;
+    FrameSequenceHeader                  header;
+    std::vector<FrameSequenceIndexEntry> index;
+    bool                                 isY4M  = false;
+    bool                                 failed = false; /**< Set if any write has failed */
+};
+
+/** Reads frames from a raw frame sequence (.capseq) file. */
+class FrameSequenceReader
+{
+public:
+    /**
+     * Opens an existing sequence file.
+     * @note Sequences that were not closed correctly are recovered using the frames present in the file.
+     * @param filePath Full pathname to the file to open.
+     * @return True if successful, False otherwise.
+     */
+    bool open(std::filesystem::path const &filePath) noexcept;
+
+    /**
+     * Gets the header of the open sequence.
+     * @return The header.
+     */
+    [[nodiscard]] FrameSequenceHeader const &getHeader() const noexcept;
+
+    /**
+     * Gets the number of frames in the sequence.
+     * @return The frame count.
+     */
+    [[nodiscard]] uint32_t getFrameCount() const noexcept;
+
+    /**
+     * Gets the index table entry of a frame.
+     * @param frame The frame within the sequence (range [0, getFrameCount())).
+     * @return The entry.
+     */
+    [[nodiscard]] FrameSequenceIndexEntry const &getIndexEntry(uint32_t frame) const noexcept;
+
+    /**
+     * Reads the data of a frame.
+     * @param frame  The frame within the sequence (range [0, getFrameCount())).
+     * @param planes Output frame data, must be at least GetFrameSequenceFrameSize() bytes.
+     * @return True if successful, False otherwise.
+     */
+    bool readFrame(uint32_t frame, void *planes) noexcept;
+
+private:
+    std::ifstream                        file;
+    FrameSequenceHeader                  header;
+    std::vector<FrameSequenceIndexEntry> index;
+};
+} // namespace Capsaicin
@@ -0,0 +1,345 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "frame_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace Capsaicin
+{
+namespace
+{
+/** Ratio between consecutive sketch bucket bounds */
+constexpr double kGamma =
+    (1.0 + QuantileSketch::kRelativeAccuracy) / (1.0 - QuantileSketch::kRelativeAccuracy);
+
+/** Number of frames before stutter detection starts, allows the moving average to settle */
+constexpr uint64_t kStutterWarmup = 8;
+
+/** Weight of each new value in the stutter detection moving average */
+constexpr double kMovingAverageWeight = 0.1;
+
+/** Number of bins used for histograms written to disk */
+constexpr uint32_t kHistogramBins = 64;
+
+void WriteJSONStatistics(std::ostream &stream, TimingStatistics const &statistics)
+{
+    stream << "\"count\": " << statistics.count << ", \"mean\": " << statistics.mean
+           << ", \"std_dev\": " << statistics.standardDeviation << ", \"min\": " << statistics.minimum
+           << ", \"max\": " << statistics.maximum << ", \"p50\": " << statistics.p50
+           << ", \"p90\": " << statistics.p90 << ", \"p99\": " << statistics.p99
+           << ", \"stutters\": " << statistics.stutterCount;
+}
+} // unnamed namespace
+
+void QuantileSketch::addValue(double const value) noexcept
+{
+    ++buckets[GetBucket(value)];
+    ++count;
+}
+
+double QuantileSketch::getQuantile(double const quantile) const noexcept
+{
+    if (count == 0)
+    {
+        return 0.0;
+    }
+    // Find the bucket containing the requested rank
+    auto const rank = static_cast<uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count - 1));
+    uint64_t   sum  = 0;
+    for (uint32_t i = 0; i < kBucketCount; ++i)
+    {
+        sum += buckets[i];
+        if (sum > rank)
+        {
+            return GetBucketValue(i);
+        }
+    }
+    return GetBucketValue(kBucketCount - 1);
+}
+
+uint64_t QuantileSketch::getCount() const noexcept
+{
+    return count;
+}
+
+std::vector<uint64_t> QuantileSketch::getHistogram(
+    double const minValue, double const maxValue, uint32_t const binCount) const noexcept
+{
+    std::vector<uint64_t> ret(binCount, 0);
+    if (binCount == 0 || maxValue <= minValue)
+    {
+        return ret;
+    }
+    double const binScale = static_cast<double>(binCount) / (maxValue - minValue);
+    for (uint32_t i = 0; i < kBucketCount; ++i)
+    {
+        if (buckets[i] == 0)
+        {
+            continue;
+        }
+        double const bin = std::clamp(
+            std::floor((GetBucketValue(i) - minValue) * binScale), 0.0, static_cast<double>(binCount - 1));
+        ret[static_cast<size_t>(bin)] += buckets[i];
+    }
+    return ret;
+}
+
+void QuantileSketch::reset() noexcept
+{
+    buckets.fill(0);
+    count = 0;
+}
+
+uint32_t QuantileSketch::GetBucket(double const value) noexcept
+{
+    // Bucket 0 holds all values too small to distinguish, bucket i holds (min*gamma^(i-1), min*gamma^i]
+    if (!(value > kMinValue))
+    {
+        return 0;
+    }
+    double const bucket = std::ceil(std::log(value / kMinValue) / std::log(kGamma));
+    return static_cast<uint32_t>(std::min(bucket, static_cast<double>(kBucketCount - 1)));
+}
+
+double QuantileSketch::GetBucketValue(uint32_t const bucket) noexcept
+{
+    if (bucket == 0)
+    {
+        return 0.0;
+    }
+    // Use the value with equal relative error to both bucket bounds
+    return kMinValue * 2.0 * std::pow(kGamma, static_cast<double>(bucket)) / (kGamma + 1.0);
+}
+
+void RunningStatistics::addValue(double const value) noexcept
+{
+    sketch.addValue(value);
+    ++count;
+    if (count == 1)
+    {
+        minimum       = value;
+        maximum       = value;
+        movingAverage = value;
+    }
+    minimum = std::min(minimum, value);
+    maximum = std::max(maximum, value);
+
+    // Welford's online algorithm avoids the precision loss of accumulating sum of squares
+    double const delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (value - mean);
+
+    if (count > kStutterWarmup && value > movingAverage * kStutterThreshold)
+    {
+        ++stutterCount;
+    }
+    movingAverage += (value - movingAverage) * kMovingAverageWeight;
+}
+
+TimingStatistics RunningStatistics::getStatistics() const noexcept
+{
+    TimingStatistics ret;
+    ret.count             = count;
+    ret.mean              = mean;
+    ret.standardDeviation = count > 1 ? std::sqrt(m2 / static_cast<double>(count - 1)) : 0.0;
+    ret.minimum           = minimum;
+    ret.maximum           = maximum;
+    // Clamp quantiles to the exact extents as bucket values can fall slightly outside them
+    ret.p50          = std::clamp(sketch.getQuantile(0.5), minimum, maximum);
+    ret.p90          = std::clamp(sketch.getQuantile(0.9), minimum, maximum);
+    ret.p99          = std::clamp(sketch.getQuantile(0.99), minimum, maximum);
+    ret.stutterCount = stutterCount;
+    return ret;
+}
+
+QuantileSketch const &RunningStatistics::getSketch() const noexcept
+{
+    return sketch;
+}
+
+void RunningStatistics::reset() noexcept
+{
+    *this = RunningStatistics();
+}
+
+void FrameStatistics::addFrameTime(double const frameTime) noexcept
+{
+    frameTimeStatistics.addValue(frameTime);
+
+    // Update the recent history ring buffer, a running sum avoids rescanning it to get the average
+    if (historyCount == kHistorySize)
+    {
+        historySum -= history[historyCursor];
+    }
+    else
+    {
+        ++historyCount;
+    }
+    history[historyCursor] = frameTime;
+    historySum += frameTime;
+    historyCursor = (historyCursor + 1) % kHistorySize;
+}
+
+void FrameStatistics::addTimestamp(
+    std::string_view const &parent, std::string_view const &name, double const time) noexcept
+{
+    try
+    {
+        timestampName.clear();
+        if (!parent.empty())
+        {
+            timestampName += parent;
+            timestampName += '/';
+        }
+        timestampName += name;
+        auto timestamp = timestamps.find(timestampName);
+        if (timestamp == timestamps.end())
+        {
+            timestamp = timestamps.emplace(timestampName, RunningStatistics()).first;
+        }
+        timestamp->second.addValue(time);
+    }
+    catch (...)
+    {}
+}
+
+RunningStatistics const &FrameStatistics::getFrameTimeStatistics() const noexcept
+{
+    return frameTimeStatistics;
+}
+
+std::map<std::string, TimingStatistics> FrameStatistics::getTimestampStatistics() const noexcept
+{
+    std::map<std::string, TimingStatistics> ret;
+    try
+    {
+        for (auto const &[name, statistics] : timestamps)
+        {
+            ret.emplace(name, statistics.getStatistics());
+        }
+    }
+    catch (...)
+    {}
+    return ret;
+}
+
+double FrameStatistics::getAverageFrameTime() const noexcept
+{
+    return historyCount > 0 ? historySum / static_cast<double>(historyCount) : 0.0;
+}
+
+uint32_t FrameStatistics::getHistoryCount() const noexcept
+{
+    return historyCount;
+}
+
+void FrameStatistics::reset() noexcept
+{
+    frameTimeStatistics.reset();
+    timestamps.clear();
+    history.fill(0.0);
+    historyCursor = 0;
+    historyCount  = 0;
+    historySum    = 0.0;
+}
+
+bool FrameStatistics::save(std::filesystem::path const &filePath) const noexcept
+{
+    try
+    {
+        if (filePath.extension() == ".json")
+        {
+            return saveJSON(filePath);
+        }
+        return saveCSV(filePath);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+float FrameStatistics::GetHistoryValue(void *object, int32_t const index) noexcept
+{
+    auto const &statistics = *static_cast<FrameStatistics const *>(object);
+    uint32_t const position =
+        (statistics.historyCursor + kHistorySize - statistics.historyCount + static_cast<uint32_t>(index))
+        % kHistorySize;
+    return static_cast<float>(statistics.history[position]);
+}
+
+bool FrameStatistics::saveCSV(std::filesystem::path const &filePath) const
+{
+    std::ofstream file(filePath);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    auto const writeRow = [&file](std::string_view const &name, TimingStatistics const &statistics) {
+        file << name << ',' << statistics.count << ',' << statistics.mean << ','
+             << statistics.standardDeviation << ',' << statistics.minimum << ',' << statistics.maximum << ','
+             << statistics.p50 << ',' << statistics.p90 << ',' << statistics.p99 << ','
+             << statistics.stutterCount << '\n';
+    };
+    file << "Name,Count,Mean (ms),StdDev (ms),Min (ms),Max (ms),P50 (ms),P90 (ms),P99 (ms),Stutters\n";
+    writeRow("FrameTime", frameTimeStatistics.getStatistics());
+    for (auto const &[name, statistics] : timestamps)
+    {
+        writeRow(name, statistics.getStatistics());
+    }
+    return file.good();
+}
+
+bool FrameStatistics::saveJSON(std::filesystem::path const &filePath) const
+{
+    std::ofstream file(filePath);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    auto const frameStatistics = frameTimeStatistics.getStatistics();
+    auto const histogram =
+        frameTimeStatistics.getSketch().getHistogram(0.0, frameStatistics.maximum, kHistogramBins);
+    file << "{\n    \"frame_time\": {";
+    WriteJSONStatistics(file, frameStatistics);
+    file << ",\n        \"histogram\": {\"min\": 0, \"max\": " << frameStatistics.maximum << ", \"bins\": [";
+    for (uint32_t i = 0; i < histogram.size(); ++i)
+    {
+        file << (i > 0 ? ", " : "") << histogram[i];
+    }
+    file << "]}},\n    \"timestamps\": {";
+    bool first = true;
+    for (auto const &[name, statistics] : timestamps)
+    {
+        // Timestamp names are code defined identifiers so do not require escaping
+        file << (first ? "\n" : ",\n") << "        \"" << name << "\": {";
+        WriteJSONStatistics(file, statistics.getStatistics());
+        file << '}';
+        first = false;
+    }
+    file << "\n    }\n}\n";
+    return file.good();
+}
+} // namespace Capsaicin
@@ -0,0 +1,202 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "capsaicin_types.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Constant memory streaming quantile estimator.
+ * Values are counted in logarithmically spaced buckets so that any returned quantile is within a fixed
+ * relative error of the true value independent of the number of values added.
+ */
+class QuantileSketch
+{
+public:
+    static constexpr double   kRelativeAccuracy = 0.01;   /**< Maximum relative error of returned values */
+    static constexpr double   kMinValue         = 1.0e-4; /**< Values below this are treated as zero */
+    static constexpr uint32_t kBucketCount      = 1024;   /**< Covers values up to ~8e4 when using ms */
+
+    /**
+     * Adds a new value to the sketch.
+     * @param value The value to add (negative values are treated as zero).
+     */
+    void addValue(double value) noexcept;
+
+    /**
+     * Gets an estimate of a quantile of all added values.
+     * @param quantile The quantile to return (range [0, 1]).
+     * @return The estimated value, zero if no values have been added.
+     */
+    [[nodiscard]] double getQuantile(double quantile) const noexcept;
+
+    /**
+     * Gets the number of values added to the sketch.
+     * @return The value count.
+     */
+    [[nodiscard]] uint64_t getCount() const noexcept;
+
+    /**
+     * Gets a histogram of all added values using evenly spaced bins.
+     * @param minValue The lower bound of the first bin.
+     * @param maxValue The upper bound of the last bin (values outside the range are added to the end bins).
+     * @param binCount Number of bins.
+     * @return The number of values within each bin.
+     */
+    [[nodiscard]] std::vector<uint64_t> getHistogram(
+        double minValue, double maxValue, uint32_t binCount) const noexcept;
+
+    /** Remove all added values. */
+    void reset() noexcept;
+
+private:
+    static uint32_t GetBucket(double value) noexcept;
+    static double   GetBucketValue(uint32_t bucket) noexcept;
+
+    std::array<uint64_t, kBucketCount> buckets = {}; /**< Number of values within each bucket */
+    uint64_t                           count   = 0;  /**< Total number of values */
+};
+
+/** Streaming statistics (moments, extents, quantiles and stutters) of a single timed value. */
+class RunningStatistics
+{
+public:
+    /** Ratio against the moving average above which a value is counted as a stutter */
+    static constexpr double kStutterThreshold = 2.0;
+
+    /**
+     * Adds a new value.
+     * @param value The value to add.
+     */
+    void addValue(double value) noexcept;
+
+    /**
+     * Gets a summary of all added values.
+     * @return The statistics.
+     */
+    [[nodiscard]] TimingStatistics getStatistics() const noexcept;
+
+    /**
+     * Gets the quantile sketch of all added values.
+     * @return The sketch.
+     */
+    [[nodiscard]] QuantileSketch const &getSketch() const noexcept;
+
+    /** Remove all added values. */
+    void reset() noexcept;
+
+private:
+    QuantileSketch sketch;
+    uint64_t       count         = 0;
+    double         mean          = 0.0;
+    double         m2            = 0.0; /**< Sum of squared differences from the mean */
+    double         minimum       = 0.0;
+    double         maximum       = 0.0;
+    double         movingAverage = 0.0; /**< Exponential moving average used for stutter detection */
+    uint64_t       stutterCount  = 0;
+};
+
+/** Collects statistics for the frame time and each GPU timestamp over an entire run. */
+class FrameStatistics
+{
+public:
+    static constexpr uint32_t kHistorySize = 256; /**< Number of recent frame times kept for display */
+
+    /**
+     * Adds a new frame time.
+     * @param frameTime The frame time (ms).
+     */
+    void addFrameTime(double frameTime) noexcept;
+
+    /**
+     * Adds a new GPU timestamp duration.
+     * @param parent Name of the parent timestamp (empty for top level timestamps).
+     * @param name   Name of the timestamp.
+     * @param time   The timestamp duration (ms).
+     */
+    void addTimestamp(std::string_view const &parent, std::string_view const &name, double time) noexcept;
+
+    /**
+     * Gets the statistics for all added frame times.
+     * @return The statistics.
+     */
+    [[nodiscard]] RunningStatistics const &getFrameTimeStatistics() const noexcept;
+
+    /**
+     * Gets summaries of each added GPU timestamp.
+     * @return The statistics for each timestamp (child timestamps are named 'parent/child').
+     */
+    [[nodiscard]] std::map<std::string, TimingStatistics> getTimestampStatistics() const noexcept;
+
+    /**
+     * Gets the average of the most recent frame times.
+     * @return The average frame time (ms).
+     */
+    [[nodiscard]] double getAverageFrameTime() const noexcept;
+
+    /**
+     * Gets the number of recent frame times available.
+     * @return The history count.
+     */
+    [[nodiscard]] uint32_t getHistoryCount() const noexcept;
+
+    /** Remove all added values. */
+    void reset() noexcept;
+
+    /**
+     * Saves all statistics to disk.
+     * @param filePath Full pathname to the file to save as (.json for JSON, otherwise CSV).
+     * @return True if successful, False otherwise.
+     */
+    [[nodiscard]] bool save(std::filesystem::path const &filePath) const noexcept;
+
+    /**
+     * Gets a recent frame time, used as a callback for ImGui::PlotLines.
+     * @param object Pointer to the FrameStatistics object.
+     * @param index  Index of the value to get (zero being the oldest).
+     * @return The frame time (ms).
+     */
+    static float GetHistoryValue(void *object, int32_t index) noexcept;
+
+private:
+    [[nodiscard]] bool saveCSV(std::filesystem::path const &filePath) const;
+    [[nodiscard]] bool saveJSON(std::filesystem::path const &filePath) const;
+
+    RunningStatistics                                     frameTimeStatistics;
+    std::map<std::string, RunningStatistics, std::less<>> timestamps;
+    std::string                                           timestampName; /**< Reused name buffer */
+
+    std::array<double, kHistorySize> history       = {};  /**< Ring buffer of recent frame times */
+    uint32_t                         historyCursor = 0;   /**< Next write position in history */
+    uint32_t                         historyCount  = 0;   /**< Number of valid values in history */
+    double                           historySum    = 0.0; /**< Running sum of valid values in history */
+};
+} // namespace Capsaicin
@@ -0,0 +1,160 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "memory_tracker.h"
+
+#include <algorithm>
+#include <ranges>
+
+namespace Capsaicin
+{
+namespace
+{
+thread_local std::string_view g_currentOwner = MemoryTracker::kDefaultOwner;
+} // unnamed namespace
+
+MemoryTracker::OwnerScope::OwnerScope(std::string_view const &owner) noexcept
+    : previousOwner(g_currentOwner)
+{
+    g_currentOwner = owner;
+}
+
+MemoryTracker::OwnerScope::~OwnerScope() noexcept
+{
+    g_currentOwner = previousOwner;
+}
+
+MemoryTracker &MemoryTracker::Get() noexcept
+{
+    static MemoryTracker tracker;
+    return tracker;
+}
+
+std::string_view MemoryTracker::GetCurrentOwner() noexcept
+{
+    return g_currentOwner;
+}
+
+void MemoryTracker::addAllocation(uint64_t const key, uint64_t const size, bool const cpuVisible) noexcept
+{
+    try
+    {
+        std::scoped_lock const scopedLock(lock);
+        removeAllocationInternal(key);
+        auto owner = usages.find(g_currentOwner);
+        if (owner == usages.end())
+        {
+            owner = usages.emplace(std::string(g_currentOwner), MemoryUsage()).first;
+        }
+        allocations.emplace(key, Allocation {&owner->second, size, cpuVisible});
+        AddUsage(owner->second, size, cpuVisible);
+        AddUsage(totalUsage, size, cpuVisible);
+    }
+    catch (...)
+    {}
+}
+
+void MemoryTracker::removeAllocation(uint64_t const key) noexcept
+{
+    std::scoped_lock const scopedLock(lock);
+    removeAllocationInternal(key);
+}
+
+MemoryUsage MemoryTracker::getUsage(std::string_view const &owner) const noexcept
+{
+    std::scoped_lock const scopedLock(lock);
+    if (auto const usage = usages.find(owner); usage != usages.cend())
+    {
+        return usage->second;
+    }
+    return {};
+}
+
+std::map<std::string, MemoryUsage> MemoryTracker::getUsages() const noexcept
+{
+    std::map<std::string, MemoryUsage> ret;
+    try
+    {
+        std::scoped_lock const scopedLock(lock);
+        ret.insert(usages.cbegin(), usages.cend());
+    }
+    catch (...)
+    {}
+    return ret;
+}
+
+MemoryUsage MemoryTracker::getTotalUsage() const noexcept
+{
+    std::scoped_lock const scopedLock(lock);
+    return totalUsage;
+}
+
+void MemoryTracker::resetPeaks() noexcept
+{
+    std::scoped_lock const scopedLock(lock);
+    for (auto &usage : usages | std::views::values)
+    {
+        usage.gpuPeakBytes = usage.gpuBytes;
+        usage.cpuPeakBytes = usage.cpuBytes;
+    }
+    totalUsage.gpuPeakBytes = totalUsage.gpuBytes;
+    totalUsage.cpuPeakBytes = totalUsage.cpuBytes;
+}
+
+void MemoryTracker::AddUsage(MemoryUsage &usage, uint64_t const size, bool const cpuVisible) noexcept
+{
+    if (cpuVisible)
+    {
+        usage.cpuBytes += size;
+        usage.cpuPeakBytes = std::max(usage.cpuPeakBytes, usage.cpuBytes);
+    }
+    else
+    {
+        usage.gpuBytes += size;
+        usage.gpuPeakBytes = std::max(usage.gpuPeakBytes, usage.gpuBytes);
+    }
+    ++usage.allocationCount;
+}
+
+void MemoryTracker::RemoveUsage(MemoryUsage &usage, uint64_t const size, bool const cpuVisible) noexcept
+{
+    if (cpuVisible)
+    {
+        usage.cpuBytes -= std::min(size, usage.cpuBytes);
+    }
+    else
+    {
+        usage.gpuBytes -= std::min(size, usage.gpuBytes);
+    }
+    --usage.allocationCount;
+}
+
+void MemoryTracker::removeAllocationInternal(uint64_t const key) noexcept
+{
+    if (auto const allocation = allocations.find(key); allocation != allocations.end())
+    {
+        RemoveUsage(*allocation->second.ownerUsage, allocation->second.size, allocation->second.cpuVisible);
+        RemoveUsage(totalUsage, allocation->second.size, allocation->second.cpuVisible);
+        allocations.erase(allocation);
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,154 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "capsaicin_types.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Capsaicin
+{
+/**
+ * Attributes resource allocations to the owner that created them.
+ * Allocations are identified by an opaque key and attributed to the owner that is current on the calling
+ * thread (set using OwnerScope). No graphics API calls are made so the accounting can be used standalone.
+ */
+class MemoryTracker
+{
+public:
+    /** Owner used for any allocation made outside of an OwnerScope */
+    static constexpr std::string_view kDefaultOwner = "Capsaicin";
+    /** Owner used for textures and buffers shared between render techniques */
+    static constexpr std::string_view kSharedOwner = "Shared Resources";
+    /** Owner used for scene geometry, materials and textures */
+    static constexpr std::string_view kSceneOwner = "Scene";
+
+    /** Sets the owner of all allocations made on the calling thread until the end of the current scope. */
+    class OwnerScope
+    {
+    public:
+        explicit OwnerScope(std::string_view const &owner) noexcept;
+        ~OwnerScope() noexcept;
+
+        OwnerScope(OwnerScope const &other)                = delete;
+        OwnerScope(OwnerScope &&other) noexcept            = delete;
+        OwnerScope &operator=(OwnerScope const &other)     = delete;
+        OwnerScope &operator=(OwnerScope &&other) noexcept = delete;
+
+    private:
+        std::string_view previousOwner;
+    };
+
+    MemoryTracker() noexcept = default;
+
+    /**
+     * Gets the global tracker instance.
+     * @return The tracker.
+     */
+    static MemoryTracker &Get() noexcept;
+
+    /**
+     * Gets the owner allocations made on the calling thread are currently attributed to.
+     * @return The owner name.
+     */
+    static std::string_view GetCurrentOwner() noexcept;
+
+    /**
+     * Gets the key used to identify a buffer allocation.
+     * @param index The gfx index of the buffer.
+     * @return The key.
+     */
+    static constexpr uint64_t GetBufferKey(uint32_t const index) noexcept
+    {
+        return index;
+    }
+
+    /**
+     * Gets the key used to identify a texture allocation.
+     * @param index The gfx index of the texture.
+     * @return The key (textures and buffers use separate key ranges).
+     */
+    static constexpr uint64_t GetTextureKey(uint32_t const index) noexcept
+    {
+        return (1ULL << 32) | index;
+    }
+
+    /**
+     * Records a new allocation against the current owner.
+     * @note If the key is already in use the existing allocation is released first.
+     * @param key        Unique identifier of the allocation.
+     * @param size       Size of the allocation (bytes).
+     * @param cpuVisible True if the allocation resides in CPU visible memory (upload/readback).
+     */
+    void addAllocation(uint64_t key, uint64_t size, bool cpuVisible) noexcept;
+
+    /**
+     * Releases a previously recorded allocation.
+     * @param key Unique identifier of the allocation, unknown keys are ignored.
+     */
+    void removeAllocation(uint64_t key) noexcept;
+
+    /**
+     * Gets the memory usage of a single owner.
+     * @param owner The owner name.
+     * @return The memory usage, zero if the owner has never allocated.
+     */
+    [[nodiscard]] MemoryUsage getUsage(std::string_view const &owner) const noexcept;
+
+    /**
+     * Gets the memory usage of each owner that has made an allocation.
+     * @return The memory usage for each owner.
+     */
+    [[nodiscard]] std::map<std::string, MemoryUsage> getUsages() const noexcept;
+
+    /**
+     * Gets the combined memory usage of all owners.
+     * @return The total memory usage.
+     */
+    [[nodiscard]] MemoryUsage getTotalUsage() const noexcept;
+
+    /** Reset all high-water marks to current usage. */
+    void resetPeaks() noexcept;
+
+private:
+    struct Allocation
+    {
+        MemoryUsage *ownerUsage = nullptr; /**< Usage of the owning entry within usages (never erased) */
+        uint64_t     size       = 0;
+        bool         cpuVisible = false;
+    };
+
+    static void AddUsage(MemoryUsage &usage, uint64_t size, bool cpuVisible) noexcept;
+    static void RemoveUsage(MemoryUsage &usage, uint64_t size, bool cpuVisible) noexcept;
+    void        removeAllocationInternal(uint64_t key) noexcept;
+
+    mutable std::mutex                              lock;
+    std::unordered_map<uint64_t, Allocation>        allocations;
+    std::map<std::string, MemoryUsage, std::less<>> usages;
+    MemoryUsage                                     totalUsage;
+};
+} // namespace Capsaicin
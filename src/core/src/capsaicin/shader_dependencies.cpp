@@ -0,0 +1,416 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "shader_dependencies.h"
+
+#include <algorithm>
+#include <fstream>
+#include <ranges>
+#include <set>
+#include <sstream>
+
+namespace Capsaicin
+{
+namespace
+{
+/**
+ * Remove all comments from source code.
+ * @param source The source code.
+ * @return The source with each comment replaced by a space (line endings are preserved).
+ */
+std::string StripComments(std::string_view const &source)
+{
+    std::string ret;
+    ret.reserve(source.size());
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '/')
+        {
+            i = std::min(source.find('\n', i), source.size()) - 1;
+            ret += ' ';
+        }
+        else if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '*')
+        {
+            size_t const end = std::min(source.find("*/", i + 2), source.size());
+            // Keep line endings so that line based parsing is unaffected
+            ret.append(static_cast<size_t>(std::ranges::count(source.substr(i, end - i), '\n')), '\n');
+            ret += ' ';
+            i = std::min(end + 1, source.size());
+        }
+        else
+        {
+            ret += source[i];
+        }
+    }
+    return ret;
+}
+
+std::string_view TrimLeft(std::string_view const &string) noexcept
+{
+    size_t const start = string.find_first_not_of(" \t");
+    return start != std::string_view::npos ? string.substr(start) : std::string_view();
+}
+
+void HashValue(uint64_t &hash, uint64_t const value) noexcept
+{
+    hash = ShaderDependencies::Hash(
+        std::string_view(reinterpret_cast<char const *>(&value), sizeof(value)), hash);
+}
+} // unnamed namespace
+
+void ShaderDependencies::setIncludePaths(std::vector<std::filesystem::path> const &paths) noexcept
+{
+    try
+    {
+        includePaths.clear();
+        for (auto const &includePath : paths)
+        {
+            includePaths.emplace_back(Normalise(includePath));
+        }
+    }
+    catch (...)
+    {}
+    clear();
+}
+
+ShaderDependencies::File ShaderDependencies::scanFile(std::filesystem::path const &file) const noexcept
+{
+    File ret;
+    try
+    {
+        std::error_code ec;
+        ret.writeTime = std::filesystem::last_write_time(file, ec);
+        std::ifstream stream(file, std::ios::binary);
+        if (!stream.is_open())
+        {
+            return ret;
+        }
+        std::stringstream buffer;
+        buffer << stream.rdbuf();
+        std::string const source = buffer.str();
+        ret.hash                 = Hash(source);
+        ret.exists               = true;
+
+        // Includes are searched for relative to the including file and then within each include path
+        auto const directory = file.parent_path();
+        for (auto const &include : ParseIncludes(source))
+        {
+            std::filesystem::path resolved = directory / include;
+            if (!std::filesystem::exists(resolved, ec))
+            {
+                for (auto const &includePath : includePaths)
+                {
+                    if (std::filesystem::exists(includePath / include, ec))
+                    {
+                        resolved = includePath / include;
+                        break;
+                    }
+                }
+            }
+            // Unresolved includes are kept so that the closure changes if the file is later created
+            ret.includes.emplace_back(Normalise(resolved));
+        }
+    }
+    catch (...)
+    {
+        ret = File();
+    }
+    return ret;
+}
+
+void ShaderDependencies::addFile(std::filesystem::path const &file, File scanned) noexcept
+{
+    try
+    {
+        files.insert_or_assign(Normalise(file), std::move(scanned));
+    }
+    catch (...)
+    {}
+}
+
+void ShaderDependencies::invalidate(std::filesystem::path const &file) noexcept
+{
+    files.erase(Normalise(file));
+}
+
+void ShaderDependencies::clear() noexcept
+{
+    files.clear();
+}
+
+std::vector<std::filesystem::path> ShaderDependencies::getIncludeClosure(
+    std::filesystem::path const &file) noexcept
+{
+    std::set<std::filesystem::path> closure;
+    try
+    {
+        std::vector<std::filesystem::path> pending = {Normalise(file)};
+        while (!pending.empty())
+        {
+            auto current = std::move(pending.back());
+            pending.pop_back();
+            if (auto const &scanned = getFile(current); scanned.exists && closure.insert(current).second)
+            {
+                pending.insert(pending.end(), scanned.includes.cbegin(), scanned.includes.cend());
+            }
+        }
+    }
+    catch (...)
+    {}
+    return {closure.cbegin(), closure.cend()};
+}
+
+std::vector<std::filesystem::path> ShaderDependencies::getProgramClosure(
+    std::filesystem::path const &program) noexcept
+{
+    std::set<std::filesystem::path> closure;
+    try
+    {
+        for (auto const &extension : kProgramExtensions)
+        {
+            auto stage = program;
+            stage += extension;
+            std::error_code ec;
+            if (std::filesystem::exists(stage, ec))
+            {
+                std::ranges::copy(getIncludeClosure(stage), std::inserter(closure, closure.end()));
+            }
+        }
+    }
+    catch (...)
+    {}
+    return {closure.cbegin(), closure.cend()};
+}
+
+std::vector<std::filesystem::path> ShaderDependencies::getDependents(
+    std::filesystem::path const &file) const noexcept
+{
+    std::set<std::filesystem::path> dependents;
+    try
+    {
+        // Invert the include graph so that it can be walked from the included file upwards
+        std::multimap<std::filesystem::path, std::filesystem::path const *> includedBy;
+        for (auto const &[path, scanned] : files)
+        {
+            for (auto const &include : scanned.includes)
+            {
+                includedBy.emplace(include, &path);
+            }
+        }
+        std::vector<std::filesystem::path> pending = {Normalise(file)};
+        while (!pending.empty())
+        {
+            auto current = std::move(pending.back());
+            pending.pop_back();
+            auto const [begin, end] = includedBy.equal_range(current);
+            if (dependents.insert(std::move(current)).second)
+            {
+                for (auto i = begin; i != end; ++i)
+                {
+                    pending.push_back(*i->second);
+                }
+            }
+        }
+    }
+    catch (...)
+    {}
+    return {dependents.cbegin(), dependents.cend()};
+}
+
+std::vector<std::filesystem::path> ShaderDependencies::updateModifiedFiles() noexcept
+{
+    std::vector<std::filesystem::path> ret;
+    try
+    {
+        for (auto &[path, scanned] : files)
+        {
+            std::error_code ec;
+            auto const      writeTime = std::filesystem::last_write_time(path, ec);
+            bool const      exists    = !ec;
+            if (exists != scanned.exists || (exists && writeTime != scanned.writeTime))
+            {
+                scanned = scanFile(path);
+                ret.push_back(path);
+            }
+        }
+    }
+    catch (...)
+    {}
+    return ret;
+}
+
+uint64_t ShaderDependencies::getHash(std::vector<std::filesystem::path> const &fileList) noexcept
+{
+    uint64_t hash = Hash({});
+    for (auto const &file : fileList)
+    {
+        // Only the file name is used so that hashes do not depend on where the source tree is located
+        try
+        {
+            hash = Hash(file.filename().string(), hash);
+        }
+        catch (...)
+        {}
+        HashValue(hash, getFile(Normalise(file)).hash);
+    }
+    return hash;
+}
+
+std::vector<std::filesystem::path> ShaderDependencies::FindShaderFiles(
+    std::filesystem::path const &directory) noexcept
+{
+    std::vector<std::filesystem::path> ret;
+    try
+    {
+        std::error_code ec;
+        for (std::filesystem::recursive_directory_iterator i(directory, ec), end; !ec && i != end;
+             i.increment(ec))
+        {
+            if (!i->is_regular_file(ec))
+            {
+                continue;
+            }
+            auto const extension = i->path().extension().string();
+            if (std::ranges::find(kProgramExtensions, extension) != kProgramExtensions.cend()
+                || std::ranges::find(kHeaderExtensions, extension) != kHeaderExtensions.cend())
+            {
+                ret.emplace_back(Normalise(i->path()));
+            }
+        }
+    }
+    catch (...)
+    {}
+    return ret;
+}
+
+std::vector<std::string> ShaderDependencies::ParseIncludes(std::string_view const &source) noexcept
+{
+    std::vector<std::string> ret;
+    try
+    {
+        std::string const code = StripComments(source);
+        for (auto const lineRange : std::views::split(code, '\n'))
+        {
+            // Match '#include "name"' or '#include <name>' allowing whitespace between each token
+            std::string_view line = TrimLeft(std::string_view(lineRange.begin(), lineRange.end()));
+            if (!line.starts_with('#'))
+            {
+                continue;
+            }
+            line = TrimLeft(line.substr(1));
+            if (!line.starts_with("include"))
+            {
+                continue;
+            }
+            line = TrimLeft(line.substr(7));
+            if (line.empty() || (line[0] != '"' && line[0] != '<'))
+            {
+                continue;
+            }
+            size_t const end = line.find(line[0] == '"' ? '"' : '>', 1);
+            if (end != std::string_view::npos && end > 1)
+            {
+                ret.emplace_back(line.substr(1, end - 1));
+            }
+        }
+    }
+    catch (...)
+    {}
+    return ret;
+}
+
+uint64_t ShaderDependencies::Hash(std::string_view const &data, uint64_t const seed) noexcept
+{
+    uint64_t hash = seed;
+    for (char const character : data)
+    {
+        hash ^= static_cast<uint8_t>(character);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+std::filesystem::path ShaderDependencies::Normalise(std::filesystem::path const &file) noexcept
+{
+    try
+    {
+        std::error_code ec;
+        auto const      absolute = std::filesystem::absolute(file, ec);
+        return (ec ? file : absolute).lexically_normal();
+    }
+    catch (...)
+    {
+        return file;
+    }
+}
+
+ShaderDependencies::File const &ShaderDependencies::getFile(std::filesystem::path const &file) noexcept
+{
+    static File const empty;
+    try
+    {
+        auto scanned = files.find(file);
+        if (scanned == files.end())
+        {
+            scanned = files.emplace(file, scanFile(file)).first;
+        }
+        return scanned->second;
+    }
+    catch (...)
+    {
+        return empty;
+    }
+}
+
+std::string GetShaderCacheKey(uint64_t const sourceHash, std::string_view const &entryPoint,
+    std::vector<std::string> const &defines, std::string_view const &compilerVersion) noexcept
+{
+    try
+    {
+        // Each value is followed by a separator so that differently split strings do not match
+        uint64_t hash = ShaderDependencies::Hash({});
+        HashValue(hash, sourceHash);
+        hash = ShaderDependencies::Hash(compilerVersion, hash);
+        hash = ShaderDependencies::Hash(std::string_view("\0", 1), hash);
+        hash = ShaderDependencies::Hash(entryPoint, hash);
+        hash = ShaderDependencies::Hash(std::string_view("\0", 1), hash);
+        auto sortedDefines = defines;
+        std::ranges::sort(sortedDefines);
+        for (auto const &define : sortedDefines)
+        {
+            hash = ShaderDependencies::Hash(define, hash);
+            hash = ShaderDependencies::Hash(std::string_view("\0", 1), hash);
+        }
+        std::string ret(16, '0');
+        for (auto &character : std::views::reverse(ret))
+        {
+            character = "0123456789abcdef"[hash & 0xF];
+            hash >>= 4;
+        }
+        return ret;
+    }
+    catch (...)
+    {
+        return {};
+    }
+}
+} // namespace Capsaicin
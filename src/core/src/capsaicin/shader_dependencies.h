@@ -0,0 +1,176 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Tracks the '#include' dependencies and contents of shader source files.
+ * Used to identify the complete set of source files that a program is compiled from so that programs can
+ * be keyed by their contents. Only the standard library is used so the scanner can be used standalone.
+ */
+class ShaderDependencies
+{
+public:
+    /** File extensions of each shader stage that may be loaded for a program */
+    static constexpr std::array<std::string_view, 7> kProgramExtensions = {
+        ".comp", ".vert", ".frag", ".geom", ".task", ".mesh", ".rt"};
+
+    /** File extensions of shader headers */
+    static constexpr std::array<std::string_view, 3> kHeaderExtensions = {".hlsl", ".h", ".inl"};
+
+    /** A scanned source file */
+    struct File
+    {
+        uint64_t                           hash   = 0;     /**< Hash of the file contents */
+        bool                               exists = false; /**< False if the file could not be read */
+        std::filesystem::file_time_type    writeTime;      /**< Last modification time when scanned */
+        std::vector<std::filesystem::path> includes;       /**< Resolved paths of each direct include */
+    };
+
+    /**
+     * Set the paths used to resolve includes, these are searched in order after the including files
+     * directory. Clears any previously scanned files.
+     * @param paths The include paths.
+     */
+    void setIncludePaths(std::vector<std::filesystem::path> const &paths) noexcept;
+
+    /**
+     * Read and parse a single source file.
+     * @note Does not modify any internal state so may be called concurrently.
+     * @param file Full path to the file.
+     * @return The scanned file.
+     */
+    [[nodiscard]] File scanFile(std::filesystem::path const &file) const noexcept;
+
+    /**
+     * Add a previously scanned file, replacing any existing entry.
+     * @param file    Full path to the file.
+     * @param scanned The scanned file.
+     */
+    void addFile(std::filesystem::path const &file, File scanned) noexcept;
+
+    /**
+     * Remove a file so that it is rescanned the next time it is needed.
+     * @param file Full path to the file.
+     */
+    void invalidate(std::filesystem::path const &file) noexcept;
+
+    /** Remove all scanned files. */
+    void clear() noexcept;
+
+    /**
+     * Gets the source file and every file it includes either directly or indirectly.
+     * @note Any file that has not already been scanned will be scanned on demand.
+     * @param file Full path to the file.
+     * @return The files (sorted) including the input file itself.
+     */
+    [[nodiscard]] std::vector<std::filesystem::path> getIncludeClosure(
+        std::filesystem::path const &file) noexcept;
+
+    /**
+     * Gets every source file used to compile a program.
+     * @param program Full path to the program without extension (as passed to gfxCreateProgram).
+     * @return The files (sorted) of each existing shader stage and everything they include.
+     */
+    [[nodiscard]] std::vector<std::filesystem::path> getProgramClosure(
+        std::filesystem::path const &program) noexcept;
+
+    /**
+     * Gets every scanned file that includes a file either directly or indirectly.
+     * @param file Full path to the file.
+     * @return The files (sorted) including the input file itself.
+     */
+    [[nodiscard]] std::vector<std::filesystem::path> getDependents(
+        std::filesystem::path const &file) const noexcept;
+
+    /**
+     * Check all scanned files for modifications and rescan any that have changed.
+     * @return The files (sorted) that have been modified, created or deleted since they were last scanned.
+     */
+    [[nodiscard]] std::vector<std::filesystem::path> updateModifiedFiles() noexcept;
+
+    /**
+     * Gets a combined hash of the names and contents of a set of files.
+     * @param fileList The files to hash (as returned by getIncludeClosure).
+     * @return The hash.
+     */
+    [[nodiscard]] uint64_t getHash(std::vector<std::filesystem::path> const &fileList) noexcept;
+
+    /**
+     * Find all shader source files within a directory and its sub-directories.
+     * @param directory The directory to search.
+     * @return Full path to each found file.
+     */
+    [[nodiscard]] static std::vector<std::filesystem::path> FindShaderFiles(
+        std::filesystem::path const &directory) noexcept;
+
+    /**
+     * Gets the names of all files included by shader source code.
+     * @note Commented out includes are ignored, preprocessor conditionals are not evaluated.
+     * @param source The source code.
+     * @return The include names in the order they occur.
+     */
+    [[nodiscard]] static std::vector<std::string> ParseIncludes(std::string_view const &source) noexcept;
+
+    /**
+     * Calculate a 64-bit FNV-1a hash, this is stable between runs and platforms.
+     * @param data The data to hash.
+     * @param seed (Optional) Initial hash value, used to combine multiple hashes.
+     * @return The hash.
+     */
+    [[nodiscard]] static uint64_t Hash(
+        std::string_view const &data, uint64_t seed = 0xCBF29CE484222325ULL) noexcept;
+
+    /**
+     * Gets the normalised form of a path used to identify files.
+     * @param file The path to normalise.
+     * @return The absolute normalised path.
+     */
+    [[nodiscard]] static std::filesystem::path Normalise(std::filesystem::path const &file) noexcept;
+
+private:
+    [[nodiscard]] File const &getFile(std::filesystem::path const &file) noexcept;
+
+    std::vector<std::filesystem::path>    includePaths;
+    std::map<std::filesystem::path, File> files;
+};
+
+/**
+ * Calculate the key used to identify a compiled shader.
+ * @param sourceHash      Combined hash of all source files (see ShaderDependencies::getHash).
+ * @param entryPoint      The shader entry point.
+ * @param defines         The preprocessor defines used to compile, ordering is ignored.
+ * @param compilerVersion Version string of the shader compiler.
+ * @return The key as a 16 character hexadecimal string.
+ */
+std::string GetShaderCacheKey(uint64_t sourceHash, std::string_view const &entryPoint,
+    std::vector<std::string> const &defines, std::string_view const &compilerVersion) noexcept;
+} // namespace Capsaicin
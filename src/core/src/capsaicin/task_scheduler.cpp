@@ -0,0 +1,311 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "task_scheduler.h"
+
+#ifdef _WIN32
+#    include <windows.h>
+#elif defined(__linux__)
+#    include <pthread.h>
+#    include <sched.h>
+#endif
+
+namespace Capsaicin
+{
+namespace
+{
+/** Scheduler owning the calling thread, nullptr if not a worker thread */
+thread_local TaskScheduler const *g_workerScheduler = nullptr;
+/** Index of the calling thread within its scheduler */
+thread_local uint32_t g_workerIndex = 0;
+
+void PinThread(std::thread &thread, uint32_t const processor) noexcept
+{
+#ifdef _WIN32
+    if (processor < sizeof(DWORD_PTR) * 8)
+    {
+        SetThreadAffinityMask(thread.native_handle(), DWORD_PTR {1} << processor);
+    }
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(processor, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+    (void)thread;
+    (void)processor;
+#endif
+}
+} // unnamed namespace
+
+TaskScheduler::TaskGroup::TaskGroup(TaskScheduler &schedulerIn) noexcept
+    : scheduler(schedulerIn)
+{}
+
+TaskScheduler::TaskGroup::~TaskGroup() noexcept
+{
+    wait();
+}
+
+void TaskScheduler::TaskGroup::run(std::function<void()> task) noexcept
+{
+    if (scheduler.workerCount == 0)
+    {
+        task();
+        return;
+    }
+    pendingCount.fetch_add(1, std::memory_order_relaxed);
+    scheduler.push(Task {std::move(task), this});
+}
+
+void TaskScheduler::TaskGroup::wait() noexcept
+{
+    while (pendingCount.load(std::memory_order_acquire) > 0)
+    {
+        if (!scheduler.tryRunTask())
+        {
+            // Remaining tasks are executing on other threads
+            std::this_thread::yield();
+        }
+    }
+}
+
+TaskScheduler::TaskScheduler(uint32_t const workerCountIn, bool const pinThreadsIn) noexcept
+{
+    setWorkerCount(workerCountIn, pinThreadsIn);
+}
+
+TaskScheduler::~TaskScheduler() noexcept
+{
+    shutdown();
+}
+
+TaskScheduler &TaskScheduler::Get() noexcept
+{
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+void TaskScheduler::setWorkerCount(uint32_t const workerCountIn, bool const pinThreadsIn) noexcept
+{
+    std::scoped_lock const scopedLock(configLock);
+    stopWorkers();
+    // The thread waiting on a task group also executes tasks so leave a processor free for it
+    workerCount =
+        workerCountIn != ~0U ? workerCountIn : std::max(std::thread::hardware_concurrency(), 1U) - 1;
+    pinThreads = pinThreadsIn;
+}
+
+void TaskScheduler::shutdown() noexcept
+{
+    std::scoped_lock const scopedLock(configLock);
+    stopWorkers();
+}
+
+uint32_t TaskScheduler::getWorkerCount() const noexcept
+{
+    return workerCount;
+}
+
+bool TaskScheduler::getPinThreads() const noexcept
+{
+    return pinThreads;
+}
+
+uint64_t TaskScheduler::getChunkSize(uint64_t const count, uint64_t const grainSize) const noexcept
+{
+    if (workerCount == 0)
+    {
+        return count;
+    }
+    uint64_t const taskCount = (static_cast<uint64_t>(workerCount) + 1) * kTasksPerThread;
+    return std::max(std::max(grainSize, uint64_t {1}), (count + taskCount - 1) / taskCount);
+}
+
+void TaskScheduler::push(Task task) noexcept
+{
+    ensureStarted();
+    auto const count = static_cast<uint32_t>(workers.size());
+    if (count == 0)
+    {
+        // Worker creation failed
+        RunTask(task);
+        return;
+    }
+    // Workers push to their own deque, other threads distribute tasks over all workers
+    uint32_t const index = g_workerScheduler == this
+                             ? g_workerIndex
+                             : nextWorker.fetch_add(1, std::memory_order_relaxed) % count;
+    {
+        std::scoped_lock const scopedLock(workers[index]->lock);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+    queuedCount.fetch_add(1, std::memory_order_release);
+    {
+        // Empty lock ensures a worker checking the queue count can not miss the notification
+        std::scoped_lock const scopedLock(sleepLock);
+    }
+    taskAdded.notify_one();
+}
+
+bool TaskScheduler::tryPop(uint32_t const workerIndex, Task &task) noexcept
+{
+    auto                  &worker = *workers[workerIndex];
+    std::scoped_lock const scopedLock(worker.lock);
+    if (worker.tasks.empty())
+    {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    queuedCount.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool TaskScheduler::trySteal(uint32_t const workerIndex, Task &task) noexcept
+{
+    auto                  &worker = *workers[workerIndex];
+    std::scoped_lock const scopedLock(worker.lock);
+    if (worker.tasks.empty())
+    {
+        return false;
+    }
+    task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    queuedCount.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool TaskScheduler::tryRunTask() noexcept
+{
+    if (queuedCount.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+    auto const count = static_cast<uint32_t>(workers.size());
+    if (count == 0)
+    {
+        return false;
+    }
+    Task           task;
+    bool const     isWorker = g_workerScheduler == this;
+    uint32_t const start = isWorker ? g_workerIndex : nextWorker.load(std::memory_order_relaxed) % count;
+    if (isWorker && tryPop(start, task))
+    {
+        RunTask(task);
+        return true;
+    }
+    for (uint32_t i = isWorker ? 1 : 0; i < count; ++i)
+    {
+        if (trySteal((start + i) % count, task))
+        {
+            RunTask(task);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::RunTask(Task &task) noexcept
+{
+    task.function();
+    task.group->pendingCount.fetch_sub(1, std::memory_order_release);
+}
+
+void TaskScheduler::ensureStarted() noexcept
+{
+    if (started.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    std::scoped_lock const scopedLock(configLock);
+    if (started.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    try
+    {
+        // All workers must exist before any thread starts stealing from them
+        workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            workers.emplace_back(std::make_unique<Worker>());
+        }
+        uint32_t const processorCount = std::max(std::thread::hardware_concurrency(), 1U);
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            workers[i]->thread = std::thread(&TaskScheduler::workerLoop, this, i);
+            if (pinThreads)
+            {
+                // Leave processor 0 to the main thread
+                PinThread(workers[i]->thread, (i + 1) % processorCount);
+            }
+        }
+    }
+    catch (...)
+    {
+        // Can not create threads, fall back to serial execution
+        stopWorkers();
+        workerCount = 0;
+    }
+    started.store(true, std::memory_order_release);
+}
+
+void TaskScheduler::stopWorkers() noexcept
+{
+    {
+        std::scoped_lock const scopedLock(sleepLock);
+        stopping = true;
+    }
+    taskAdded.notify_all();
+    for (auto const &worker : workers)
+    {
+        if (worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+    workers.clear();
+    stopping = false;
+    started.store(false, std::memory_order_release);
+}
+
+void TaskScheduler::workerLoop(uint32_t const workerIndex) noexcept
+{
+    g_workerScheduler = this;
+    g_workerIndex     = workerIndex;
+    while (true)
+    {
+        if (tryRunTask())
+        {
+            continue;
+        }
+        std::unique_lock lock(sleepLock);
+        taskAdded.wait(
+            lock, [this] { return stopping || queuedCount.load(std::memory_order_acquire) > 0; });
+        if (stopping)
+        {
+            return;
+        }
+    }
+}
+} // namespace Capsaicin
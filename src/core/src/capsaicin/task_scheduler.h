@@ -0,0 +1,252 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Portable work-stealing thread pool used for all parallel CPU work within Capsaicin.
+ * Each worker owns a deque of tasks, it executes its own tasks newest first and when empty steals the
+ * oldest tasks from other workers. Threads waiting on a TaskGroup help execute pending tasks so nested
+ * parallel loops can never deadlock. Worker threads are created on first use.
+ * @note Tasks must not throw exceptions.
+ */
+class TaskScheduler
+{
+public:
+    /** Set of tasks that can be waited on together. */
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(TaskScheduler &schedulerIn) noexcept;
+
+        /** Destructor, waits for all tasks within the group to complete. */
+        ~TaskGroup() noexcept;
+
+        TaskGroup(TaskGroup const &other)                = delete;
+        TaskGroup(TaskGroup &&other) noexcept            = delete;
+        TaskGroup &operator=(TaskGroup const &other)     = delete;
+        TaskGroup &operator=(TaskGroup &&other) noexcept = delete;
+
+        /**
+         * Queue a new task within the group.
+         * @note If the scheduler has no workers the task is executed immediately on the calling thread.
+         * @param task The task to execute.
+         */
+        void run(std::function<void()> task) noexcept;
+
+        /** Wait until all tasks within the group have completed, executing pending tasks while waiting. */
+        void wait() noexcept;
+
+    private:
+        friend class TaskScheduler;
+
+        TaskScheduler        &scheduler;
+        std::atomic<uint32_t> pendingCount = 0; /**< Number of queued or executing tasks */
+    };
+
+    /**
+     * Constructor.
+     * @param workerCountIn (Optional) Number of worker threads, ~0 to select based on hardware concurrency.
+     * @param pinThreadsIn  (Optional) True to pin each worker thread to a separate logical processor.
+     */
+    explicit TaskScheduler(uint32_t workerCountIn = ~0U, bool pinThreadsIn = false) noexcept;
+
+    /** Destructor, all task groups must have been waited on beforehand. */
+    ~TaskScheduler() noexcept;
+
+    TaskScheduler(TaskScheduler const &other)                = delete;
+    TaskScheduler(TaskScheduler &&other) noexcept            = delete;
+    TaskScheduler &operator=(TaskScheduler const &other)     = delete;
+    TaskScheduler &operator=(TaskScheduler &&other) noexcept = delete;
+
+    /**
+     * Gets the global scheduler instance.
+     * @return The scheduler.
+     */
+    static TaskScheduler &Get() noexcept;
+
+    /**
+     * Recreates the worker threads.
+     * @note Must not be called while any tasks are pending.
+     * @param workerCountIn Number of worker threads, ~0 to select based on hardware concurrency and 0 to
+     *  execute all tasks serially on the calling thread.
+     * @param pinThreadsIn  True to pin each worker thread to a separate logical processor.
+     */
+    void setWorkerCount(uint32_t workerCountIn, bool pinThreadsIn) noexcept;
+
+    /**
+     * Stops all worker threads, they are recreated on next use.
+     * @note Must not be called while any tasks are pending.
+     */
+    void shutdown() noexcept;
+
+    /**
+     * Gets the number of worker threads.
+     * @return The worker count (not including threads waiting on a task group).
+     */
+    [[nodiscard]] uint32_t getWorkerCount() const noexcept;
+
+    /**
+     * Check if worker threads are pinned to logical processors.
+     * @return True if pinned, False otherwise.
+     */
+    [[nodiscard]] bool getPinThreads() const noexcept;
+
+    /**
+     * Calls a function for every index within a range, the calling thread also executes iterations.
+     * @param first     The first index.
+     * @param last      One past the last index.
+     * @param function  The function to call with each index.
+     * @param grainSize (Optional) Minimum number of indexes per task, 0 to select automatically.
+     */
+    template<typename INDEX, typename FUNCTION>
+    void parallelFor(
+        INDEX const first, INDEX const last, FUNCTION const &function, uint64_t const grainSize = 0) noexcept
+    {
+        if (!(first < last))
+        {
+            return;
+        }
+        auto const     count     = static_cast<uint64_t>(last - first);
+        uint64_t const chunkSize = getChunkSize(count, grainSize);
+        auto const     runChunk  = [&function, first](uint64_t const begin, uint64_t const end) {
+            for (uint64_t i = begin; i < end; ++i)
+            {
+                function(first + static_cast<decltype(last - first)>(i));
+            }
+        };
+        if (chunkSize >= count)
+        {
+            runChunk(0, count);
+            return;
+        }
+        TaskGroup group(*this);
+        for (uint64_t begin = chunkSize; begin < count; begin += chunkSize)
+        {
+            group.run([&runChunk, begin, end = std::min(begin + chunkSize, count)] { runChunk(begin, end); });
+        }
+        runChunk(0, chunkSize);
+        group.wait();
+    }
+
+    /**
+     * Reduces a range in parallel.
+     * The range is split into chunks that depend only on its length, and the per-chunk results are combined
+     * in order. The result is therefore deterministic regardless of worker count even if the combine
+     * function is neither associative nor commutative.
+     * @param first     Iterator (or index) of the first element.
+     * @param last      Iterator (or index) one past the last element.
+     * @param identity  Initial value passed to each chunk.
+     * @param reduce    Function reducing a sub-range, called as reduce(begin, end, identity).
+     * @param combine   Function combining the results of 2 consecutive sub-ranges.
+     * @param grainSize (Optional) Minimum number of elements per chunk, 0 to use the default.
+     * @return The reduced value.
+     */
+    template<typename ITERATOR, typename TYPE, typename REDUCE, typename COMBINE>
+    TYPE parallelReduce(ITERATOR const first, ITERATOR const last, TYPE const &identity, REDUCE const &reduce,
+        COMBINE const &combine, uint64_t const grainSize = 0) noexcept
+    {
+        if (!(first < last))
+        {
+            return identity;
+        }
+        auto const     count      = static_cast<uint64_t>(last - first);
+        uint64_t const chunkSize  = std::max(
+            grainSize > 0 ? grainSize : kReduceGrainSize, (count + kMaxReduceChunks - 1) / kMaxReduceChunks);
+        uint64_t const chunkCount = (count + chunkSize - 1) / chunkSize;
+        if (chunkCount == 1)
+        {
+            return reduce(first, last, identity);
+        }
+        using OFFSET = decltype(last - first);
+        std::vector<TYPE> results(chunkCount, identity);
+        parallelFor(
+            uint64_t {0}, chunkCount,
+            [&](uint64_t const chunk) {
+                auto const begin = static_cast<OFFSET>(chunk * chunkSize);
+                auto const end   = static_cast<OFFSET>(std::min((chunk + 1) * chunkSize, count));
+                results[chunk]   = reduce(first + begin, first + end, identity);
+            },
+            1);
+        TYPE result = std::move(results[0]);
+        for (uint64_t chunk = 1; chunk < chunkCount; ++chunk)
+        {
+            result = combine(result, results[chunk]);
+        }
+        return result;
+    }
+
+private:
+    /** Default minimum elements per reduction chunk */
+    static constexpr uint64_t kReduceGrainSize = 1024;
+    /** Upper bound on reduction chunks, independent of the worker count to keep results deterministic */
+    static constexpr uint64_t kMaxReduceChunks = 256;
+    /** Number of tasks created per thread by parallelFor, allows stealing to balance uneven iterations */
+    static constexpr uint64_t kTasksPerThread = 4;
+
+    struct Task
+    {
+        std::function<void()> function;
+        TaskGroup            *group = nullptr;
+    };
+
+    struct Worker
+    {
+        std::mutex       lock;
+        std::deque<Task> tasks; /**< Owner pushes and pops at the back, thieves take from the front */
+        std::thread      thread;
+    };
+
+    [[nodiscard]] uint64_t getChunkSize(uint64_t count, uint64_t grainSize) const noexcept;
+    void                   push(Task task) noexcept;
+    bool                   tryPop(uint32_t workerIndex, Task &task) noexcept;
+    bool                   trySteal(uint32_t workerIndex, Task &task) noexcept;
+    bool                   tryRunTask() noexcept;
+    static void            RunTask(Task &task) noexcept;
+    void                   ensureStarted() noexcept;
+    void                   stopWorkers() noexcept;
+    void                   workerLoop(uint32_t workerIndex) noexcept;
+
+    std::mutex                           configLock; /**< Serialises worker creation and destruction */
+    std::atomic<bool>                    started = false;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex                           sleepLock;
+    std::condition_variable              taskAdded;       /**< Signalled when a task is queued or on exit */
+    std::atomic<uint32_t>                queuedCount = 0; /**< Number of tasks waiting in any deque */
+    std::atomic<uint32_t>                nextWorker  = 0; /**< Round-robin target for external pushes */
+    uint32_t                             workerCount = 0;
+    bool                                 pinThreads  = false;
+    bool                                 stopping    = false;
+};
+} // namespace Capsaicin
@@ -22,8 +22,9 @@ THE SOFTWARE.
 
 #include "blue_noise_sampler.h"
 
-#include "blue_noise_sampler_samples.h" // Separate file as does not play well with IDEs
+#include "blue_noise_tables.h"
 #include "capsaicin_internal.h"
+#include "memory_tracker.h"
 
 namespace Capsaicin
 {
@@ -36,11 +37,17 @@ BlueNoiseSampler::~BlueNoiseSampler() noexcept
     terminate();
 }
 
-bool BlueNoiseSampler::init([[maybe_unused]] CapsaicinInternal const &capsaicin) noexcept
+bool BlueNoiseSampler::init(CapsaicinInternal const &capsaicin) noexcept
 {
-    sobolBuffer          = gfxCreateBuffer(gfx_, sizeof(Sobol256x256), Sobol256x256);
-    rankingTileBuffer    = gfxCreateBuffer(gfx_, sizeof(RankingTiles), RankingTiles);
-    scramblingTileBuffer = gfxCreateBuffer(gfx_, sizeof(ScramblingTiles), ScramblingTiles);
+    // Tables are loaded on first use, only validate the file header here so that a missing or invalid file
+    // fails initialisation instead of binding empty buffers
+    BlueNoiseTables tables;
+    if (!tables.loadHeader(capsaicin.getShaderPaths()[0] + BlueNoiseTables::kDefaultFile))
+    {
+        GFX_PRINT_ERROR(kGfxResult_InternalError, "Invalid or missing blue noise sample tables '%s'",
+            BlueNoiseTables::kDefaultFile);
+        return false;
+    }
     return true;
 }
 
@@ -51,16 +58,47 @@ void BlueNoiseSampler::run([[maybe_unused]] CapsaicinInternal &capsaicin) noexce
 
 void BlueNoiseSampler::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx_, sobolBuffer);
-    gfxDestroyBuffer(gfx_, rankingTileBuffer);
-    gfxDestroyBuffer(gfx_, scramblingTileBuffer);
+    DestroyBuffer(gfx_, sobolBuffer);
+    DestroyBuffer(gfx_, rankingTileBuffer);
+    DestroyBuffer(gfx_, scramblingTileBuffer);
+    tableSize    = uint4 {0};
+    tablesLoaded = false;
 }
 
 void BlueNoiseSampler::addProgramParameters(
-    [[maybe_unused]] CapsaicinInternal const &capsaicin, GfxProgram const &program) const noexcept
+    CapsaicinInternal const &capsaicin, GfxProgram const &program) const noexcept
 {
+    if (!tablesLoaded)
+    {
+        tablesLoaded = loadTables(capsaicin);
+        if (!tablesLoaded)
+        {
+            GFX_PRINT_ERROR(kGfxResult_InternalError, "Failed to load blue noise sample tables '%s'",
+                BlueNoiseTables::kDefaultFile);
+        }
+    }
     gfxProgramSetParameter(gfx_, program, "g_SobolBuffer", sobolBuffer);
     gfxProgramSetParameter(gfx_, program, "g_RankingTile", rankingTileBuffer);
     gfxProgramSetParameter(gfx_, program, "g_ScramblingTile", scramblingTileBuffer);
+    gfxProgramSetParameter(gfx_, program, "g_BlueNoiseSize", tableSize);
+}
+
+bool BlueNoiseSampler::loadTables(CapsaicinInternal const &capsaicin) const noexcept
+{
+    BlueNoiseTables tables;
+    if (!tables.load(capsaicin.getShaderPaths()[0] + BlueNoiseTables::kDefaultFile))
+    {
+        return false;
+    }
+    // Attribute the upload to the sampler rather than the render technique that first used it
+    MemoryTracker::OwnerScope const memoryOwner(getName());
+    auto const createBuffer = [this](std::vector<uint32_t> const &values) {
+        return CreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(values.size()), values.data());
+    };
+    sobolBuffer          = createBuffer(tables.sobol);
+    rankingTileBuffer    = createBuffer(tables.rankingTile);
+    scramblingTileBuffer = createBuffer(tables.scramblingTile);
+    tableSize = uint4(tables.tileSize, tables.sampleCount, tables.dimensionCount, tables.tileDimensionCount);
+    return true;
 }
 } // namespace Capsaicin
@@ -65,14 +65,25 @@ class BlueNoiseSampler final
 
     /**
      * Add the required program parameters to a shader based on current settings.
+     * @note Sample tables are loaded and uploaded on first use so that they only occupy memory when a render
+     * technique actually uses the sampler.
      * @param capsaicin Current framework context.
      * @param program   The shader program to bind parameters to.
      */
     void addProgramParameters(CapsaicinInternal const &capsaicin, GfxProgram const &program) const noexcept;
 
 private:
-    GfxBuffer sobolBuffer;
-    GfxBuffer rankingTileBuffer;
-    GfxBuffer scramblingTileBuffer;
+    /**
+     * Load the sample tables from disk and upload them to the GPU.
+     * @param capsaicin Current framework context.
+     * @return True if successful, False otherwise.
+     */
+    bool loadTables(CapsaicinInternal const &capsaicin) const noexcept;
+
+    mutable GfxBuffer sobolBuffer;
+    mutable GfxBuffer rankingTileBuffer;
+    mutable GfxBuffer scramblingTileBuffer;
+    mutable uint4     tableSize    = uint4 {0}; /**< Tile size, sample count, dimensions, tile dimensions */
+    mutable bool      tablesLoaded = false;     /**< True once the tables have been uploaded */
 };
 } // namespace Capsaicin
@@ -26,6 +26,7 @@ THE SOFTWARE.
 StructuredBuffer<uint> g_SobolBuffer;
 StructuredBuffer<uint> g_RankingTile;
 StructuredBuffer<uint> g_ScramblingTile;
+uint4 g_BlueNoiseSize; // Tile size, sample count, dimension count, tile dimension count (all but last are powers of 2)
 
 #define GOLDEN_RATIO 1.61803398874989484820f
 
@@ -36,23 +37,29 @@ float samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(in in
 {
     // A Low-Discrepancy Sampler that Distributes Monte Carlo Errors as a Blue Noise in Screen Space - Heitz etal
 
+    uint tileSize           = g_BlueNoiseSize.x;
+    uint sampleCount        = g_BlueNoiseSize.y;
+    uint dimensionCount     = g_BlueNoiseSize.z;
+    uint tileDimensionCount = g_BlueNoiseSize.w;
+
     // wrap arguments
-    pixel_i         = (pixel_i & 127);
-    pixel_j         = (pixel_j & 127);
-    sampleIndex     = (sampleIndex & 255);
-    sampleDimension = (sampleDimension & 255);
+    pixel_i         = (pixel_i & (tileSize - 1));
+    pixel_j         = (pixel_j & (tileSize - 1));
+    sampleIndex     = (sampleIndex & (sampleCount - 1));
+    sampleDimension = (sampleDimension & (dimensionCount - 1));
+    int tileIndex   = (sampleDimension % tileDimensionCount) + (pixel_i + pixel_j * tileSize) * tileDimensionCount;
 
     // xor index based on optimized ranking
-    int rankedSampleIndex = sampleIndex ^ g_RankingTile[sampleDimension + (pixel_i + pixel_j * 128) * 8];
+    int rankedSampleIndex = sampleIndex ^ g_RankingTile[tileIndex];
 
     // fetch value in sequence
-    int value = g_SobolBuffer[sampleDimension + rankedSampleIndex * 256];
+    int value = g_SobolBuffer[sampleDimension + rankedSampleIndex * dimensionCount];
 
     // If the dimension is optimized, xor sequence value based on optimized scrambling
-    value = value ^ g_ScramblingTile[(sampleDimension % 8) + (pixel_i + pixel_j * 128) * 8];
+    value = value ^ g_ScramblingTile[tileIndex];
 
     // convert to float and return
-    return (0.5f + value) / 256.0f;
+    return (0.5f + value) / sampleCount;
 }
 
 float BlueNoise_Sample1D(in uint2 pixel, in uint sample_index, in uint dimension_offset)
@@ -60,7 +67,7 @@ float BlueNoise_Sample1D(in uint2 pixel, in uint sample_index, in uint dimension
     // https://blog.demofox.org/2017/10/31/animating-noise-for-integration-over-time/
     float s = samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel.x, pixel.y, 0, dimension_offset);
 
-    return fmod(s + (sample_index & 255) * GOLDEN_RATIO, 1.0f);
+    return fmod(s + (sample_index & (g_BlueNoiseSize.y - 1)) * GOLDEN_RATIO, 1.0f);
 }
 
 float BlueNoise_Sample1D(in uint2 pixel, in uint sample_index)
@@ -74,7 +81,7 @@ float2 BlueNoise_Sample2D(in uint2 pixel, in uint sample_index, in uint dimensio
     float2 s = float2(samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel.x, pixel.y, 0, dimension_offset + 0),
                       samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel.x, pixel.y, 0, dimension_offset + 1));
 
-    return fmod(s + (sample_index & 255) * GOLDEN_RATIO, 1.0f);
+    return fmod(s + (sample_index & (g_BlueNoiseSize.y - 1)) * GOLDEN_RATIO, 1.0f);
 }
 
 float2 BlueNoise_Sample2D(in uint2 pixel, in uint sample_index)
@@ -89,7 +96,7 @@ float3 BlueNoise_Sample3D(in uint2 pixel, in uint sample_index, in uint dimensio
                       samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel.x, pixel.y, 0, dimension_offset + 1),
                       samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel.x, pixel.y, 0, dimension_offset + 2));
 
-    return fmod(s + (sample_index & 255) * GOLDEN_RATIO, 1.0f);
+    return fmod(s + (sample_index & (g_BlueNoiseSize.y - 1)) * GOLDEN_RATIO, 1.0f);
 }
 
 float3 BlueNoise_Sample3D(in uint2 pixel, in uint sample_index)
@@ -23,6 +23,7 @@ THE SOFTWARE.
 #include "brdf_lut.h"
 
 #include "capsaicin_internal.h"
+#include "gpu_lut_cache.h"
 
 namespace Capsaicin
 {
@@ -37,10 +38,23 @@ BrdfLut::~BrdfLut() noexcept
 
 bool BrdfLut::init(CapsaicinInternal const &capsaicin) noexcept
 {
-    brdf_lut_buffer_ = gfxCreateTexture2D(gfx_, brdf_lut_size_, brdf_lut_size_, DXGI_FORMAT_R16G16_FLOAT);
+    brdf_lut_buffer_ = CreateTexture2D(gfx_, brdf_lut_size_, brdf_lut_size_, DXGI_FORMAT_R16G16_FLOAT);
     brdf_lut_buffer_.setName("Capsaicin_BrdfLut_LutBuffer");
 
-    GfxProgram const brdf_lut_program = capsaicin.createProgram("components/brdf_lut/brdf_lut");
+    // Reuse a previously computed LUT if nothing it depends on has changed
+    LutCache::Key key;
+    key.add(Name)
+        .add(brdf_lut_size_)
+        .add(brdf_lut_sample_size_)
+        .add(capsaicin.getProgramHash("components/brdf_lut/brdf_lut"));
+    GPULutCache &lutCache      = capsaicin.getGPULutCache();
+    bool const   lutCacheValid = lutCache.isValid();
+    if (lutCacheValid && lutCache.load(capsaicin.getLutCache(), key, brdf_lut_buffer_))
+    {
+        return true;
+    }
+
+    GfxProgram const brdf_lut_program = capsaicin.createProgram("components/brdf_lut/brdf_lut", getName());
     GfxKernel const  brdf_lut_kernel  = gfxCreateComputeKernel(gfx_, brdf_lut_program, "ComputeBrdfLut");
 
     gfxProgramSetParameter(gfx_, brdf_lut_program, "g_LutBuffer", brdf_lut_buffer_);
@@ -57,6 +71,10 @@ bool BrdfLut::init(CapsaicinInternal const &capsaicin) noexcept
     gfxDestroyKernel(gfx_, brdf_lut_kernel);
     gfxDestroyProgram(gfx_, brdf_lut_program);
 
+    if (lutCacheValid)
+    {
+        lutCache.save(capsaicin, key, brdf_lut_buffer_);
+    }
     return true;
 }
 
@@ -67,7 +85,7 @@ void BrdfLut::run([[maybe_unused]] CapsaicinInternal &capsaicin) noexcept
 
 void BrdfLut::terminate() noexcept
 {
-    gfxDestroyTexture(gfx_, brdf_lut_buffer_);
+    DestroyTexture(gfx_, brdf_lut_buffer_);
 }
 
 void BrdfLut::addProgramParameters(
@@ -23,6 +23,7 @@ THE SOFTWARE.
 #include "light_builder.h"
 
 #include "capsaicin_internal.h"
+#include "cpu_profiler.h"
 #include "hash_reduce.h"
 #include "light_builder_shared.h"
 #include "render_technique.h"
@@ -80,10 +81,11 @@ SharedBufferList LightBuilder::getSharedBuffers() const noexcept
 
 bool LightBuilder::init(CapsaicinInternal const &capsaicin) noexcept
 {
-    gatherAreaLightsProgram = capsaicin.createProgram("components/light_builder/gather_area_lights");
+    gatherAreaLightsProgram =
+        capsaicin.createProgram("components/light_builder/gather_area_lights", getName());
     gatherAreaLightsKernel  = gfxCreateComputeKernel(gfx_, gatherAreaLightsProgram, "main");
 
-    lightCountBuffer = gfxCreateBuffer<uint32_t>(gfx_, 1);
+    lightCountBuffer = CreateBuffer<uint32_t>(gfx_, 1);
     lightCountBuffer.setName("LightCountBuffer");
 
     options = convertOptions(capsaicin.getOptions());
@@ -163,6 +165,7 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
         // Update lights
         {
             TimedSection const timedSection(*this, "UpdateLights");
+            CAPSAICIN_PROFILE_SCOPE("UpdateLights");
 
             // We create a single light list for all known lights in the current scene. We use `Light` to
             // represent any type of supported light (area, point, directional etc.) by re-interpreting
@@ -256,8 +259,8 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
                 if (!lightInstancePrimitiveOffset.empty())
                 {
                     // Create light mesh buffer
-                    gfxDestroyBuffer(gfx_, lightInstanceBuffer);
-                    lightInstanceBuffer = gfxCreateBuffer<uint32_t>(gfx_,
+                    DestroyBuffer(gfx_, lightInstanceBuffer);
+                    lightInstanceBuffer = CreateBuffer<uint32_t>(gfx_,
                         static_cast<uint32_t>(lightInstancePrimitiveOffset.size()),
                         lightInstancePrimitiveOffset.data());
                     lightInstanceBuffer.setName("LightInstanceBuffer");
@@ -269,8 +272,8 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
                 glm::max(lightCount, 1U); // Always allocate buffers even when no lights
             if (lightBuffer.getCount() < numLights)
             {
-                gfxDestroyBuffer(gfx_, lightBuffer);
-                lightBuffer = gfxCreateBuffer<Light>(gfx_, numLights);
+                DestroyBuffer(gfx_, lightBuffer);
+                lightBuffer = CreateBuffer<Light>(gfx_, numLights);
                 lightBuffer.setName("AllLightBuffer");
                 if (hasPreviousLightBuffer)
                 {
@@ -287,11 +290,11 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
             if (!allLightData.empty())
             {
                 // Copy delta lights to start of buffer (after any environment maps)
-                GfxBuffer const upload_buffer = gfxCreateBuffer<Light>(gfx_,
+                GfxBuffer const upload_buffer = CreateBuffer<Light>(gfx_,
                     static_cast<uint32_t>(allLightData.size()), allLightData.data(), kGfxCpuAccess_Write);
                 gfxCommandCopyBuffer(
                     gfx_, lightBuffer, 0, upload_buffer, 0, allLightData.size() * sizeof(Light));
-                gfxDestroyBuffer(gfx_, upload_buffer);
+                DestroyBuffer(gfx_, upload_buffer);
             }
             gfxCommandClearBuffer(gfx_, lightCountBuffer, lightCount);
         }
@@ -328,7 +331,7 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
                 }
             }
             auto            drawCount      = static_cast<uint32_t>(drawData.size());
-            GfxBuffer const drawDataBuffer = gfxCreateBuffer<DrawData>(gfx_, drawCount, drawData.data());
+            GfxBuffer const drawDataBuffer = CreateBuffer<DrawData>(gfx_, drawCount, drawData.data());
 
             // The shader is actually a compute kernel, but it functions identically to a mesh shader. We run
             // a mesh shader group for each entry in the draw call list. Each shader group is then responsible
@@ -361,7 +364,7 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
             gfxCommandBindKernel(gfx_, gatherAreaLightsKernel);
             gfxCommandDispatch(gfx_, drawCount, 1, 1);
 
-            gfxDestroyBuffer(gfx_, drawDataBuffer);
+            DestroyBuffer(gfx_, drawDataBuffer);
         }
 
         if (hasPreviousLightBuffer && lightIndexesChanged)
@@ -387,11 +390,11 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
 
 void LightBuilder::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx_, lightBuffer);
+    DestroyBuffer(gfx_, lightBuffer);
     lightBuffer = {};
-    gfxDestroyBuffer(gfx_, lightCountBuffer);
+    DestroyBuffer(gfx_, lightCountBuffer);
     lightCountBuffer = {};
-    gfxDestroyBuffer(gfx_, lightInstanceBuffer);
+    DestroyBuffer(gfx_, lightInstanceBuffer);
     lightInstanceBuffer = {};
 
     gfxDestroyKernel(gfx_, gatherAreaLightsKernel);
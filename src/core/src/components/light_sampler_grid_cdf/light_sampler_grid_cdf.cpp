@@ -70,7 +70,7 @@ bool LightSamplerGridCDF::init(CapsaicinInternal const &capsaicin) noexcept
 {
     initKernels(capsaicin);
 
-    configBuffer = gfxCreateBuffer<LightSamplingConfiguration>(gfx_, 1);
+    configBuffer = CreateBuffer<LightSamplingConfiguration>(gfx_, 1);
     configBuffer.setName("Capsaicin_LightSamplerGridCDF_ConfigBuffer");
 
     config = {uint4 {0}, float3 {0}, float3 {0}, float3 {0}};
@@ -137,9 +137,9 @@ void LightSamplerGridCDF::run(CapsaicinInternal &capsaicin) noexcept
         config.sceneExtent = sceneExtent;
 
         GfxBuffer const uploadBuffer =
-            gfxCreateBuffer<LightSamplingConfiguration>(gfx_, 1, &config, kGfxCpuAccess_Write);
+            CreateBuffer<LightSamplingConfiguration>(gfx_, 1, &config, kGfxCpuAccess_Write);
         gfxCommandCopyBuffer(gfx_, configBuffer, uploadBuffer);
-        gfxDestroyBuffer(gfx_, uploadBuffer);
+        DestroyBuffer(gfx_, uploadBuffer);
     }
 
     uint lightDataLength = config.numCells.x * config.numCells.y * config.numCells.z * config.numCells.w;
@@ -149,12 +149,12 @@ void LightSamplerGridCDF::run(CapsaicinInternal &capsaicin) noexcept
     }
     if (lightIndexBuffer.getCount() < lightDataLength)
     {
-        gfxDestroyBuffer(gfx_, lightIndexBuffer);
-        gfxDestroyBuffer(gfx_, lightCDFBuffer);
+        DestroyBuffer(gfx_, lightIndexBuffer);
+        DestroyBuffer(gfx_, lightCDFBuffer);
 
-        lightIndexBuffer = gfxCreateBuffer<uint>(gfx_, lightDataLength);
+        lightIndexBuffer = CreateBuffer<uint>(gfx_, lightDataLength);
         lightIndexBuffer.setName("Capsaicin_LightSamplerGridCDF_IndexBuffer");
-        lightCDFBuffer = gfxCreateBuffer<uint>(gfx_, lightDataLength);
+        lightCDFBuffer = CreateBuffer<uint>(gfx_, lightDataLength);
         lightCDFBuffer.setName("Capsaicin_LightSamplerGridCDF_CDFBuffer");
 
         lightSettingsUpdatedFlag = true;
@@ -195,11 +195,11 @@ void LightSamplerGridCDF::run(CapsaicinInternal &capsaicin) noexcept
 
 void LightSamplerGridCDF::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx_, configBuffer);
+    DestroyBuffer(gfx_, configBuffer);
     configBuffer = {};
-    gfxDestroyBuffer(gfx_, lightIndexBuffer);
+    DestroyBuffer(gfx_, lightIndexBuffer);
     lightIndexBuffer = {};
-    gfxDestroyBuffer(gfx_, lightCDFBuffer);
+    DestroyBuffer(gfx_, lightCDFBuffer);
     lightCDFBuffer = {};
 
     gfxDestroyKernel(gfx_, buildKernel);
@@ -298,7 +298,8 @@ std::string_view LightSamplerGridCDF::getHeaderFile() const noexcept
 
 bool LightSamplerGridCDF::initKernels(CapsaicinInternal const &capsaicin) noexcept
 {
-    boundsProgram = capsaicin.createProgram("components/light_sampler_grid_cdf/light_sampler_grid_cdf");
+    boundsProgram =
+        capsaicin.createProgram("components/light_sampler_grid_cdf/light_sampler_grid_cdf", getName());
     auto const                baseDefines(getShaderDefines(capsaicin));
     std::vector<char const *> defines;
     defines.reserve(baseDefines.size());
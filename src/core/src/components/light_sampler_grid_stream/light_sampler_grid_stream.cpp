@@ -77,7 +77,7 @@ bool LightSamplerGridStream::init(CapsaicinInternal const &capsaicin) noexcept
 {
     initKernels(capsaicin);
 
-    boundsLengthBuffer = gfxCreateBuffer<uint>(gfx_, 1);
+    boundsLengthBuffer = CreateBuffer<uint>(gfx_, 1);
     boundsLengthBuffer.setName("Capsaicin_LightSamplerGridStream_BoundsCountBuffer");
 
     initBoundsBuffers();
@@ -95,12 +95,12 @@ bool LightSamplerGridStream::init(CapsaicinInternal const &capsaicin) noexcept
         float3 sceneExtent;
     };
 
-    configBuffer = gfxCreateBuffer<LightSamplingConfiguration>(gfx_, 1);
+    configBuffer = CreateBuffer<LightSamplingConfiguration>(gfx_, 1);
     configBuffer.setName("Capsaicin_LightSamplerGrid_ConfigBuffer");
 
     initLightIndexBuffer();
 
-    dispatchCommandBuffer = gfxCreateBuffer<DispatchCommand>(gfx_, 1);
+    dispatchCommandBuffer = CreateBuffer<DispatchCommand>(gfx_, 1);
     dispatchCommandBuffer.setName("Capsaicin_LightSamplerGrid_DispatchCommandBuffer");
 
     return !!boundsProgram;
@@ -130,21 +130,21 @@ void LightSamplerGridStream::run(CapsaicinInternal &capsaicin) noexcept
 
 void LightSamplerGridStream::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx_, boundsLengthBuffer);
+    DestroyBuffer(gfx_, boundsLengthBuffer);
     boundsLengthBuffer = {};
-    gfxDestroyBuffer(gfx_, boundsMinBuffer);
+    DestroyBuffer(gfx_, boundsMinBuffer);
     boundsMinBuffer = {};
-    gfxDestroyBuffer(gfx_, boundsMaxBuffer);
+    DestroyBuffer(gfx_, boundsMaxBuffer);
     boundsMaxBuffer = {};
 
-    gfxDestroyBuffer(gfx_, configBuffer);
+    DestroyBuffer(gfx_, configBuffer);
     configBuffer = {};
-    gfxDestroyBuffer(gfx_, lightIndexBuffer);
+    DestroyBuffer(gfx_, lightIndexBuffer);
     lightIndexBuffer = {};
-    gfxDestroyBuffer(gfx_, lightReservoirBuffer);
+    DestroyBuffer(gfx_, lightReservoirBuffer);
     lightReservoirBuffer = {};
 
-    gfxDestroyBuffer(gfx_, dispatchCommandBuffer);
+    DestroyBuffer(gfx_, dispatchCommandBuffer);
     dispatchCommandBuffer = {};
 
     gfxDestroyKernel(gfx_, calculateBoundsKernel);
@@ -203,8 +203,8 @@ void LightSamplerGridStream::reserveBoundsValues(uint32_t reserve, std::type_inf
 
     if (boundsMinBuffer.getCount() < boundsMaxLength && boundsMaxLength > 0)
     {
-        gfxDestroyBuffer(gfx_, boundsMinBuffer);
-        gfxDestroyBuffer(gfx_, boundsMaxBuffer);
+        DestroyBuffer(gfx_, boundsMinBuffer);
+        DestroyBuffer(gfx_, boundsMaxBuffer);
         initBoundsBuffers();
     }
 }
@@ -259,8 +259,8 @@ void LightSamplerGridStream::update(CapsaicinInternal &capsaicin, Timeable *pare
     }
     if (lightIndexBuffer.getCount() < lightDataLength)
     {
-        gfxDestroyBuffer(gfx_, lightIndexBuffer);
-        gfxDestroyBuffer(gfx_, lightReservoirBuffer);
+        DestroyBuffer(gfx_, lightIndexBuffer);
+        DestroyBuffer(gfx_, lightReservoirBuffer);
         initLightIndexBuffer();
     }
 
@@ -298,28 +298,28 @@ void LightSamplerGridStream::update(CapsaicinInternal &capsaicin, Timeable *pare
             {
                 // Copy to last element boundsMinBuffer and boundsMaxBuffer
                 GfxBuffer const uploadMinBuffer =
-                    gfxCreateBuffer<float>(gfx_, 3, &newBounds.first, kGfxCpuAccess_Write);
+                    CreateBuffer<float>(gfx_, 3, &newBounds.first, kGfxCpuAccess_Write);
                 gfxCommandCopyBuffer(gfx_, boundsMinBuffer,
                     (static_cast<size_t>(boundsMaxLength) - 1) * sizeof(float) * 3, uploadMinBuffer, 0,
                     sizeof(float) * 3);
                 GfxBuffer const uploadMaxBuffer =
-                    gfxCreateBuffer<float>(gfx_, 3, &newBounds.second, kGfxCpuAccess_Write);
+                    CreateBuffer<float>(gfx_, 3, &newBounds.second, kGfxCpuAccess_Write);
                 gfxCommandCopyBuffer(gfx_, boundsMaxBuffer,
                     (static_cast<size_t>(boundsMaxLength) - 1) * sizeof(float) * 3, uploadMaxBuffer, 0,
                     sizeof(float) * 3);
-                gfxDestroyBuffer(gfx_, uploadMinBuffer);
-                gfxDestroyBuffer(gfx_, uploadMaxBuffer);
+                DestroyBuffer(gfx_, uploadMinBuffer);
+                DestroyBuffer(gfx_, uploadMaxBuffer);
             }
             else
             {
                 GfxBuffer const uploadMinBuffer =
-                    gfxCreateBuffer<float>(gfx_, 3, &newBounds.first, kGfxCpuAccess_Write);
+                    CreateBuffer<float>(gfx_, 3, &newBounds.first, kGfxCpuAccess_Write);
                 gfxCommandCopyBuffer(gfx_, boundsMinBuffer, 0, uploadMinBuffer, 0, sizeof(float) * 3);
                 GfxBuffer const uploadMaxBuffer =
-                    gfxCreateBuffer<float>(gfx_, 3, &newBounds.second, kGfxCpuAccess_Write);
+                    CreateBuffer<float>(gfx_, 3, &newBounds.second, kGfxCpuAccess_Write);
                 gfxCommandCopyBuffer(gfx_, boundsMaxBuffer, 0, uploadMaxBuffer, 0, sizeof(float) * 3);
-                gfxDestroyBuffer(gfx_, uploadMinBuffer);
-                gfxDestroyBuffer(gfx_, uploadMaxBuffer);
+                DestroyBuffer(gfx_, uploadMinBuffer);
+                DestroyBuffer(gfx_, uploadMaxBuffer);
             }
         }
     }
@@ -362,7 +362,7 @@ void LightSamplerGridStream::update(CapsaicinInternal &capsaicin, Timeable *pare
         gfxCommandDispatch(gfx_, 1, 1, 1);
 
         // Release constant buffer
-        gfxDestroyBuffer(gfx_, samplingConstants);
+        DestroyBuffer(gfx_, samplingConstants);
     }
 
     // Create the light sampling structure
@@ -456,9 +456,11 @@ std::string_view LightSamplerGridStream::getHeaderFile() const noexcept
 bool LightSamplerGridStream::initKernels(CapsaicinInternal const &capsaicin) noexcept
 {
     boundsProgram =
-        capsaicin.createProgram("components/light_sampler_grid_stream/light_sampler_grid_stream_bounds");
+        capsaicin.createProgram("components/light_sampler_grid_stream/light_sampler_grid_stream_bounds",
+            getName());
     buildProgram =
-        capsaicin.createProgram("components/light_sampler_grid_stream/light_sampler_grid_stream_build");
+        capsaicin.createProgram("components/light_sampler_grid_stream/light_sampler_grid_stream_build",
+            getName());
     auto const                baseDefines(getShaderDefines(capsaicin));
     std::vector<char const *> defines;
     defines.reserve(baseDefines.size());
@@ -475,9 +477,9 @@ bool LightSamplerGridStream::initKernels(CapsaicinInternal const &capsaicin) noe
 
 bool LightSamplerGridStream::initBoundsBuffers() noexcept
 {
-    boundsMinBuffer = gfxCreateBuffer<glm::vec3>(gfx_, boundsMaxLength);
+    boundsMinBuffer = CreateBuffer<glm::vec3>(gfx_, boundsMaxLength);
     boundsMinBuffer.setName("Capsaicin_LightSamplerGrid_BoundsMinBuffer");
-    boundsMaxBuffer = gfxCreateBuffer<glm::vec3>(gfx_, boundsMaxLength);
+    boundsMaxBuffer = CreateBuffer<glm::vec3>(gfx_, boundsMaxLength);
     boundsMaxBuffer.setName("Capsaicin_LightSamplerGrid_BoundsMaxBuffer");
     gfxCommandClearBuffer(gfx_, boundsLengthBuffer, 0);
     return !!boundsMaxBuffer;
@@ -493,9 +495,9 @@ bool LightSamplerGridStream::initLightIndexBuffer() noexcept
         lightDataLength *= 8;
     }
 
-    lightIndexBuffer = gfxCreateBuffer<uint>(gfx_, lightDataLength);
+    lightIndexBuffer = CreateBuffer<uint>(gfx_, lightDataLength);
     lightIndexBuffer.setName("Capsaicin_LightSamplerGrid_IndexBuffer");
-    lightReservoirBuffer = gfxCreateBuffer<float2>(gfx_, lightDataLength);
+    lightReservoirBuffer = CreateBuffer<float2>(gfx_, lightDataLength);
     lightReservoirBuffer.setName("Capsaicin_LightSamplerGrid_ReservoirBuffer");
     return !!lightReservoirBuffer;
 }
@@ -23,6 +23,7 @@ THE SOFTWARE.
 #include "prefilter_ibl.h"
 
 #include "capsaicin_internal.h"
+#include "gpu_lut_cache.h"
 
 #include <algorithm>
 #include <numbers>
@@ -40,11 +41,17 @@ PrefilterIBL::~PrefilterIBL() noexcept
 
 bool PrefilterIBL::init(CapsaicinInternal const &capsaicin) noexcept
 {
-    prefilter_ibl_buffer_ = gfxCreateTextureCube(
+    prefilter_ibl_buffer_ = CreateTextureCube(
         gfx_, prefilter_ibl_buffer_size_, DXGI_FORMAT_R16G16B16A16_FLOAT, prefilter_ibl_buffer_mips_);
     prefilter_ibl_buffer_.setName("Capsaicin_PrefilterIBL_PrefilterIBLBuffer");
 
-    prefilter_ibl_program_ = capsaicin.createProgram("components/prefilter_ibl/prefilter_ibl");
+    prefilter_ibl_program_ = capsaicin.createProgram("components/prefilter_ibl/prefilter_ibl", getName());
+
+    // All faces and mips only differ by their render target so a single kernel is shared between them
+    GfxDrawState const draw_sky_state = {};
+    gfxDrawStateSetColorTarget(draw_sky_state, 0, prefilter_ibl_buffer_.getFormat());
+    prefilter_ibl_kernel_ =
+        gfxCreateGraphicsKernel(gfx_, prefilter_ibl_program_, draw_sky_state, "PrefilterIBL");
 
     // init prefiltered IBL
     prefilterIBL(capsaicin);
@@ -63,8 +70,11 @@ void PrefilterIBL::run(CapsaicinInternal &capsaicin) noexcept
 
 void PrefilterIBL::terminate() noexcept
 {
+    gfxDestroyKernel(gfx_, prefilter_ibl_kernel_);
+    prefilter_ibl_kernel_ = {};
     gfxDestroyProgram(gfx_, prefilter_ibl_program_);
-    gfxDestroyTexture(gfx_, prefilter_ibl_buffer_);
+    prefilter_ibl_program_ = {};
+    DestroyTexture(gfx_, prefilter_ibl_buffer_);
 }
 
 void PrefilterIBL::addProgramParameters(
@@ -73,8 +83,25 @@ void PrefilterIBL::addProgramParameters(
     gfxProgramSetParameter(gfx_, program, "g_PrefilteredEnvironmentBuffer", prefilter_ibl_buffer_);
 }
 
-void PrefilterIBL::prefilterIBL(CapsaicinInternal const &capsaicin) const noexcept
+void PrefilterIBL::prefilterIBL(CapsaicinInternal const &capsaicin) noexcept
 {
+    // Reuse a previously prefiltered environment map if available, the environment map hash is zero whenever
+    // its contents are unknown in which case the result cannot be cached
+    uint64_t const environmentHash = capsaicin.getEnvironmentMapHash();
+    LutCache::Key  key;
+    key.add(Name)
+        .add(environmentHash)
+        .add(prefilter_ibl_buffer_size_)
+        .add(prefilter_ibl_buffer_mips_)
+        .add(prefilter_ibl_sample_size_)
+        .add(capsaicin.getProgramHash("components/prefilter_ibl/prefilter_ibl"));
+    GPULutCache &lutCache = capsaicin.getGPULutCache();
+    if (environmentHash != 0 && lutCache.isValid()
+        && lutCache.load(capsaicin.getLutCache(), key, prefilter_ibl_buffer_))
+    {
+        return;
+    }
+
     constexpr std::array forward_vectors = {glm::dvec3(-1.0, 0.0, 0.0), glm::dvec3(1.0, 0.0, 0.0),
         glm::dvec3(0.0, 1.0, 0.0), glm::dvec3(0.0, -1.0, 0.0), glm::dvec3(0.0, 0.0, -1.0),
         glm::dvec3(0.0, 0.0, 1.0)};
@@ -87,12 +114,6 @@ void PrefilterIBL::prefilterIBL(CapsaicinInternal const &capsaicin) const noexce
     {
         for (uint32_t cubemap_face = 0; cubemap_face < 6; ++cubemap_face)
         {
-            GfxDrawState const draw_sky_state = {};
-            gfxDrawStateSetColorTarget(draw_sky_state, 0, prefilter_ibl_buffer_.getFormat());
-
-            GfxKernel const prefilter_ibl_kernel =
-                gfxCreateGraphicsKernel(gfx_, prefilter_ibl_program_, draw_sky_state, "PrefilterIBL");
-
             uint2 const buffer_dimensions = {std::max(prefilter_ibl_buffer_size_ >> mip_level, 1U),
                 std::max(prefilter_ibl_buffer_size_ >> mip_level, 1U)};
 
@@ -114,12 +135,15 @@ void PrefilterIBL::prefilterIBL(CapsaicinInternal const &capsaicin) const noexce
             gfxProgramSetParameter(gfx_, prefilter_ibl_program_, "g_SampleSize", prefilter_ibl_sample_size_);
 
             gfxCommandBindColorTarget(gfx_, 0, prefilter_ibl_buffer_, mip_level, cubemap_face);
-            gfxCommandBindKernel(gfx_, prefilter_ibl_kernel);
+            gfxCommandBindKernel(gfx_, prefilter_ibl_kernel_);
             gfxCommandDraw(gfx_, 3);
-
-            gfxDestroyKernel(gfx_, prefilter_ibl_kernel);
         }
     }
+
+    if (environmentHash != 0 && lutCache.isValid())
+    {
+        lutCache.save(capsaicin, key, prefilter_ibl_buffer_);
+    }
 }
 
 } // namespace Capsaicin
@@ -71,9 +71,10 @@ class PrefilterIBL final
     void addProgramParameters(CapsaicinInternal const &capsaicin, GfxProgram const &program) const noexcept;
 
 private:
-    void prefilterIBL(CapsaicinInternal const &capsaicin) const noexcept;
+    void prefilterIBL(CapsaicinInternal const &capsaicin) noexcept;
 
     GfxProgram prefilter_ibl_program_;
+    GfxKernel  prefilter_ibl_kernel_;
     GfxTexture prefilter_ibl_buffer_;
 
     uint32_t prefilter_ibl_buffer_size_ = 1024;
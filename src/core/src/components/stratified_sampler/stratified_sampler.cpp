@@ -77,12 +77,12 @@ bool StratifiedSampler::init(CapsaicinInternal const &capsaicin) noexcept
         }
     }
     seedBuffer =
-        gfxCreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(seedBufferData.size()), seedBufferData.data());
+        CreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(seedBufferData.size()), seedBufferData.data());
     seedBuffer.setName("StratifiedSampler_SeedBuffer");
 
     if (!sobolBuffer)
     {
-        sobolBuffer = gfxCreateBuffer<uint32_t>(gfx_, sizeof(sobolData), sobolData);
+        sobolBuffer = CreateBuffer<uint32_t>(gfx_, sizeof(sobolData), sobolData);
         sobolBuffer.setName("StratifiedSampler_SobolBuffer");
     }
     return true;
@@ -103,7 +103,7 @@ void StratifiedSampler::run(CapsaicinInternal &capsaicin) noexcept
     {
         GfxCommandEvent const command_event(gfx_, "InitStratifiedSampler");
 
-        gfxDestroyBuffer(gfx_, seedBuffer);
+        DestroyBuffer(gfx_, seedBuffer);
 
         init(capsaicin);
     }
@@ -111,9 +111,9 @@ void StratifiedSampler::run(CapsaicinInternal &capsaicin) noexcept
 
 void StratifiedSampler::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx_, seedBuffer);
+    DestroyBuffer(gfx_, seedBuffer);
     seedBuffer = {};
-    gfxDestroyBuffer(gfx_, sobolBuffer);
+    DestroyBuffer(gfx_, sobolBuffer);
     sobolBuffer = {};
 }
 
@@ -52,7 +52,7 @@ Atmosphere::RenderOptions Atmosphere::convertOptions(RenderOptionList const &opt
 
 bool Atmosphere::init(CapsaicinInternal const &capsaicin) noexcept
 {
-    atmosphere_program_       = capsaicin.createProgram("render_techniques/atmosphere/atmosphere");
+    atmosphere_program_       = capsaicin.createProgram("render_techniques/atmosphere/atmosphere", getName());
     draw_atmosphere_kernel_   = gfxCreateComputeKernel(gfx_, atmosphere_program_, "DrawAtmosphere");
     filter_atmosphere_kernel_ = gfxCreateComputeKernel(gfx_, atmosphere_program_, "FilterAtmosphere");
     return !!atmosphere_program_;
@@ -75,9 +75,9 @@ bool AutoExposure::init(CapsaicinInternal const &capsaicin) noexcept
     // Update exposure buffer with initial exposure value
     auto const     &exposureBuffer   = capsaicin.getSharedBuffer("Exposure");
     float const     combinedExposure = options.auto_exposure_value * options.auto_exposure_bias;
-    GfxBuffer const uploadBuffer = gfxCreateBuffer<float>(gfx_, 1, &combinedExposure, kGfxCpuAccess_Write);
+    GfxBuffer const uploadBuffer = CreateBuffer<float>(gfx_, 1, &combinedExposure, kGfxCpuAccess_Write);
     gfxCommandCopyBuffer(gfx_, exposureBuffer, uploadBuffer);
-    gfxDestroyBuffer(gfx_, uploadBuffer);
+    DestroyBuffer(gfx_, uploadBuffer);
 
     if (options.auto_exposure_enable)
     {
@@ -194,22 +194,21 @@ void AutoExposure::render(CapsaicinInternal &capsaicin) noexcept
         TimedSection const timed_section(*this, "ExposureUpload");
         float              combinedExposure = options.auto_exposure_value;
         combinedExposure                    = glm::max(combinedExposure, 0.0001F);
-        GfxBuffer const uploadBuffer =
-            gfxCreateBuffer<float>(gfx_, 1, &combinedExposure, kGfxCpuAccess_Write);
+        GfxBuffer const uploadBuffer = CreateBuffer<float>(gfx_, 1, &combinedExposure, kGfxCpuAccess_Write);
         gfxCommandCopyBuffer(gfx_, capsaicin.getSharedBuffer("Exposure"), uploadBuffer);
-        gfxDestroyBuffer(gfx_, uploadBuffer);
+        DestroyBuffer(gfx_, uploadBuffer);
     }
 }
 
 void AutoExposure::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx_, histogramBuffer);
+    DestroyBuffer(gfx_, histogramBuffer);
     histogramBuffer = {};
-    gfxDestroyBuffer(gfx_, keySceneLuminanceBuffer);
+    DestroyBuffer(gfx_, keySceneLuminanceBuffer);
     keySceneLuminanceBuffer = {};
     for (auto const &i : exposureBufferTemp)
     {
-        gfxDestroyBuffer(gfx_, i.second.first);
+        DestroyBuffer(gfx_, i.second.first);
     }
     exposureBufferTemp.clear();
 
@@ -257,13 +256,13 @@ void AutoExposure::renderGUI(CapsaicinInternal &capsaicin) const noexcept
 bool AutoExposure::initAutoExposure(CapsaicinInternal const &capsaicin) noexcept
 {
     // Create buffer used to store scene luminance histogram
-    histogramBuffer = gfxCreateBuffer<float>(gfx_, 128 /*required @ 1080p*/);
+    histogramBuffer = CreateBuffer<float>(gfx_, 128 /*required @ 1080p*/);
     histogramBuffer.setName("AutoExposure_Histogram");
     gfxCommandClearBuffer(gfx_, histogramBuffer, glm::floatBitsToUint(0.0F));
 
     // Create buffer used to hold key scene luminance
     constexpr float clearValue = 0.0F;
-    keySceneLuminanceBuffer    = gfxCreateBuffer<float>(gfx_, 1, &clearValue);
+    keySceneLuminanceBuffer    = CreateBuffer<float>(gfx_, 1, &clearValue);
     keySceneLuminanceBuffer.setName("AutoExposure_KeySceneLuminance");
 
     // Create buffer list used to read-back calculated exposure values
@@ -271,7 +270,7 @@ bool AutoExposure::initAutoExposure(CapsaicinInternal const &capsaicin) noexcept
     exposureBufferTemp.reserve(backBufferCount);
     for (uint32_t i = 0; i < backBufferCount; ++i)
     {
-        GfxBuffer   buffer = gfxCreateBuffer<float>(gfx_, 1, nullptr, kGfxCpuAccess_Read);
+        GfxBuffer   buffer = CreateBuffer<float>(gfx_, 1, nullptr, kGfxCpuAccess_Read);
         std::string name   = "AutoExposure_ExposureReadBack";
         name += std::to_string(i);
         buffer.setName(name.c_str());
@@ -279,7 +278,7 @@ bool AutoExposure::initAutoExposure(CapsaicinInternal const &capsaicin) noexcept
     }
 
     // Create kernels
-    exposureProgram = capsaicin.createProgram("render_techniques/auto_exposure/auto_exposure");
+    exposureProgram = capsaicin.createProgram("render_techniques/auto_exposure/auto_exposure", getName());
     histogramKernel = gfxCreateComputeKernel(gfx_, exposureProgram, "CalculateHistogram");
     exposureKernel  = gfxCreateComputeKernel(gfx_, exposureProgram, "CalculateExposure");
 
@@ -93,8 +93,8 @@ bool Bloom::init(CapsaicinInternal const &capsaicin) noexcept
         calculateBlurParameters(bufferDimensions);
 
         // Create kernels
-        blurProgram    = capsaicin.createProgram("render_techniques/bloom/blur");
-        combineProgram = capsaicin.createProgram("render_techniques/bloom/combine");
+        blurProgram    = capsaicin.createProgram("render_techniques/bloom/blur", getName());
+        combineProgram = capsaicin.createProgram("render_techniques/bloom/combine", getName());
         combineKernel  = gfxCreateComputeKernel(gfx_, combineProgram, "main");
 
         return initBlurKernel() && !!combineKernel && !!bloomTexture;
@@ -244,7 +244,7 @@ void Bloom::terminate() noexcept
     combineKernel = {};
     gfxDestroyProgram(gfx_, combineProgram);
     combineProgram = {};
-    gfxDestroyTexture(gfx_, bloomTexture);
+    DestroyTexture(gfx_, bloomTexture);
     bloomTexture = {};
 }
 
@@ -23,83 +23,6 @@ THE SOFTWARE.
 
 #include "capsaicin_internal.h"
 
-#include <fstream>
-
-namespace
-{
-
-class Tokenizer
-{
-public:
-    explicit Tokenizer(std::string const &fileName)
-    {
-        memset(token_.data(), 0, token_.size());
-        std::filesystem::path const filePath = fileName;
-        data_.resize(std::filesystem::file_size(filePath));
-        std::ifstream readFile(filePath);
-        if (readFile.read(data_.data(), static_cast<std::streamsize>(data_.size())); readFile)
-        {
-            advanceToNextToken();
-        }
-        else
-        {
-            GFX_ASSERTMSG(0, "Failed to read color grading file");
-            data_.clear();
-        }
-    }
-
-    [[nodiscard]] char const *getToken() const { return token_.data(); }
-
-    bool advanceToNextToken()
-    {
-        char c         = 0;
-        bool has_token = false;
-        memset(token_.data(), 0, token_.size());
-        auto token_cursor = data_cursor_;
-
-        while (readNextCharacter(c))
-        {
-            switch (c)
-            {
-            case ' ':
-            case '\r':
-            case '\n':
-                if (!has_token)
-                {
-                    token_cursor = data_cursor_;
-                }
-                else
-                {
-                    size_t const token_size = std::min(data_cursor_ - token_cursor - 1, token_.size() - 1);
-                    memcpy(token_.data(), &data_[token_cursor], token_size);
-                    return true;
-                }
-                break;
-            default: has_token = true; break;
-            }
-        }
-
-        return false;
-    }
-
-private:
-    bool readNextCharacter(char &c)
-    {
-        if (data_cursor_ >= data_.size())
-        {
-            return false; // EOF
-        }
-        c = data_[data_cursor_++];
-        return true;
-    }
-
-    std::vector<char>     data_;
-    std::array<char, 256> token_ {};
-    size_t                data_cursor_ = 0;
-};
-
-} // unnamed namespace
-
 namespace Capsaicin
 {
 
@@ -148,13 +71,17 @@ bool ColorGrading::init(CapsaicinInternal const &capsaicin) noexcept
                 lut_buffer_user_selected    = false;
             }
         }
-        if (!!lut_buffer_)
+        if (!!lut_buffer_ && !color_grading_program_)
         {
-            color_grading_program_ = capsaicin.createProgram("render_techniques/color_grading/color_grading");
+            color_grading_program_ =
+                capsaicin.createProgram("render_techniques/color_grading/color_grading", getName());
             apply_kernel_          = gfxCreateComputeKernel(gfx_, color_grading_program_, "Apply");
+            char const *define     = "LUT_1D";
+            apply_1d_kernel_       =
+                gfxCreateComputeKernel(gfx_, color_grading_program_, "Apply", &define, 1);
         }
 
-        return !!apply_kernel_;
+        return !!apply_kernel_ && !!apply_1d_kernel_;
     }
     lut_buffer_user_selected = false;
     return true;
@@ -284,12 +211,17 @@ void ColorGrading::render(CapsaicinInternal &capsaicin) noexcept
 
     gfxProgramSetParameter(gfx_, color_grading_program_, "g_LutBuffer", lut_buffer_);
     gfxProgramSetParameter(gfx_, color_grading_program_, "g_LutSampler", capsaicin.getLinearSampler());
+    gfxProgramSetParameter(gfx_, color_grading_program_, "g_LutDomainMin", lut_domain_min_);
+    gfxProgramSetParameter(gfx_, color_grading_program_, "g_LutDomainScale", lut_domain_scale_);
+    gfxProgramSetParameter(gfx_, color_grading_program_, "g_LutSize", lut_buffer_.getWidth());
+
+    GfxKernel const kernel = lut_type_ == CubeLut::Type::LUT3D ? apply_kernel_ : apply_1d_kernel_;
 
-    uint32_t const *num_threads  = gfxKernelGetNumThreads(gfx_, apply_kernel_);
+    uint32_t const *num_threads  = gfxKernelGetNumThreads(gfx_, kernel);
     uint32_t const  num_groups_x = (bufferDimensions.x + num_threads[0] - 1) / num_threads[0];
     uint32_t const  num_groups_y = (bufferDimensions.y + num_threads[1] - 1) / num_threads[1];
 
-    gfxCommandBindKernel(gfx_, apply_kernel_);
+    gfxCommandBindKernel(gfx_, kernel);
     gfxCommandDispatch(gfx_, num_groups_x, num_groups_y, 1);
 }
 
@@ -302,15 +234,25 @@ void ColorGrading::renderGUI(CapsaicinInternal &capsaicin) const noexcept
 
 void ColorGrading::terminate() noexcept
 {
-    gfxDestroyTexture(gfx_, lut_buffer_);
+    DestroyTexture(gfx_, lut_buffer_);
 
     lut_buffer_ = {};
 
+    lut_ = CubeLut();
+
     gfxDestroyProgram(gfx_, color_grading_program_);
     gfxDestroyKernel(gfx_, apply_kernel_);
+    gfxDestroyKernel(gfx_, apply_1d_kernel_);
+    gfxDestroyProgram(gfx_, upload_program_);
+    gfxDestroyKernel(gfx_, upload_kernel_);
+    gfxDestroyKernel(gfx_, upload_1d_kernel_);
 
     color_grading_program_ = {};
     apply_kernel_          = {};
+    apply_1d_kernel_       = {};
+    upload_program_        = {};
+    upload_kernel_         = {};
+    upload_1d_kernel_      = {};
 }
 
 bool ColorGrading::openLUTFile(std::string const &fileName, CapsaicinInternal const &capsaicin) noexcept
@@ -322,111 +264,78 @@ bool ColorGrading::openLUTFile(std::string const &fileName, CapsaicinInternal co
             kGfxResult_InvalidOperation, "Failed to open Color Grading file `%s'", fileName.c_str());
         return false;
     }
-    else
+    // Previously loaded files are read from the cache instead of being parsed again
+    if (std::string error; !lut_.load(fileName, capsaicin.getLutCache(), error))
     {
-        // Use tokenizer to split the input LUT file into each entry
-        Tokenizer tokenizer(fileName);
-
-        uint32_t            token_index = 0;
-        uint32_t            lut_size    = 0;
-        std::vector<float4> lut_data;
-        bool                failed = true;
-
-        do
-        {
-            switch (token_index)
-            {
-            case 0:
-                // The first token of a .cube file should specify the LUT type, we only support 3D LUT files
-                if (strcmp(tokenizer.getToken(), "LUT_3D_SIZE") != 0)
-                {
-                    GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
-                        "Invalid Color Grading file, only 3D LUT files accepted");
-                }
-                break;
-            case 1:
-                // The second element specifies the LUT size in each dimension. i.e. a size of x results in a
-                // table with x*x*x entries
-                lut_size = static_cast<uint32_t>(std::stoi(tokenizer.getToken()));
-                if ((lut_size == 0U) || lut_size > 100)
-                {
-                    GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
-                        "Invalid Color Grading file, invalid or un-found LUT size");
-                }
-                else
-                {
-                    lut_data.resize(static_cast<size_t>(lut_size) * lut_size * lut_size);
-                }
-                break;
-            default:
-            {
-                // All entries after the first 2 are the actually LUT data elements
-                uint32_t const lut_index = (token_index - 2);
-                // Check if number of elements exceeds expected LUT size
-                if (lut_index >= 3 * lut_data.size())
-                {
-                    GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
-                        "Invalid Color Grading file, found elements exceeds specified LUT size");
-                }
-                else
-                {
-                    // Add element to LUT data
-                    if ((lut_index % 3) == 0U)
-                    {
-                        lut_data[lut_index / 3].w = 1.0F;
-                    }
-                    lut_data[lut_index / 3][lut_index % 3] = std::stof(tokenizer.getToken());
-                }
-            }
-            break;
-            }
-            ++token_index;
-        }
-        while (tokenizer.advanceToNextToken());
+        GFX_PRINT_ERROR(kGfxResult_InvalidParameter, "Invalid Color Grading file `%s': %s", fileName.c_str(),
+            error.c_str());
+        return false;
+    }
+    if (!uploadLUT(capsaicin))
+    {
+        return false;
+    }
+    // Only set the internal file if it was successfully loaded
+    options_.color_grading_file = fileName;
+    return true;
+}
 
-        // Check if number of found elements exactly matches specified LUT size
-        if (token_index - 2 != 3 * lut_data.size())
-        {
-            GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
-                "Invalid Color Grading file, found elements does not match specified LUT size");
-        }
-        else if (!lut_data.empty())
-        {
-            // Upload the LUT data into a 3D texture
-            gfxDestroyTexture(gfx_, lut_buffer_);
-            lut_buffer_ = gfxCreateTexture3D(gfx_, lut_size, lut_size, lut_size, DXGI_FORMAT_R8G8B8A8_UNORM);
-            // We lazily load the upload kernel so that it is only loaded when actually needed (assumed LUT
-            // updates occur infrequently)
-            GfxProgram const upload_program =
-                capsaicin.createProgram("render_techniques/color_grading/color_grading_upload");
-            GfxKernel const upload_kernel = gfxCreateComputeKernel(gfx_, upload_program, "Upload");
-            GfxBuffer const upload_buffer =
-                gfxCreateBuffer<float4>(gfx_, static_cast<uint32_t>(lut_data.size()), lut_data.data());
-
-            gfxProgramSetParameter(gfx_, upload_program, "g_RWLutBuffer", lut_buffer_);
-            gfxProgramSetParameter(gfx_, upload_program, "g_UploadBuffer", upload_buffer);
-            gfxProgramSetParameter(gfx_, upload_program, "g_LutSize", lut_size);
-
-            uint32_t const *num_threads = gfxKernelGetNumThreads(gfx_, upload_kernel);
-            uint32_t const  num_groups_x =
-                (static_cast<uint32_t>(lut_data.size()) + num_threads[0] - 1) / num_threads[0];
-
-            gfxCommandBindKernel(gfx_, upload_kernel);
-            gfxCommandDispatch(gfx_, num_groups_x, 1, 1);
-            gfxDestroyBuffer(gfx_, upload_buffer);
-            gfxDestroyKernel(gfx_, upload_kernel);
-            gfxDestroyProgram(gfx_, upload_program);
-            failed = false;
-        }
+bool ColorGrading::uploadLUT(CapsaicinInternal const &capsaicin) noexcept
+{
+    // The upload kernels are only loaded when actually needed but are then kept as LUTs are often switched
+    // between repeatedly
+    if (!upload_program_)
+    {
+        upload_program_ =
+            capsaicin.createProgram("render_techniques/color_grading/color_grading_upload", getName());
+        upload_kernel_     = gfxCreateComputeKernel(gfx_, upload_program_, "Upload");
+        char const *define = "LUT_1D";
+        upload_1d_kernel_  = gfxCreateComputeKernel(gfx_, upload_program_, "Upload", &define, 1);
+    }
+    if (!upload_kernel_ || !upload_1d_kernel_)
+    {
+        return false;
+    }
 
-        if (!failed)
-        {
-            // Only set the internal file if it was successfully loaded
-            options_.color_grading_file = fileName;
-            return true;
-        }
+    // 3D LUTs are stored in a volume texture and 1D LUTs in a single row 2D texture, the existing texture is
+    // reused when switching between LUTs with the same layout
+    auto const description = lut_.getDescription();
+    bool const is3D        = lut_.getType() == CubeLut::Type::LUT3D;
+    if (!lut_buffer_ || lut_type_ != lut_.getType() || lut_buffer_.getWidth() != description.width
+        || lut_buffer_.getHeight() != description.height)
+    {
+        DestroyTexture(gfx_, lut_buffer_);
+        lut_buffer_ = is3D ? CreateTexture3D(gfx_, description.width, description.height,
+                                 description.sliceCount, DXGI_FORMAT_R16G16B16A16_FLOAT)
+                           : CreateTexture2D(gfx_, description.width, 1, DXGI_FORMAT_R16G16B16A16_FLOAT);
     }
-    return false;
+    lut_type_ = lut_.getType();
+    for (uint32_t channel = 0; channel < 3; ++channel)
+    {
+        lut_domain_min_[channel]   = lut_.getDomainMin()[channel];
+        lut_domain_scale_[channel] = 1.0F / (lut_.getDomainMax()[channel] - lut_.getDomainMin()[channel]);
+    }
+
+    // Each texel is uploaded as 4 packed half values
+    auto const      texels        = lut_.getTexels();
+    uint32_t const  texel_count   = static_cast<uint32_t>(texels.size() / description.bytesPerTexel);
+    GfxBuffer const upload_buffer = CreateBuffer<uint2>(gfx_, texel_count, texels.data());
+    GfxKernel const kernel        = is3D ? upload_kernel_ : upload_1d_kernel_;
+
+    gfxProgramSetParameter(gfx_, upload_program_, "g_RWLutBuffer", lut_buffer_);
+    gfxProgramSetParameter(gfx_, upload_program_, "g_UploadBuffer", upload_buffer);
+    gfxProgramSetParameter(gfx_, upload_program_, "g_LutDimensions",
+        uint3(description.width, description.height, description.sliceCount));
+
+    uint32_t const *num_threads  = gfxKernelGetNumThreads(gfx_, kernel);
+    uint32_t const  num_groups_x = (description.width + num_threads[0] - 1) / num_threads[0];
+    uint32_t const  num_groups_y = (description.height + num_threads[1] - 1) / num_threads[1];
+    uint32_t const  num_groups_z = (description.sliceCount + num_threads[2] - 1) / num_threads[2];
+
+    gfxCommandBindKernel(gfx_, kernel);
+    gfxCommandDispatch(gfx_, num_groups_x, num_groups_y, num_groups_z);
+    DestroyBuffer(gfx_, upload_buffer);
+    return true;
 }
 
 std::string ColorGrading::getSceneLUTFile(CapsaicinInternal const &capsaicin) noexcept
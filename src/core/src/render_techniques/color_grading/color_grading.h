@@ -21,6 +21,7 @@ THE SOFTWARE.
 ********************************************************************/
 #pragma once
 
+#include "cube_lut.h"
 #include "render_technique.h"
 
 namespace Capsaicin
@@ -103,12 +104,27 @@ class ColorGrading final : public RenderTechnique
      */
     [[nodiscard]] static std::string getSceneLUTFile(CapsaicinInternal const &capsaicin) noexcept;
 
+    /**
+     * Upload the currently loaded LUT into the LUT texture.
+     * @param capsaicin Current framework context.
+     * @return True on success, False otherwise.
+     */
+    bool uploadLUT(CapsaicinInternal const &capsaicin) noexcept;
+
     RenderOptions options_;    //
+    CubeLut       lut_;        /**< Parsed LUT, kept so that loading another LUT reuses its memory */
     GfxTexture    lut_buffer_; //
     bool          lut_buffer_user_selected = true;
+    CubeLut::Type lut_type_                = CubeLut::Type::LUT3D; /**< Type of LUT in lut_buffer_ */
+    float3        lut_domain_min_          = float3(0.0F);
+    float3        lut_domain_scale_        = float3(1.0F); /**< Reciprocal of the LUT domain extent */
 
     GfxProgram color_grading_program_; //
     GfxKernel  apply_kernel_;          //
+    GfxKernel  apply_1d_kernel_;       //
+    GfxProgram upload_program_;        /**< Persists between LUT loads so that switching LUTs is cheap */
+    GfxKernel  upload_kernel_;         //
+    GfxKernel  upload_1d_kernel_;      //
 };
 
 } // namespace Capsaicin
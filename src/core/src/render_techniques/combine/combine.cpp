@@ -70,7 +70,7 @@ bool Combine::init(CapsaicinInternal const &capsaicin) noexcept
     {
         defines.push_back("HAS_BACKUP_BUFFER");
     }
-    combineProgram = capsaicin.createProgram("render_techniques/combine/combine");
+    combineProgram = capsaicin.createProgram("render_techniques/combine/combine", getName());
     combineKernel  = gfxCreateComputeKernel(
         gfx_, combineProgram, "main", defines.data(), static_cast<uint32_t>(defines.size()));
 
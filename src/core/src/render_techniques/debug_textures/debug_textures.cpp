@@ -69,7 +69,7 @@ DebugViewList DebugTextures::getDebugViews() const noexcept
 
 bool DebugTextures::init(CapsaicinInternal const &capsaicin) noexcept
 {
-    program = capsaicin.createProgram("render_techniques/debug_textures/debug_textures");
+    program = capsaicin.createProgram("render_techniques/debug_textures/debug_textures", getName());
 
     GfxDrawState const drawState = {};
     gfxDrawStateSetColorTarget(drawState, 0, capsaicin.getSharedTexture("Debug").getFormat());
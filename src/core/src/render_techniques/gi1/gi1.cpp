@@ -67,46 +67,46 @@ GI1::ScreenProbes::~ScreenProbes()
 {
     for (GfxTexture const &probe_buffer : probe_buffers_)
     {
-        gfxDestroyTexture(gfx_, probe_buffer);
+        DestroyTexture(gfx_, probe_buffer);
     }
     for (GfxTexture const &probe_mask_buffer : probe_mask_buffers_)
     {
-        gfxDestroyTexture(gfx_, probe_mask_buffer);
+        DestroyTexture(gfx_, probe_mask_buffer);
     }
 
     for (GfxBuffer const &probe_sh_buffer : probe_sh_buffers_)
     {
-        gfxDestroyBuffer(gfx_, probe_sh_buffer);
+        DestroyBuffer(gfx_, probe_sh_buffer);
     }
     for (GfxBuffer const &probe_spawn_buffer : probe_spawn_buffers_)
     {
-        gfxDestroyBuffer(gfx_, probe_spawn_buffer);
-    }
-    gfxDestroyBuffer(gfx_, probe_spawn_scan_buffer_);
-    gfxDestroyBuffer(gfx_, probe_spawn_index_buffer_);
-    gfxDestroyBuffer(gfx_, probe_spawn_probe_buffer_);
-    gfxDestroyBuffer(gfx_, probe_spawn_sample_buffer_);
-    gfxDestroyBuffer(gfx_, probe_spawn_radiance_buffer_);
-    gfxDestroyBuffer(gfx_, probe_empty_tile_buffer_);
-    gfxDestroyBuffer(gfx_, probe_empty_tile_count_buffer_);
-    gfxDestroyBuffer(gfx_, probe_override_tile_buffer_);
-    gfxDestroyBuffer(gfx_, probe_override_tile_count_buffer_);
-    gfxDestroyTexture(gfx_, probe_cached_tile_buffer_);
-    gfxDestroyTexture(gfx_, probe_cached_tile_index_buffer_);
+        DestroyBuffer(gfx_, probe_spawn_buffer);
+    }
+    DestroyBuffer(gfx_, probe_spawn_scan_buffer_);
+    DestroyBuffer(gfx_, probe_spawn_index_buffer_);
+    DestroyBuffer(gfx_, probe_spawn_probe_buffer_);
+    DestroyBuffer(gfx_, probe_spawn_sample_buffer_);
+    DestroyBuffer(gfx_, probe_spawn_radiance_buffer_);
+    DestroyBuffer(gfx_, probe_empty_tile_buffer_);
+    DestroyBuffer(gfx_, probe_empty_tile_count_buffer_);
+    DestroyBuffer(gfx_, probe_override_tile_buffer_);
+    DestroyBuffer(gfx_, probe_override_tile_count_buffer_);
+    DestroyTexture(gfx_, probe_cached_tile_buffer_);
+    DestroyTexture(gfx_, probe_cached_tile_index_buffer_);
     for (GfxBuffer const &probe_cached_tile_lru_buffer : probe_cached_tile_lru_buffers_)
     {
-        gfxDestroyBuffer(gfx_, probe_cached_tile_lru_buffer);
-    }
-    gfxDestroyBuffer(gfx_, probe_cached_tile_lru_flag_buffer_);
-    gfxDestroyBuffer(gfx_, probe_cached_tile_lru_count_buffer_);
-    gfxDestroyBuffer(gfx_, probe_cached_tile_lru_index_buffer_);
-    gfxDestroyBuffer(gfx_, probe_cached_tile_mru_buffer_);
-    gfxDestroyBuffer(gfx_, probe_cached_tile_mru_count_buffer_);
-    gfxDestroyBuffer(gfx_, probe_cached_tile_list_buffer_);
-    gfxDestroyBuffer(gfx_, probe_cached_tile_list_count_buffer_);
-    gfxDestroyBuffer(gfx_, probe_cached_tile_list_index_buffer_);
-    gfxDestroyBuffer(gfx_, probe_cached_tile_list_element_buffer_);
-    gfxDestroyBuffer(gfx_, probe_cached_tile_list_element_count_buffer_);
+        DestroyBuffer(gfx_, probe_cached_tile_lru_buffer);
+    }
+    DestroyBuffer(gfx_, probe_cached_tile_lru_flag_buffer_);
+    DestroyBuffer(gfx_, probe_cached_tile_lru_count_buffer_);
+    DestroyBuffer(gfx_, probe_cached_tile_lru_index_buffer_);
+    DestroyBuffer(gfx_, probe_cached_tile_mru_buffer_);
+    DestroyBuffer(gfx_, probe_cached_tile_mru_count_buffer_);
+    DestroyBuffer(gfx_, probe_cached_tile_list_buffer_);
+    DestroyBuffer(gfx_, probe_cached_tile_list_count_buffer_);
+    DestroyBuffer(gfx_, probe_cached_tile_list_index_buffer_);
+    DestroyBuffer(gfx_, probe_cached_tile_list_element_buffer_);
+    DestroyBuffer(gfx_, probe_cached_tile_list_element_count_buffer_);
 }
 
 void GI1::ScreenProbes::ensureMemoryIsAllocated(CapsaicinInternal const &capsaicin)
@@ -132,7 +132,7 @@ void GI1::ScreenProbes::ensureMemoryIsAllocated(CapsaicinInternal const &capsaic
     {
         for (GfxTexture const &probe_buffer : probe_buffers_)
         {
-            gfxDestroyTexture(gfx_, probe_buffer);
+            DestroyTexture(gfx_, probe_buffer);
         }
 
         for (uint32_t i = 0; i < ARRAYSIZE(probe_buffers_); ++i)
@@ -140,7 +140,7 @@ void GI1::ScreenProbes::ensureMemoryIsAllocated(CapsaicinInternal const &capsaic
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_ProbeBuffer%u", i);
 
-            probe_buffers_[i] = gfxCreateTexture2D(
+            probe_buffers_[i] = CreateTexture2D(
                 gfx_, probe_buffer_width, probe_buffer_height, DXGI_FORMAT_R16G16B16A16_FLOAT);
             probe_buffers_[i].setName(buffer);
         }
@@ -151,7 +151,7 @@ void GI1::ScreenProbes::ensureMemoryIsAllocated(CapsaicinInternal const &capsaic
     {
         for (GfxTexture const &probe_mask_buffer : probe_mask_buffers_)
         {
-            gfxDestroyTexture(gfx_, probe_mask_buffer);
+            DestroyTexture(gfx_, probe_mask_buffer);
         }
 
         gfxCommandBindKernel(gfx_, self.clear_probe_mask_kernel_);
@@ -163,7 +163,7 @@ void GI1::ScreenProbes::ensureMemoryIsAllocated(CapsaicinInternal const &capsaic
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_ProbeMaskBuffer%u", i);
 
-            probe_mask_buffers_[i] = gfxCreateTexture2D(
+            probe_mask_buffers_[i] = CreateTexture2D(
                 gfx_, probe_count[0], probe_count[1], DXGI_FORMAT_R32_UINT, probe_mask_mip_count);
             probe_mask_buffers_[i].setName(buffer);
 
@@ -186,7 +186,7 @@ void GI1::ScreenProbes::ensureMemoryIsAllocated(CapsaicinInternal const &capsaic
     {
         for (GfxBuffer const &probe_sh_buffer : probe_sh_buffers_)
         {
-            gfxDestroyBuffer(gfx_, probe_sh_buffer);
+            DestroyBuffer(gfx_, probe_sh_buffer);
         }
 
         for (uint32_t i = 0; i < ARRAYSIZE(probe_sh_buffers_); ++i)
@@ -194,7 +194,7 @@ void GI1::ScreenProbes::ensureMemoryIsAllocated(CapsaicinInternal const &capsaic
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_ProbeSHBuffer%u", i);
 
-            probe_sh_buffers_[i] = gfxCreateBuffer<uint2>(gfx_, 9 * max_probe_count);
+            probe_sh_buffers_[i] = CreateBuffer<uint2>(gfx_, 9 * max_probe_count);
             probe_sh_buffers_[i].setName(buffer);
         }
     }
@@ -203,93 +203,93 @@ void GI1::ScreenProbes::ensureMemoryIsAllocated(CapsaicinInternal const &capsaic
     {
         for (GfxBuffer const &probe_spawn_buffer : probe_spawn_buffers_)
         {
-            gfxDestroyBuffer(gfx_, probe_spawn_buffer);
+            DestroyBuffer(gfx_, probe_spawn_buffer);
         }
-        gfxDestroyBuffer(gfx_, probe_spawn_scan_buffer_);
-        gfxDestroyBuffer(gfx_, probe_spawn_index_buffer_);
-        gfxDestroyBuffer(gfx_, probe_spawn_probe_buffer_);
-        gfxDestroyBuffer(gfx_, probe_spawn_sample_buffer_);
-        gfxDestroyBuffer(gfx_, probe_spawn_radiance_buffer_);
-        gfxDestroyBuffer(gfx_, probe_override_tile_buffer_);
+        DestroyBuffer(gfx_, probe_spawn_scan_buffer_);
+        DestroyBuffer(gfx_, probe_spawn_index_buffer_);
+        DestroyBuffer(gfx_, probe_spawn_probe_buffer_);
+        DestroyBuffer(gfx_, probe_spawn_sample_buffer_);
+        DestroyBuffer(gfx_, probe_spawn_radiance_buffer_);
+        DestroyBuffer(gfx_, probe_override_tile_buffer_);
 
         for (uint32_t i = 0; i < ARRAYSIZE(probe_spawn_buffers_); ++i)
         {
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_ProbeSpawnBuffer%u", i);
 
-            probe_spawn_buffers_[i] = gfxCreateBuffer<uint32_t>(gfx_, max_probe_spawn_count);
+            probe_spawn_buffers_[i] = CreateBuffer<uint32_t>(gfx_, max_probe_spawn_count);
             probe_spawn_buffers_[i].setName(buffer);
         }
 
-        probe_spawn_scan_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, max_probe_spawn_count);
+        probe_spawn_scan_buffer_ = CreateBuffer<uint32_t>(gfx_, max_probe_spawn_count);
         probe_spawn_scan_buffer_.setName("Capsaicin_ProbeSpawnScanBuffer");
 
-        probe_spawn_index_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, max_probe_spawn_count);
+        probe_spawn_index_buffer_ = CreateBuffer<uint32_t>(gfx_, max_probe_spawn_count);
         probe_spawn_index_buffer_.setName("Capsaicin_ProbeSpawnIndexBuffer");
 
-        probe_spawn_probe_buffer_ = gfxCreateBuffer<uint2>(gfx_, max_probe_spawn_count);
+        probe_spawn_probe_buffer_ = CreateBuffer<uint2>(gfx_, max_probe_spawn_count);
         probe_spawn_probe_buffer_.setName("Capsaicin_ProbeSpawnProbeBuffer");
 
-        probe_spawn_sample_buffer_ = gfxCreateBuffer<uint2>(gfx_, max_ray_count);
+        probe_spawn_sample_buffer_ = CreateBuffer<uint2>(gfx_, max_ray_count);
         probe_spawn_sample_buffer_.setName("Capsaicin_ProbeSpawnSampleBuffer");
 
-        probe_spawn_radiance_buffer_ = gfxCreateBuffer<uint2>(gfx_, max_ray_count);
+        probe_spawn_radiance_buffer_ = CreateBuffer<uint2>(gfx_, max_ray_count);
         probe_spawn_radiance_buffer_.setName("Capsaicin_ProbeSpawnRadianceBuffer");
 
-        probe_override_tile_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, max_probe_spawn_count);
+        probe_override_tile_buffer_ = CreateBuffer<uint32_t>(gfx_, max_probe_spawn_count);
         probe_override_tile_buffer_.setName("Capsaicin_ProbeOverrideTileBuffer");
     }
 
     if (probe_empty_tile_buffer_.getCount() != max_probe_count)
     {
-        gfxDestroyBuffer(gfx_, probe_empty_tile_buffer_);
+        DestroyBuffer(gfx_, probe_empty_tile_buffer_);
 
-        probe_empty_tile_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, max_probe_count);
+        probe_empty_tile_buffer_ = CreateBuffer<uint32_t>(gfx_, max_probe_count);
         probe_empty_tile_buffer_.setName("Capsaicin_ProbeEmptyTileBuffer");
     }
 
     if (!probe_empty_tile_count_buffer_.getCount())
     {
-        gfxDestroyBuffer(gfx_, probe_empty_tile_count_buffer_);
+        DestroyBuffer(gfx_, probe_empty_tile_count_buffer_);
 
-        probe_empty_tile_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        probe_empty_tile_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         probe_empty_tile_count_buffer_.setName("Capsaicin_ProbeEmptyTileCountBuffer");
     }
 
     if (!probe_override_tile_count_buffer_.getCount())
     {
-        gfxDestroyBuffer(gfx_, probe_override_tile_count_buffer_);
+        DestroyBuffer(gfx_, probe_override_tile_count_buffer_);
 
-        probe_override_tile_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        probe_override_tile_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         probe_override_tile_count_buffer_.setName("Capsaicin_ProbeOverrideTileCountBuffer");
     }
 
     if (probe_cached_tile_buffer_.getWidth() != probe_buffer_width
         || probe_cached_tile_buffer_.getHeight() != probe_buffer_height)
     {
-        gfxDestroyTexture(gfx_, probe_cached_tile_buffer_);
-        gfxDestroyTexture(gfx_, probe_cached_tile_index_buffer_);
+        DestroyTexture(gfx_, probe_cached_tile_buffer_);
+        DestroyTexture(gfx_, probe_cached_tile_index_buffer_);
         for (GfxBuffer const &probe_cached_tile_lru_buffer : probe_cached_tile_lru_buffers_)
         {
-            gfxDestroyBuffer(gfx_, probe_cached_tile_lru_buffer);
+            DestroyBuffer(gfx_, probe_cached_tile_lru_buffer);
         }
-        gfxDestroyBuffer(gfx_, probe_cached_tile_lru_flag_buffer_);
-        gfxDestroyBuffer(gfx_, probe_cached_tile_lru_count_buffer_);
-        gfxDestroyBuffer(gfx_, probe_cached_tile_lru_index_buffer_);
-        gfxDestroyBuffer(gfx_, probe_cached_tile_mru_buffer_);
-        gfxDestroyBuffer(gfx_, probe_cached_tile_mru_count_buffer_);
-        gfxDestroyBuffer(gfx_, probe_cached_tile_list_buffer_);
-        gfxDestroyBuffer(gfx_, probe_cached_tile_list_count_buffer_);
-        gfxDestroyBuffer(gfx_, probe_cached_tile_list_index_buffer_);
-        gfxDestroyBuffer(gfx_, probe_cached_tile_list_element_buffer_);
-        gfxDestroyBuffer(gfx_, probe_cached_tile_list_element_count_buffer_);
+        DestroyBuffer(gfx_, probe_cached_tile_lru_flag_buffer_);
+        DestroyBuffer(gfx_, probe_cached_tile_lru_count_buffer_);
+        DestroyBuffer(gfx_, probe_cached_tile_lru_index_buffer_);
+        DestroyBuffer(gfx_, probe_cached_tile_mru_buffer_);
+        DestroyBuffer(gfx_, probe_cached_tile_mru_count_buffer_);
+        DestroyBuffer(gfx_, probe_cached_tile_list_buffer_);
+        DestroyBuffer(gfx_, probe_cached_tile_list_count_buffer_);
+        DestroyBuffer(gfx_, probe_cached_tile_list_index_buffer_);
+        DestroyBuffer(gfx_, probe_cached_tile_list_element_buffer_);
+        DestroyBuffer(gfx_, probe_cached_tile_list_element_count_buffer_);
 
         probe_cached_tile_buffer_ =
-            gfxCreateTexture2D(gfx_, probe_buffer_width, probe_buffer_height, DXGI_FORMAT_R16G16B16A16_FLOAT);
+            CreateTexture2D(gfx_, probe_buffer_width, probe_buffer_height, DXGI_FORMAT_R16G16B16A16_FLOAT);
         probe_cached_tile_buffer_.setName("Capsaicin_ProbeCachedTileBuffer");
 
         probe_cached_tile_index_buffer_ =
-            gfxCreateTexture2D(gfx_, probe_count[0], probe_count[1], DXGI_FORMAT_R32G32B32A32_FLOAT);
+            CreateTexture2D(gfx_, probe_count[0], probe_count[1], DXGI_FORMAT_R32G32B32A32_FLOAT);
         probe_cached_tile_index_buffer_.setName("Capsaicin_ProbeCachedTileIndexBuffer");
 
         for (uint32_t i = 0; i < ARRAYSIZE(probe_cached_tile_lru_buffers_); ++i)
@@ -297,38 +297,38 @@ void GI1::ScreenProbes::ensureMemoryIsAllocated(CapsaicinInternal const &capsaic
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_ProbeCachedTileLRUBuffer%u", i);
 
-            probe_cached_tile_lru_buffers_[i] = gfxCreateBuffer<uint32_t>(gfx_, max_probe_count);
+            probe_cached_tile_lru_buffers_[i] = CreateBuffer<uint32_t>(gfx_, max_probe_count);
             probe_cached_tile_lru_buffers_[i].setName(buffer);
         }
 
-        probe_cached_tile_lru_flag_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, max_probe_count + 1);
+        probe_cached_tile_lru_flag_buffer_ = CreateBuffer<uint32_t>(gfx_, max_probe_count + 1);
         probe_cached_tile_lru_flag_buffer_.setName("Capsaicin_ProbeCachedTileLRUFlagBuffer");
 
-        probe_cached_tile_lru_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        probe_cached_tile_lru_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         probe_cached_tile_lru_count_buffer_.setName("Capsaicin_ProbeCachedTileLRUCountBuffer");
 
-        probe_cached_tile_lru_index_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, max_probe_count + 1);
+        probe_cached_tile_lru_index_buffer_ = CreateBuffer<uint32_t>(gfx_, max_probe_count + 1);
         probe_cached_tile_lru_index_buffer_.setName("Capsaicin_ProbeCachedTileLRUIndexBuffer");
 
-        probe_cached_tile_mru_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, max_probe_count);
+        probe_cached_tile_mru_buffer_ = CreateBuffer<uint32_t>(gfx_, max_probe_count);
         probe_cached_tile_mru_buffer_.setName("Capsaicin_ProbeCachedTileMRUBuffer");
 
-        probe_cached_tile_mru_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        probe_cached_tile_mru_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         probe_cached_tile_mru_count_buffer_.setName("Capsaicin_ProbeCachedTileMRUCountBuffer");
 
-        probe_cached_tile_list_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, max_probe_count);
+        probe_cached_tile_list_buffer_ = CreateBuffer<uint32_t>(gfx_, max_probe_count);
         probe_cached_tile_list_buffer_.setName("Capsaicin_ProbeCachedTileListBuffer");
 
-        probe_cached_tile_list_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, max_probe_count);
+        probe_cached_tile_list_count_buffer_ = CreateBuffer<uint32_t>(gfx_, max_probe_count);
         probe_cached_tile_list_count_buffer_.setName("Capsaicin_ProbeCachedTileListCountBuffer");
 
-        probe_cached_tile_list_index_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, max_probe_count);
+        probe_cached_tile_list_index_buffer_ = CreateBuffer<uint32_t>(gfx_, max_probe_count);
         probe_cached_tile_list_index_buffer_.setName("Capsaicin_ProbeCachedTileListIndexBuffer");
 
-        probe_cached_tile_list_element_buffer_ = gfxCreateBuffer<uint4>(gfx_, max_probe_count);
+        probe_cached_tile_list_element_buffer_ = CreateBuffer<uint4>(gfx_, max_probe_count);
         probe_cached_tile_list_element_buffer_.setName("Capsaicin_ProbeCachedTileListElementBuffer");
 
-        probe_cached_tile_list_element_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        probe_cached_tile_list_element_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         probe_cached_tile_list_element_count_buffer_.setName(
             "Capsaicin_ProbeCachedTileListElementCountBuffer");
 
@@ -433,27 +433,27 @@ GI1::HashGridCache::~HashGridCache()
 {
     for (GfxBuffer const &buffer : radiance_cache_hash_buffer_float_)
     {
-        gfxDestroyBuffer(gfx_, buffer);
+        DestroyBuffer(gfx_, buffer);
     }
 
     for (GfxBuffer const &buffer : radiance_cache_hash_buffer_uint_)
     {
-        gfxDestroyBuffer(gfx_, buffer);
+        DestroyBuffer(gfx_, buffer);
     }
 
     for (GfxBuffer const &buffer : radiance_cache_hash_buffer_uint2_)
     {
-        gfxDestroyBuffer(gfx_, buffer);
+        DestroyBuffer(gfx_, buffer);
     }
 
     for (GfxBuffer const &buffer : radiance_cache_hash_buffer_float4_)
     {
-        gfxDestroyBuffer(gfx_, buffer);
+        DestroyBuffer(gfx_, buffer);
     }
 
     for (GfxBuffer const &buffer : radiance_cache_debug_stats_readback_buffers_)
     {
-        gfxDestroyBuffer(gfx_, buffer);
+        DestroyBuffer(gfx_, buffer);
     }
 }
 
@@ -491,13 +491,13 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_hash_buffer_ || num_tiles != num_tiles_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_hash_buffer_);
-        gfxDestroyBuffer(gfx_, radiance_cache_decay_tile_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_hash_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_decay_tile_buffer_);
 
-        radiance_cache_hash_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
+        radiance_cache_hash_buffer_ = CreateBuffer<uint32_t>(gfx_, num_tiles);
         radiance_cache_hash_buffer_.setName("Capsaicin_RadianceCache_HashBuffer");
 
-        radiance_cache_decay_tile_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
+        radiance_cache_decay_tile_buffer_ = CreateBuffer<uint32_t>(gfx_, num_tiles);
         radiance_cache_decay_tile_buffer_.setName("Capsaicin_RadianceCache_DecayTileBuffer");
 
         gfxCommandClearBuffer(gfx_, radiance_cache_hash_buffer_); // clear the radiance cache
@@ -508,9 +508,9 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_value_buffer_ || num_cells != num_cells_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_value_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_value_buffer_);
         
-        radiance_cache_value_buffer_ = gfxCreateBuffer<uint2>(gfx_, num_cells);
+        radiance_cache_value_buffer_ = CreateBuffer<uint2>(gfx_, num_cells);
         radiance_cache_value_buffer_.setName("Capsaicin_RadianceCache_ValueBuffer");
     }
 
@@ -518,8 +518,8 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_multibounce_info_buffer_ || num_cells != num_cells_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_multibounce_info_buffer_);
-        radiance_cache_multibounce_info_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_cells);
+        DestroyBuffer(gfx_, radiance_cache_multibounce_info_buffer_);
+        radiance_cache_multibounce_info_buffer_ = CreateBuffer<uint32_t>(gfx_, num_cells);
         radiance_cache_multibounce_info_buffer_.setName("Capsaicin_RadianceCache_MultibounceInfoBuffer");
         
         gfxCommandClearBuffer(gfx_, radiance_cache_multibounce_info_buffer_);
@@ -529,9 +529,9 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_value_indirect_buffer_ || num_cells != num_cells_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_value_indirect_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_value_indirect_buffer_);
 
-        radiance_cache_value_indirect_buffer_ = gfxCreateBuffer<uint2>(gfx_, num_cells);
+        radiance_cache_value_indirect_buffer_ = CreateBuffer<uint2>(gfx_, num_cells);
         radiance_cache_value_indirect_buffer_.setName("Capsaicin_RadianceCache_ValueIndirectBuffer");
     }
 
@@ -539,7 +539,7 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_update_tile_count_buffer_)
     {
-        radiance_cache_update_tile_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        radiance_cache_update_tile_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         radiance_cache_update_tile_count_buffer_.setName("Capsaicin_RadianceCache_UpdateTileCountBuffer");
     }
 
@@ -547,9 +547,9 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_update_cell_value_buffer_ || num_cells != num_cells_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_update_cell_value_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_update_cell_value_buffer_);
 
-        radiance_cache_update_cell_value_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_cells << 2);
+        radiance_cache_update_cell_value_buffer_ = CreateBuffer<uint32_t>(gfx_, num_cells << 2);
         radiance_cache_update_cell_value_buffer_.setName("Capsaicin_RadianceCache_UpdateCellValueBuffer");
 
         gfxCommandClearBuffer(gfx_, radiance_cache_update_cell_value_buffer_);
@@ -559,8 +559,8 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_update_cell_value_buffer_ || num_cells != num_cells_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_update_cell_value_indirect_buffer_);
-        radiance_cache_update_cell_value_indirect_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_cells << 2);
+        DestroyBuffer(gfx_, radiance_cache_update_cell_value_indirect_buffer_);
+        radiance_cache_update_cell_value_indirect_buffer_ = CreateBuffer<uint32_t>(gfx_, num_cells << 2);
         radiance_cache_update_cell_value_indirect_buffer_.setName(
             "Capsaicin_RadianceCache_UpdateCellValueIndirectBuffer");
 
@@ -570,25 +570,25 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_visibility_count_buffer0_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_visibility_count_buffer0_);
-        gfxDestroyBuffer(gfx_, radiance_cache_visibility_count_buffer1_);
-        gfxDestroyBuffer(gfx_, radiance_cache_visibility_ray_count_buffer_);
-        gfxDestroyBuffer(gfx_, radiance_cache_packed_tile_count_buffer0_);
-        gfxDestroyBuffer(gfx_, radiance_cache_packed_tile_count_buffer1_);
+        DestroyBuffer(gfx_, radiance_cache_visibility_count_buffer0_);
+        DestroyBuffer(gfx_, radiance_cache_visibility_count_buffer1_);
+        DestroyBuffer(gfx_, radiance_cache_visibility_ray_count_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_packed_tile_count_buffer0_);
+        DestroyBuffer(gfx_, radiance_cache_packed_tile_count_buffer1_);
 
-        radiance_cache_visibility_count_buffer0_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        radiance_cache_visibility_count_buffer0_ = CreateBuffer<uint32_t>(gfx_, 1);
         radiance_cache_visibility_count_buffer0_.setName("Capsaicin_RadianceCache_VisibilityCountBuffer0");
-        radiance_cache_visibility_count_buffer1_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        radiance_cache_visibility_count_buffer1_ = CreateBuffer<uint32_t>(gfx_, 1);
         radiance_cache_visibility_count_buffer1_.setName("Capsaicin_RadianceCache_VisibilityCountBuffer1");
 
-        radiance_cache_visibility_ray_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        radiance_cache_visibility_ray_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         radiance_cache_visibility_ray_count_buffer_.setName(
             "Capsaicin_RadianceCache_VisibilityRayCountBuffer");
 
-        radiance_cache_packed_tile_count_buffer0_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        radiance_cache_packed_tile_count_buffer0_ = CreateBuffer<uint32_t>(gfx_, 1);
         radiance_cache_packed_tile_count_buffer0_.setName("Capsaicin_RadianceCache_PackedTileCountBuffer0");
 
-        radiance_cache_packed_tile_count_buffer1_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        radiance_cache_packed_tile_count_buffer1_ = CreateBuffer<uint32_t>(gfx_, 1);
         radiance_cache_packed_tile_count_buffer1_.setName("Capsaicin_RadianceCache_PackedTileCountBuffer1");
     }
 
@@ -600,13 +600,13 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_packed_tile_index_buffer0_ || num_tiles != num_tiles_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_packed_tile_index_buffer0_);
-        gfxDestroyBuffer(gfx_, radiance_cache_packed_tile_index_buffer1_);
+        DestroyBuffer(gfx_, radiance_cache_packed_tile_index_buffer0_);
+        DestroyBuffer(gfx_, radiance_cache_packed_tile_index_buffer1_);
 
-        radiance_cache_packed_tile_index_buffer0_ = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
+        radiance_cache_packed_tile_index_buffer0_ = CreateBuffer<uint32_t>(gfx_, num_tiles);
         radiance_cache_packed_tile_index_buffer0_.setName("Capsaicin_RadianceCache_PackedTileIndexBuffer0");
 
-        radiance_cache_packed_tile_index_buffer1_ = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
+        radiance_cache_packed_tile_index_buffer1_ = CreateBuffer<uint32_t>(gfx_, num_tiles);
         radiance_cache_packed_tile_index_buffer1_.setName("Capsaicin_RadianceCache_PackedTileIndexBuffer1");
 
         gfxCommandClearBuffer(gfx_, radiance_cache_packed_tile_index_buffer0_);
@@ -624,12 +624,12 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
     {
         if (!radiance_cache_debug_cell_buffer_ || num_cells != num_cells_)
         {
-            gfxDestroyBuffer(gfx_, radiance_cache_debug_decay_cell_buffer_);
-            gfxDestroyBuffer(gfx_, radiance_cache_debug_cell_buffer_);
+            DestroyBuffer(gfx_, radiance_cache_debug_decay_cell_buffer_);
+            DestroyBuffer(gfx_, radiance_cache_debug_cell_buffer_);
 
-            radiance_cache_debug_decay_cell_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_cells);
+            radiance_cache_debug_decay_cell_buffer_ = CreateBuffer<uint32_t>(gfx_, num_cells);
             radiance_cache_debug_decay_cell_buffer_.setName("Capsaicin_RadianceCache_DebugDecayCellBuffer");
-            radiance_cache_debug_cell_buffer_ = gfxCreateBuffer<float4>(gfx_, num_cells);
+            radiance_cache_debug_cell_buffer_ = CreateBuffer<float4>(gfx_, num_cells);
             radiance_cache_debug_cell_buffer_.setName("Capsaicin_RadianceCache_DebugCellBuffer");
 
             gfxCommandClearBuffer(gfx_, radiance_cache_debug_decay_cell_buffer_, 0xFFFFFFFFu);
@@ -637,8 +637,8 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
     }
     else
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_debug_decay_cell_buffer_);
-        gfxDestroyBuffer(gfx_, radiance_cache_debug_cell_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_debug_decay_cell_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_debug_cell_buffer_);
 
         radiance_cache_debug_decay_cell_buffer_ = {};
         radiance_cache_debug_cell_buffer_       = {};
@@ -649,27 +649,27 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_update_tile_buffer_ || max_ray_count != max_ray_count_ || num_cells != num_cells_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_update_tile_buffer_);
-        gfxDestroyBuffer(gfx_, radiance_cache_visibility_buffer_);
-        gfxDestroyBuffer(gfx_, radiance_cache_visibility_cell_buffer_);
-        gfxDestroyBuffer(gfx_, radiance_cache_visibility_query_buffer_);
-        gfxDestroyBuffer(gfx_, radiance_cache_visibility_ray_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_update_tile_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_visibility_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_visibility_cell_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_visibility_query_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_visibility_ray_buffer_);
 
         radiance_cache_update_tile_buffer_ =
-            gfxCreateBuffer<uint32_t>(gfx_, GFX_MIN(2 * max_ray_count, num_cells));
+            CreateBuffer<uint32_t>(gfx_, GFX_MIN(2 * max_ray_count, num_cells));
         radiance_cache_update_tile_buffer_.setName("Capsaicin_RadianceCache_UpdateTileBuffer");
 
         radiance_cache_visibility_buffer_ =
-            gfxCreateBuffer<float4>(gfx_, 2 * max_ray_count); // BE CAREFUL: only bounce 0 and 1
+            CreateBuffer<float4>(gfx_, 2 * max_ray_count); // BE CAREFUL: only bounce 0 and 1
         radiance_cache_visibility_buffer_.setName("Capsaicin_RadianceCache_VisibilityBuffer");
 
-        radiance_cache_visibility_cell_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 2 * max_ray_count);
+        radiance_cache_visibility_cell_buffer_ = CreateBuffer<uint32_t>(gfx_, 2 * max_ray_count);
         radiance_cache_visibility_cell_buffer_.setName("Capsaicin_RadianceCache_VisibilityCellBuffer");
 
-        radiance_cache_visibility_query_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 2 * max_ray_count);
+        radiance_cache_visibility_query_buffer_ = CreateBuffer<uint32_t>(gfx_, 2 * max_ray_count);
         radiance_cache_visibility_query_buffer_.setName("Capsaicin_RadianceCache_VisibilityQueryBuffer");
 
-        radiance_cache_visibility_ray_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 2 * max_ray_count);
+        radiance_cache_visibility_ray_buffer_ = CreateBuffer<uint32_t>(gfx_, 2 * max_ray_count);
         radiance_cache_visibility_ray_buffer_.setName("Capsaicin_RadianceCache_VisibilityRayBuffer");
     }
 
@@ -681,7 +681,7 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_multibounce_count_buffer_)
     {
-        radiance_cache_multibounce_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        radiance_cache_multibounce_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         radiance_cache_multibounce_count_buffer_.setName("Capsaicin_RadianceCache_MultibounceCountBuffer");
     }
 
@@ -690,10 +690,10 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
     if (!radiance_cache_multibounce_cell_buffer_ || max_ray_count != max_ray_count_)
     {
         radiance_cache_multibounce_cell_buffer_ =
-            gfxCreateBuffer<uint32_t>(gfx_, max_ray_count);
+            CreateBuffer<uint32_t>(gfx_, max_ray_count);
         radiance_cache_multibounce_cell_buffer_.setName("Capsaicin_RadianceCache_MultibounceCellBuffer");
         radiance_cache_multibounce_query_buffer_ =
-            gfxCreateBuffer<uint32_t>(gfx_, max_ray_count);
+            CreateBuffer<uint32_t>(gfx_, max_ray_count);
         radiance_cache_multibounce_query_buffer_.setName("Capsaicin_RadianceCache_MultibounceQueryBuffer"); 
     }
 
@@ -702,7 +702,7 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_resolve_count_buffer_)
     {
-        radiance_cache_resolve_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        radiance_cache_resolve_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         radiance_cache_resolve_count_buffer_.setName("Capsaicin_RadianceCache_ResolveCountBuffer");
     }
 
@@ -711,7 +711,7 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
     if (!radiance_cache_resolve_buffer_ || max_ray_count != max_ray_count_)
     {
         radiance_cache_resolve_buffer_ =
-            gfxCreateBuffer<uint32_t>(gfx_, max_ray_count); // BE CAREFUL: we only resolve first bounce cells
+            CreateBuffer<uint32_t>(gfx_, max_ray_count); // BE CAREFUL: we only resolve first bounce cells
         radiance_cache_resolve_buffer_.setName("Capsaicin_RadianceCache_ResolveBuffer");
     }
 
@@ -719,13 +719,13 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_debug_free_bucket_buffer_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_debug_free_bucket_buffer_);
-        gfxDestroyBuffer(gfx_, radiance_cache_debug_used_bucket_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_debug_free_bucket_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_debug_used_bucket_buffer_);
 
-        radiance_cache_debug_free_bucket_buffer_ = gfxCreateBuffer<uint>(gfx_, 1);
+        radiance_cache_debug_free_bucket_buffer_ = CreateBuffer<uint>(gfx_, 1);
         radiance_cache_debug_free_bucket_buffer_.setName("Capsaicin_RadianceCache_FreeBucketBuffer");
 
-        radiance_cache_debug_used_bucket_buffer_ = gfxCreateBuffer<uint>(gfx_, 1);
+        radiance_cache_debug_used_bucket_buffer_ = CreateBuffer<uint>(gfx_, 1);
         radiance_cache_debug_used_bucket_buffer_.setName("Capsaicin_RadianceCache_UsedBucketBuffer");
     }
 
@@ -734,9 +734,9 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_debug_bucket_overflow_count_buffer_ || num_buckets != num_buckets_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_debug_bucket_overflow_count_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_debug_bucket_overflow_count_buffer_);
 
-        radiance_cache_debug_bucket_overflow_count_buffer_ = gfxCreateBuffer<uint>(gfx_, num_buckets);
+        radiance_cache_debug_bucket_overflow_count_buffer_ = CreateBuffer<uint>(gfx_, num_buckets);
         radiance_cache_debug_bucket_overflow_count_buffer_.setName(
             "Capsaicin_RadianceCache_BucketOverflowBuffer");
     }
@@ -747,10 +747,10 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
         || debug_bucket_occupancy_histogram_size != debug_bucket_occupancy_histogram_size_)
     {
         static_assert(kGfxConstant_BackBufferCount == 3);
-        gfxDestroyBuffer(gfx_, radiance_cache_debug_bucket_occupancy_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_debug_bucket_occupancy_buffer_);
 
         radiance_cache_debug_bucket_occupancy_buffer_ =
-            gfxCreateBuffer<uint>(gfx_, debug_bucket_occupancy_histogram_size + 1);
+            CreateBuffer<uint>(gfx_, debug_bucket_occupancy_histogram_size + 1);
         radiance_cache_debug_bucket_occupancy_buffer_.setName(
             "Capsaicin_RadianceCache_BucketOccupancyBuffer");
     }
@@ -760,10 +760,10 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
     if (!radiance_cache_debug_bucket_overflow_buffer_
         || debug_bucket_overflow_histogram_size != debug_bucket_overflow_histogram_size_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_debug_bucket_overflow_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_debug_bucket_overflow_buffer_);
 
         radiance_cache_debug_bucket_overflow_buffer_ =
-            gfxCreateBuffer<uint>(gfx_, debug_bucket_overflow_histogram_size);
+            CreateBuffer<uint>(gfx_, debug_bucket_overflow_histogram_size);
         radiance_cache_debug_bucket_overflow_buffer_.setName("Capsaicin_RadianceCache_BucketOverflowBuffer");
     }
 
@@ -771,13 +771,13 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
 
     if (!radiance_cache_debug_stats_buffer_ || debug_stats_size != debug_stats_size_)
     {
-        gfxDestroyBuffer(gfx_, radiance_cache_debug_stats_buffer_);
+        DestroyBuffer(gfx_, radiance_cache_debug_stats_buffer_);
         for (GfxBuffer const &buffer : radiance_cache_debug_stats_readback_buffers_)
         {
-            gfxDestroyBuffer(gfx_, buffer);
+            DestroyBuffer(gfx_, buffer);
         }
 
-        radiance_cache_debug_stats_buffer_ = gfxCreateBuffer<float>(gfx_, debug_stats_size);
+        radiance_cache_debug_stats_buffer_ = CreateBuffer<float>(gfx_, debug_stats_size);
         radiance_cache_debug_stats_buffer_.setName("Capsaicin_RadianceCache_StatsBuffer");
 
         for (uint32_t i = 0; i < ARRAYSIZE(radiance_cache_debug_stats_readback_buffers_); ++i)
@@ -786,7 +786,7 @@ void GI1::HashGridCache::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinInter
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_RadianceCache_StatsReadbackBuffer%u", i);
 
             radiance_cache_debug_stats_readback_buffers_[i] =
-                gfxCreateBuffer<float>(gfx_, debug_stats_size, nullptr, kGfxCpuAccess_Read);
+                CreateBuffer<float>(gfx_, debug_stats_size, nullptr, kGfxCpuAccess_Read);
             radiance_cache_debug_stats_readback_buffers_[i].setName(buffer);
 
             radiance_cache_debug_stats_readback_is_pending_[i] = false; // Don't read-back unfilled buffers
@@ -832,33 +832,33 @@ GI1::WorldSpaceReSTIR::~WorldSpaceReSTIR()
 {
     for (GfxBuffer const &reservoir_hash_buffer : reservoir_hash_buffers_)
     {
-        gfxDestroyBuffer(gfx_, reservoir_hash_buffer);
+        DestroyBuffer(gfx_, reservoir_hash_buffer);
     }
     for (GfxBuffer const &reservoir_hash_count_buffer : reservoir_hash_count_buffers_)
     {
-        gfxDestroyBuffer(gfx_, reservoir_hash_count_buffer);
+        DestroyBuffer(gfx_, reservoir_hash_count_buffer);
     }
     for (GfxBuffer const &reservoir_hash_index_buffer : reservoir_hash_index_buffers_)
     {
-        gfxDestroyBuffer(gfx_, reservoir_hash_index_buffer);
+        DestroyBuffer(gfx_, reservoir_hash_index_buffer);
     }
     for (GfxBuffer const &reservoir_hash_value_buffer : reservoir_hash_value_buffers_)
     {
-        gfxDestroyBuffer(gfx_, reservoir_hash_value_buffer);
+        DestroyBuffer(gfx_, reservoir_hash_value_buffer);
     }
-    gfxDestroyBuffer(gfx_, reservoir_hash_list_buffer_);
-    gfxDestroyBuffer(gfx_, reservoir_hash_list_count_buffer_);
+    DestroyBuffer(gfx_, reservoir_hash_list_buffer_);
+    DestroyBuffer(gfx_, reservoir_hash_list_count_buffer_);
 
-    gfxDestroyBuffer(gfx_, reservoir_indirect_sample_buffer_);
+    DestroyBuffer(gfx_, reservoir_indirect_sample_buffer_);
     for (GfxBuffer const &reservoir_indirect_sample_normal_buffer : reservoir_indirect_sample_normal_buffers_)
     {
-        gfxDestroyBuffer(gfx_, reservoir_indirect_sample_normal_buffer);
+        DestroyBuffer(gfx_, reservoir_indirect_sample_normal_buffer);
     }
-    gfxDestroyBuffer(gfx_, reservoir_indirect_sample_material_buffer_);
+    DestroyBuffer(gfx_, reservoir_indirect_sample_material_buffer_);
     for (GfxBuffer const &reservoir_indirect_sample_reservoir_buffer :
         reservoir_indirect_sample_reservoir_buffers_)
     {
-        gfxDestroyBuffer(gfx_, reservoir_indirect_sample_reservoir_buffer);
+        DestroyBuffer(gfx_, reservoir_indirect_sample_reservoir_buffer);
     }
 }
 
@@ -870,19 +870,19 @@ void GI1::WorldSpaceReSTIR::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinIn
     {
         for (GfxBuffer const &reservoir_hash_buffer : reservoir_hash_buffers_)
         {
-            gfxDestroyBuffer(gfx_, reservoir_hash_buffer);
+            DestroyBuffer(gfx_, reservoir_hash_buffer);
         }
         for (GfxBuffer const &reservoir_hash_count_buffer : reservoir_hash_count_buffers_)
         {
-            gfxDestroyBuffer(gfx_, reservoir_hash_count_buffer);
+            DestroyBuffer(gfx_, reservoir_hash_count_buffer);
         }
         for (GfxBuffer const &reservoir_hash_index_buffer : reservoir_hash_index_buffers_)
         {
-            gfxDestroyBuffer(gfx_, reservoir_hash_index_buffer);
+            DestroyBuffer(gfx_, reservoir_hash_index_buffer);
         }
         for (GfxBuffer const &reservoir_hash_value_buffer : reservoir_hash_value_buffers_)
         {
-            gfxDestroyBuffer(gfx_, reservoir_hash_value_buffer);
+            DestroyBuffer(gfx_, reservoir_hash_value_buffer);
         }
 
         for (uint32_t i = 0; i < ARRAYSIZE(reservoir_hash_buffers_); ++i)
@@ -890,7 +890,7 @@ void GI1::WorldSpaceReSTIR::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinIn
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_Reservoir_HashBuffer%u", i);
 
-            reservoir_hash_buffers_[i] = gfxCreateBuffer<uint32_t>(gfx_, kConstant_NumEntries);
+            reservoir_hash_buffers_[i] = CreateBuffer<uint32_t>(gfx_, kConstant_NumEntries);
             reservoir_hash_buffers_[i].setName(buffer);
         }
 
@@ -899,7 +899,7 @@ void GI1::WorldSpaceReSTIR::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinIn
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_Reservoir_HashCountBuffer%u", i);
 
-            reservoir_hash_count_buffers_[i] = gfxCreateBuffer<uint32_t>(gfx_, kConstant_NumEntries);
+            reservoir_hash_count_buffers_[i] = CreateBuffer<uint32_t>(gfx_, kConstant_NumEntries);
             reservoir_hash_count_buffers_[i].setName(buffer);
         }
 
@@ -908,7 +908,7 @@ void GI1::WorldSpaceReSTIR::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinIn
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_Reservoir_HashIndexBuffer%u", i);
 
-            reservoir_hash_index_buffers_[i] = gfxCreateBuffer<uint32_t>(gfx_, kConstant_NumEntries);
+            reservoir_hash_index_buffers_[i] = CreateBuffer<uint32_t>(gfx_, kConstant_NumEntries);
             reservoir_hash_index_buffers_[i].setName(buffer);
         }
 
@@ -917,39 +917,39 @@ void GI1::WorldSpaceReSTIR::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinIn
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_Reservoir_HashValueBuffer%u", i);
 
-            reservoir_hash_value_buffers_[i] = gfxCreateBuffer<uint32_t>(gfx_, kConstant_NumEntries);
+            reservoir_hash_value_buffers_[i] = CreateBuffer<uint32_t>(gfx_, kConstant_NumEntries);
             reservoir_hash_value_buffers_[i].setName(buffer);
         }
     }
 
     if (reservoir_hash_list_buffer_.getCount() < max_ray_count)
     {
-        gfxDestroyBuffer(gfx_, reservoir_hash_list_buffer_);
-        gfxDestroyBuffer(gfx_, reservoir_hash_list_count_buffer_);
+        DestroyBuffer(gfx_, reservoir_hash_list_buffer_);
+        DestroyBuffer(gfx_, reservoir_hash_list_count_buffer_);
 
-        reservoir_hash_list_buffer_ = gfxCreateBuffer<uint4>(gfx_, max_ray_count);
+        reservoir_hash_list_buffer_ = CreateBuffer<uint4>(gfx_, max_ray_count);
         reservoir_hash_list_buffer_.setName("Capsaicin_Reservoir_HashListBuffer");
 
-        reservoir_hash_list_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        reservoir_hash_list_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         reservoir_hash_list_count_buffer_.setName("Capsaicin_Reservoir_HashListCountBuffer");
     }
 
     if (reservoir_indirect_sample_buffer_.getCount() < 2 * max_ray_count)
     {
-        gfxDestroyBuffer(gfx_, reservoir_indirect_sample_buffer_);
+        DestroyBuffer(gfx_, reservoir_indirect_sample_buffer_);
         for (GfxBuffer const &reservoir_indirect_sample_normal_buffer :
             reservoir_indirect_sample_normal_buffers_)
         {
-            gfxDestroyBuffer(gfx_, reservoir_indirect_sample_normal_buffer);
+            DestroyBuffer(gfx_, reservoir_indirect_sample_normal_buffer);
         }
-        gfxDestroyBuffer(gfx_, reservoir_indirect_sample_material_buffer_);
+        DestroyBuffer(gfx_, reservoir_indirect_sample_material_buffer_);
         for (GfxBuffer const &reservoir_indirect_sample_reservoir_buffer :
             reservoir_indirect_sample_reservoir_buffers_)
         {
-            gfxDestroyBuffer(gfx_, reservoir_indirect_sample_reservoir_buffer);
+            DestroyBuffer(gfx_, reservoir_indirect_sample_reservoir_buffer);
         }
 
-        reservoir_indirect_sample_buffer_ = gfxCreateBuffer<float4>(gfx_, 2 * max_ray_count);
+        reservoir_indirect_sample_buffer_ = CreateBuffer<float4>(gfx_, 2 * max_ray_count);
         reservoir_indirect_sample_buffer_.setName("Capsaicin_Reservoir_IndirectSampleBuffer");
 
         for (uint32_t i = 0; i < ARRAYSIZE(reservoir_indirect_sample_normal_buffers_); ++i)
@@ -957,11 +957,11 @@ void GI1::WorldSpaceReSTIR::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinIn
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_Reservoir_IndirectSampleNormalBuffer%u", i);
 
-            reservoir_indirect_sample_normal_buffers_[i] = gfxCreateBuffer<uint32_t>(gfx_, 2 * max_ray_count);
+            reservoir_indirect_sample_normal_buffers_[i] = CreateBuffer<uint32_t>(gfx_, 2 * max_ray_count);
             reservoir_indirect_sample_normal_buffers_[i].setName(buffer);
         }
 
-        reservoir_indirect_sample_material_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 2 * max_ray_count);
+        reservoir_indirect_sample_material_buffer_ = CreateBuffer<uint32_t>(gfx_, 2 * max_ray_count);
         reservoir_indirect_sample_material_buffer_.setName(
             "Capsaicin_Reservoir_IndirectSamplerMaterialBuffer");
 
@@ -970,7 +970,7 @@ void GI1::WorldSpaceReSTIR::ensureMemoryIsAllocated([[maybe_unused]] CapsaicinIn
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_Reservoir_IndirectSampleReservoirBuffer%u", i);
 
-            reservoir_indirect_sample_reservoir_buffers_[i] = gfxCreateBuffer<uint4>(gfx_, 2 * max_ray_count);
+            reservoir_indirect_sample_reservoir_buffers_[i] = CreateBuffer<uint4>(gfx_, 2 * max_ray_count);
             reservoir_indirect_sample_reservoir_buffers_[i].setName(buffer);
         }
     }
@@ -993,14 +993,14 @@ GI1::GlossyReflections::~GlossyReflections()
 {
     for (auto const &texture : texture_float_)
     {
-        gfxDestroyTexture(gfx_, texture);
+        DestroyTexture(gfx_, texture);
     }
     for (auto const &texture : texture_float4_)
     {
-        gfxDestroyTexture(gfx_, texture);
+        DestroyTexture(gfx_, texture);
     }
-    gfxDestroyBuffer(gfx_, rt_sample_buffer_);
-    gfxDestroyBuffer(gfx_, rt_sample_count_buffer_);
+    DestroyBuffer(gfx_, rt_sample_buffer_);
+    DestroyBuffer(gfx_, rt_sample_count_buffer_);
 }
 
 void GI1::GlossyReflections::ensureMemoryIsAllocated(CapsaicinInternal const &capsaicin)
@@ -1019,10 +1019,10 @@ void GI1::GlossyReflections::ensureMemoryIsAllocated(CapsaicinInternal const &ca
     if (!specular_buffer_ || specular_buffer_.getWidth() != half_buffer_width
         || specular_buffer_.getHeight() != half_buffer_height)
     {
-        gfxDestroyTexture(gfx_, specular_buffer_);
+        DestroyTexture(gfx_, specular_buffer_);
 
         specular_buffer_ =
-            gfxCreateTexture2D(gfx_, half_buffer_width, half_buffer_height, DXGI_FORMAT_R16G16B16A16_FLOAT);
+            CreateTexture2D(gfx_, half_buffer_width, half_buffer_height, DXGI_FORMAT_R16G16B16A16_FLOAT);
         specular_buffer_.setName("SpecularBuffer");
         gfxCommandClearTexture(gfx_, specular_buffer_);
     }
@@ -1030,34 +1030,34 @@ void GI1::GlossyReflections::ensureMemoryIsAllocated(CapsaicinInternal const &ca
     if (!direction_buffer_ || direction_buffer_.getWidth() != half_buffer_width
         || direction_buffer_.getHeight() != half_buffer_height)
     {
-        gfxDestroyTexture(gfx_, direction_buffer_);
+        DestroyTexture(gfx_, direction_buffer_);
 
         direction_buffer_ =
-            gfxCreateTexture2D(gfx_, half_buffer_width, half_buffer_height, DXGI_FORMAT_R16G16B16A16_FLOAT);
+            CreateTexture2D(gfx_, half_buffer_width, half_buffer_height, DXGI_FORMAT_R16G16B16A16_FLOAT);
         direction_buffer_.setName("DirectionBuffer");
     }
 
     if (!rt_sample_buffer_ || rt_sample_buffer_.getCount() != half_buffer_width * half_buffer_height)
     {
-        gfxDestroyBuffer(gfx_, rt_sample_buffer_);
+        DestroyBuffer(gfx_, rt_sample_buffer_);
 
-        rt_sample_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, half_buffer_width * half_buffer_height);
+        rt_sample_buffer_ = CreateBuffer<uint32_t>(gfx_, half_buffer_width * half_buffer_height);
         rt_sample_buffer_.setName("RtSampleBuffer");
     }
 
     if (!rt_sample_count_buffer_)
     {
-        rt_sample_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        rt_sample_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         rt_sample_count_buffer_.setName("RtSampleCountBuffer");
     }
 
     if (!fireflies_buffer_ || fireflies_buffer_.getWidth() != half_buffer_width
         || fireflies_buffer_.getHeight() != half_buffer_height)
     {
-        gfxDestroyTexture(gfx_, fireflies_buffer_);
+        DestroyTexture(gfx_, fireflies_buffer_);
 
         fireflies_buffer_ =
-            gfxCreateTexture2D(gfx_, half_buffer_width, half_buffer_height, DXGI_FORMAT_R8_SNORM);
+            CreateTexture2D(gfx_, half_buffer_width, half_buffer_height, DXGI_FORMAT_R8_SNORM);
         fireflies_buffer_.setName("FirefliesBuffer");
     }
 
@@ -1065,9 +1065,9 @@ void GI1::GlossyReflections::ensureMemoryIsAllocated(CapsaicinInternal const &ca
     if (!reflections_buffer_ || reflections_buffer_.getWidth() != full_buffer_dimensions.x
         || reflections_buffer_.getHeight() != full_buffer_dimensions.y)
     {
-        gfxDestroyTexture(gfx_, reflections_buffer_);
+        DestroyTexture(gfx_, reflections_buffer_);
 
-        reflections_buffer_ = gfxCreateTexture2D(
+        reflections_buffer_ = CreateTexture2D(
             gfx_, full_buffer_dimensions.x, full_buffer_dimensions.y, DXGI_FORMAT_R16G16B16A16_FLOAT);
         reflections_buffer_.setName("ReflectionsBuffer");
     }
@@ -1075,9 +1075,9 @@ void GI1::GlossyReflections::ensureMemoryIsAllocated(CapsaicinInternal const &ca
     if (!standard_dev_buffer_ || standard_dev_buffer_.getWidth() != full_buffer_dimensions.x
         || standard_dev_buffer_.getHeight() != full_buffer_dimensions.y)
     {
-        gfxDestroyTexture(gfx_, standard_dev_buffer_);
+        DestroyTexture(gfx_, standard_dev_buffer_);
 
-        standard_dev_buffer_ = gfxCreateTexture2D(
+        standard_dev_buffer_ = CreateTexture2D(
             gfx_, full_buffer_dimensions.x, full_buffer_dimensions.y, DXGI_FORMAT_R16G16B16A16_FLOAT);
         standard_dev_buffer_.setName("StandardDevBuffer");
     }
@@ -1108,7 +1108,7 @@ void GI1::GlossyReflections::ensureMemoryIsAllocated(CapsaicinInternal const &ca
         GFX_ASSERTMSG(false, "Unexpected denoiser mode %d...", options.gi1_glossy_reflections_denoiser_mode);
     }
 
-    // BE CAREFUL: we need to call gfxDestroyTexture if temp_buffer_count == 0
+    // BE CAREFUL: we need to call DestroyTexture if temp_buffer_count == 0
     GfxTexture *temp_reflections_buffers[] = {&reflections_buffer0_, &reflections_buffer1_};
     for (uint32_t buffer_index = 0; buffer_index < 2; ++buffer_index)
     {
@@ -1116,7 +1116,7 @@ void GI1::GlossyReflections::ensureMemoryIsAllocated(CapsaicinInternal const &ca
         if (!temp_reflections_buffer || temp_reflections_buffer.getWidth() != temp_buffer_width
             || temp_reflections_buffer.getHeight() != temp_buffer_height)
         {
-            gfxDestroyTexture(gfx_, temp_reflections_buffer);
+            DestroyTexture(gfx_, temp_reflections_buffer);
             temp_reflections_buffer = {};
 
             if (temp_buffer_width > 0 && buffer_index < temp_buffer_count)
@@ -1124,7 +1124,7 @@ void GI1::GlossyReflections::ensureMemoryIsAllocated(CapsaicinInternal const &ca
                 char buffer[64];
                 GFX_SNPRINTF(buffer, sizeof(buffer), "ReflectionsBuffer%u", buffer_index);
 
-                temp_reflections_buffer = gfxCreateTexture2D(
+                temp_reflections_buffer = CreateTexture2D(
                     gfx_, temp_buffer_width, temp_buffer_height, DXGI_FORMAT_R16G16B16A16_FLOAT);
                 temp_reflections_buffer.setName(buffer);
             }
@@ -1139,7 +1139,7 @@ void GI1::GlossyReflections::ensureMemoryIsAllocated(CapsaicinInternal const &ca
         if (!temp_average_squared_buffer || temp_average_squared_buffer.getWidth() != temp_buffer_width
             || temp_average_squared_buffer.getHeight() != temp_buffer_height)
         {
-            gfxDestroyTexture(gfx_, temp_average_squared_buffer);
+            DestroyTexture(gfx_, temp_average_squared_buffer);
             temp_average_squared_buffer = {};
 
             if (temp_buffer_width > 0 && buffer_index < temp_buffer_count)
@@ -1147,7 +1147,7 @@ void GI1::GlossyReflections::ensureMemoryIsAllocated(CapsaicinInternal const &ca
                 char buffer[64];
                 GFX_SNPRINTF(buffer, sizeof(buffer), "AverageSquaredBuffer%u", buffer_index);
 
-                temp_average_squared_buffer = gfxCreateTexture2D(
+                temp_average_squared_buffer = CreateTexture2D(
                     gfx_, temp_buffer_width, temp_buffer_height, DXGI_FORMAT_R16G16B16A16_FLOAT);
                 temp_average_squared_buffer.setName(buffer);
             }
@@ -1164,17 +1164,17 @@ GI1::GIDenoiser::~GIDenoiser()
 {
     for (GfxTexture const &blur_mask : blur_masks_)
     {
-        gfxDestroyTexture(gfx_, blur_mask);
+        DestroyTexture(gfx_, blur_mask);
     }
     for (GfxTexture const &color_buffer : color_buffers_)
     {
-        gfxDestroyTexture(gfx_, color_buffer);
+        DestroyTexture(gfx_, color_buffer);
     }
     for (GfxTexture const &color_delta_buffer : color_delta_buffers_)
     {
-        gfxDestroyTexture(gfx_, color_delta_buffer);
+        DestroyTexture(gfx_, color_delta_buffer);
     }
-    gfxDestroyBuffer(gfx_, blur_sample_count_buffer_);
+    DestroyBuffer(gfx_, blur_sample_count_buffer_);
 }
 
 void GI1::GIDenoiser::ensureMemoryIsAllocated(CapsaicinInternal const &capsaicin)
@@ -1189,10 +1189,10 @@ void GI1::GIDenoiser::ensureMemoryIsAllocated(CapsaicinInternal const &capsaicin
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_GIDenoiser_BlurMask%u", i);
 
-            gfxDestroyTexture(gfx_, blur_masks_[i]);
+            DestroyTexture(gfx_, blur_masks_[i]);
 
             blur_masks_[i] =
-                gfxCreateTexture2D(gfx_, buffer_dimensions.x, buffer_dimensions.y, DXGI_FORMAT_R8_SNORM);
+                CreateTexture2D(gfx_, buffer_dimensions.x, buffer_dimensions.y, DXGI_FORMAT_R8_SNORM);
             blur_masks_[i].setName(buffer);
         }
 
@@ -1201,9 +1201,9 @@ void GI1::GIDenoiser::ensureMemoryIsAllocated(CapsaicinInternal const &capsaicin
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_GIDenoiser_ColorBuffer%u", i);
 
-            gfxDestroyTexture(gfx_, color_buffers_[i]);
+            DestroyTexture(gfx_, color_buffers_[i]);
 
-            color_buffers_[i] = gfxCreateTexture2D(
+            color_buffers_[i] = CreateTexture2D(
                 gfx_, buffer_dimensions.x, buffer_dimensions.y, DXGI_FORMAT_R16G16B16A16_FLOAT);
             color_buffers_[i].setName(buffer);
         }
@@ -1213,17 +1213,17 @@ void GI1::GIDenoiser::ensureMemoryIsAllocated(CapsaicinInternal const &capsaicin
             char buffer[64];
             GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_GIDenoiser_ColorDeltaBuffer%u", i);
 
-            gfxDestroyTexture(gfx_, color_delta_buffers_[i]);
+            DestroyTexture(gfx_, color_delta_buffers_[i]);
 
             color_delta_buffers_[i] =
-                gfxCreateTexture2D(gfx_, buffer_dimensions.x, buffer_dimensions.y, DXGI_FORMAT_R16_FLOAT);
+                CreateTexture2D(gfx_, buffer_dimensions.x, buffer_dimensions.y, DXGI_FORMAT_R16_FLOAT);
             color_delta_buffers_[i].setName(buffer);
         }
     }
 
     if (!blur_sample_count_buffer_)
     {
-        blur_sample_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        blur_sample_count_buffer_ = CreateBuffer<uint32_t>(gfx_, 1);
         blur_sample_count_buffer_.setName("Capsaicin_GIDenoiser_BlurSampleCountBuffer");
     }
 }
@@ -1403,11 +1403,11 @@ DebugViewList GI1::getDebugViews() const noexcept
 
 bool GI1::init(CapsaicinInternal const &capsaicin) noexcept
 {
-    draw_command_buffer_ = gfxCreateBuffer<uint4>(gfx_, 1);
+    draw_command_buffer_ = CreateBuffer<uint4>(gfx_, 1);
     draw_command_buffer_.setName("Capsaicin_DrawCommandBuffer");
 
     dispatch_command_buffer_ =
-        gfxCreateBuffer(gfx_, GFX_MAX(sizeof(DispatchCommand), sizeof(DispatchRaysCommand)));
+        CreateBuffer(gfx_, GFX_MAX(sizeof(DispatchCommand), sizeof(DispatchRaysCommand)));
     dispatch_command_buffer_.setName("Capsaicin_DispatchCommandBuffer");
 
     // Set up the base defines based on available features
@@ -1484,7 +1484,7 @@ bool GI1::init(CapsaicinInternal const &capsaicin) noexcept
     gfxDrawStateSetColorTarget(
         debug_reflection_draw_state, 0, capsaicin.getSharedTexture("Debug").getFormat());
 
-    gi1_program_              = capsaicin.createProgram("render_techniques/gi1/gi1");
+    gi1_program_              = capsaicin.createProgram("render_techniques/gi1/gi1", getName());
     resolve_gi1_kernel_       = gfxCreateGraphicsKernel(gfx_, gi1_program_, resolve_lighting_draw_state,
               "ResolveGI1", base_defines.data(), base_define_count);
     clear_counters_kernel_    = gfxCreateComputeKernel(gfx_, gi1_program_, "ClearCounters");
@@ -2725,7 +2725,7 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
             gfxCommandBindKernel(gfx_, atrous_kernels[0]);
             gfxCommandDispatch(gfx_, num_groups_x, num_groups_y, 1);
 
-            gfxDestroyBuffer(gfx_, glossy_reflections_atrous_constants);
+            DestroyBuffer(gfx_, glossy_reflections_atrous_constants);
         }
 
         for (int pass_index = 1; pass_index < options.gi1_glossy_reflections_atrous_pass_count - 1;
@@ -2759,7 +2759,7 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
                 gfxCommandBindKernel(gfx_, atrous_kernels[1]);
                 gfxCommandDispatch(gfx_, num_groups_x, num_groups_y, 1);
 
-                gfxDestroyBuffer(gfx_, glossy_reflections_atrous_constants);
+                DestroyBuffer(gfx_, glossy_reflections_atrous_constants);
             }
         }
 
@@ -2789,7 +2789,7 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
             gfxCommandBindKernel(gfx_, atrous_kernels[2]);
             gfxCommandDispatch(gfx_, num_groups_x, num_groups_y, 1);
 
-            gfxDestroyBuffer(gfx_, glossy_reflections_atrous_constants);
+            DestroyBuffer(gfx_, glossy_reflections_atrous_constants);
         }
 
         // Unset deleted buffer
@@ -3045,11 +3045,11 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
     }
 
     // Release our constant buffers
-    gfxDestroyBuffer(gfx_, gi1_constants);
-    gfxDestroyBuffer(gfx_, screen_probes_constants);
-    gfxDestroyBuffer(gfx_, hash_grid_cache_constants);
-    gfxDestroyBuffer(gfx_, world_space_restir_constants);
-    gfxDestroyBuffer(gfx_, glossy_reflections_constants);
+    DestroyBuffer(gfx_, gi1_constants);
+    DestroyBuffer(gfx_, screen_probes_constants);
+    DestroyBuffer(gfx_, hash_grid_cache_constants);
+    DestroyBuffer(gfx_, world_space_restir_constants);
+    DestroyBuffer(gfx_, glossy_reflections_constants);
 
     // Flip the buffers
     screen_probes_.probe_buffer_index_ = (1 - screen_probes_.probe_buffer_index_);
@@ -3065,10 +3065,10 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
 
 void GI1::terminate() noexcept
 {
-    gfxDestroyTexture(gfx_, depth_buffer_);
-    gfxDestroyTexture(gfx_, irradiance_buffer_);
-    gfxDestroyBuffer(gfx_, draw_command_buffer_);
-    gfxDestroyBuffer(gfx_, dispatch_command_buffer_);
+    DestroyTexture(gfx_, depth_buffer_);
+    DestroyTexture(gfx_, irradiance_buffer_);
+    DestroyBuffer(gfx_, draw_command_buffer_);
+    DestroyBuffer(gfx_, dispatch_command_buffer_);
 
     gfxDestroyProgram(gfx_, gi1_program_);
     gfxDestroyKernel(gfx_, resolve_gi1_kernel_);
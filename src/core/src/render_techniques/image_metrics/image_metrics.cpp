@@ -69,22 +69,11 @@ bool ImageMetrics::init(CapsaicinInternal const &capsaicin) noexcept
     if (options.image_metrics_enable)
     {
         // Initialise image comparison helpers
-        if (!metricMSE.initialise(capsaicin, GPUImageMetrics::Type::HDR_RGB, GPUImageMetrics::Operation::MSE))
-        {
-            return false;
-        }
-        if (!metricRMAE.initialise(
-                capsaicin, GPUImageMetrics::Type::HDR_RGB, GPUImageMetrics::Operation::RMAE))
-        {
-            return false;
-        }
-        if (!metricSMAPE.initialise(
-                capsaicin, GPUImageMetrics::Type::HDR_RGB, GPUImageMetrics::Operation::SMAPE))
-        {
-            return false;
-        }
-        if (!metricSSIM.initialise(
-                capsaicin, GPUImageMetrics::Type::HDR_RGB, GPUImageMetrics::Operation::SSIM))
+        // All metrics are calculated together using a single pass over the images
+        using Operation = GPUImageMetrics::Operation;
+        if (!metrics.initialise(capsaicin, GPUImageMetrics::Type::HDR_RGB,
+                {Operation::MSE, Operation::RMSE, Operation::PSNR, Operation::RMAE, Operation::SMAPE,
+                    Operation::SSIM}))
         {
             return false;
         }
@@ -148,21 +137,17 @@ void ImageMetrics::render(CapsaicinInternal &capsaicin) noexcept
     options = newOptions;
 
     auto const &colourBuffer = capsaicin.getSharedTexture("Color");
-    metricMSE.compareAsync(colourBuffer, referenceImage);
-    metricRMAE.compareAsync(colourBuffer, referenceImage);
-    metricSMAPE.compareAsync(colourBuffer, referenceImage);
-    metricSSIM.compareAsync(colourBuffer, referenceImage);
+    metrics.compareAsync(colourBuffer, referenceImage);
 
-    if (options.image_metrics_save_to_file && capsaicin.getFrameIndex() > metricMSE.getAsyncDelay())
+    if (options.image_metrics_save_to_file && capsaicin.getFrameIndex() > metrics.getAsyncDelay())
     {
-        auto const mse = static_cast<double>(metricMSE.getMetricValue());
-        // RMSE = sqrt(MSE)
-        double const rmse = sqrt(mse);
-        // PSNR = 20log10(MaxValue) - 10log10(MSE)
-        double const psnr  = -10.0 * log10(mse);
-        auto const   rmae  = static_cast<double>(metricRMAE.getMetricValue());
-        auto const   smape = static_cast<double>(metricSMAPE.getMetricValue());
-        auto const   ssim  = static_cast<double>(metricSSIM.getMetricValue());
+        using Operation  = GPUImageMetrics::Operation;
+        auto const mse   = static_cast<double>(metrics.getMetricValue(Operation::MSE));
+        auto const rmse  = static_cast<double>(metrics.getMetricValue(Operation::RMSE));
+        auto const psnr  = static_cast<double>(metrics.getMetricValue(Operation::PSNR));
+        auto const rmae  = static_cast<double>(metrics.getMetricValue(Operation::RMAE));
+        auto const smape = static_cast<double>(metrics.getMetricValue(Operation::SMAPE));
+        auto const ssim  = static_cast<double>(metrics.getMetricValue(Operation::SSIM));
 
         // Write values to file
         outputFile << std::setprecision(10) << mse << ',' << rmse << ',' << psnr << ',' << rmae << ','
@@ -172,7 +157,7 @@ void ImageMetrics::render(CapsaicinInternal &capsaicin) noexcept
 
 void ImageMetrics::terminate() noexcept
 {
-    gfxDestroyTexture(gfx_, referenceImage);
+    DestroyTexture(gfx_, referenceImage);
     referenceImage = {};
     closeFile();
 }
@@ -184,34 +169,22 @@ void ImageMetrics::renderGUI(CapsaicinInternal &capsaicin) const noexcept
         // Nothing to do as there is no image to compare
         return;
     }
-    double const mse = (capsaicin.getFrameIndex() > metricMSE.getAsyncDelay())
-                         ? static_cast<double>(metricMSE.getMetricValue())
-                         : 0.0;
-    ImGui::Text("PQ-MSE  :  %f", mse);
-    // RMSE = sqrt(MSE)
-    double const rmse = sqrt(mse);
-    ImGui::Text("PQ-RMSE :  %f", rmse);
-    // PSNR = 20log10(MaxValue) - 10log10(MSE)
-    double const psnr = -10.0 * log10(mse);
-    ImGui::Text("PQ-PSNR :  %f", psnr);
-    double const rmae = (capsaicin.getFrameIndex() > metricRMAE.getAsyncDelay())
-                          ? static_cast<double>(metricRMAE.getMetricValue())
-                          : 0.0;
-    ImGui::Text("PQ-RMAE :  %f", rmae);
-    double const smape = (capsaicin.getFrameIndex() > metricSMAPE.getAsyncDelay())
-                           ? static_cast<double>(metricSMAPE.getMetricValue())
-                           : 0.0;
-    ImGui::Text("PQ-SMAPE :  %f", smape);
-    double const ssim = (capsaicin.getFrameIndex() > metricSSIM.getAsyncDelay())
-                          ? static_cast<double>(metricSSIM.getMetricValue())
-                          : 0.0;
-    ImGui::Text("PQ-SSIM :  %f", ssim);
+    bool const hasValues = capsaicin.getFrameIndex() > metrics.getAsyncDelay();
+    auto const getValue  = [&](GPUImageMetrics::Operation const operation) {
+        return hasValues ? static_cast<double>(metrics.getMetricValue(operation)) : 0.0;
+    };
+    ImGui::Text("PQ-MSE  :  %f", getValue(GPUImageMetrics::Operation::MSE));
+    ImGui::Text("PQ-RMSE :  %f", getValue(GPUImageMetrics::Operation::RMSE));
+    ImGui::Text("PQ-PSNR :  %f", getValue(GPUImageMetrics::Operation::PSNR));
+    ImGui::Text("PQ-RMAE :  %f", getValue(GPUImageMetrics::Operation::RMAE));
+    ImGui::Text("PQ-SMAPE :  %f", getValue(GPUImageMetrics::Operation::SMAPE));
+    ImGui::Text("PQ-SSIM :  %f", getValue(GPUImageMetrics::Operation::SSIM));
 }
 
 bool ImageMetrics::loadReferenceImage(CapsaicinInternal const &capsaicin) noexcept
 {
     // Ensure old texture is removed
-    gfxDestroyTexture(gfx_, referenceImage);
+    DestroyTexture(gfx_, referenceImage);
     referenceImage = {};
 
     // Open reference image location
@@ -226,13 +199,13 @@ bool ImageMetrics::loadReferenceImage(CapsaicinInternal const &capsaicin) noexce
             return false;
         }
         GfxConstRef const imageRef = gfxSceneGetObjectHandle<GfxImage>(tempScene, 0);
-        referenceImage = gfxCreateTexture2D(gfx_, imageRef->width, imageRef->height, imageRef->format, 1);
+        referenceImage = CreateTexture2D(gfx_, imageRef->width, imageRef->height, imageRef->format, 1);
         referenceImage.setName(gfxSceneGetObjectMetadata<GfxImage>(tempScene, imageRef).getObjectName());
 
         GfxBuffer const uploadBuffer =
-            gfxCreateBuffer(gfx_, imageRef->data.size(), imageRef->data.data(), kGfxCpuAccess_Write);
+            CreateBuffer(gfx_, imageRef->data.size(), imageRef->data.data(), kGfxCpuAccess_Write);
         gfxCommandCopyBufferToTexture(gfx_, referenceImage, uploadBuffer);
-        gfxDestroyBuffer(gfx_, uploadBuffer);
+        DestroyBuffer(gfx_, uploadBuffer);
         gfxDestroyScene(tempScene);
         return !!referenceImage;
     }
@@ -99,10 +99,7 @@ class ImageMetrics final : public RenderTechnique
     RenderOptions options;
     bool          needsInit = false;
 
-    GPUImageMetrics metricMSE;
-    GPUImageMetrics metricRMAE;
-    GPUImageMetrics metricSMAPE;
-    GPUImageMetrics metricSSIM;
+    GPUImageMetrics metrics; /**< Calculates all metrics in a single batched pass */
     GfxTexture      referenceImage;
 
     std::ofstream outputFile;
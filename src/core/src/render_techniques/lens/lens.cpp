@@ -79,7 +79,7 @@ bool Lens::init(CapsaicinInternal const &capsaicin) noexcept
     if (options.lens_chromatic_enable || options.lens_vignette_enable || options.lens_film_grain_enable)
     {
         // Create kernels
-        lensProgram = capsaicin.createProgram("render_techniques/lens/lens");
+        lensProgram = capsaicin.createProgram("render_techniques/lens/lens", getName());
 
         return initLens(capsaicin);
     }
@@ -182,7 +182,7 @@ void Lens::terminate() noexcept
     lensMapKernel = {};
     gfxDestroyProgram(gfx_, lensProgram);
     lensProgram = {};
-    gfxDestroyTexture(gfx_, chromaticAberrationTexture);
+    DestroyTexture(gfx_, chromaticAberrationTexture);
     chromaticAberrationTexture = {};
 }
 
@@ -256,7 +256,7 @@ bool Lens::initLens(CapsaicinInternal const &capsaicin) noexcept
     }
     else
     {
-        gfxDestroyTexture(gfx_, chromaticAberrationTexture);
+        DestroyTexture(gfx_, chromaticAberrationTexture);
         chromaticAberrationTexture = {};
     }
     if (options.lens_vignette_enable)
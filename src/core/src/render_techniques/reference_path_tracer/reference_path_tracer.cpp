@@ -104,12 +104,12 @@ SharedTextureList ReferencePT::getSharedTextures() const noexcept
 
 bool ReferencePT::init(CapsaicinInternal const &capsaicin) noexcept
 {
-    rayCameraData = gfxCreateBuffer<RayCamera>(gfx_, 1, nullptr, kGfxCpuAccess_Write);
+    rayCameraData = CreateBuffer<RayCamera>(gfx_, 1, nullptr, kGfxCpuAccess_Write);
     rayCameraData.setName("Capsaicin_PT_RayCamera");
     accumulationBuffer =
         capsaicin.createRenderTexture(DXGI_FORMAT_R32G32B32A32_FLOAT, "PT_AccumulationBuffer");
 
-    reference_pt_program_ = capsaicin.createProgram(getProgramName());
+    reference_pt_program_ = capsaicin.createProgram(getProgramName(), getName());
     return initKernels(capsaicin);
 }
 
@@ -215,9 +215,9 @@ void ReferencePT::render(CapsaicinInternal &capsaicin) noexcept
 
 void ReferencePT::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx_, rayCameraData);
+    DestroyBuffer(gfx_, rayCameraData);
     rayCameraData = {};
-    gfxDestroyTexture(gfx_, accumulationBuffer);
+    DestroyTexture(gfx_, accumulationBuffer);
     accumulationBuffer = {};
 
     gfxDestroyProgram(gfx_, reference_pt_program_);
@@ -70,7 +70,7 @@ bool Skybox::init(CapsaicinInternal const &capsaicin) noexcept
     gfxDrawStateSetDepthWriteMask(skybox_draw_state, D3D12_DEPTH_WRITE_MASK_ZERO);
     gfxDrawStateSetDepthFunction(skybox_draw_state, D3D12_COMPARISON_FUNC_GREATER);
 
-    skybox_program_ = capsaicin.createProgram("render_techniques/skybox/skybox");
+    skybox_program_ = capsaicin.createProgram("render_techniques/skybox/skybox", getName());
     skybox_kernel_  = gfxCreateGraphicsKernel(gfx_, skybox_program_, skybox_draw_state);
     return !!skybox_program_;
 }
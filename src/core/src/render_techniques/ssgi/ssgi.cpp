@@ -203,7 +203,7 @@ void SSGI::render(CapsaicinInternal &capsaicin) noexcept
     }
 
     // Release our constant buffer
-    gfxDestroyBuffer(gfx_, ssgi_constant_buffer);
+    DestroyBuffer(gfx_, ssgi_constant_buffer);
 }
 
 void SSGI::terminate() noexcept
@@ -225,7 +225,7 @@ void SSGI::initializeKernels(CapsaicinInternal const &capsaicin)
     std::vector const               unroll_defines {"UNROLL_SLICE_LOOP", "UNROLL_STEP_LOOP"};
 
     // Kernels
-    ssgi_program_ = capsaicin.createProgram("render_techniques/ssgi/ssgi");
+    ssgi_program_ = capsaicin.createProgram("render_techniques/ssgi/ssgi", getName());
     {
         std::vector<char const *> defines;
         defines.insert(defines.cend(), global_defines.cbegin(), global_defines.cend());
@@ -241,9 +241,9 @@ void SSGI::initializeKernels(CapsaicinInternal const &capsaicin)
     }
 
     // Debug kernels
-    debug_occlusion_program_   = capsaicin.createProgram("render_techniques/ssgi/ssgi_debug");
+    debug_occlusion_program_   = capsaicin.createProgram("render_techniques/ssgi/ssgi_debug", getName());
     debug_occlusion_kernel_    = gfxCreateComputeKernel(gfx_, debug_occlusion_program_, "DebugOcclusion");
-    debug_bent_normal_program_ = capsaicin.createProgram("render_techniques/ssgi/ssgi_debug");
+    debug_bent_normal_program_ = capsaicin.createProgram("render_techniques/ssgi/ssgi_debug", getName());
     debug_bent_normal_kernel_  = gfxCreateComputeKernel(gfx_, debug_bent_normal_program_, "DebugBentNormal");
 }
 
@@ -69,7 +69,7 @@ bool TAA::init(CapsaicinInternal const &capsaicin) noexcept
     {
         defines.push_back("HAS_GLOBAL_ILLUMINATION_BUFFER");
     }
-    taa_program_             = capsaicin.createProgram("render_techniques/taa/taa");
+    taa_program_             = capsaicin.createProgram("render_techniques/taa/taa", getName());
     resolve_temporal_kernel_ = gfxCreateComputeKernel(
         gfx_, taa_program_, "ResolveTemporal", defines.data(), static_cast<uint32_t>(defines.size()));
     update_history_kernel_ = gfxCreateComputeKernel(gfx_, taa_program_, "UpdateHistory");
@@ -160,7 +160,7 @@ void TAA::terminate() noexcept
 {
     for (GfxTexture const &color_buffer : color_buffers_)
     {
-        gfxDestroyTexture(gfx_, color_buffer);
+        DestroyTexture(gfx_, color_buffer);
     }
 
     gfxDestroyProgram(gfx_, taa_program_);
@@ -87,7 +87,8 @@ bool ToneMapping::init(CapsaicinInternal const &capsaicin) noexcept
     if (options.tonemap_enable)
     {
         // Create kernels
-        toneMappingProgram = capsaicin.createProgram("render_techniques/tone_mapping/tone_mapping");
+        toneMappingProgram =
+            capsaicin.createProgram("render_techniques/tone_mapping/tone_mapping", getName());
 
         return initToneMapKernel();
     }
@@ -45,7 +45,7 @@ SharedTextureList VarianceEstimate::getSharedTextures() const noexcept
 
 bool VarianceEstimate::init(CapsaicinInternal const &capsaicin) noexcept
 {
-    result_buffer_ = gfxCreateBuffer<float>(gfx_, 1);
+    result_buffer_ = CreateBuffer<float>(gfx_, 1);
     result_buffer_.setName("Capsaicin_ResultBuffer");
 
     for (uint32_t i = 0; i < ARRAYSIZE(readback_buffers_); ++i)
@@ -53,12 +53,12 @@ bool VarianceEstimate::init(CapsaicinInternal const &capsaicin) noexcept
         char buffer[64];
         GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_ReadbackBuffer%u", i);
 
-        readback_buffers_[i] = gfxCreateBuffer<float>(gfx_, 1, nullptr, kGfxCpuAccess_Read);
+        readback_buffers_[i] = CreateBuffer<float>(gfx_, 1, nullptr, kGfxCpuAccess_Read);
         readback_buffers_[i].setName(buffer);
     }
 
     variance_estimate_program_ =
-        capsaicin.createProgram("render_techniques/variance_estimate/variance_estimate");
+        capsaicin.createProgram("render_techniques/variance_estimate/variance_estimate", getName());
     compute_mean_kernel_      = gfxCreateComputeKernel(gfx_, variance_estimate_program_, "ComputeMean");
     compute_distance_kernel_  = gfxCreateComputeKernel(gfx_, variance_estimate_program_, "ComputeDistance");
     compute_deviation_kernel_ = gfxCreateComputeKernel(gfx_, variance_estimate_program_, "ComputeDeviation");
@@ -83,17 +83,17 @@ void VarianceEstimate::render(CapsaicinInternal &capsaicin) noexcept
 
     if (mean_buffer_.getCount() != elem_count)
     {
-        gfxDestroyBuffer(gfx_, mean_buffer_);
+        DestroyBuffer(gfx_, mean_buffer_);
 
-        mean_buffer_ = gfxCreateBuffer<float>(gfx_, elem_count);
+        mean_buffer_ = CreateBuffer<float>(gfx_, elem_count);
         mean_buffer_.setName("Capsaicin_MeanBuffer");
     }
 
     if (square_buffer_.getCount() != elem_count)
     {
-        gfxDestroyBuffer(gfx_, square_buffer_);
+        DestroyBuffer(gfx_, square_buffer_);
 
-        square_buffer_ = gfxCreateBuffer<float>(gfx_, elem_count);
+        square_buffer_ = CreateBuffer<float>(gfx_, elem_count);
         square_buffer_.setName("Capsaicin_SquareBuffer");
     }
 
@@ -153,16 +153,16 @@ void VarianceEstimate::render(CapsaicinInternal &capsaicin) noexcept
 
 void VarianceEstimate::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx_, mean_buffer_);
+    DestroyBuffer(gfx_, mean_buffer_);
     mean_buffer_ = {};
-    gfxDestroyBuffer(gfx_, square_buffer_);
+    DestroyBuffer(gfx_, square_buffer_);
     square_buffer_ = {};
-    gfxDestroyBuffer(gfx_, result_buffer_);
+    DestroyBuffer(gfx_, result_buffer_);
     result_buffer_ = {};
 
     for (GfxBuffer &readback_buffer : readback_buffers_)
     {
-        gfxDestroyBuffer(gfx_, readback_buffer);
+        DestroyBuffer(gfx_, readback_buffer);
         readback_buffer = {};
     }
 
@@ -122,7 +122,7 @@ bool VisibilityBuffer::init(CapsaicinInternal const &capsaicin) noexcept
     {
         // Initialise disocclusion program
         disocclusion_mask_program_ =
-            capsaicin.createProgram("render_techniques/visibility_buffer/disocclusion_mask");
+            capsaicin.createProgram("render_techniques/visibility_buffer/disocclusion_mask", getName());
         disocclusion_mask_kernel_ = gfxCreateComputeKernel(gfx_, disocclusion_mask_program_);
     }
 
@@ -157,7 +157,7 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
 
         initKernel(capsaicin);
 
-        gfxDestroyBuffer(gfx_, constants_buffer);
+        DestroyBuffer(gfx_, constants_buffer);
         constants_buffer = {};
     }
 
@@ -180,8 +180,8 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
                 }
             }
             drawCount = static_cast<uint32_t>(drawData.size());
-            gfxDestroyBuffer(gfx_, draw_data_buffer);
-            draw_data_buffer = gfxCreateBuffer<DrawData>(gfx_, drawCount, drawData.data());
+            DestroyBuffer(gfx_, draw_data_buffer);
+            draw_data_buffer = CreateBuffer<DrawData>(gfx_, drawCount, drawData.data());
         }
 
         {
@@ -209,8 +209,8 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
             constants.projection0011 =
                 float2(cameraMatrices.projection[0][0], cameraMatrices.projection[1][1]);
             constants.view = cameraMatrices.view;
-            gfxDestroyBuffer(gfx_, constants_buffer);
-            constants_buffer = gfxCreateBuffer<DrawConstants>(gfx_, 1, &constants);
+            DestroyBuffer(gfx_, constants_buffer);
+            constants_buffer = CreateBuffer<DrawConstants>(gfx_, 1, &constants);
         }
     }
 
@@ -284,8 +284,8 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
             if (auto packedDrawSize = glm::max(drawCount >> 5, 1U);
                 !meshlet_visibility_buffer || meshlet_visibility_buffer.getSize() < packedDrawSize)
             {
-                gfxDestroyBuffer(gfx_, meshlet_visibility_buffer);
-                meshlet_visibility_buffer = gfxCreateBuffer<uint32_t>(gfx_, packedDrawSize);
+                DestroyBuffer(gfx_, meshlet_visibility_buffer);
+                meshlet_visibility_buffer = CreateBuffer<uint32_t>(gfx_, packedDrawSize);
                 gfxCommandClearBuffer(gfx_, meshlet_visibility_buffer, 0);
             }
 
@@ -364,8 +364,8 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
                 float2(cameraMatrices.projection[2][0] * static_cast<float>(bufferDimensions.x),
                     cameraMatrices.projection[2][1] * static_cast<float>(bufferDimensions.y))
                     * 0.5F};
-            gfxDestroyBuffer(gfx_, constants_buffer);
-            constants_buffer = gfxCreateBuffer<DrawConstantsRT>(gfx_, 1, &constants);
+            DestroyBuffer(gfx_, constants_buffer);
+            constants_buffer = CreateBuffer<DrawConstantsRT>(gfx_, 1, &constants);
         }
 
         // Render using ray tracing pass
@@ -466,8 +466,8 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
             gfxCommandBindKernel(gfx_, visibility_buffer_kernel_);
             gfxCommandDispatch(gfx_, num_groups_x, num_groups_y, 1);
         }
-        gfxDestroyBuffer(gfx_, cameraMatrixBuffer);
-        gfxDestroyBuffer(gfx_, cameraPrevMatrixBuffer);
+        DestroyBuffer(gfx_, cameraMatrixBuffer);
+        DestroyBuffer(gfx_, cameraPrevMatrixBuffer);
         // Copy The F32 VisibilityDepth into D32 Depth buffer for later passes
         gfxCommandCopyTexture(
             gfx_, capsaicin.getSharedTexture("Depth"), capsaicin.getSharedTexture("VisibilityDepth"));
@@ -519,7 +519,8 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
             gfxDestroySbt(gfx_, debug_sbt);
             debug_sbt = {};
 
-            debug_program = capsaicin.createProgram("render_techniques/visibility_buffer/debug_meshlets");
+            debug_program =
+                capsaicin.createProgram("render_techniques/visibility_buffer/debug_meshlets", getName());
 
             GfxDrawState const debug_state;
             gfxDrawStateSetCullMode(debug_state, D3D12_CULL_MODE_NONE);
@@ -573,7 +574,8 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
             gfxDestroySbt(gfx_, debug_sbt);
             debug_sbt = {};
 
-            debug_program = capsaicin.createProgram("render_techniques/visibility_buffer/debug_wireframe");
+            debug_program =
+                capsaicin.createProgram("render_techniques/visibility_buffer/debug_wireframe", getName());
 
             GfxDrawState const debug_state;
             gfxDrawStateSetCullMode(debug_state, D3D12_CULL_MODE_NONE);
@@ -625,7 +627,8 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
             gfxDestroySbt(gfx_, debug_sbt);
             debug_sbt = {};
 
-            debug_program = capsaicin.createProgram("render_techniques/visibility_buffer/debug_velocity");
+            debug_program =
+                capsaicin.createProgram("render_techniques/visibility_buffer/debug_velocity", getName());
 
             GfxDrawState const debug_state;
             gfxDrawStateSetColorTarget(debug_state, 0, capsaicin.getSharedTexture("Debug").getFormat());
@@ -648,7 +651,8 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
             gfxDestroySbt(gfx_, debug_sbt);
             debug_sbt = {};
 
-            debug_program = capsaicin.createProgram("render_techniques/visibility_buffer/debug_material");
+            debug_program =
+                capsaicin.createProgram("render_techniques/visibility_buffer/debug_material", getName());
 
             GfxDrawState const debug_material_draw_state;
             gfxDrawStateSetColorTarget(
@@ -705,7 +709,8 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
             gfxDestroySbt(gfx_, debug_sbt);
             debug_sbt = {};
 
-            debug_program = capsaicin.createProgram("render_techniques/visibility_buffer/debug_dxr10");
+            debug_program =
+                capsaicin.createProgram("render_techniques/visibility_buffer/debug_dxr10", getName());
             // Associate space1 with local root signature for MyHitGroup
             GfxLocalRootSignatureAssociation local_root_signature_associations[] = {
                 {1, kGfxShaderGroupType_Hit, "MyHitGroup"}
@@ -780,13 +785,13 @@ void VisibilityBuffer::terminate() noexcept
     debug_sbt          = {};
     debug_program_view = "";
 
-    gfxDestroyBuffer(gfx_, draw_data_buffer);
+    DestroyBuffer(gfx_, draw_data_buffer);
     draw_data_buffer = {};
-    gfxDestroyBuffer(gfx_, constants_buffer);
+    DestroyBuffer(gfx_, constants_buffer);
     constants_buffer = {};
-    gfxDestroyBuffer(gfx_, meshlet_visibility_buffer);
+    DestroyBuffer(gfx_, meshlet_visibility_buffer);
     meshlet_visibility_buffer = {};
-    gfxDestroyTexture(gfx_, depth_pyramid);
+    DestroyTexture(gfx_, depth_pyramid);
     depth_pyramid = {};
     gfxDestroySamplerState(gfx_, depth_pyramid_sampler);
     depth_pyramid_sampler = {};
@@ -850,7 +855,7 @@ bool VisibilityBuffer::initKernel(CapsaicinInternal const &capsaicin) noexcept
             visibility_buffer_draw_state, capsaicin.getSharedTexture("Depth").getFormat());
 
         visibility_buffer_program_ =
-            capsaicin.createProgram("render_techniques/visibility_buffer/visibility_buffer");
+            capsaicin.createProgram("render_techniques/visibility_buffer/visibility_buffer", getName());
         visibility_buffer_kernel_ = gfxCreateMeshKernel(gfx_, visibility_buffer_program_,
             visibility_buffer_draw_state, nullptr, defines.data(), static_cast<uint32_t>(defines.size()));
     }
@@ -876,7 +881,7 @@ bool VisibilityBuffer::initKernel(CapsaicinInternal const &capsaicin) noexcept
             defines.push_back("DISABLE_ALPHA_TESTING");
         }
         visibility_buffer_program_ =
-            capsaicin.createProgram("render_techniques/visibility_buffer/visibility_buffer_rt");
+            capsaicin.createProgram("render_techniques/visibility_buffer/visibility_buffer_rt", getName());
         if (options.visibility_buffer_use_rt_dxr10)
         {
             std::vector exports = {
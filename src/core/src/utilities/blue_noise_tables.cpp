@@ -0,0 +1,305 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "blue_noise_tables.h"
+
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <span>
+
+namespace Capsaicin
+{
+namespace
+{
+/** How the values of a table are stored */
+enum class Encoding : uint32_t
+{
+    Raw       = 0, /**< Values stored consecutively */
+    RunLength = 1, /**< Pairs of 8bit run length (minus 1) followed by the repeated value */
+};
+
+/** File header, all values are little endian */
+struct FileHeader
+{
+    uint32_t magic              = BlueNoiseTables::kMagic;
+    uint32_t version            = BlueNoiseTables::kVersion;
+    uint32_t sampleCount        = 0;
+    uint32_t dimensionCount     = 0;
+    uint32_t tileSize           = 0;
+    uint32_t tileDimensionCount = 0;
+};
+
+/** Header preceding the data of each table, table data is padded to a multiple of 4 bytes */
+struct TableHeader
+{
+    Encoding encoding    = Encoding::Raw;
+    uint32_t valueSize   = 0; /**< Size of each value in bytes (1, 2 or 4) */
+    uint32_t count       = 0; /**< Number of values */
+    uint32_t encodedSize = 0; /**< Size of the table data in bytes (not including padding) */
+};
+
+uint32_t GetValueSize(uint32_t const valueBits) noexcept
+{
+    return valueBits <= 8 ? 1 : valueBits <= 16 ? 2 : 4;
+}
+
+uint32_t ReadValue(std::byte const *data, uint32_t const valueSize) noexcept
+{
+    uint32_t value = 0;
+    std::memcpy(&value, data, valueSize);
+    return value;
+}
+
+void WriteValue(std::vector<std::byte> &data, uint32_t const value, uint32_t const valueSize)
+{
+    auto const *bytes = reinterpret_cast<std::byte const *>(&value);
+    data.insert(data.end(), bytes, bytes + valueSize);
+}
+
+/**
+ * Decodes a table.
+ * @param data   The remaining file data, advanced past the table on success.
+ * @param values Output decoded values.
+ * @return True if successful, False if the data is invalid.
+ */
+bool DecodeTable(std::span<std::byte const> &data, std::vector<uint32_t> &values)
+{
+    TableHeader header;
+    if (data.size() < sizeof(header))
+    {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    size_t const paddedSize = (static_cast<size_t>(header.encodedSize) + 3) & ~size_t {3};
+    if (data.size() - sizeof(header) < paddedSize
+        || (header.valueSize != 1 && header.valueSize != 2 && header.valueSize != 4))
+    {
+        return false;
+    }
+    std::span<std::byte const> const encoded = data.subspan(sizeof(header), header.encodedSize);
+    data                                     = data.subspan(sizeof(header) + paddedSize);
+    values.resize(header.count);
+    if (header.encoding == Encoding::Raw)
+    {
+        if (encoded.size() != static_cast<size_t>(header.count) * header.valueSize)
+        {
+            return false;
+        }
+        if (header.valueSize == sizeof(uint32_t))
+        {
+            std::memcpy(values.data(), encoded.data(), encoded.size());
+            return true;
+        }
+        for (uint32_t i = 0; i < header.count; ++i)
+        {
+            values[i] = ReadValue(&encoded[static_cast<size_t>(i) * header.valueSize], header.valueSize);
+        }
+        return true;
+    }
+    if (header.encoding == Encoding::RunLength)
+    {
+        size_t const runSize = 1 + header.valueSize;
+        size_t       offset  = 0;
+        uint32_t     index   = 0;
+        for (; offset + runSize <= encoded.size(); offset += runSize)
+        {
+            uint32_t const runLength = std::to_integer<uint32_t>(encoded[offset]) + 1;
+            if (runLength > header.count - index)
+            {
+                return false;
+            }
+            std::fill_n(values.begin() + index, runLength, ReadValue(&encoded[offset + 1], header.valueSize));
+            index += runLength;
+        }
+        return index == header.count && offset == encoded.size();
+    }
+    return false;
+}
+
+/**
+ * Encodes a table and appends it to the file data.
+ * @param values    The values to encode.
+ * @param valueSize Size of each value in bytes.
+ * @param compress  True to use run-length encoding if it reduces the size of the table.
+ * @param data      The file data.
+ */
+void EncodeTable(std::vector<uint32_t> const &values, uint32_t const valueSize, bool const compress,
+    std::vector<std::byte> &data)
+{
+    std::vector<std::byte> encoded;
+    TableHeader            header;
+    header.valueSize = valueSize;
+    header.count     = static_cast<uint32_t>(values.size());
+    if (compress)
+    {
+        for (size_t i = 0; i < values.size();)
+        {
+            size_t runEnd = i + 1;
+            while (runEnd < values.size() && runEnd - i < 256 && values[runEnd] == values[i])
+            {
+                ++runEnd;
+            }
+            encoded.push_back(static_cast<std::byte>(runEnd - i - 1));
+            WriteValue(encoded, values[i], valueSize);
+            i = runEnd;
+        }
+        header.encoding = Encoding::RunLength;
+    }
+    if (!compress || encoded.size() >= values.size() * valueSize)
+    {
+        encoded.clear();
+        for (uint32_t const value : values)
+        {
+            WriteValue(encoded, value, valueSize);
+        }
+        header.encoding = Encoding::Raw;
+    }
+    header.encodedSize = static_cast<uint32_t>(encoded.size());
+    auto const *headerBytes = reinterpret_cast<std::byte const *>(&header);
+    data.insert(data.end(), headerBytes, headerBytes + sizeof(header));
+    data.insert(data.end(), encoded.cbegin(), encoded.cend());
+    data.resize((data.size() + 3) & ~size_t {3}, std::byte {0});
+}
+} // unnamed namespace
+
+bool BlueNoiseTables::isValid() const noexcept
+{
+    size_t const tileValueCount = static_cast<size_t>(tileSize) * tileSize * tileDimensionCount;
+    bool const   validSizes     = std::has_single_bit(sampleCount) && std::has_single_bit(dimensionCount)
+                         && std::has_single_bit(tileSize) && tileDimensionCount > 0
+                         && sobol.size() == static_cast<size_t>(sampleCount) * dimensionCount
+                         && rankingTile.size() == tileValueCount && scramblingTile.size() == tileValueCount;
+    if (!validSizes)
+    {
+        return false;
+    }
+    // Sample values and scrambling keys share the same bit count, ranking keys xor the sample index
+    auto const inRange = [this](uint32_t const value) { return value < sampleCount; };
+    return std::ranges::all_of(sobol, inRange) && std::ranges::all_of(rankingTile, inRange)
+        && std::ranges::all_of(scramblingTile, inRange);
+}
+
+uint32_t BlueNoiseTables::getValueBits() const noexcept
+{
+    return static_cast<uint32_t>(std::countr_zero(sampleCount));
+}
+
+bool BlueNoiseTables::load(std::filesystem::path const &filePath) noexcept
+{
+    try
+    {
+        MappedFile file;
+        if (!file.open(filePath))
+        {
+            return false;
+        }
+        std::span<std::byte const> data = file.getData();
+        if (!readHeader(data))
+        {
+            return false;
+        }
+        data = data.subspan(sizeof(FileHeader));
+        if (!DecodeTable(data, sobol) || !DecodeTable(data, rankingTile)
+            || !DecodeTable(data, scramblingTile))
+        {
+            return false;
+        }
+        return isValid();
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool BlueNoiseTables::loadHeader(std::filesystem::path const &filePath) noexcept
+{
+    try
+    {
+        MappedFile file;
+        return file.open(filePath) && readHeader(file.getData());
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool BlueNoiseTables::readHeader(std::span<std::byte const> const data) noexcept
+{
+    FileHeader header;
+    if (data.size() < sizeof(header))
+    {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion || !std::has_single_bit(header.sampleCount)
+        || !std::has_single_bit(header.dimensionCount) || !std::has_single_bit(header.tileSize)
+        || header.tileDimensionCount == 0)
+    {
+        return false;
+    }
+    sampleCount        = header.sampleCount;
+    dimensionCount     = header.dimensionCount;
+    tileSize           = header.tileSize;
+    tileDimensionCount = header.tileDimensionCount;
+    return true;
+}
+
+bool BlueNoiseTables::save(std::filesystem::path const &filePath, bool const compress) const noexcept
+{
+    try
+    {
+        if (!isValid())
+        {
+            return false;
+        }
+        FileHeader header;
+        header.sampleCount        = sampleCount;
+        header.dimensionCount     = dimensionCount;
+        header.tileSize           = tileSize;
+        header.tileDimensionCount = tileDimensionCount;
+        std::vector<std::byte> data(sizeof(header));
+        std::memcpy(data.data(), &header, sizeof(header));
+        uint32_t const valueSize = GetValueSize(getValueBits());
+        EncodeTable(sobol, valueSize, compress, data);
+        EncodeTable(rankingTile, valueSize, compress, data);
+        EncodeTable(scramblingTile, valueSize, compress, data);
+
+        std::ofstream file(filePath, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file.write(reinterpret_cast<char const *>(data.data()), static_cast<std::streamsize>(data.size()));
+        return file.good();
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+} // namespace Capsaicin
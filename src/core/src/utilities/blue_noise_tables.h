@@ -0,0 +1,100 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Sample tables used by the BlueNoiseSampler component (Heitz et al. 2019, "A Low-Discrepancy Sampler that
+ * Distributes Monte Carlo Errors as a Blue Noise in Screen Space").
+ * Tables are stored on disk in a compact binary file, each value uses the smallest integer size able to hold
+ * it and tables can optionally be run-length encoded. Values are expanded to 32bit for use on the GPU.
+ */
+class BlueNoiseTables
+{
+public:
+    static constexpr uint32_t kMagic   = 0x534E4243; /**< 'CBNS' */
+    static constexpr uint32_t kVersion = 1;
+
+    /** Default file name, relative to the shader source directory */
+    static constexpr char const *kDefaultFile =
+        "components/blue_noise_sampler/blue_noise_sampler_samples.bin";
+
+    uint32_t sampleCount        = 0; /**< Number of samples in the sequence (power of 2) */
+    uint32_t dimensionCount     = 0; /**< Number of dimensions in the sequence (power of 2) */
+    uint32_t tileSize           = 0; /**< Width and height of the ranking and scrambling tiles (power of 2) */
+    uint32_t tileDimensionCount = 0; /**< Number of optimised dimensions in each tile pixel */
+
+    std::vector<uint32_t> sobol;          /**< Owen scrambled Sobol sequence, dimensions are consecutive */
+    std::vector<uint32_t> rankingTile;    /**< Per pixel sample index xor keys */
+    std::vector<uint32_t> scramblingTile; /**< Per pixel sample value xor keys */
+
+    /**
+     * Checks if the table dimensions are valid and each table holds the required number of values within
+     * the valid range (so that all values can be safely used as indexes on the GPU).
+     * @return True if valid, False otherwise.
+     */
+    [[nodiscard]] bool isValid() const noexcept;
+
+    /**
+     * Gets the number of bits used by each sample value.
+     * @return The bit count (the sequence uses 1 value per sample so this is log2(sampleCount)).
+     */
+    [[nodiscard]] uint32_t getValueBits() const noexcept;
+
+    /**
+     * Loads tables from a file, the file is memory mapped and decoded directly into each table.
+     * @param filePath Full pathname to the file to load.
+     * @return True if successful, False otherwise.
+     */
+    bool load(std::filesystem::path const &filePath) noexcept;
+
+    /**
+     * Loads only the table dimensions from a file, used to validate a file without decoding its tables.
+     * @param filePath Full pathname to the file to load.
+     * @return True if the file exists and its header is valid, False otherwise.
+     */
+    bool loadHeader(std::filesystem::path const &filePath) noexcept;
+
+    /**
+     * Saves the tables to a file.
+     * @param filePath Full pathname to the file to save as.
+     * @param compress True to run-length encode tables where this reduces their size.
+     * @return True if successful, False otherwise.
+     */
+    [[nodiscard]] bool save(std::filesystem::path const &filePath, bool compress) const noexcept;
+
+private:
+    /**
+     * Reads and validates the file header, setting the table dimensions.
+     * @param data The file contents.
+     * @return True if the header is valid, False otherwise.
+     */
+    bool readHeader(std::span<std::byte const> data) noexcept;
+};
+} // namespace Capsaicin
@@ -21,7 +21,7 @@ THE SOFTWARE.
 ********************************************************************/
 #pragma once
 
-#include <gfx.h>
+#include "gpu_memory.h"
 
 namespace Capsaicin
 {
@@ -62,6 +62,6 @@ class BufferView
     }
 
     /** Destructor. */
-    ~BufferView() noexcept { gfxDestroyBuffer(gfx, buffer); }
+    ~BufferView() noexcept { DestroyBuffer(gfx, buffer); }
 };
 } // namespace Capsaicin
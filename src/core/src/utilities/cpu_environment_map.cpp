@@ -0,0 +1,416 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_environment_map.h"
+
+#include "cpu_mip.h"
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+
+namespace Capsaicin
+{
+using Vector = CPUEnvironmentMap::Vector;
+
+namespace
+{
+constexpr float kPi = std::numbers::pi_v<float>;
+
+/** Minimum number of texels processed by each task */
+constexpr uint64_t kGrainTexels = 4096;
+
+/** Maximum number of bilinear samples along each axis used to generate a single cube map texel */
+constexpr uint32_t kMaxSupersampling = 8;
+
+float Dot(Vector const &a, Vector const &b) noexcept
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Vector Normalise(Vector const &a) noexcept
+{
+    float const scale = 1.0F / std::sqrt(Dot(a, a));
+    return {a[0] * scale, a[1] * scale, a[2] * scale};
+}
+
+/**
+ * Gets the position within the equirectangular source image of a direction.
+ * The source is mapped with the x and z axes mirrored relative to cube map lookups, this matches the
+ * orientation of environment cube maps previously rendered on the GPU.
+ */
+void GetSourcePosition(Vector const &direction, float &u, float &v) noexcept
+{
+    u = std::atan2(-direction[2], -direction[0]) / (2.0F * kPi) + 0.5F;
+    v = 1.0F - std::acos(std::clamp(direction[1], -1.0F, 1.0F)) / kPi;
+}
+
+/** Position of a direction on a cube map face, uses the same face selection as hardware cube map lookups */
+struct CubeMapPosition
+{
+    uint32_t face = 0;
+    float    u    = 0.0F;
+    float    v    = 0.0F;
+};
+
+CubeMapPosition GetCubeMapPosition(Vector const &direction) noexcept
+{
+    float const x = std::abs(direction[0]);
+    float const y = std::abs(direction[1]);
+    float const z = std::abs(direction[2]);
+    float       majorAxis;
+    float       s;
+    float       t;
+    uint32_t    face;
+    if (x >= y && x >= z)
+    {
+        majorAxis = x;
+        face      = direction[0] >= 0.0F ? 0 : 1;
+        s         = direction[0] >= 0.0F ? -direction[2] : direction[2];
+        t         = -direction[1];
+    }
+    else if (y >= z)
+    {
+        majorAxis = y;
+        face      = direction[1] >= 0.0F ? 2 : 3;
+        s         = direction[0];
+        t         = direction[1] >= 0.0F ? direction[2] : -direction[2];
+    }
+    else
+    {
+        majorAxis = z;
+        face      = direction[2] >= 0.0F ? 4 : 5;
+        s         = direction[2] >= 0.0F ? direction[0] : -direction[0];
+        t         = -direction[1];
+    }
+    return {face, 0.5F * (s / majorAxis + 1.0F), 0.5F * (t / majorAxis + 1.0F)};
+}
+
+/** Gets the offset (in values) of a mip level within RGBA float cube map data */
+size_t GetLevelOffset(uint32_t const size, uint32_t const mip) noexcept
+{
+    size_t offset = 0;
+    for (uint32_t i = 0; i < mip; ++i)
+    {
+        size_t const levelSize = std::max(size >> i, 1U);
+        offset += levelSize * levelSize * 6 * 4;
+    }
+    return offset;
+}
+
+Vector SampleFace(float const *level, uint32_t const size, CubeMapPosition const &position) noexcept
+{
+    auto const     maxTexel = static_cast<float>(size - 1);
+    float const    x  = std::clamp(position.u * static_cast<float>(size) - 0.5F, 0.0F, maxTexel);
+    float const    y  = std::clamp(position.v * static_cast<float>(size) - 0.5F, 0.0F, maxTexel);
+    auto const     x0 = static_cast<uint32_t>(x);
+    auto const     y0 = static_cast<uint32_t>(y);
+    uint32_t const x1 = std::min(x0 + 1, size - 1);
+    uint32_t const y1 = std::min(y0 + 1, size - 1);
+    float const    fx = x - static_cast<float>(x0);
+    float const    fy = y - static_cast<float>(y0);
+
+    float const *face = level + static_cast<size_t>(position.face) * size * size * 4;
+    auto const   texel = [face, size](uint32_t const tx, uint32_t const ty) {
+        return face + (static_cast<size_t>(ty) * size + tx) * 4;
+    };
+    float const *t00 = texel(x0, y0);
+    float const *t10 = texel(x1, y0);
+    float const *t01 = texel(x0, y1);
+    float const *t11 = texel(x1, y1);
+    Vector       ret;
+    for (uint32_t channel = 0; channel < 3; ++channel)
+    {
+        float const top    = t00[channel] + (t10[channel] - t00[channel]) * fx;
+        float const bottom = t01[channel] + (t11[channel] - t01[channel]) * fx;
+        ret[channel]       = top + (bottom - top) * fy;
+    }
+    return ret;
+}
+
+} // unnamed namespace
+
+bool CPUEnvironmentMap::initialise(uint32_t const widthIn, uint32_t const heightIn,
+    uint32_t const channelCount, std::span<float const> const values) noexcept
+{
+    clear();
+    size_t const pixelCount = static_cast<size_t>(widthIn) * heightIn;
+    if (pixelCount == 0 || channelCount == 0 || channelCount > 4 || values.size() < pixelCount * channelCount)
+    {
+        return false;
+    }
+    try
+    {
+        this->values.resize(pixelCount * 3);
+    }
+    catch (...)
+    {
+        return false;
+    }
+    width  = widthIn;
+    height = heightIn;
+    TaskScheduler::Get().parallelFor(
+        size_t {0}, pixelCount,
+        [&](size_t const pixel) {
+            float const *source      = &values[pixel * channelCount];
+            float       *destination = &this->values[pixel * 3];
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                // Single channel images are treated as grey, non-finite values would corrupt every
+                // integral over the image so are removed
+                float const value    = source[channelCount == 1 ? 0 : std::min(channel, channelCount - 1)];
+                destination[channel] = (channel < channelCount || channelCount == 1) && std::isfinite(value)
+                                         ? value
+                                         : 0.0F;
+            }
+        },
+        kGrainTexels);
+    return true;
+}
+
+void CPUEnvironmentMap::clear() noexcept
+{
+    width  = 0;
+    height = 0;
+    values.clear();
+    values.shrink_to_fit();
+}
+
+bool CPUEnvironmentMap::isValid() const noexcept
+{
+    return !values.empty();
+}
+
+uint32_t CPUEnvironmentMap::getWidth() const noexcept
+{
+    return width;
+}
+
+uint32_t CPUEnvironmentMap::getHeight() const noexcept
+{
+    return height;
+}
+
+Vector CPUEnvironmentMap::evaluate(Vector const &direction) const noexcept
+{
+    if (!isValid())
+    {
+        return {};
+    }
+    float u;
+    float v;
+    GetSourcePosition(direction, u, v);
+
+    // Wrap horizontally and clamp vertically, matching a linear sampler with wrapped addressing
+    float const    x      = u * static_cast<float>(width) - 0.5F;
+    float const    maxY   = static_cast<float>(height - 1);
+    float const    y      = std::clamp(v * static_cast<float>(height) - 0.5F, 0.0F, maxY);
+    float const    floorX = std::floor(x);
+    auto const     x0     = static_cast<uint32_t>(static_cast<int64_t>(floorX) + width) % width;
+    uint32_t const x1     = (x0 + 1) % width;
+    auto const     y0     = static_cast<uint32_t>(y);
+    uint32_t const y1     = std::min(y0 + 1, height - 1);
+    float const    fx     = x - floorX;
+    float const    fy     = y - static_cast<float>(y0);
+
+    Vector const t00 = fetch(x0, y0);
+    Vector const t10 = fetch(x1, y0);
+    Vector const t01 = fetch(x0, y1);
+    Vector const t11 = fetch(x1, y1);
+    Vector       ret;
+    for (uint32_t channel = 0; channel < 3; ++channel)
+    {
+        float const top    = t00[channel] + (t10[channel] - t00[channel]) * fx;
+        float const bottom = t01[channel] + (t11[channel] - t01[channel]) * fx;
+        ret[channel]       = top + (bottom - top) * fy;
+    }
+    return ret;
+}
+
+Vector CPUEnvironmentMap::GetSourceDirection(float const u, float const v) noexcept
+{
+    float const phi      = (u - 0.5F) * 2.0F * kPi;
+    float const theta    = (1.0F - v) * kPi;
+    float const sinTheta = std::sin(theta);
+    return {-sinTheta * std::cos(phi), std::cos(theta), -sinTheta * std::sin(phi)};
+}
+
+Vector CPUEnvironmentMap::GetCubeMapDirection(uint32_t const face, float const u, float const v) noexcept
+{
+    float const s = 2.0F * u - 1.0F;
+    float const t = 2.0F * v - 1.0F;
+    switch (face)
+    {
+    case 0: return Normalise({1.0F, -t, -s});
+    case 1: return Normalise({-1.0F, -t, s});
+    case 2: return Normalise({s, 1.0F, t});
+    case 3: return Normalise({s, -1.0F, -t});
+    case 4: return Normalise({s, -t, 1.0F});
+    default: return Normalise({-s, -t, -1.0F});
+    }
+}
+
+uint32_t CPUEnvironmentMap::GetCubeMapSize(uint32_t const renderWidth, uint32_t const renderHeight,
+    uint32_t const sourceWidth, uint32_t const sourceHeight) noexcept
+{
+    // Scale to the closest power of 2 of the render resolution
+    uint32_t const maxWidth   = std::max(renderWidth, renderHeight);
+    uint32_t const floorWidth = std::bit_floor(maxWidth);
+    uint32_t const ceilWidth  = std::bit_ceil(maxWidth);
+    uint32_t       size       = (maxWidth - floorWidth >= ceilWidth - maxWidth) ? ceilWidth : floorWidth;
+
+    // Never exceed the resolution of the source
+    if (sourceWidth > 0 && sourceHeight > 0)
+    {
+        size = std::min((maxWidth == renderWidth ? sourceWidth : sourceHeight) / 2, size);
+    }
+    return std::max(size, 1U);
+}
+
+LutCache::Key CPUEnvironmentMap::GetCubeMapKey(
+    uint64_t const fileHash, uint32_t const renderWidth, uint32_t const renderHeight) noexcept
+{
+    // The final size also depends on the source dimensions, which are determined by the file contents
+    LutCache::Key key;
+    key.add("EnvironmentMap")
+        .add(fileHash)
+        .add(GetCubeMapSize(renderWidth, renderHeight, 0, 0))
+        .add(std::max(renderWidth, renderHeight) == renderWidth ? 0U : 1U)
+        .add(kVersion);
+    return key;
+}
+
+LutCache::Description CPUEnvironmentMap::GetCubeMapDescription(
+    uint32_t const size, uint32_t const mipCount) noexcept
+{
+    LutCache::Description description;
+    description.format        = kFormatRGBA16F;
+    description.width         = size;
+    description.height        = size;
+    description.sliceCount    = 6;
+    description.mipCount      = mipCount;
+    description.bytesPerTexel = 8;
+    return description;
+}
+
+bool CPUEnvironmentMap::generateCubeMap(
+    uint32_t const size, uint32_t mipCount, std::vector<float> &cubeMap) const noexcept
+{
+    if (!isValid() || size == 0)
+    {
+        return false;
+    }
+    mipCount = std::clamp(mipCount, 1U, CPUMip::GetMipCount(size, size));
+    try
+    {
+        cubeMap.resize(GetLevelOffset(size, mipCount));
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    // Each face covers a quarter of the source width, use enough samples to cover every source texel
+    uint32_t const samples     = std::clamp((width + 4 * size - 1) / (4 * size), 1U, kMaxSupersampling);
+    float const    sampleScale = 1.0F / static_cast<float>(samples * samples);
+    float const    sampleStep  = 1.0F / static_cast<float>(samples);
+    auto const     faceSize    = static_cast<size_t>(size) * size * 4;
+    TaskScheduler::Get().parallelFor(
+        uint64_t {0}, uint64_t {6} * size,
+        [&](uint64_t const faceRow) {
+            auto const face = static_cast<uint32_t>(faceRow / size);
+            auto const y    = static_cast<uint32_t>(faceRow % size);
+            float     *row  = &cubeMap[face * faceSize + static_cast<size_t>(y) * size * 4];
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                Vector sum = {};
+                for (uint32_t sampleY = 0; sampleY < samples; ++sampleY)
+                {
+                    float const v =
+                        (static_cast<float>(y) + (static_cast<float>(sampleY) + 0.5F) * sampleStep)
+                        / static_cast<float>(size);
+                    for (uint32_t sampleX = 0; sampleX < samples; ++sampleX)
+                    {
+                        float const u =
+                            (static_cast<float>(x) + (static_cast<float>(sampleX) + 0.5F) * sampleStep)
+                            / static_cast<float>(size);
+                        Vector const value = evaluate(GetCubeMapDirection(face, u, v));
+                        sum                = {sum[0] + value[0], sum[1] + value[1], sum[2] + value[2]};
+                    }
+                }
+                row[x * 4 + 0] = sum[0] * sampleScale;
+                row[x * 4 + 1] = sum[1] * sampleScale;
+                row[x * 4 + 2] = sum[2] * sampleScale;
+                row[x * 4 + 3] = 1.0F;
+            }
+        },
+        std::max(kGrainTexels / size, uint64_t {1}));
+
+    if (mipCount > 1)
+    {
+        // Mip each face separately and then interleave the faces of each level
+        std::vector<float> faceChain(CPUMip::GetMipChainSize(size, size, 4, mipCount));
+        for (uint32_t face = 0; face < 6; ++face)
+        {
+            std::copy_n(&cubeMap[face * faceSize], faceSize, faceChain.begin());
+            CPUMip::Mip(faceChain.data(), size, size, CPUMip::Type::RGBA, mipCount);
+            for (uint32_t mip = 1; mip < mipCount; ++mip)
+            {
+                uint32_t const levelSize = std::max(size >> mip, 1U);
+                size_t const   levelFace = static_cast<size_t>(levelSize) * levelSize * 4;
+                std::copy_n(faceChain.begin()
+                                + static_cast<ptrdiff_t>(CPUMip::GetMipChainSize(size, size, 4, mip)),
+                    levelFace, &cubeMap[GetLevelOffset(size, mip) + face * levelFace]);
+            }
+        }
+    }
+    return true;
+}
+
+Vector CPUEnvironmentMap::SampleCubeMap(std::span<float const> const cubeMap, uint32_t const size,
+    uint32_t const mipCount, Vector const &direction, float const lod) noexcept
+{
+    CubeMapPosition const position = GetCubeMapPosition(direction);
+    float const           level    = std::clamp(lod, 0.0F, static_cast<float>(mipCount - 1));
+    auto const            mip0     = static_cast<uint32_t>(level);
+    Vector const          value0 =
+        SampleFace(&cubeMap[GetLevelOffset(size, mip0)], std::max(size >> mip0, 1U), position);
+    float const blend = level - static_cast<float>(mip0);
+    if (blend <= 0.0F)
+    {
+        return value0;
+    }
+    uint32_t const mip1 = std::min(mip0 + 1, mipCount - 1);
+    Vector const   value1 =
+        SampleFace(&cubeMap[GetLevelOffset(size, mip1)], std::max(size >> mip1, 1U), position);
+    return {value0[0] + (value1[0] - value0[0]) * blend, value0[1] + (value1[1] - value0[1]) * blend,
+        value0[2] + (value1[2] - value0[2]) * blend};
+}
+
+Vector CPUEnvironmentMap::fetch(uint32_t const x, uint32_t const y) const noexcept
+{
+    float const *value = &values[(static_cast<size_t>(y) * width + x) * 3];
+    return {value[0], value[1], value[2]};
+}
+} // namespace Capsaicin
@@ -0,0 +1,155 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "lut_cache.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * CPU preprocessing of equirectangular environment maps.
+ * Generates the environment cube map and its mip chain. Cube map faces and mips use the
+ * LutCache::Description layout so results can be cached and uploaded without any further conversion. All
+ * directions are in the space used to look up the environment cube map in shaders. Rows and texels are
+ * processed in parallel using the TaskScheduler.
+ */
+class CPUEnvironmentMap
+{
+public:
+    /** Version of all generated data, must be incremented whenever results change to invalidate caches */
+    static constexpr uint32_t kVersion = 1;
+
+    static constexpr uint32_t kFormatRGBA16F = 10; /**< DXGI_FORMAT_R16G16B16A16_FLOAT */
+
+    /** A direction or RGB value */
+    using Vector = std::array<float, 3>;
+
+    /**
+     * Initialise from an equirectangular image.
+     * @param widthIn      The width of the image.
+     * @param heightIn     The height of the image.
+     * @param channelCount Number of channels in each pixel (range [1, 4]), only the first 3 are used.
+     * @param values       The image values, channels are interleaved and rows tightly packed.
+     * @return True if successful, False if the input was invalid.
+     */
+    bool initialise(
+        uint32_t widthIn, uint32_t heightIn, uint32_t channelCount, std::span<float const> values) noexcept;
+
+    /** Release the source image. */
+    void clear() noexcept;
+
+    [[nodiscard]] bool     isValid() const noexcept;
+    [[nodiscard]] uint32_t getWidth() const noexcept;
+    [[nodiscard]] uint32_t getHeight() const noexcept;
+
+    /**
+     * Evaluate the source image in a given direction using bilinear filtering.
+     * @param direction Normalised direction.
+     * @return The RGB value.
+     */
+    [[nodiscard]] Vector evaluate(Vector const &direction) const noexcept;
+
+    /**
+     * Gets the direction corresponding to a position within the equirectangular source image.
+     * @param u Horizontal position (range [0, 1]).
+     * @param v Vertical position (range [0, 1], 0 being the first row).
+     * @return The normalised direction.
+     */
+    [[nodiscard]] static Vector GetSourceDirection(float u, float v) noexcept;
+
+    /**
+     * Gets the direction corresponding to a position on a cube map face.
+     * @param face The cube map face (ordered +X, -X, +Y, -Y, +Z, -Z).
+     * @param u    Horizontal position (range [0, 1]).
+     * @param v    Vertical position (range [0, 1], 0 being the first row).
+     * @return The normalised direction.
+     */
+    [[nodiscard]] static Vector GetCubeMapDirection(uint32_t face, float u, float v) noexcept;
+
+    /**
+     * Gets the size of the environment cube map used for a given render resolution.
+     * The size is the power of 2 closest to the largest render dimension without exceeding half the
+     * corresponding dimension of the source image.
+     * @param renderWidth  The render width.
+     * @param renderHeight The render height.
+     * @param sourceWidth  The source image width, 0 if not known.
+     * @param sourceHeight The source image height, 0 if not known.
+     * @return The cube map size.
+     */
+    [[nodiscard]] static uint32_t GetCubeMapSize(
+        uint32_t renderWidth, uint32_t renderHeight, uint32_t sourceWidth, uint32_t sourceHeight) noexcept;
+
+    /**
+     * Gets the cache key of the environment cube map generated for a given render resolution.
+     * @param fileHash     Hash of the contents of the source image file (see LutCache::HashFile).
+     * @param renderWidth  The render width.
+     * @param renderHeight The render height.
+     * @return The key.
+     */
+    [[nodiscard]] static LutCache::Key GetCubeMapKey(
+        uint64_t fileHash, uint32_t renderWidth, uint32_t renderHeight) noexcept;
+
+    /**
+     * Gets the layout of a cube map stored as half precision RGBA values.
+     * @param size     The width and height of each face.
+     * @param mipCount Number of mip levels.
+     * @return The description.
+     */
+    [[nodiscard]] static LutCache::Description GetCubeMapDescription(
+        uint32_t size, uint32_t mipCount) noexcept;
+
+    /**
+     * Generate a cube map and its mip chain from the source image.
+     * @note Each texel is the average of enough bilinear samples to cover the source texels it spans, mips
+     * are generated using a 2x2 box filter (see CPUMip).
+     * @param size     The width and height of each face.
+     * @param mipCount Number of mip levels (including the top level).
+     * @param cubeMap  Output RGBA values using the layout from GetCubeMapDescription.
+     * @return True if successful, False otherwise.
+     */
+    bool generateCubeMap(uint32_t size, uint32_t mipCount, std::vector<float> &cubeMap) const noexcept;
+
+    /**
+     * Sample a cube map using trilinear filtering.
+     * @param cubeMap   RGBA values using the layout from GetCubeMapDescription.
+     * @param size      The width and height of each face.
+     * @param mipCount  Number of mip levels.
+     * @param direction Normalised direction.
+     * @param lod       The mip level to sample (clamped to the available levels).
+     * @return The RGB value.
+     */
+    [[nodiscard]] static Vector SampleCubeMap(std::span<float const> cubeMap, uint32_t size,
+        uint32_t mipCount, Vector const &direction, float lod) noexcept;
+
+private:
+    [[nodiscard]] Vector fetch(uint32_t x, uint32_t y) const noexcept;
+
+    uint32_t           width  = 0;
+    uint32_t           height = 0;
+    std::vector<float> values; /**< RGB values of the source image */
+};
+} // namespace Capsaicin
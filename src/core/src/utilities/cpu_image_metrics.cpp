@@ -0,0 +1,468 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_image_metrics.h"
+
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#if defined(__AVX2__)
+#    include <immintrin.h>
+#endif
+
+namespace Capsaicin
+{
+namespace
+{
+using Type      = CPUImageMetrics::Type;
+using Operation = CPUImageMetrics::Operation;
+
+/** Width of the SSIM window, centered on each pixel */
+constexpr int32_t kWindowSize   = 11;
+constexpr int32_t kWindowOffset = kWindowSize / 2;
+
+/** Sum of the squared window weights needed for weighted variance */
+constexpr float kSumSquaredWeights = 0.0353944717F;
+
+/** Minimum number of pixels processed by each parallel task */
+constexpr uint32_t kGrainPixels = 16384;
+
+/** Gaussian window weights with sigma=1.5, the GPU table is symmetric so only a quadrant is stored */
+constexpr std::array<std::array<float, 6>, 6> kGaussianQuadrant = {{
+    {1.057565598e-06F, 7.814411533e-06F, 3.702247708e-05F,
+        0.0001124643551F, 0.0002190506529F, 0.0002735611601F},
+    {7.814411533e-06F, 5.77411252e-05F, 0.0002735611601F,
+        0.0008310054291F, 0.001618577563F, 0.002021358758F},
+    {3.702247708e-05F, 0.0002735611601F, 0.001296055594F,
+        0.003937069263F, 0.007668363825F, 0.00957662749F},
+    {0.0001124643551F, 0.0008310054291F, 0.003937069263F,
+        0.01195976041F, 0.02329443247F, 0.02909122565F},
+    {0.0002190506529F, 0.001618577563F, 0.007668363825F,
+        0.02329443247F, 0.0453713591F, 0.05666197049F},
+    {0.0002735611601F, 0.002021358758F, 0.00957662749F,
+        0.02909122565F, 0.05666197049F, 0.07076223776F},
+}};
+
+constexpr auto kGaussianWeights = [] {
+    std::array<std::array<float, kWindowSize>, kWindowSize> ret {};
+    for (int32_t x = 0; x < kWindowSize; ++x)
+    {
+        for (int32_t y = 0; y < kWindowSize; ++y)
+        {
+            ret[x][y] = kGaussianQuadrant[std::min(x, kWindowSize - 1 - x)][std::min(y, kWindowSize - 1 - y)];
+        }
+    }
+    return ret;
+}();
+
+bool IsMultichannel(Type const type) noexcept
+{
+    return type == Type::HDR_RGB || type == Type::SDR_RGB || type == Type::SDR_SRGB;
+}
+
+bool IsHDR(Type const type) noexcept
+{
+    return type == Type::HDR_RGB || type == Type::HDR;
+}
+
+bool IsLinear(Type const type) noexcept
+{
+    return type != Type::SDR_NONLINEAR && type != Type::SDR_SRGB;
+}
+
+/** Equivalent of decodeEOTFSRGB in math/color.hlsl */
+float DecodeEOTFSRGB(float const value) noexcept
+{
+    return value < 0.003041282560128F
+             ? 12.92F * value
+             : 1.055010718947587F * std::pow(value, 1.0F / 2.4F) - 0.055010718947587F;
+}
+
+/** Equivalent of decodeEOTFST2048 in math/color.hlsl */
+float DecodeEOTFST2048(float const value) noexcept
+{
+    float const powM1 = std::pow(value, 0.1593017578125F);
+    return std::pow((0.8359375F + 18.8515625F * powM1) / (1.0F + 18.6875F * powM1), 78.84375F);
+}
+
+/**
+ * Gets the value of a pixel used for comparison, equivalent to GetImageValues in gpu_image_metrics.comp.
+ * @param pixel The pixel channel values.
+ * @param type  The type of data in the image.
+ * @return The converted value.
+ */
+float GetImageValue(float const *pixel, Type const type) noexcept
+{
+    float value;
+    if (IsMultichannel(type))
+    {
+        float red   = pixel[0];
+        float green = pixel[1];
+        float blue  = pixel[2];
+        if (!IsHDR(type))
+        {
+            // Comparison is performed on luma which requires converting back to gamma corrected values
+            red   = DecodeEOTFSRGB(red);
+            green = DecodeEOTFSRGB(green);
+            blue  = DecodeEOTFSRGB(blue);
+        }
+        value = red * 0.2126F + green * 0.7152F + blue * 0.0722F;
+    }
+    else
+    {
+        value = pixel[0];
+        if (!IsHDR(type) && IsLinear(type))
+        {
+            value = value < 0.0031308F ? 12.92F * value
+                                       : 1.055F * std::pow(std::abs(value), 1.0F / 2.4F) - 0.055F;
+        }
+    }
+    if (IsHDR(type))
+    {
+        // HDR values are converted to perceptual values using the PQ transfer function
+        value = DecodeEOTFST2048(value);
+    }
+    return value;
+}
+
+/**
+ * Converts every pixel of an image into the values used for comparison.
+ * @param image        The image to convert.
+ * @param width        The width of the image.
+ * @param height       The height of the image.
+ * @param channelCount Number of channels in each pixel.
+ * @param type         The type of data in the image.
+ * @param values       Output converted values, one per pixel.
+ */
+void ConvertImage(float const *image, uint32_t const width, uint32_t const height,
+    uint32_t const channelCount, Type const type, std::vector<float> &values)
+{
+    values.resize(static_cast<size_t>(width) * height);
+    TaskScheduler::Get().parallelFor(
+        0U, height,
+        [&](uint32_t const row) {
+            size_t const rowStart = static_cast<size_t>(row) * width;
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                values[rowStart + x] = GetImageValue(&image[(rowStart + x) * channelCount], type);
+            }
+        },
+        std::max(kGrainPixels / width, 1U));
+}
+
+/**
+ * Gets the metric value of a single pixel, equivalent to the non SSIM path in gpu_image_metrics.comp.
+ * @tparam OP The metric operation (MSE, RMSE and PSNR all use squared error).
+ * @param input     The source value.
+ * @param reference The reference value.
+ * @return The pixel value.
+ */
+template<Operation OP>
+float GetPixelMetric(float const input, float const reference) noexcept
+{
+    float value = reference - input;
+    if constexpr (OP == Operation::RMAE)
+    {
+        value = std::abs(value) / reference;
+        return reference != 0.0F ? value : 0.0F;
+    }
+    else if constexpr (OP == Operation::SMAPE)
+    {
+        float const divisor = (std::abs(reference) + std::abs(input)) * 0.5F;
+        value               = std::abs(value) / divisor;
+        return divisor != 0.0F ? value : 0.0F;
+    }
+    else
+    {
+        return value * value;
+    }
+}
+
+/**
+ * Sums the metric values of a row of pixels.
+ * @tparam OP The metric operation (MSE, RMSE and PSNR all use squared error).
+ * @param input     The source values.
+ * @param reference The reference values.
+ * @param count     Number of pixels.
+ * @return The sum of the pixel values.
+ */
+template<Operation OP>
+double SumRow(float const *input, float const *reference, uint32_t const count) noexcept
+{
+    uint32_t i   = 0;
+    double   sum = 0.0;
+#if defined(__AVX2__)
+    // Per-pixel values are calculated identically to the scalar path, only the summation order differs
+    __m256 const absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 const zero    = _mm256_setzero_ps();
+    __m256d      sumLow  = _mm256_setzero_pd();
+    __m256d      sumHigh = _mm256_setzero_pd();
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 const source = _mm256_loadu_ps(input + i);
+        __m256 const target = _mm256_loadu_ps(reference + i);
+        __m256       value  = _mm256_sub_ps(target, source);
+        if constexpr (OP == Operation::RMAE)
+        {
+            value = _mm256_div_ps(_mm256_and_ps(value, absMask), target);
+            value = _mm256_and_ps(value, _mm256_cmp_ps(target, zero, _CMP_NEQ_UQ));
+        }
+        else if constexpr (OP == Operation::SMAPE)
+        {
+            __m256 const divisor = _mm256_mul_ps(
+                _mm256_add_ps(_mm256_and_ps(target, absMask), _mm256_and_ps(source, absMask)),
+                _mm256_set1_ps(0.5F));
+            value = _mm256_div_ps(_mm256_and_ps(value, absMask), divisor);
+            value = _mm256_and_ps(value, _mm256_cmp_ps(divisor, zero, _CMP_NEQ_UQ));
+        }
+        else
+        {
+            value = _mm256_mul_ps(value, value);
+        }
+        sumLow  = _mm256_add_pd(sumLow, _mm256_cvtps_pd(_mm256_castps256_ps128(value)));
+        sumHigh = _mm256_add_pd(sumHigh, _mm256_cvtps_pd(_mm256_extractf128_ps(value, 1)));
+    }
+    std::array<double, 4> lanes {};
+    _mm256_storeu_pd(lanes.data(), _mm256_add_pd(sumLow, sumHigh));
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+    for (; i < count; ++i)
+    {
+        sum += static_cast<double>(GetPixelMetric<OP>(input[i], reference[i]));
+    }
+    return sum;
+}
+
+/**
+ * Gets the SSIM of a single pixel, equivalent to the SSIM path in gpu_image_metrics.comp.
+ * @param input     The source values.
+ * @param reference The reference values.
+ * @param width     The width of the image.
+ * @param height    The height of the image.
+ * @param x         The horizontal pixel coordinate.
+ * @param y         The vertical pixel coordinate.
+ * @return The pixel value.
+ */
+float GetPixelSSIM(float const *input, float const *reference, int32_t const width, int32_t const height,
+    int32_t const x, int32_t const y) noexcept
+{
+    // Clamp window to avoid going over image edges, weights are not renormalised to match the GPU
+    int32_t const minX     = std::max(kWindowOffset - x, 0);
+    int32_t const maxX     = std::min(kWindowOffset + width - x, kWindowSize);
+    int32_t const minY     = std::max(kWindowOffset - y, 0);
+    int32_t const maxY     = std::min(kWindowOffset + height - y, kWindowSize);
+    auto const    getIndex = [&](int32_t const windowX, int32_t const windowY) {
+        return static_cast<size_t>(y + windowY - kWindowOffset) * static_cast<size_t>(width)
+             + static_cast<size_t>(x + windowX - kWindowOffset);
+    };
+
+    // Calculate the weighted pixel mean over the window, the window is iterated in the same order as the GPU
+    float sampleMeanInput     = 0.0F;
+    float sampleMeanReference = 0.0F;
+    for (int32_t windowX = minX; windowX < maxX; ++windowX)
+    {
+        for (int32_t windowY = minY; windowY < maxY; ++windowY)
+        {
+            size_t const index  = getIndex(windowX, windowY);
+            float const  weight = kGaussianWeights[windowX][windowY];
+            sampleMeanInput += input[index] * weight;
+            sampleMeanReference += reference[index] * weight;
+        }
+    }
+
+    // Calculate the weighted unbiased variance and cross-correlation
+    float varianceInput     = 0.0F;
+    float varianceReference = 0.0F;
+    float crossCorrelation  = 0.0F;
+    for (int32_t windowX = minX; windowX < maxX; ++windowX)
+    {
+        for (int32_t windowY = minY; windowY < maxY; ++windowY)
+        {
+            size_t const index       = getIndex(windowX, windowY);
+            float const  weight      = kGaussianWeights[windowX][windowY];
+            float const  inputSq     = input[index] - sampleMeanInput;
+            float const  referenceSq = reference[index] - sampleMeanReference;
+            varianceInput += inputSq * inputSq * weight;
+            varianceReference += referenceSq * referenceSq * weight;
+            crossCorrelation += inputSq * referenceSq * weight;
+        }
+    }
+    varianceInput /= 1.0F - kSumSquaredWeights;
+    varianceReference /= 1.0F - kSumSquaredWeights;
+    crossCorrelation /= 1.0F - kSumSquaredWeights;
+    varianceInput     = std::max(varianceInput, 0.0F);
+    varianceReference = std::max(varianceReference, 0.0F);
+
+    // Input range is [0,1] so L=1
+    constexpr float k1       = 0.01F;
+    constexpr float k2       = 0.03F;
+    constexpr float c1       = k1 * k1;
+    constexpr float c2       = k2 * k2;
+    float const     value1   = (2.0F * sampleMeanInput * sampleMeanReference) + c1;
+    float const     value2   = (2.0F * crossCorrelation) + c2;
+    float const     divisor1 =
+        (sampleMeanInput * sampleMeanInput) + (sampleMeanReference * sampleMeanReference) + c1;
+    float const     divisor2 = varianceInput + varianceReference + c2;
+    return (value1 * value2) / (divisor1 * divisor2);
+}
+
+/**
+ * Sums the metric values of every pixel.
+ * @param input     The converted source values.
+ * @param reference The converted reference values.
+ * @param width     The width of the images.
+ * @param height    The height of the images.
+ * @param operation The metric to sum.
+ * @return The sum of the pixel values.
+ */
+double SumMetric(std::vector<float> const &input, std::vector<float> const &reference, uint32_t const width,
+    uint32_t const height, Operation const operation) noexcept
+{
+    auto const sumRows = [&](uint32_t const first, uint32_t const last, double sum) {
+        for (uint32_t row = first; row < last; ++row)
+        {
+            size_t const       rowStart     = static_cast<size_t>(row) * width;
+            float const *const inputRow     = input.data() + rowStart;
+            float const *const referenceRow = reference.data() + rowStart;
+            switch (operation)
+            {
+            case Operation::RMAE: sum += SumRow<Operation::RMAE>(inputRow, referenceRow, width); break;
+            case Operation::SMAPE: sum += SumRow<Operation::SMAPE>(inputRow, referenceRow, width); break;
+            case Operation::SSIM:
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    sum += static_cast<double>(GetPixelSSIM(input.data(), reference.data(),
+                        static_cast<int32_t>(width), static_cast<int32_t>(height), static_cast<int32_t>(x),
+                        static_cast<int32_t>(row)));
+                }
+                break;
+            default: sum += SumRow<Operation::MSE>(inputRow, referenceRow, width); break;
+            }
+        }
+        return sum;
+    };
+    // Rows are combined in a fixed order so results do not depend on the number of worker threads
+    return TaskScheduler::Get().parallelReduce(
+        0U, height, 0.0, sumRows, std::plus<> {}, std::max(kGrainPixels / width, 1U));
+}
+} // unnamed namespace
+
+bool CPUImageMetrics::Compare(float const *sourceImage, float const *referenceImage, uint32_t const width,
+    uint32_t const height, uint32_t const channelCount, Type const type,
+    std::span<Operation const> const operations, double *values) noexcept
+{
+    if (sourceImage == nullptr || referenceImage == nullptr || values == nullptr || width == 0
+        || height == 0 || channelCount == 0 || channelCount > 4 || (IsMultichannel(type) && channelCount < 3))
+    {
+        return false;
+    }
+    try
+    {
+        std::vector<float> input;
+        std::vector<float> reference;
+        ConvertImage(sourceImage, width, height, channelCount, type, input);
+        ConvertImage(referenceImage, width, height, channelCount, type, reference);
+
+        // MSE, RMSE and PSNR are all calculated from the same sum so it is only calculated once
+        double         squaredErrorSum   = 0.0;
+        bool           squaredErrorValid = false;
+        uint64_t const totalPixels       = static_cast<uint64_t>(width) * height;
+        for (size_t i = 0; i < operations.size(); ++i)
+        {
+            Operation const operation = operations[i];
+            double          sum;
+            if (operation == Operation::MSE || operation == Operation::RMSE || operation == Operation::PSNR)
+            {
+                if (!squaredErrorValid)
+                {
+                    squaredErrorSum   = SumMetric(input, reference, width, height, Operation::MSE);
+                    squaredErrorValid = true;
+                }
+                sum = squaredErrorSum;
+            }
+            else
+            {
+                sum = SumMetric(input, reference, width, height, operation);
+            }
+            values[i] = ConvertMetric(sum, totalPixels, type, operation);
+        }
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool CPUImageMetrics::Compare(float const *sourceImage, float const *referenceImage, uint32_t const width,
+    uint32_t const height, uint32_t const channelCount, Type const type, Operation const operation,
+    double &value) noexcept
+{
+    return Compare(sourceImage, referenceImage, width, height, channelCount, type,
+        std::span<Operation const>(&operation, 1), &value);
+}
+
+double CPUImageMetrics::ConvertMetric(
+    double const sum, uint64_t const totalPixels, Type const type, Operation const operation) noexcept
+{
+    double ret = sum / static_cast<double>(totalPixels);
+    switch (operation)
+    {
+    case Operation::MSE:
+        // MSE = [1/(width*height)]Sum([Ref.x.y - Src.x.y]^2)
+        break;
+    case Operation::RMSE:
+        // RMSE = sqrt(MSE)
+        ret = std::sqrt(ret);
+        break;
+    case Operation::PSNR:
+        // PSNR = 20log10(MaxValue) - 10log10(MSE)
+        if (IsHDR(type))
+        {
+            // MaxValue is set as 1.0f as we assume always using normalised float values
+            ret = -10.0 * std::log10(ret);
+        }
+        else
+        {
+            // MaxValue is set as 255 for 8bit values
+            ret = 48.13080361 - 10.0 * std::log10(ret);
+        }
+        break;
+    case Operation::RMAE:
+        // RMAE = [1/(width*height)]Sum(Abs(Src.x.y - Ref.x.y)/Ref.x.y)
+        break;
+    case Operation::SMAPE:
+        // SMAPE = [100/(width*height)]Sum(Abs(Ref.x.y - Src.x.y)/([abs(Ref.x.y)+Abs(Src.x.y)]/2)
+        ret *= 100.0;
+        break;
+    case Operation::SSIM:
+        // SSIM =[1/(width*height)]Sum(SSIM(x,y))
+    default: break;
+    }
+    return ret;
+}
+} // namespace Capsaicin
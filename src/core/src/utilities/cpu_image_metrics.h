@@ -0,0 +1,105 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace Capsaicin
+{
+/**
+ * CPU implementation of the comparison metrics calculated by GPUImageMetrics.
+ * Each pixel is converted and evaluated using the same operations as the GPU kernels. Per-pixel values are
+ * accumulated in double precision so sums may differ slightly from the GPU, which accumulates in float.
+ * Rows are processed in parallel using the TaskScheduler. Intended for offline comparison of dumped images
+ * and as a reference for validating GPUImageMetrics.
+ */
+class CPUImageMetrics
+{
+public:
+    /** Type of image values, matches GPUImageMetrics::Type. */
+    enum class Type : uint32_t
+    {
+        HDR = 0,       /**< HDR linear float grayscale/luminance values */
+        HDR_RGB,       /**< HDR linear float RGB values */
+        SDR,           /**< SDR linear float values */
+        SDR_RGB,       /**< SDR linear float RGB values */
+        SDR_NONLINEAR, /**< SDR gamma corrected float values */
+        SDR_SRGB,      /**< SDR gamma corrected sRGB float values */
+    };
+
+    /** Type of comparison operation to perform, matches GPUImageMetrics::Operation. */
+    enum class Operation
+    {
+        MSE,   /**< Mean Squared Error */
+        RMSE,  /**< Root Mean Squared Error */
+        PSNR,  /**< Peak Signal to noise ratio */
+        RMAE,  /**< Relative Mean Absolute Error */
+        SMAPE, /**< Symmetric Mean Absolute Percentage Error */
+        SSIM,  /**< Structural Similarity */
+    };
+
+    /**
+     * Generate comparison metrics for 2 different images.
+     * @note Values are expected as they would be read from a texture by the GPU, i.e. sRGB images must
+     * already be linearised. RGB types use the first 3 channels, all other types use only the first channel.
+     * Pixel conversions are shared between all requested operations.
+     * @param sourceImage    The input image to compare, channels are interleaved and rows tightly packed.
+     * @param referenceImage The reference image to compare to, must have the same layout as the source.
+     * @param width          The width of both images.
+     * @param height         The height of both images.
+     * @param channelCount   Number of channels in each pixel (range [1, 4]).
+     * @param type           The type of data in the images.
+     * @param operations     The metrics to calculate.
+     * @param values         Output value for each requested operation.
+     * @return True, if operation succeeded.
+     */
+    static bool Compare(float const *sourceImage, float const *referenceImage, uint32_t width,
+        uint32_t height, uint32_t channelCount, Type type, std::span<Operation const> operations,
+        double *values) noexcept;
+
+    /**
+     * Generate a single comparison metric for 2 different images.
+     * @param sourceImage    The input image to compare, channels are interleaved and rows tightly packed.
+     * @param referenceImage The reference image to compare to, must have the same layout as the source.
+     * @param width          The width of both images.
+     * @param height         The height of both images.
+     * @param channelCount   Number of channels in each pixel (range [1, 4]).
+     * @param type           The type of data in the images.
+     * @param operation      The metric to calculate.
+     * @param value          Output metric value.
+     * @return True, if operation succeeded.
+     */
+    static bool Compare(float const *sourceImage, float const *referenceImage, uint32_t width,
+        uint32_t height, uint32_t channelCount, Type type, Operation operation, double &value) noexcept;
+
+    /**
+     * Convert the sum of all per-pixel values into the final metric.
+     * @param sum         The sum of the per-pixel values.
+     * @param totalPixels Number of pixels that were summed.
+     * @param type        The type of data in the images.
+     * @param operation   The metric that was calculated.
+     * @return The final metric value.
+     */
+    static double ConvertMetric(double sum, uint64_t totalPixels, Type type, Operation operation) noexcept;
+};
+} // namespace Capsaicin
@@ -0,0 +1,626 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_mip.h"
+
+#include "pixel_conversion.h"
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined(__AVX2__)
+#    include <immintrin.h>
+#endif
+
+namespace Capsaicin
+{
+using Type = CPUMip::Type;
+
+namespace
+{
+/** Minimum number of output texels processed by each task */
+constexpr uint32_t kGrainTexels = 16384;
+
+/** How source texels are combined */
+enum class Filter : uint8_t
+{
+    Average,
+    Minimum,
+    Maximum,
+};
+
+/** Source texels contributing to an output texel along a single axis */
+struct Taps
+{
+    std::array<uint32_t, 3> index  = {};
+    std::array<float, 3>    weight = {};
+    uint32_t                count  = 0;
+};
+
+/** Level being generated from the previous level */
+template<typename T>
+struct Level
+{
+    T const *source       = nullptr;
+    T       *destination  = nullptr;
+    uint32_t inputWidth   = 0;
+    uint32_t inputHeight  = 0;
+    uint32_t outputWidth  = 0;
+    uint32_t outputHeight = 0;
+};
+
+/** Per task temporary rows */
+struct Scratch
+{
+    std::vector<float> linear; /**< Source row converted to linear values */
+    std::vector<float> column; /**< Vertically filtered source row */
+    std::vector<float> output; /**< Filtered output row */
+};
+
+/** Equivalent of convertFromSRGB in math/color.hlsl */
+float ConvertFromSRGB(float const value) noexcept
+{
+    return value < 0.03929337067685376F ? value / 12.92F
+                                        : std::pow((value + 0.055010718947587F) / 1.055010718947587F, 2.4F);
+}
+
+/** Equivalent of convertToSRGB in math/color.hlsl */
+float ConvertToSRGB(float const value) noexcept
+{
+    return value < 0.003041282560128F
+             ? 12.92F * value
+             : 1.055010718947587F * std::pow(value, 1.0F / 2.4F) - 0.055010718947587F;
+}
+
+bool IsSRGB(Type const type) noexcept
+{
+    return type == Type::sRGB || type == Type::sRGBA;
+}
+
+Filter GetFilter(Type const type) noexcept
+{
+    return type == Type::DepthMin ? Filter::Minimum
+         : type == Type::DepthMax ? Filter::Maximum
+                                  : Filter::Average;
+}
+
+/**
+ * Gets the source texels used for an output texel, equivalent to the window used in gpu_mip.comp.
+ * GPUs round down when calculating mip dimensions so odd sized inputs use a 3 texel window with weights
+ * proportional to the fraction of each texel covered by the output texel.
+ * @param output     The output texel coordinate.
+ * @param inputSize  The source dimension.
+ * @param outputSize The output dimension.
+ * @return The taps.
+ */
+Taps GetTaps(uint32_t const output, uint32_t const inputSize, uint32_t const outputSize) noexcept
+{
+    Taps           ret;
+    uint32_t const first = output * 2;
+    if ((inputSize & 1U) == 0 || inputSize == 1)
+    {
+        ret.index  = {first, std::min(first + 1, inputSize - 1), 0};
+        ret.weight = {0.5F, 0.5F, 0.0F};
+        ret.count  = 2;
+    }
+    else
+    {
+        float const scale = 1.0F / static_cast<float>(inputSize);
+        ret.index         = {first, first + 1, first + 2};
+        ret.weight        = {static_cast<float>(outputSize - output) * scale,
+                   static_cast<float>(outputSize) * scale, static_cast<float>(output + 1) * scale};
+        ret.count         = 3;
+    }
+    return ret;
+}
+
+template<Filter FILTER>
+float Combine(float const value, float const sample, float const weight) noexcept
+{
+    if constexpr (FILTER == Filter::Minimum)
+    {
+        return std::min(value, sample);
+    }
+    else if constexpr (FILTER == Filter::Maximum)
+    {
+        return std::max(value, sample);
+    }
+    else
+    {
+        return value + sample * weight;
+    }
+}
+
+/**
+ * Combines a source row into the vertically filtered row.
+ * @param column The filtered row.
+ * @param row    The source row.
+ * @param weight The source row weight (only used when averaging).
+ * @param count  Number of values in each row.
+ * @param first  True if this is the first source row, in which case the filtered row is overwritten.
+ */
+template<Filter FILTER>
+void CombineRow(
+    float *column, float const *row, float const weight, size_t const count, bool const first) noexcept
+{
+    if (first && FILTER != Filter::Average)
+    {
+        std::memcpy(column, row, count * sizeof(float));
+        return;
+    }
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256 const weights = _mm256_set1_ps(weight);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 const sample = _mm256_loadu_ps(row + i);
+        __m256 const value  = first ? _mm256_setzero_ps() : _mm256_loadu_ps(column + i);
+        if constexpr (FILTER == Filter::Minimum)
+        {
+            _mm256_storeu_ps(column + i, _mm256_min_ps(sample, value));
+        }
+        else if constexpr (FILTER == Filter::Maximum)
+        {
+            _mm256_storeu_ps(column + i, _mm256_max_ps(sample, value));
+        }
+        else
+        {
+            _mm256_storeu_ps(column + i, _mm256_add_ps(value, _mm256_mul_ps(sample, weights)));
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        column[i] = Combine<FILTER>(first ? 0.0F : column[i], row[i], weight);
+    }
+}
+
+/**
+ * Horizontally filters a row.
+ * @param column       The vertically filtered row.
+ * @param output       The output row.
+ * @param inputWidth   The width of the source row.
+ * @param outputWidth  The width of the output row.
+ * @param channelCount Number of channels in each texel.
+ */
+template<Filter FILTER>
+void FilterRow(float const *column, float *output, uint32_t const inputWidth, uint32_t const outputWidth,
+    uint32_t const channelCount) noexcept
+{
+    uint32_t x = 0;
+#if defined(__AVX2__)
+    if ((inputWidth & 1U) == 0 && channelCount != 3)
+    {
+        // Even widths are a pairwise combination of neighbouring texels, each iteration separates 8 texels
+        // pairs worth of channels into 2 registers holding the first and second texel of each pair
+        __m256 const half          = _mm256_set1_ps(0.5F);
+        uint32_t const texelsPerIt = 8 / channelCount;
+        for (; x + texelsPerIt <= outputWidth; x += texelsPerIt)
+        {
+            float const *source = column + static_cast<size_t>(x) * 2 * channelCount;
+            __m256 const value0 = _mm256_loadu_ps(source);
+            __m256 const value1 = _mm256_loadu_ps(source + 8);
+            __m256       first;
+            __m256       second;
+            if (channelCount == 4)
+            {
+                first  = _mm256_permute2f128_ps(value0, value1, 0x20);
+                second = _mm256_permute2f128_ps(value0, value1, 0x31);
+            }
+            else
+            {
+                // Results are interleaved across 128bit lanes and are reordered after combining
+                if (channelCount == 2)
+                {
+                    first  = _mm256_shuffle_ps(value0, value1, _MM_SHUFFLE(1, 0, 1, 0));
+                    second = _mm256_shuffle_ps(value0, value1, _MM_SHUFFLE(3, 2, 3, 2));
+                }
+                else
+                {
+                    first  = _mm256_shuffle_ps(value0, value1, _MM_SHUFFLE(2, 0, 2, 0));
+                    second = _mm256_shuffle_ps(value0, value1, _MM_SHUFFLE(3, 1, 3, 1));
+                }
+            }
+            __m256 result;
+            if constexpr (FILTER == Filter::Minimum)
+            {
+                result = _mm256_min_ps(first, second);
+            }
+            else if constexpr (FILTER == Filter::Maximum)
+            {
+                result = _mm256_max_ps(first, second);
+            }
+            else
+            {
+                result = _mm256_add_ps(_mm256_mul_ps(first, half), _mm256_mul_ps(second, half));
+            }
+            if (channelCount != 4)
+            {
+                result = _mm256_castpd_ps(
+                    _mm256_permute4x64_pd(_mm256_castps_pd(result), _MM_SHUFFLE(3, 1, 2, 0)));
+            }
+            _mm256_storeu_ps(output + static_cast<size_t>(x) * channelCount, result);
+        }
+    }
+#endif
+    for (; x < outputWidth; ++x)
+    {
+        Taps const taps = GetTaps(x, inputWidth, outputWidth);
+        for (uint32_t channel = 0; channel < channelCount; ++channel)
+        {
+            float value = FILTER == Filter::Average ? 0.0F : column[taps.index[0] * channelCount + channel];
+            for (uint32_t tap = 0; tap < taps.count; ++tap)
+            {
+                value = Combine<FILTER>(
+                    value, column[taps.index[tap] * channelCount + channel], taps.weight[tap]);
+            }
+            output[x * channelCount + channel] = value;
+        }
+    }
+}
+
+/** Gets the table used to linearise 8bit sRGB values. */
+std::array<float, 256> const &GetSRGBToLinearTable() noexcept
+{
+    static std::array<float, 256> const table = [] {
+        std::array<float, 256> ret {};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            ret[i] = ConvertFromSRGB(static_cast<float>(i) / 255.0F);
+        }
+        return ret;
+    }();
+    return table;
+}
+
+/**
+ * Gets the table used to quantise linear values to 8bit sRGB values.
+ * Entry i holds the linear value at which the rounded sRGB value changes from i to i+1, this avoids
+ * evaluating the sRGB curve for every output texel.
+ */
+std::array<float, 256> const &GetLinearToSRGBTable() noexcept
+{
+    static std::array<float, 256> const table = [] {
+        std::array<float, 256> ret {};
+        for (uint32_t i = 0; i < 255; ++i)
+        {
+            ret[i] = ConvertFromSRGB((static_cast<float>(i) + 0.5F) / 255.0F);
+        }
+        ret[255] = std::numeric_limits<float>::infinity();
+        return ret;
+    }();
+    return table;
+}
+
+/**
+ * Converts a row of stored values to linear float values.
+ * @param row          The stored values.
+ * @param linear       Output linear values.
+ * @param width        Number of texels in the row.
+ * @param channelCount Number of channels in each texel.
+ * @param srgb         True if the colour channels are sRGB encoded.
+ * @return Pointer to the linear values (this may be the input row if no conversion is required).
+ */
+float const *LoadRow(float const *row, float *linear, uint32_t const width, uint32_t const channelCount,
+    bool const srgb) noexcept
+{
+    if (!srgb)
+    {
+        return row;
+    }
+    for (uint32_t x = 0; x < width; ++x)
+    {
+        for (uint32_t channel = 0; channel < channelCount; ++channel)
+        {
+            size_t const index = static_cast<size_t>(x) * channelCount + channel;
+            linear[index]      = channel < 3 ? ConvertFromSRGB(row[index]) : row[index];
+        }
+    }
+    return linear;
+}
+
+float const *LoadRow(uint8_t const *row, float *linear, uint32_t const width, uint32_t const channelCount,
+    bool const srgb) noexcept
+{
+    size_t const count = static_cast<size_t>(width) * channelCount;
+    if (!srgb)
+    {
+        ConvertUnormToFloat(row, linear, count);
+        return linear;
+    }
+    auto const &table = GetSRGBToLinearTable();
+    size_t      i     = 0;
+#if defined(__AVX2__)
+    // Rows start on a texel boundary so the alpha channel is always in lanes 3 and 7
+    __m256 const scale = _mm256_set1_ps(255.0F);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i const value =
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(row + i)));
+        __m256 result = _mm256_i32gather_ps(table.data(), value, sizeof(float));
+        if (channelCount == 4)
+        {
+            result = _mm256_blend_ps(result, _mm256_div_ps(_mm256_cvtepi32_ps(value), scale), 0x88);
+        }
+        _mm256_storeu_ps(linear + i, result);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        linear[i] = (channelCount == 4 && i % 4 == 3) ? static_cast<float>(row[i]) / 255.0F : table[row[i]];
+    }
+    return linear;
+}
+
+/**
+ * Converts a row of filtered linear values to stored values.
+ * @param linear       The filtered linear values.
+ * @param row          Output stored values.
+ * @param width        Number of texels in the row.
+ * @param channelCount Number of channels in each texel.
+ * @param srgb         True if the colour channels are sRGB encoded.
+ */
+void StoreRow(float const *linear, float *row, uint32_t const width, uint32_t const channelCount,
+    bool const srgb) noexcept
+{
+    size_t const count = static_cast<size_t>(width) * channelCount;
+    if (!srgb)
+    {
+        std::memcpy(row, linear, count * sizeof(float));
+        return;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        row[i] = (channelCount == 4 && i % 4 == 3) ? linear[i] : ConvertToSRGB(linear[i]);
+    }
+}
+
+void StoreRow(float const *linear, uint8_t *row, uint32_t const width, uint32_t const channelCount,
+    bool const srgb) noexcept
+{
+    // UNORM writes are clamped and rounded to nearest
+    size_t const count = static_cast<size_t>(width) * channelCount;
+    if (!srgb)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        // max returns its second operand if either is NaN so NaN becomes zero
+        __m256 const zero  = _mm256_setzero_ps();
+        __m256 const one   = _mm256_set1_ps(1.0F);
+        __m256 const scale = _mm256_set1_ps(255.0F);
+        __m256 const round = _mm256_set1_ps(0.5F);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 const  clamped = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(linear + i), zero), one);
+            __m256i const value   = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(clamped, scale), round));
+            __m128i const packed =
+                _mm_packus_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(row + i), _mm_packus_epi16(packed, packed));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            float const clamped = std::min(std::max(linear[i], 0.0F), 1.0F);
+            row[i]              = static_cast<uint8_t>(clamped * 255.0F + 0.5F);
+        }
+        return;
+    }
+    auto const &table = GetLinearToSRGBTable();
+    size_t      i     = 0;
+#if defined(__AVX2__)
+    __m256 const zero  = _mm256_setzero_ps();
+    __m256 const one   = _mm256_set1_ps(1.0F);
+    __m256 const scale = _mm256_set1_ps(255.0F);
+    __m256 const round = _mm256_set1_ps(0.5F);
+    for (; i + 8 <= count; i += 8)
+    {
+        // Same binary search as the scalar path using a gather for each step
+        __m256 const value = _mm256_loadu_ps(linear + i);
+        __m256i      index = _mm256_setzero_si256();
+        for (int32_t step = 128; step > 0; step >>= 1)
+        {
+            __m256 const threshold = _mm256_i32gather_ps(
+                table.data(), _mm256_add_epi32(index, _mm256_set1_epi32(step - 1)), sizeof(float));
+            __m256i const greater = _mm256_castps_si256(_mm256_cmp_ps(value, threshold, _CMP_GE_OQ));
+            index = _mm256_add_epi32(index, _mm256_and_si256(greater, _mm256_set1_epi32(step)));
+        }
+        if (channelCount == 4)
+        {
+            __m256 const clamped = _mm256_min_ps(_mm256_max_ps(value, zero), one);
+            index                = _mm256_blend_epi32(
+                index, _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(clamped, scale), round)), 0x88);
+        }
+        __m128i const packed =
+            _mm_packus_epi32(_mm256_castsi256_si128(index), _mm256_extracti128_si256(index, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(row + i), _mm_packus_epi16(packed, packed));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        float const value = linear[i];
+        if (channelCount == 4 && i % 4 == 3)
+        {
+            float const clamped = std::min(std::max(value, 0.0F), 1.0F);
+            row[i]              = static_cast<uint8_t>(clamped * 255.0F + 0.5F);
+            continue;
+        }
+        // Branchless binary search for the number of thresholds below the value (NaN becomes zero)
+        uint32_t index = 0;
+        for (uint32_t step = 128; step > 0; step >>= 1)
+        {
+            index += value >= table[index + step - 1] ? step : 0;
+        }
+        row[i] = static_cast<uint8_t>(index);
+    }
+}
+
+/**
+ * Generates a range of rows of a single level.
+ * @param level        The level to generate.
+ * @param firstRow     The first output row.
+ * @param lastRow      One past the last output row.
+ * @param channelCount Number of channels in each texel.
+ * @param srgb         True if the colour channels are sRGB encoded.
+ */
+template<Filter FILTER, typename T>
+void GenerateRows(Level<T> const &level, uint32_t const firstRow, uint32_t const lastRow,
+    uint32_t const channelCount, bool const srgb)
+{
+    size_t const inputRowSize  = static_cast<size_t>(level.inputWidth) * channelCount;
+    size_t const outputRowSize = static_cast<size_t>(level.outputWidth) * channelCount;
+    Scratch      scratch;
+    scratch.linear.resize(inputRowSize);
+    scratch.column.resize(inputRowSize);
+    scratch.output.resize(outputRowSize);
+    for (uint32_t y = firstRow; y < lastRow; ++y)
+    {
+        Taps const taps = GetTaps(y, level.inputHeight, level.outputHeight);
+        for (uint32_t tap = 0; tap < taps.count; ++tap)
+        {
+            float const *row = LoadRow(level.source + taps.index[tap] * inputRowSize, scratch.linear.data(),
+                level.inputWidth, channelCount, srgb);
+            CombineRow<FILTER>(scratch.column.data(), row, taps.weight[tap], inputRowSize, tap == 0);
+        }
+        FilterRow<FILTER>(scratch.column.data(), scratch.output.data(), level.inputWidth, level.outputWidth,
+            channelCount);
+        StoreRow(scratch.output.data(), level.destination + y * outputRowSize, level.outputWidth,
+            channelCount, srgb);
+    }
+}
+
+template<Filter FILTER, typename T>
+void GenerateLevel(Level<T> const &level, uint32_t const channelCount, bool const srgb) noexcept
+{
+    try
+    {
+        // Small levels are generated serially to avoid task overheads
+        uint32_t const rowsPerTask = std::max(kGrainTexels / level.outputWidth, 1U);
+        uint32_t const taskCount   = (level.outputHeight + rowsPerTask - 1) / rowsPerTask;
+        if (taskCount <= 1)
+        {
+            GenerateRows<FILTER>(level, 0, level.outputHeight, channelCount, srgb);
+            return;
+        }
+        TaskScheduler::Get().parallelFor(
+            0U, taskCount,
+            [&](uint32_t const task) {
+                uint32_t const firstRow = task * rowsPerTask;
+                GenerateRows<FILTER>(level, firstRow, std::min(firstRow + rowsPerTask, level.outputHeight),
+                    channelCount, srgb);
+            },
+            1);
+    }
+    catch (...)
+    {}
+}
+
+template<typename T>
+bool MipInternal(
+    T *mipChain, uint32_t width, uint32_t height, Type const type, uint32_t const mipLevels) noexcept
+{
+    if (mipChain == nullptr || width == 0 || height == 0)
+    {
+        return false;
+    }
+    uint32_t const channelCount = CPUMip::GetChannelCount(type);
+    uint32_t const levelCount   = std::min(mipLevels, CPUMip::GetMipCount(width, height));
+    bool const     srgb         = IsSRGB(type);
+    Filter const   filter       = GetFilter(type);
+    T             *source       = mipChain;
+    for (uint32_t i = 1; i < levelCount; ++i)
+    {
+        Level<T> level;
+        level.source       = source;
+        level.destination  = source + static_cast<size_t>(width) * height * channelCount;
+        level.inputWidth   = width;
+        level.inputHeight  = height;
+        level.outputWidth  = std::max(width / 2, 1U);
+        level.outputHeight = std::max(height / 2, 1U);
+        switch (filter)
+        {
+        case Filter::Minimum: GenerateLevel<Filter::Minimum>(level, channelCount, srgb); break;
+        case Filter::Maximum: GenerateLevel<Filter::Maximum>(level, channelCount, srgb); break;
+        default: GenerateLevel<Filter::Average>(level, channelCount, srgb); break;
+        }
+        source = level.destination;
+        width  = level.outputWidth;
+        height = level.outputHeight;
+    }
+    return true;
+}
+} // unnamed namespace
+
+uint32_t CPUMip::GetChannelCount(Type const type) noexcept
+{
+    switch (type)
+    {
+    case Type::RG: return 2;
+    case Type::RGB:
+    case Type::sRGB: return 3;
+    case Type::RGBA:
+    case Type::sRGBA: return 4;
+    default: return 1;
+    }
+}
+
+uint32_t CPUMip::GetMipCount(uint32_t const width, uint32_t const height) noexcept
+{
+    // Mips = floor(log2(size)) + 1
+    return 32U - static_cast<uint32_t>(std::countl_zero(std::max(width, height)));
+}
+
+size_t CPUMip::GetMipChainSize(
+    uint32_t width, uint32_t height, uint32_t const channelCount, uint32_t const mipLevels) noexcept
+{
+    size_t         ret        = 0;
+    uint32_t const levelCount = std::min(mipLevels, GetMipCount(width, height));
+    for (uint32_t i = 0; i < levelCount; ++i)
+    {
+        ret += static_cast<size_t>(width) * height * channelCount;
+        width  = std::max(width / 2, 1U);
+        height = std::max(height / 2, 1U);
+    }
+    return ret;
+}
+
+bool CPUMip::Mip(float *mipChain, uint32_t const width, uint32_t const height, Type const type,
+    uint32_t const mipLevels) noexcept
+{
+    return MipInternal(mipChain, width, height, type, mipLevels);
+}
+
+bool CPUMip::Mip(uint8_t *mipChain, uint32_t const width, uint32_t const height, Type const type,
+    uint32_t const mipLevels) noexcept
+{
+    if (GetFilter(type) != Filter::Average)
+    {
+        return false;
+    }
+    return MipInternal(mipChain, width, height, type, mipLevels);
+}
+} // namespace Capsaicin
@@ -0,0 +1,109 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Capsaicin
+{
+/**
+ * CPU implementation of the mip-map generation performed by GPUMip.
+ * Each level is generated from the previously generated level using the same filtering as the GPU kernels:
+ * a 2x2 box filter for even dimensions and a weighted 3 texel window along odd dimensions. sRGB values are
+ * linearised before filtering and re-encoded afterwards. Rows are processed in parallel using the
+ * TaskScheduler. Intended for generating mips of texture data before upload and as a reference for
+ * validating GPUMip.
+ */
+class CPUMip
+{
+public:
+    /** Type of data in 2D texture to mip, matches GPUMip::Type. */
+    enum class Type : uint8_t
+    {
+        R = 0,
+        RG,
+        RGB,
+        RGBA,
+        sRGB,
+        sRGBA,
+        DepthMin,
+        DepthMax,
+    };
+
+    /**
+     * Gets the number of channels in each texel for a given type.
+     * @param type The texture data type.
+     * @return The channel count.
+     */
+    static uint32_t GetChannelCount(Type type) noexcept;
+
+    /**
+     * Gets the number of levels in a complete mip chain.
+     * @param width  The width of the top level.
+     * @param height The height of the top level.
+     * @return The mip count (floor(log2(max(width, height))) + 1).
+     */
+    static uint32_t GetMipCount(uint32_t width, uint32_t height) noexcept;
+
+    /**
+     * Gets the number of values required to hold a mip chain.
+     * @param width        The width of the top level.
+     * @param height       The height of the top level.
+     * @param channelCount Number of channels in each texel.
+     * @param mipLevels    Number of levels in the chain (including the top level).
+     * @return The value count.
+     */
+    static size_t GetMipChainSize(
+        uint32_t width, uint32_t height, uint32_t channelCount, uint32_t mipLevels) noexcept;
+
+    /**
+     * Create a chain of mip maps for a texture.
+     * @note Levels are tightly packed one after another with interleaved channels, the same layout used
+     * when uploading a mip chain to a texture. Values are expected as they are stored in the texture, i.e.
+     * sRGB types hold sRGB encoded values.
+     * @param mipChain  The mip chain, the top level must contain the input texture and the allocation must
+     *                  hold 'GetMipChainSize' values.
+     * @param width     The width of the top level.
+     * @param height    The height of the top level.
+     * @param type      The texture data type.
+     * @param mipLevels Number of levels in the chain (including the top level), clamped to 'GetMipCount'.
+     * @return True, if operation succeeded.
+     */
+    static bool Mip(float *mipChain, uint32_t width, uint32_t height, Type type, uint32_t mipLevels) noexcept;
+
+    /**
+     * Create a chain of mip maps for a texture with 8bit normalised values.
+     * @note Filtering is performed using float values, each level is then rounded to nearest before being
+     * used to generate the next level (matching a GPU writing to a UNORM texture).
+     * @param mipChain  The mip chain, the top level must contain the input texture and the allocation must
+     *                  hold 'GetMipChainSize' values.
+     * @param width     The width of the top level.
+     * @param height    The height of the top level.
+     * @param type      The texture data type (depth types are not supported).
+     * @param mipLevels Number of levels in the chain (including the top level), clamped to 'GetMipCount'.
+     * @return True, if operation succeeded.
+     */
+    static bool Mip(
+        uint8_t *mipChain, uint32_t width, uint32_t height, Type type, uint32_t mipLevels) noexcept;
+};
+} // namespace Capsaicin
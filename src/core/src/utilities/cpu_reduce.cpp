@@ -0,0 +1,203 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_reduce.h"
+
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace Capsaicin
+{
+namespace
+{
+/** Key with a component type and count matching the equivalent HLSL type. */
+template<typename T, size_t N>
+using Key = std::array<T, N>;
+
+/**
+ * Combines 2 keys component wise, using the same semantics as the HLSL operations.
+ * @tparam OPERATION The type of operation to perform.
+ * @param a First key.
+ * @param b Second key.
+ * @return The combined key.
+ */
+template<CPUReduce::Operation OPERATION, typename T, size_t N>
+Key<T, N> Combine(Key<T, N> const &a, Key<T, N> const &b) noexcept
+{
+    Key<T, N> ret;
+    for (size_t i = 0; i < N; ++i)
+    {
+        if constexpr (OPERATION == CPUReduce::Operation::Sum || OPERATION == CPUReduce::Operation::Product)
+        {
+            if constexpr (std::is_signed_v<T> && std::is_integral_v<T>)
+            {
+                // Signed integers wrap on overflow as they do on the GPU
+                using UNSIGNED = std::make_unsigned_t<T>;
+                auto const x   = static_cast<UNSIGNED>(a[i]);
+                auto const y   = static_cast<UNSIGNED>(b[i]);
+                ret[i] = static_cast<T>(OPERATION == CPUReduce::Operation::Sum ? x + y : x * y);
+            }
+            else
+            {
+                ret[i] = OPERATION == CPUReduce::Operation::Sum ? a[i] + b[i] : a[i] * b[i];
+            }
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            // HLSL min/max return the non-NaN value
+            ret[i] = OPERATION == CPUReduce::Operation::Min ? std::fmin(a[i], b[i]) : std::fmax(a[i], b[i]);
+        }
+        else
+        {
+            ret[i] = OPERATION == CPUReduce::Operation::Min ? std::min(a[i], b[i]) : std::max(a[i], b[i]);
+        }
+    }
+    return ret;
+}
+
+/**
+ * Reduces a single block of keys in the same order as BlockReduceType.
+ * @param keys  The keys.
+ * @param first Index of the first key of the block.
+ * @param count Total number of keys.
+ * @return The reduced block value.
+ */
+template<CPUReduce::Operation OPERATION, typename T, size_t N>
+Key<T, N> ReduceBlock(Key<T, N> const *keys, uint32_t const first, uint32_t const count) noexcept
+{
+    // Each thread combines keys strided by the group size, then all threads are combined
+    Key<T, N>      result;
+    uint32_t const threads = std::min(count - first, CPUReduce::kGroupSize);
+    for (uint32_t thread = 0; thread < threads; ++thread)
+    {
+        uint32_t  index       = first + thread;
+        Key<T, N> threadValue = keys[index];
+        for (uint32_t i = 1; i < CPUReduce::kKeysPerThread; ++i)
+        {
+            index += CPUReduce::kGroupSize;
+            if (index >= count)
+            {
+                break;
+            }
+            threadValue = Combine<OPERATION>(threadValue, keys[index]);
+        }
+        result = thread == 0 ? threadValue : Combine<OPERATION>(result, threadValue);
+    }
+    return result;
+}
+
+template<CPUReduce::Operation OPERATION, typename T, size_t N>
+bool ReduceType(void const *keys, uint32_t const numKeys, void *result)
+{
+    // Copy keys as the source is not required to be aligned
+    std::vector<Key<T, N>> values(numKeys);
+    std::memcpy(values.data(), keys, sizeof(Key<T, N>) * numKeys);
+    std::vector<Key<T, N>> partials;
+    auto                  &scheduler = TaskScheduler::Get();
+    // Each loop reduces every block of the previous loop's output, matching the GPU passes
+    for (uint32_t count = numKeys; count > 1;)
+    {
+        uint32_t const numGroups = (count + CPUReduce::kKeysPerGroup - 1) / CPUReduce::kKeysPerGroup;
+        partials.resize(numGroups);
+        scheduler.parallelFor(0U, numGroups, [&](uint32_t const group) {
+            partials[group] = ReduceBlock<OPERATION>(values.data(), group * CPUReduce::kKeysPerGroup, count);
+        });
+        std::swap(values, partials);
+        count = numGroups;
+    }
+    std::memcpy(result, values.data(), sizeof(Key<T, N>));
+    return true;
+}
+
+template<typename T, size_t N>
+bool ReduceOperation(void const *keys, uint32_t const numKeys, CPUReduce::Operation const operation,
+    void *result)
+{
+    switch (operation)
+    {
+    case CPUReduce::Operation::Sum: return ReduceType<CPUReduce::Operation::Sum, T, N>(keys, numKeys, result);
+    case CPUReduce::Operation::Min: return ReduceType<CPUReduce::Operation::Min, T, N>(keys, numKeys, result);
+    case CPUReduce::Operation::Max: return ReduceType<CPUReduce::Operation::Max, T, N>(keys, numKeys, result);
+    case CPUReduce::Operation::Product:
+        return ReduceType<CPUReduce::Operation::Product, T, N>(keys, numKeys, result);
+    default: return false;
+    }
+}
+
+template<typename T>
+bool ReduceComponents(void const *keys, uint32_t const numKeys, uint32_t const components,
+    CPUReduce::Operation const operation, void *result)
+{
+    switch (components)
+    {
+    case 1: return ReduceOperation<T, 1>(keys, numKeys, operation, result);
+    case 2: return ReduceOperation<T, 2>(keys, numKeys, operation, result);
+    case 3: return ReduceOperation<T, 3>(keys, numKeys, operation, result);
+    case 4: return ReduceOperation<T, 4>(keys, numKeys, operation, result);
+    default: return false;
+    }
+}
+} // unnamed namespace
+
+uint32_t CPUReduce::GetTypeSize(Type const type) noexcept
+{
+    return ((static_cast<uint32_t>(type) % 4) + 1)
+         * static_cast<uint32_t>(type >= Type::Double ? sizeof(double) : sizeof(float));
+}
+
+bool CPUReduce::Reduce(void const *keys, uint32_t const numKeys, Type const type, Operation const operation,
+    void *result) noexcept
+{
+    if (numKeys == 0 || keys == nullptr || result == nullptr)
+    {
+        return false;
+    }
+    try
+    {
+        uint32_t const components = (static_cast<uint32_t>(type) % 4) + 1;
+        if (type >= Type::Double)
+        {
+            return ReduceComponents<double>(keys, numKeys, components, operation, result);
+        }
+        if (type >= Type::Int)
+        {
+            return ReduceComponents<int32_t>(keys, numKeys, components, operation, result);
+        }
+        if (type >= Type::UInt)
+        {
+            return ReduceComponents<uint32_t>(keys, numKeys, components, operation, result);
+        }
+        return ReduceComponents<float>(keys, numKeys, components, operation, result);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+} // namespace Capsaicin
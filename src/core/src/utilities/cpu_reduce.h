@@ -0,0 +1,91 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+
+namespace Capsaicin
+{
+/**
+ * CPU implementation of the reductions performed by GPUReduce.
+ * Keys are combined in blocks in the same order as the GPU kernels so that integer, min and max results are
+ * identical, floating point sums and products may differ by rounding as the GPU combines values across waves
+ * in a hardware dependent order. Blocks are reduced in parallel using the TaskScheduler. Intended as a
+ * reference for validating GPUReduce.
+ */
+class CPUReduce
+{
+public:
+    static constexpr uint32_t kGroupSize     = 256;                         /**< Threads per block */
+    static constexpr uint32_t kKeysPerThread = 4;                           /**< Keys per thread */
+    static constexpr uint32_t kKeysPerGroup  = kGroupSize * kKeysPerThread; /**< Keys per block */
+
+    /** Type of value to reduce, matches GPUReduce::Type. */
+    enum class Type : uint8_t
+    {
+        Float = 0,
+        Float2,
+        Float3,
+        Float4,
+        UInt,
+        UInt2,
+        UInt3,
+        UInt4,
+        Int,
+        Int2,
+        Int3,
+        Int4,
+        Double,
+        Double2,
+        Double3,
+        Double4,
+    };
+
+    /** Type of reduce operation to perform, matches GPUReduce::Operation. */
+    enum class Operation : uint8_t
+    {
+        Sum,
+        Min,
+        Max,
+        Product,
+    };
+
+    /**
+     * Gets the size of a single key.
+     * @param type The key type.
+     * @return The size (bytes).
+     */
+    static uint32_t GetTypeSize(Type type) noexcept;
+
+    /**
+     * Reduce a list of keys using the selected operation.
+     * @param keys      The keys to reduce, tightly packed as they would be in a GPU buffer.
+     * @param numKeys   Number of keys.
+     * @param type      The type of each key.
+     * @param operation The type of operation to perform.
+     * @param result    Output reduced value, must be large enough to hold a single key.
+     * @return True if successful, False if there are no keys or temporary memory could not be allocated.
+     */
+    static bool Reduce(
+        void const *keys, uint32_t numKeys, Type type, Operation operation, void *result) noexcept;
+};
+} // namespace Capsaicin
@@ -0,0 +1,221 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_sort.h"
+
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace Capsaicin
+{
+CPUSort::CPUSort(Operation const operationIn) noexcept
+    : operation(operationIn)
+{}
+
+bool CPUSort::sort(uint32_t *keys, uint32_t const numKeys, uint32_t *payload) noexcept
+{
+    return sortSegmented(keys, 1, &numKeys, numKeys, payload);
+}
+
+bool CPUSort::sortSegmented(uint32_t *keys, std::vector<uint32_t> const &numKeys, uint32_t *payload) noexcept
+{
+    try
+    {
+        segments.clear();
+        size_t offset = 0;
+        for (auto const segmentKeys : numKeys)
+        {
+            segments.push_back({.keyOffset = static_cast<uint32_t>(offset), .numKeys = segmentKeys});
+            offset += segmentKeys;
+        }
+        return sortInternal(keys, payload, offset);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool CPUSort::sortSegmented(uint32_t *keys, uint32_t const numSegments, uint32_t const *numKeys,
+    uint32_t const maxNumKeys, uint32_t *payload) noexcept
+{
+    try
+    {
+        segments.clear();
+        for (uint32_t i = 0; i < numSegments; ++i)
+        {
+            segments.push_back({.keyOffset = i * maxNumKeys, .numKeys = std::min(numKeys[i], maxNumKeys)});
+        }
+        return sortInternal(keys, payload, static_cast<size_t>(numSegments) * maxNumKeys);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool CPUSort::sortInternal(uint32_t *keys, uint32_t *payload, size_t const size) noexcept
+{
+    try
+    {
+        // Distribute segments between thread groups identically to ffxParallelSortSetConstantAndDispatchData
+        uint32_t totalGroups = 0;
+        for (auto &segment : segments)
+        {
+            uint32_t const numBlocks = (segment.numKeys + kBlockSize - 1) / kBlockSize;
+            if (numBlocks < kMaxThreadGroups)
+            {
+                segment.numBlocksPerThreadGroup             = 1;
+                segment.numThreadGroups                     = numBlocks;
+                segment.numThreadGroupsWithAdditionalBlocks = 0;
+            }
+            else
+            {
+                segment.numBlocksPerThreadGroup             = numBlocks / kMaxThreadGroups;
+                segment.numThreadGroups                     = kMaxThreadGroups;
+                segment.numThreadGroupsWithAdditionalBlocks = numBlocks % kMaxThreadGroups;
+            }
+            segment.firstGroup = totalGroups;
+            totalGroups += segment.numThreadGroups;
+        }
+        if (totalGroups == 0)
+        {
+            return true;
+        }
+        groupSegments.resize(totalGroups);
+        for (uint32_t i = 0; i < static_cast<uint32_t>(segments.size()); ++i)
+        {
+            std::fill_n(groupSegments.begin() + segments[i].firstGroup, segments[i].numThreadGroups, i);
+        }
+        sumTable.resize(static_cast<size_t>(totalGroups) * kBinCount);
+        keysPong.resize(size);
+        if (payload != nullptr)
+        {
+            payloadPong.resize(size);
+        }
+
+        uint32_t  *readKeys     = keys;
+        uint32_t  *writeKeys    = keysPong.data();
+        uint32_t  *readPayload  = payload;
+        uint32_t  *writePayload = payloadPong.data();
+        bool const descending   = operation == Operation::Descending;
+        auto      &scheduler    = TaskScheduler::Get();
+
+        // Perform radix sort, an even number of passes leaves the result in the source buffers
+        static_assert((32 / kBitsPerPass) % 2 == 0);
+        for (uint32_t shift = 0; shift < 32U; shift += kBitsPerPass)
+        {
+            auto const getBin = [shift, descending](uint32_t const key) {
+                uint32_t const bin = (key >> shift) & (kBinCount - 1);
+                return descending ? (kBinCount - 1) - bin : bin;
+            };
+
+            // Count the keys in each bin for every thread group of every segment
+            scheduler.parallelFor(0U, totalGroups, [&](uint32_t const globalGroup) {
+                Segment const &segment = segments[groupSegments[globalGroup]];
+                uint32_t const group   = globalGroup - segment.firstGroup;
+                auto const [first, last] = GetGroupRange(segment, group);
+                std::array<uint32_t, kBinCount> histogram = {};
+                uint32_t const *segmentKeys               = readKeys + segment.keyOffset;
+                for (uint32_t i = first; i < last; ++i)
+                {
+                    ++histogram[getBin(segmentKeys[i])];
+                }
+                // Sums are stored bin-major so that a single scan gives each group its offset for every bin
+                uint32_t *segmentSums = &sumTable[static_cast<size_t>(segment.firstGroup) * kBinCount];
+                for (uint32_t bin = 0; bin < kBinCount; ++bin)
+                {
+                    segmentSums[bin * segment.numThreadGroups + group] = histogram[bin];
+                }
+            });
+
+            // Scan the sums of each segment
+            scheduler.parallelFor(size_t {0}, segments.size(), [&](size_t const index) {
+                Segment const &segment     = segments[index];
+                uint32_t      *segmentSums = &sumTable[static_cast<size_t>(segment.firstGroup) * kBinCount];
+                std::exclusive_scan(
+                    segmentSums, segmentSums + kBinCount * segment.numThreadGroups, segmentSums, 0U);
+            });
+
+            // Scatter each thread group's keys, keys are processed in order so each pass is stable
+            scheduler.parallelFor(0U, totalGroups, [&](uint32_t const globalGroup) {
+                Segment const &segment = segments[groupSegments[globalGroup]];
+                uint32_t const group   = globalGroup - segment.firstGroup;
+                auto const [first, last] = GetGroupRange(segment, group);
+                uint32_t const *segmentSums = &sumTable[static_cast<size_t>(segment.firstGroup) * kBinCount];
+                std::array<uint32_t, kBinCount> offsets = {};
+                for (uint32_t bin = 0; bin < kBinCount; ++bin)
+                {
+                    offsets[bin] = segmentSums[bin * segment.numThreadGroups + group];
+                }
+                uint32_t const *sourceKeys      = readKeys + segment.keyOffset;
+                uint32_t       *destinationKeys = writeKeys + segment.keyOffset;
+                if (readPayload != nullptr)
+                {
+                    uint32_t const *sourcePayload      = readPayload + segment.keyOffset;
+                    uint32_t       *destinationPayload = writePayload + segment.keyOffset;
+                    for (uint32_t i = first; i < last; ++i)
+                    {
+                        uint32_t const offset      = offsets[getBin(sourceKeys[i])]++;
+                        destinationKeys[offset]    = sourceKeys[i];
+                        destinationPayload[offset] = sourcePayload[i];
+                    }
+                }
+                else
+                {
+                    for (uint32_t i = first; i < last; ++i)
+                    {
+                        destinationKeys[offsets[getBin(sourceKeys[i])]++] = sourceKeys[i];
+                    }
+                }
+            });
+
+            // Swap read/write sources
+            std::swap(readKeys, writeKeys);
+            std::swap(readPayload, writePayload);
+        }
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+std::pair<uint32_t, uint32_t> CPUSort::GetGroupRange(Segment const &segment, uint32_t const group) noexcept
+{
+    // Trailing thread groups process an additional block, matches ffxParallelSortCountUInt
+    uint32_t start     = kBlockSize * segment.numBlocksPerThreadGroup * group;
+    uint32_t numBlocks = segment.numBlocksPerThreadGroup;
+    uint32_t const firstAdditional = segment.numThreadGroups - segment.numThreadGroupsWithAdditionalBlocks;
+    if (group >= firstAdditional)
+    {
+        start += (group - firstAdditional) * kBlockSize;
+        ++numBlocks;
+    }
+    uint32_t const end = std::min(start + numBlocks * kBlockSize, segment.numKeys);
+    return {std::min(start, end), end};
+}
+} // namespace Capsaicin
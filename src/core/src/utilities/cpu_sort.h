@@ -0,0 +1,128 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * CPU implementation of the FidelityFX parallel radix sort used by GPUSort.
+ * Keys are distributed between thread groups, counted, scanned and scattered exactly as the GPU kernels do
+ * so that results (including payload order for equal keys) are bit identical. Thread groups are executed in
+ * parallel using the TaskScheduler. Intended as a reference for validating and benchmarking GPUSort.
+ * @note Float keys are supported by passing their bit patterns, as with GPUSort negative values are not.
+ */
+class CPUSort
+{
+public:
+    static constexpr uint32_t kBitsPerPass     = 4;   /**< Number of key bits sorted by each pass */
+    static constexpr uint32_t kBinCount        = 16;  /**< Number of bins per pass (1 << kBitsPerPass) */
+    static constexpr uint32_t kBlockSize       = 512; /**< Keys processed by a thread group per block */
+    static constexpr uint32_t kMaxThreadGroups = 800; /**< Maximum number of thread groups per segment */
+
+    /** Type of sort operation to perform. */
+    enum class Operation : uint8_t
+    {
+        Ascending = 0,
+        Descending,
+    };
+
+    /**
+     * Constructor.
+     * @param operationIn (Optional) The type of operation to perform.
+     */
+    explicit CPUSort(Operation operationIn = Operation::Ascending) noexcept;
+
+    /**
+     * Sort a list of keys and optional associated payload.
+     * @param keys     The keys to sort.
+     * @param numKeys  Number of keys to sort.
+     * @param payload  (Optional) The payload for each key, reordered along with the keys.
+     * @return True if successful, False if temporary memory could not be allocated.
+     */
+    bool sort(uint32_t *keys, uint32_t numKeys, uint32_t *payload = nullptr) noexcept;
+
+    /**
+     * Sort a segmented list of keys and optional associated payload, equivalent to GPUSort::sortSegmented.
+     * @param keys     The keys to sort, each segment immediately follows the previous one.
+     * @param numKeys  List containing the number of keys in each segment.
+     * @param payload  (Optional) The payload for each key, reordered along with the keys.
+     * @return True if successful, False if temporary memory could not be allocated.
+     */
+    bool sortSegmented(
+        uint32_t *keys, std::vector<uint32_t> const &numKeys, uint32_t *payload = nullptr) noexcept;
+
+    /**
+     * Sort a segmented list of keys and optional associated payload, equivalent to
+     * GPUSort::sortIndirectSegmented.
+     * @param keys        The keys to sort, segments start at multiples of @maxNumKeys.
+     * @param numSegments The number of segments to sort.
+     * @param numKeys     The number of keys in each segment (must have @numSegments values each <=
+     *  @maxNumKeys).
+     * @param maxNumKeys  The maximum number of keys in each segment, also the stride between segments.
+     * @param payload     (Optional) The payload for each key, reordered along with the keys.
+     * @return True if successful, False if temporary memory could not be allocated.
+     */
+    bool sortSegmented(uint32_t *keys, uint32_t numSegments, uint32_t const *numKeys, uint32_t maxNumKeys,
+        uint32_t *payload = nullptr) noexcept;
+
+private:
+    /** Distribution of a single segment between thread groups, matches FfxParallelSortConstants. */
+    struct Segment
+    {
+        uint32_t keyOffset                           = 0; /**< Index of the first key */
+        uint32_t numKeys                             = 0; /**< Number of keys */
+        uint32_t numBlocksPerThreadGroup             = 0; /**< Blocks processed by every thread group */
+        uint32_t numThreadGroups                     = 0; /**< Number of thread groups */
+        uint32_t numThreadGroupsWithAdditionalBlocks = 0; /**< Trailing groups processing an extra block */
+        uint32_t firstGroup                          = 0; /**< First thread group index over all segments */
+    };
+
+    /**
+     * Internal sort implementation used to handle all sort cases.
+     * @param keys    The keys to sort.
+     * @param payload The payload for each key, may be nullptr.
+     * @param size    Number of elements spanned by all segments.
+     * @return True if successful, False otherwise.
+     */
+    bool sortInternal(uint32_t *keys, uint32_t *payload, size_t size) noexcept;
+
+    /**
+     * Gets the range of keys processed by a thread group.
+     * @param segment The segment the thread group belongs to.
+     * @param group   The index of the thread group within the segment.
+     * @return The index of the first key and one past the last key (relative to the segment).
+     */
+    static std::pair<uint32_t, uint32_t> GetGroupRange(Segment const &segment, uint32_t group) noexcept;
+
+    Operation             operation;
+    std::vector<Segment>  segments;      /**< Segments being sorted */
+    std::vector<uint32_t> groupSegments; /**< Segment of each thread group of all segments */
+    std::vector<uint32_t> sumTable;      /**< Per thread group bin counts (bin-major within each segment) */
+    std::vector<uint32_t> keysPong;
+    std::vector<uint32_t> payloadPong;
+};
+} // namespace Capsaicin
@@ -0,0 +1,478 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cube_lut.h"
+
+#include "mapped_file.h"
+#include "pixel_conversion.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace Capsaicin
+{
+namespace
+{
+/** Number of table entries parsed before converting them to half precision as a single batch */
+constexpr size_t kBatchTexels = 256;
+
+/** DXGI_FORMAT_R32G32B32A32_FLOAT, used to cache the table domain */
+constexpr uint32_t kFormatRGBA32F = 2;
+
+/** Reads '.cube' lines and values directly from the file contents. */
+class LineReader
+{
+public:
+    explicit LineReader(std::string_view const text) noexcept
+        : cursor(text.data())
+        , end(text.data() + text.size())
+    {}
+
+    /**
+     * Advance to the next line that is not empty or a comment.
+     * @return False if the end of the text has been reached.
+     */
+    bool nextLine() noexcept
+    {
+        while (cursor < end)
+        {
+            auto const *newLine = static_cast<char const *>(std::memchr(cursor, '\n', end - cursor));
+            lineStart           = cursor;
+            lineEnd             = newLine != nullptr ? newLine : end;
+            cursor              = newLine != nullptr ? newLine + 1 : end;
+            ++lineNumber;
+            skipSpaces();
+            if (lineStart < lineEnd && *lineStart != '#' && *lineStart != '\r')
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Check if the current line starts with a number, all other lines start with a keyword.
+     * @return True if the line contains table data.
+     */
+    [[nodiscard]] bool isData() const noexcept
+    {
+        char const character = *lineStart;
+        return (character >= '0' && character <= '9') || character == '-' || character == '+'
+            || character == '.';
+    }
+
+    /**
+     * Read the next whitespace separated word from the current line.
+     * @return The word, empty if the end of the line has been reached.
+     */
+    std::string_view readWord() noexcept
+    {
+        char const *wordStart = lineStart;
+        while (lineStart < lineEnd && !IsSpace(*lineStart))
+        {
+            ++lineStart;
+        }
+        std::string_view const ret(wordStart, static_cast<size_t>(lineStart - wordStart));
+        skipSpaces();
+        return ret;
+    }
+
+    /**
+     * Read the next number from the current line.
+     * @param value Output value.
+     * @return True if successful, False if the line does not contain a valid finite number.
+     */
+    bool readFloat(float &value) noexcept
+    {
+        // std::from_chars does not accept an explicit positive sign
+        lineStart += (lineStart < lineEnd && *lineStart == '+') ? 1 : 0;
+        auto const [last, result] = std::from_chars(lineStart, lineEnd, value);
+        if (result != std::errc() || !std::isfinite(value) || (last < lineEnd && !IsSpace(*last)))
+        {
+            return false;
+        }
+        lineStart = last;
+        skipSpaces();
+        return true;
+    }
+
+    bool readUInt(uint32_t &value) noexcept
+    {
+        auto const [last, result] = std::from_chars(lineStart, lineEnd, value);
+        if (result != std::errc() || (last < lineEnd && !IsSpace(*last)))
+        {
+            return false;
+        }
+        lineStart = last;
+        skipSpaces();
+        return true;
+    }
+
+    /**
+     * Check if the whole of the current line has been read.
+     * @return True if nothing other than whitespace remains.
+     */
+    [[nodiscard]] bool isLineEnd() const noexcept { return lineStart >= lineEnd; }
+
+    [[nodiscard]] uint32_t getLineNumber() const noexcept { return lineNumber; }
+
+private:
+    static bool IsSpace(char const character) noexcept
+    {
+        return character == ' ' || character == '\t' || character == '\r';
+    }
+
+    void skipSpaces() noexcept
+    {
+        while (lineStart < lineEnd && IsSpace(*lineStart))
+        {
+            ++lineStart;
+        }
+    }
+
+    char const *cursor;
+    char const *end;
+    char const *lineStart  = nullptr; /**< Read position within the current line */
+    char const *lineEnd    = nullptr;
+    uint32_t    lineNumber = 0;
+};
+
+/**
+ * Read the red, green and blue values of a line.
+ * @param reader The line reader.
+ * @param values Output values.
+ * @return True if the line contains exactly 3 valid values.
+ */
+bool ReadVector(LineReader &reader, float *values) noexcept
+{
+    return reader.readFloat(values[0]) && reader.readFloat(values[1]) && reader.readFloat(values[2])
+        && reader.isLineEnd();
+}
+
+LutCache::Key GetDomainKey(LutCache::Key key) noexcept
+{
+    return key.add("Domain");
+}
+} // unnamed namespace
+
+bool CubeLut::parse(std::string_view const text, std::string &error) noexcept
+{
+    clear();
+    LineReader reader(text);
+    auto const fail = [&](char const *message) {
+        try
+        {
+            error = "Line " + std::to_string(reader.getLineNumber()) + ": " + message;
+        }
+        catch (...)
+        {}
+        clear();
+        return false;
+    };
+
+    // Keywords must all appear before the table data
+    uint32_t size1D = 0;
+    uint32_t size3D = 0;
+    while (reader.nextLine() && !reader.isData())
+    {
+        std::string_view const keyword = reader.readWord();
+        if (keyword == "LUT_1D_SIZE" || keyword == "LUT_3D_SIZE")
+        {
+            bool const is3D    = keyword[4] == '3';
+            uint32_t  &newSize = is3D ? size3D : size1D;
+            if (!reader.readUInt(newSize) || !reader.isLineEnd() || newSize < 2
+                || newSize > (is3D ? kMaxSize3D : kMaxSize1D))
+            {
+                return fail(is3D ? "Invalid LUT_3D_SIZE (must be between 2 and 256)"
+                                 : "Invalid LUT_1D_SIZE (must be between 2 and 16384)");
+            }
+        }
+        else if (keyword == "DOMAIN_MIN" || keyword == "DOMAIN_MAX")
+        {
+            if (!ReadVector(reader, keyword == "DOMAIN_MIN" ? domainMin.data() : domainMax.data()))
+            {
+                return fail("Invalid domain, expected 3 values");
+            }
+        }
+        else if (keyword == "LUT_1D_INPUT_RANGE" || keyword == "LUT_3D_INPUT_RANGE")
+        {
+            float minimum;
+            float maximum;
+            if (!reader.readFloat(minimum) || !reader.readFloat(maximum) || !reader.isLineEnd())
+            {
+                return fail("Invalid input range, expected 2 values");
+            }
+            domainMin.fill(minimum);
+            domainMax.fill(maximum);
+        }
+        // Any other keyword (TITLE, application specific metadata) does not affect the table
+    }
+    if ((size1D == 0) == (size3D == 0))
+    {
+        return fail(size3D == 0 ? "Missing LUT_1D_SIZE or LUT_3D_SIZE"
+                                : "Combined 1D and 3D tables are not supported");
+    }
+    for (uint32_t channel = 0; channel < 3; ++channel)
+    {
+        if (!(domainMax[channel] > domainMin[channel]))
+        {
+            return fail("DOMAIN_MAX must be greater than DOMAIN_MIN");
+        }
+    }
+    type = size3D > 0 ? Type::LUT3D : Type::LUT1D;
+    size = type == Type::LUT3D ? size3D : size1D;
+    size_t const texelCount =
+        type == Type::LUT3D ? static_cast<size_t>(size) * size * size : static_cast<size_t>(size);
+    try
+    {
+        texels.resize(texelCount * 4 * sizeof(uint16_t));
+    }
+    catch (...)
+    {
+        return fail("Failed to allocate table");
+    }
+
+    // Values are parsed into a small batch that is converted to half precision once full
+    std::array<float, kBatchTexels * 4> batch;
+    auto  *destination = reinterpret_cast<uint16_t *>(texels.data());
+    size_t texelIndex  = 0;
+    size_t batchCount  = 0;
+    bool   isData      = !reader.isLineEnd();
+    while (isData)
+    {
+        if (texelIndex + batchCount >= texelCount)
+        {
+            return fail("Too many table entries");
+        }
+        float *value = &batch[batchCount * 4];
+        if (!reader.isData() || !ReadVector(reader, value))
+        {
+            return fail("Invalid table entry, expected 3 values");
+        }
+        value[3] = 1.0F;
+        if (++batchCount == kBatchTexels)
+        {
+            ConvertFloatToHalf(batch.data(), destination + texelIndex * 4, batchCount * 4);
+            texelIndex += batchCount;
+            batchCount = 0;
+        }
+        isData = reader.nextLine();
+    }
+    ConvertFloatToHalf(batch.data(), destination + texelIndex * 4, batchCount * 4);
+    texelIndex += batchCount;
+    if (texelIndex != texelCount)
+    {
+        return fail("Too few table entries");
+    }
+    return true;
+}
+
+bool CubeLut::load(std::filesystem::path const &filePath, std::string &error) noexcept
+{
+    MappedFile file;
+    if (!file.open(filePath))
+    {
+        clear();
+        error = "Failed to open file";
+        return false;
+    }
+    auto const data = file.getData();
+    return parse(std::string_view(reinterpret_cast<char const *>(data.data()), data.size()), error);
+}
+
+bool CubeLut::load(std::filesystem::path const &filePath, LutCache &cache, std::string &error) noexcept
+{
+    if (cache.getDirectory().empty())
+    {
+        return load(filePath, error);
+    }
+    MappedFile file;
+    if (!file.open(filePath))
+    {
+        clear();
+        error = "Failed to open file";
+        return false;
+    }
+    auto const    data = file.getData();
+    LutCache::Key key;
+    key.add("CubeLut").add(LutCache::Hash(data)).add(kVersion);
+    if (loadCached(cache, key))
+    {
+        return true;
+    }
+    if (!parse(std::string_view(reinterpret_cast<char const *>(data.data()), data.size()), error))
+    {
+        return false;
+    }
+    try
+    {
+        std::array const domain = {
+            domainMin[0], domainMin[1], domainMin[2], 0.0F, domainMax[0], domainMax[1], domainMax[2], 0.0F};
+        LutCache::Description domainDescription;
+        domainDescription.format        = kFormatRGBA32F;
+        domainDescription.width         = 2;
+        domainDescription.bytesPerTexel = 4 * sizeof(float);
+        auto const domainBytes          = std::as_bytes(std::span(domain));
+        cache.saveAsync(
+            GetDomainKey(key), domainDescription, std::vector(domainBytes.begin(), domainBytes.end()));
+        cache.saveAsync(key, getDescription(), texels);
+    }
+    catch (...)
+    {}
+    return true;
+}
+
+void CubeLut::clear() noexcept
+{
+    // The table memory is kept so that loading another table of the same size does not allocate
+    type      = Type::LUT3D;
+    size      = 0;
+    domainMin = {0.0F, 0.0F, 0.0F};
+    domainMax = {1.0F, 1.0F, 1.0F};
+    texels.clear();
+}
+
+bool CubeLut::isValid() const noexcept
+{
+    return size > 0;
+}
+
+CubeLut::Type CubeLut::getType() const noexcept
+{
+    return type;
+}
+
+uint32_t CubeLut::getSize() const noexcept
+{
+    return size;
+}
+
+CubeLut::Vector CubeLut::getDomainMin() const noexcept
+{
+    return domainMin;
+}
+
+CubeLut::Vector CubeLut::getDomainMax() const noexcept
+{
+    return domainMax;
+}
+
+LutCache::Description CubeLut::getDescription() const noexcept
+{
+    LutCache::Description description;
+    description.format        = kFormatRGBA16F;
+    description.width         = size;
+    description.height        = type == Type::LUT3D ? size : 1;
+    description.sliceCount    = type == Type::LUT3D ? size : 1;
+    description.bytesPerTexel = 4 * sizeof(uint16_t);
+    return description;
+}
+
+std::span<std::byte const> CubeLut::getTexels() const noexcept
+{
+    return texels;
+}
+
+CubeLut::Vector CubeLut::evaluate(Vector const &color) const noexcept
+{
+    if (!isValid())
+    {
+        return color;
+    }
+
+    // The domain maps onto the first and last table entries
+    std::array<uint32_t, 3> index0;
+    std::array<uint32_t, 3> index1;
+    std::array<float, 3>    weight;
+    for (uint32_t channel = 0; channel < 3; ++channel)
+    {
+        float const position = std::clamp((color[channel] - domainMin[channel])
+                                              / (domainMax[channel] - domainMin[channel]),
+                                   0.0F, 1.0F)
+                             * static_cast<float>(size - 1);
+        index0[channel] = std::min(static_cast<uint32_t>(position), size - 2);
+        index1[channel] = index0[channel] + 1;
+        weight[channel] = position - static_cast<float>(index0[channel]);
+    }
+    auto const lerp = [](Vector const &a, Vector const &b, float const t) {
+        return Vector {a[0] + (b[0] - a[0]) * t, a[1] + (b[1] - a[1]) * t, a[2] + (b[2] - a[2]) * t};
+    };
+    if (type == Type::LUT1D)
+    {
+        Vector ret;
+        for (uint32_t channel = 0; channel < 3; ++channel)
+        {
+            ret[channel] = lerp(fetch(index0[channel]), fetch(index1[channel]), weight[channel])[channel];
+        }
+        return ret;
+    }
+    auto const get = [&](uint32_t const r, uint32_t const g, uint32_t const b) {
+        return fetch((b * size + g) * size + r);
+    };
+    auto const lerpRed = [&](uint32_t const g, uint32_t const b) {
+        return lerp(get(index0[0], g, b), get(index1[0], g, b), weight[0]);
+    };
+    Vector const c00 = lerpRed(index0[1], index0[2]);
+    Vector const c10 = lerpRed(index1[1], index0[2]);
+    Vector const c01 = lerpRed(index0[1], index1[2]);
+    Vector const c11 = lerpRed(index1[1], index1[2]);
+    return lerp(lerp(c00, c10, weight[1]), lerp(c01, c11, weight[1]), weight[2]);
+}
+
+bool CubeLut::loadCached(LutCache const &cache, LutCache::Key const &key) noexcept
+{
+    LutCache::Description  domainDescription;
+    std::vector<std::byte> domain;
+    LutCache::Description  description;
+    if (!cache.load(GetDomainKey(key), domainDescription, domain)
+        || domain.size() != 8 * sizeof(float) || !cache.load(key, description, texels))
+    {
+        texels.clear();
+        return false;
+    }
+
+    // Validate the table layout, 1D tables are stored as a single row
+    type = description.height == 1 && description.sliceCount == 1 ? Type::LUT1D : Type::LUT3D;
+    size = description.width;
+    if (description != getDescription() || size < 2 || size > (type == Type::LUT3D ? kMaxSize3D : kMaxSize1D))
+    {
+        clear();
+        return false;
+    }
+    std::array<float, 8> values;
+    std::memcpy(values.data(), domain.data(), sizeof(values));
+    domainMin = {values[0], values[1], values[2]};
+    domainMax = {values[4], values[5], values[6]};
+    return true;
+}
+
+CubeLut::Vector CubeLut::fetch(uint32_t const index) const noexcept
+{
+    std::array<uint16_t, 3> half;
+    std::memcpy(half.data(), &texels[static_cast<size_t>(index) * 4 * sizeof(uint16_t)], sizeof(half));
+    Vector ret;
+    ConvertHalfToFloat(half.data(), ret.data(), 3);
+    return ret;
+}
+} // namespace Capsaicin
@@ -0,0 +1,129 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "lut_cache.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Colour grading lookup table loaded from a '.cube' file.
+ * Supports 1D and 3D tables (up to kMaxSize1D and kMaxSize3D entries per dimension), DOMAIN_MIN/DOMAIN_MAX
+ * and the LUT_*_INPUT_RANGE extension. Values are parsed in place from a memory mapped file with
+ * std::from_chars and converted directly into the half precision RGBA layout used for upload, so apart from
+ * growing the table no memory is allocated. Parsed tables can be stored in a LutCache so that reloading
+ * the same file only requires reading the already converted table.
+ */
+class CubeLut
+{
+public:
+    enum class Type : uint32_t
+    {
+        LUT1D, /**< Separate curve per channel */
+        LUT3D, /**< Full RGB cube */
+    };
+
+    static constexpr uint32_t kMaxSize1D = 16384; /**< Largest 1D table (maximum 2D texture width) */
+    static constexpr uint32_t kMaxSize3D = 256;   /**< Largest 3D table */
+
+    /** Version of the cached form, must be incremented whenever it changes to invalidate caches */
+    static constexpr uint32_t kVersion = 1;
+
+    static constexpr uint32_t kFormatRGBA16F = 10; /**< DXGI_FORMAT_R16G16B16A16_FLOAT */
+
+    using Vector = std::array<float, 3>;
+
+    /**
+     * Parse the contents of a '.cube' file.
+     * @param text  The file contents.
+     * @param error Output reason for failure (including the line number).
+     * @return True if successful, False otherwise (the table is left empty).
+     */
+    bool parse(std::string_view text, std::string &error) noexcept;
+
+    /**
+     * Load a '.cube' file.
+     * @param filePath Full pathname to the file.
+     * @param error    Output reason for failure.
+     * @return True if successful, False otherwise.
+     */
+    bool load(std::filesystem::path const &filePath, std::string &error) noexcept;
+
+    /**
+     * Load a '.cube' file using a previously cached table if available.
+     * @note Cache entries are keyed by the file contents. Newly parsed tables are saved in the background.
+     * @param filePath Full pathname to the file.
+     * @param cache    The cache to load from and save to (ignored if it has no directory).
+     * @param error    Output reason for failure.
+     * @return True if successful, False otherwise.
+     */
+    bool load(std::filesystem::path const &filePath, LutCache &cache, std::string &error) noexcept;
+
+    /** Release the table. */
+    void clear() noexcept;
+
+    [[nodiscard]] bool     isValid() const noexcept;
+    [[nodiscard]] Type     getType() const noexcept;
+    [[nodiscard]] uint32_t getSize() const noexcept;
+    [[nodiscard]] Vector   getDomainMin() const noexcept;
+    [[nodiscard]] Vector   getDomainMax() const noexcept;
+
+    /**
+     * Gets the layout of the table when stored in a texture.
+     * 3D tables are stored as a size^3 volume, 1D tables as a single row of 'size' texels.
+     * @return The description.
+     */
+    [[nodiscard]] LutCache::Description getDescription() const noexcept;
+
+    /**
+     * Gets the table entries.
+     * @return Half precision RGBA values (alpha is 1), red changes fastest followed by green then blue.
+     */
+    [[nodiscard]] std::span<std::byte const> getTexels() const noexcept;
+
+    /**
+     * Evaluate the table at a given input colour using linear (1D) or trilinear (3D) interpolation.
+     * @param color The input colour, clamped to the table domain.
+     * @return The output colour.
+     */
+    [[nodiscard]] Vector evaluate(Vector const &color) const noexcept;
+
+private:
+    [[nodiscard]] bool   loadCached(LutCache const &cache, LutCache::Key const &key) noexcept;
+    [[nodiscard]] Vector fetch(uint32_t index) const noexcept;
+
+    Type                   type      = Type::LUT3D;
+    uint32_t               size      = 0;
+    Vector                 domainMin = {0.0F, 0.0F, 0.0F};
+    Vector                 domainMax = {1.0F, 1.0F, 1.0F};
+    std::vector<std::byte> texels; /**< Half precision RGBA table entries */
+};
+} // namespace Capsaicin
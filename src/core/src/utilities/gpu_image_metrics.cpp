@@ -23,78 +23,106 @@ THE SOFTWARE.
 #include "gpu_image_metrics.h"
 
 #include "capsaicin_internal.h"
+#include "cpu_image_metrics.h"
 
 namespace Capsaicin
 {
+// The CPU implementation uses matching type and operation values
+static_assert(static_cast<uint32_t>(GPUImageMetrics::Type::SDR_SRGB)
+              == static_cast<uint32_t>(CPUImageMetrics::Type::SDR_SRGB));
+static_assert(static_cast<uint32_t>(GPUImageMetrics::Operation::SSIM)
+              == static_cast<uint32_t>(CPUImageMetrics::Operation::SSIM));
+
+namespace
+{
+/** Per-pixel metrics calculated by the kernel, several operations may share the same metric */
+enum class Metric : uint32_t
+{
+    SquaredError = 0, /**< Used by MSE, RMSE and PSNR */
+    RMAE,
+    SMAPE,
+    SSIM,
+    Count,
+};
+
+/** Maximum number of metrics that can be calculated in a single pass, must match the shader */
+constexpr uint32_t kMaxMetrics = static_cast<uint32_t>(Metric::Count);
+
+/** Shader define used to set the output index of each metric */
+constexpr std::array<std::string_view, kMaxMetrics> kMetricDefines = {
+    "SQUARED_ERROR_INDEX=", "RMAE_INDEX=", "SMAPE_INDEX=", "SSIM_INDEX="};
+
+Metric GetMetric(GPUImageMetrics::Operation const operation) noexcept
+{
+    switch (operation)
+    {
+    case GPUImageMetrics::Operation::RMAE: return Metric::RMAE;
+    case GPUImageMetrics::Operation::SMAPE: return Metric::SMAPE;
+    case GPUImageMetrics::Operation::SSIM: return Metric::SSIM;
+    default: return Metric::SquaredError;
+    }
+}
+} // unnamed namespace
+
 GPUImageMetrics::~GPUImageMetrics() noexcept
 {
     terminate();
 }
 
 bool GPUImageMetrics::initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPaths,
-    Type const type, Operation operation) noexcept
+    Type const type, Operation const operation) noexcept
 {
-    gfx = gfxIn;
+    return initialise(gfxIn, shaderPaths, type, std::vector {operation});
+}
+
+bool GPUImageMetrics::initialise(
+    CapsaicinInternal const &capsaicin, Type const type, Operation const operation) noexcept
+{
+    return initialise(capsaicin.getGfx(), capsaicin.getShaderPaths(), type, std::vector {operation});
+}
 
-    if (type != currentType || operation != currentOperation)
+bool GPUImageMetrics::initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPaths,
+    Type const type, std::vector<Operation> const &operations) noexcept
+{
+    if (operations.empty())
     {
-        // If configuration has changed then need to recompile kernels
-        gfxDestroyProgram(gfx, metricsProgram);
-        metricsProgram = {};
-        gfxDestroyKernel(gfx, metricsKernel);
-        metricsKernel = {};
+        return false;
+    }
+    gfx = gfxIn;
 
-        if (!metricBufferTemp.empty())
+    if (type != currentType || operations != currentOperations || metricCount == 0)
+    {
+        // If configuration has changed then need to recompile kernels and recreate buffers as the number of
+        // metrics may have changed
+        terminate();
+        currentType       = type;
+        currentOperations = operations;
+
+        // Assign each metric an output index, operations using the same metric share it
+        std::array<uint32_t, kMaxMetrics> metricIndexes;
+        metricIndexes.fill(UINT_MAX);
+        metricCount = 0;
+        operationMetrics.clear();
+        for (auto const operation : currentOperations)
         {
-            for (auto &i : metricBufferTemp)
+            auto const metric = static_cast<uint32_t>(GetMetric(operation));
+            if (metricIndexes[metric] == UINT_MAX)
             {
-                i.first = 0.0F;
+                metricIndexes[metric] = metricCount++;
             }
+            operationMetrics.push_back(metricIndexes[metric]);
         }
-    }
-    currentType      = type;
-    currentOperation = operation;
-
-    static constexpr std::array<std::string_view, 6> typeName = {
-        "MSE", "RMSE", "PSNR", "RMAE", "SMAPE", "SSIM"};
+        currentValues.assign(currentOperations.size(), 0.0F);
 
-    if (metricBufferTemp.empty())
-    {
         uint32_t const backBufferCount = getAsyncDelay();
-        metricBufferTemp.reserve(backBufferCount);
+        readbackBuffers.resize(backBufferCount);
         for (uint32_t i = 0; i < backBufferCount; ++i)
         {
-            GfxBuffer   buffer = gfxCreateBuffer<float>(gfx, 1, nullptr, kGfxCpuAccess_Read);
-            std::string name   = "GPUImageMetrics_";
-            name.append(typeName[static_cast<uint32_t>(operation)]);
-            name += "Buffer";
-            name += std::to_string(i);
-            buffer.setName(name.c_str());
-            metricBufferTemp.emplace_back(0.0F, buffer);
+            GfxBuffer buffer = CreateBuffer<float>(gfx, metricCount, nullptr, kGfxCpuAccess_Read);
+            buffer.setName(("GPUImageMetrics_MetricsReadbackBuffer" + std::to_string(i)).c_str());
+            readbackBuffers[i] = {buffer, 0};
         }
-    }
-    else
-    {
-        // Invalidate current values
-        for (auto &i : metricBufferTemp)
-        {
-            i.first = 0.0F;
-        }
-    }
 
-    if (!metricBuffer)
-    {
-        metricBuffer     = gfxCreateBuffer<float>(gfx, 8160 /*required @ 1080p*/);
-        std::string name = "GPUImageMetrics_Metrics";
-        name.append(typeName[static_cast<uint32_t>(operation)]);
-        name += "Buffer";
-        metricBuffer.setName(name.c_str());
-    }
-
-    if (!metricsProgram)
-    {
-        gfxDestroyProgram(gfx, metricsProgram);
-        gfxDestroyKernel(gfx, metricsKernel);
         std::vector<char const *> includePaths;
         includePaths.reserve(shaderPaths.size());
         for (auto const &path : shaderPaths)
@@ -103,46 +131,46 @@ bool GPUImageMetrics::initialise(GfxContext const &gfxIn, std::vector<std::strin
         }
         metricsProgram = gfxCreateProgram(gfx, "utilities/gpu_image_metrics", includePaths[0], nullptr,
             includePaths.data(), static_cast<uint32_t>(includePaths.size()));
-        std::vector<char const *> baseDefines;
+        std::vector<std::string> defines;
         if (currentType == Type::HDR_RGB || currentType == Type::SDR_RGB || currentType == Type::SDR_SRGB)
         {
-            baseDefines.push_back("INPUT_MULTICHANNEL");
+            defines.emplace_back("INPUT_MULTICHANNEL");
         }
         if (currentType == Type::HDR_RGB || currentType == Type::HDR)
         {
-            baseDefines.push_back("INPUT_HDR");
+            defines.emplace_back("INPUT_HDR");
         }
         if (currentType != Type::SDR_NONLINEAR && currentType != Type::SDR_SRGB)
         {
-            baseDefines.push_back("INPUT_LINEAR");
-        }
-        if (currentOperation == Operation::PSNR)
-        {
-            baseDefines.push_back("CALCULATE_PSNR");
-        }
-        else if (currentOperation == Operation::MSE)
-        {
-            baseDefines.push_back("CALCULATE_MSE");
-        }
-        else if (currentOperation == Operation::RMSE)
-        {
-            baseDefines.push_back("CALCULATE_RMSE");
+            defines.emplace_back("INPUT_LINEAR");
         }
-        else if (currentOperation == Operation::RMAE)
+        for (uint32_t metric = 0; metric < kMaxMetrics; ++metric)
         {
-            baseDefines.push_back("CALCULATE_RMAE");
-        }
-        else if (currentOperation == Operation::SMAPE)
-        {
-            baseDefines.push_back("CALCULATE_SMAPE");
+            if (metricIndexes[metric] != UINT_MAX)
+            {
+                defines.push_back(
+                    std::string(kMetricDefines[metric]) + std::to_string(metricIndexes[metric]));
+            }
         }
-        else if (currentOperation == Operation::SSIM)
+        defines.push_back("METRIC_COUNT=" + std::to_string(metricCount));
+        std::vector<char const *> baseDefines;
+        baseDefines.reserve(defines.size());
+        for (auto const &define : defines)
         {
-            baseDefines.push_back("CALCULATE_SSIM");
+            baseDefines.push_back(define.c_str());
         }
         metricsKernel = gfxCreateComputeKernel(gfx, metricsProgram, "ComputeMetric", baseDefines.data(),
             static_cast<uint32_t>(baseDefines.size()));
     }
+    else
+    {
+        // Invalidate current values
+        for (auto &readback : readbackBuffers)
+        {
+            readback.totalSamples = 0;
+        }
+    }
+
     if (!reducer.initialise(gfx, shaderPaths, GPUReduce::Type::Float, GPUReduce::Operation::Sum))
     {
         return false;
@@ -151,50 +179,62 @@ bool GPUImageMetrics::initialise(GfxContext const &gfxIn, std::vector<std::strin
 }
 
 bool GPUImageMetrics::initialise(
-    CapsaicinInternal const &capsaicin, Type const type, Operation const operation) noexcept
+    CapsaicinInternal const &capsaicin, Type const type, std::vector<Operation> const &operations) noexcept
 {
-    return initialise(capsaicin.getGfx(), capsaicin.getShaderPaths(), type, operation);
+    return initialise(capsaicin.getGfx(), capsaicin.getShaderPaths(), type, operations);
 }
 
 bool GPUImageMetrics::compare(GfxTexture const &sourceImage, GfxTexture const &referenceImage) noexcept
 {
-    if (!compareInternal(sourceImage, referenceImage))
+    Readback &readback = readbackBuffers[0];
+    if (!compareInternal(sourceImage, referenceImage, readback))
     {
         return false;
     }
 
-    gfxCommandCopyBuffer(gfx, metricBufferTemp[0].second, 0, metricBuffer, 0, sizeof(float));
     // Force the operation to complete and then read back to CPU
+    readback.totalSamples = referenceImage.getWidth() * referenceImage.getHeight();
     gfxFinish(gfx);
-    auto const newValue = *gfxBufferGetData<float>(gfx, metricBufferTemp[0].second);
-    currentValue        = convertMetric(newValue, referenceImage.getWidth() * referenceImage.getHeight());
+    readValues(readback);
+    readback.totalSamples = 0;
     return true;
 }
 
 bool GPUImageMetrics::compareAsync(GfxTexture const &sourceImage, GfxTexture const &referenceImage) noexcept
 {
-    if (!compareInternal(sourceImage, referenceImage))
+    // Stream the results back to the CPU, all metrics are read back together
+    Readback &readback = readbackBuffers[gfxGetBackBufferIndex(gfx)];
+    if (readback.totalSamples != 0)
     {
-        return false;
+        readValues(readback);
+        readback.totalSamples = 0;
     }
 
-    // Stream the result back to the CPU
-    uint32_t const bufferIndex = gfxGetBackBufferIndex(gfx);
-    if (metricBufferTemp[bufferIndex].first != 0.0F)
+    if (!compareInternal(sourceImage, referenceImage, readback))
     {
-        auto const newValue = *gfxBufferGetData<float>(gfx, metricBufferTemp[bufferIndex].second);
-        currentValue        = convertMetric(newValue, referenceImage.getWidth() * referenceImage.getHeight());
+        return false;
     }
 
-    // Begin copy of new value (will take 'bufferIndex' number of frames to become valid)
-    gfxCommandCopyBuffer(gfx, metricBufferTemp[bufferIndex].second, 0, metricBuffer, 0, sizeof(float));
-    metricBufferTemp[bufferIndex].first = currentValue;
+    // Begin copy of new values (will take 'bufferIndex' number of frames to become valid)
+    readback.totalSamples = referenceImage.getWidth() * referenceImage.getHeight();
     return true;
 }
 
 float GPUImageMetrics::getMetricValue() const noexcept
 {
-    return currentValue;
+    return !currentValues.empty() ? currentValues[0] : 0.0F;
+}
+
+float GPUImageMetrics::getMetricValue(Operation const operation) const noexcept
+{
+    for (size_t i = 0; i < currentOperations.size() && i < currentValues.size(); ++i)
+    {
+        if (currentOperations[i] == operation)
+        {
+            return currentValues[i];
+        }
+    }
+    return 0.0F;
 }
 
 uint32_t GPUImageMetrics::getAsyncDelay() const noexcept
@@ -204,23 +244,29 @@ uint32_t GPUImageMetrics::getAsyncDelay() const noexcept
 
 void GPUImageMetrics::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx, metricBuffer);
+    for (auto &job : metricReduceJobs)
+    {
+        DestroyBuffer(gfx, job.buffer);
+    }
+    metricReduceJobs.clear();
+    DestroyBuffer(gfx, metricBuffer);
     metricBuffer = {};
-    for (auto &i : metricBufferTemp)
+    metricStride = 0;
+    for (auto &readback : readbackBuffers)
     {
-        gfxDestroyBuffer(gfx, i.second);
-        i.second = {};
+        DestroyBuffer(gfx, readback.buffer);
     }
-    metricBufferTemp.clear();
+    readbackBuffers.clear();
 
     gfxDestroyProgram(gfx, metricsProgram);
     metricsProgram = {};
     gfxDestroyKernel(gfx, metricsKernel);
     metricsKernel = {};
+    metricCount   = 0;
 }
 
 bool GPUImageMetrics::compareInternal(
-    GfxTexture const &sourceImage, GfxTexture const &referenceImage) noexcept
+    GfxTexture const &sourceImage, GfxTexture const &referenceImage, Readback const &readback) noexcept
 {
     if ((sourceImage.getWidth() != referenceImage.getWidth() && sourceImage.getWidth() != 0)
         || (sourceImage.getHeight() != referenceImage.getHeight() && sourceImage.getHeight() != 0))
@@ -234,12 +280,9 @@ bool GPUImageMetrics::compareInternal(
     uint32_t const  numGroupsY      = (dimensions[1] + numThreads[1] - 1) / numThreads[1];
     uint32_t const  numOutputValues = numGroupsX * numGroupsY;
 
-    if (metricBuffer.getCount() < numOutputValues)
+    if (numOutputValues != metricStride && !updateMetricBuffer(numOutputValues))
     {
-        std::string const bufferName = metricBuffer.getName();
-        gfxDestroyBuffer(gfx, metricBuffer);
-        metricBuffer = gfxCreateBuffer<float>(gfx, numOutputValues);
-        metricBuffer.setName(bufferName.c_str());
+        return false;
     }
 
     gfxProgramSetParameter(gfx, metricsProgram, "g_ImageDimensions", dimensions);
@@ -249,62 +292,78 @@ bool GPUImageMetrics::compareInternal(
 
     gfxProgramSetParameter(gfx, metricsProgram, "g_MetricBuffer", metricBuffer);
 
-    // Compute the metric
+    // Compute all metrics
     {
         gfxCommandBindKernel(gfx, metricsKernel);
         gfxCommandDispatch(gfx, numGroupsX, numGroupsY, 1);
     }
 
-    // Reduce to single value
+    // Reduce each metric to a single value
     if (numOutputValues > 1)
     {
-        if (!reducer.reduce(metricBuffer, numOutputValues))
+        if (!reducer.reduceBatch(metricReduceJobs))
         {
             return false;
         }
     }
 
+    // Gather the final value of each metric into the readback buffer
+    for (uint32_t metric = 0; metric < metricCount; ++metric)
+    {
+        gfxCommandCopyBuffer(gfx, readback.buffer, metric * sizeof(float), metricBuffer,
+            static_cast<uint64_t>(metric) * metricStride * sizeof(float), sizeof(float));
+    }
     return true;
 }
 
-float GPUImageMetrics::convertMetric(float const value, uint32_t const totalSamples) const noexcept
+bool GPUImageMetrics::updateMetricBuffer(uint32_t const stride) noexcept
 {
-    auto const totalPixels = static_cast<double>(totalSamples);
-    double     ret         = static_cast<double>(value) / totalPixels;
-    switch (currentOperation)
+    for (auto &job : metricReduceJobs)
     {
-    case Operation::MSE:
-        // MSE = [1/(width*height)]Sum([Ref.x.y - Src.x.y]^2)
-        break;
-    case Operation::RMSE:
-        // RMSE = sqrt(MSE)
-        ret = sqrt(ret);
-        break;
-    case Operation::PSNR:
-        // PSNR = 20log10(MaxValue) - 10log10(MSE)
-        if (currentType == Type::HDR || currentType == Type::HDR_RGB)
-        {
-            // MaxValue is set as 1.0f as we assume always using normalised float values
-            ret = -10.0 * log10(ret);
-        }
-        else
+        DestroyBuffer(gfx, job.buffer);
+    }
+    metricReduceJobs.clear();
+
+    // The buffer is only ever grown so that it can be reused when switching between resolutions
+    uint64_t const requiredCount = static_cast<uint64_t>(stride) * metricCount;
+    if (metricBuffer.getCount() < requiredCount)
+    {
+        DestroyBuffer(gfx, metricBuffer);
+        metricBuffer = CreateBuffer<float>(gfx, static_cast<uint32_t>(requiredCount));
+        metricBuffer.setName("GPUImageMetrics_MetricsBuffer");
+        if (!metricBuffer)
         {
-            // MaxValue is set as 255 for 8bit values
-            ret = 48.13080361 - 10.0 * log10(ret);
+            metricStride = 0;
+            return false;
         }
-        break;
-    case Operation::RMAE:
-        // RMAE = [1/(width*height)]Sum(Abs(Src.x.y - Ref.x.y)/Ref.x.y)
-        break;
-    case Operation::SMAPE:
-        // SMAPE = [100/(width*height)]Sum(Abs(Ref.x.y - Src.x.y)/([abs(Ref.x.y)+Abs(Src.x.y)]/2)
-        ret *= 100.0;
-        break;
-    case Operation::SSIM:
-        // SSIM =[1/(width*height)]Sum(SSIM(x,y))
-    default: break;
     }
-    return static_cast<float>(ret);
+
+    // Each metric is stored contiguously and reduced using a separate view of the buffer
+    for (uint32_t metric = 0; metric < metricCount; ++metric)
+    {
+        GPUReduce::Job job;
+        job.buffer  = gfxCreateBufferRange<float>(gfx, metricBuffer, metric * stride, stride);
+        job.numKeys = stride;
+        metricReduceJobs.push_back(job);
+    }
+    metricStride = stride;
+    return true;
 }
 
+void GPUImageMetrics::readValues(Readback const &readback) noexcept
+{
+    float const *values = gfxBufferGetData<float>(gfx, readback.buffer);
+    for (size_t i = 0; i < currentOperations.size(); ++i)
+    {
+        currentValues[i] =
+            convertMetric(currentOperations[i], values[operationMetrics[i]], readback.totalSamples);
+    }
+}
+
+float GPUImageMetrics::convertMetric(
+    Operation const operation, float const value, uint32_t const totalSamples) const noexcept
+{
+    return static_cast<float>(CPUImageMetrics::ConvertMetric(static_cast<double>(value), totalSamples,
+        static_cast<CPUImageMetrics::Type>(currentType), static_cast<CPUImageMetrics::Operation>(operation)));
+}
 } // namespace Capsaicin
@@ -59,9 +59,9 @@ class GPUImageMetrics
 
     /**
      * Initialise the internal data based on current configuration.
-     * @param gfxIn         Active gfx context.
+     * @param gfxIn       Active gfx context.
      * @param shaderPaths Paths to shader files based on current working directory.
-     * @param type        The object type to reduce.
+     * @param type        The type of data in the images.
      * @param operation   The type of operation to perform.
      * @return True, if any initialisation/changes succeeded.
      */
@@ -77,6 +77,28 @@ class GPUImageMetrics
      */
     bool initialise(CapsaicinInternal const &capsaicin, Type type, Operation operation) noexcept;
 
+    /**
+     * Initialise the internal data to calculate several metrics at once.
+     * All operations are calculated from a single pass over the images and read back together.
+     * @param gfxIn       Active gfx context.
+     * @param shaderPaths Paths to shader files based on current working directory.
+     * @param type        The type of data in the images.
+     * @param operations  The operations to perform.
+     * @return True, if any initialisation/changes succeeded.
+     */
+    bool initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPaths, Type type,
+        std::vector<Operation> const &operations) noexcept;
+
+    /**
+     * Initialise the internal data to calculate several metrics at once.
+     * @param capsaicin  Current framework context.
+     * @param type       The type of data in the images.
+     * @param operations The operations to perform.
+     * @return True, if any initialisation/changes succeeded.
+     */
+    bool initialise(
+        CapsaicinInternal const &capsaicin, Type type, std::vector<Operation> const &operations) noexcept;
+
     /**
      * Generate comparison metrics for 2 different images.
      * @note This will flush the current GPU pipeline so only call this function is no other work is to be
@@ -100,10 +122,17 @@ class GPUImageMetrics
      * Read back the value of the most recent calculated metric.
      * @note When using 'compareAsync' there will be a delay before the final value is available. This delay
      * can be retrieved using 'getAsyncDelay'.
-     * @return The calculated metric value, Zero if no value is available.
+     * @return The calculated value of the first requested operation, Zero if no value is available.
      */
     [[nodiscard]] float getMetricValue() const noexcept;
 
+    /**
+     * Read back the value of the most recent calculated metric.
+     * @param operation The operation to get the value of.
+     * @return The calculated metric value, Zero if no value is available or the operation was not requested.
+     */
+    [[nodiscard]] float getMetricValue(Operation operation) const noexcept;
+
     /**
      * Get the number of frames of delay there is when using 'compareAsync'.
      * @return The number of frames worth of delay.
@@ -114,19 +143,50 @@ class GPUImageMetrics
     /** Terminates and cleans up this object. */
     void terminate() noexcept;
 
-    bool compareInternal(GfxTexture const &sourceImage, GfxTexture const &referenceImage) noexcept;
+    /**
+     * Resize the metric buffer and its per metric views.
+     * @param stride Number of values stored for each metric (i.e. number of metric thread groups).
+     * @return True, if operation succeeded.
+     */
+    bool updateMetricBuffer(uint32_t stride) noexcept;
+
+    /** Buffer used to copy back all calculated metrics into CPU memory */
+    struct Readback
+    {
+        GfxBuffer buffer;
+        uint32_t  totalSamples = 0; /**< Number of pixels compared by the copy in flight, 0 if none */
+    };
+
+    /**
+     * Read back and convert the values of all requested operations.
+     * @param readback The readback buffer containing the calculated metrics.
+     */
+    void readValues(Readback const &readback) noexcept;
+
+    /**
+     * Calculate all metrics and copy them to a readback buffer.
+     * @param sourceImage    The input image to compare.
+     * @param referenceImage The reference image to compare to.
+     * @param readback       The readback buffer to copy the metrics to.
+     * @return True, if operation succeeded.
+     */
+    bool compareInternal(
+        GfxTexture const &sourceImage, GfxTexture const &referenceImage, Readback const &readback) noexcept;
 
-    [[nodiscard]] float convertMetric(float value, uint32_t totalSamples) const noexcept;
+    [[nodiscard]] float convertMetric(Operation operation, float value, uint32_t totalSamples) const noexcept;
 
     GfxContext gfx;
 
-    Type      currentType      = Type::HDR_RGB;
-    Operation currentOperation = Operation::RMSE;
+    Type                   currentType       = Type::HDR_RGB;
+    std::vector<Operation> currentOperations = {Operation::RMSE};
+    std::vector<uint32_t>  operationMetrics;      /**< Index of the metric used by each operation */
+    uint32_t               metricCount       = 0; /**< Number of metrics calculated by the kernel */
 
-    GfxBuffer metricBuffer; /**< Buffer used to hold calculated metric */
-    std::vector<std::pair<float, GfxBuffer>>
-          metricBufferTemp;    /**< Buffer used to copy back calculated metric into CPU memory */
-    float currentValue = 1.0F; /**< Most recent calculated metric value */
+    GfxBuffer                   metricBuffer;     /**< Buffer used to hold calculated metrics */
+    uint32_t                    metricStride = 0; /**< Number of values of each metric within metricBuffer */
+    std::vector<GPUReduce::Job> metricReduceJobs; /**< Reduction of each metric's view within metricBuffer */
+    std::vector<Readback>       readbackBuffers;  /**< Ring of readback buffers, one per back buffer */
+    std::vector<float>          currentValues;    /**< Most recent calculated value of each operation */
 
     GfxProgram metricsProgram;
     GfxKernel  metricsKernel;
@@ -0,0 +1,183 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "gpu_lut_cache.h"
+
+#include "capsaicin_internal.h"
+#include "gpu_readback.h"
+
+namespace Capsaicin
+{
+GPULutCache::~GPULutCache() noexcept
+{
+    terminate();
+}
+
+bool GPULutCache::initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPaths) noexcept
+{
+    gfx = gfxIn;
+
+    if (!lutProgram)
+    {
+        std::vector<char const *> includePaths;
+        includePaths.reserve(shaderPaths.size());
+        for (auto const &path : shaderPaths)
+        {
+            includePaths.push_back(path.c_str());
+        }
+        lutProgram = gfxCreateProgram(gfx, "utilities/gpu_lut_cache", includePaths[0], nullptr,
+            includePaths.data(), static_cast<uint32_t>(includePaths.size()));
+        char const *arrayDefine = "TEXTURE_ARRAY";
+        packKernel              = gfxCreateComputeKernel(gfx, lutProgram, "Pack");
+        packArrayKernel         = gfxCreateComputeKernel(gfx, lutProgram, "Pack", &arrayDefine, 1);
+        unpackKernel            = gfxCreateComputeKernel(gfx, lutProgram, "Unpack");
+        unpackArrayKernel       = gfxCreateComputeKernel(gfx, lutProgram, "Unpack", &arrayDefine, 1);
+    }
+
+    return isValid();
+}
+
+bool GPULutCache::initialise(CapsaicinInternal const &capsaicin) noexcept
+{
+    return initialise(capsaicin.getGfx(), capsaicin.getShaderPaths());
+}
+
+bool GPULutCache::isValid() const noexcept
+{
+    return !!packKernel && !!packArrayKernel && !!unpackKernel && !!unpackArrayKernel;
+}
+
+bool GPULutCache::GetDescription(GfxTexture const &texture, LutCache::Description &description) noexcept
+{
+    description        = {};
+    description.format = static_cast<uint32_t>(texture.getFormat());
+    switch (texture.getFormat())
+    {
+    case DXGI_FORMAT_R16G16_FLOAT: description.bytesPerTexel = 4; break;
+    case DXGI_FORMAT_R16G16B16A16_FLOAT: description.bytesPerTexel = 8; break;
+    default: return false;
+    }
+    description.width      = texture.getWidth();
+    description.height     = texture.getHeight();
+    description.sliceCount = texture.getDepth();
+    description.mipCount   = texture.getMipLevels();
+    return description.width > 0 && description.height > 0 && description.sliceCount > 0
+        && description.mipCount > 0;
+}
+
+bool GPULutCache::load(LutCache const &cache, LutCache::Key const &key, GfxTexture const &texture) noexcept
+{
+    LutCache::Description expected;
+    if (!GetDescription(texture, expected))
+    {
+        return false;
+    }
+    LutCache::Description  description;
+    std::vector<std::byte> data;
+    if (!cache.load(key, description, data) || description != expected)
+    {
+        return false;
+    }
+    return upload(texture, data);
+}
+
+bool GPULutCache::upload(GfxTexture const &texture, std::span<std::byte const> const data) noexcept
+{
+    LutCache::Description description;
+    if (!GetDescription(texture, description) || data.size() != description.getSize())
+    {
+        GFX_PRINT_ERROR(kGfxResult_InvalidParameter, "Texture data does not match texture layout");
+        return false;
+    }
+    GfxBuffer const buffer = CreateBuffer(gfx, data.size(), data.data());
+    dispatch(texture, description, buffer, true);
+    // Buffer destruction is deferred until the GPU has finished using it
+    DestroyBuffer(gfx, buffer);
+    return true;
+}
+
+bool GPULutCache::save(
+    CapsaicinInternal const &capsaicin, LutCache::Key const &key, GfxTexture const &texture) noexcept
+{
+    LutCache &cache = capsaicin.getLutCache();
+    if (cache.getDirectory().empty())
+    {
+        return true;
+    }
+    LutCache::Description description;
+    if (!GetDescription(texture, description))
+    {
+        GFX_PRINT_ERROR(kGfxResult_InvalidParameter, "Texture format cannot be cached");
+        return false;
+    }
+    GfxBuffer buffer = CreateBuffer(gfx, description.getSize());
+    buffer.setName("GPULutCache_Buffer");
+    dispatch(texture, description, buffer, false);
+    bool const ret = GPUReadback::ReadbackAsync(capsaicin, buffer, 0, description.getSize(),
+        [&cache, key, description](void const *data, uint64_t const size) {
+            auto const *bytes = static_cast<std::byte const *>(data);
+            cache.saveAsync(key, description, std::vector(bytes, bytes + size));
+        });
+    DestroyBuffer(gfx, buffer);
+    return ret;
+}
+
+void GPULutCache::terminate() noexcept
+{
+    gfxDestroyKernel(gfx, packKernel);
+    packKernel = {};
+    gfxDestroyKernel(gfx, packArrayKernel);
+    packArrayKernel = {};
+    gfxDestroyKernel(gfx, unpackKernel);
+    unpackKernel = {};
+    gfxDestroyKernel(gfx, unpackArrayKernel);
+    unpackArrayKernel = {};
+    gfxDestroyProgram(gfx, lutProgram);
+    lutProgram = {};
+}
+
+void GPULutCache::dispatch(GfxTexture const &texture, LutCache::Description const &description,
+    GfxBuffer const &buffer, bool const unpack) noexcept
+{
+    bool const      array  = description.sliceCount > 1;
+    GfxKernel const kernel = unpack ? (array ? unpackArrayKernel : unpackKernel)
+                                    : (array ? packArrayKernel : packKernel);
+
+    uint32_t const *numThreads = gfxKernelGetNumThreads(gfx, kernel);
+    gfxProgramSetParameter(gfx, lutProgram, "g_Buffer", buffer);
+    gfxProgramSetParameter(gfx, lutProgram, "g_TexelSize", description.bytesPerTexel / 4);
+    gfxCommandBindKernel(gfx, kernel);
+    for (uint32_t mip = 0; mip < description.mipCount; ++mip)
+    {
+        uint3 const dimensions(glm::max(description.width >> mip, 1U),
+            glm::max(description.height >> mip, 1U), description.sliceCount);
+        gfxProgramSetParameter(gfx, lutProgram, "g_Texture", texture, mip);
+        gfxProgramSetParameter(gfx, lutProgram, "g_Dimensions", dimensions);
+        gfxProgramSetParameter(
+            gfx, lutProgram, "g_BufferOffset", static_cast<uint32_t>(description.getMipOffset(mip) / 4));
+
+        uint32_t const numGroupsX = (dimensions.x + numThreads[0] - 1) / numThreads[0];
+        uint32_t const numGroupsY = (dimensions.y + numThreads[1] - 1) / numThreads[1];
+        gfxCommandDispatch(gfx, numGroupsX, numGroupsY, dimensions.z);
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,122 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "gpu_shared.h"
+#include "lut_cache.h"
+
+#include <gfx.h>
+
+namespace Capsaicin
+{
+class CapsaicinInternal;
+
+/** A helper utility class to load lookup textures from, and save them to, a LutCache. */
+class GPULutCache
+{
+public:
+    /** Defaulted constructor. */
+    GPULutCache() noexcept = default;
+
+    /** Destructor. */
+    ~GPULutCache() noexcept;
+
+    GPULutCache(GPULutCache const &other)                = delete;
+    GPULutCache(GPULutCache &&other) noexcept            = delete;
+    GPULutCache &operator=(GPULutCache const &other)     = delete;
+    GPULutCache &operator=(GPULutCache &&other) noexcept = delete;
+
+    /**
+     * Initialise the internal data based on current configuration.
+     * @param gfxIn       Active gfx context.
+     * @param shaderPaths Path to shader files based on current working directory.
+     * @return True, if any initialisation/changes succeeded.
+     */
+    bool initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPaths) noexcept;
+
+    /**
+     * Initialise the internal data based on current configuration.
+     * @param capsaicin Current framework context.
+     * @return True, if any initialisation/changes succeeded.
+     */
+    bool initialise(CapsaicinInternal const &capsaicin) noexcept;
+
+    /** Destroy any used internal resources. */
+    void terminate() noexcept;
+
+    /**
+     * Check if the pack and unpack kernels were successfully created.
+     * @return True if textures can be loaded and saved, False otherwise.
+     */
+    [[nodiscard]] bool isValid() const noexcept;
+
+    /**
+     * Gets the cache layout of a texture.
+     * @note Only 2 and 4 channel half precision 2D and cube textures are supported.
+     * @param texture     The texture.
+     * @param description Output description of the texture.
+     * @return True if the texture can be cached, False otherwise.
+     */
+    static bool GetDescription(GfxTexture const &texture, LutCache::Description &description) noexcept;
+
+    /**
+     * Load a cache entry into a texture.
+     * @param cache   The cache to load from.
+     * @param key     The key identifying the entry.
+     * @param texture The texture to write to, must match the layout of the cached entry.
+     * @return True if successful, False if there is no valid entry (the texture is left unchanged).
+     */
+    bool load(LutCache const &cache, LutCache::Key const &key, GfxTexture const &texture) noexcept;
+
+    /**
+     * Upload texture data laid out as described by GetDescription.
+     * @param texture The texture to write to.
+     * @param data    The texture data.
+     * @return True if successful, False otherwise.
+     */
+    bool upload(GfxTexture const &texture, std::span<std::byte const> data) noexcept;
+
+    /**
+     * Save the contents of a texture to the frameworks cache.
+     * @note The texture is read back asynchronously and written to disk on a background thread so the
+     * contents must be complete at the time of the call but may be modified immediately afterwards.
+     * @param capsaicin Current framework context.
+     * @param key       The key identifying the entry.
+     * @param texture   The texture to save.
+     * @return True if successful, False otherwise.
+     */
+    bool save(
+        CapsaicinInternal const &capsaicin, LutCache::Key const &key, GfxTexture const &texture) noexcept;
+
+private:
+    void dispatch(GfxTexture const &texture, LutCache::Description const &description,
+        GfxBuffer const &buffer, bool unpack) noexcept;
+
+    GfxContext gfx;
+
+    GfxProgram lutProgram;
+    GfxKernel  packKernel;
+    GfxKernel  packArrayKernel;
+    GfxKernel  unpackKernel;
+    GfxKernel  unpackArrayKernel;
+};
+} // namespace Capsaicin
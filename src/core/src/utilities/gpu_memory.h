@@ -0,0 +1,184 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "capsaicin_internal_types.h"
+#include "memory_tracker.h"
+
+#include <algorithm>
+#include <gfx.h>
+
+namespace Capsaicin
+{
+/*
+ * Wrappers around gfx resource creation/destruction that record each allocation with the memory tracker.
+ * Allocations are attributed to the owner of the current MemoryTracker::OwnerScope.
+ */
+
+/**
+ * Gets the key used to identify a buffer within the memory tracker.
+ * @param buffer The buffer.
+ * @return The key.
+ */
+inline uint64_t GetMemoryKey(GfxBuffer const &buffer) noexcept
+{
+    return MemoryTracker::GetBufferKey(buffer.getIndex());
+}
+
+/**
+ * Gets the key used to identify a texture within the memory tracker.
+ * @param texture The texture.
+ * @return The key (textures and buffers use separate key ranges).
+ */
+inline uint64_t GetMemoryKey(GfxTexture const &texture) noexcept
+{
+    return MemoryTracker::GetTextureKey(texture.getIndex());
+}
+
+/**
+ * Calculate the approximate memory footprint of a texture.
+ * @note Does not include any driver padding or alignment.
+ * @param gfx     Active gfx context.
+ * @param texture The texture.
+ * @param depth   The number of slices at the top mip level.
+ * @param is3D    True if slices are reduced along with each mip level.
+ * @return The size of the texture (bytes).
+ */
+inline uint64_t GetTextureMemorySize(
+    GfxContext const &gfx, GfxTexture const &texture, uint32_t const depth, bool const is3D) noexcept
+{
+    // Window sized textures report a width/height of zero
+    uint64_t const width  = texture.getWidth() > 0 ? texture.getWidth() : gfxGetBackBufferWidth(gfx);
+    uint64_t const height = texture.getHeight() > 0 ? texture.getHeight() : gfxGetBackBufferHeight(gfx);
+    uint64_t       pixels = 0;
+    for (uint32_t mip = 0; mip < std::max(texture.getMipLevels(), 1U); ++mip)
+    {
+        pixels += std::max(width >> mip, uint64_t {1}) * std::max(height >> mip, uint64_t {1})
+                * (is3D ? std::max(static_cast<uint64_t>(depth) >> mip, uint64_t {1}) : depth);
+    }
+    return pixels * GetBitsPerPixel(texture.getFormat()) / 8;
+}
+
+/**
+ * Records a newly created texture with the memory tracker.
+ * @param gfx     Active gfx context.
+ * @param texture The texture.
+ * @param depth   The number of slices at the top mip level.
+ * @param is3D    True if slices are reduced along with each mip level.
+ * @return The texture.
+ */
+inline GfxTexture TrackTexture(
+    GfxContext const &gfx, GfxTexture const &texture, uint32_t const depth, bool const is3D) noexcept
+{
+    if (texture)
+    {
+        MemoryTracker::Get().addAllocation(
+            GetMemoryKey(texture), GetTextureMemorySize(gfx, texture, depth, is3D), false);
+    }
+    return texture;
+}
+
+/**
+ * Records a newly created buffer with the memory tracker.
+ * @param buffer The buffer.
+ * @return The buffer.
+ */
+inline GfxBuffer TrackBuffer(GfxBuffer const &buffer) noexcept
+{
+    if (buffer)
+    {
+        MemoryTracker::Get().addAllocation(
+            GetMemoryKey(buffer), buffer.getSize(), buffer.getCpuAccess() != kGfxCpuAccess_None);
+    }
+    return buffer;
+}
+
+/** Tracked equivalent of gfxCreateBuffer. */
+inline GfxBuffer CreateBuffer(GfxContext const &gfx, uint64_t const size, void const *data = nullptr,
+    GfxCpuAccess const cpuAccess = kGfxCpuAccess_None) noexcept
+{
+    return TrackBuffer(gfxCreateBuffer(gfx, size, data, cpuAccess));
+}
+
+/** Tracked equivalent of gfxCreateBuffer<TYPE>. */
+template<typename TYPE>
+GfxBuffer CreateBuffer(GfxContext const &gfx, uint32_t const elementCount, void const *elementData = nullptr,
+    GfxCpuAccess const cpuAccess = kGfxCpuAccess_None) noexcept
+{
+    return TrackBuffer(gfxCreateBuffer<TYPE>(gfx, elementCount, elementData, cpuAccess));
+}
+
+/** Tracked equivalent of gfxCreateTexture2D for window sized textures. */
+inline GfxTexture CreateTexture2D(
+    GfxContext const &gfx, DXGI_FORMAT const format, float const *clearValue = nullptr) noexcept
+{
+    return TrackTexture(gfx, gfxCreateTexture2D(gfx, format, clearValue), 1, false);
+}
+
+/** Tracked equivalent of gfxCreateTexture2D. */
+inline GfxTexture CreateTexture2D(GfxContext const &gfx, uint32_t const width, uint32_t const height,
+    DXGI_FORMAT const format, uint32_t const mipLevels = 1, float const *clearValue = nullptr) noexcept
+{
+    return TrackTexture(
+        gfx, gfxCreateTexture2D(gfx, width, height, format, mipLevels, clearValue), 1, false);
+}
+
+/** Tracked equivalent of gfxCreateTexture3D. */
+inline GfxTexture CreateTexture3D(GfxContext const &gfx, uint32_t const width, uint32_t const height,
+    uint32_t const depth, DXGI_FORMAT const format, uint32_t const mipLevels = 1,
+    float const *clearValue = nullptr) noexcept
+{
+    return TrackTexture(
+        gfx, gfxCreateTexture3D(gfx, width, height, depth, format, mipLevels, clearValue), depth, true);
+}
+
+/** Tracked equivalent of gfxCreateTextureCube. */
+inline GfxTexture CreateTextureCube(GfxContext const &gfx, uint32_t const size, DXGI_FORMAT const format,
+    uint32_t const mipLevels = 1, float const *clearValue = nullptr) noexcept
+{
+    return TrackTexture(gfx, gfxCreateTextureCube(gfx, size, format, mipLevels, clearValue), 6, false);
+}
+
+/**
+ * Tracked equivalent of gfxDestroyBuffer.
+ * @note Range views created with gfxCreateBufferRange alias the memory of their parent buffer and are
+ * deliberately not tracked, they are still destroyed using this function (which then only releases the view).
+ */
+inline GfxResult DestroyBuffer(GfxContext const &gfx, GfxBuffer const &buffer) noexcept
+{
+    if (buffer)
+    {
+        MemoryTracker::Get().removeAllocation(GetMemoryKey(buffer));
+    }
+    return gfxDestroyBuffer(gfx, buffer);
+}
+
+/** Tracked equivalent of gfxDestroyTexture. */
+inline GfxResult DestroyTexture(GfxContext const &gfx, GfxTexture const &texture) noexcept
+{
+    if (texture)
+    {
+        MemoryTracker::Get().removeAllocation(GetMemoryKey(texture));
+    }
+    return gfxDestroyTexture(gfx, texture);
+}
+} // namespace Capsaicin
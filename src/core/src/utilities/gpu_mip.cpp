@@ -23,6 +23,7 @@ THE SOFTWARE.
 #include "gpu_mip.h"
 
 #include "capsaicin_internal.h"
+#include "cpu_mip.h"
 
 #define FFX_CPU
 #include <FidelityFX/gpu/ffx_core.h>
@@ -32,6 +33,9 @@ THE SOFTWARE.
 
 namespace Capsaicin
 {
+// The CPU implementation uses matching type values
+static_assert(static_cast<uint8_t>(GPUMip::Type::DepthMax) == static_cast<uint8_t>(CPUMip::Type::DepthMax));
+
 GPUMip::~GPUMip() noexcept
 {
     terminate();
@@ -128,9 +132,9 @@ void GPUMip::terminate() noexcept
     mipProgramNonPower2 = {};
     gfxDestroyKernel(gfx, mipKernelNonPower2);
     mipKernelNonPower2 = {};
-    gfxDestroyBuffer(gfx, mipTempBuffer);
+    DestroyBuffer(gfx, mipTempBuffer);
     mipTempBuffer = {};
-    gfxDestroyBuffer(gfx, mipSPDCountBuffer);
+    DestroyBuffer(gfx, mipSPDCountBuffer);
     mipSPDCountBuffer = {};
 }
 
@@ -196,10 +200,10 @@ bool GPUMip::mipInternal(GfxTexture const &inputTexture, GfxTexture const &outpu
 
             if (!mipTempBuffer)
             {
-                mipTempBuffer = gfxCreateBuffer<SPDConstants>(gfx, 1, nullptr, kGfxCpuAccess_Write);
+                mipTempBuffer = CreateBuffer<SPDConstants>(gfx, 1, nullptr, kGfxCpuAccess_Write);
                 mipTempBuffer.setName("GPUMip_SPDConstants");
                 constexpr uint32_t clearValue = 0;
-                mipSPDCountBuffer             = gfxCreateBuffer<uint32_t>(gfx, 1, &clearValue);
+                mipSPDCountBuffer             = CreateBuffer<uint32_t>(gfx, 1, &clearValue);
                 mipSPDCountBuffer.setName("Capsaicin_SPDCounterBuffer");
             }
             gfxBufferGetData<SPDConstants>(gfx, mipTempBuffer)[0] = constantsSPD;
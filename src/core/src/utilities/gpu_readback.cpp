@@ -26,8 +26,10 @@ THE SOFTWARE.
 namespace Capsaicin
 {
 GPUReadback::GPUReadback() noexcept
-    : readback_frame_index_(0)
+    : readback_pool_(nullptr)
+    , readback_frame_index_(0)
     , readback_buffer_index_(0)
+    , readback_size_(0)
     , readback_buffer_data_(nullptr)
 {}
 
@@ -38,33 +40,31 @@ GPUReadback::~GPUReadback() noexcept
 
 void const *GPUReadback::readback(CapsaicinInternal const &capsaicin, GfxBuffer const &buffer) noexcept
 {
-    if (!*readback_buffers_ || readback_buffers_->getSize() != buffer.getSize())
+    if (!*readback_buffers_ || readback_size_ != buffer.getSize())
     {
-        gfx_ = capsaicin.getGfx();
+        clear();
+        gfx_           = capsaicin.getGfx();
+        readback_pool_ = &capsaicin.getReadbackPool();
+        readback_size_ = buffer.getSize();
 
-        free(readback_buffer_data_);
-        readback_buffer_data_ = malloc(buffer.getSize());
+        readback_buffer_data_ = malloc(readback_size_);
         if (readback_buffer_data_ == nullptr)
         {
             return nullptr;
         }
-        memset(readback_buffer_data_, 0, buffer.getSize());
+        memset(readback_buffer_data_, 0, readback_size_);
 
-        for (uint32_t i = 0; i < ARRAYSIZE(readback_buffers_); ++i)
+        for (GfxBuffer &readback_buffer : readback_buffers_)
         {
-            char name[64];
-            GFX_SNPRINTF(name, sizeof(name), "Capsaicin_ReadbackBuffer%u", i);
-
-            gfxDestroyBuffer(gfx_, readback_buffers_[i]);
-
-            readback_buffers_[i] =
-                gfxCreateBuffer(gfx_, buffer.getSize(), readback_buffer_data_, kGfxCpuAccess_Read);
-            readback_buffers_[i].setStride(buffer.getStride());
-            readback_buffers_[i].setName(name);
-
-            readback_frame_index_  = capsaicin.getFrameIndex() - 1;
-            readback_buffer_index_ = 0; // reset cursor
+            readback_buffer = readback_pool_->acquire(readback_size_);
+            if (!readback_buffer)
+            {
+                clear();
+                return nullptr;
+            }
         }
+        readback_frame_index_  = capsaicin.getFrameIndex() - 1;
+        readback_buffer_index_ = 0; // reset cursor
     }
 
     if (hasReadback(capsaicin)) // only read back if we've advanced to a new frame
@@ -74,10 +74,11 @@ void const *GPUReadback::readback(CapsaicinInternal const &capsaicin, GfxBuffer
 
         if (readback_buffer_index_ >= ARRAYSIZE(readback_buffers_))
         {
-            memcpy(readback_buffer_data_, gfxBufferGetData(gfx_, readback_buffer), buffer.getSize());
+            memcpy(readback_buffer_data_, gfxBufferGetData(gfx_, readback_buffer), readback_size_);
         }
 
-        gfxCommandCopyBuffer(gfx_, readback_buffer, buffer);
+        // Pooled buffers may be larger than the source so only the source range is copied
+        gfxCommandCopyBuffer(gfx_, readback_buffer, 0, buffer, 0, readback_size_);
 
         if (++readback_buffer_index_ >= 2 * ARRAYSIZE(readback_buffers_))
         {
@@ -90,6 +91,12 @@ void const *GPUReadback::readback(CapsaicinInternal const &capsaicin, GfxBuffer
     return readback_buffer_data_;
 }
 
+bool GPUReadback::ReadbackAsync(CapsaicinInternal const &capsaicin, GfxBuffer const &buffer,
+    uint64_t const offset, uint64_t const size, ReadbackPool::Callback callback) noexcept
+{
+    return capsaicin.getReadbackPool().readback(buffer, offset, size, std::move(callback));
+}
+
 bool GPUReadback::hasReadback(CapsaicinInternal const &capsaicin) const noexcept
 {
     return readback_frame_index_ != capsaicin.getFrameIndex();
@@ -99,7 +106,10 @@ void GPUReadback::reset() noexcept
 {
     readback_buffer_index_ = 0; // reset cursor
 
-    memset(readback_buffer_data_, 0, readback_buffers_->getSize());
+    if (readback_buffer_data_ != nullptr)
+    {
+        memset(readback_buffer_data_, 0, readback_size_);
+    }
 }
 
 void GPUReadback::clear() noexcept
@@ -109,8 +119,12 @@ void GPUReadback::clear() noexcept
 
     for (GfxBuffer &readback_buffer : readback_buffers_)
     {
-        gfxDestroyBuffer(gfx_, readback_buffer);
+        if (readback_pool_ != nullptr)
+        {
+            readback_pool_->release(readback_buffer);
+        }
         readback_buffer = {};
     }
+    readback_size_ = 0;
 }
 } // namespace Capsaicin
@@ -22,6 +22,7 @@ THE SOFTWARE.
 #pragma once
 
 #include "gpu_shared.h"
+#include "readback_pool.h"
 
 #include <gfx.h>
 
@@ -65,6 +66,18 @@ class GPUReadback
      */
     void const *readback(CapsaicinInternal const &capsaicin, GfxBuffer const &buffer) noexcept;
 
+    /**
+     * Asynchronously reads back a range of GPU data.
+     * @param capsaicin Current framework context.
+     * @param buffer    The buffer to be read.
+     * @param offset    Offset of the range within the buffer (bytes).
+     * @param size      Size of the range (bytes).
+     * @param callback  Called with the requested data once it is available (several frames later).
+     * @return True if successful, False otherwise.
+     */
+    static bool ReadbackAsync(CapsaicinInternal const &capsaicin, GfxBuffer const &buffer, uint64_t offset,
+        uint64_t size, ReadbackPool::Callback callback) noexcept;
+
     /**
      * Check whether some readback information is available.
      * @return true if new readback information is available.
@@ -78,12 +91,14 @@ class GPUReadback
     void clear() noexcept;
 
 private:
-    GfxContext gfx_; //
+    GfxContext    gfx_;           //
+    ReadbackPool *readback_pool_; /**< Pool that the readback buffers were acquired from */
 
     uint32_t readback_frame_index_;  //
     uint32_t readback_buffer_index_; //
 
     GfxBuffer readback_buffers_[kGfxConstant_BackBufferCount]; //
+    uint64_t  readback_size_;                                  /**< Size of the read back data (bytes) */
     void     *readback_buffer_data_;                           //
 };
 } // namespace Capsaicin
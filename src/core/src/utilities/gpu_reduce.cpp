@@ -23,9 +23,72 @@ THE SOFTWARE.
 #include "gpu_reduce.h"
 
 #include "capsaicin_internal.h"
+#include "cpu_reduce.h"
+
+#include <array>
+#include <ranges>
 
 namespace Capsaicin
 {
+// The CPU reference uses matching type and operation values and the same block size
+static_assert(
+    static_cast<uint8_t>(GPUReduce::Type::Double4) == static_cast<uint8_t>(CPUReduce::Type::Double4));
+static_assert(static_cast<uint8_t>(GPUReduce::Operation::Product)
+              == static_cast<uint8_t>(CPUReduce::Operation::Product));
+
+namespace
+{
+constexpr uint kGroupSize     = 256; // Must match GROUP_SIZE in shader
+constexpr uint kKeysPerThread = 4;   // Must match KEYS_PER_THREAD in shader
+constexpr uint kKeysPerGroup  = kGroupSize * kKeysPerThread;
+static_assert(kKeysPerGroup == CPUReduce::kKeysPerGroup);
+
+/** Maximum number of passes used by a reduction */
+constexpr uint kMaxPasses = 3;
+
+/** Job offset used to read/write the job's own buffer instead of scratch, must match BATCH_JOB_BUFFER */
+constexpr uint kBatchJobBuffer = 0xFFFFFFFFU;
+
+std::vector<char const *> GetDefines(GPUReduce::Type const type, GPUReduce::Operation const operation)
+{
+    std::vector<char const *> baseDefines;
+    switch (type)
+    {
+    case GPUReduce::Type::Float: baseDefines.push_back("TYPE=float"); break;
+    case GPUReduce::Type::Float2: baseDefines.push_back("TYPE=float2"); break;
+    case GPUReduce::Type::Float3: baseDefines.push_back("TYPE=float3"); break;
+    case GPUReduce::Type::Float4: baseDefines.push_back("TYPE=float4"); break;
+    case GPUReduce::Type::UInt: baseDefines.push_back("TYPE=uint"); break;
+    case GPUReduce::Type::UInt2: baseDefines.push_back("TYPE=uint2"); break;
+    case GPUReduce::Type::UInt3: baseDefines.push_back("TYPE=uint3"); break;
+    case GPUReduce::Type::UInt4: baseDefines.push_back("TYPE=uint4"); break;
+    case GPUReduce::Type::Int: baseDefines.push_back("TYPE=int"); break;
+    case GPUReduce::Type::Int2: baseDefines.push_back("TYPE=int2"); break;
+    case GPUReduce::Type::Int3: baseDefines.push_back("TYPE=int3"); break;
+    case GPUReduce::Type::Int4: baseDefines.push_back("TYPE=int4"); break;
+    case GPUReduce::Type::Double: baseDefines.push_back("TYPE=double"); break;
+    case GPUReduce::Type::Double2: baseDefines.push_back("TYPE=double2"); break;
+    case GPUReduce::Type::Double3: baseDefines.push_back("TYPE=double3"); break;
+    case GPUReduce::Type::Double4: baseDefines.push_back("TYPE=double4"); break;
+    default: break;
+    }
+    switch (operation)
+    {
+    case GPUReduce::Operation::Sum: baseDefines.push_back("OP=0"); break;
+    case GPUReduce::Operation::Min: baseDefines.push_back("OP=1"); break;
+    case GPUReduce::Operation::Max: baseDefines.push_back("OP=2"); break;
+    case GPUReduce::Operation::Product: baseDefines.push_back("OP=3"); break;
+    }
+    return baseDefines;
+}
+
+uint64_t GetTypeSize(GPUReduce::Type const type) noexcept
+{
+    return ((static_cast<uint64_t>(type) % 4) + 1)
+         * (type >= GPUReduce::Type::Double ? sizeof(double) : sizeof(float));
+}
+} // unnamed namespace
+
 GPUReduce::~GPUReduce() noexcept
 {
     terminate();
@@ -39,18 +102,18 @@ bool GPUReduce::initialise(GfxContext const &gfxIn, std::vector<std::string> con
     if (!indirectBuffer)
     {
         // Free just in case
-        gfxDestroyBuffer(gfx, indirectBuffer);
-        gfxDestroyBuffer(gfx, indirectBuffer2);
-        gfxDestroyBuffer(gfx, indirectCountBuffer);
-        gfxDestroyBuffer(gfx, indirectCountBuffer2);
+        DestroyBuffer(gfx, indirectBuffer);
+        DestroyBuffer(gfx, indirectBuffer2);
+        DestroyBuffer(gfx, indirectCountBuffer);
+        DestroyBuffer(gfx, indirectCountBuffer2);
         // Create required buffers
-        indirectBuffer = gfxCreateBuffer<uint>(gfx, 4);
+        indirectBuffer = CreateBuffer<uint>(gfx, 4);
         indirectBuffer.setName("Capsaicin_Reduce_IndirectBuffer");
-        indirectBuffer2 = gfxCreateBuffer<uint>(gfx, 4);
+        indirectBuffer2 = CreateBuffer<uint>(gfx, 4);
         indirectBuffer2.setName("Capsaicin_Reduce_IndirectBuffer2");
-        indirectCountBuffer = gfxCreateBuffer<uint>(gfx, 1);
+        indirectCountBuffer = CreateBuffer<uint>(gfx, 1);
         indirectCountBuffer.setName("Capsaicin_Reduce_IndirectCountBuffer");
-        indirectCountBuffer2 = gfxCreateBuffer<uint>(gfx, 1);
+        indirectCountBuffer2 = CreateBuffer<uint>(gfx, 1);
         indirectCountBuffer2.setName("Capsaicin_Reduce_IndirectCountBuffer2");
     }
 
@@ -62,6 +125,15 @@ bool GPUReduce::initialise(GfxContext const &gfxIn, std::vector<std::string> con
         gfxDestroyKernel(gfx, reduceKernel);
         reduceKernel = {};
     }
+    if (!reduceProgram)
+    {
+        // Batch kernels belong to the program so must be recreated along with it
+        for (auto &kernel : batchKernels | std::views::values)
+        {
+            gfxDestroyKernel(gfx, kernel);
+        }
+        batchKernels.clear();
+    }
     currentType      = type;
     currentOperation = operation;
     if (!reduceProgram)
@@ -79,34 +151,7 @@ bool GPUReduce::initialise(GfxContext const &gfxIn, std::vector<std::string> con
         }
         reduceProgram = gfxCreateProgram(gfx, "utilities/gpu_reduce", includePaths[0], nullptr,
             includePaths.data(), static_cast<uint32_t>(includePaths.size()));
-        std::vector<char const *> baseDefines;
-        switch (currentType)
-        {
-        case Type::Float: baseDefines.push_back("TYPE=float"); break;
-        case Type::Float2: baseDefines.push_back("TYPE=float2"); break;
-        case Type::Float3: baseDefines.push_back("TYPE=float3"); break;
-        case Type::Float4: baseDefines.push_back("TYPE=float4"); break;
-        case Type::UInt: baseDefines.push_back("TYPE=uint"); break;
-        case Type::UInt2: baseDefines.push_back("TYPE=uint2"); break;
-        case Type::UInt3: baseDefines.push_back("TYPE=uint3"); break;
-        case Type::UInt4: baseDefines.push_back("TYPE=uint4"); break;
-        case Type::Int: baseDefines.push_back("TYPE=int"); break;
-        case Type::Int2: baseDefines.push_back("TYPE=int2"); break;
-        case Type::Int3: baseDefines.push_back("TYPE=int3"); break;
-        case Type::Int4: baseDefines.push_back("TYPE=int4"); break;
-        case Type::Double: baseDefines.push_back("TYPE=double"); break;
-        case Type::Double2: baseDefines.push_back("TYPE=double2"); break;
-        case Type::Double3: baseDefines.push_back("TYPE=double3"); break;
-        case Type::Double4: baseDefines.push_back("TYPE=double4"); break;
-        default: break;
-        }
-        switch (currentOperation)
-        {
-        case Operation::Sum: baseDefines.push_back("OP=0"); break;
-        case Operation::Min: baseDefines.push_back("OP=1"); break;
-        case Operation::Max: baseDefines.push_back("OP=2"); break;
-        case Operation::Product: baseDefines.push_back("OP=3"); break;
-        }
+        std::vector<char const *> const baseDefines = GetDefines(currentType, currentOperation);
         reduceKernel = gfxCreateComputeKernel(
             gfx, reduceProgram, "BlockReduce", baseDefines.data(), static_cast<uint32_t>(baseDefines.size()));
         reduceIndirectKernel   = gfxCreateComputeKernel(gfx, reduceProgram, "BlockReduceIndirect",
@@ -126,15 +171,15 @@ bool GPUReduce::initialise(
 
 void GPUReduce::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx, scratchBuffer);
+    DestroyBuffer(gfx, scratchBuffer);
     scratchBuffer = {};
-    gfxDestroyBuffer(gfx, indirectBuffer);
+    DestroyBuffer(gfx, indirectBuffer);
     indirectBuffer = {};
-    gfxDestroyBuffer(gfx, indirectBuffer2);
+    DestroyBuffer(gfx, indirectBuffer2);
     indirectBuffer2 = {};
-    gfxDestroyBuffer(gfx, indirectCountBuffer);
+    DestroyBuffer(gfx, indirectCountBuffer);
     indirectCountBuffer = {};
-    gfxDestroyBuffer(gfx, indirectCountBuffer2);
+    DestroyBuffer(gfx, indirectCountBuffer2);
     indirectCountBuffer2 = {};
 
     gfxDestroyProgram(gfx, reduceProgram);
@@ -145,6 +190,14 @@ void GPUReduce::terminate() noexcept
     reduceIndirectKernel = {};
     gfxDestroyKernel(gfx, dispatchIndirectKernel);
     dispatchIndirectKernel = {};
+    for (auto &kernel : batchKernels | std::views::values)
+    {
+        gfxDestroyKernel(gfx, kernel);
+    }
+    batchKernels.clear();
+    DestroyBuffer(gfx, batchJobsBuffer);
+    batchJobsBuffer = {};
+    batchJobs.clear();
 }
 
 bool GPUReduce::reduceIndirect(
@@ -165,13 +218,9 @@ bool GPUReduce::reduceInternal(
     bool const indirect = (numKeys != nullptr);
 
     // Calculate number of loops
-    uint32_t const *numThreads    = gfxKernelGetNumThreads(gfx, reduceKernel);
-    uint const      groupSize     = numThreads[0];
-    constexpr uint  keysPerThread = 4; // Must match KEYS_PER_THREAD in shader
-    uint const      keysPerGroup  = groupSize * keysPerThread;
-    uint32_t const  numGroups1    = (maxNumKeys + keysPerGroup - 1) / keysPerGroup;
-    uint32_t const  numGroups2    = (numGroups1 + keysPerGroup - 1) / keysPerGroup;
-    if (numGroups2 > numThreads[0])
+    uint32_t const numGroups1 = (maxNumKeys + kKeysPerGroup - 1) / kKeysPerGroup;
+    uint32_t const numGroups2 = (numGroups1 + kKeysPerGroup - 1) / kKeysPerGroup;
+    if (numGroups2 > kGroupSize)
     {
         // To many keys as we only support 2 loops
         return false;
@@ -206,16 +255,9 @@ bool GPUReduce::reduceInternal(
     if (numGroups1 > 1)
     {
         // Create scratch buffer needed for loops
-        uint64_t const typeSize = ((static_cast<uint64_t>(currentType) % 4) + 1)
-                                * (currentType >= Type::Double ? sizeof(double) : sizeof(float));
-        uint64_t const scratchBufferSize = numGroups1 * typeSize;
-        if (!scratchBuffer || (scratchBuffer.getSize() < scratchBufferSize))
-        {
-            gfxDestroyBuffer(gfx, scratchBuffer);
-            scratchBuffer = gfxCreateBuffer(gfx, scratchBufferSize);
-            scratchBuffer.setStride(static_cast<uint32_t>(typeSize));
-            scratchBuffer.setName("Capsaicin_Reduce_ScratchBuffer");
-        }
+        uint64_t const typeSize = GetTypeSize(currentType);
+        reserveScratch(numGroups1 * typeSize);
+        scratchBuffer.setStride(static_cast<uint32_t>(typeSize));
 
         gfxProgramSetParameter(gfx, reduceProgram, "g_OutputBuffer", scratchBuffer);
         // Run first loop
@@ -268,4 +310,140 @@ bool GPUReduce::reduceInternal(
 
     return true;
 }
+
+bool GPUReduce::reduceBatch(std::vector<Job> const &jobs) noexcept
+{
+    // Group jobs that can be reduced by the same kernel
+    std::map<std::pair<Type, Operation>, std::vector<Job const *>> batches;
+    for (auto const &job : jobs)
+    {
+        if (job.numKeys == 0)
+        {
+            continue;
+        }
+        uint const numGroups1 = (job.numKeys + kKeysPerGroup - 1) / kKeysPerGroup;
+        uint const numGroups2 = (numGroups1 + kKeysPerGroup - 1) / kKeysPerGroup;
+        if (numGroups2 > kGroupSize)
+        {
+            // Too many keys as we only support 2 loops
+            return false;
+        }
+        batches[{job.type, job.operation}].push_back(&job);
+    }
+
+    // Layout each batch's job table and scratch memory, all batches run in sequence so share the same scratch
+    struct Batch
+    {
+        GfxKernel                    kernel;
+        std::vector<GfxBuffer>       buffers;        /**< Buffer of each job */
+        uint                         jobOffset = 0;  /**< Index of the batch's first job table entry */
+        std::array<uint, kMaxPasses> numGroups = {}; /**< Dispatch size of each pass */
+        uint64_t                     typeSize  = 0;
+    };
+    std::vector<Batch> batchList;
+    std::vector<uint4> newBatchJobs;
+    uint64_t           scratchSize = 0;
+    for (auto const &[key, members] : batches)
+    {
+        Batch batch;
+        batch.kernel = getBatchKernel(key.first, key.second);
+        if (!batch.kernel || members.size() > 65535)
+        {
+            return false;
+        }
+        batch.jobOffset     = static_cast<uint>(newBatchJobs.size());
+        batch.typeSize      = GetTypeSize(key.first);
+        auto const jobCount = static_cast<uint>(members.size());
+        newBatchJobs.resize(newBatchJobs.size() + static_cast<size_t>(kMaxPasses) * jobCount, uint4(0));
+        uint scratchOffset = 0;
+        for (uint i = 0; i < jobCount; ++i)
+        {
+            batch.buffers.push_back(members[i]->buffer);
+            // Each pass reads the previous pass's output, the final pass writes back to the job's buffer
+            uint count       = members[i]->numKeys;
+            uint inputOffset = kBatchJobBuffer;
+            for (uint pass = 0; pass < kMaxPasses && count > 0; ++pass)
+            {
+                uint const numGroups    = (count + kKeysPerGroup - 1) / kKeysPerGroup;
+                uint const outputOffset = numGroups > 1 ? scratchOffset : kBatchJobBuffer;
+                newBatchJobs[batch.jobOffset + pass * jobCount + i] =
+                    uint4(count, inputOffset, outputOffset, 0);
+                batch.numGroups[pass] = std::max(batch.numGroups[pass], numGroups);
+                if (numGroups == 1)
+                {
+                    break;
+                }
+                scratchOffset += numGroups;
+                inputOffset = outputOffset;
+                count       = numGroups;
+            }
+        }
+        scratchSize = std::max(scratchSize, scratchOffset * batch.typeSize);
+        batchList.push_back(std::move(batch));
+    }
+    if (batchList.empty())
+    {
+        return true;
+    }
+
+    // Upload the job table only when it has changed
+    if (!batchJobsBuffer || newBatchJobs != batchJobs)
+    {
+        if (!batchJobsBuffer || batchJobsBuffer.getCount() < newBatchJobs.size())
+        {
+            DestroyBuffer(gfx, batchJobsBuffer);
+            batchJobsBuffer = CreateBuffer<uint4>(gfx, static_cast<uint32_t>(newBatchJobs.size()));
+            batchJobsBuffer.setName("Capsaicin_Reduce_BatchJobsBuffer");
+        }
+        GfxBuffer const uploadBuffer = CreateBuffer<uint4>(gfx, static_cast<uint32_t>(newBatchJobs.size()),
+            newBatchJobs.data(), kGfxCpuAccess_Write);
+        gfxCommandCopyBuffer(gfx, batchJobsBuffer, 0, uploadBuffer, 0, uploadBuffer.getSize());
+        DestroyBuffer(gfx, uploadBuffer);
+        batchJobs = std::move(newBatchJobs);
+    }
+    reserveScratch(std::max(scratchSize, uint64_t {sizeof(double) * 4}));
+
+    gfxProgramSetParameter(gfx, reduceProgram, "g_BatchJobs", batchJobsBuffer);
+    for (auto const &batch : batchList)
+    {
+        GfxBuffer batchScratch = scratchBuffer;
+        batchScratch.setStride(static_cast<uint32_t>(batch.typeSize));
+        gfxProgramSetParameter(gfx, reduceProgram, "g_BatchScratch", batchScratch);
+        gfxProgramSetParameter(gfx, reduceProgram, "g_BatchBuffers", batch.buffers.data(),
+            static_cast<uint32_t>(batch.buffers.size()));
+        gfxCommandBindKernel(gfx, batch.kernel);
+        auto const jobCount = static_cast<uint>(batch.buffers.size());
+        for (uint pass = 0; pass < kMaxPasses && batch.numGroups[pass] > 0; ++pass)
+        {
+            gfxProgramSetParameter(gfx, reduceProgram, "g_BatchJobOffset", batch.jobOffset + pass * jobCount);
+            gfxCommandDispatch(gfx, batch.numGroups[pass], jobCount, 1);
+        }
+    }
+    return true;
+}
+
+void GPUReduce::reserveScratch(uint64_t const size) noexcept
+{
+    if (!scratchBuffer || (scratchBuffer.getSize() < size))
+    {
+        DestroyBuffer(gfx, scratchBuffer);
+        scratchBuffer = CreateBuffer(gfx, size);
+        scratchBuffer.setName("Capsaicin_Reduce_ScratchBuffer");
+    }
+}
+
+GfxKernel GPUReduce::getBatchKernel(Type const type, Operation const operation) noexcept
+{
+    auto kernel = batchKernels.find({type, operation});
+    if (kernel == batchKernels.end())
+    {
+        std::vector<char const *> const defines = GetDefines(type, operation);
+        kernel = batchKernels
+                     .emplace(std::make_pair(type, operation),
+                         gfxCreateComputeKernel(gfx, reduceProgram, "BlockReduceBatch", defines.data(),
+                             static_cast<uint32_t>(defines.size())))
+                     .first;
+    }
+    return kernel->second;
+}
 } // namespace Capsaicin
@@ -24,6 +24,7 @@ THE SOFTWARE.
 #include "gpu_shared.h"
 
 #include <gfx.h>
+#include <map>
 
 namespace Capsaicin
 {
@@ -74,6 +75,15 @@ class GPUReduce
         Product,
     };
 
+    /** A single reduction performed as part of a batch. */
+    struct Job
+    {
+        GfxBuffer buffer;                      /**< Keys to reduce, the result is written to the first key */
+        Type      type      = Type::Float;
+        Operation operation = Operation::Sum;
+        uint      numKeys   = 0;               /**< Number of keys in the buffer */
+    };
+
     /**
      * Initialise the internal data based on current configuration.
      * @param gfxIn         Active gfx context.
@@ -112,6 +122,16 @@ class GPUReduce
      */
     bool reduce(GfxBuffer const &sourceBuffer, uint numKeys) noexcept;
 
+    /**
+     * Reduce multiple buffers, each with its own type and operation.
+     * All jobs share the same scratch memory. Each reduction pass is a single dispatch for all jobs with the
+     * same type and operation, this is independent of the type and operation passed to initialise.
+     * @note Kernels for each type and operation combination are created on first use.
+     * @param jobs The reductions to perform, each result is written to the first element of its buffer.
+     * @return True, if operation succeeded.
+     */
+    bool reduceBatch(std::vector<Job> const &jobs) noexcept;
+
 private:
     /** Terminates and cleans up this object. */
     void terminate() noexcept;
@@ -129,6 +149,20 @@ class GPUReduce
     bool reduceInternal(
         GfxBuffer const &sourceBuffer, uint maxNumKeys, GfxBuffer const *numKeys = nullptr) noexcept;
 
+    /**
+     * Ensures the scratch buffer is large enough.
+     * @param size The required size (bytes).
+     */
+    void reserveScratch(uint64_t size) noexcept;
+
+    /**
+     * Gets the batched reduction kernel for a type and operation, creating it if required.
+     * @param type      The object type to reduce.
+     * @param operation The type of operation to perform.
+     * @return The kernel.
+     */
+    GfxKernel getBatchKernel(Type type, Operation operation) noexcept;
+
     GfxContext gfx;
 
     Type       currentType      = Type::Float;
@@ -142,5 +176,9 @@ class GPUReduce
     GfxKernel  reduceKernel;
     GfxKernel  reduceIndirectKernel;
     GfxKernel  dispatchIndirectKernel;
+
+    std::map<std::pair<Type, Operation>, GfxKernel> batchKernels;
+    GfxBuffer                                       batchJobsBuffer;
+    std::vector<uint4> batchJobs; /**< Contents of batchJobsBuffer, only uploaded when changed */
 };
 } // namespace Capsaicin
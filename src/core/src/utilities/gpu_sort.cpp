@@ -22,8 +22,8 @@ THE SOFTWARE.
 
 #include "gpu_sort.h"
 
-#include "buffer_view.h"
 #include "capsaicin_internal.h"
+#include "cpu_sort.h"
 
 #define FFX_CPU
 #ifdef __clang__
@@ -39,8 +39,17 @@ THE SOFTWARE.
 #    pragma clang diagnostic pop
 #endif
 
+#include <algorithm>
+
 namespace Capsaicin
 {
+// The CPU reference must follow the exact same data distribution to produce identical results
+static_assert(CPUSort::kBitsPerPass == FFX_PARALLELSORT_SORT_BITS_PER_PASS);
+static_assert(CPUSort::kBinCount == FFX_PARALLELSORT_SORT_BIN_COUNT);
+static_assert(
+    CPUSort::kBlockSize == FFX_PARALLELSORT_ELEMENTS_PER_THREAD * FFX_PARALLELSORT_THREADGROUP_SIZE);
+static_assert(CPUSort::kMaxThreadGroups == 800);
+
 GPUSort::~GPUSort() noexcept
 {
     terminate();
@@ -51,14 +60,12 @@ bool GPUSort::initialise(GfxContext const &gfxIn, std::vector<std::string> const
 {
     gfx = gfxIn;
 
-    if (!parallelSortCBBuffer)
+    if (!countScatterArgsBuffer)
     {
-        // Currently we just allocate enough for a max number of 16 segments
-        parallelSortCBBuffer = gfxCreateBuffer<FfxParallelSortConstants>(gfx, 1 * 16);
-        parallelSortCBBuffer.setName("ParallelSortCBBuffer");
-        countScatterArgsBuffer = gfxCreateBuffer<uint>(gfx, 3 * 16);
+        // All segments are dispatched together so only a single set of arguments is needed
+        countScatterArgsBuffer = CreateBuffer<uint>(gfx, 4); // Uses 4 for alignment
         countScatterArgsBuffer.setName("CountScatterArgsBuffer");
-        reduceScanArgsBuffer = gfxCreateBuffer<uint>(gfx, 3 * 16);
+        reduceScanArgsBuffer = CreateBuffer<uint>(gfx, 4);
         reduceScanArgsBuffer.setName("ReduceScanArgsBuffer");
     }
 
@@ -143,21 +150,26 @@ bool GPUSort::initialise(
 
 void GPUSort::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx, parallelSortCBBuffer);
+    DestroyBuffer(gfx, parallelSortCBBuffer);
     parallelSortCBBuffer = {};
-    gfxDestroyBuffer(gfx, countScatterArgsBuffer);
+    DestroyBuffer(gfx, segmentOffsetsBuffer);
+    segmentOffsetsBuffer = {};
+    segmentSizes.clear();
+    segmentTotalKeys      = 0;
+    segmentConstantsValid = false;
+    DestroyBuffer(gfx, countScatterArgsBuffer);
     countScatterArgsBuffer = {};
-    gfxDestroyBuffer(gfx, reduceScanArgsBuffer);
+    DestroyBuffer(gfx, reduceScanArgsBuffer);
     reduceScanArgsBuffer = {};
 
-    gfxDestroyBuffer(gfx, scratchBuffer);
+    DestroyBuffer(gfx, scratchBuffer);
     scratchBuffer = {};
-    gfxDestroyBuffer(gfx, reducedScratchBuffer);
+    DestroyBuffer(gfx, reducedScratchBuffer);
     reducedScratchBuffer = {};
 
-    gfxDestroyBuffer(gfx, sourcePongBuffer);
+    DestroyBuffer(gfx, sourcePongBuffer);
     sourcePongBuffer = {};
-    gfxDestroyBuffer(gfx, payloadPongBuffer);
+    DestroyBuffer(gfx, payloadPongBuffer);
     payloadPongBuffer = {};
 
     gfxDestroyProgram(gfx, sortProgram);
@@ -181,473 +193,256 @@ void GPUSort::terminate() noexcept
 void GPUSort::sortIndirect(
     GfxBuffer const &sourceBuffer, GfxBuffer const &numKeys, uint const maxNumKeys) noexcept
 {
-    sortInternal(sourceBuffer, maxNumKeys, &numKeys);
+    sortInternal(sourceBuffer, {}, maxNumKeys, 1, &numKeys);
 }
 
 void GPUSort::sortIndirectPayload(GfxBuffer const &sourceBuffer, GfxBuffer const &numKeys,
     uint const maxNumKeys, GfxBuffer const &sourcePayload) noexcept
 {
-    sortInternal(sourceBuffer, maxNumKeys, &numKeys, &sourcePayload);
+    sortInternal(sourceBuffer, {}, maxNumKeys, 1, &numKeys, &sourcePayload);
 }
 
 void GPUSort::sort(GfxBuffer const &sourceBuffer, uint const numKeys) noexcept
 {
-    sortInternal(sourceBuffer, numKeys);
+    sortInternal(sourceBuffer, {numKeys}, numKeys);
 }
 
 void GPUSort::sortPayload(
     GfxBuffer const &sourceBuffer, uint const numKeys, GfxBuffer const &sourcePayload) noexcept
 {
-    sortInternal(sourceBuffer, numKeys, nullptr, &sourcePayload);
+    sortInternal(sourceBuffer, {numKeys}, numKeys, UINT_MAX, nullptr, &sourcePayload);
 }
 
 void GPUSort::sortIndirectSegmented(GfxBuffer const &sourceBuffer, uint const numSegments,
     GfxBuffer const &numKeys, uint const maxNumKeys) noexcept
 {
-    sortInternalSegmented(sourceBuffer, {}, maxNumKeys, numSegments, &numKeys);
+    sortInternal(sourceBuffer, {}, maxNumKeys, numSegments, &numKeys);
 }
 
 void GPUSort::sortIndirectPayloadSegmented(GfxBuffer const &sourceBuffer, uint const numSegments,
     GfxBuffer const &numKeys, uint const maxNumKeys, GfxBuffer const &sourcePayload) noexcept
 {
-    sortInternalSegmented(sourceBuffer, {}, maxNumKeys, numSegments, &numKeys, &sourcePayload);
+    sortInternal(sourceBuffer, {}, maxNumKeys, numSegments, &numKeys, &sourcePayload);
 }
 
 void GPUSort::sortSegmented(GfxBuffer const &sourceBuffer, std::vector<uint> const &numKeys) noexcept
 {
-    sortInternalSegmented(sourceBuffer, numKeys, 0);
+    sortInternal(sourceBuffer, numKeys, 0);
 }
 
 void GPUSort::sortPayloadSegmented(
     GfxBuffer const &sourceBuffer, std::vector<uint> const &numKeys, GfxBuffer const &sourcePayload) noexcept
 {
-    sortInternalSegmented(sourceBuffer, numKeys, 0, UINT_MAX, nullptr, &sourcePayload);
+    sortInternal(sourceBuffer, numKeys, 0, UINT_MAX, nullptr, &sourcePayload);
 }
 
-void GPUSort::sortInternal(GfxBuffer const &sourceBuffer, uint const maxNumKeys, GfxBuffer const *numKeys,
+void GPUSort::sortInternal(GfxBuffer const &sourceBuffer, std::vector<uint> const &numKeysList,
+    uint const maxNumKeys, uint numSegments, GfxBuffer const *numKeys,
     GfxBuffer const *sourcePayload) noexcept
 {
     // Check if we have payload to also sort
     bool const hasPayload = sourcePayload != nullptr;
 
     // Check if indirect
-    bool const indirect = (numKeys != nullptr);
+    bool const isIndirect = (numKeys != nullptr);
 
-    uint numThreadGroupsToRun        = 0;
-    uint numReducedThreadGroupsToRun = 0;
-    if (indirect)
+    numSegments = isIndirect ? numSegments : static_cast<uint>(numKeysList.size());
+    if (numSegments == 0)
     {
-        // Run the indirect sort setup kernel
-        gfxProgramSetParameter(gfx, sortProgram, "CBufferUAV", parallelSortCBBuffer);
-        gfxProgramSetParameter(gfx, sortProgram, "CountScatterArgs", countScatterArgsBuffer);
-        gfxProgramSetParameter(gfx, sortProgram, "ReduceScanArgs", reduceScanArgsBuffer);
-        gfxProgramSetParameter(gfx, sortProgram, "numKeys", *numKeys);
-
-        gfxCommandBindKernel(gfx, setupIndirect);
-        gfxCommandDispatch(gfx, 1, 1, 1);
+        return;
     }
-    else
+    if (numSegments > kMaxSegments)
     {
-        FfxParallelSortConstants constantBufferData = {};
-        ffxParallelSortSetConstantAndDispatchData(
-            maxNumKeys, 800, constantBufferData, numThreadGroupsToRun, numReducedThreadGroupsToRun);
-        gfxDestroyBuffer(gfx, parallelSortCBBuffer);
-        parallelSortCBBuffer = gfxCreateBuffer<FfxParallelSortConstants>(gfx, 1, &constantBufferData);
+        GFX_PRINT_ERROR(kGfxResult_InvalidParameter, "Cannot sort more than %u segments at once (got %u)",
+            kMaxSegments, numSegments);
+        return;
     }
 
-    // Make scratch buffers
-    uint scratchBufferSize        = 0;
-    uint reducedScratchBufferSize = 0;
-    ffxParallelSortCalculateScratchResourceSize(maxNumKeys, scratchBufferSize, reducedScratchBufferSize);
-    if (!scratchBuffer || (scratchBuffer.getSize() < scratchBufferSize))
+    // Get the capacity of each segment, indirect segments are laid out with a fixed stride
+    std::vector<uint> newSegmentSizes;
+    if (isIndirect)
     {
-        gfxDestroyBuffer(gfx, scratchBuffer);
-        scratchBuffer = gfxCreateBuffer(gfx, scratchBufferSize);
-        scratchBuffer.setName("ScratchBuffer");
+        newSegmentSizes.resize(numSegments, maxNumKeys);
     }
-    if (!reducedScratchBuffer || (reducedScratchBuffer.getSize() < reducedScratchBufferSize))
+    else
     {
-        gfxDestroyBuffer(gfx, reducedScratchBuffer);
-        reducedScratchBuffer = gfxCreateBuffer(gfx, reducedScratchBufferSize);
-        reducedScratchBuffer.setName("ReducedScratchBuffer");
+        newSegmentSizes = numKeysList;
     }
 
-    // Setup ping-pong buffers
-    if (!sourcePongBuffer || ((sourcePongBuffer.getSize() / sizeof(uint)) < maxNumKeys))
+    // Create the segment offset table, this only changes when the segment layout does
+    if (!segmentOffsetsBuffer || newSegmentSizes != segmentSizes)
     {
-        gfxDestroyBuffer(gfx, sourcePongBuffer);
-        sourcePongBuffer = gfxCreateBuffer<uint>(gfx, maxNumKeys);
-        sourcePongBuffer.setName("SourcePongBuffer");
-    }
-    if (hasPayload && (!payloadPongBuffer || ((payloadPongBuffer.getSize() / sizeof(uint)) < maxNumKeys)))
-    {
-        gfxDestroyBuffer(gfx, payloadPongBuffer);
-        payloadPongBuffer = gfxCreateBuffer<uint>(gfx, maxNumKeys);
-        payloadPongBuffer.setName("PayloadPongBuffer");
-    }
-    GfxBuffer const *readBuffer(&sourceBuffer);
-    GfxBuffer const *writeBuffer(&sourcePongBuffer);
-    GfxBuffer const *readPayloadBuffer(sourcePayload);
-    GfxBuffer const *writePayloadBuffer(&payloadPongBuffer);
-
-    // Perform Radix Sort (currently only support 32-bit key/payload sorting
-    for (uint32_t shift = 0; shift < 32U; shift += FFX_PARALLELSORT_SORT_BITS_PER_PASS)
-    {
-        // Sort Count
+        // Each segment gets its own range of keys, sum table and reduced sum table
+        std::vector<uint4> segmentOffsets(numSegments, uint4(0));
+        uint               totalKeys              = 0;
+        uint               totalScratchSize       = 0;
+        uint               totalReduceScratchSize = 0;
+        for (uint i = 0; i < numSegments; ++i)
         {
-            gfxProgramSetParameter(gfx, sortProgram, "CShiftBit", shift);
-            gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBuffer);
-            gfxProgramSetParameter(gfx, sortProgram, "SrcBuffer", *readBuffer);
-            gfxProgramSetParameter(gfx, sortProgram, "SumTable", scratchBuffer);
-
-            gfxCommandBindKernel(gfx, count);
-            if (indirect)
-            {
-                gfxCommandDispatchIndirect(gfx, countScatterArgsBuffer);
-            }
-            else
-            {
-                gfxCommandDispatch(gfx, numThreadGroupsToRun, 1, 1);
-            }
+            // Empty segments still write a reduced sum for every bin so must be given their own space
+            uint scratchSize       = 0;
+            uint reduceScratchSize = 0;
+            ffxParallelSortCalculateScratchResourceSize(
+                std::max(newSegmentSizes[i], 1U), scratchSize, reduceScratchSize);
+            segmentOffsets[i] = uint4(totalKeys, totalScratchSize, totalReduceScratchSize, 0);
+            totalKeys += newSegmentSizes[i];
+            totalScratchSize += scratchSize / static_cast<uint>(sizeof(uint));
+            totalReduceScratchSize += reduceScratchSize / static_cast<uint>(sizeof(uint));
         }
-
-        // Sort Reduce
+        DestroyBuffer(gfx, segmentOffsetsBuffer);
+        segmentOffsetsBuffer = CreateBuffer<uint4>(gfx, numSegments, segmentOffsets.data());
+        segmentOffsetsBuffer.setName("SegmentOffsetsBuffer");
+        segmentSizes          = std::move(newSegmentSizes);
+        segmentConstantsValid = false;
+
+        // Make scratch buffers
+        if (!scratchBuffer || (scratchBuffer.getCount() < totalScratchSize))
         {
-            gfxProgramSetParameter(gfx, sortProgram, "ReduceTable", reducedScratchBuffer);
-
-            gfxCommandBindKernel(gfx, countReduce);
-            if (indirect)
-            {
-                gfxCommandDispatchIndirect(gfx, reduceScanArgsBuffer);
-            }
-            else
-            {
-                gfxCommandDispatch(gfx, numReducedThreadGroupsToRun, 1, 1);
-            }
+            DestroyBuffer(gfx, scratchBuffer);
+            scratchBuffer = CreateBuffer<uint>(gfx, totalScratchSize);
+            scratchBuffer.setName("ScratchBuffer");
         }
-
-        // Sort Scan
+        if (!reducedScratchBuffer || (reducedScratchBuffer.getCount() < totalReduceScratchSize))
         {
-            // First do scan prefix of reduced values
-            gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", reducedScratchBuffer);
-            gfxProgramSetParameter(gfx, sortProgram, "ScanDst", reducedScratchBuffer);
-            gfxCommandBindKernel(gfx, scan);
-            gfxCommandDispatch(gfx, 1, 1, 1);
-
-            // Next do scan prefix on the histogram with partial sums that we just did
-            gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", scratchBuffer);
-            gfxProgramSetParameter(gfx, sortProgram, "ScanDst", scratchBuffer);
-            gfxProgramSetParameter(gfx, sortProgram, "ScanScratch", reducedScratchBuffer);
-            gfxCommandBindKernel(gfx, scanAdd);
-            if (indirect)
-            {
-                gfxCommandDispatchIndirect(gfx, reduceScanArgsBuffer);
-            }
-            else
-            {
-                gfxCommandDispatch(gfx, numReducedThreadGroupsToRun, 1, 1);
-            }
+            DestroyBuffer(gfx, reducedScratchBuffer);
+            reducedScratchBuffer = CreateBuffer<uint>(gfx, totalReduceScratchSize);
+            reducedScratchBuffer.setName("ReducedScratchBuffer");
         }
 
-        // Sort Scatter
+        // Setup ping-pong buffers
+        if (!sourcePongBuffer || (sourcePongBuffer.getCount() < totalKeys))
         {
-            gfxProgramSetParameter(gfx, sortProgram, "DstBuffer", *writeBuffer);
-            if (hasPayload)
-            {
-                gfxProgramSetParameter(gfx, sortProgram, "SrcPayload", *readPayloadBuffer);
-                gfxProgramSetParameter(gfx, sortProgram, "DstPayload", *writePayloadBuffer);
-                gfxCommandBindKernel(gfx, scatterPayload);
-            }
-            else
-            {
-                gfxCommandBindKernel(gfx, scatter);
-            }
-            if (indirect)
-            {
-                gfxCommandDispatchIndirect(gfx, countScatterArgsBuffer);
-            }
-            else
-            {
-                gfxCommandDispatch(gfx, numThreadGroupsToRun, 1, 1);
-            }
+            DestroyBuffer(gfx, sourcePongBuffer);
+            sourcePongBuffer = CreateBuffer<uint>(gfx, std::max(totalKeys, 1U));
+            sourcePongBuffer.setName("SourcePongBuffer");
         }
-
-        // Swap read/write sources
-        std::swap(readBuffer, writeBuffer);
-        std::swap(readPayloadBuffer, writePayloadBuffer);
+        segmentTotalKeys = totalKeys;
+    }
+    if (hasPayload && (!payloadPongBuffer || (payloadPongBuffer.getCount() < segmentTotalKeys)))
+    {
+        DestroyBuffer(gfx, payloadPongBuffer);
+        payloadPongBuffer = CreateBuffer<uint>(gfx, std::max(segmentTotalKeys, 1U));
+        payloadPongBuffer.setName("PayloadPongBuffer");
     }
-}
-
-void GPUSort::sortInternalSegmented(GfxBuffer const &sourceBuffer, std::vector<uint> const &numKeysList,
-    uint const maxNumKeys, uint numSegments, GfxBuffer const *numKeys,
-    GfxBuffer const *sourcePayload) noexcept
-{
-    // Check if we have payload to also sort
-    bool const hasPayload = sourcePayload != nullptr;
-
-    // Check if indirect
-    bool const isIndirect = (numKeys != nullptr);
 
-    numSegments = isIndirect ? numSegments : static_cast<uint>(numKeysList.size());
+    if (!parallelSortCBBuffer || parallelSortCBBuffer.getCount() < numSegments)
+    {
+        DestroyBuffer(gfx, parallelSortCBBuffer);
+        parallelSortCBBuffer = CreateBuffer<FfxParallelSortConstants>(gfx, numSegments);
+        parallelSortCBBuffer.setName("ParallelSortCBBuffer");
+        segmentConstantsValid = false;
+    }
 
-    std::vector<BufferView<FfxParallelSortConstants>> parallelSortCBBufferViews;
-    parallelSortCBBufferViews.reserve(numSegments);
-    std::vector<BufferView<uint>> countScatterArgsBufferViews;
-    std::vector<BufferView<uint>> reduceScanArgsBufferViews;
-    std::vector<uint>             numThreadGroupsToRun;
-    std::vector<uint>             numReducedThreadGroupsToRun;
     if (isIndirect)
     {
-        // Check if the buffers are big enough for all the requested segments
-        if (countScatterArgsBuffer.getCount() < 4 * numSegments)
-        {
-            gfxDestroyBuffer(gfx, countScatterArgsBuffer);
-            countScatterArgsBuffer = gfxCreateBuffer<uint>(gfx, 4 * numSegments); // Uses 4 for alignment
-            countScatterArgsBuffer.setName("CountScatterArgsBuffer");
-            gfxDestroyBuffer(gfx, reduceScanArgsBuffer);
-            reduceScanArgsBuffer = gfxCreateBuffer<uint>(gfx, 4 * numSegments);
-            reduceScanArgsBuffer.setName("ReduceScanArgsBuffer");
-        }
-        if (parallelSortCBBuffer.getCount() < numSegments)
-        {
-            gfxDestroyBuffer(gfx, parallelSortCBBuffer);
-            parallelSortCBBuffer = gfxCreateBuffer<FfxParallelSortConstants>(gfx, numSegments);
-            parallelSortCBBuffer.setName("ParallelSortCBBuffer");
-        }
-        // Create the individual views into the buffers
-        countScatterArgsBufferViews.reserve(numSegments);
-        reduceScanArgsBufferViews.reserve(numSegments);
-        std::vector<BufferView<uint>> numKeysViews;
-        numKeysViews.reserve(numSegments);
-        for (uint i = 0; i < numSegments; ++i)
-        {
-            parallelSortCBBufferViews.emplace_back(gfx, parallelSortCBBuffer, i, 1);
-            countScatterArgsBufferViews.emplace_back(gfx, countScatterArgsBuffer, i * 4, 3);
-            reduceScanArgsBufferViews.emplace_back(gfx, reduceScanArgsBuffer, i * 4, 3);
-            numKeysViews.emplace_back(gfx, *numKeys, i, 1);
-        }
+        // Run the indirect sort setup kernel, this sets up all segments and the dispatch covering them all
+        gfxProgramSetParameter(gfx, sortProgram, "CBufferUAV", parallelSortCBBuffer);
+        gfxProgramSetParameter(gfx, sortProgram, "CountScatterArgs", countScatterArgsBuffer);
+        gfxProgramSetParameter(gfx, sortProgram, "ReduceScanArgs", reduceScanArgsBuffer);
+        gfxProgramSetParameter(gfx, sortProgram, "numKeys", *numKeys);
+        gfxProgramSetParameter(gfx, sortProgram, "NumSegments", numSegments);
 
-        // Run the indirect sort setup kernel
         gfxCommandBindKernel(gfx, setupIndirect);
-        for (uint i = 0; i < numSegments; ++i)
-        {
-            gfxProgramSetParameter(gfx, sortProgram, "CBufferUAV", parallelSortCBBufferViews[i].buffer);
-            gfxProgramSetParameter(
-                gfx, sortProgram, "CountScatterArgs", countScatterArgsBufferViews[i].buffer);
-            gfxProgramSetParameter(gfx, sortProgram, "ReduceScanArgs", reduceScanArgsBufferViews[i].buffer);
-            gfxProgramSetParameter(gfx, sortProgram, "numKeys", numKeysViews[i].buffer);
-
-            gfxCommandDispatch(gfx, 1, 1, 1);
-        }
+        gfxCommandDispatch(gfx, 1, 1, 1);
+        segmentConstantsValid = false;
     }
     else
     {
-        std::vector<FfxParallelSortConstants> constantBufferData;
-        constantBufferData.resize(numSegments);
-        numThreadGroupsToRun.resize(numSegments);
-        numReducedThreadGroupsToRun.resize(numSegments);
+        // Dispatches must cover the largest segment, groups beyond the size of smaller segments exit early
+        std::vector<FfxParallelSortConstants> constantBufferData(numSegments);
+        maxThreadGroupsToRun        = 0;
+        maxReducedThreadGroupsToRun = 0;
         for (uint i = 0; i < numSegments; ++i)
         {
             memset(&constantBufferData[i], 0, sizeof(FfxParallelSortConstants));
+            uint numThreadGroupsToRun        = 0;
+            uint numReducedThreadGroupsToRun = 0;
             ffxParallelSortSetConstantAndDispatchData(numKeysList[i], 800, constantBufferData[i],
-                numThreadGroupsToRun[i], numReducedThreadGroupsToRun[i]);
+                numThreadGroupsToRun, numReducedThreadGroupsToRun);
+            maxThreadGroupsToRun        = std::max(maxThreadGroupsToRun, numThreadGroupsToRun);
+            maxReducedThreadGroupsToRun = std::max(maxReducedThreadGroupsToRun, numReducedThreadGroupsToRun);
         }
-        gfxDestroyBuffer(gfx, parallelSortCBBuffer);
-        parallelSortCBBuffer =
-            gfxCreateBuffer<FfxParallelSortConstants>(gfx, numSegments, constantBufferData.data());
-        parallelSortCBBuffer.setName("ParallelSortCBBuffer");
-        for (uint i = 0; i < numSegments; ++i)
+        if (!segmentConstantsValid)
         {
-            parallelSortCBBufferViews.emplace_back(gfx, parallelSortCBBuffer, i, 1);
+            // Constants only depend on the segment sizes so are only uploaded when they change
+            GfxBuffer const uploadBuffer = CreateBuffer<FfxParallelSortConstants>(
+                gfx, numSegments, constantBufferData.data(), kGfxCpuAccess_Write);
+            gfxCommandCopyBuffer(gfx, parallelSortCBBuffer, 0, uploadBuffer, 0, uploadBuffer.getSize());
+            DestroyBuffer(gfx, uploadBuffer);
+            segmentConstantsValid = true;
         }
     }
 
-    // Make scratch buffers
-    std::vector<uint> scratchBufferCount;
-    std::vector<uint> reducedScratchBufferCount;
-    uint              totalScratchBufferCount        = 0;
-    uint              totalReducedScratchBufferCount = 0;
-    uint              totalKeys                      = 0;
-    // Size each buffer based on maxNumKeys or exact segment size of known
-    scratchBufferCount.resize(numSegments);
-    reducedScratchBufferCount.resize(numSegments);
-    for (uint i = 0; i < numSegments; ++i)
-    {
-        uint const bufferSize = isIndirect ? maxNumKeys : numKeysList[i];
-        ffxParallelSortCalculateScratchResourceSize(
-            bufferSize, scratchBufferCount[i], reducedScratchBufferCount[i]);
-        scratchBufferCount[i] /= sizeof(uint); // Convert from size to count
-        reducedScratchBufferCount[i] /= sizeof(uint);
-        totalScratchBufferCount += scratchBufferCount[i];
-        totalReducedScratchBufferCount += reducedScratchBufferCount[i];
-        totalKeys += bufferSize;
-    }
-    if (!scratchBuffer || (scratchBuffer.getCount() < totalScratchBufferCount))
-    {
-        gfxDestroyBuffer(gfx, scratchBuffer);
-        scratchBuffer = gfxCreateBuffer<uint>(gfx, totalScratchBufferCount);
-        scratchBuffer.setName("ScratchBuffer");
-    }
-    if (!reducedScratchBuffer || (reducedScratchBuffer.getCount() < totalReducedScratchBufferCount))
-    {
-        gfxDestroyBuffer(gfx, reducedScratchBuffer);
-        reducedScratchBuffer = gfxCreateBuffer<uint>(gfx, totalReducedScratchBufferCount);
-        reducedScratchBuffer.setName("ReducedScratchBuffer");
-    }
+    GfxBuffer const *readBuffer(&sourceBuffer);
+    GfxBuffer const *writeBuffer(&sourcePongBuffer);
+    GfxBuffer const *readPayloadBuffer(sourcePayload);
+    GfxBuffer const *writePayloadBuffer(&payloadPongBuffer);
 
-    // Setup ping-pong buffers
-    if (!sourcePongBuffer || (sourcePongBuffer.getCount() < totalKeys))
-    {
-        gfxDestroyBuffer(gfx, sourcePongBuffer);
-        sourcePongBuffer = gfxCreateBuffer<uint>(gfx, totalKeys);
-        sourcePongBuffer.setName("SourcePongBuffer");
-    }
-    if (hasPayload && (!payloadPongBuffer || (payloadPongBuffer.getCount() < totalKeys)))
-    {
-        gfxDestroyBuffer(gfx, payloadPongBuffer);
-        payloadPongBuffer = gfxCreateBuffer<uint>(gfx, totalKeys);
-        payloadPongBuffer.setName("PayloadPongBuffer");
-    }
-    std::vector<BufferView<uint>> sourceBufferViews;
-    std::vector<BufferView<uint>> sourcePongBufferViews;
-    std::vector<BufferView<uint>> scratchBufferViews;
-    std::vector<BufferView<uint>> reducedScratchBufferViews;
-    std::vector<BufferView<uint>> sourcePayloadViews;
-    std::vector<BufferView<uint>> payloadPongBufferViews;
-    // Set buffer views
-    sourceBufferViews.reserve(numSegments);
-    sourcePongBufferViews.reserve(numSegments);
-    scratchBufferViews.reserve(numSegments);
-    reducedScratchBufferViews.reserve(numSegments);
-    sourcePayloadViews.reserve(numSegments);
-    payloadPongBufferViews.reserve(numSegments);
-    for (uint i = 0, offset = 0, scratchOffset = 0, reduceOffset = 0; i < numSegments; ++i)
-    {
-        uint const bufferSize = isIndirect ? maxNumKeys : numKeysList[i];
-        sourceBufferViews.emplace_back(gfx, sourceBuffer, offset, bufferSize);
-        sourcePongBufferViews.emplace_back(gfx, sourcePongBuffer, offset, bufferSize);
-        scratchBufferViews.emplace_back(gfx, scratchBuffer, scratchOffset, scratchBufferCount[i]);
-        reducedScratchBufferViews.emplace_back(
-            gfx, reducedScratchBuffer, reduceOffset, reducedScratchBufferCount[i]);
-
-        if (hasPayload)
+    gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBuffer);
+    gfxProgramSetParameter(gfx, sortProgram, "SegmentOffsets", segmentOffsetsBuffer);
+    gfxProgramSetParameter(gfx, sortProgram, "SumTable", scratchBuffer);
+    gfxProgramSetParameter(gfx, sortProgram, "ReduceTable", reducedScratchBuffer);
+
+    auto const dispatch = [&](GfxBuffer const &argsBuffer, uint const numGroups) {
+        if (isIndirect)
         {
-            sourcePayloadViews.emplace_back(gfx, *sourcePayload, offset, bufferSize);
-            payloadPongBufferViews.emplace_back(gfx, payloadPongBuffer, offset, bufferSize);
+            gfxCommandDispatchIndirect(gfx, argsBuffer);
         }
-        offset += bufferSize;
-        scratchOffset += scratchBufferCount[i];
-        reduceOffset += reducedScratchBufferCount[i];
-    }
-
-    std::vector<BufferView<uint>> const *readBuffer(&sourceBufferViews);
-    std::vector<BufferView<uint>> const *writeBuffer(&sourcePongBufferViews);
-    std::vector<BufferView<uint>> const *readPayloadBuffer(&sourcePayloadViews);
-    std::vector<BufferView<uint>> const *writePayloadBuffer(&payloadPongBufferViews);
+        else
+        {
+            gfxCommandDispatch(gfx, numGroups, numSegments, 1);
+        }
+    };
 
-    // Perform Radix Sort (currently only support 32-bit key/payload sorting
+    // Perform Radix Sort (currently only support 32-bit key/payload sorting), every segment is processed by
+    // each dispatch using the group Y index to select the segment
     for (uint32_t shift = 0; shift < 32U; shift += FFX_PARALLELSORT_SORT_BITS_PER_PASS)
     {
         // Sort Count
         {
             gfxProgramSetParameter(gfx, sortProgram, "CShiftBit", shift);
+            gfxProgramSetParameter(gfx, sortProgram, "SrcBuffer", *readBuffer);
+
             gfxCommandBindKernel(gfx, count);
-            for (uint i = 0; i < numSegments; ++i)
-            {
-                gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "SrcBuffer", (*readBuffer)[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "SumTable", scratchBufferViews[i].buffer);
-                if (isIndirect)
-                {
-                    gfxCommandDispatchIndirect(gfx, countScatterArgsBufferViews[i].buffer);
-                }
-                else
-                {
-                    gfxCommandDispatch(gfx, numThreadGroupsToRun[i], 1, 1);
-                }
-            }
+            dispatch(countScatterArgsBuffer, maxThreadGroupsToRun);
         }
 
         // Sort Reduce
         {
             gfxCommandBindKernel(gfx, countReduce);
-            for (uint i = 0; i < numSegments; ++i)
-            {
-                gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "SumTable", scratchBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ReduceTable", reducedScratchBufferViews[i].buffer);
-                if (isIndirect)
-                {
-                    gfxCommandDispatchIndirect(gfx, reduceScanArgsBufferViews[i].buffer);
-                }
-                else
-                {
-                    gfxCommandDispatch(gfx, numReducedThreadGroupsToRun[i], 1, 1);
-                }
-            }
+            dispatch(reduceScanArgsBuffer, maxReducedThreadGroupsToRun);
         }
 
         // Sort Scan
         {
             // First do scan prefix of reduced values
+            gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", reducedScratchBuffer);
+            gfxProgramSetParameter(gfx, sortProgram, "ScanDst", reducedScratchBuffer);
+            gfxProgramSetParameter(gfx, sortProgram, "ScanScratch", reducedScratchBuffer);
             gfxCommandBindKernel(gfx, scan);
-            for (uint i = 0; i < numSegments; ++i)
-            {
-                gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", reducedScratchBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ScanDst", reducedScratchBufferViews[i].buffer);
-                gfxCommandDispatch(gfx, 1, 1, 1);
-            }
+            gfxCommandDispatch(gfx, 1, numSegments, 1);
 
             // Next do scan prefix on the histogram with partial sums that we just did
+            gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", scratchBuffer);
+            gfxProgramSetParameter(gfx, sortProgram, "ScanDst", scratchBuffer);
             gfxCommandBindKernel(gfx, scanAdd);
-            for (uint i = 0; i < numSegments; ++i)
-            {
-                gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", scratchBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ScanDst", scratchBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ScanScratch", reducedScratchBufferViews[i].buffer);
-                if (isIndirect)
-                {
-                    gfxCommandDispatchIndirect(gfx, reduceScanArgsBufferViews[i].buffer);
-                }
-                else
-                {
-                    gfxCommandDispatch(gfx, numReducedThreadGroupsToRun[i], 1, 1);
-                }
-            }
+            dispatch(reduceScanArgsBuffer, maxReducedThreadGroupsToRun);
         }
 
         // Sort Scatter
         {
+            gfxProgramSetParameter(gfx, sortProgram, "DstBuffer", *writeBuffer);
             if (hasPayload)
             {
+                gfxProgramSetParameter(gfx, sortProgram, "SrcPayload", *readPayloadBuffer);
+                gfxProgramSetParameter(gfx, sortProgram, "DstPayload", *writePayloadBuffer);
                 gfxCommandBindKernel(gfx, scatterPayload);
             }
             else
             {
                 gfxCommandBindKernel(gfx, scatter);
             }
-            for (uint i = 0; i < numSegments; ++i)
-            {
-                gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "SrcBuffer", (*readBuffer)[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "DstBuffer", (*writeBuffer)[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "SumTable", scratchBufferViews[i].buffer);
-                if (hasPayload)
-                {
-                    gfxProgramSetParameter(gfx, sortProgram, "SrcPayload", (*readPayloadBuffer)[i].buffer);
-                    gfxProgramSetParameter(gfx, sortProgram, "DstPayload", (*writePayloadBuffer)[i].buffer);
-                }
-                if (isIndirect)
-                {
-                    gfxCommandDispatchIndirect(gfx, countScatterArgsBufferViews[i].buffer);
-                }
-                else
-                {
-                    gfxCommandDispatch(gfx, numThreadGroupsToRun[i], 1, 1);
-                }
-            }
+            dispatch(countScatterArgsBuffer, maxThreadGroupsToRun);
         }
 
         // Swap read/write sources
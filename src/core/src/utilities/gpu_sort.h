@@ -167,22 +167,9 @@ class GPUSort
     void terminate() noexcept;
 
     /**
-     * Internal sort implementation used to handle multiple sort cases.
-     * @param sourceBuffer  The buffer containing the keys to sort (only 32bit uint or float>=0 are
-     * supported).
-     * @param maxNumKeys    Value containing the number of keys in the source buffer, if using indirect
-     *  execution and exact value is unknown then this should be the maximum possible number of values in the
-     *  source.
-     * @param numKeys       (Optional) If non-null, a buffer containing the number of keys in the source
-     * buffer used for indirect execution. If null then @maxNumKeys is used instead.
-     * @param sourcePayload (Optional) The buffer containing the payload for each key (only 32bit payloads per
-     *  key are supported).
-     */
-    void sortInternal(GfxBuffer const &sourceBuffer, uint maxNumKeys, GfxBuffer const *numKeys = nullptr,
-        GfxBuffer const *sourcePayload = nullptr) noexcept;
-
-    /**
-     * Internal sort implementation used to handle multiple sort cases.
+     * Internal sort implementation used to handle all sort cases.
+     * All segments are sorted together, with each radix pass requiring only a single dispatch per kernel.
+     * Non-segmented sorts are handled as a single segment.
      * @param sourceBuffer  The buffer containing the keys to sort (only 32bit uint or float>=0 are
      * supported).
      * @param numKeysList   List containing the number of keys in each segment of the source buffer.
@@ -196,16 +183,20 @@ class GPUSort
      * @param sourcePayload (Optional) The buffer containing the payload for each key (only 32bit payloads per
      *  key are supported).
      */
-    void sortInternalSegmented(GfxBuffer const &sourceBuffer, std::vector<uint> const &numKeysList,
-        uint maxNumKeys, uint numSegments = UINT_MAX, GfxBuffer const *numKeys = nullptr,
+    void sortInternal(GfxBuffer const &sourceBuffer, std::vector<uint> const &numKeysList, uint maxNumKeys,
+        uint numSegments = UINT_MAX, GfxBuffer const *numKeys = nullptr,
         GfxBuffer const *sourcePayload = nullptr) noexcept;
 
+    /** Maximum number of segments, limited by the maximum dispatch size */
+    static constexpr uint kMaxSegments = 65535;
+
     GfxContext gfx;
 
     Type      currentType      = Type::Float;
     Operation currentOperation = Operation::Ascending;
 
     GfxBuffer parallelSortCBBuffer;
+    GfxBuffer segmentOffsetsBuffer; /**< Key, sum table and reduced sum table offset of each segment */
     GfxBuffer countScatterArgsBuffer;
     GfxBuffer reduceScanArgsBuffer;
 
@@ -215,6 +206,12 @@ class GPUSort
     GfxBuffer sourcePongBuffer;
     GfxBuffer payloadPongBuffer;
 
+    std::vector<uint> segmentSizes;                        /**< Key capacity of each segment */
+    uint              segmentTotalKeys            = 0;     /**< Combined capacity of all segments */
+    bool              segmentConstantsValid       = false; /**< Constants uploaded for segmentSizes */
+    uint              maxThreadGroupsToRun        = 0;     /**< Largest count/scatter dispatch */
+    uint              maxReducedThreadGroupsToRun = 0;     /**< Largest reduce/scan dispatch */
+
     GfxProgram sortProgram;
     GfxKernel  setupIndirect;
     GfxKernel  count;
@@ -0,0 +1,348 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "lut_cache.h"
+
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <ranges>
+#include <system_error>
+
+namespace Capsaicin
+{
+namespace
+{
+/** File header, all values are little endian and followed by the texture data */
+struct FileHeader
+{
+    uint32_t              magic   = LutCache::kMagic;
+    uint32_t              version = LutCache::kVersion;
+    LutCache::Description description;
+    uint64_t              dataSize = 0;
+    uint64_t              dataHash = 0; /**< Detects truncated or corrupted entries */
+};
+static_assert(sizeof(FileHeader) == 48, "File header must not contain padding");
+
+constexpr uint64_t kPrime = 0x100000001B3ULL;
+
+uint64_t Mix(uint64_t value) noexcept
+{
+    // SplitMix64 finaliser, ensures every input bit affects every output bit
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+}
+} // unnamed namespace
+
+uint64_t LutCache::Description::getMipOffset(uint32_t const mip) const noexcept
+{
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < mip; ++i)
+    {
+        uint64_t const mipWidth  = std::max(width >> i, 1U);
+        uint64_t const mipHeight = std::max(height >> i, 1U);
+        offset += mipWidth * mipHeight * sliceCount * bytesPerTexel;
+    }
+    return offset;
+}
+
+uint64_t LutCache::Description::getSize() const noexcept
+{
+    return getMipOffset(mipCount);
+}
+
+LutCache::Key &LutCache::Key::add(uint64_t const value) noexcept
+{
+    hash = Mix((hash ^ value) * kPrime);
+    return *this;
+}
+
+LutCache::Key &LutCache::Key::add(std::string_view const &value) noexcept
+{
+    return add(Hash(std::as_bytes(std::span(value.data(), value.size()))));
+}
+
+uint64_t LutCache::Key::getHash() const noexcept
+{
+    return hash;
+}
+
+std::string LutCache::Key::getName() const noexcept
+{
+    try
+    {
+        std::string ret(16, '0');
+        uint64_t    value = hash;
+        for (auto &character : std::views::reverse(ret))
+        {
+            character = "0123456789abcdef"[value & 0xF];
+            value >>= 4;
+        }
+        return ret;
+    }
+    catch (...)
+    {
+        return {};
+    }
+}
+
+uint64_t LutCache::Hash(std::span<std::byte const> const data, uint64_t const seed) noexcept
+{
+    // FNV-1a applied to 64-bit words, unrolled over 4 independent lanes to hide the multiply latency
+    std::array<uint64_t, 4> lanes     = {seed, seed ^ 1, seed ^ 2, seed ^ 3};
+    size_t const            wordCount = data.size() / sizeof(uint64_t);
+    size_t                  word      = 0;
+    for (; word + 4 <= wordCount; word += 4)
+    {
+        std::array<uint64_t, 4> values;
+        std::memcpy(values.data(), &data[word * sizeof(uint64_t)], sizeof(values));
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            lanes[lane] = (lanes[lane] ^ values[lane]) * kPrime;
+        }
+    }
+    uint64_t ret = Mix(lanes[0]) ^ Mix(lanes[1] + 1) ^ Mix(lanes[2] + 2) ^ Mix(lanes[3] + 3);
+    for (; word < wordCount; ++word)
+    {
+        uint64_t value;
+        std::memcpy(&value, &data[word * sizeof(uint64_t)], sizeof(value));
+        ret = (ret ^ value) * kPrime;
+    }
+    for (size_t i = wordCount * sizeof(uint64_t); i < data.size(); ++i)
+    {
+        ret = (ret ^ std::to_integer<uint64_t>(data[i])) * kPrime;
+    }
+    return Mix(ret ^ data.size());
+}
+
+bool LutCache::HashFile(std::filesystem::path const &filePath, uint64_t &hash) noexcept
+{
+    MappedFile file;
+    if (!file.open(filePath))
+    {
+        return false;
+    }
+    hash = Hash(file.getData());
+    return true;
+}
+
+void LutCache::setDirectory(std::filesystem::path const &directoryIn) noexcept
+{
+    try
+    {
+        flush();
+        directory = directoryIn;
+    }
+    catch (...)
+    {
+        directory.clear();
+    }
+}
+
+std::filesystem::path const &LutCache::getDirectory() const noexcept
+{
+    return directory;
+}
+
+void LutCache::setMaxSize(uint64_t const maxSizeIn) noexcept
+{
+    // Wait for pending saves as they read the cap on the writer thread
+    flush();
+    maxSize = maxSizeIn;
+}
+
+uint64_t LutCache::getMaxSize() const noexcept
+{
+    return maxSize;
+}
+
+bool LutCache::load(Key const &key, Description &description, std::vector<std::byte> &data) const noexcept
+{
+    try
+    {
+        if (directory.empty())
+        {
+            return false;
+        }
+        auto const filePath = getFilePath(key);
+        MappedFile file;
+        if (!file.open(filePath))
+        {
+            return false;
+        }
+        auto const fileData = file.getData();
+        FileHeader header;
+        if (fileData.size() < sizeof(header))
+        {
+            return false;
+        }
+        std::memcpy(&header, fileData.data(), sizeof(header));
+        if (header.magic != kMagic || header.version != kVersion
+            || header.dataSize != header.description.getSize()
+            || header.dataSize != fileData.size() - sizeof(header))
+        {
+            return false;
+        }
+        auto const textureData = fileData.subspan(sizeof(header));
+        if (Hash(textureData) != header.dataHash)
+        {
+            return false;
+        }
+        description = header.description;
+        data.assign(textureData.begin(), textureData.end());
+        // Mark the entry as recently used so that it is evicted last, failing to do so is not an error
+        std::error_code error;
+        std::filesystem::last_write_time(filePath, std::filesystem::file_time_type::clock::now(), error);
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool LutCache::save(
+    Key const &key, Description const &description, std::span<std::byte const> const data) const noexcept
+{
+    try
+    {
+        if (directory.empty() || data.size() != description.getSize())
+        {
+            return false;
+        }
+        std::filesystem::create_directories(directory);
+        auto const filePath = getFilePath(key);
+        auto       tempPath = filePath;
+        tempPath += ".tmp";
+
+        FileHeader header;
+        header.description = description;
+        header.dataSize    = data.size();
+        header.dataHash    = Hash(data);
+        {
+            std::ofstream file(tempPath, std::ios::binary);
+            if (!file.is_open())
+            {
+                return false;
+            }
+            file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+            file.write(
+                reinterpret_cast<char const *>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!file.good())
+            {
+                file.close();
+                std::filesystem::remove(tempPath);
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, filePath);
+        evict(filePath);
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+void LutCache::saveAsync(
+    Key const &key, Description const &description, std::vector<std::byte> data) noexcept
+{
+    // Failing to save is not an error, the entry is just regenerated the next time it is needed
+    writer.push([this, key, description, entryData = std::move(data)] {
+        static_cast<void>(save(key, description, entryData));
+    });
+}
+
+void LutCache::flush() noexcept
+{
+    writer.flush();
+}
+
+std::filesystem::path LutCache::getFilePath(Key const &key) const
+{
+    return directory / (key.getName() + ".lut");
+}
+
+void LutCache::evict(std::filesystem::path const &keepPath) const
+{
+    if (maxSize == 0)
+    {
+        return;
+    }
+    struct Entry
+    {
+        std::filesystem::path           path;
+        std::filesystem::file_time_type lastUsed;
+        uint64_t                        size;
+    };
+    std::vector<Entry> entries;
+    uint64_t           totalSize = 0;
+    std::error_code    error;
+    for (auto const &file : std::filesystem::directory_iterator(directory, error))
+    {
+        if (file.path().extension() != ".lut" || !file.is_regular_file(error))
+        {
+            continue;
+        }
+        auto const size = file.file_size(error);
+        if (error)
+        {
+            // Entry may have been deleted by another thread or process
+            continue;
+        }
+        auto const lastUsed = file.last_write_time(error);
+        if (error)
+        {
+            continue;
+        }
+        totalSize += size;
+        if (file.path() != keepPath)
+        {
+            entries.push_back({file.path(), lastUsed, size});
+        }
+    }
+    if (totalSize <= maxSize)
+    {
+        return;
+    }
+    std::ranges::sort(entries, {}, &Entry::lastUsed);
+    for (auto const &entry : entries)
+    {
+        if (totalSize <= maxSize)
+        {
+            break;
+        }
+        if (std::filesystem::remove(entry.path, error))
+        {
+            totalSize -= entry.size;
+        }
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,217 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "async_writer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Disk cache of precomputed lookup textures (BRDF LUT, prefiltered IBL, environment cube maps etc.).
+ * Each entry is identified by a content hash of everything used to generate it (source files, target size,
+ * shader sources) so stale entries are never loaded and can simply be deleted. No graphics API calls are
+ * made, uploading and reading back texture data is left to the caller.
+ * The total size of the cache directory is capped (kDefaultMaxSize unless changed using setMaxSize), after
+ * each save the least recently used entries are deleted until the directory fits within the cap again.
+ * Loading an entry updates its modification time so that entries still in use are kept.
+ */
+class LutCache
+{
+public:
+    static constexpr uint32_t kMagic   = 0x54554C43; /**< 'CLUT' */
+    static constexpr uint32_t kVersion = 1;
+
+    /** Default cache directory, relative to the working directory */
+    static constexpr char const *kDefaultDirectory = "cache/luts";
+
+    /** Default maximum total size of all cache entries (bytes) */
+    static constexpr uint64_t kDefaultMaxSize = 1ULL << 30;
+
+    /**
+     * Layout of cached texture data.
+     * Mips are stored in order, with all slices of each mip stored consecutively as tightly packed rows.
+     */
+    struct Description
+    {
+        uint32_t format        = 0; /**< DXGI_FORMAT of the texture */
+        uint32_t width         = 0;
+        uint32_t height        = 0;
+        uint32_t sliceCount    = 1; /**< Number of array slices (6 for cube maps) */
+        uint32_t mipCount      = 1;
+        uint32_t bytesPerTexel = 0;
+
+        /**
+         * Gets the offset of a mip level within the texture data.
+         * @param mip The mip level (may equal mipCount to get the total size).
+         * @return The offset (bytes).
+         */
+        [[nodiscard]] uint64_t getMipOffset(uint32_t mip) const noexcept;
+
+        /**
+         * Gets the size of the texture data.
+         * @return The size (bytes).
+         */
+        [[nodiscard]] uint64_t getSize() const noexcept;
+
+        bool operator==(Description const &other) const noexcept = default;
+    };
+
+    /** Accumulates the hash of all inputs used to generate a cache entry. */
+    class Key
+    {
+    public:
+        /**
+         * Add a value to the key.
+         * @param value The value to add.
+         * @return Reference to this key.
+         */
+        Key &add(uint64_t value) noexcept;
+
+        /**
+         * Add a string to the key.
+         * @param value The string to add.
+         * @return Reference to this key.
+         */
+        Key &add(std::string_view const &value) noexcept;
+
+        /**
+         * Gets the combined hash of all added values.
+         * @return The hash.
+         */
+        [[nodiscard]] uint64_t getHash() const noexcept;
+
+        /**
+         * Gets the name used for the cache file.
+         * @return The hash as a 16 character hexadecimal string.
+         */
+        [[nodiscard]] std::string getName() const noexcept;
+
+    private:
+        uint64_t hash = 0xCBF29CE484222325ULL;
+    };
+
+    LutCache() noexcept = default;
+    ~LutCache() noexcept = default;
+
+    LutCache(LutCache const &other)                = delete;
+    LutCache(LutCache &&other) noexcept            = delete;
+    LutCache &operator=(LutCache const &other)     = delete;
+    LutCache &operator=(LutCache &&other) noexcept = delete;
+
+    /**
+     * Calculate a hash of a block of data, this is stable between runs and platforms.
+     * Data is consumed 8 bytes at a time so that large source files (e.g. environment maps) hash quickly.
+     * @param data The data to hash.
+     * @param seed (Optional) Initial hash value, used to combine multiple hashes.
+     * @return The hash.
+     */
+    [[nodiscard]] static uint64_t Hash(
+        std::span<std::byte const> data, uint64_t seed = 0xCBF29CE484222325ULL) noexcept;
+
+    /**
+     * Calculate a hash of the contents of a file.
+     * @param filePath Full pathname to the file.
+     * @param hash     Output hash.
+     * @return True if successful, False if the file could not be read.
+     */
+    static bool HashFile(std::filesystem::path const &filePath, uint64_t &hash) noexcept;
+
+    /**
+     * Set the directory cache files are stored in.
+     * @param directoryIn The directory, empty to disable the cache.
+     */
+    void setDirectory(std::filesystem::path const &directoryIn) noexcept;
+
+    /**
+     * Gets the directory cache files are stored in.
+     * @return The directory, empty if the cache is disabled.
+     */
+    [[nodiscard]] std::filesystem::path const &getDirectory() const noexcept;
+
+    /**
+     * Set the maximum total size of all cache entries.
+     * @note Entries are only evicted when a new entry is saved.
+     * @param maxSizeIn The maximum size (bytes), 0 for no limit.
+     */
+    void setMaxSize(uint64_t maxSizeIn) noexcept;
+
+    /**
+     * Gets the maximum total size of all cache entries.
+     * @return The maximum size (bytes), 0 if there is no limit.
+     */
+    [[nodiscard]] uint64_t getMaxSize() const noexcept;
+
+    /**
+     * Load a cache entry.
+     * @param key         The key identifying the entry.
+     * @param description Output description of the cached texture.
+     * @param data        Output texture data.
+     * @return True if successful, False if there is no valid entry.
+     */
+    [[nodiscard]] bool load(
+        Key const &key, Description &description, std::vector<std::byte> &data) const noexcept;
+
+    /**
+     * Save a cache entry, replacing any existing entry.
+     * @note The file is written under a temporary name and then renamed so that concurrent readers never see
+     * a partially written entry. Least recently used entries are then evicted to stay within the size cap.
+     * @param key         The key identifying the entry.
+     * @param description Description of the texture.
+     * @param data        The texture data.
+     * @return True if successful, False otherwise.
+     */
+    [[nodiscard]] bool save(
+        Key const &key, Description const &description, std::span<std::byte const> data) const noexcept;
+
+    /**
+     * Save a cache entry on a background thread.
+     * @param key         The key identifying the entry.
+     * @param description Description of the texture.
+     * @param data        The texture data.
+     */
+    void saveAsync(Key const &key, Description const &description, std::vector<std::byte> data) noexcept;
+
+    /** Wait until all background saves have completed. */
+    void flush() noexcept;
+
+private:
+    [[nodiscard]] std::filesystem::path getFilePath(Key const &key) const;
+
+    /**
+     * Delete the least recently used entries until the total size is within the cap.
+     * @param keepPath Entry that is never deleted (the one just saved).
+     */
+    void evict(std::filesystem::path const &keepPath) const;
+
+    std::filesystem::path directory = kDefaultDirectory;
+    uint64_t              maxSize   = kDefaultMaxSize;
+    AsyncWriter           writer {1}; /**< Writes entries saved using saveAsync */
+};
+} // namespace Capsaicin
@@ -0,0 +1,131 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace Capsaicin
+{
+MappedFile::~MappedFile() noexcept
+{
+    close();
+}
+
+bool MappedFile::open(std::filesystem::path const &filePath) noexcept
+{
+    close();
+#ifdef _WIN32
+    HANDLE const fileHandle = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    file = fileHandle;
+    LARGE_INTEGER fileSize {};
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0)
+    {
+        close();
+        return false;
+    }
+    mapping = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        close();
+        return false;
+    }
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        close();
+        return false;
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int const fileHandle = ::open(filePath.c_str(), O_RDONLY);
+    if (fileHandle < 0)
+    {
+        return false;
+    }
+    // The mapping remains valid after the file is closed
+    struct stat fileStat {};
+    if (fstat(fileHandle, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        ::close(fileHandle);
+        return false;
+    }
+    void *const mapped =
+        mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileHandle, 0);
+    ::close(fileHandle);
+    if (mapped == MAP_FAILED)
+    {
+        return false;
+    }
+    data = mapped;
+    size = static_cast<size_t>(fileStat.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::close() noexcept
+{
+#ifdef _WIN32
+    if (data != nullptr)
+    {
+        UnmapViewOfFile(data);
+    }
+    if (mapping != nullptr)
+    {
+        CloseHandle(mapping);
+    }
+    if (file != nullptr)
+    {
+        CloseHandle(file);
+    }
+    mapping = nullptr;
+    file    = nullptr;
+#else
+    if (data != nullptr)
+    {
+        munmap(data, size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+std::span<std::byte const> MappedFile::getData() const noexcept
+{
+    return {static_cast<std::byte const *>(data), size};
+}
+} // namespace Capsaicin
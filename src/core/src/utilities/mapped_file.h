@@ -0,0 +1,68 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace Capsaicin
+{
+/** Read only memory mapping of an entire file. */
+class MappedFile
+{
+public:
+    MappedFile() noexcept = default;
+
+    /** Destructor, unmaps the file. */
+    ~MappedFile() noexcept;
+
+    MappedFile(MappedFile const &other)                = delete;
+    MappedFile(MappedFile &&other) noexcept            = delete;
+    MappedFile &operator=(MappedFile const &other)     = delete;
+    MappedFile &operator=(MappedFile &&other) noexcept = delete;
+
+    /**
+     * Maps a file into memory, any previously mapped file is unmapped.
+     * @param filePath Full pathname to the file to map.
+     * @return True if successful, False otherwise.
+     */
+    bool open(std::filesystem::path const &filePath) noexcept;
+
+    /** Unmaps the currently mapped file. */
+    void close() noexcept;
+
+    /**
+     * Gets the contents of the mapped file.
+     * @return The file data, empty if no file is mapped.
+     */
+    [[nodiscard]] std::span<std::byte const> getData() const noexcept;
+
+private:
+    void  *data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void *file    = nullptr; /**< File handle */
+    void *mapping = nullptr; /**< File mapping handle */
+#endif
+};
+} // namespace Capsaicin
@@ -0,0 +1,306 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "pixel_conversion.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#    include <immintrin.h>
+#endif
+
+// F16C is a separate extension to AVX2, MSVC has no macro for it but assumes it is available with /arch:AVX2
+#if defined(__AVX2__) && (defined(__F16C__) || defined(_MSC_VER))
+#    define CAPSAICIN_PIXEL_CONVERSION_F16C 1
+#endif
+
+namespace Capsaicin
+{
+namespace
+{
+float HalfToFloat(uint16_t const value) noexcept
+{
+    // Shift exponent and mantissa into place and then rebias the exponent using a multiply, this correctly
+    // normalises denormals. Inf/NaN must have their exponent forced to the maximum separately
+    uint32_t const exponentMantissa = value & 0x7FFFU;
+    float const    scaled = std::bit_cast<float>(exponentMantissa << 13) * std::bit_cast<float>(0x77800000U);
+    uint32_t       bits   = std::bit_cast<uint32_t>(scaled) | (static_cast<uint32_t>(value & 0x8000U) << 16);
+    if (exponentMantissa > 0x7BFFU)
+    {
+        bits |= 0x7F800000U;
+    }
+    return std::bit_cast<float>(bits);
+}
+
+uint16_t FloatToHalf(float const value) noexcept
+{
+    uint32_t const bits      = std::bit_cast<uint32_t>(value);
+    uint32_t const sign      = (bits >> 16) & 0x8000U;
+    uint32_t       magnitude = bits & 0x7FFFFFFFU;
+    if (magnitude >= 0x7F800000U)
+    {
+        // Inf/NaN, NaN is kept quiet
+        return static_cast<uint16_t>(sign | (magnitude > 0x7F800000U ? 0x7E00U : 0x7C00U));
+    }
+    if (magnitude >= 0x477FF000U)
+    {
+        // Rounds to a value larger than the maximum half
+        return static_cast<uint16_t>(sign | 0x7C00U);
+    }
+    if (magnitude < 0x38800000U)
+    {
+        // Denormal result, adding 0.5 aligns the mantissa so that the FPU performs the rounding
+        float const denormal = std::bit_cast<float>(magnitude) + 0.5F;
+        return static_cast<uint16_t>(sign | (std::bit_cast<uint32_t>(denormal) - 0x3F000000U));
+    }
+    // Rebias the exponent and round to nearest even
+    magnitude += 0xC8000FFFU + ((magnitude >> 13) & 1U);
+    return static_cast<uint16_t>(sign | (magnitude >> 13));
+}
+
+uint8_t FloatToUnorm8(float const value) noexcept
+{
+    // Written so that NaN compares false and results in zero
+    float const clamped = value > 0.0F ? std::min(value, 1.0F) : 0.0F;
+    return static_cast<uint8_t>(clamped * 255.0F);
+}
+
+template<typename T>
+void SplitChannelsScalar(
+    T const *source, uint32_t const channelCount, T *const *destinations, size_t const pixelCount) noexcept
+{
+    for (uint32_t channel = 0; channel < channelCount; ++channel)
+    {
+        if (T *destination = destinations[channel]; destination != nullptr)
+        {
+            for (size_t pixel = 0; pixel < pixelCount; ++pixel)
+            {
+                destination[pixel] = source[pixel * channelCount + channel];
+            }
+        }
+    }
+}
+} // unnamed namespace
+
+void ConvertHalfToFloat(uint16_t const *source, float *destination, size_t const count) noexcept
+{
+    size_t i = 0;
+#if defined(CAPSAICIN_PIXEL_CONVERSION_F16C)
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i const half = _mm_loadu_si128(reinterpret_cast<__m128i const *>(source + i));
+        _mm256_storeu_ps(destination + i, _mm256_cvtph_ps(half));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    // Vector version of HalfToFloat
+    __m128i const maskExponentMantissa = _mm_set1_epi32(0x7FFF);
+    __m128i const maxFinite            = _mm_set1_epi32(0x7BFF);
+    __m128 const  rebias               = _mm_castsi128_ps(_mm_set1_epi32(0x77800000));
+    __m128 const  infNanExponent       = _mm_castsi128_ps(_mm_set1_epi32(0x7F800000));
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i const half = _mm_unpacklo_epi16(
+            _mm_loadl_epi64(reinterpret_cast<__m128i const *>(source + i)), _mm_setzero_si128());
+        __m128i const exponentMantissa = _mm_and_si128(half, maskExponentMantissa);
+        __m128i const sign             = _mm_slli_epi32(_mm_xor_si128(half, exponentMantissa), 16);
+        __m128 const  scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentMantissa, 13)), rebias);
+        __m128 const  infNan =
+            _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(exponentMantissa, maxFinite)), infNanExponent);
+        _mm_storeu_ps(destination + i, _mm_or_ps(_mm_or_ps(scaled, _mm_castsi128_ps(sign)), infNan));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        destination[i] = HalfToFloat(source[i]);
+    }
+}
+
+void ConvertFloatToHalf(float const *source, uint16_t *destination, size_t const count) noexcept
+{
+    size_t i = 0;
+#if defined(CAPSAICIN_PIXEL_CONVERSION_F16C)
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i const half = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), half);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        destination[i] = FloatToHalf(source[i]);
+    }
+}
+
+void ConvertUnormToFloat(uint16_t const *source, float *destination, size_t const count) noexcept
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    // Divide rather than multiply by the reciprocal so results are identical to the scalar path
+    __m256 const scale = _mm256_set1_ps(65535.0F);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i const value =
+            _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(source + i)));
+        _mm256_storeu_ps(destination + i, _mm256_div_ps(_mm256_cvtepi32_ps(value), scale));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128 const scale = _mm_set1_ps(65535.0F);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i const value = _mm_unpacklo_epi16(
+            _mm_loadl_epi64(reinterpret_cast<__m128i const *>(source + i)), _mm_setzero_si128());
+        _mm_storeu_ps(destination + i, _mm_div_ps(_mm_cvtepi32_ps(value), scale));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        destination[i] = static_cast<float>(source[i]) / 65535.0F;
+    }
+}
+
+void ConvertUnormToFloat(uint8_t const *source, float *destination, size_t const count) noexcept
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256 const scale = _mm256_set1_ps(255.0F);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i const value =
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(source + i)));
+        _mm256_storeu_ps(destination + i, _mm256_div_ps(_mm256_cvtepi32_ps(value), scale));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        destination[i] = static_cast<float>(source[i]) / 255.0F;
+    }
+}
+
+void ConvertFloatToUnorm8(float const *source, uint8_t *destination, size_t const count) noexcept
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    // max returns its second operand if either is NaN so NaN becomes zero, truncation then rounds down
+    __m256 const zero  = _mm256_setzero_ps();
+    __m256 const one   = _mm256_set1_ps(1.0F);
+    __m256 const scale = _mm256_set1_ps(255.0F);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 const clamped = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(source + i), zero), one);
+        __m256i const value  = _mm256_cvttps_epi32(_mm256_mul_ps(clamped, scale));
+        __m128i const packed = _mm_packus_epi32(
+            _mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(destination + i), _mm_packus_epi16(packed, packed));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128 const zero  = _mm_setzero_ps();
+    __m128 const one   = _mm_set1_ps(1.0F);
+    __m128 const scale = _mm_set1_ps(255.0F);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 const  clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i), zero), one);
+        __m128i const value   = _mm_cvttps_epi32(_mm_mul_ps(clamped, scale));
+        __m128i const packed  = _mm_packs_epi32(value, value);
+        int32_t const bytes   = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+        std::memcpy(destination + i, &bytes, sizeof(bytes));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        destination[i] = FloatToUnorm8(source[i]);
+    }
+}
+
+template<typename T>
+void SplitChannels(
+    T const *source, uint32_t const channelCount, T *const *destinations, size_t const pixelCount) noexcept
+{
+    size_t pixel = 0;
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+    // Transpose blocks of 4 RGBA pixels into 4 values of each channel
+    if constexpr (sizeof(T) == 4)
+    {
+        if (channelCount == 4)
+        {
+            for (; pixel + 4 <= pixelCount; pixel += 4)
+            {
+                auto const *block = reinterpret_cast<float const *>(source + pixel * 4);
+                __m128      row0  = _mm_loadu_ps(block);
+                __m128      row1  = _mm_loadu_ps(block + 4);
+                __m128      row2  = _mm_loadu_ps(block + 8);
+                __m128      row3  = _mm_loadu_ps(block + 12);
+                _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+                __m128 const channels[4] = {row0, row1, row2, row3};
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                {
+                    if (destinations[channel] != nullptr)
+                    {
+                        _mm_storeu_ps(
+                            reinterpret_cast<float *>(destinations[channel] + pixel), channels[channel]);
+                    }
+                }
+            }
+        }
+    }
+    else if constexpr (sizeof(T) == 2)
+    {
+        if (channelCount == 4)
+        {
+            for (; pixel + 4 <= pixelCount; pixel += 4)
+            {
+                // a = r0 g0 b0 a0 r1 g1 b1 a1, b = r2 g2 b2 a2 r3 g3 b3 a3
+                auto const   *block = reinterpret_cast<__m128i const *>(source + pixel * 4);
+                __m128i const a     = _mm_loadu_si128(block);
+                __m128i const b     = _mm_loadu_si128(block + 1);
+                __m128i const t0    = _mm_unpacklo_epi16(a, b); // r0 r2 g0 g2 b0 b2 a0 a2
+                __m128i const t1    = _mm_unpackhi_epi16(a, b); // r1 r3 g1 g3 b1 b3 a1 a3
+                __m128i const rg    = _mm_unpacklo_epi16(t0, t1);
+                __m128i const ba    = _mm_unpackhi_epi16(t0, t1);
+                __m128i const channels[4] = {rg, _mm_srli_si128(rg, 8), ba, _mm_srli_si128(ba, 8)};
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                {
+                    if (destinations[channel] != nullptr)
+                    {
+                        _mm_storel_epi64(
+                            reinterpret_cast<__m128i *>(destinations[channel] + pixel), channels[channel]);
+                    }
+                }
+            }
+        }
+    }
+#endif
+    // Remaining pixels and formats without a vector path
+    T *remaining[4] = {};
+    for (uint32_t channel = 0; channel < channelCount; ++channel)
+    {
+        remaining[channel] = destinations[channel] != nullptr ? destinations[channel] + pixel : nullptr;
+    }
+    SplitChannelsScalar(source + pixel * channelCount, channelCount, remaining, pixelCount - pixel);
+}
+
+template void SplitChannels<uint8_t>(uint8_t const *, uint32_t, uint8_t *const *, size_t) noexcept;
+template void SplitChannels<uint16_t>(uint16_t const *, uint32_t, uint16_t *const *, size_t) noexcept;
+template void SplitChannels<uint32_t>(uint32_t const *, uint32_t, uint32_t *const *, size_t) noexcept;
+template void SplitChannels<float>(float const *, uint32_t, float *const *, size_t) noexcept;
+} // namespace Capsaicin
@@ -0,0 +1,75 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Capsaicin
+{
+/**
+ * Converts IEEE 754 half precision values to single precision.
+ * @param source      The half values to convert.
+ * @param destination Output converted values.
+ * @param count       Number of values to convert.
+ */
+void ConvertHalfToFloat(uint16_t const *source, float *destination, size_t count) noexcept;
+
+/**
+ * Converts single precision values to IEEE 754 half precision.
+ * @note Values are rounded to nearest even, values too large for half precision become infinity.
+ * @param source      The values to convert.
+ * @param destination Output converted values.
+ * @param count       Number of values to convert.
+ */
+void ConvertFloatToHalf(float const *source, uint16_t *destination, size_t count) noexcept;
+
+/**
+ * Converts normalised unsigned integer values to single precision in the range [0, 1].
+ * @param source      The values to convert.
+ * @param destination Output converted values.
+ * @param count       Number of values to convert.
+ */
+void ConvertUnormToFloat(uint16_t const *source, float *destination, size_t count) noexcept;
+void ConvertUnormToFloat(uint8_t const *source, float *destination, size_t count) noexcept;
+
+/**
+ * Quantizes single precision values to 8bit normalised unsigned integers.
+ * @note Values are clamped to [0, 1] and rounded down, NaN is converted to zero.
+ * @param source      The values to convert.
+ * @param destination Output converted values.
+ * @param count       Number of values to convert.
+ */
+void ConvertFloatToUnorm8(float const *source, uint8_t *destination, size_t count) noexcept;
+
+/**
+ * Splits interleaved pixel data into separate planar channels.
+ * @tparam T Type of each channel value (uint8_t, uint16_t, uint32_t or float).
+ * @param source       The interleaved pixel data.
+ * @param channelCount Number of channels in each source pixel (range [1, 4]).
+ * @param destinations Output plane for each source channel, nullptr entries are skipped.
+ * @param pixelCount   Number of pixels to split.
+ */
+template<typename T>
+void SplitChannels(
+    T const *source, uint32_t channelCount, T *const *destinations, size_t pixelCount) noexcept;
+} // namespace Capsaicin
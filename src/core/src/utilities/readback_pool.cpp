@@ -0,0 +1,203 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "readback_pool.h"
+
+#include "gpu_memory.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+
+namespace Capsaicin
+{
+ReadbackPool::~ReadbackPool() noexcept
+{
+    clear();
+}
+
+void ReadbackPool::initialise(GfxContext const &gfxIn) noexcept
+{
+    clear();
+    gfx        = gfxIn;
+    frameIndex = 0;
+}
+
+GfxBuffer ReadbackPool::acquire(uint64_t const size) noexcept
+{
+    if (!gfx)
+    {
+        return {};
+    }
+    // Reuse a buffer of the same bucket once the GPU can no longer be copying into it
+    uint64_t const bucketSize  = GetBucketSize(size);
+    uint64_t const reuseFrames = gfxGetBackBufferCount(gfx);
+    auto const [first, last]   = freeBuffers.equal_range(bucketSize);
+    for (auto freeBuffer = first; freeBuffer != last; ++freeBuffer)
+    {
+        if (frameIndex - freeBuffer->second.releaseFrame >= reuseFrames)
+        {
+            GfxBuffer const ret = freeBuffer->second.buffer;
+            freeBuffers.erase(freeBuffer);
+            return ret;
+        }
+    }
+    MemoryTracker::OwnerScope const owner(kMemoryOwner);
+    GfxBuffer                       ret = CreateBuffer(gfx, bucketSize, nullptr, kGfxCpuAccess_Read);
+    ret.setName("Capsaicin_ReadbackPoolBuffer");
+    return ret;
+}
+
+void ReadbackPool::release(GfxBuffer const &buffer) noexcept
+{
+    if (!buffer)
+    {
+        return;
+    }
+    try
+    {
+        freeBuffers.emplace(buffer.getSize(), FreeBuffer {buffer, frameIndex});
+    }
+    catch (...)
+    {
+        DestroyBuffer(gfx, buffer);
+    }
+}
+
+bool ReadbackPool::readback(
+    GfxBuffer const &buffer, uint64_t const offset, uint64_t const size, Callback callback) noexcept
+{
+    if (!buffer || size == 0 || offset + size > buffer.getSize())
+    {
+        GFX_PRINT_ERROR(kGfxResult_InvalidParameter, "Invalid readback range requested");
+        return false;
+    }
+    GfxBuffer const readbackBuffer = acquire(size);
+    if (!readbackBuffer)
+    {
+        return false;
+    }
+    try
+    {
+        pendingReadbacks.push_back({readbackBuffer, size, frameIndex, std::move(callback)});
+    }
+    catch (...)
+    {
+        release(readbackBuffer);
+        return false;
+    }
+    gfxCommandCopyBuffer(gfx, readbackBuffer, 0, buffer, offset, size);
+    return true;
+}
+
+void ReadbackPool::update() noexcept
+{
+    // Copies recorded N frames ago are guaranteed complete as gfx limits the number of frames in flight.
+    // Readbacks are stored in submission order so the completed ones are always at the front.
+    uint64_t const completeFrames = gfxGetBackBufferCount(gfx);
+    auto const     firstPending   = std::ranges::find_if(pendingReadbacks, [&](auto const &pendingReadback) {
+        return frameIndex - pendingReadback.submitFrame < completeFrames;
+    });
+    completeReadbacks(static_cast<size_t>(std::distance(pendingReadbacks.begin(), firstPending)));
+
+    // Destroy any buffers that have not been reused for a while
+    for (auto freeBuffer = freeBuffers.begin(); freeBuffer != freeBuffers.end();)
+    {
+        if (frameIndex - freeBuffer->second.releaseFrame > kMaxIdleFrames)
+        {
+            DestroyBuffer(gfx, freeBuffer->second.buffer);
+            freeBuffer = freeBuffers.erase(freeBuffer);
+        }
+        else
+        {
+            ++freeBuffer;
+        }
+    }
+    ++frameIndex;
+}
+
+void ReadbackPool::flush() noexcept
+{
+    completeReadbacks(pendingReadbacks.size());
+}
+
+void ReadbackPool::clear() noexcept
+{
+    for (auto &pendingReadback : pendingReadbacks)
+    {
+        DestroyBuffer(gfx, pendingReadback.buffer);
+    }
+    pendingReadbacks.clear();
+    for (auto &freeBuffer : freeBuffers)
+    {
+        DestroyBuffer(gfx, freeBuffer.second.buffer);
+    }
+    freeBuffers.clear();
+}
+
+uint32_t ReadbackPool::getPendingCount() const noexcept
+{
+    return static_cast<uint32_t>(pendingReadbacks.size());
+}
+
+void ReadbackPool::completeReadbacks(size_t const count) noexcept
+{
+    // Callbacks may request new readbacks so the completed ones are removed before any are invoked
+    auto const                   last = pendingReadbacks.begin() + static_cast<std::ptrdiff_t>(count);
+    std::vector<PendingReadback> completed;
+    try
+    {
+        completed.assign(std::make_move_iterator(pendingReadbacks.begin()), std::make_move_iterator(last));
+    }
+    catch (...)
+    {
+        return;
+    }
+    pendingReadbacks.erase(pendingReadbacks.begin(), last);
+    for (auto &readback : completed)
+    {
+        if (readback.callback)
+        {
+            try
+            {
+                readback.callback(gfxBufferGetData(gfx, readback.buffer), readback.size);
+            }
+            catch (...)
+            {
+                GFX_PRINTLN("Error: Readback callback failed");
+            }
+        }
+        release(readback.buffer);
+    }
+}
+
+uint64_t ReadbackPool::GetBucketSize(uint64_t const size) noexcept
+{
+    if (size <= kMinBucketSize)
+    {
+        return kMinBucketSize;
+    }
+    // Use 4 buckets per power of 2 to limit the wasted space to at most 25%
+    uint64_t const step = std::bit_floor(size) / 4;
+    return (size + step - 1) / step * step;
+}
+} // namespace Capsaicin
@@ -0,0 +1,149 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <gfx.h>
+#include <map>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * A pool of persistently mapped readback buffers shared between all CPU readbacks.
+ * Buffers are grouped into size buckets and only reused once the GPU can no longer be writing to them,
+ * which avoids creating and destroying a readback buffer for every image dump or readback request.
+ */
+class ReadbackPool
+{
+public:
+    /** Owner that pooled buffers are attributed to within the memory tracker */
+    static constexpr std::string_view kMemoryOwner = "Readback Pool";
+    /** Smallest buffer size handed out by the pool (bytes) */
+    static constexpr uint64_t kMinBucketSize = 64 * 1024;
+    /** Number of frames an unused buffer is kept before it is destroyed */
+    static constexpr uint64_t kMaxIdleFrames = 256;
+
+    /**
+     * Callback used to receive asynchronous readback data.
+     * @param data Pointer to the read back data, only valid for the duration of the call.
+     * @param size Size of the read back data (bytes).
+     */
+    using Callback = std::function<void(void const *data, uint64_t size)>;
+
+    ReadbackPool() noexcept = default;
+    ~ReadbackPool() noexcept;
+
+    ReadbackPool(ReadbackPool const &other)                = delete;
+    ReadbackPool(ReadbackPool &&other) noexcept            = delete;
+    ReadbackPool &operator=(ReadbackPool const &other)     = delete;
+    ReadbackPool &operator=(ReadbackPool &&other) noexcept = delete;
+
+    /**
+     * Initialise the pool.
+     * @param gfxIn Active gfx context.
+     */
+    void initialise(GfxContext const &gfxIn) noexcept;
+
+    /**
+     * Gets a readback buffer from the pool.
+     * @note The returned buffer may be larger than requested.
+     * @param size Minimum size of the buffer (bytes).
+     * @return The buffer, invalid if creation failed.
+     */
+    [[nodiscard]] GfxBuffer acquire(uint64_t size) noexcept;
+
+    /**
+     * Return a buffer to the pool.
+     * The buffer is not reused until any GPU copies recorded in the current frame have completed.
+     * @param buffer The buffer previously returned from acquire().
+     */
+    void release(GfxBuffer const &buffer) noexcept;
+
+    /**
+     * Asynchronously read back a range of a GPU buffer.
+     * @param buffer   The buffer to read from.
+     * @param offset   Offset of the range within the buffer (bytes).
+     * @param size     Size of the range (bytes).
+     * @param callback Called on the render thread from update() once the data is available.
+     * @return True if successful, False otherwise.
+     */
+    bool readback(GfxBuffer const &buffer, uint64_t offset, uint64_t size, Callback callback) noexcept;
+
+    /**
+     * Advance to the next frame.
+     * Invokes the callbacks of all completed readbacks and recycles buffers whose copies have completed.
+     * @note Must be called once per frame after all of the frames readbacks have been recorded.
+     */
+    void update() noexcept;
+
+    /**
+     * Invokes the callbacks of all pending readbacks.
+     * @note The GPU must be idle (e.g. after gfxFinish) before calling.
+     */
+    void flush() noexcept;
+
+    /** Destroy all pooled buffers, any pending readbacks are discarded. */
+    void clear() noexcept;
+
+    /**
+     * Gets the number of readbacks waiting on the GPU.
+     * @return The pending readback count.
+     */
+    [[nodiscard]] uint32_t getPendingCount() const noexcept;
+
+private:
+    /**
+     * Gets the size of the bucket used for a requested size.
+     * @param size The requested size (bytes).
+     * @return The bucket size (bytes).
+     */
+    static uint64_t GetBucketSize(uint64_t size) noexcept;
+
+    /**
+     * Invoke the callbacks of the oldest pending readbacks and return their buffers to the pool.
+     * @param count Number of readbacks to complete from the front of the pending list.
+     */
+    void completeReadbacks(size_t count) noexcept;
+
+    struct FreeBuffer
+    {
+        GfxBuffer buffer;
+        uint64_t  releaseFrame; /**< Frame that the buffer was last released */
+    };
+
+    struct PendingReadback
+    {
+        GfxBuffer buffer;
+        uint64_t  size;
+        uint64_t  submitFrame; /**< Frame that the copy was recorded */
+        Callback  callback;
+    };
+
+    GfxContext                          gfx;
+    uint64_t                            frameIndex = 0;
+    std::multimap<uint64_t, FreeBuffer> freeBuffers; /**< Released buffers keyed by bucket size */
+    std::vector<PendingReadback>        pendingReadbacks;
+};
+} // namespace Capsaicin
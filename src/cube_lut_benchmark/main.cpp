@@ -0,0 +1,319 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cube_lut.h"
+#include "lut_cache.h"
+#include "pixel_conversion.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/** Maximum difference allowed between the half precision table and the source values */
+constexpr float kTolerance = 1.0e-3F;
+
+/**
+ * Grade stored in the generated table, a mild contrast curve with a warm tint.
+ * @param color The input colour.
+ * @return The graded colour.
+ */
+CubeLut::Vector Grade(CubeLut::Vector const &color) noexcept
+{
+    CubeLut::Vector ret;
+    for (uint32_t channel = 0; channel < 3; ++channel)
+    {
+        float const value = color[channel] * color[channel] * (3.0F - 2.0F * color[channel]);
+        ret[channel]      = (0.5F * color[channel] + 0.5F * value) * (channel == 0 ? 1.0F : 0.95F);
+    }
+    return ret;
+}
+
+/**
+ * Generates the contents of a 3D '.cube' file in the form written by common grading applications.
+ * @param size The table size in each dimension.
+ * @return The file contents.
+ */
+string GenerateCube(uint32_t const size)
+{
+    string ret = "TITLE \"Capsaicin benchmark\"\n# Generated by cube_lut_benchmark\nLUT_3D_SIZE "
+               + to_string(size) + "\nDOMAIN_MIN 0.0 0.0 0.0\nDOMAIN_MAX 1.0 1.0 1.0\n\n";
+    ret.reserve(ret.size() + static_cast<size_t>(size) * size * size * 27);
+    float const      scale = 1.0F / static_cast<float>(size - 1);
+    array<char, 128> line {};
+    for (uint32_t b = 0; b < size; ++b)
+    {
+        for (uint32_t g = 0; g < size; ++g)
+        {
+            for (uint32_t r = 0; r < size; ++r)
+            {
+                auto const value = Grade({static_cast<float>(r) * scale, static_cast<float>(g) * scale,
+                    static_cast<float>(b) * scale});
+                int const  count = snprintf(line.data(), line.size(), "%.6f %.6f %.6f\n",
+                     static_cast<double>(value[0]), static_cast<double>(value[1]),
+                     static_cast<double>(value[2]));
+                ret.append(line.data(), static_cast<size_t>(count));
+            }
+        }
+    }
+    return ret;
+}
+
+/**
+ * Parse a 3D '.cube' file the same way as the previous ColorGrading loader, used as the baseline.
+ * Each whitespace separated token is copied into a fixed buffer and converted using std::stoi/std::stof.
+ * @param text  The file contents (only LUT_3D_SIZE followed by table data is supported).
+ * @param table Output table entries.
+ * @return True if successful, False otherwise.
+ */
+bool BaselineParse(string_view const text, vector<array<float, 4>> &table)
+{
+    array<char, 256> token {};
+    size_t           cursor     = 0;
+    uint32_t         tokenIndex = 0;
+    bool             inTable    = false;
+    table.clear();
+    while (cursor < text.size())
+    {
+        size_t const start = text.find_first_not_of(" \r\n", cursor);
+        if (start == string_view::npos)
+        {
+            break;
+        }
+        size_t const end = min(text.find_first_of(" \r\n", start), text.size());
+        cursor           = end;
+        memset(token.data(), 0, token.size());
+        memcpy(token.data(), text.data() + start, min(end - start, token.size() - 1));
+        if (!inTable)
+        {
+            // Skip the header up to the table size
+            if (strcmp(token.data(), "LUT_3D_SIZE") == 0)
+            {
+                inTable = true;
+            }
+            continue;
+        }
+        if (table.empty())
+        {
+            auto const size = static_cast<size_t>(stoi(token.data()));
+            table.resize(size * size * size);
+            continue;
+        }
+        if (strncmp(token.data(), "DOMAIN_", 7) == 0)
+        {
+            // Skip the domain keyword and its 3 values
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                size_t const valueStart = text.find_first_not_of(" \r\n", cursor);
+                cursor                  = min(text.find_first_of(" \r\n", valueStart), text.size());
+            }
+            continue;
+        }
+        if (tokenIndex >= 3 * table.size())
+        {
+            return false;
+        }
+        table[tokenIndex / 3][tokenIndex % 3] = stof(token.data());
+        table[tokenIndex / 3][3]              = 1.0F;
+        ++tokenIndex;
+    }
+    return !table.empty() && tokenIndex == 3 * table.size();
+}
+
+/**
+ * Times a load operation over a number of iterations.
+ * @param run        The operation, returns False on failure.
+ * @param iterations Number of timed runs (after 1 untimed warmup run).
+ * @return The median time (ms), negative if the operation failed.
+ */
+double Measure(function<bool()> const &run, uint32_t const iterations)
+{
+    if (!run())
+    {
+        return -1.0;
+    }
+    vector<double> times;
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        auto const start = chrono::steady_clock::now();
+        if (!run())
+        {
+            return -1.0;
+        }
+        times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    ranges::nth_element(times, times.begin() + static_cast<ptrdiff_t>(times.size() / 2));
+    return times[times.size() / 2];
+}
+
+/**
+ * Check a loaded table against the baseline parse and the grade it was generated from.
+ * @param lut      The loaded table.
+ * @param baseline The baseline table entries.
+ * @param size     The expected table size.
+ * @return True if all entries and interpolated values are within tolerance.
+ */
+bool Validate(CubeLut const &lut, vector<array<float, 4>> const &baseline, uint32_t const size)
+{
+    if (!lut.isValid() || lut.getType() != CubeLut::Type::LUT3D || lut.getSize() != size
+        || lut.getTexels().size() != baseline.size() * 4 * sizeof(uint16_t))
+    {
+        return false;
+    }
+    vector<float> values(baseline.size() * 4);
+    ConvertHalfToFloat(
+        reinterpret_cast<uint16_t const *>(lut.getTexels().data()), values.data(), values.size());
+    for (size_t i = 0; i < baseline.size(); ++i)
+    {
+        for (uint32_t channel = 0; channel < 4; ++channel)
+        {
+            if (abs(values[i * 4 + channel] - baseline[i][channel]) > kTolerance)
+            {
+                return false;
+            }
+        }
+    }
+    // Interpolated values between entries should closely follow the smooth source grade
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        CubeLut::Vector const color    = {static_cast<float>(i % 10) / 9.3F,
+               static_cast<float>(i / 10 % 10) / 9.7F, static_cast<float>(i / 100) / 9.1F};
+        CubeLut::Vector const result   = lut.evaluate(color);
+        CubeLut::Vector const expected = Grade(color);
+        for (uint32_t channel = 0; channel < 3; ++channel)
+        {
+            if (abs(result[channel] - expected[channel]) > 1.0F / static_cast<float>(size))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // unnamed namespace
+
+int main(int argc, char **argv)
+{
+    CLI::App app {"Capsaicin - Cube LUT Benchmark"};
+
+    uint32_t size = 65;
+    app.add_option("--size", size, "Size of the generated 3D table in each dimension")
+        ->check(CLI::Range(2U, CubeLut::kMaxSize3D))
+        ->capture_default_str();
+    uint32_t iterations = 16;
+    app.add_option("--iterations", iterations, "Number of timed runs of each method (median is reported)")
+        ->check(CLI::Range(1U, 10000U))
+        ->capture_default_str();
+
+    CLI11_PARSE(app, argc, argv);
+
+    // Write the generated table and cache into a temporary directory
+    filesystem::path const directory = filesystem::temp_directory_path() / "capsaicin_cube_lut_benchmark";
+    filesystem::path const filePath  = directory / "benchmark.cube";
+    error_code             errorCode;
+    filesystem::remove_all(directory, errorCode);
+    filesystem::create_directories(directory, errorCode);
+    string const text = GenerateCube(size);
+    {
+        ofstream file(filePath, ios::binary);
+        if (!file.write(text.data(), static_cast<streamsize>(text.size())))
+        {
+            cerr << "Failed to write " << filePath.string() << '\n';
+            return 1;
+        }
+    }
+    LutCache cache;
+    cache.setDirectory(directory / "cache");
+
+    vector<array<float, 4>> baseline;
+    CubeLut                 lut;
+    string                  error;
+    bool                    valid    = true;
+    bool                    firstRun = true;
+    struct Method
+    {
+        string         name;
+        function<bool()> run;
+    };
+    vector<Method> const methods = {
+        {        "tokenize+stof", [&] { return BaselineParse(text, baseline); }},
+        {"from_chars (memory)", [&] { return lut.parse(text, error); }},
+        {  "from_chars (mmap)", [&] { return lut.load(filePath, error); }},
+        {       "cached reload",
+         [&] {
+             bool const ret = lut.load(filePath, cache, error);
+             if (firstRun)
+             {
+                 // The first load parses the file and saves the cache entries in the background
+                 cache.flush();
+                 firstRun = false;
+             }
+             return ret;
+         }},
+    };
+
+    size_t const valueCount = static_cast<size_t>(size) * size * size * 3;
+    cout << "Table: " << size << "^3 (" << text.size() / 1024 << " KiB), iterations: " << iterations
+         << "\n\n";
+    cout << "Method               Median (ms)  Speedup  Throughput\n";
+    double baselineTime = 0.0;
+    for (auto const &[name, run] : methods)
+    {
+        double const time = Measure(run, iterations);
+        if (time < 0.0)
+        {
+            cerr << "Failed to load using " << name << (error.empty() ? "" : ": " + error) << '\n';
+            valid = false;
+            continue;
+        }
+        if (&name == &methods.front().name)
+        {
+            baselineTime = time;
+        }
+        else if (!Validate(lut, baseline, size))
+        {
+            cerr << "Table loaded using " << name << " does not match the source table\n";
+            valid = false;
+        }
+        array<char, 128> line {};
+        snprintf(line.data(), line.size(), "%-20s %11.3f  %6.2fx  %.1f MB/s  %.2f M values/s\n", name.c_str(),
+            time, time > 0.0 ? baselineTime / time : 0.0, static_cast<double>(text.size()) / (time * 1000.0),
+            static_cast<double>(valueCount) / (time * 1000.0));
+        cout << line.data();
+    }
+    filesystem::remove_all(directory, errorCode);
+    return valid ? 0 : 1;
+}
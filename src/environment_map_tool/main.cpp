@@ -0,0 +1,262 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_environment_map.h"
+#include "cpu_mip.h"
+#include "lut_cache.h"
+#include "pixel_conversion.h"
+#include "task_scheduler.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <stb_image.h>
+#include <string>
+#include <tinyexr.h>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/** A decoded image, channels are interleaved */
+struct Image
+{
+    uint32_t      width        = 0;
+    uint32_t      height       = 0;
+    uint32_t      channelCount = 0;
+    vector<float> values;
+};
+
+string ToLower(string value)
+{
+    ranges::transform(value, value.begin(), [](char const character) {
+        return static_cast<char>(tolower(static_cast<unsigned char>(character)));
+    });
+    return value;
+}
+
+/**
+ * Loads an EXR, HDR or LDR image as linear float values.
+ * @param path  Full pathname to the image.
+ * @param image Output decoded image.
+ * @param error Output reason for failure.
+ * @return True if successful, False otherwise.
+ */
+bool LoadImage(filesystem::path const &path, Image &image, string &error)
+{
+    string const fileName = path.string();
+    if (ToLower(path.extension().string()) == ".exr")
+    {
+        float      *rgba     = nullptr;
+        int         width    = 0;
+        int         height   = 0;
+        char const *exrError = nullptr;
+        if (LoadEXR(&rgba, &width, &height, fileName.c_str(), &exrError) != TINYEXR_SUCCESS)
+        {
+            error = exrError != nullptr ? exrError : "Failed to load EXR image";
+            FreeEXRErrorMessage(exrError);
+            return false;
+        }
+        image.width        = static_cast<uint32_t>(width);
+        image.height       = static_cast<uint32_t>(height);
+        image.channelCount = 4;
+        image.values.assign(rgba, rgba + static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+        free(rgba);
+        return true;
+    }
+
+    // stb linearises LDR formats so that all sources can be handled identically
+    int    width    = 0;
+    int    height   = 0;
+    int    channels = 0;
+    float *data     = stbi_loadf(fileName.c_str(), &width, &height, &channels, 0);
+    if (data == nullptr)
+    {
+        error = stbi_failure_reason();
+        return false;
+    }
+    image.width        = static_cast<uint32_t>(width);
+    image.height       = static_cast<uint32_t>(height);
+    image.channelCount = static_cast<uint32_t>(channels);
+    image.values.assign(data, data + static_cast<size_t>(width) * static_cast<size_t>(height) * channels);
+    stbi_image_free(data);
+    return true;
+}
+
+/**
+ * Times a single processing stage.
+ * @param name     Name of the stage.
+ * @param function The stage to run.
+ * @return The value returned by the stage.
+ */
+bool TimeStage(string_view const &name, function<bool()> const &function)
+{
+    auto const   start   = chrono::steady_clock::now();
+    bool const   ret     = function();
+    double const elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cerr << name << ": " << elapsed << " ms" << (ret ? "" : " (failed)") << endl;
+    return ret;
+}
+
+/**
+ * Converts float RGBA values to the half precision layout stored in the cache.
+ * @param values The values to convert.
+ * @return The converted data.
+ */
+vector<byte> ConvertToHalf(vector<float> const &values)
+{
+    vector<byte> ret(values.size() * sizeof(uint16_t));
+    ConvertFloatToHalf(values.data(), reinterpret_cast<uint16_t *>(ret.data()), values.size());
+    return ret;
+}
+
+/**
+ * Writes a single cache entry, reporting its name.
+ * @param cache       The cache to write to.
+ * @param key         The entry key.
+ * @param description Layout of the data.
+ * @param data        The data to write.
+ * @return True if successful, False otherwise.
+ */
+bool Save(LutCache const &cache, LutCache::Key const &key, LutCache::Description const &description,
+    span<byte const> const data)
+{
+    if (!cache.save(key, description, data))
+    {
+        cerr << "Failed to write cache entry: " << key.getName() << endl;
+        return false;
+    }
+    cout << (cache.getDirectory() / key.getName()).generic_string() << endl;
+    return true;
+}
+
+/**
+ * Generates and caches all environment map data for a single source image.
+ * @param environmentMap The decoded source image.
+ * @param fileHash       Hash of the contents of the source file.
+ * @param renderSizes    Render resolutions to generate runtime cube maps for.
+ * @param cache          The cache to write to.
+ * @return True if successful, False otherwise.
+ */
+bool Process(CPUEnvironmentMap const &environmentMap, uint64_t const fileHash,
+    vector<array<uint32_t, 2>> const &renderSizes, LutCache const &cache)
+{
+    uint32_t const sourceWidth  = environmentMap.getWidth();
+    uint32_t const sourceHeight = environmentMap.getHeight();
+    bool           ret          = true;
+
+    // Runtime cube maps, keyed identically to CapsaicinInternal::generateEnvironmentMap
+    vector<float> cubeMap;
+    for (auto const &[renderWidth, renderHeight] : renderSizes)
+    {
+        uint32_t const size =
+            CPUEnvironmentMap::GetCubeMapSize(renderWidth, renderHeight, sourceWidth, sourceHeight);
+        uint32_t const mipCount = CPUMip::GetMipCount(size, size);
+        string const   name     = "Cube map " + to_string(size) + " (" + to_string(renderWidth) + 'x'
+                          + to_string(renderHeight) + ')';
+        if (!TimeStage(name, [&] { return environmentMap.generateCubeMap(size, mipCount, cubeMap); }))
+        {
+            return false;
+        }
+        ret &= Save(cache, CPUEnvironmentMap::GetCubeMapKey(fileHash, renderWidth, renderHeight),
+            CPUEnvironmentMap::GetCubeMapDescription(size, mipCount), ConvertToHalf(cubeMap));
+    }
+
+    return ret;
+}
+
+} // unnamed namespace
+
+int main(int argc, char **argv)
+{
+    CLI::App app {"Capsaicin - Environment Map Tool"};
+
+    filesystem::path inputPath;
+    app.add_option("input", inputPath, "The equirectangular EXR/HDR environment map to process")
+        ->check(CLI::ExistingFile);
+    filesystem::path cachePath = "cache/luts";
+    app.add_option("--cache-dir", cachePath, "Directory to write cache entries to")->capture_default_str();
+    vector<string> renderSizeNames;
+    app.add_option("--render-size", renderSizeNames,
+        "Render resolutions (WxH) to generate runtime environment cube maps for (Default 1920x1080)");
+    uint32_t workerThreads = ~0U;
+    app.add_option("--worker-threads", workerThreads,
+        "Number of task scheduler worker threads (default based on hardware concurrency)");
+
+    CLI11_PARSE(app, argc, argv);
+
+    TaskScheduler::Get().setWorkerCount(workerThreads, false);
+    if (inputPath.empty())
+    {
+        cerr << "An input environment map is required" << endl;
+        return 1;
+    }
+    if (renderSizeNames.empty())
+    {
+        renderSizeNames.emplace_back("1920x1080");
+    }
+    vector<array<uint32_t, 2>> renderSizes;
+    for (auto const &renderSizeName : renderSizeNames)
+    {
+        array<uint32_t, 2> renderSize = {};
+        if (sscanf(renderSizeName.c_str(), "%ux%u", &renderSize[0], &renderSize[1]) != 2 || renderSize[0] == 0
+            || renderSize[1] == 0)
+        {
+            cerr << "Invalid render size: " << renderSizeName << endl;
+            return 1;
+        }
+        renderSizes.push_back(renderSize);
+    }
+
+    // The file hash must match the runtime so that cube map entries are found when loading the same file
+    uint64_t          fileHash = 0;
+    Image             image;
+    string            error;
+    CPUEnvironmentMap environmentMap;
+    if (!TimeStage("Hash", [&] { return LutCache::HashFile(inputPath, fileHash); })
+        || !TimeStage("Load", [&] { return LoadImage(inputPath, image, error); }))
+    {
+        cerr << "Failed to load environment map: " << inputPath.string() << (error.empty() ? "" : ": ")
+             << error << endl;
+        return 1;
+    }
+    if (!TimeStage("Decode", [&] {
+            return environmentMap.initialise(image.width, image.height, image.channelCount, image.values);
+        }))
+    {
+        return 1;
+    }
+    image = {};
+
+    LutCache cache;
+    cache.setDirectory(cachePath);
+    bool const ret = Process(environmentMap, fileHash, renderSizes, cache);
+    TaskScheduler::Get().shutdown();
+    return ret ? 0 : 1;
+}
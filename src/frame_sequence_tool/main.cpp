@@ -0,0 +1,297 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "frame_sequence.h"
+#include "pixel_conversion.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/**
+ * Reads a frame from a sequence and converts each plane to float.
+ * @param reader The sequence to read from.
+ * @param frame  The frame within the sequence.
+ * @param planes Reused buffer for the raw frame data.
+ * @param values Output values, each channel stored as a separate plane.
+ * @return True if successful, False otherwise.
+ */
+bool ReadFrameAsFloat(
+    FrameSequenceReader &reader, uint32_t const frame, vector<uint8_t> &planes, vector<float> &values)
+{
+    FrameSequenceHeader const &header = reader.getHeader();
+    size_t const valueCount = static_cast<size_t>(header.width) * header.height * header.channelCount;
+    planes.resize(GetFrameSequenceFrameSize(header));
+    values.resize(valueCount);
+    if (!reader.readFrame(frame, planes.data()))
+    {
+        return false;
+    }
+    if (header.pixelType == FrameSequencePixelType::Float16)
+    {
+        ConvertHalfToFloat(reinterpret_cast<uint16_t const *>(planes.data()), values.data(), valueCount);
+    }
+    else
+    {
+        ConvertUnormToFloat(planes.data(), values.data(), valueCount);
+    }
+    return true;
+}
+
+/**
+ * Saves a frame as a PFM (float) or PPM/PGM (8bit) image, the formats are written without any dependencies.
+ * @note Only the first 3 channels are saved, single channel frames are saved as greyscale.
+ * @param filePath Full pathname to the file to save as (extension is replaced).
+ * @param header   The sequence header.
+ * @param planes   The raw frame data.
+ * @return True if successful, False otherwise.
+ */
+bool SaveFrame(filesystem::path filePath, FrameSequenceHeader const &header, vector<uint8_t> const &planes)
+{
+    bool const     isFloat      = header.pixelType == FrameSequencePixelType::Float16;
+    uint32_t const outputCount  = header.channelCount == 1 ? 1 : 3;
+    size_t const   pixelCount   = static_cast<size_t>(header.width) * header.height;
+    filePath.replace_extension(isFloat ? ".pfm" : (outputCount == 1 ? ".pgm" : ".ppm"));
+    ofstream file(filePath, ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    if (isFloat)
+    {
+        // PFM stores little endian (negative scale) float rows from bottom to top
+        file << (outputCount == 1 ? "Pf\n" : "PF\n") << header.width << ' ' << header.height << "\n-1.0\n";
+        vector<float> row(static_cast<size_t>(header.width) * outputCount);
+        vector<float> values(header.width);
+        for (uint32_t y = header.height; y-- > 0;)
+        {
+            for (uint32_t channel = 0; channel < outputCount; ++channel)
+            {
+                // Missing channels of 2 channel frames are written as zero
+                if (channel >= header.channelCount)
+                {
+                    ranges::fill(values, 0.0F);
+                }
+                else
+                {
+                    ConvertHalfToFloat(reinterpret_cast<uint16_t const *>(planes.data())
+                                           + channel * pixelCount + static_cast<size_t>(y) * header.width,
+                        values.data(), header.width);
+                }
+                for (uint32_t x = 0; x < header.width; ++x)
+                {
+                    row[static_cast<size_t>(x) * outputCount + channel] = values[x];
+                }
+            }
+            file.write(reinterpret_cast<char const *>(row.data()),
+                static_cast<streamsize>(row.size() * sizeof(float)));
+        }
+    }
+    else
+    {
+        file << (outputCount == 1 ? "P5\n" : "P6\n") << header.width << ' ' << header.height << "\n255\n";
+        vector<uint8_t> pixels(pixelCount * outputCount);
+        for (size_t pixel = 0; pixel < pixelCount; ++pixel)
+        {
+            for (uint32_t channel = 0; channel < outputCount; ++channel)
+            {
+                pixels[pixel * outputCount + channel] =
+                    channel < header.channelCount ? planes[channel * pixelCount + pixel] : 0;
+            }
+        }
+        file.write(reinterpret_cast<char const *>(pixels.data()), static_cast<streamsize>(pixels.size()));
+    }
+    return file.good();
+}
+
+bool PrintInfo(FrameSequenceReader const &reader)
+{
+    FrameSequenceHeader const &header = reader.getHeader();
+    cout << "Dimensions: " << header.width << 'x' << header.height << '\n'
+         << "Channels: " << header.channelCount << '\n'
+         << "Pixel Type: " << (header.pixelType == FrameSequencePixelType::Float16 ? "float16" : "uint8")
+         << '\n'
+         << "Frames: " << reader.getFrameCount() << '\n';
+    if (reader.getFrameCount() > 0)
+    {
+        double totalTime = 0.0;
+        for (uint32_t frame = 0; frame < reader.getFrameCount(); ++frame)
+        {
+            totalTime += reader.getIndexEntry(frame).frameTime;
+        }
+        cout << "First Frame Index: " << reader.getIndexEntry(0).frameIndex << '\n'
+             << "Last Frame Index: " << reader.getIndexEntry(reader.getFrameCount() - 1).frameIndex << '\n'
+             << "Average Frame Time (ms): " << totalTime / reader.getFrameCount() << '\n';
+    }
+    return true;
+}
+
+bool ExtractFrames(FrameSequenceReader &reader, filesystem::path const &sequencePath,
+    vector<uint32_t> frames, filesystem::path const &outputDirectory)
+{
+    if (frames.empty())
+    {
+        for (uint32_t frame = 0; frame < reader.getFrameCount(); ++frame)
+        {
+            frames.push_back(frame);
+        }
+    }
+    if (error_code ec; !exists(outputDirectory, ec))
+    {
+        create_directories(outputDirectory, ec);
+    }
+    vector<uint8_t> planes(GetFrameSequenceFrameSize(reader.getHeader()));
+    for (uint32_t const frame : frames)
+    {
+        if (frame >= reader.getFrameCount())
+        {
+            cerr << "Frame " << frame << " is outside the sequence" << endl;
+            return false;
+        }
+        filesystem::path filePath = outputDirectory / sequencePath.stem();
+        filePath += '_';
+        filePath += to_string(reader.getIndexEntry(frame).frameIndex);
+        if (!reader.readFrame(frame, planes.data()) || !SaveFrame(filePath, reader.getHeader(), planes))
+        {
+            cerr << "Failed to extract frame " << frame << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ComputeMetrics(FrameSequenceReader &reader, FrameSequenceReader &reference)
+{
+    FrameSequenceHeader const &header          = reader.getHeader();
+    FrameSequenceHeader const &referenceHeader = reference.getHeader();
+    if (header.width != referenceHeader.width || header.height != referenceHeader.height
+        || header.channelCount != referenceHeader.channelCount)
+    {
+        cerr << "Reference dimensions do not match the sequence" << endl;
+        return false;
+    }
+    if (reference.getFrameCount() != 1 && reference.getFrameCount() < reader.getFrameCount())
+    {
+        cerr << "Reference must contain a single frame or at least as many frames as the sequence" << endl;
+        return false;
+    }
+
+    // Values are compared in [0, 1] for 8bit data so the PSNR peak is 1 for all pixel types
+    vector<uint8_t> planes;
+    vector<float>   values;
+    vector<float>   referenceValues;
+    bool const      singleReference = reference.getFrameCount() == 1;
+    if (singleReference && !ReadFrameAsFloat(reference, 0, planes, referenceValues))
+    {
+        cerr << "Failed to read reference frame" << endl;
+        return false;
+    }
+    cout << "Frame,FrameIndex,FrameTime (ms),MSE,RMSE,PSNR (dB)\n";
+    for (uint32_t frame = 0; frame < reader.getFrameCount(); ++frame)
+    {
+        if (!ReadFrameAsFloat(reader, frame, planes, values)
+            || (!singleReference && !ReadFrameAsFloat(reference, frame, planes, referenceValues)))
+        {
+            cerr << "Failed to read frame " << frame << endl;
+            return false;
+        }
+        double sum = 0.0;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            double const difference = static_cast<double>(values[i] - referenceValues[i]);
+            sum += difference * difference;
+        }
+        double const mse  = values.empty() ? 0.0 : sum / static_cast<double>(values.size());
+        double const psnr = mse > 0.0 ? -10.0 * log10(mse) : numeric_limits<double>::infinity();
+        auto const  &entry = reader.getIndexEntry(frame);
+        cout << frame << ',' << entry.frameIndex << ',' << entry.frameTime << ',' << mse << ',' << sqrt(mse)
+             << ',' << psnr << '\n';
+    }
+    return true;
+}
+} // unnamed namespace
+
+int main(int argc, char **argv)
+{
+    CLI::App app {"Capsaicin - Frame Sequence Tool"};
+    app.require_subcommand(1);
+
+    filesystem::path sequencePath;
+    auto            *info = app.add_subcommand("info", "Print the layout and frame count of a sequence");
+    info->add_option("sequence", sequencePath, "The .capseq file")->required()->check(CLI::ExistingFile);
+
+    auto *extract = app.add_subcommand("extract", "Save frames as PFM (float16) or PPM/PGM (uint8)");
+    vector<uint32_t> frames;
+    filesystem::path outputDirectory = "./";
+    extract->add_option("sequence", sequencePath, "The .capseq file")->required()->check(CLI::ExistingFile);
+    extract->add_option("--frame", frames, "Frames within the sequence to extract (Default all frames)");
+    extract->add_option("--output", outputDirectory, "Directory to save frames to")->capture_default_str();
+
+    auto *metrics = app.add_subcommand("metrics", "Output MSE/RMSE/PSNR of each frame against a reference");
+    filesystem::path referencePath;
+    metrics->add_option("sequence", sequencePath, "The .capseq file")->required()->check(CLI::ExistingFile);
+    metrics
+        ->add_option("reference", referencePath,
+            "The reference .capseq file, a single frame reference is compared against every frame")
+        ->required()
+        ->check(CLI::ExistingFile);
+
+    CLI11_PARSE(app, argc, argv);
+
+    FrameSequenceReader reader;
+    if (!reader.open(sequencePath))
+    {
+        cerr << "Failed to open frame sequence: " << sequencePath.string() << endl;
+        return 1;
+    }
+    bool ret = false;
+    if (info->parsed())
+    {
+        ret = PrintInfo(reader);
+    }
+    else if (extract->parsed())
+    {
+        ret = ExtractFrames(reader, sequencePath, frames, outputDirectory);
+    }
+    else if (metrics->parsed())
+    {
+        FrameSequenceReader reference;
+        if (!reference.open(referencePath))
+        {
+            cerr << "Failed to open frame sequence: " << referencePath.string() << endl;
+            return 1;
+        }
+        ret = ComputeMetrics(reader, reference);
+    }
+    return ret ? 0 : 1;
+}
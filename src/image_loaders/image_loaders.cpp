@@ -20,7 +20,18 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ********************************************************************/
 
-float4 DrawSky(in uint idx : SV_VertexID) : SV_Position
-{
-    return 1.0f - float4(4.0f * (idx & 1), 4.0f * (idx >> 1), 1.0f, 0.0f);
-}
+// Implementations of the image loaders shared by the host tools, built separately so that warnings in third
+// party code are ignored.
+// EXR compression uses the stb zlib implementation so that miniz is not required
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#if !defined(CAPSAICIN_TINYEXR_LIBRARY)
+#    define STB_IMAGE_WRITE_IMPLEMENTATION
+#    include <stb_image_write.h>
+
+#    define TINYEXR_USE_MINIZ    0
+#    define TINYEXR_USE_STB_ZLIB 1
+#    define TINYEXR_IMPLEMENTATION
+#    include <tinyexr.h>
+#endif
@@ -0,0 +1,357 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_image_metrics.h"
+#include "pixel_conversion.h"
+#include "task_scheduler.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stb_image.h>
+#include <string>
+#include <tinyexr.h>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+using Type      = CPUImageMetrics::Type;
+using Operation = CPUImageMetrics::Operation;
+
+/** Command line name of each image type, in enum order */
+constexpr array<string_view, 6> kTypeNames = {
+    "hdr", "hdr_rgb", "sdr", "sdr_rgb", "sdr_nonlinear", "sdr_srgb"};
+
+/** Name of each metric, in enum order */
+constexpr array<string_view, 6> kOperationNames = {"MSE", "RMSE", "PSNR", "RMAE", "SMAPE", "SSIM"};
+
+/** A decoded image, channels are interleaved */
+struct Image
+{
+    uint32_t      width        = 0;
+    uint32_t      height       = 0;
+    uint32_t      channelCount = 0;
+    vector<float> values;
+};
+
+/** A source and reference image pair along with the calculated metrics */
+struct Comparison
+{
+    filesystem::path name;            /**< Path relative to the compared directories */
+    filesystem::path source;
+    filesystem::path reference;
+    vector<double>   values     = {}; /**< Value of each requested metric */
+    uint64_t         pixelCount = 0;
+    string           error      = {}; /**< Reason the comparison failed, empty if successful */
+};
+
+string ToLower(string value)
+{
+    ranges::transform(value, value.begin(), [](char const character) {
+        return static_cast<char>(tolower(static_cast<unsigned char>(character)));
+    });
+    return value;
+}
+
+bool IsImageFile(filesystem::path const &path)
+{
+    string const extension = ToLower(path.extension().string());
+    return extension == ".exr" || extension == ".png";
+}
+
+/**
+ * Gets the image type used for a comparison.
+ * @param path     The source image.
+ * @param typeName The requested type, 'auto' selects based on the file type.
+ * @return The image type.
+ */
+Type GetType(filesystem::path const &path, string const &typeName)
+{
+    if (auto const type = ranges::find(kTypeNames, typeName); type != kTypeNames.end())
+    {
+        return static_cast<Type>(distance(kTypeNames.begin(), type));
+    }
+    return ToLower(path.extension().string()) == ".exr" ? Type::HDR_RGB : Type::SDR_SRGB;
+}
+
+/**
+ * Loads an EXR or PNG image as float values.
+ * @note PNG images are expanded to RGBA and, unless the type expects gamma corrected values, are linearised
+ * the same way as reading from an sRGB texture on the GPU.
+ * @param path  Full pathname to the image.
+ * @param type  The type of comparison the image is used for.
+ * @param image Output decoded image.
+ * @param error Output reason for failure.
+ * @return True if successful, False otherwise.
+ */
+bool LoadImage(filesystem::path const &path, Type const type, Image &image, string &error)
+{
+    string const fileName = path.string();
+    if (ToLower(path.extension().string()) == ".exr")
+    {
+        float      *rgba     = nullptr;
+        int         width    = 0;
+        int         height   = 0;
+        char const *exrError = nullptr;
+        if (LoadEXR(&rgba, &width, &height, fileName.c_str(), &exrError) != TINYEXR_SUCCESS)
+        {
+            error = exrError != nullptr ? exrError : "Failed to load EXR image";
+            FreeEXRErrorMessage(exrError);
+            return false;
+        }
+        image.width        = static_cast<uint32_t>(width);
+        image.height       = static_cast<uint32_t>(height);
+        image.channelCount = 4;
+        image.values.assign(rgba, rgba + static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+        free(rgba);
+        return true;
+    }
+
+    int        width    = 0;
+    int        height   = 0;
+    int        channels = 0;
+    bool const is16Bit  = stbi_is_16_bit(fileName.c_str()) != 0;
+    void *data = is16Bit ? static_cast<void *>(stbi_load_16(fileName.c_str(), &width, &height, &channels, 4))
+                         : static_cast<void *>(stbi_load(fileName.c_str(), &width, &height, &channels, 4));
+    if (data == nullptr)
+    {
+        error = stbi_failure_reason();
+        return false;
+    }
+    image.width        = static_cast<uint32_t>(width);
+    image.height       = static_cast<uint32_t>(height);
+    image.channelCount = 4;
+    size_t const count = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    image.values.resize(count);
+    if (is16Bit)
+    {
+        ConvertUnormToFloat(static_cast<uint16_t const *>(data), image.values.data(), count);
+    }
+    else
+    {
+        ConvertUnormToFloat(static_cast<uint8_t const *>(data), image.values.data(), count);
+    }
+    stbi_image_free(data);
+    if (type != Type::SDR_NONLINEAR)
+    {
+        TaskScheduler::Get().parallelFor(
+            size_t {0}, count / 4,
+            [&image](size_t const pixel) {
+                for (float &value : span(&image.values[pixel * 4], 3))
+                {
+                    value = value <= 0.04045F ? value / 12.92F : pow((value + 0.055F) / 1.055F, 2.4F);
+                }
+            },
+            4096);
+    }
+    return true;
+}
+
+/**
+ * Gets the list of image pairs to compare.
+ * @param sourcePath    The source image or directory.
+ * @param referencePath The reference image or directory.
+ * @param comparisons   Output image pairs, directories are searched recursively and matched by relative path.
+ * @return True if successful, False otherwise.
+ */
+bool GetComparisons(filesystem::path const &sourcePath, filesystem::path const &referencePath,
+    vector<Comparison> &comparisons)
+{
+    bool const isDirectory = filesystem::is_directory(sourcePath);
+    if (isDirectory != filesystem::is_directory(referencePath))
+    {
+        cerr << "Source and reference must both be either images or directories" << endl;
+        return false;
+    }
+    if (!isDirectory)
+    {
+        comparisons.push_back({sourcePath.filename(), sourcePath, referencePath});
+        return true;
+    }
+    for (auto const &entry : filesystem::recursive_directory_iterator(sourcePath))
+    {
+        if (entry.is_regular_file() && IsImageFile(entry.path()))
+        {
+            filesystem::path const name = entry.path().lexically_relative(sourcePath);
+            comparisons.push_back({name, entry.path(), referencePath / name});
+        }
+    }
+    ranges::sort(comparisons, {}, &Comparison::name);
+    return true;
+}
+
+/**
+ * Loads and compares a single image pair.
+ * @param comparison The image pair, values and error are updated with the result.
+ * @param typeName   The requested image type.
+ * @param operations The metrics to calculate.
+ */
+void Compare(Comparison &comparison, string const &typeName, vector<Operation> const &operations)
+{
+    if (!filesystem::exists(comparison.reference))
+    {
+        comparison.error = "Missing reference image";
+        return;
+    }
+    Type const type = GetType(comparison.source, typeName);
+    Image      source;
+    Image      reference;
+    if (!LoadImage(comparison.source, type, source, comparison.error)
+        || !LoadImage(comparison.reference, type, reference, comparison.error))
+    {
+        return;
+    }
+    if (source.width != reference.width || source.height != reference.height)
+    {
+        comparison.error = "Image dimensions do not match";
+        return;
+    }
+    comparison.values.resize(operations.size());
+    comparison.pixelCount = static_cast<uint64_t>(source.width) * source.height;
+    if (!CPUImageMetrics::Compare(source.values.data(), reference.values.data(), source.width, source.height,
+            source.channelCount, type, operations, comparison.values.data()))
+    {
+        comparison.error = "Failed to calculate metrics";
+    }
+}
+} // unnamed namespace
+
+int main(int argc, char **argv)
+{
+    CLI::App app {"Capsaicin - Image Metrics Tool"};
+
+    filesystem::path sourcePath;
+    filesystem::path referencePath;
+    app.add_option("source", sourcePath, "The EXR/PNG image or directory of images to compare")
+        ->required()
+        ->check(CLI::ExistingPath);
+    app.add_option("reference", referencePath,
+           "The reference image or directory, directory images are matched by relative path")
+        ->required()
+        ->check(CLI::ExistingPath);
+    string typeName = "auto";
+    app.add_option("--type", typeName,
+           "Image type (hdr, hdr_rgb, sdr, sdr_rgb, sdr_nonlinear, sdr_srgb), auto uses hdr_rgb for EXR and "
+           "sdr_srgb for PNG")
+        ->capture_default_str();
+    vector<string> metricNames;
+    app.add_option("--metric", metricNames, "Metrics to calculate (MSE, RMSE, PSNR, RMAE, SMAPE, SSIM)");
+    filesystem::path outputPath;
+    app.add_option("--output", outputPath, "CSV file to write results to (Default standard output)");
+    uint32_t workerThreads = ~0U;
+    app.add_option("--worker-threads", workerThreads,
+        "Number of task scheduler worker threads (default based on hardware concurrency)");
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (typeName != "auto" && ranges::find(kTypeNames, typeName) == kTypeNames.end())
+    {
+        cerr << "Unknown image type: " << typeName << endl;
+        return 1;
+    }
+    vector<Operation> operations;
+    for (auto const &metricName : metricNames)
+    {
+        auto const operation = ranges::find_if(kOperationNames, [&metricName](string_view const name) {
+            return ToLower(string(name)) == ToLower(metricName);
+        });
+        if (operation == kOperationNames.end())
+        {
+            cerr << "Unknown metric: " << metricName << endl;
+            return 1;
+        }
+        operations.push_back(static_cast<Operation>(distance(kOperationNames.begin(), operation)));
+    }
+    if (operations.empty())
+    {
+        for (size_t i = 0; i < kOperationNames.size(); ++i)
+        {
+            operations.push_back(static_cast<Operation>(i));
+        }
+    }
+
+    vector<Comparison> comparisons;
+    if (!GetComparisons(sourcePath, referencePath, comparisons))
+    {
+        return 1;
+    }
+
+    // Image pairs are compared in parallel, each comparison also splits its rows between worker threads
+    TaskScheduler::Get().setWorkerCount(workerThreads, false);
+    auto const start = chrono::steady_clock::now();
+    TaskScheduler::Get().parallelFor(
+        size_t {0}, comparisons.size(),
+        [&](size_t const index) { Compare(comparisons[index], typeName, operations); }, 1);
+    double const elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    ofstream file;
+    if (!outputPath.empty())
+    {
+        file.open(outputPath);
+        if (!file.is_open())
+        {
+            cerr << "Failed to open output file: " << outputPath.string() << endl;
+            return 1;
+        }
+    }
+    ostream &output = outputPath.empty() ? cout : file;
+    output << "Image";
+    for (auto const operation : operations)
+    {
+        output << ',' << kOperationNames[static_cast<size_t>(operation)];
+    }
+    output << '\n';
+    uint32_t failedCount = 0;
+    uint64_t pixelCount  = 0;
+    for (auto const &comparison : comparisons)
+    {
+        if (!comparison.error.empty())
+        {
+            cerr << comparison.name.generic_string() << ": " << comparison.error << endl;
+            ++failedCount;
+            continue;
+        }
+        output << comparison.name.generic_string();
+        for (double const value : comparison.values)
+        {
+            output << ',' << value;
+        }
+        output << '\n';
+        pixelCount += comparison.pixelCount;
+    }
+
+    double const megapixels = static_cast<double>(pixelCount) / 1.0e6;
+    cerr << "Compared " << comparisons.size() - failedCount << " of " << comparisons.size() << " images ("
+         << megapixels << " MP) in " << elapsed << " s, " << (elapsed > 0.0 ? megapixels / elapsed : 0.0)
+         << " MP/s" << endl;
+    TaskScheduler::Get().shutdown();
+    return failedCount == 0 && output.good() ? 0 : 1;
+}
@@ -0,0 +1,599 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark_suite.h"
+
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using nlohmann::ordered_json;
+
+namespace
+{
+template<typename T>
+bool ReadScalar(
+    YAML::Node const &parent, string const &key, string_view const type, T &value, string &error)
+{
+    auto const member = parent[key];
+    if (!member || member.IsNull())
+    {
+        return true;
+    }
+    if (!member.IsScalar() || !YAML::convert<T>::decode(member, value))
+    {
+        error = "'" + key + "' must be " + string(type);
+        return false;
+    }
+    return true;
+}
+
+bool ReadCount(YAML::Node const &parent, string const &key, uint32_t const minimum, uint32_t &value,
+    string &error)
+{
+    double number = static_cast<double>(value);
+    if (!ReadScalar(parent, key, "a number", number, error))
+    {
+        return false;
+    }
+    if (number < static_cast<double>(minimum) || number > static_cast<double>(numeric_limits<uint32_t>::max())
+        || floor(number) != number)
+    {
+        error = "'" + key + "' must be an integer >= " + to_string(minimum);
+        return false;
+    }
+    value = static_cast<uint32_t>(number);
+    return true;
+}
+
+bool ReadString(YAML::Node const &parent, string const &key, string &value, string &error)
+{
+    return ReadScalar(parent, key, "a string", value, error);
+}
+
+/** Parse a resolution given either as a "WxH" string or a {width: W, height: H} map */
+bool ReadResolution(YAML::Node const &resolution, uint32_t &width, uint32_t &height)
+{
+    if (resolution.IsMap())
+    {
+        string error;
+        return ReadCount(resolution, "width", 1, width, error)
+            && ReadCount(resolution, "height", 1, height, error) && width > 0 && height > 0;
+    }
+    if (!resolution.IsScalar())
+    {
+        return false;
+    }
+    auto const &text      = resolution.Scalar();
+    auto const  separator = text.find_first_of("xX");
+    if (separator == string::npos)
+    {
+        return false;
+    }
+    auto const *widthEnd               = text.data() + separator;
+    auto const *heightEnd              = text.data() + text.size();
+    auto const [widthLast, widthError] = from_chars(text.data(), widthEnd, width);
+    auto const [heightLast, heightError] = from_chars(widthEnd + 1, heightEnd, height);
+    return widthError == errc() && widthLast == widthEnd && heightError == errc() && heightLast == heightEnd
+        && width > 0 && height > 0;
+}
+
+/**
+ * Convert a YAML node to JSON so that render options can be stored in the results file.
+ * Quoted scalars are kept as strings, plain scalars are converted to the first matching type of bool,
+ * integer or floating point.
+ */
+ordered_json OptionsToJson(YAML::Node const &node)
+{
+    switch (node.Type())
+    {
+    case YAML::NodeType::Sequence:
+    {
+        ordered_json ret = ordered_json::array();
+        for (auto const &element : node)
+        {
+            ret.push_back(OptionsToJson(element));
+        }
+        return ret;
+    }
+    case YAML::NodeType::Map:
+    {
+        ordered_json ret = ordered_json::object();
+        for (auto const &member : node)
+        {
+            ret[member.first.Scalar()] = OptionsToJson(member.second);
+        }
+        return ret;
+    }
+    case YAML::NodeType::Scalar:
+    {
+        if (node.Tag() == "!")
+        {
+            return node.Scalar();
+        }
+        if (bool value = false; YAML::convert<bool>::decode(node, value))
+        {
+            return value;
+        }
+        if (int64_t value = 0; YAML::convert<int64_t>::decode(node, value))
+        {
+            return value;
+        }
+        if (double value = 0.0; YAML::convert<double>::decode(node, value))
+        {
+            return value;
+        }
+        return node.Scalar();
+    }
+    default: return nullptr;
+    }
+}
+
+/** Get an object member, or null if it does not exist */
+ordered_json const &GetMember(ordered_json const &parent, char const *key)
+{
+    static ordered_json const null;
+    auto const                found = parent.find(key);
+    return found != parent.end() ? *found : null;
+}
+
+template<typename T = double>
+T GetNumber(ordered_json const &value)
+{
+    return value.is_number() ? value.get<T>() : T();
+}
+
+string GetString(ordered_json const &value)
+{
+    return value.is_string() ? value.get<string>() : string();
+}
+
+ordered_json TimingToJson(BenchmarkTiming const &timing)
+{
+    ordered_json ret;
+    ret["count"]    = timing.count;
+    ret["mean"]     = timing.mean;
+    ret["std_dev"]  = timing.standardDeviation;
+    ret["min"]      = timing.minimum;
+    ret["max"]      = timing.maximum;
+    ret["p50"]      = timing.p50;
+    ret["p90"]      = timing.p90;
+    ret["p99"]      = timing.p99;
+    ret["stutters"] = timing.stutterCount;
+    return ret;
+}
+
+BenchmarkTiming TimingFromJson(ordered_json const &value)
+{
+    BenchmarkTiming ret;
+    ret.count             = GetNumber<uint64_t>(GetMember(value, "count"));
+    ret.mean              = GetNumber(GetMember(value, "mean"));
+    ret.standardDeviation = GetNumber(GetMember(value, "std_dev"));
+    ret.minimum           = GetNumber(GetMember(value, "min"));
+    ret.maximum           = GetNumber(GetMember(value, "max"));
+    ret.p50               = GetNumber(GetMember(value, "p50"));
+    ret.p90               = GetNumber(GetMember(value, "p90"));
+    ret.p99               = GetNumber(GetMember(value, "p99"));
+    ret.stutterCount      = GetNumber<uint64_t>(GetMember(value, "stutters"));
+    return ret;
+}
+
+ordered_json MemoryToJson(BenchmarkMemory const &memory)
+{
+    ordered_json ret;
+    ret["gpu_bytes"]      = memory.gpuBytes;
+    ret["gpu_peak_bytes"] = memory.gpuPeakBytes;
+    ret["cpu_bytes"]      = memory.cpuBytes;
+    ret["cpu_peak_bytes"] = memory.cpuPeakBytes;
+    ret["allocations"]    = memory.allocationCount;
+    return ret;
+}
+
+BenchmarkMemory MemoryFromJson(ordered_json const &value)
+{
+    BenchmarkMemory ret;
+    ret.gpuBytes        = GetNumber<uint64_t>(GetMember(value, "gpu_bytes"));
+    ret.gpuPeakBytes    = GetNumber<uint64_t>(GetMember(value, "gpu_peak_bytes"));
+    ret.cpuBytes        = GetNumber<uint64_t>(GetMember(value, "cpu_bytes"));
+    ret.cpuPeakBytes    = GetNumber<uint64_t>(GetMember(value, "cpu_peak_bytes"));
+    ret.allocationCount = GetNumber<uint32_t>(GetMember(value, "allocations"));
+    return ret;
+}
+} // unnamed namespace
+
+string BenchmarkConfiguration::getName() const
+{
+    string ret = scene + '_' + (environment.empty() ? "Default"s : environment) + '_'
+               + (camera.empty() ? "Default"s : camera) + '_' + renderer + '_' + optionSet + '_';
+    ret += width > 0 ? to_string(width) + 'x' + to_string(height) : "Window"s;
+    erase_if(ret, [](unsigned char const c) { return isspace(c); });
+    ranges::replace_if(
+        ret, [](char const c) { return string_view(R"(<>:"/\|?*)").find(c) != string_view::npos; }, '-');
+    return ret;
+}
+
+
+bool BenchmarkSuite::Load(filesystem::path const &filePath, BenchmarkSuite &suite, string &error) noexcept
+{
+    try
+    {
+        ifstream file(filePath);
+        if (!file.is_open())
+        {
+            error = "Failed to open file '" + filePath.string() + "'";
+            return false;
+        }
+        YAML::Node const spec = YAML::Load(file);
+        if (!spec.IsMap())
+        {
+            error = "Benchmark suite must be a YAML (or JSON) map of settings";
+            return false;
+        }
+        suite = BenchmarkSuite();
+        string outputDirectory;
+        string cameraPath;
+        if (!ReadString(spec, "output", outputDirectory, error)
+            || !ReadCount(spec, "warmup_frames", 0, suite.warmupFrames, error)
+            || !ReadCount(spec, "frames", 1, suite.frames, error)
+            || !ReadCount(spec, "repetitions", 1, suite.repetitions, error)
+            || !ReadString(spec, "camera_path", cameraPath, error)
+            || !ReadScalar(spec, "frame_budget_ms", "a number", suite.frameBudget, error)
+            || !ReadScalar(spec, "image_metrics", "a boolean", suite.imageMetrics, error))
+        {
+            return false;
+        }
+        if (!outputDirectory.empty())
+        {
+            suite.outputDirectory = outputDirectory;
+        }
+        suite.cameraPath = cameraPath;
+
+        // Read each axis of the configuration matrix
+        vector<BenchmarkConfiguration> scenes;
+        for (auto const &scene : spec["scenes"])
+        {
+            BenchmarkConfiguration configuration;
+            if (scene.IsScalar())
+            {
+                configuration.scene = scene.Scalar();
+            }
+            else if (scene.IsMap())
+            {
+                if (!ReadString(scene, "name", configuration.scene, error)
+                    || !ReadString(scene, "environment", configuration.environment, error)
+                    || !ReadString(scene, "camera", configuration.camera, error))
+                {
+                    return false;
+                }
+            }
+            if (configuration.scene.empty())
+            {
+                error = "Each entry in 'scenes' must be a scene name or a map with a 'name'";
+                return false;
+            }
+            scenes.push_back(std::move(configuration));
+        }
+        vector<string> renderers;
+        for (auto const &renderer : spec["renderers"])
+        {
+            if (!renderer.IsScalar())
+            {
+                error = "Each entry in 'renderers' must be a renderer name";
+                return false;
+            }
+            renderers.emplace_back(renderer.Scalar());
+        }
+        if (scenes.empty() || renderers.empty())
+        {
+            error = "Benchmark suite requires at least one entry in both 'scenes' and 'renderers'";
+            return false;
+        }
+        vector<pair<string, ordered_json>> optionSets;
+        for (auto const &optionSet : spec["option_sets"])
+        {
+            auto const name    = optionSet["name"];
+            auto const options = optionSet["options"];
+            if (!optionSet.IsMap() || !name || !name.IsScalar()
+                || !(!options || options.IsNull() || options.IsMap()))
+            {
+                error = "Each entry in 'option_sets' must have a 'name' and an 'options' map";
+                return false;
+            }
+            optionSets.emplace_back(name.Scalar(), options ? OptionsToJson(options) : ordered_json());
+        }
+        if (optionSets.empty())
+        {
+            optionSets.emplace_back("Default", ordered_json());
+        }
+        vector<pair<uint32_t, uint32_t>> resolutions;
+        for (auto const &resolution : spec["resolutions"])
+        {
+            uint32_t width  = 0;
+            uint32_t height = 0;
+            if (!ReadResolution(resolution, width, height))
+            {
+                error = "Each entry in 'resolutions' must be of the form \"1920x1080\"";
+                return false;
+            }
+            resolutions.emplace_back(width, height);
+        }
+        if (resolutions.empty())
+        {
+            resolutions.emplace_back(0, 0);
+        }
+
+        // Expand the full matrix, ordered so that the expensive scene changes happen least often
+        for (auto const &scene : scenes)
+        {
+            for (auto const &renderer : renderers)
+            {
+                for (auto const &[optionSetName, options] : optionSets)
+                {
+                    for (auto const &[width, height] : resolutions)
+                    {
+                        BenchmarkConfiguration configuration = scene;
+                        configuration.renderer               = renderer;
+                        configuration.optionSet              = optionSetName;
+                        configuration.options                = options;
+                        configuration.width                  = width;
+                        configuration.height                 = height;
+                        suite.configurations.push_back(std::move(configuration));
+                    }
+                }
+            }
+        }
+        return true;
+    }
+    catch (exception const &e)
+    {
+        error = filePath.string() + ": " + e.what();
+        return false;
+    }
+}
+
+bool BenchmarkResult::save(filesystem::path const &filePath) const noexcept
+{
+    try
+    {
+        ordered_json document;
+        document["format_version"] = kVersion;
+        document["version"]        = version;
+        auto &config               = document["configuration"];
+        config["scene"]            = configuration.scene;
+        config["environment"]      = configuration.environment;
+        config["camera"]           = configuration.camera;
+        config["renderer"]         = configuration.renderer;
+        config["option_set"]       = configuration.optionSet;
+        config["options"]          = configuration.options.is_object() ? configuration.options
+                                                                       : ordered_json::object();
+        config["width"]            = configuration.width;
+        config["height"]           = configuration.height;
+        document["warmup_frames"]   = warmupFrames;
+        document["frames"]          = frames;
+        document["frame_budget_ms"] = frameBudget;
+
+        auto &repetitionsJson = document["repetitions"];
+        repetitionsJson       = ordered_json::array();
+        for (auto const &repetition : repetitions)
+        {
+            ordered_json repetitionJson;
+            repetitionJson["frame_time"]  = TimingToJson(repetition.frameTime);
+            repetitionJson["over_budget"] = repetition.overBudgetFrames;
+            auto &timestamps              = repetitionJson["timestamps"];
+            timestamps                    = ordered_json::object();
+            for (auto const &[name, timing] : repetition.timestamps)
+            {
+                timestamps[name] = TimingToJson(timing);
+            }
+            auto &memory    = repetitionJson["memory"];
+            memory["total"] = MemoryToJson(repetition.memory);
+            auto &owners    = memory["owners"];
+            owners          = ordered_json::object();
+            for (auto const &[name, usage] : repetition.memoryOwners)
+            {
+                owners[name] = MemoryToJson(usage);
+            }
+            repetitionJson["frame_times"] = repetition.frameTimes;
+            repetitionsJson.push_back(std::move(repetitionJson));
+        }
+
+        auto &metrics = document["image_metrics"];
+        metrics       = ordered_json::object();
+        if (imageMetricFrames > 0)
+        {
+            metrics["frames"] = imageMetricFrames;
+            for (auto const &[name, value] : imageMetrics)
+            {
+                metrics[name] = value;
+            }
+        }
+
+        ofstream file(filePath);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file << document.dump(4) << '\n';
+        return file.good();
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool BenchmarkResult::Load(filesystem::path const &filePath, BenchmarkResult &result, string &error) noexcept
+{
+    try
+    {
+        ifstream file(filePath);
+        if (!file.is_open())
+        {
+            error = "Failed to open file '" + filePath.string() + "'";
+            return false;
+        }
+        ordered_json const document = ordered_json::parse(file);
+        if (GetNumber<uint32_t>(GetMember(document, "format_version")) != kVersion)
+        {
+            error = filePath.string() + ": Unsupported benchmark results version";
+            return false;
+        }
+        result                           = BenchmarkResult();
+        result.version                   = GetString(GetMember(document, "version"));
+        auto const &config               = GetMember(document, "configuration");
+        result.configuration.scene       = GetString(GetMember(config, "scene"));
+        result.configuration.environment = GetString(GetMember(config, "environment"));
+        result.configuration.camera      = GetString(GetMember(config, "camera"));
+        result.configuration.renderer    = GetString(GetMember(config, "renderer"));
+        result.configuration.optionSet   = GetString(GetMember(config, "option_set"));
+        result.configuration.options     = GetMember(config, "options");
+        result.configuration.width       = GetNumber<uint32_t>(GetMember(config, "width"));
+        result.configuration.height      = GetNumber<uint32_t>(GetMember(config, "height"));
+        result.warmupFrames              = GetNumber<uint32_t>(GetMember(document, "warmup_frames"));
+        result.frames                    = GetNumber<uint32_t>(GetMember(document, "frames"));
+        result.frameBudget               = GetNumber(GetMember(document, "frame_budget_ms"));
+        for (auto const &repetitionJson : GetMember(document, "repetitions"))
+        {
+            BenchmarkRepetition repetition;
+            repetition.frameTime        = TimingFromJson(GetMember(repetitionJson, "frame_time"));
+            repetition.overBudgetFrames = GetNumber<uint64_t>(GetMember(repetitionJson, "over_budget"));
+            for (auto const &[name, timing] : GetMember(repetitionJson, "timestamps").items())
+            {
+                repetition.timestamps.emplace(name, TimingFromJson(timing));
+            }
+            auto const &memory = GetMember(repetitionJson, "memory");
+            repetition.memory  = MemoryFromJson(GetMember(memory, "total"));
+            for (auto const &[name, usage] : GetMember(memory, "owners").items())
+            {
+                repetition.memoryOwners.emplace(name, MemoryFromJson(usage));
+            }
+            for (auto const &frameTime : GetMember(repetitionJson, "frame_times"))
+            {
+                repetition.frameTimes.push_back(GetNumber(frameTime));
+            }
+            result.repetitions.push_back(std::move(repetition));
+        }
+        for (auto const &[name, value] : GetMember(document, "image_metrics").items())
+        {
+            if (name == "frames")
+            {
+                result.imageMetricFrames = GetNumber<uint32_t>(value);
+            }
+            else if (value.is_number())
+            {
+                result.imageMetrics.emplace(name, value.get<double>());
+            }
+        }
+        return true;
+    }
+    catch (exception const &e)
+    {
+        error = filePath.string() + ": " + e.what();
+        return false;
+    }
+}
+
+bool BenchmarkResult::loadImageMetrics(filesystem::path const &filePath) noexcept
+{
+    try
+    {
+        vector<pair<string, vector<double>>> metrics;
+        if (!ReadImageMetrics(filePath, metrics, imageMetricFrames) || imageMetricFrames == 0)
+        {
+            return false;
+        }
+        imageMetrics.clear();
+        for (auto const &[name, values] : metrics)
+        {
+            if (!values.empty())
+            {
+                double sum = 0.0;
+                for (double const value : values)
+                {
+                    sum += value;
+                }
+                imageMetrics.emplace(name, sum / static_cast<double>(values.size()));
+            }
+        }
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool ReadImageMetrics(
+    filesystem::path const &filePath, vector<pair<string, vector<double>>> &metrics, uint32_t &frames) noexcept
+{
+    try
+    {
+        ifstream file(filePath);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        // First line contains the metric names, each subsequent line the values for a single frame
+        string line;
+        if (!getline(file, line))
+        {
+            return false;
+        }
+        metrics.clear();
+        stringstream header(line);
+        for (string name; getline(header, name, ',');)
+        {
+            metrics.emplace_back(name, vector<double>());
+        }
+        frames = 0;
+        while (getline(file, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+            stringstream values(line);
+            string       value;
+            for (size_t column = 0; column < metrics.size() && getline(values, value, ','); ++column)
+            {
+                // Skip non-finite values (e.g. PSNR of an exact match) so they do not poison the mean
+                double number = 0.0;
+                if (auto const [last, result] = from_chars(value.data(), value.data() + value.size(), number);
+                    result == errc() && isfinite(number))
+                {
+                    metrics[column].second.push_back(number);
+                }
+            }
+            ++frames;
+        }
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
@@ -0,0 +1,160 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/** A single point of a benchmark suite matrix. */
+struct BenchmarkConfiguration
+{
+    std::string            scene;       /**< Scene name from the scene_viewer scene list, or a scene file */
+    std::string            environment; /**< Environment map name, empty to use the scene default */
+    std::string            camera;      /**< Scene camera name, empty to use the scene default */
+    std::string            renderer;    /**< Renderer name */
+    std::string            optionSet;   /**< Name of the render option set */
+    nlohmann::ordered_json options; /**< Render options applied on top of the renderer defaults */
+    uint32_t               width  = 0; /**< Render width, zero to use the window resolution */
+    uint32_t               height = 0; /**< Render height, zero to use the window resolution */
+
+    /**
+     * Get a file name stem that uniquely identifies the configuration.
+     * @return The name (without spaces or characters invalid in file names).
+     */
+    [[nodiscard]] std::string getName() const;
+};
+
+/** Benchmark suite read from a specification file and expanded into individual configurations. */
+struct BenchmarkSuite
+{
+    std::filesystem::path outputDirectory = "./dump/benchmark"; /**< Directory results are written to */
+    uint32_t              warmupFrames    = 64;    /**< Frames rendered before measuring a configuration */
+    uint32_t              frames          = 512;   /**< Frames measured in each repetition */
+    uint32_t              repetitions     = 3;     /**< Measured repetitions of each configuration */
+    double                frameBudget     = 0.0;   /**< Frame time budget (ms), zero to disable */
+    bool                  imageMetrics    = false; /**< Measure image metrics against reference images */
+    std::filesystem::path cameraPath; /**< Camera path played back over each repetition (optional) */
+
+    /** Expanded configurations (scenes x renderers x option sets x resolutions) */
+    std::vector<BenchmarkConfiguration> configurations;
+
+    /**
+     * Load a benchmark suite specification.
+     * Specifications are YAML, as JSON is a subset of YAML JSON specifications are also accepted.
+     * @param      filePath Full pathname to the YAML (or JSON) specification file.
+     * @param [out] suite    The loaded suite.
+     * @param [out] error    Description of any error encountered.
+     * @return True if successful, False otherwise.
+     */
+    static bool Load(
+        std::filesystem::path const &filePath, BenchmarkSuite &suite, std::string &error) noexcept;
+};
+
+/** Summary of a timed value, matches Capsaicin::TimingStatistics. */
+struct BenchmarkTiming
+{
+    uint64_t count             = 0;
+    double   mean              = 0.0;
+    double   standardDeviation = 0.0;
+    double   minimum           = 0.0;
+    double   maximum           = 0.0;
+    double   p50               = 0.0;
+    double   p90               = 0.0;
+    double   p99               = 0.0;
+    uint64_t stutterCount      = 0;
+};
+
+/** Memory used by a set of resources, matches Capsaicin::MemoryUsage. */
+struct BenchmarkMemory
+{
+    uint64_t gpuBytes        = 0;
+    uint64_t gpuPeakBytes    = 0;
+    uint64_t cpuBytes        = 0;
+    uint64_t cpuPeakBytes    = 0;
+    uint32_t allocationCount = 0;
+};
+
+/** Measurements taken over a single repetition of a configuration. */
+struct BenchmarkRepetition
+{
+    std::vector<double>                    frameTimes;           /**< CPU frame time of every frame (ms) */
+    BenchmarkTiming                        frameTime;            /**< Frame time statistics (ms) */
+    uint64_t                               overBudgetFrames = 0; /**< Frames exceeding the frame budget */
+    std::map<std::string, BenchmarkTiming> timestamps;   /**< GPU time of each render technique (ms) */
+    BenchmarkMemory                        memory;       /**< Total memory usage (peaks over repetition) */
+    std::map<std::string, BenchmarkMemory> memoryOwners; /**< Memory usage of each owner */
+};
+
+/** Results of a single benchmark configuration. */
+struct BenchmarkResult
+{
+    static constexpr uint32_t kVersion = 1; /**< Results file format version */
+
+    std::string                      version; /**< Version of the program that produced the results */
+    BenchmarkConfiguration           configuration;
+    uint32_t                         warmupFrames = 0;
+    uint32_t                         frames       = 0;
+    double                           frameBudget  = 0.0;
+    std::vector<BenchmarkRepetition> repetitions;
+    uint32_t                         imageMetricFrames = 0; /**< Frames averaged into imageMetrics */
+    std::map<std::string, double>    imageMetrics;          /**< Mean of each image metric (MSE, SSIM...) */
+
+    /**
+     * Save the results as JSON.
+     * @param filePath Full pathname to the file to save as.
+     * @return True if successful, False otherwise.
+     */
+    [[nodiscard]] bool save(std::filesystem::path const &filePath) const noexcept;
+
+    /**
+     * Load results previously saved using save().
+     * @param      filePath Full pathname to the file to load.
+     * @param [out] result   The loaded results.
+     * @param [out] error    Description of any error encountered.
+     * @return True if successful, False otherwise.
+     */
+    static bool Load(
+        std::filesystem::path const &filePath, BenchmarkResult &result, std::string &error) noexcept;
+
+    /**
+     * Read the image metrics CSV file written by the image metrics render technique.
+     * @param filePath Full pathname to the CSV file.
+     * @return True if successful, False otherwise.
+     */
+    bool loadImageMetrics(std::filesystem::path const &filePath) noexcept;
+};
+
+/**
+ * Read the per-frame values of an image metrics CSV file written by the image metrics render technique.
+ * @param      filePath Full pathname to the CSV file.
+ * @param [out] metrics  The name and values of each metric (non-finite values are skipped).
+ * @param [out] frames   The number of frames in the file.
+ * @return True if successful, False otherwise.
+ */
+bool ReadImageMetrics(std::filesystem::path const &filePath,
+    std::vector<std::pair<std::string, std::vector<double>>> &metrics, uint32_t &frames) noexcept;
@@ -129,6 +129,17 @@ bool CapsaicinMain::run() noexcept
         return false;
     }
 
+    // Run a benchmark suite in place of the interactive frame loop
+    if (!benchmarkSuiteFile.empty())
+    {
+        bool const ret = runBenchmarkSuite();
+        if (!profileOutput.empty() && !Capsaicin::DumpProfile(profileOutput))
+        {
+            printString("Failed to save profile: "s + profileOutput.string(), MessageLevel::Warning);
+        }
+        return ret;
+    }
+
     // Render frames continuously
     while (true)
     {
@@ -178,6 +189,57 @@ bool CapsaicinMain::run() noexcept
         }
     }
 
+    if (sequenceOpen)
+    {
+        Capsaicin::CloseFrameSequence();
+        sequenceOpen = false;
+    }
+
+    if (benchmarkMode)
+    {
+        try
+        {
+            // Save frame time and GPU timestamp statistics collected over the benchmark run
+            filesystem::path savePath = getSaveName();
+            if (!benchmarkModeSuffix.empty())
+            {
+                savePath += '_';
+                savePath += benchmarkModeSuffix;
+            }
+            savePath += "_statistics"sv;
+            for (auto const &extension : {".csv"sv, ".json"sv})
+            {
+                filesystem::path statisticsFile = savePath;
+                statisticsFile += extension;
+                if (!Capsaicin::SaveFrameStatistics(statisticsFile))
+                {
+                    printString(
+                        "Failed to save frame statistics: "s + statisticsFile.string(), MessageLevel::Warning);
+                }
+            }
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+    if (!profileOutput.empty())
+    {
+        if (!Capsaicin::DumpProfile(profileOutput))
+        {
+            printString("Failed to save profile: "s + profileOutput.string(), MessageLevel::Warning);
+        }
+    }
+
+    if (!cameraPathOutput.empty())
+    {
+        if (!Capsaicin::StopCameraPathRecording(cameraPathOutput))
+        {
+            printString("Failed to save camera path: "s + cameraPathOutput.string(), MessageLevel::Warning);
+        }
+    }
+
     return true;
 }
 
@@ -363,6 +425,30 @@ bool CapsaicinMain::initialise() noexcept
         app.add_option("--benchmark-suffix", benchmarkModeSuffix, "Suffix to add to any saved filenames")
             ->needs(bench)
             ->capture_default_str();
+        vector<pair<string, SequenceFormat>> const sequenceFormatNames = {
+            {"none", SequenceFormat::None},
+            { "raw",  SequenceFormat::Raw},
+            { "y4m",  SequenceFormat::Y4M},
+        };
+        app.add_option("--benchmark-sequence", benchmarkModeSequence,
+               "Save all benchmark frames to a single frame sequence file instead of individual images")
+            ->needs(bench)
+            ->transform(CLI::CheckedTransformer(sequenceFormatNames, CLI::ignore_case))
+            ->capture_default_str();
+        auto *playCameraPath = app.add_option("--benchmark-camera-path", benchmarkCameraPath,
+                                       "Camera path to play back over the benchmark frames")
+                                   ->needs(bench)
+                                   ->check(CLI::ExistingFile);
+        auto *recordCameraPath =
+            app.add_option("--record-camera-path", cameraPathOutput,
+                   "Record the camera each frame and save the camera path to the specified file on exit")
+                ->excludes(playCameraPath);
+        app.add_option("--benchmark-suite", benchmarkSuiteFile,
+               "Run the benchmark suite described by the specified YAML (or JSON) file and save the results "
+               "of each configuration")
+            ->excludes(bench)
+            ->excludes(recordCameraPath)
+            ->check(CLI::ExistingFile);
 
         vector<string> renderOptions;
         app.add_option("--render-options", renderOptions, "Additional render options");
@@ -376,10 +462,31 @@ bool CapsaicinMain::initialise() noexcept
         app.add_flag(
             "--list-renderers", listRenderer, "List all available renderers and corresponding indexes");
         app.add_flag("--save-as-jpeg", saveAsJPEG, "Save as JPEG");
+        Capsaicin::EXRCompression exrCompression = Capsaicin::EXRCompression::PIZ;
+        vector<pair<string, Capsaicin::EXRCompression>> const exrCompressionNames = {
+            { "none",  Capsaicin::EXRCompression::None},
+            {  "zip",   Capsaicin::EXRCompression::ZIP},
+            {  "piz",   Capsaicin::EXRCompression::PIZ},
+            {"lossy", Capsaicin::EXRCompression::Lossy},
+        };
+        app.add_option("--exr-compression", exrCompression, "Compression used when saving EXR images")
+            ->transform(CLI::CheckedTransformer(exrCompressionNames, CLI::ignore_case))
+            ->capture_default_str();
+        app.add_option("--profile-output", profileOutput,
+            "Record CPU/GPU profiling events and save them as a Chrome trace to the specified file on exit");
+        uint32_t workerThreads = ~0U;
+        app.add_option("--worker-threads", workerThreads,
+            "Number of worker threads used for parallel CPU work, 0 to run it serially (default based on "
+            "hardware concurrency)");
+        bool pinThreads = false;
+        app.add_flag("--pin-threads", pinThreads, "Pin each worker thread to a separate logical processor");
 
         // Parse command line and update any requested settings
         app.parse(GetCommandLine(), true);
 
+        // Benchmark suites run without user input the same as benchmark mode
+        benchmarkMode = benchmarkMode || !benchmarkSuiteFile.empty();
+
         // Perform any help operations
         if (listScene)
         {
@@ -451,7 +558,9 @@ bool CapsaicinMain::initialise() noexcept
         }
 
         // Create Capsaicin render context
+        Capsaicin::SetWorkerThreads(workerThreads, pinThreads);
         Capsaicin::Initialize(contextGFX, ImGui::GetCurrentContext());
+        Capsaicin::SetEXRCompression(exrCompression);
 
         // Set window scaling
         Capsaicin::SetRenderDimensionsScale(renderScale);
@@ -662,6 +771,22 @@ bool CapsaicinMain::initialise() noexcept
         {
             Capsaicin::SetPaused(false);
         }
+
+        if (!profileOutput.empty())
+        {
+            Capsaicin::SetProfilingEnabled(true);
+        }
+
+        if (!cameraPathOutput.empty())
+        {
+            Capsaicin::StartCameraPathRecording();
+        }
+        else if (!benchmarkCameraPath.empty()
+                 && !Capsaicin::PlayCameraPath(benchmarkCameraPath, benchmarkModeFrameCount))
+        {
+            printString("Failed to load camera path: "s + benchmarkCameraPath.string(), MessageLevel::Error);
+            return false;
+        }
     }
     catch (const CLI::ParseError &e)
     {
@@ -1069,7 +1194,9 @@ bool CapsaicinMain::renderFrame() noexcept
     if (saveImage)
     {
         // Disable performing tone mapping as we output in HDR
-        if (!saveAsJPEG && !saveAsPNG && Capsaicin::hasOption<bool>("tonemap_enable"))
+        bool const saveAsSDR =
+            saveAsJPEG || saveAsPNG || (benchmarkMode && benchmarkModeSequence == SequenceFormat::Y4M);
+        if (!saveAsSDR && Capsaicin::hasOption<bool>("tonemap_enable"))
         {
             reenableToneMap = Capsaicin::getOption<bool>("tonemap_enable");
             Capsaicin::setOption("tonemap_enable", false);
@@ -1119,6 +1246,334 @@ bool CapsaicinMain::renderFrame() noexcept
     return true;
 }
 
+static BenchmarkTiming ToBenchmarkTiming(Capsaicin::TimingStatistics const &statistics) noexcept
+{
+    return {
+        .count             = statistics.count,
+        .mean              = statistics.mean,
+        .standardDeviation = statistics.standardDeviation,
+        .minimum           = statistics.minimum,
+        .maximum           = statistics.maximum,
+        .p50               = statistics.p50,
+        .p90               = statistics.p90,
+        .p99               = statistics.p99,
+        .stutterCount      = statistics.stutterCount,
+    };
+}
+
+static BenchmarkMemory ToBenchmarkMemory(Capsaicin::MemoryUsage const &usage) noexcept
+{
+    return {
+        .gpuBytes        = usage.gpuBytes,
+        .gpuPeakBytes    = usage.gpuPeakBytes,
+        .cpuBytes        = usage.cpuBytes,
+        .cpuPeakBytes    = usage.cpuPeakBytes,
+        .allocationCount = usage.allocationCount,
+    };
+}
+
+bool CapsaicinMain::runBenchmarkSuite() noexcept
+{
+    try
+    {
+        BenchmarkSuite suite;
+        if (string error; !BenchmarkSuite::Load(benchmarkSuiteFile, suite, error))
+        {
+            printString("Failed to load benchmark suite: "s + error, MessageLevel::Error);
+            return false;
+        }
+        error_code ec;
+        filesystem::create_directories(suite.outputDirectory, ec);
+        if (ec)
+        {
+            printString("Failed to create benchmark output directory: "s + suite.outputDirectory.string(),
+                MessageLevel::Error);
+            return false;
+        }
+
+        filesystem::path currentScene;
+        string           defaultCamera;
+        for (size_t index = 0; index < suite.configurations.size(); ++index)
+        {
+            auto const &configuration = suite.configurations[index];
+            printString("Running benchmark "s + to_string(index + 1) + '/'
+                        + to_string(suite.configurations.size()) + ": " + configuration.getName());
+
+            // Only reload the scene when it changes as loading is by far the most expensive step
+            auto const scene = ranges::find_if(
+                scenes, [&configuration](SceneData const &sd) { return sd.name == configuration.scene; });
+            filesystem::path const sceneFile =
+                scene != scenes.cend() ? scene->fileName : filesystem::path(configuration.scene);
+            if (sceneFile != currentScene)
+            {
+                if (!loadScene(sceneFile))
+                {
+                    return false;
+                }
+                currentScene  = sceneFile;
+                defaultCamera = Capsaicin::GetSceneCurrentCamera();
+            }
+            if (!runBenchmarkConfiguration(suite, configuration, defaultCamera))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    catch (exception const &e)
+    {
+        printString(e.what(), MessageLevel::Error);
+        return false;
+    }
+}
+
+bool CapsaicinMain::runBenchmarkConfiguration(BenchmarkSuite const &suite,
+    BenchmarkConfiguration const &configuration, string_view const defaultCamera) noexcept
+{
+    try
+    {
+        // The renderer must be set first as changing it resets all render options to their defaults
+        if (!setRenderer(configuration.renderer))
+        {
+            printString("Invalid benchmark renderer: "s + configuration.renderer, MessageLevel::Error);
+            return false;
+        }
+
+        // Use the same default environment map as the interactive viewer if none is specified
+        string_view environmentName = configuration.environment;
+        if (environmentName.empty())
+        {
+            auto const scene = ranges::find_if(
+                scenes, [&configuration](SceneData const &sd) { return sd.name == configuration.scene; });
+            environmentName =
+                scene == scenes.cend() || scene->useEnvironmentMap ? defaultEnvironmentMap : "None";
+        }
+        auto const environmentMap = ranges::find_if(sceneEnvironmentMaps,
+            [&environmentName](EnvironmentData const &ed) { return ed.first == environmentName; });
+        if (!setEnvironmentMap(environmentMap != sceneEnvironmentMaps.cend()
+                                   ? environmentMap->second
+                                   : filesystem::path(environmentName)))
+        {
+            return false;
+        }
+
+        string_view const camera = configuration.camera.empty() ? defaultCamera : configuration.camera;
+        if (auto const cameras = Capsaicin::GetSceneCameras();
+            ranges::find(cameras, camera) == cameras.cend())
+        {
+            printString("Invalid benchmark camera: "s + string(camera), MessageLevel::Error);
+            return false;
+        }
+        setCamera(camera);
+
+        for (auto const &[option, value] : configuration.options.items())
+        {
+            if (!setRenderOption(option, value))
+            {
+                return false;
+            }
+        }
+
+        // Render resolution is set by scaling the window resolution to match the requested height
+        auto const [windowWidth, windowHeight] = Capsaicin::GetWindowDimensions();
+        float const renderScale =
+            configuration.height > 0
+                ? static_cast<float>(configuration.height) / static_cast<float>(windowHeight)
+                : 1.0F;
+        Capsaicin::SetRenderDimensionsScale(renderScale);
+        if (configuration.width * windowHeight != configuration.height * windowWidth)
+        {
+            auto const [renderWidth, renderHeight] = Capsaicin::GetRenderDimensions();
+            printString("Benchmark resolution does not match window aspect ratio, rendering at "s
+                            + to_string(renderWidth) + 'x' + to_string(renderHeight),
+                MessageLevel::Warning);
+        }
+
+        // Restarts animations and any camera path so that every repetition renders identical frames
+        auto const restart = [&suite, this](uint32_t const frameCount) {
+            Capsaicin::RestartPlayback();
+            if (!suite.cameraPath.empty() && frameCount > 0
+                && !Capsaicin::PlayCameraPath(suite.cameraPath, frameCount))
+            {
+                printString("Failed to load camera path: "s + suite.cameraPath.string(), MessageLevel::Error);
+                return false;
+            }
+            return true;
+        };
+        auto const renderFrames = [this](uint32_t const frameCount) {
+            for (uint32_t frame = 0; frame < frameCount; ++frame)
+            {
+                if (!renderBenchmarkFrame())
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        // Warm up shader compilation, caches and any temporal accumulation
+        if (!restart(suite.warmupFrames) || !renderFrames(suite.warmupFrames))
+        {
+            return false;
+        }
+
+        BenchmarkResult result;
+        result.version       = SIG_VERSION_STR;
+        result.configuration = configuration;
+        result.warmupFrames  = suite.warmupFrames;
+        result.frames        = suite.frames;
+        result.frameBudget   = suite.frameBudget;
+        for (uint32_t repetition = 0; repetition < suite.repetitions; ++repetition)
+        {
+            if (!restart(suite.frames))
+            {
+                return false;
+            }
+            Capsaicin::ResetFrameStatistics();
+            Capsaicin::ResetMemoryPeaks();
+            auto &measurement = result.repetitions.emplace_back();
+            measurement.frameTimes.reserve(suite.frames);
+            for (uint32_t frame = 0; frame < suite.frames; ++frame)
+            {
+                if (!renderBenchmarkFrame())
+                {
+                    return false;
+                }
+                double const frameTime = Capsaicin::GetFrameTime() * 1000.0;
+                measurement.frameTimes.push_back(frameTime);
+                if (suite.frameBudget > 0.0 && frameTime > suite.frameBudget)
+                {
+                    ++measurement.overBudgetFrames;
+                }
+            }
+            measurement.frameTime = ToBenchmarkTiming(Capsaicin::GetFrameTimeStatistics());
+            for (auto const &[name, statistics] : Capsaicin::GetTimestampStatistics())
+            {
+                measurement.timestamps.emplace(name, ToBenchmarkTiming(statistics));
+            }
+            measurement.memory = ToBenchmarkMemory(Capsaicin::GetTotalMemoryUsage());
+            for (auto const &[owner, usage] : Capsaicin::GetMemoryUsage())
+            {
+                measurement.memoryOwners.emplace(owner, ToBenchmarkMemory(usage));
+            }
+        }
+
+        if (suite.imageMetrics && !Capsaicin::hasOption<bool>("image_metrics_enable"))
+        {
+            printString("Image metrics are not supported by the current renderer", MessageLevel::Warning);
+        }
+        else if (suite.imageMetrics)
+        {
+            // Image metrics are measured in a separate pass so they do not affect the timing results
+            error_code ec;
+            filesystem::create_directories("./dump", ec);
+            if (!restart(suite.frames))
+            {
+                return false;
+            }
+            Capsaicin::setOption("image_metrics_enable", true);
+            Capsaicin::setOption("image_metrics_save_to_file", true);
+            // Additional frames flush the metrics of any frames still in flight
+            if (!renderFrames(suite.frames + gfxGetBackBufferCount(contextGFX) + 1))
+            {
+                return false;
+            }
+            // Disabling image metrics forces the metrics file to be closed
+            Capsaicin::setOption("image_metrics_enable", false);
+            Capsaicin::Render();
+            filesystem::path metricsFile = "./dump/"s;
+            metricsFile += getImageMetricsName();
+            metricsFile += ".csv"sv;
+            if (!result.loadImageMetrics(metricsFile))
+            {
+                printString("No image metrics recorded (missing reference image?): "s + metricsFile.string(),
+                    MessageLevel::Warning);
+            }
+        }
+        if (!suite.cameraPath.empty())
+        {
+            Capsaicin::StopCameraPath();
+        }
+
+        auto const resultFile = suite.outputDirectory / (configuration.getName() + ".json");
+        if (!result.save(resultFile))
+        {
+            printString("Failed to save benchmark results: "s + resultFile.string(), MessageLevel::Error);
+            return false;
+        }
+        return true;
+    }
+    catch (exception const &e)
+    {
+        printString(e.what(), MessageLevel::Error);
+        return false;
+    }
+}
+
+bool CapsaicinMain::setRenderOption(string const &option, nlohmann::ordered_json const &value) noexcept
+{
+    auto const &validOpts = Capsaicin::GetOptions();
+    auto const  found     = validOpts.find(option);
+    if (found == validOpts.end())
+    {
+        printString("Invalid benchmark render option: "s + option, MessageLevel::Error);
+        return false;
+    }
+    double const number    = value.is_number() ? value.get<double>() : numeric_limits<double>::quiet_NaN();
+    bool const   isInteger = value.is_number() && floor(number) == number;
+    if (holds_alternative<bool>(found->second) && value.is_boolean())
+    {
+        Capsaicin::setOption(option, value.get<bool>());
+    }
+    else if (holds_alternative<int32_t>(found->second) && isInteger)
+    {
+        Capsaicin::setOption(option, static_cast<int32_t>(number));
+    }
+    else if (holds_alternative<uint32_t>(found->second) && isInteger && number >= 0.0)
+    {
+        Capsaicin::setOption(option, static_cast<uint32_t>(number));
+    }
+    else if (holds_alternative<float>(found->second) && value.is_number())
+    {
+        Capsaicin::setOption(option, static_cast<float>(number));
+    }
+    else if (holds_alternative<string>(found->second) && value.is_string())
+    {
+        Capsaicin::setOption(option, value.get<string>());
+    }
+    else
+    {
+        printString("Invalid value type passed for benchmark render option '" + option + "'",
+            MessageLevel::Error);
+        return false;
+    }
+    return true;
+}
+
+bool CapsaicinMain::renderBenchmarkFrame() noexcept
+{
+    // Check if window should close
+    if (gfxWindowIsCloseRequested(window) || gfxWindowIsKeyReleased(window, VK_ESCAPE))
+    {
+        printString("Benchmark suite cancelled", MessageLevel::Warning);
+        return false;
+    }
+
+    // Get events
+    gfxWindowPumpEvents(window);
+
+    // Render the scene
+    Capsaicin::Render();
+
+    // Complete the frame
+#if _DEBUG || defined(SHADER_DEBUG)
+    gfxFrame(contextGFX);
+#else
+    gfxFrame(contextGFX, false);
+#endif
+    return true;
+}
+
 bool CapsaicinMain::renderGUI() noexcept
 {
     try
@@ -1585,6 +2040,11 @@ bool CapsaicinMain::renderGUIDetails()
         {
             Capsaicin::ReloadShaders();
         }
+        ImGui::SameLine();
+        if (bool hotReload = Capsaicin::GetShaderHotReload(); ImGui::Checkbox("Auto Reload", &hotReload))
+        {
+            Capsaicin::SetShaderHotReload(hotReload);
+        }
         if (ImGui::Button("Dump Frame (F6)"))
         {
             saveImage = true;
@@ -1595,6 +2055,38 @@ bool CapsaicinMain::renderGUIDetails()
         ImGui::SameLine();
         if (!saveAsJPEG)
             ImGui::Checkbox("Save as PNG", &saveAsPNG);
+        if (!saveAsJPEG && !saveAsPNG)
+        {
+            constexpr array<char const *, 4> compressionNames = {"None", "ZIP", "PIZ", "Lossy"};
+            auto compression = static_cast<int32_t>(Capsaicin::GetEXRCompression());
+            if (ImGui::Combo("EXR Compression", &compression, compressionNames.data(),
+                    static_cast<int32_t>(compressionNames.size())))
+            {
+                Capsaicin::SetEXRCompression(static_cast<Capsaicin::EXRCompression>(compression));
+            }
+        }
+        if (bool profiling = Capsaicin::GetProfilingEnabled(); ImGui::Checkbox("Record Profile", &profiling))
+        {
+            Capsaicin::SetProfilingEnabled(profiling);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Save Profile"))
+        {
+            filesystem::path savePath = profileOutput;
+            if (savePath.empty())
+            {
+                savePath = "./dump/"s;
+                if (error_code ec; !exists(savePath, ec))
+                {
+                    create_directory(savePath, ec);
+                }
+                savePath += "profile.json"sv;
+            }
+            if (!Capsaicin::DumpProfile(savePath))
+            {
+                printString("Failed to save profile: "s + savePath.string(), MessageLevel::Warning);
+            }
+        }
     }
     return true;
 }
@@ -1617,6 +2109,31 @@ void CapsaicinMain::saveFrame() noexcept
             savePath += '_';
             savePath += benchmarkModeSuffix;
         }
+
+        auto const        view     = Capsaicin::GetCurrentDebugView();
+        string_view const dumpView = view != "None" ? view : "Color";
+        if (benchmarkMode && benchmarkModeSequence != SequenceFormat::None)
+        {
+            // Append to a single sequence file, per frame files are too costly for long benchmark runs
+            if (!sequenceOpen)
+            {
+                if (view != "None")
+                {
+                    savePath += view;
+                }
+                savePath += benchmarkModeSequence == SequenceFormat::Y4M ? ".y4m"sv : ".capseq"sv;
+                sequenceOpen = Capsaicin::OpenFrameSequence(savePath);
+                if (!sequenceOpen)
+                {
+                    printString("Failed to open frame sequence: "s + savePath.string(), MessageLevel::Error);
+                    benchmarkModeSequence = SequenceFormat::None;
+                    return;
+                }
+            }
+            Capsaicin::AppendFrameSequence(dumpView);
+            return;
+        }
+
         savePath += '_';
         uint32_t const frameIndex = Capsaicin::GetFrameIndex() + 1; //+1 to correct for 0 indexed
         savePath += to_string(frameIndex);
@@ -1627,8 +2144,6 @@ void CapsaicinMain::saveFrame() noexcept
             savePath += to_string(Capsaicin::GetAverageFrameTime());
         }
 
-        auto const        view     = Capsaicin::GetCurrentDebugView();
-        string_view const dumpView = view != "None" ? view : "Color";
         if (view != "None")
         {
             savePath += view;
@@ -1720,6 +2235,38 @@ filesystem::path CapsaicinMain::getSaveName()
     return savePath;
 }
 
+filesystem::path CapsaicinMain::getImageMetricsName()
+{
+    // Must match the naming used by the image metrics render technique
+    auto const currentScenes = Capsaicin::GetCurrentScenes();
+    GFX_ASSERT(!currentScenes.empty());
+    filesystem::path currentSceneName = currentScenes[0];
+    currentSceneName = currentSceneName.replace_extension(""); // Remove the '.gltf' extension
+    currentSceneName = currentSceneName.filename();
+    filesystem::path currentEM = Capsaicin::GetCurrentEnvironmentMap();
+    if (!currentEM.empty())
+    {
+        currentEM = currentEM.replace_extension(""); // Remove the extension
+        currentEM = currentEM.filename();
+    }
+    else
+    {
+        currentEM = "None";
+    }
+    string renderer(Capsaicin::GetCurrentRenderer());
+    if (renderer.find("Path Tracer") != string::npos)
+    {
+        // All path tracer variants share the same reference
+        renderer = "Path Tracer";
+    }
+    string fileName = currentSceneName.string() + '_' + currentEM.string() + '_';
+    fileName += Capsaicin::GetSceneCurrentCamera();
+    fileName += '_';
+    fileName += renderer;
+    erase_if(fileName, [](unsigned char const c) { return isspace(c); });
+    return fileName;
+}
+
 void CapsaicinMain::fileDropCallback(char const *filePath, uint32_t const index, void *data) noexcept
 {
     auto *thisPtr = static_cast<CapsaicinMain *>(data);
@@ -22,6 +22,8 @@ THE SOFTWARE.
 
 #pragma once
 
+#include "benchmark_suite.h"
+
 #include <array>
 #include <capsaicin.h>
 #include <cinttypes>
@@ -67,6 +69,14 @@ class CapsaicinMain
         Error,
     };
 
+    /** Frame sequence format used to save benchmark frames instead of individual images */
+    enum class SequenceFormat : uint32_t
+    {
+        None,
+        Raw, /**< Planar float16/uint8 frames (.capseq) */
+        Y4M, /**< Tone-mapped 8bit video (.y4m) */
+    };
+
     /**
      * Print a string to an output console or debugger window if one is available.
      * @note If a debugger is attached then the string will be output to the debug console, else if the
@@ -124,6 +134,38 @@ class CapsaicinMain
      */
     [[nodiscard]] bool renderFrame() noexcept;
 
+    /**
+     * Run every configuration of the benchmark suite and save the results of each.
+     * @return Boolean signalling if no error occurred.
+     */
+    [[nodiscard]] bool runBenchmarkSuite() noexcept;
+
+    /**
+     * Set up, measure and save the results of a single benchmark suite configuration.
+     * @note The scene must already be loaded.
+     * @param suite         The benchmark suite.
+     * @param configuration The configuration to run.
+     * @param defaultCamera Camera to use if the configuration does not specify one.
+     * @return Boolean signalling if no error occurred.
+     */
+    [[nodiscard]] bool runBenchmarkConfiguration(BenchmarkSuite const &suite,
+        BenchmarkConfiguration const &configuration, std::string_view defaultCamera) noexcept;
+
+    /**
+     * Set a render option from a JSON value.
+     * @param option The option name.
+     * @param value  The new value, must match the type of the option.
+     * @return Boolean signalling if no error occurred.
+     */
+    [[nodiscard]] bool setRenderOption(
+        std::string const &option, nlohmann::ordered_json const &value) noexcept;
+
+    /**
+     * Render a single frame without processing user input or displaying the GUI.
+     * @return False if the window has been closed, True otherwise.
+     */
+    [[nodiscard]] bool renderBenchmarkFrame() noexcept;
+
     /**
      * Perform operations to display the default GUI.
      * @return Boolean signaling if no error occurred.
@@ -155,6 +197,12 @@ class CapsaicinMain
      */
     [[nodiscard]] static std::filesystem::path getSaveName();
 
+    /**
+     * Get the file name used by the image metrics render technique for the current settings.
+     * @return String containing file name (without extension).
+     */
+    [[nodiscard]] static std::filesystem::path getImageMetricsName();
+
     /**
      * Callback function for getting window drag & drop events.
      * @param filePath The path of the dropped file.
@@ -198,7 +246,14 @@ class CapsaicinMain
     bool        saveAsJPEG      = false;      /**< File type selector for dump frame */
     bool        saveAsPNG  = false;
     bool        saveImage       = false;      /**< Used to buffer save image requests */
+    SequenceFormat benchmarkModeSequence = SequenceFormat::None; /**< Save benchmark frames to a sequence */
+    bool           sequenceOpen          = false; /**< Set once the benchmark frame sequence is opened */
     bool        reDisableRender = false;      /**< Use to render only a single frame at a time */
 
+    std::filesystem::path profileOutput;       /**< File to save recorded profiling events to on exit */
+    std::filesystem::path cameraPathOutput;    /**< File to save the recorded camera path to on exit */
+    std::filesystem::path benchmarkCameraPath; /**< Camera path played back during benchmark mode */
+    std::filesystem::path benchmarkSuiteFile;  /**< Benchmark suite specification to run instead */
+
     bool hasConsole = false; /**< Set if a console output terminal is attached */
 };
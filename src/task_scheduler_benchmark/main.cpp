@@ -0,0 +1,676 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_mip.h"
+#include "cpu_sort.h"
+#include "pixel_conversion.h"
+#include "task_scheduler.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#if defined(CAPSAICIN_HAS_STD_PARALLEL) && CAPSAICIN_HAS_STD_PARALLEL
+#    include <execution>
+#endif
+#if defined(CAPSAICIN_HAS_TINYEXR) && CAPSAICIN_HAS_TINYEXR
+#    include <tinyexr.h>
+#endif
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/**
+ * Integer mixing function used as a cheap per element workload.
+ * @param value The value to mix.
+ * @return The mixed value.
+ */
+uint64_t Mix(uint64_t value) noexcept
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+/**
+ * Workload with a cost that varies strongly between elements, stresses load balancing.
+ * @param value The element value.
+ * @return The result.
+ */
+double Uneven(uint64_t const value) noexcept
+{
+    uint32_t const iterations = static_cast<uint32_t>(Mix(value) % 16 == 0 ? 4096 : 16);
+    double         ret        = static_cast<double>(value);
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        ret = sqrt(ret + static_cast<double>(i));
+    }
+    return ret;
+}
+
+/** The ways each workload is executed */
+enum class Executor : uint8_t
+{
+    Serial,
+    StdParallel,
+    TaskScheduler,
+};
+
+/** Number of keys in each segment of the segmented sort workload */
+constexpr uint32_t kSegmentSize = 4096;
+
+/** A single benchmark, run once per executor */
+struct Workload
+{
+    string                                       name;
+    function<void(Executor, vector<uint64_t> &)> run;
+    vector<pair<string, double>> rates = {}; /**< Reported throughput units and their count per element */
+};
+
+/**
+ * Gets the keys sorted by the sort workloads, these are copied for each run so every run sorts the same data.
+ * @param keys   The cached keys, regenerated if their count does not match.
+ * @param values The input values.
+ */
+void GetSortKeys(vector<uint32_t> &keys, vector<uint64_t> const &values)
+{
+    if (keys.size() != values.size())
+    {
+        keys.resize(values.size());
+        ranges::transform(values, keys.begin(), [](uint64_t const value) {
+            return static_cast<uint32_t>(Mix(value));
+        });
+    }
+}
+
+/**
+ * Straightforward gamma correct box filter of a sRGBA 8bit power of two texture, used as the baseline for
+ * the CPUMip workload.
+ * @param mipChain The mip chain, the top level must contain the texture.
+ * @param size     The width and height of the top level.
+ * @param executor The executor used to process rows (StdParallel or Serial).
+ */
+void MipBaseline(vector<uint8_t> &mipChain, uint32_t size, Executor const executor)
+{
+    auto const fromSRGB = [](uint8_t const value) {
+        float const color = static_cast<float>(value) / 255.0F;
+        return color < 0.03929337067685376F ? color / 12.92F
+                                            : pow((color + 0.055010718947587F) / 1.055010718947587F, 2.4F);
+    };
+    auto const toSRGB = [](float const value) {
+        float const color = value < 0.003041282560128F
+                              ? 12.92F * value
+                              : 1.055010718947587F * pow(value, 1.0F / 2.4F) - 0.055010718947587F;
+        return static_cast<uint8_t>(clamp(color, 0.0F, 1.0F) * 255.0F + 0.5F);
+    };
+    uint8_t *source = mipChain.data();
+    for (; size > 1; size /= 2)
+    {
+        uint8_t *const destination = source + static_cast<size_t>(size) * size * 4;
+        uint32_t const outputSize  = size / 2;
+        auto const     mipRow      = [&](uint32_t const y) {
+            for (uint32_t x = 0; x < outputSize; ++x)
+            {
+                for (uint32_t channel = 0; channel < 4; ++channel)
+                {
+                    float sum = 0.0F;
+                    for (uint32_t i = 0; i < 4; ++i)
+                    {
+                        uint8_t const value =
+                            source[(static_cast<size_t>(y * 2 + i / 2) * size + x * 2 + i % 2) * 4 + channel];
+                        sum += channel < 3 ? fromSRGB(value) : static_cast<float>(value) / 255.0F;
+                    }
+                    destination[(static_cast<size_t>(y) * outputSize + x) * 4 + channel] =
+                        channel < 3 ? toSRGB(sum * 0.25F)
+                                    : static_cast<uint8_t>(sum * 0.25F * 255.0F + 0.5F);
+                }
+            }
+        };
+        if (executor == Executor::Serial)
+        {
+            for (uint32_t y = 0; y < outputSize; ++y)
+            {
+                mipRow(y);
+            }
+        }
+#if defined(CAPSAICIN_HAS_STD_PARALLEL) && CAPSAICIN_HAS_STD_PARALLEL
+        else
+        {
+            vector<uint32_t> rows(outputSize);
+            iota(rows.begin(), rows.end(), 0U);
+            for_each(execution::par, rows.cbegin(), rows.cend(), mipRow);
+        }
+#endif
+        source = destination;
+    }
+}
+
+/** Width and height of the RGBA16F image converted by the pixel conversion workload (4K UHD) */
+constexpr uint32_t kImageWidth  = 3840;
+constexpr uint32_t kImageHeight = 2160;
+
+/**
+ * Straightforward conversion of interleaved RGBA16F pixels to planar single precision, used as the baseline
+ * for the pixel conversion workload.
+ * @param pixels   The interleaved half pixels.
+ * @param planes   Output planar values, each channel is stored in a separate plane of width*height values.
+ * @param executor The executor used to process rows (StdParallel or Serial).
+ */
+void PixelConversionBaseline(vector<uint16_t> const &pixels, vector<float> &planes, Executor const executor)
+{
+    auto const halfToFloat = [](uint16_t const half) {
+        // Denormals are normalised one bit at a time, Inf/NaN keep their mantissa
+        uint32_t const sign     = static_cast<uint32_t>(half & 0x8000U) << 16;
+        uint32_t       exponent = (half >> 10) & 0x1FU;
+        uint32_t       mantissa = half & 0x3FFU;
+        if (exponent == 0x1FU)
+        {
+            return bit_cast<float>(sign | 0x7F800000U | (mantissa << 13));
+        }
+        if (exponent == 0)
+        {
+            if (mantissa == 0)
+            {
+                return bit_cast<float>(sign);
+            }
+            exponent = 1;
+            while ((mantissa & 0x400U) == 0)
+            {
+                mantissa <<= 1;
+                --exponent;
+            }
+            mantissa &= 0x3FFU;
+        }
+        return bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+    };
+    size_t const planeSize  = static_cast<size_t>(kImageWidth) * kImageHeight;
+    auto const   convertRow = [&](uint32_t const y) {
+        for (size_t pixel = static_cast<size_t>(y) * kImageWidth; pixel < (y + 1ULL) * kImageWidth; ++pixel)
+        {
+            for (uint32_t channel = 0; channel < 4; ++channel)
+            {
+                planes[channel * planeSize + pixel] = halfToFloat(pixels[pixel * 4 + channel]);
+            }
+        }
+    };
+    if (executor == Executor::Serial)
+    {
+        for (uint32_t y = 0; y < kImageHeight; ++y)
+        {
+            convertRow(y);
+        }
+    }
+#if defined(CAPSAICIN_HAS_STD_PARALLEL) && CAPSAICIN_HAS_STD_PARALLEL
+    else
+    {
+        vector<uint32_t> rows(kImageHeight);
+        iota(rows.begin(), rows.end(), 0U);
+        for_each(execution::par, rows.cbegin(), rows.cend(), convertRow);
+    }
+#endif
+}
+
+/**
+ * Times a workload over a number of repetitions.
+ * @param workload    The workload to run.
+ * @param executor    The executor to run it on.
+ * @param values      The input values.
+ * @param repetitions Number of timed repetitions (after 1 untimed warmup run).
+ * @return The median time (ms).
+ */
+double Measure(Workload const &workload, Executor const executor, vector<uint64_t> &values,
+    uint32_t const repetitions)
+{
+    workload.run(executor, values);
+    vector<double> times;
+    for (uint32_t i = 0; i < repetitions; ++i)
+    {
+        auto const start = chrono::steady_clock::now();
+        workload.run(executor, values);
+        times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    ranges::nth_element(times, times.begin() + static_cast<ptrdiff_t>(times.size() / 2));
+    return times[times.size() / 2];
+}
+
+/**
+ * Gets the size of the texture used by the mip workload.
+ * @param elementCount Number of elements processed by each workload.
+ * @return The width and height of the largest power of two texture with at most one texel per element.
+ */
+uint32_t GetMipTextureSize(size_t const elementCount) noexcept
+{
+    return bit_floor(static_cast<uint32_t>(sqrt(static_cast<double>(elementCount))));
+}
+
+vector<Workload> GetWorkloads(uint32_t const size)
+{
+    vector<Workload> ret;
+    // Reduction of a cheap per element function, equivalent to HashReduce over scene data
+    ret.push_back({"reduce", [](Executor const executor, vector<uint64_t> &values) {
+                       auto const mixSum = [](uint64_t const *begin, uint64_t const *end, uint64_t sum) {
+                           for (; begin < end; ++begin)
+                           {
+                               sum += Mix(*begin);
+                           }
+                           return sum;
+                       };
+                       volatile uint64_t result = 0;
+                       if (executor == Executor::Serial)
+                       {
+                           result = mixSum(values.data(), values.data() + values.size(), 0);
+                       }
+#if defined(CAPSAICIN_HAS_STD_PARALLEL) && CAPSAICIN_HAS_STD_PARALLEL
+                       else if (executor == Executor::StdParallel)
+                       {
+                           result = transform_reduce(execution::par, values.cbegin(), values.cend(),
+                               uint64_t {0}, plus<> {}, [](uint64_t const value) { return Mix(value); });
+                       }
+#endif
+                       else
+                       {
+                           result = TaskScheduler::Get().parallelReduce(values.data(),
+                               values.data() + values.size(), uint64_t {0}, mixSum, plus<> {});
+                       }
+                       (void)result;
+                   }});
+    // Independent in-place update of every element, memory bandwidth bound
+    ret.push_back({"for", [](Executor const executor, vector<uint64_t> &values) {
+                       auto const update = [](uint64_t &value) { value = Mix(value); };
+                       if (executor == Executor::Serial)
+                       {
+                           ranges::for_each(values, update);
+                       }
+#if defined(CAPSAICIN_HAS_STD_PARALLEL) && CAPSAICIN_HAS_STD_PARALLEL
+                       else if (executor == Executor::StdParallel)
+                       {
+                           for_each(execution::par, values.begin(), values.end(), update);
+                       }
+#endif
+                       else
+                       {
+                           TaskScheduler::Get().parallelFor(
+                               size_t {0}, values.size(), [&](size_t const index) { update(values[index]); });
+                       }
+                   }});
+    // Elements with very different costs, equivalent to per mesh/instance scene updates
+    ret.push_back({"uneven", [](Executor const executor, vector<uint64_t> &values) {
+                       size_t const   count = values.size() / 64;
+                       vector<double> results(count);
+                       auto const     update = [&](size_t const index) {
+                           results[index] = Uneven(values[index]);
+                       };
+                       if (executor == Executor::Serial)
+                       {
+                           for (size_t i = 0; i < count; ++i)
+                           {
+                               update(i);
+                           }
+                       }
+#if defined(CAPSAICIN_HAS_STD_PARALLEL) && CAPSAICIN_HAS_STD_PARALLEL
+                       else if (executor == Executor::StdParallel)
+                       {
+                           vector<size_t> indexes(count);
+                           iota(indexes.begin(), indexes.end(), size_t {0});
+                           for_each(execution::par, indexes.cbegin(), indexes.cend(), update);
+                       }
+#endif
+                       else
+                       {
+                           TaskScheduler::Get().parallelFor(size_t {0}, count, update);
+                       }
+                   }});
+    // Radix sort of random keys, equivalent to GPUSort (compared against the stable standard library sort)
+    auto const sortKeys    = make_shared<vector<uint32_t>>();
+    auto const sortScratch = make_shared<vector<uint32_t>>();
+    auto const cpuSort     = make_shared<CPUSort>();
+    ret.push_back({"sort",
+        [=](Executor const executor, vector<uint64_t> &values) {
+            GetSortKeys(*sortKeys, values);
+            vector<uint32_t> &keys = *sortScratch;
+            keys                   = *sortKeys;
+            if (executor == Executor::Serial)
+            {
+                ranges::stable_sort(keys);
+            }
+#if defined(CAPSAICIN_HAS_STD_PARALLEL) && CAPSAICIN_HAS_STD_PARALLEL
+            else if (executor == Executor::StdParallel)
+            {
+                stable_sort(execution::par, keys.begin(), keys.end());
+            }
+#endif
+            else
+            {
+                cpuSort->sort(keys.data(), static_cast<uint32_t>(keys.size()));
+            }
+        },
+        {{"keys", 1.0}}});
+    // Many small independent sorts, equivalent to GPUSort::sortSegmented
+    ret.push_back({"segsort",
+        [=](Executor const executor, vector<uint64_t> &values) {
+            GetSortKeys(*sortKeys, values);
+            vector<uint32_t> &keys = *sortScratch;
+            keys                   = *sortKeys;
+
+            size_t const segmentCount = keys.size() / kSegmentSize;
+            auto const   sortSegment  = [&](size_t const segment) {
+                auto const begin = keys.begin() + static_cast<ptrdiff_t>(segment * kSegmentSize);
+                stable_sort(begin, begin + kSegmentSize);
+            };
+            if (executor == Executor::Serial)
+            {
+                for (size_t i = 0; i < segmentCount; ++i)
+                {
+                    sortSegment(i);
+                }
+            }
+#if defined(CAPSAICIN_HAS_STD_PARALLEL) && CAPSAICIN_HAS_STD_PARALLEL
+            else if (executor == Executor::StdParallel)
+            {
+                vector<size_t> segments(segmentCount);
+                iota(segments.begin(), segments.end(), size_t {0});
+                for_each(execution::par, segments.cbegin(), segments.cend(), sortSegment);
+            }
+#endif
+            else
+            {
+                vector<uint32_t> const numKeys(segmentCount, kSegmentSize);
+                cpuSort->sortSegmented(keys.data(), numKeys);
+            }
+        },
+        {{"keys", 1.0}, {"segments", 1.0 / kSegmentSize}}});
+    // Mip chain generation of a sRGBA texture with one texel per element, equivalent to GPUMip
+    auto const mipChain = make_shared<vector<uint8_t>>();
+    ret.push_back({"mip",
+        [=](Executor const executor, vector<uint64_t> &values) {
+            uint32_t const textureSize = GetMipTextureSize(values.size());
+            size_t const   texelCount  = CPUMip::GetMipChainSize(textureSize, textureSize, 4, ~0U) / 4;
+            if (mipChain->size() != texelCount * 4)
+            {
+                mipChain->resize(texelCount * 4);
+                for (size_t i = 0; i < static_cast<size_t>(textureSize) * textureSize; ++i)
+                {
+                    auto const texel = static_cast<uint32_t>(Mix(values[i]));
+                    memcpy(mipChain->data() + i * 4, &texel, sizeof(texel));
+                }
+            }
+            if (executor == Executor::TaskScheduler)
+            {
+                CPUMip::Mip(mipChain->data(), textureSize, textureSize, CPUMip::Type::sRGBA, ~0U);
+            }
+            else
+            {
+                MipBaseline(*mipChain, textureSize, executor);
+            }
+        },
+        {{"texels", GetMipTextureSize(size) * static_cast<double>(GetMipTextureSize(size)) / size}}});
+    // Conversion of a 4K RGBA16F image to planar single precision, equivalent to dumping a HDR render target
+    auto const pixels = make_shared<vector<uint16_t>>();
+    auto const planes = make_shared<vector<float>>();
+    ret.push_back({"rgba16f",
+        [=](Executor const executor, vector<uint64_t> &values) {
+            size_t const planeSize = static_cast<size_t>(kImageWidth) * kImageHeight;
+            if (pixels->empty())
+            {
+                // Random halves so that denormals, infinities and NaNs are all included
+                pixels->resize(planeSize * 4);
+                for (size_t i = 0; i < pixels->size(); ++i)
+                {
+                    (*pixels)[i] = static_cast<uint16_t>(Mix(values[i % values.size()] + i));
+                }
+                planes->resize(planeSize * 4);
+            }
+            if (executor == Executor::TaskScheduler)
+            {
+                // Each row is split into chunks of planar halves that are then converted in place
+                TaskScheduler::Get().parallelFor(0U, kImageHeight, [&](uint32_t const y) {
+                    constexpr size_t               chunkSize = 256;
+                    array<uint16_t, chunkSize * 4> chunk;
+                    array<uint16_t *, 4> const     destinations = {chunk.data(), chunk.data() + chunkSize,
+                        chunk.data() + chunkSize * 2, chunk.data() + chunkSize * 3};
+                    size_t const                   end          = (y + 1ULL) * kImageWidth;
+                    for (size_t first = static_cast<size_t>(y) * kImageWidth; first < end; first += chunkSize)
+                    {
+                        size_t const count = min(chunkSize, end - first);
+                        SplitChannels(pixels->data() + first * 4, 4, destinations.data(), count);
+                        for (uint32_t channel = 0; channel < 4; ++channel)
+                        {
+                            ConvertHalfToFloat(
+                                destinations[channel], planes->data() + channel * planeSize + first, count);
+                        }
+                    }
+                });
+            }
+            else
+            {
+                PixelConversionBaseline(*pixels, *planes, executor);
+            }
+        },
+        {{"pixels", kImageWidth * static_cast<double>(kImageHeight) / size}}});
+    return ret;
+}
+
+#if defined(CAPSAICIN_HAS_TINYEXR) && CAPSAICIN_HAS_TINYEXR
+/**
+ * Measures encoding of a 4K RGBA float image with each EXR compression mode available to dumps.
+ * @note Each image is encoded on a single thread, dumps encode bands of scanlines on each worker thread.
+ * @param repetitions Number of timed encodes of each mode (after 1 untimed warmup encode).
+ */
+void MeasureEXRCompression(uint32_t const repetitions)
+{
+    // Smooth HDR gradients with a small amount of noise, similar to a partially converged render
+    size_t const  planeSize = static_cast<size_t>(kImageWidth) * kImageHeight;
+    vector<float> planes(planeSize * 4);
+    for (uint32_t y = 0; y < kImageHeight; ++y)
+    {
+        for (uint32_t x = 0; x < kImageWidth; ++x)
+        {
+            size_t const index     = static_cast<size_t>(y) * kImageWidth + x;
+            float const  u         = static_cast<float>(x) / kImageWidth;
+            float const  v         = static_cast<float>(y) / kImageHeight;
+            float const  intensity = exp2(8.0F * u * v - 2.0F);
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                float const noise = static_cast<float>(Mix(index * 3 + channel) & 0xFFFFU) / 65535.0F;
+                planes[channel * planeSize + index] =
+                    intensity * (0.75F + 0.25F * sin(12.0F * u + 4.0F * v + static_cast<float>(channel)))
+                    * (0.98F + 0.04F * noise);
+            }
+            planes[3 * planeSize + index] = 1.0F;
+        }
+    }
+
+    // Channels are stored in alphabetical order
+    array<EXRChannelInfo, 4>  channels {};
+    array<unsigned char *, 4> images {};
+    for (uint32_t channel = 0; channel < 4; ++channel)
+    {
+        channels[channel].name[0] = "ABGR"[channel];
+        images[channel] = reinterpret_cast<unsigned char *>(planes.data() + (3 - channel) * planeSize);
+    }
+    EXRImage image;
+    InitEXRImage(&image);
+    image.num_channels = 4;
+    image.images       = images.data();
+    image.width        = static_cast<int>(kImageWidth);
+    image.height       = static_cast<int>(kImageHeight);
+
+    struct Mode
+    {
+        char const *name;
+        int         compression;
+        int         pixelType; /**< Stored pixel type, Lossy stores floats as half */
+    };
+    array const modes = {
+        Mode {"None", TINYEXR_COMPRESSIONTYPE_NONE, TINYEXR_PIXELTYPE_FLOAT},
+        Mode {"RLE", TINYEXR_COMPRESSIONTYPE_RLE, TINYEXR_PIXELTYPE_FLOAT},
+        Mode {"ZIPS", TINYEXR_COMPRESSIONTYPE_ZIPS, TINYEXR_PIXELTYPE_FLOAT},
+        Mode {"ZIP", TINYEXR_COMPRESSIONTYPE_ZIP, TINYEXR_PIXELTYPE_FLOAT},
+        Mode {"PIZ", TINYEXR_COMPRESSIONTYPE_PIZ, TINYEXR_PIXELTYPE_FLOAT},
+        Mode {"Lossy", TINYEXR_COMPRESSIONTYPE_ZIP, TINYEXR_PIXELTYPE_HALF},
+    };
+    double const inputSize = static_cast<double>(planes.size() * sizeof(float)) / 1.0e6;
+    cout << "\nEXR compression of a " << kImageWidth << "x" << kImageHeight << " RGBA float image ("
+         << inputSize << " MB)\n\n";
+    cout << "Mode      Median (ms)   Throughput  Size (MB)   Ratio\n";
+    for (auto const &[name, compression, pixelType] : modes)
+    {
+        array<int, 4> pixelTypes;
+        array<int, 4> requestedPixelTypes;
+        pixelTypes.fill(TINYEXR_PIXELTYPE_FLOAT);
+        requestedPixelTypes.fill(pixelType);
+        EXRHeader header;
+        InitEXRHeader(&header);
+        header.compression_type      = compression;
+        header.num_channels          = 4;
+        header.channels              = channels.data();
+        header.pixel_types           = pixelTypes.data();
+        header.requested_pixel_types = requestedPixelTypes.data();
+
+        vector<double> times;
+        size_t         size = 0;
+        for (uint32_t i = 0; i <= repetitions; ++i)
+        {
+            unsigned char *memory = nullptr;
+            char const    *error  = nullptr;
+            auto const     start  = chrono::steady_clock::now();
+            size                  = SaveEXRImageToMemory(&image, &header, &memory, &error);
+            double const time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            free(memory);
+            if (size == 0)
+            {
+                cout << name << ": " << (error != nullptr ? error : "Failed to encode image") << '\n';
+                FreeEXRErrorMessage(error);
+                break;
+            }
+            if (i > 0)
+            {
+                times.push_back(time);
+            }
+        }
+        if (size == 0)
+        {
+            continue;
+        }
+        ranges::nth_element(times, times.begin() + static_cast<ptrdiff_t>(times.size() / 2));
+        double const     time       = times[times.size() / 2];
+        double const     outputSize = static_cast<double>(size) / 1.0e6;
+        array<char, 128> line {};
+        snprintf(line.data(), line.size(), "%-9s %11.3f  %6.1f MB/s  %9.2f  %5.2fx\n", name, time,
+            time > 0.0 ? inputSize * 1000.0 / time : 0.0, outputSize, inputSize / outputSize);
+        cout << line.data();
+    }
+}
+#endif
+} // unnamed namespace
+
+int main(int argc, char **argv)
+{
+    CLI::App app {"Capsaicin - Task Scheduler Benchmark"};
+
+    uint32_t size = 1U << 22;
+    app.add_option("--size", size, "Number of elements processed by each workload")
+        ->check(CLI::Range(64U, 1U << 30))
+        ->capture_default_str();
+    uint32_t repetitions = 16;
+    app.add_option("--repetitions", repetitions, "Number of timed runs of each workload (median is reported)")
+        ->check(CLI::Range(1U, 10000U))
+        ->capture_default_str();
+    uint32_t workerThreads = ~0U;
+    app.add_option("--worker-threads", workerThreads,
+        "Number of task scheduler worker threads (default based on hardware concurrency)");
+    bool pinThreads = false;
+    app.add_flag("--pin-threads", pinThreads, "Pin each worker thread to a separate logical processor");
+#if defined(CAPSAICIN_HAS_TINYEXR) && CAPSAICIN_HAS_TINYEXR
+    bool exrCompression = false;
+    app.add_flag("--exr-compression", exrCompression,
+        "Also measure encoding speed and size of a 4K image with each EXR compression mode");
+#endif
+
+    CLI11_PARSE(app, argc, argv);
+
+    TaskScheduler::Get().setWorkerCount(workerThreads, pinThreads);
+    vector<uint64_t> values(size);
+    iota(values.begin(), values.end(), uint64_t {0});
+
+    vector<pair<Executor, string>> executors = {
+        {       Executor::Serial,            "serial"},
+#if defined(CAPSAICIN_HAS_STD_PARALLEL) && CAPSAICIN_HAS_STD_PARALLEL
+        {  Executor::StdParallel, "std::execution::par"},
+#endif
+        {Executor::TaskScheduler,      "TaskScheduler"},
+    };
+    cout << "Elements: " << size << ", repetitions: " << repetitions
+         << ", worker threads: " << TaskScheduler::Get().getWorkerCount() << (pinThreads ? " (pinned)" : "")
+         << "\n\n";
+    cout << "Workload  Executor              Median (ms)  Speedup  Throughput\n";
+    for (auto const &workload : GetWorkloads(size))
+    {
+        double serialTime = 0.0;
+        for (auto const &[executor, name] : executors)
+        {
+            double const time = Measure(workload, executor, values, repetitions);
+            if (executor == Executor::Serial)
+            {
+                serialTime = time;
+            }
+            array<char, 128> line {};
+            snprintf(line.data(), line.size(), "%-9s %-21s %11.3f  %6.2fx", workload.name.c_str(),
+                name.c_str(), time, time > 0.0 ? serialTime / time : 0.0);
+            cout << line.data();
+            for (auto const &[unit, perElement] : workload.rates)
+            {
+                // Reported in thousands or millions of items per second depending on magnitude
+                double const rate    = time > 0.0 ? perElement * size * 1000.0 / time : 0.0;
+                bool const   million = rate >= 1.0e6;
+                snprintf(line.data(), line.size(), "  %.2f %c%s/s", rate / (million ? 1.0e6 : 1.0e3),
+                    million ? 'M' : 'K', unit.c_str());
+                cout << line.data();
+            }
+            cout << '\n';
+        }
+    }
+#if defined(CAPSAICIN_HAS_TINYEXR) && CAPSAICIN_HAS_TINYEXR
+    if (exrCompression)
+    {
+        MeasureEXRCompression(repetitions);
+    }
+#endif
+    TaskScheduler::Get().shutdown();
+    return 0;
+}
@@ -0,0 +1,170 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "async_writer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/**
+ * Poll a condition until it becomes true.
+ * @param condition The condition to check.
+ * @return True if the condition became true before timing out, False otherwise.
+ */
+template<typename Condition>
+bool WaitFor(Condition const &condition)
+{
+    auto const timeout = chrono::steady_clock::now() + chrono::seconds(10);
+    while (!condition())
+    {
+        if (chrono::steady_clock::now() > timeout)
+        {
+            return false;
+        }
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    return true;
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *name) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s\n", name);
+        }
+    };
+
+    // Push blocks while the queue is full and resumes once a worker takes the next task
+    {
+        AsyncWriter         writer(1, 2);
+        promise<void>       gate;
+        shared_future<void> gateFuture = gate.get_future().share();
+        atomic_bool         started    = false;
+        mutex               orderLock;
+        vector<uint32_t>    order;
+        auto                record = [&](uint32_t const index) {
+            return [&, index] {
+                scoped_lock const scopedLock(orderLock);
+                order.push_back(index);
+            };
+        };
+        auto blocked = writer.push([&] {
+            started = true;
+            gateFuture.wait();
+        });
+        check(WaitFor([&] { return started.load(); }), "first task started");
+        check(writer.getPendingCount() == 1, "pending count of executing task");
+        writer.push(record(1));
+        writer.push(record(2));
+        check(writer.getPendingCount() == 3, "pending count of queued tasks");
+        atomic_bool pushed = false;
+        thread      producer([&] {
+            writer.push(record(3));
+            pushed = true;
+        });
+        this_thread::sleep_for(chrono::milliseconds(100));
+        check(!pushed, "push blocks while queue is full");
+        check(writer.getPendingCount() == 3, "queue bounded while full");
+        gate.set_value();
+        check(WaitFor([&] { return pushed.load(); }), "push resumes once queue has space");
+        producer.join();
+        writer.flush();
+        check(blocked.wait_for(chrono::seconds(0)) == future_status::ready, "future ready after flush");
+        check(writer.getPendingCount() == 0, "nothing pending after flush");
+        check(order == vector<uint32_t> {1, 2, 3}, "tasks executed in order");
+    }
+
+    // Flush waits for queued and executing tasks on every worker
+    {
+        AsyncWriter        writer(4, 4);
+        atomic_uint32_t    completed = 0;
+        constexpr uint32_t taskCount = 64;
+        for (uint32_t i = 0; i < taskCount; ++i)
+        {
+            writer.push([&] {
+                this_thread::sleep_for(chrono::milliseconds(1));
+                ++completed;
+            });
+        }
+        writer.flush();
+        check(completed == taskCount, "flush waits for all tasks");
+        check(writer.getPendingCount() == 0, "nothing pending after multi-threaded flush");
+        writer.flush();
+        check(completed == taskCount, "flush with nothing pending");
+    }
+
+    // Exceptions are returned through the future and do not stop the worker
+    {
+        AsyncWriter writer(1);
+        auto        failed = writer.push([] { throw runtime_error("task failed"); });
+        bool        caught = false;
+        try
+        {
+            failed.get();
+        }
+        catch (runtime_error const &)
+        {
+            caught = true;
+        }
+        check(caught, "exception stored in future");
+        atomic_bool ran = false;
+        writer.push([&] { ran = true; }).wait();
+        check(ran, "worker continues after exception");
+    }
+
+    // Destruction drains every queued task before the workers exit
+    {
+        atomic_uint32_t    completed = 0;
+        constexpr uint32_t taskCount = 32;
+        {
+            AsyncWriter writer(2, 64);
+            for (uint32_t i = 0; i < taskCount; ++i)
+            {
+                writer.push([&] {
+                    this_thread::sleep_for(chrono::milliseconds(2));
+                    ++completed;
+                });
+            }
+        }
+        check(completed == taskCount, "destructor drains queued tasks");
+    }
+
+    printf("%u of %u AsyncWriter tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
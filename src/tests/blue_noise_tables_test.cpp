@@ -0,0 +1,238 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "blue_noise_tables.h"
+#include "mapped_file.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+mt19937 randomGenerator(11); /**< Fixed seed so that failures are reproducible */
+
+/**
+ * Creates valid tables filled with random values.
+ * The ranking tile holds long runs of repeated values so that it is run-length encoded when compressing.
+ * @param sampleCount    Number of samples in the sequence.
+ * @param dimensionCount Number of dimensions in the sequence.
+ * @param tileSize       Width and height of the tiles.
+ * @return The tables.
+ */
+BlueNoiseTables CreateTables(
+    uint32_t const sampleCount, uint32_t const dimensionCount, uint32_t const tileSize)
+{
+    BlueNoiseTables ret;
+    ret.sampleCount        = sampleCount;
+    ret.dimensionCount     = dimensionCount;
+    ret.tileSize           = tileSize;
+    ret.tileDimensionCount = 8;
+    uniform_int_distribution<uint32_t> distribution(0, sampleCount - 1);
+    ret.sobol.resize(static_cast<size_t>(sampleCount) * dimensionCount);
+    for (auto &value : ret.sobol)
+    {
+        value = distribution(randomGenerator);
+    }
+    ret.rankingTile.resize(static_cast<size_t>(tileSize) * tileSize * ret.tileDimensionCount);
+    for (size_t i = 0; i < ret.rankingTile.size(); ++i)
+    {
+        ret.rankingTile[i] = static_cast<uint32_t>(i / 300) % sampleCount;
+    }
+    ret.scramblingTile.resize(ret.rankingTile.size());
+    for (auto &value : ret.scramblingTile)
+    {
+        value = distribution(randomGenerator);
+    }
+    return ret;
+}
+
+/**
+ * Checks whether two sets of tables hold the same values.
+ * @param tables The loaded tables.
+ * @param other  The saved tables.
+ * @return True if equal, False otherwise.
+ */
+bool Equal(BlueNoiseTables const &tables, BlueNoiseTables const &other)
+{
+    return tables.sampleCount == other.sampleCount && tables.dimensionCount == other.dimensionCount
+        && tables.tileSize == other.tileSize && tables.tileDimensionCount == other.tileDimensionCount
+        && tables.sobol == other.sobol && tables.rankingTile == other.rankingTile
+        && tables.scramblingTile == other.scramblingTile;
+}
+
+/**
+ * Reads an entire file.
+ * @param file Full path to the file.
+ * @return The file contents.
+ */
+vector<char> ReadFile(filesystem::path const &file)
+{
+    ifstream     stream(file, ios::binary);
+    vector<char> ret(filesystem::file_size(file));
+    stream.read(ret.data(), static_cast<streamsize>(ret.size()));
+    return ret;
+}
+
+/**
+ * Create (or replace) a file.
+ * @param file     Full path to the file.
+ * @param contents The file contents.
+ * @param size     Number of bytes of the contents to write.
+ */
+void WriteFile(filesystem::path const &file, vector<char> const &contents, size_t const size)
+{
+    ofstream stream(file, ios::binary | ios::trunc);
+    stream.write(contents.data(), static_cast<streamsize>(size));
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *name) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s\n", name);
+        }
+    };
+
+    // Temporary directory, removed again at the end
+    auto const root = filesystem::temp_directory_path()
+                    / ("capsaicin_blue_noise_tables_test_" + to_string(random_device()()));
+    filesystem::remove_all(root);
+    filesystem::create_directories(root);
+    auto const file      = root / "tables.bin";
+    auto const corrupted = root / "corrupted.bin";
+
+    // Mapping reflects the file contents and is released on close or when another file is opened
+    {
+        vector<char> const contents = {'c', 'a', 'p', 's'};
+        WriteFile(file, contents, contents.size());
+        MappedFile mapped;
+        check(mapped.getData().empty(), "unopened mapping is empty");
+        check(mapped.open(file) && mapped.getData().size() == contents.size()
+                  && memcmp(mapped.getData().data(), contents.data(), contents.size()) == 0,
+            "mapped contents");
+        check(!mapped.open(root / "missing.bin") && mapped.getData().empty(), "missing file");
+        WriteFile(corrupted, contents, 0);
+        check(!mapped.open(corrupted) && mapped.getData().empty(), "empty file");
+        check(mapped.open(file), "reopen");
+        mapped.close();
+        check(mapped.getData().empty(), "closed mapping is empty");
+    }
+
+    // Round trips using each value size, both with and without run-length encoding
+    for (uint32_t const sampleCount : {256U, 65536U, 131072U})
+    {
+        BlueNoiseTables const tables = CreateTables(sampleCount, 4, 16);
+        for (bool const compress : {false, true})
+        {
+            BlueNoiseTables loaded;
+            string const    name = to_string(sampleCount) + (compress ? " compressed" : "") + " round trip";
+            check(tables.save(file, compress) && loaded.load(file) && Equal(loaded, tables), name.c_str());
+            BlueNoiseTables header;
+            check(header.loadHeader(file) && header.sampleCount == sampleCount && header.tileSize == 16
+                      && header.sobol.empty(),
+                (name + " header").c_str());
+        }
+    }
+    {
+        BlueNoiseTables const tables = CreateTables(256, 4, 16);
+        check(tables.save(file, false), "save raw");
+        auto const rawSize = filesystem::file_size(file);
+        check(tables.save(file, true) && filesystem::file_size(file) < rawSize,
+            "run-length encoding is smaller");
+    }
+
+    // Every truncation of a valid file is rejected, only files holding the full header have a valid header
+    BlueNoiseTables const tables = CreateTables(256, 2, 8);
+    check(tables.save(file, true), "save");
+    vector<char> const contents = ReadFile(file);
+    bool               rejected = true;
+    bool               headers  = true;
+    for (size_t size = 0; size < contents.size(); ++size)
+    {
+        WriteFile(corrupted, contents, size);
+        BlueNoiseTables loaded;
+        rejected = rejected && !loaded.load(corrupted);
+        headers  = headers && BlueNoiseTables().loadHeader(corrupted) == (size >= 6 * sizeof(uint32_t));
+    }
+    check(rejected, "truncated files");
+    check(headers, "truncated headers");
+
+    // Corrupted headers and tables are rejected
+    auto const corrupt = [&](size_t const offset, uint32_t const value) {
+        vector<char> modified = contents;
+        memcpy(modified.data() + offset, &value, sizeof(value));
+        WriteFile(corrupted, modified, modified.size());
+        BlueNoiseTables loaded;
+        return !loaded.load(corrupted);
+    };
+    // File header of 6 values followed by the sobol table header of encoding, value size, count and size,
+    // the raw 8bit sobol values and then the ranking tile runs of 256, 44 and 212 values
+    constexpr size_t kSobolHeader = 6 * sizeof(uint32_t);
+    constexpr size_t kRankingRuns = kSobolHeader + 16 + 256 * 2 + 16;
+    check(corrupt(0, 0x12345678), "bad magic");
+    check(corrupt(4, BlueNoiseTables::kVersion + 1), "bad version");
+    check(corrupt(8, 100), "sample count not a power of 2");
+    check(corrupt(20, 0), "no tile dimensions");
+    check(corrupt(kSobolHeader, 7), "unknown encoding");
+    check(corrupt(kSobolHeader + 4, 3), "bad value size");
+    check(corrupt(kSobolHeader + 8, 511), "wrong value count");
+    check(corrupt(kSobolHeader + 12, 0xFFFFFFF0), "encoded size past end of file");
+    check(corrupt(kRankingRuns + 4, 0xFFFFFFFF), "run past end of table");
+    {
+        // Raw 8bit sobol values can only be out of range if the sample count is reduced
+        BlueNoiseTables const small = CreateTables(128, 2, 8);
+        check(small.save(file, false), "save small");
+        vector<char> modified = ReadFile(file);
+        modified[kSobolHeader + 16] = static_cast<char>(200);
+        WriteFile(corrupted, modified, modified.size());
+        check(!BlueNoiseTables().load(corrupted), "value out of range");
+    }
+
+    // Invalid tables are not saved
+    BlueNoiseTables invalid = tables;
+    invalid.sobol.pop_back();
+    check(!invalid.isValid() && !invalid.save(file, true), "save missing values");
+    invalid = tables;
+    invalid.scramblingTile[0] = invalid.sampleCount;
+    check(!invalid.isValid() && !invalid.save(file, true), "save value out of range");
+    check(!BlueNoiseTables().load(root / "missing.bin"), "load missing file");
+
+    filesystem::remove_all(root);
+
+    printf("%u of %u BlueNoiseTables tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,264 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_environment_map.h"
+#include "cpu_mip.h"
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+using Vector = CPUEnvironmentMap::Vector;
+
+mt19937 randomGenerator(13); /**< Fixed seed so that failures are reproducible */
+
+/**
+ * Creates an environment map from an analytic radiance function.
+ * @param width    Width of the equirectangular image.
+ * @param height   Height of the equirectangular image.
+ * @param radiance Function returning the radiance in a given direction.
+ * @return The environment map.
+ */
+CPUEnvironmentMap CreateAnalytic(
+    uint32_t const width, uint32_t const height, function<Vector(Vector const &)> const &radiance)
+{
+    vector<float> values(static_cast<size_t>(width) * height * 3);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            Vector const value = radiance(CPUEnvironmentMap::GetSourceDirection(
+                (static_cast<float>(x) + 0.5F) / static_cast<float>(width),
+                (static_cast<float>(y) + 0.5F) / static_cast<float>(height)));
+            ranges::copy(value, &values[(static_cast<size_t>(y) * width + x) * 3]);
+        }
+    }
+    CPUEnvironmentMap ret;
+    static_cast<void>(ret.initialise(width, height, 3, values));
+    return ret;
+}
+
+Vector RandomDirection()
+{
+    uniform_real_distribution<float> uniform(0.0F, 1.0F);
+    float const                      z   = 2.0F * uniform(randomGenerator) - 1.0F;
+    float const                      phi = 2.0F * numbers::pi_v<float> * uniform(randomGenerator);
+    float const                      r   = sqrt(max(1.0F - z * z, 0.0F));
+    return {r * cos(phi), r * sin(phi), z};
+}
+
+float Dot(Vector const &a, Vector const &b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/**
+ * Gets the maximum relative error of every texel of a cube map against an analytic function.
+ * @param cubeMap  The cube map.
+ * @param size     Size of each face of the cube map.
+ * @param mipCount Number of mip levels to test.
+ * @param expected Function returning the expected value of each channel in a direction.
+ * @return The maximum relative error.
+ */
+double GetCubeMapError(vector<float> const &cubeMap, uint32_t const size, uint32_t const mipCount,
+    function<float(Vector const &)> const &expected)
+{
+    double   ret    = 0.0;
+    uint64_t offset = 0;
+    for (uint32_t mip = 0; mip < mipCount; ++mip)
+    {
+        uint32_t const levelSize = max(size >> mip, 1U);
+        for (uint32_t face = 0; face < 6; ++face)
+        {
+            for (uint32_t y = 0; y < levelSize; ++y)
+            {
+                for (uint32_t x = 0; x < levelSize; ++x, offset += 4)
+                {
+                    Vector const direction = CPUEnvironmentMap::GetCubeMapDirection(face,
+                        (static_cast<float>(x) + 0.5F) / static_cast<float>(levelSize),
+                        (static_cast<float>(y) + 0.5F) / static_cast<float>(levelSize));
+                    double const value = expected(direction);
+                    ret = max(ret, abs(cubeMap[offset] - value) / max(abs(value), 1.0e-3));
+                }
+            }
+        }
+    }
+    return ret;
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *name) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s\n", name);
+        }
+    };
+    TaskScheduler::Get().setWorkerCount(3, false);
+
+    // Cube map sizes follow the render resolution without exceeding the source resolution
+    check(CPUEnvironmentMap::GetCubeMapSize(1920, 1080, 0, 0) == 2048
+              && CPUEnvironmentMap::GetCubeMapSize(1280, 720, 0, 0) == 1024,
+        "cube map size");
+    check(CPUEnvironmentMap::GetCubeMapSize(1920, 1080, 2048, 1024) == 1024
+              && CPUEnvironmentMap::GetCubeMapSize(1080, 1920, 2048, 1024) == 512,
+        "cube map size limited by source");
+    check(CPUEnvironmentMap::GetCubeMapKey(1, 1920, 1080).getHash()
+                  == CPUEnvironmentMap::GetCubeMapKey(1, 1900, 1080).getHash()
+              && CPUEnvironmentMap::GetCubeMapKey(1, 1920, 1080).getHash()
+                     != CPUEnvironmentMap::GetCubeMapKey(1, 1080, 1920).getHash()
+              && CPUEnvironmentMap::GetCubeMapKey(1, 1920, 1080).getHash()
+                     != CPUEnvironmentMap::GetCubeMapKey(2, 1920, 1080).getHash(),
+        "cube map key");
+    check(CPUEnvironmentMap::GetCubeMapDescription(64, 7).getSize()
+              == CPUMip::GetMipChainSize(64, 64, 4, 7) * 6 * sizeof(uint16_t),
+        "cube map description");
+
+    // Cube map directions are normalised and lie on the major axis of their face
+    bool onFace = true;
+    for (uint32_t face = 0; face < 6; ++face)
+    {
+        Vector const direction = CPUEnvironmentMap::GetCubeMapDirection(face, 0.3F, 0.8F);
+        float const  major     = direction[face / 2] * (face % 2 == 0 ? 1.0F : -1.0F);
+        onFace = onFace && abs(Dot(direction, direction) - 1.0F) < 1.0e-5F && major >= abs(direction[0])
+              && major >= abs(direction[1]) && major >= abs(direction[2]);
+    }
+    check(onFace, "cube map directions");
+
+    // Constant radiance, every level of the cube map has the same value
+    {
+        auto const environmentMap =
+            CreateAnalytic(512, 256, [](Vector const &) { return Vector {1.0F, 1.0F, 1.0F}; });
+        uint32_t const size     = 64;
+        uint32_t const mipCount = CPUMip::GetMipCount(size, size);
+        vector<float>  cubeMap;
+        check(environmentMap.generateCubeMap(size, mipCount, cubeMap)
+                  && cubeMap.size() == CPUMip::GetMipChainSize(size, size, 4, mipCount) * 6,
+            "constant cube map size");
+        check(GetCubeMapError(cubeMap, size, mipCount, [](Vector const &) { return 1.0F; }) < 1.0e-4,
+            "constant cube map");
+    }
+
+    // Linear radiance, tests the orientation of the source image, cube map faces and sampling
+    {
+        Vector const axis     = {1.0F / sqrt(14.0F), 2.0F / sqrt(14.0F), 3.0F / sqrt(14.0F)};
+        auto const   radiance = [&axis](Vector const &direction) {
+            float const value = 1.0F + 0.5F * Dot(direction, axis);
+            return Vector {value, value, value};
+        };
+        auto const     environmentMap = CreateAnalytic(1024, 512, radiance);
+        uint32_t const size           = 128;
+        vector<float>  cubeMap;
+        static_cast<void>(environmentMap.generateCubeMap(size, 1, cubeMap));
+        auto const channel = [&radiance](Vector const &direction) { return radiance(direction)[0]; };
+        check(GetCubeMapError(cubeMap, size, 1, channel) < 1.0e-2, "linear cube map");
+
+        double sourceError  = 0.0;
+        double samplesError = 0.0;
+        for (uint32_t i = 0; i < 4096; ++i)
+        {
+            Vector const direction = RandomDirection();
+            float const  expected  = radiance(direction)[0];
+            float const  source    = environmentMap.evaluate(direction)[0];
+            float const  value     = CPUEnvironmentMap::SampleCubeMap(cubeMap, size, 1, direction, 0.0F)[0];
+            sourceError            = max(sourceError, static_cast<double>(abs(source - expected) / expected));
+            samplesError           = max(samplesError, static_cast<double>(abs(value - expected) / expected));
+        }
+        check(sourceError < 1.0e-2, "linear source evaluation");
+        check(samplesError < 1.0e-2, "linear cube map sampling");
+    }
+
+    // Mips are the average of the level above, sampling between levels blends them
+    {
+        Vector const axis     = {0.0F, 1.0F, 0.0F};
+        auto const   radiance = [&axis](Vector const &direction) {
+            float const value = max(Dot(direction, axis), 0.0F);
+            return Vector {value, 0.5F * value, 0.0F};
+        };
+        auto const     environmentMap = CreateAnalytic(256, 128, radiance);
+        uint32_t const size           = 16;
+        uint32_t const mipCount       = CPUMip::GetMipCount(size, size);
+        vector<float>  cubeMap;
+        static_cast<void>(environmentMap.generateCubeMap(size, mipCount, cubeMap));
+        float    faceAverage = 0.0F;
+        uint32_t faceOffset  = 2 * size * size * 4;
+        for (uint32_t texel = 0; texel < size * size; ++texel)
+        {
+            faceAverage += cubeMap[faceOffset + texel * 4];
+        }
+        faceAverage /= static_cast<float>(size * size);
+        size_t const lastLevel = CPUMip::GetMipChainSize(size, size, 4, mipCount - 1) * 6;
+        check(abs(cubeMap[lastLevel + 2 * 4] - faceAverage) < 1.0e-5F && cubeMap[lastLevel + 3 * 4] == 0.0F,
+            "cube map mips");
+        Vector const up      = {0.0F, 1.0F, 0.0F};
+        float const  level0  = CPUEnvironmentMap::SampleCubeMap(cubeMap, size, mipCount, up, 0.0F)[0];
+        float const  level4  = CPUEnvironmentMap::SampleCubeMap(cubeMap, size, mipCount, up, 4.0F)[0];
+        float const  blended = CPUEnvironmentMap::SampleCubeMap(cubeMap, size, mipCount, up, 3.5F)[0];
+        float const  level3  = CPUEnvironmentMap::SampleCubeMap(cubeMap, size, mipCount, up, 3.0F)[0];
+        check(level0 > level4 && abs(blended - 0.5F * (level3 + level4)) < 1.0e-5F
+                  && CPUEnvironmentMap::SampleCubeMap(cubeMap, size, mipCount, up, 10.0F)[0] == level4,
+            "cube map sampling levels");
+        Vector const color = CPUEnvironmentMap::SampleCubeMap(cubeMap, size, mipCount, up, 0.0F);
+        check(abs(color[1] - 0.5F * level0) < 1.0e-5F && color[2] == 0.0F, "cube map channels");
+    }
+
+    // Single channel sources are grey, non-finite values are removed and invalid input is rejected
+    {
+        CPUEnvironmentMap environmentMap;
+        vector<float>     grey(8 * 4, 0.25F);
+        grey[5] = numeric_limits<float>::infinity();
+        check(environmentMap.initialise(8, 4, 1, grey) && environmentMap.getWidth() == 8
+                  && environmentMap.getHeight() == 4,
+            "initialise single channel");
+        vector<float> cubeMap;
+        check(environmentMap.generateCubeMap(2, 1, cubeMap)
+                  && ranges::all_of(cubeMap, [](float const value) { return isfinite(value); }),
+            "non-finite values removed");
+        // The removed value is in the first row, the last row is evaluated straight up
+        Vector const value = environmentMap.evaluate({0.0F, 1.0F, 0.0F});
+        check(value[0] == 0.25F && value[1] == 0.25F && value[2] == 0.25F, "single channel is grey");
+        check(!environmentMap.initialise(8, 4, 5, grey) && !environmentMap.isValid(), "too many channels");
+        check(!environmentMap.initialise(8, 5, 1, grey), "too few values");
+        check(!environmentMap.generateCubeMap(16, 1, cubeMap), "generate without source");
+    }
+    TaskScheduler::Get().shutdown();
+
+    printf("%u of %u CPUEnvironmentMap tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,244 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "cpu_image_metrics.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+using Type      = CPUImageMetrics::Type;
+using Operation = CPUImageMetrics::Operation;
+
+/** PSNR offset of 8bit values, 20log10(255) */
+constexpr double kPSNR8Bit = 48.13080361;
+
+/**
+ * Calculates a single metric.
+ * @param source       The source image.
+ * @param reference    The reference image.
+ * @param width        The width of both images.
+ * @param channelCount Number of channels in each pixel.
+ * @param type         The type of data in the images.
+ * @param operation    The metric to calculate.
+ * @return The metric value, NaN on failure.
+ */
+double Metric(vector<float> const &source, vector<float> const &reference, uint32_t const width,
+    uint32_t const channelCount, Type const type, Operation const operation)
+{
+    double     value  = numeric_limits<double>::quiet_NaN();
+    auto const height = static_cast<uint32_t>(source.size() / (static_cast<size_t>(width) * channelCount));
+    bool const valid  = CPUImageMetrics::Compare(
+        source.data(), reference.data(), width, height, channelCount, type, operation, value);
+    return valid ? value : numeric_limits<double>::quiet_NaN();
+}
+
+/**
+ * Checks whether a value is within a relative tolerance of an expected value.
+ * @param value    The value.
+ * @param expected The expected value.
+ * @return True if close, False otherwise.
+ */
+bool Near(double const value, double const expected)
+{
+    return abs(value - expected) <= 1.0e-6 * max(abs(expected), 1.0);
+}
+
+/**
+ * Equivalent of the PQ (SMPTE ST 2084) EOTF applied to HDR values before comparison.
+ * @param value The linear value.
+ * @return The perceptual value.
+ */
+double PQ(float const value)
+{
+    float const powM1 = pow(value, 0.1593017578125F);
+    return pow((0.8359375F + 18.8515625F * powM1) / (1.0F + 18.6875F * powM1), 78.84375F);
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *name) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s\n", name);
+        }
+    };
+
+    // Constant gamma corrected images are compared directly, every error metric is then known exactly
+    vector<float> const half(256, 0.5F);
+    vector<float> const threeQuarters(256, 0.75F);
+    auto const          constant = [&](Operation const operation) {
+        return Metric(half, threeQuarters, 16, 1, Type::SDR_NONLINEAR, operation);
+    };
+    check(Near(constant(Operation::MSE), 0.0625), "MSE");
+    check(Near(constant(Operation::RMSE), 0.25), "RMSE");
+    check(Near(constant(Operation::PSNR), kPSNR8Bit - 10.0 * log10(0.0625)), "PSNR");
+    check(Near(constant(Operation::RMAE), 1.0 / 3.0), "RMAE");
+    check(Near(constant(Operation::SMAPE), 40.0), "SMAPE");
+
+    // Identical images have no error and perfect structural similarity, including at the clamped edges
+    mt19937                          random(7);
+    uniform_real_distribution<float> distribution(0.0F, 1.0F);
+    vector<float>                    noise(13 * 11 * 4);
+    for (auto &value : noise)
+    {
+        value = distribution(random);
+    }
+    auto const rgba = [&](vector<float> const &source, vector<float> const &reference,
+                          Operation const operation) {
+        return Metric(source, reference, 13, 4, Type::SDR_SRGB, operation);
+    };
+    check(rgba(noise, noise, Operation::MSE) == 0.0, "MSE of identical images");
+    check(isinf(rgba(noise, noise, Operation::PSNR)), "PSNR of identical images");
+    check(rgba(noise, noise, Operation::RMAE) == 0.0, "RMAE of identical images");
+    check(rgba(noise, noise, Operation::SMAPE) == 0.0, "SMAPE of identical images");
+    check(Near(rgba(noise, noise, Operation::SSIM), 1.0), "SSIM of identical images");
+
+    // SSIM of a single pixel only uses the centre window weight
+    {
+        double const weight     = 0.07076223776 / (1.0 - 0.0353944717);
+        double const meanSource = 0.5 * 0.07076223776;
+        double const meanRef    = 0.75 * 0.07076223776;
+        double const varSource  = (0.5 - meanSource) * (0.5 - meanSource) * weight;
+        double const varRef     = (0.75 - meanRef) * (0.75 - meanRef) * weight;
+        double const covariance = (0.5 - meanSource) * (0.75 - meanRef) * weight;
+        double const c1         = 0.0001;
+        double const c2         = 0.0009;
+        double const luminance =
+            (2.0 * meanSource * meanRef + c1) / (meanSource * meanSource + meanRef * meanRef + c1);
+        double const structure = (2.0 * covariance + c2) / (varSource + varRef + c2);
+        double const expected  = luminance * structure;
+        double const ssim = Metric({0.5F}, {0.75F}, 1, 1, Type::SDR_NONLINEAR, Operation::SSIM);
+        check(abs(ssim - expected) < 1.0e-5, "SSIM of single pixel");
+    }
+    vector<float> noisy    = noise;
+    vector<float> inverted = noise;
+    for (size_t i = 0; i < noise.size(); ++i)
+    {
+        noisy[i]    = clamp(noise[i] + 0.05F * (distribution(random) - 0.5F), 0.0F, 1.0F);
+        inverted[i] = 1.0F - noise[i];
+    }
+    double const noisySSIM    = rgba(noise, noisy, Operation::SSIM);
+    double const invertedSSIM = rgba(noise, inverted, Operation::SSIM);
+    check(noisySSIM < 1.0 && noisySSIM > 0.5 && invertedSSIM < noisySSIM, "SSIM ordering");
+    check(Near(rgba(inverted, noise, Operation::SSIM), invertedSSIM), "SSIM symmetry");
+
+    // Linear SDR values are gamma corrected and RGB values are compared using luma
+    vector<float> const black(48, 0.0F);
+    vector<float> const white(48, 1.0F);
+    vector<float>       red(48, 0.0F);
+    for (size_t i = 0; i < red.size(); i += 3)
+    {
+        red[i] = 1.0F;
+    }
+    vector<float> const zero(16, 0.0F);
+    check(Near(Metric(black, white, 4, 3, Type::SDR_RGB, Operation::MSE), 1.0), "SDR_RGB luma of white");
+    check(Near(Metric(black, white, 4, 3, Type::SDR_SRGB, Operation::PSNR), kPSNR8Bit), "SDR_SRGB PSNR");
+    check(Near(Metric(black, red, 4, 3, Type::SDR_RGB, Operation::RMSE), 0.2126), "SDR_RGB luma weights");
+    check(Near(Metric(zero, vector<float>(16, 0.0031308F), 4, 1, Type::SDR, Operation::RMSE),
+              12.92 * 0.0031308F),
+        "SDR linear segment");
+    check(Near(Metric(zero, vector<float>(16, 0.25F), 4, 1, Type::SDR, Operation::RMSE),
+              1.055 * pow(0.25, 1.0 / 2.4) - 0.055),
+        "SDR gamma segment");
+
+    // HDR values are compared after the PQ transfer function
+    double const pqError = PQ(0.1F) - PQ(0.0F);
+    check(Near(Metric(zero, vector<float>(16, 0.1F), 4, 1, Type::HDR, Operation::RMSE), pqError), "HDR PQ");
+    check(Near(Metric(zero, vector<float>(16, 0.1F), 4, 1, Type::HDR, Operation::PSNR),
+              -10.0 * log10(pqError * pqError)),
+        "HDR PSNR");
+    check(Near(Metric(vector<float>(48, 0.2F), vector<float>(48, 0.4F), 4, 3, Type::HDR_RGB, Operation::MSE),
+              Metric(vector<float>(16, 0.2F), vector<float>(16, 0.4F), 4, 1, Type::HDR, Operation::MSE)),
+        "HDR_RGB grey matches HDR");
+
+    // Zero references contribute nothing to the relative metrics
+    check(Metric(half, vector<float>(256, 0.0F), 16, 1, Type::SDR_NONLINEAR, Operation::RMAE) == 0.0,
+        "RMAE of zero reference");
+    check(Metric(zero, zero, 4, 1, Type::SDR_NONLINEAR, Operation::SMAPE) == 0.0, "SMAPE of zero images");
+
+    // Sums over sizes that are not a multiple of the vector width match a direct calculation
+    uint32_t const oddWidth = 37;
+    vector<float>  source(oddWidth * 19);
+    vector<float>  reference(source.size());
+    double         squared  = 0.0;
+    double         relative = 0.0;
+    double         percent  = 0.0;
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        source[i]         = distribution(random);
+        reference[i]      = distribution(random) + 0.01F;
+        float const error = reference[i] - source[i];
+        squared += static_cast<double>(error * error);
+        relative += static_cast<double>(abs(error) / reference[i]);
+        percent += static_cast<double>(abs(error) / ((abs(reference[i]) + abs(source[i])) * 0.5F));
+    }
+    auto const odd = [&](Operation const operation) {
+        return Metric(source, reference, oddWidth, 1, Type::SDR_NONLINEAR, operation);
+    };
+    auto const count = static_cast<double>(source.size());
+    check(Near(odd(Operation::MSE), squared / count), "MSE of odd sized image");
+    check(Near(odd(Operation::RMAE), relative / count), "RMAE of odd sized image");
+    check(Near(odd(Operation::SMAPE), 100.0 * percent / count), "SMAPE of odd sized image");
+
+    // Requesting several metrics at once gives the same results as requesting each separately
+    array const operations = {Operation::SSIM, Operation::MSE, Operation::PSNR, Operation::RMAE,
+        Operation::SMAPE, Operation::RMSE};
+    array<double, operations.size()> values {};
+    bool same = CPUImageMetrics::Compare(source.data(), reference.data(), oddWidth, 19, 1,
+        Type::SDR_NONLINEAR, operations, values.data());
+    for (size_t i = 0; i < operations.size(); ++i)
+    {
+        same = same && values[i] == odd(operations[i]);
+    }
+    check(same, "multiple operations");
+
+    // Invalid parameters
+    double     value   = 0.0;
+    auto const compare = [&](float const *image, uint32_t const width, uint32_t const channelCount,
+                             Type const type) {
+        return CPUImageMetrics::Compare(
+            image, half.data(), width, 4, channelCount, type, Operation::MSE, value);
+    };
+    check(!compare(half.data(), 4, 0, Type::SDR), "zero channels");
+    check(!compare(half.data(), 4, 5, Type::SDR), "too many channels");
+    check(!compare(half.data(), 4, 2, Type::HDR_RGB), "too few RGB channels");
+    check(!compare(nullptr, 4, 1, Type::SDR), "missing image");
+    check(!compare(half.data(), 0, 1, Type::SDR), "empty image");
+
+    printf("%u of %u CPUImageMetrics tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
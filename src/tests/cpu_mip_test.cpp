@@ -0,0 +1,296 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_mip.h"
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+using Type = CPUMip::Type;
+
+mt19937 randomGenerator(5); /**< Fixed seed so that failures are reproducible */
+
+char const *const kTypeNames[] = {"R", "RG", "RGB", "RGBA", "sRGB", "sRGBA", "DepthMin", "DepthMax"};
+
+/** Equivalent of convertFromSRGB in math/color.hlsl */
+double ConvertFromSRGB(double const value)
+{
+    return value < 0.03929337067685376 ? value / 12.92
+                                       : pow((value + 0.055010718947587) / 1.055010718947587, 2.4);
+}
+
+/** Equivalent of convertToSRGB in math/color.hlsl */
+double ConvertToSRGB(double const value)
+{
+    return value < 0.003041282560128 ? 12.92 * value
+                                     : 1.055010718947587 * pow(value, 1.0 / 2.4) - 0.055010718947587;
+}
+
+/**
+ * Gets the weight of a source texel for an output texel along a single axis.
+ * Each output texel covers an equal fraction of the source so the weight is the overlap of the source texel
+ * with that fraction, this matches the 2 and 3 texel windows used for even and odd sizes.
+ * @param input      The source texel coordinate.
+ * @param output     The output texel coordinate.
+ * @param inputSize  The source dimension.
+ * @param outputSize The output dimension.
+ * @return The weight, zero if the source texel does not contribute.
+ */
+double Weight(
+    uint32_t const input, uint32_t const output, uint32_t const inputSize, uint32_t const outputSize)
+{
+    double const scale = static_cast<double>(inputSize) / static_cast<double>(outputSize);
+    double const start = max(static_cast<double>(output) * scale, static_cast<double>(input));
+    double const end   = min(static_cast<double>(output + 1) * scale, static_cast<double>(input + 1));
+    return max(end - start, 0.0) / scale;
+}
+
+/**
+ * Generates the next level of a mip chain using a direct 2D evaluation of the filter.
+ * @param source The previous level, as stored in the texture.
+ * @param width  The width of the previous level.
+ * @param height The height of the previous level.
+ * @param type   The texture data type.
+ * @return The next level, as stored in the texture.
+ */
+vector<double> ReferenceLevel(vector<double> const &source, uint32_t const width, uint32_t const height,
+    Type const type)
+{
+    uint32_t const channelCount = CPUMip::GetChannelCount(type);
+    bool const     srgb         = type == Type::sRGB || type == Type::sRGBA;
+    uint32_t const outputWidth  = max(width / 2, 1U);
+    uint32_t const outputHeight = max(height / 2, 1U);
+    vector<double> ret(static_cast<size_t>(outputWidth) * outputHeight * channelCount);
+    for (uint32_t y = 0; y < outputHeight; ++y)
+    {
+        for (uint32_t x = 0; x < outputWidth; ++x)
+        {
+            for (uint32_t channel = 0; channel < channelCount; ++channel)
+            {
+                // Only the 3x3 texels starting at twice the output coordinate can overlap the output texel
+                bool const linearise = srgb && channel < 3;
+                double     value     = type == Type::DepthMin ? INFINITY
+                                     : type == Type::DepthMax ? -INFINITY
+                                                              : 0.0;
+                for (uint32_t j = y * 2; j < min(y * 2 + 3, height); ++j)
+                {
+                    for (uint32_t i = x * 2; i < min(x * 2 + 3, width); ++i)
+                    {
+                        double const weight =
+                            Weight(i, x, width, outputWidth) * Weight(j, y, height, outputHeight);
+                        if (weight == 0.0)
+                        {
+                            continue;
+                        }
+                        double const sample =
+                            source[(static_cast<size_t>(j) * width + i) * channelCount + channel];
+                        if (type == Type::DepthMin)
+                        {
+                            value = min(value, sample);
+                        }
+                        else if (type == Type::DepthMax)
+                        {
+                            value = max(value, sample);
+                        }
+                        else
+                        {
+                            value += weight * (linearise ? ConvertFromSRGB(sample) : sample);
+                        }
+                    }
+                }
+                ret[(static_cast<size_t>(y) * outputWidth + x) * channelCount + channel] =
+                    linearise ? ConvertToSRGB(value) : value;
+            }
+        }
+    }
+    return ret;
+}
+
+/**
+ * Mips a random float texture and compares every level against the reference.
+ * Each reference level is generated from the previously generated level so that errors do not accumulate.
+ * @param width  The width of the top level.
+ * @param height The height of the top level.
+ * @param type   The texture data type.
+ * @return True if every level matches, False otherwise.
+ */
+bool TestMip(uint32_t width, uint32_t height, Type const type)
+{
+    uint32_t const                   channelCount = CPUMip::GetChannelCount(type);
+    uint32_t const                   mipCount     = CPUMip::GetMipCount(width, height);
+    size_t                           offset       = static_cast<size_t>(width) * height * channelCount;
+    vector<float>                    mipChain(CPUMip::GetMipChainSize(width, height, channelCount, ~0U));
+    uniform_real_distribution<float> distribution(0.0F, 1.0F);
+    generate_n(mipChain.begin(), offset, [&] { return distribution(randomGenerator); });
+    if (!CPUMip::Mip(mipChain.data(), width, height, type, ~0U))
+    {
+        return false;
+    }
+    vector<double> level(mipChain.begin(), mipChain.begin() + static_cast<ptrdiff_t>(offset));
+    for (uint32_t mip = 1; mip < mipCount; ++mip)
+    {
+        level  = ReferenceLevel(level, width, height, type);
+        width  = max(width / 2, 1U);
+        height = max(height / 2, 1U);
+        for (size_t i = 0; i < level.size(); ++i)
+        {
+            if (abs(static_cast<double>(mipChain[offset + i]) - level[i]) > 2.0e-5)
+            {
+                return false;
+            }
+            level[i] = static_cast<double>(mipChain[offset + i]);
+        }
+        offset += level.size();
+    }
+    return offset == mipChain.size();
+}
+
+/**
+ * Mips a random 8bit texture and compares every level against the rounded reference.
+ * Values may differ by 1 where the float reference lies on a rounding boundary.
+ * @param width  The width of the top level.
+ * @param height The height of the top level.
+ * @param type   The texture data type.
+ * @return True if every level matches, False otherwise.
+ */
+bool TestMipUnorm(uint32_t width, uint32_t height, Type const type)
+{
+    uint32_t const                    channelCount = CPUMip::GetChannelCount(type);
+    uint32_t const                    mipCount     = CPUMip::GetMipCount(width, height);
+    size_t                            offset       = static_cast<size_t>(width) * height * channelCount;
+    vector<uint8_t>                   mipChain(CPUMip::GetMipChainSize(width, height, channelCount, ~0U));
+    uniform_int_distribution<uint32_t> distribution(0, 255);
+    generate_n(
+        mipChain.begin(), offset, [&] { return static_cast<uint8_t>(distribution(randomGenerator)); });
+    if (!CPUMip::Mip(mipChain.data(), width, height, type, ~0U))
+    {
+        return false;
+    }
+    vector<double> level(offset);
+    for (size_t i = 0; i < offset; ++i)
+    {
+        level[i] = static_cast<double>(mipChain[i]) / 255.0;
+    }
+    for (uint32_t mip = 1; mip < mipCount; ++mip)
+    {
+        level  = ReferenceLevel(level, width, height, type);
+        width  = max(width / 2, 1U);
+        height = max(height / 2, 1U);
+        for (size_t i = 0; i < level.size(); ++i)
+        {
+            double const expected = floor(clamp(level[i], 0.0, 1.0) * 255.0 + 0.5);
+            if (abs(static_cast<double>(mipChain[offset + i]) - expected) > 1.0)
+            {
+                return false;
+            }
+            level[i] = static_cast<double>(mipChain[offset + i]) / 255.0;
+        }
+        offset += level.size();
+    }
+    return offset == mipChain.size();
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *name) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s\n", name);
+        }
+    };
+
+    // Level counts and chain sizes of power of 2 and NPOT textures
+    check(CPUMip::GetMipCount(1, 1) == 1 && CPUMip::GetMipCount(16, 16) == 5, "mip count of power of 2");
+    check(CPUMip::GetMipCount(37, 19) == 6 && CPUMip::GetMipCount(1, 1023) == 10, "mip count of NPOT");
+    check(CPUMip::GetMipChainSize(5, 3, 1, ~0U) == 15 + 2 + 1, "chain size of NPOT");
+    check(CPUMip::GetMipChainSize(8, 2, 4, 2) == (16 + 4) * 4, "chain size of partial chain");
+    check(CPUMip::GetChannelCount(Type::sRGB) == 3 && CPUMip::GetChannelCount(Type::DepthMax) == 1,
+        "channel count");
+
+    // Every type against the reference, sizes cover odd, even and unit dimensions as well as levels large
+    // enough to be split across tasks
+    TaskScheduler::Get().setWorkerCount(3, false);
+    for (uint32_t type = 0; type <= static_cast<uint32_t>(Type::DepthMax); ++type)
+    {
+        for (auto const &[width, height] : {pair {16U, 16U}, pair {37U, 19U}, pair {64U, 33U}, pair {7U, 1U},
+                 pair {1U, 9U}, pair {513U, 300U}})
+        {
+            ++tests;
+            if (!TestMip(width, height, static_cast<Type>(type)))
+            {
+                ++failures;
+                printf("FAILED: %s mip of %ux%u\n", kTypeNames[type], width, height);
+            }
+            if (type > static_cast<uint32_t>(Type::sRGBA))
+            {
+                continue;
+            }
+            ++tests;
+            if (!TestMipUnorm(width, height, static_cast<Type>(type)))
+            {
+                ++failures;
+                printf("FAILED: %s 8bit mip of %ux%u\n", kTypeNames[type], width, height);
+            }
+        }
+    }
+
+    // sRGB colour channels are averaged as linear values while alpha is averaged directly
+    vector<float> srgba = {0.0F, 0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 1.0F, 1.0F, 0.0F, 0.0F, 0.0F, 0.0F};
+    check(CPUMip::Mip(srgba.data(), 2, 1, Type::sRGBA, ~0U), "sRGBA mip");
+    check(abs(srgba[8] - 0.735354F) < 1.0e-5F && srgba[8] == srgba[10], "sRGB average of black and white");
+    check(srgba[11] == 0.5F, "alpha average of sRGBA");
+    vector<uint8_t> srgb8 = {0, 0, 0, 255, 255, 255, 0, 0, 0};
+    check(CPUMip::Mip(srgb8.data(), 2, 1, Type::sRGB, ~0U) && srgb8[6] == 188 && srgb8[8] == 188,
+        "8bit sRGB average of black and white");
+
+    // Only the requested levels are written
+    vector<float> partial(CPUMip::GetMipChainSize(8, 8, 1, ~0U), -1.0F);
+    fill_n(partial.begin(), 64, 1.0F);
+    check(CPUMip::Mip(partial.data(), 8, 8, Type::R, 2) && partial[64 + 15] == 1.0F && partial[80] == -1.0F,
+        "partial chain");
+
+    // Invalid parameters
+    float texel = 0.0F;
+    check(!CPUMip::Mip(static_cast<float *>(nullptr), 4, 4, Type::R, ~0U), "missing texture");
+    check(!CPUMip::Mip(&texel, 0, 1, Type::R, ~0U), "empty texture");
+    uint8_t depth = 0;
+    check(!CPUMip::Mip(&depth, 1, 1, Type::DepthMin, ~0U), "8bit depth");
+    TaskScheduler::Get().shutdown();
+
+    printf("%u of %u CPUMip tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
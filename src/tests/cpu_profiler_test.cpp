@@ -0,0 +1,152 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_profiler.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+constexpr string_view kEventName = "event";
+
+/**
+ * Check that a list of copied events is a contiguous run recorded by RecordEvents.
+ * @param events The copied events.
+ * @param first  Expected index of the first event, ~0 to accept any start.
+ * @param count  Expected number of events, ~0 to accept any count.
+ * @return True if the events are valid, False otherwise.
+ */
+bool CheckEvents(vector<CPUProfiler::Event> const &events, uint64_t const first, uint64_t const count)
+{
+    if ((count != ~0ULL && events.size() != count)
+        || (first != ~0ULL && !events.empty() && events.front().start != first))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        auto const &event = events[i];
+        auto const  track = event.start % 2 == 0 ? CPUProfiler::Track::CPU : CPUProfiler::Track::GPU;
+        if (event.name != kEventName || event.duration != 1
+            || event.frame != static_cast<uint32_t>(event.start) || event.track != track
+            || (i > 0 && event.start != events[i - 1].start + 1))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Record events whose values are all derived from their index.
+ * @param first The index of the first event.
+ * @param count The number of events to record.
+ */
+void RecordEvents(uint64_t const first, uint64_t const count)
+{
+    auto &profiler = CPUProfiler::Get();
+    for (uint64_t i = first; i < first + count; ++i)
+    {
+        profiler.setFrameIndex(static_cast<uint32_t>(i));
+        profiler.addEvent(
+            kEventName, i, i + 1, i % 2 == 0 ? CPUProfiler::Track::CPU : CPUProfiler::Track::GPU);
+    }
+}
+
+/**
+ * Gets the events recorded by the calling thread (which must have the given name).
+ * @param threadName The name of the thread.
+ * @return The events.
+ */
+vector<CPUProfiler::Event> GetThreadEvents(string_view const &threadName)
+{
+    for (auto &[threadIndex, name, events] : CPUProfiler::Get().getEvents())
+    {
+        if (name == threadName)
+        {
+            return events;
+        }
+    }
+    return {};
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *name) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s\n", name);
+        }
+    };
+
+    auto &profiler = CPUProfiler::Get();
+    profiler.setThreadName("main");
+    constexpr uint64_t bufferSize = CPUProfiler::kThreadBufferSize;
+
+    RecordEvents(0, 100);
+    check(CheckEvents(GetThreadEvents("main"), 0, 100), "partially filled buffer");
+
+    // Once the ring buffer wraps only the most recent events are kept
+    RecordEvents(100, bufferSize);
+    check(CheckEvents(GetThreadEvents("main"), 100, bufferSize), "wrapped buffer");
+
+    profiler.reset();
+    check(GetThreadEvents("main").empty(), "reset");
+    RecordEvents(0, 10);
+    check(CheckEvents(GetThreadEvents("main"), 0, 10), "record after reset");
+    profiler.reset();
+
+    // Copies taken while another thread keeps recording (and wrapping its buffer) must only ever contain
+    // complete events as a contiguous run
+    atomic<bool> finished = false;
+    thread       writer([&finished] {
+        CPUProfiler::Get().setThreadName("writer");
+        RecordEvents(0, 64 * bufferSize);
+        finished.store(true);
+    });
+    uint32_t copies      = 0;
+    bool     copiesValid = true;
+    while (!finished.load())
+    {
+        copiesValid = copiesValid && CheckEvents(GetThreadEvents("writer"), ~0ULL, ~0ULL);
+        ++copies;
+    }
+    writer.join();
+    check(copiesValid, "copies during recording");
+    check(CheckEvents(GetThreadEvents("writer"), 63 * bufferSize, bufferSize), "events after recording");
+
+    printf("%u of %u CPUProfiler tests passed (%u concurrent copies)\n", tests - failures, tests, copies);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,236 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_reduce.h"
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+mt19937 randomGenerator(3); /**< Fixed seed so that failures are reproducible */
+
+char const *const kTypeNames[] = {"Float", "Float2", "Float3", "Float4", "UInt", "UInt2", "UInt3", "UInt4",
+    "Int", "Int2", "Int3", "Int4", "Double", "Double2", "Double3", "Double4"};
+char const *const kOperationNames[] = {"Sum", "Min", "Max", "Product"};
+
+/**
+ * Generate a random key component.
+ * Products use values close to 1 (or odd integers) so that the result neither overflows nor becomes 0.
+ * @param operation The operation the value is used with.
+ * @return The value.
+ */
+template<typename T>
+T RandomValue(CPUReduce::Operation const operation)
+{
+    uint32_t const random = static_cast<uint32_t>(randomGenerator());
+    if constexpr (is_floating_point_v<T>)
+    {
+        if (operation == CPUReduce::Operation::Product)
+        {
+            return static_cast<T>(1.0 + (static_cast<double>(random % 2001) - 1000.0) * 1e-7);
+        }
+        return static_cast<T>(static_cast<double>(random % 100000) * 0.01 - 500.0);
+    }
+    else if constexpr (is_signed_v<T>)
+    {
+        if (operation == CPUReduce::Operation::Product)
+        {
+            return static_cast<T>((random % 4) * 2 + 1) * (random & 8 ? -1 : 1);
+        }
+        return static_cast<T>(random);
+    }
+    else
+    {
+        return operation == CPUReduce::Operation::Product ? (random % 4) * 2 + 1 : random;
+    }
+}
+
+/**
+ * Reduce random keys using CPUReduce and compare the result against a serial reduction.
+ * Integer results must match exactly (with wrapping on overflow), floating point sums and products must be
+ * within the rounding error expected for the blocked reduction order.
+ * @param type      The key type.
+ * @param operation The operation to perform.
+ * @param numKeys   Number of keys to reduce.
+ * @return True if the results match, False otherwise.
+ */
+template<typename T>
+bool TestReduce(CPUReduce::Type const type, CPUReduce::Operation const operation, uint32_t const numKeys)
+{
+    uint32_t const components = static_cast<uint32_t>(type) % 4 + 1;
+    vector<T>      keys(static_cast<size_t>(numKeys) * components);
+    ranges::generate(keys, [operation] { return RandomValue<T>(operation); });
+
+    // Serial reduction, floating point values are accumulated with higher precision and integers wrap on
+    // overflow as they do on the GPU
+    using Reference =
+        typename conditional_t<is_floating_point_v<T>, type_identity<long double>, make_unsigned<T>>::type;
+    vector<Reference> reference(components);
+    vector<Reference> magnitude(components);
+    for (uint32_t key = 0; key < numKeys; ++key)
+    {
+        for (uint32_t component = 0; component < components; ++component)
+        {
+            size_t const index  = static_cast<size_t>(key) * components + component;
+            auto const   value  = static_cast<Reference>(keys[index]);
+            auto        &result = reference[component];
+            if (key == 0)
+            {
+                result = value;
+            }
+            else if (operation == CPUReduce::Operation::Sum)
+            {
+                result += value;
+            }
+            else if (operation == CPUReduce::Operation::Product)
+            {
+                result *= value;
+            }
+            else
+            {
+                // Compare in the key type so that signed integers are ordered correctly
+                bool const less = static_cast<T>(value) < static_cast<T>(result);
+                result          = (operation == CPUReduce::Operation::Min) == less ? value : result;
+            }
+            if constexpr (is_floating_point_v<T>)
+            {
+                magnitude[component] += fabs(value);
+            }
+        }
+    }
+
+    vector<T> result(components);
+    if (!CPUReduce::Reduce(keys.data(), numKeys, type, operation, result.data()))
+    {
+        return false;
+    }
+    for (uint32_t component = 0; component < components; ++component)
+    {
+        if constexpr (is_floating_point_v<T>)
+        {
+            // Min and max must be exact. Sum errors are bounded by the number of additions along each keys
+            // path through the reduction, where each level combines up to kGroupSize + kKeysPerThread values
+            // serially. Every multiply contributes to the relative error of a product
+            long double const expected = reference[component];
+            long double const epsilon  = numeric_limits<T>::epsilon();
+            long double       bound    = 0.0L;
+            if (operation == CPUReduce::Operation::Sum)
+            {
+                uint32_t levels = 1;
+                for (uint32_t count = numKeys; count > CPUReduce::kKeysPerGroup;
+                     count /= CPUReduce::kKeysPerGroup)
+                {
+                    ++levels;
+                }
+                bound = magnitude[component] * epsilon * levels
+                      * (CPUReduce::kGroupSize + CPUReduce::kKeysPerThread);
+            }
+            else if (operation == CPUReduce::Operation::Product)
+            {
+                bound = fabs(expected) * epsilon * numKeys;
+            }
+            // Allow for the rounding of the reference itself where long double is no larger than double
+            bound += magnitude[component] * numeric_limits<long double>::epsilon() * numKeys;
+            if (fabs(static_cast<long double>(result[component]) - expected) > bound)
+            {
+                return false;
+            }
+        }
+        else if (result[component] != static_cast<T>(reference[component]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestReduce(CPUReduce::Type const type, CPUReduce::Operation const operation, uint32_t const numKeys)
+{
+    if (type >= CPUReduce::Type::Double)
+    {
+        return TestReduce<double>(type, operation, numKeys);
+    }
+    if (type >= CPUReduce::Type::Int)
+    {
+        return TestReduce<int32_t>(type, operation, numKeys);
+    }
+    if (type >= CPUReduce::Type::UInt)
+    {
+        return TestReduce<uint32_t>(type, operation, numKeys);
+    }
+    return TestReduce<float>(type, operation, numKeys);
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    for (uint32_t const workers : {0U, 3U, ~0U})
+    {
+        TaskScheduler::Get().setWorkerCount(workers, false);
+        for (uint32_t type = 0; type <= static_cast<uint32_t>(CPUReduce::Type::Double4); ++type)
+        {
+            for (uint32_t operation = 0; operation <= static_cast<uint32_t>(CPUReduce::Operation::Product);
+                 ++operation)
+            {
+                // Sizes covering single keys, partial and full blocks and multiple reduction passes
+                for (uint32_t const numKeys : {1U, 7U, CPUReduce::kKeysPerGroup, CPUReduce::kKeysPerGroup + 1,
+                         CPUReduce::kKeysPerGroup * 4 + 3, 50000U})
+                {
+                    ++tests;
+                    if (!TestReduce(static_cast<CPUReduce::Type>(type),
+                            static_cast<CPUReduce::Operation>(operation), numKeys))
+                    {
+                        ++failures;
+                        printf("FAILED: %s %s of %u keys, workers %u\n", kTypeNames[type],
+                            kOperationNames[operation], numKeys, workers);
+                    }
+                }
+            }
+        }
+    }
+
+    // Reducing nothing must fail
+    ++tests;
+    if (float result = 0.0F; CPUReduce::Reduce(&result, 0, CPUReduce::Type::Float, CPUReduce::Operation::Sum,
+                                 &result))
+    {
+        ++failures;
+        printf("FAILED: Reduce of 0 keys succeeded\n");
+    }
+    TaskScheduler::Get().shutdown();
+
+    printf("%u of %u CPUReduce tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
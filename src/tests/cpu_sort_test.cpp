@@ -0,0 +1,165 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_sort.h"
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+mt19937 randomGenerator(7); /**< Fixed seed so that failures are reproducible */
+
+/**
+ * Sort a set of segments using CPUSort and compare the result against std::stable_sort.
+ * @param segments   The number of keys in each segment.
+ * @param stride     Stride between segments, 0 for tightly packed segments.
+ * @param descending True to sort descending, False for ascending.
+ * @param keyMask    Mask applied to each random key, small masks generate many equal keys.
+ * @param usePayload True to sort a payload along with the keys.
+ * @return True if the results match, False otherwise.
+ */
+bool TestSort(vector<uint32_t> const &segments, uint32_t const stride, bool const descending,
+    uint32_t const keyMask, bool const usePayload)
+{
+    size_t const totalKeys =
+        stride > 0 ? segments.size() * stride : accumulate(segments.cbegin(), segments.cend(), size_t {0});
+    vector<uint32_t> keys(totalKeys);
+    vector<uint32_t> payload(totalKeys);
+    for (size_t i = 0; i < totalKeys; ++i)
+    {
+        keys[i]    = static_cast<uint32_t>(randomGenerator()) & keyMask;
+        payload[i] = static_cast<uint32_t>(i);
+    }
+
+    // Reference stable sort of each segment, keys beyond a strided segments key count must be untouched
+    vector<uint32_t> referenceKeys    = keys;
+    vector<uint32_t> referencePayload = payload;
+    size_t           offset           = 0;
+    for (uint32_t const count : segments)
+    {
+        vector<pair<uint32_t, uint32_t>> segment(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            segment[i] = {referenceKeys[offset + i], referencePayload[offset + i]};
+        }
+        stable_sort(segment.begin(), segment.end(), [descending](auto const &left, auto const &right) {
+            return descending ? left.first > right.first : left.first < right.first;
+        });
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            referenceKeys[offset + i]    = segment[i].first;
+            referencePayload[offset + i] = segment[i].second;
+        }
+        offset += stride > 0 ? stride : count;
+    }
+
+    CPUSort sort(descending ? CPUSort::Operation::Descending : CPUSort::Operation::Ascending);
+    uint32_t *payloadData = usePayload ? payload.data() : nullptr;
+    bool const sorted =
+        stride > 0 ? sort.sortSegmented(keys.data(), static_cast<uint32_t>(segments.size()), segments.data(),
+                         stride, payloadData)
+                   : sort.sortSegmented(keys.data(), segments, payloadData);
+    return sorted && keys == referenceKeys && (!usePayload || payload == referencePayload);
+}
+} // unnamed namespace
+
+int main()
+{
+    // Segments covering: empty lists, single keys, block boundaries, more blocks than thread groups and
+    // a mix of empty and non-empty segments
+    vector<vector<uint32_t>> const packedSegments = {
+        {},
+        {0},
+        {0, 0, 0},
+        {1},
+        {511, 512, 513},
+        {CPUSort::kMaxThreadGroups * CPUSort::kBlockSize + 777},
+        {5, 0, 10000, 17, 0, 4096},
+    };
+    vector<vector<uint32_t>> const stridedSegments = {
+        {0, 0},
+        {5, 0, 1000, 17, 1024},
+        {1024, 1, 333},
+    };
+    constexpr uint32_t segmentStride = 1024;
+
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *type, uint32_t const workers,
+                         bool const descending, uint32_t const keyMask, bool const usePayload,
+                         size_t const index) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s segments %zu, workers %u, %s, key mask 0x%X, %s\n", type, index, workers,
+                descending ? "descending" : "ascending", keyMask, usePayload ? "payload" : "keys only");
+        }
+    };
+    for (uint32_t const workers : {0U, 3U, ~0U})
+    {
+        TaskScheduler::Get().setWorkerCount(workers, false);
+        for (bool const descending : {false, true})
+        {
+            for (uint32_t const keyMask : {0xFFFFFFFFU, 0x3U})
+            {
+                for (bool const usePayload : {true, false})
+                {
+                    for (size_t i = 0; i < packedSegments.size(); ++i)
+                    {
+                        check(TestSort(packedSegments[i], 0, descending, keyMask, usePayload), "packed",
+                            workers, descending, keyMask, usePayload, i);
+                    }
+                    for (size_t i = 0; i < stridedSegments.size(); ++i)
+                    {
+                        check(TestSort(stridedSegments[i], segmentStride, descending, keyMask, usePayload),
+                            "strided", workers, descending, keyMask, usePayload, i);
+                    }
+                }
+            }
+        }
+
+        // Unsegmented sort of keys only
+        vector<uint32_t> keys(100000);
+        ranges::generate(keys, [] { return static_cast<uint32_t>(randomGenerator()); });
+        vector<uint32_t> referenceKeys = keys;
+        ranges::stable_sort(referenceKeys);
+        CPUSort sort;
+        check(sort.sort(keys.data(), static_cast<uint32_t>(keys.size())) && keys == referenceKeys, "single",
+            workers, false, 0xFFFFFFFFU, false, 0);
+        check(sort.sort(nullptr, 0), "empty", workers, false, 0xFFFFFFFFU, false, 0);
+    }
+    TaskScheduler::Get().shutdown();
+
+    printf("%u of %u CPUSort tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,195 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cube_lut.h"
+#include "lut_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/** Table of 3 entries per channel mapping 0, 0.5 and 1 to 0, 0.25 and 1 */
+constexpr string_view kCurve1D = "LUT_1D_SIZE 3\n0 0 0\n0.25 0.25 0.25\n1 1 1\n";
+
+/** Identity table of 2 entries per dimension, red changes fastest */
+constexpr string_view kIdentity3D =
+    "LUT_3D_SIZE 2\n0 0 0\n1 0 0\n0 1 0\n1 1 0\n0 0 1\n1 0 1\n0 1 1\n1 1 1\n";
+
+/**
+ * Checks whether a colour is within the precision of half precision table entries of an expected colour.
+ * @param value    The colour.
+ * @param expected The expected colour.
+ * @return True if close, False otherwise.
+ */
+bool Near(CubeLut::Vector const &value, CubeLut::Vector const &expected)
+{
+    for (uint32_t channel = 0; channel < 3; ++channel)
+    {
+        if (abs(value[channel] - expected[channel]) > 1.0e-3F)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Checks that parsing fails with a given error.
+ * @param text  The file contents.
+ * @param error The expected error, including the line number.
+ * @return True if parsing failed with the expected error and left the table empty, False otherwise.
+ */
+bool Fails(string_view const &text, string_view const &error)
+{
+    CubeLut lut;
+    string  message;
+    return !lut.parse(text, message) && message.starts_with(error) && !lut.isValid()
+        && lut.getTexels().empty();
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *name) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s\n", name);
+        }
+    };
+
+    // 1D tables interpolate each channel separately
+    CubeLut lut;
+    string  error;
+    check(lut.parse(kCurve1D, error) && lut.getType() == CubeLut::Type::LUT1D && lut.getSize() == 3,
+        "parse 1D");
+    check(Near(lut.evaluate({0.5F, 0.75F, 0.25F}), {0.25F, 0.625F, 0.125F}), "evaluate 1D");
+    check(lut.getDescription().width == 3 && lut.getDescription().height == 1
+              && lut.getDescription().sliceCount == 1 && lut.getTexels().size() == 3 * 4 * sizeof(uint16_t),
+        "1D layout");
+
+    // 3D tables interpolate between the 8 surrounding entries, comments, titles, blank lines, signs and
+    // windows line endings are accepted
+    check(lut.parse(kIdentity3D, error) && lut.getType() == CubeLut::Type::LUT3D && lut.getSize() == 2,
+        "parse 3D");
+    check(Near(lut.evaluate({1.0F, 0.0F, 0.0F}), {1.0F, 0.0F, 0.0F})
+              && Near(lut.evaluate({0.2F, 0.6F, 0.9F}), {0.2F, 0.6F, 0.9F}),
+        "evaluate 3D");
+    uint16_t alpha = 0;
+    memcpy(&alpha, lut.getTexels().data() + 3 * sizeof(uint16_t), sizeof(alpha));
+    check(alpha == 0x3C00 && lut.getDescription().height == 2 && lut.getDescription().sliceCount == 2,
+        "3D layout");
+    check(lut.parse("# Comment\r\nTITLE \"Grade\"\r\n\r\n  LUT_3D_SIZE 2\r\n+0 0 0\r\n# Comment\r\n1 0 0\r\n"
+                    "0 1 0\r\n1 1 0\r\n0 0 1\r\n1 0 1\r\n\r\n0 1 1\r\n1 1 1",
+              error)
+              && Near(lut.evaluate({0.2F, 0.6F, 0.9F}), {0.2F, 0.6F, 0.9F}),
+        "comments and line endings");
+
+    // Domains map onto the first and last entries with inputs outside the domain clamped
+    check(lut.parse("DOMAIN_MIN 0 0 -1\nDOMAIN_MAX 2 4 1\nLUT_1D_SIZE 2\n0 0 0\n1 1 1\n", error)
+              && lut.getDomainMin() == CubeLut::Vector {0.0F, 0.0F, -1.0F}
+              && lut.getDomainMax() == CubeLut::Vector {2.0F, 4.0F, 1.0F},
+        "DOMAIN");
+    check(Near(lut.evaluate({1.0F, 1.0F, 0.0F}), {0.5F, 0.25F, 0.5F})
+              && Near(lut.evaluate({3.0F, -1.0F, 2.0F}), {1.0F, 0.0F, 1.0F}),
+        "evaluate DOMAIN");
+    check(lut.parse("LUT_3D_INPUT_RANGE -1 1\n" + string(kIdentity3D), error)
+              && Near(lut.evaluate({0.0F, 0.5F, -1.0F}), {0.5F, 0.75F, 0.0F}),
+        "INPUT_RANGE");
+    check(lut.parse(kCurve1D, error) && lut.getDomainMin() == CubeLut::Vector {0.0F, 0.0F, 0.0F},
+        "domain reset");
+
+    // Keyword errors
+    check(Fails("TITLE \"x\"\n0 0 0\n", "Line 2: Missing LUT_1D_SIZE or LUT_3D_SIZE"), "missing size");
+    check(Fails("LUT_1D_SIZE 2\nLUT_3D_SIZE 2\n0 0 0\n", "Line 3: Combined 1D and 3D"), "1D and 3D");
+    check(Fails("LUT_3D_SIZE 1\n", "Line 1: Invalid LUT_3D_SIZE"), "3D size too small");
+    check(Fails("LUT_3D_SIZE 257\n", "Line 1: Invalid LUT_3D_SIZE"), "3D size too large");
+    check(Fails("LUT_1D_SIZE 16385\n", "Line 1: Invalid LUT_1D_SIZE"), "1D size too large");
+    check(Fails("LUT_1D_SIZE 2 2\n", "Line 1: Invalid LUT_1D_SIZE"), "size followed by values");
+    check(Fails("LUT_1D_SIZE -2\n", "Line 1: Invalid LUT_1D_SIZE"), "negative size");
+    check(Fails("LUT_1D_SIZE 2\nDOMAIN_MIN 0 0\n", "Line 2: Invalid domain"), "domain too few values");
+    check(Fails("DOMAIN_MAX 1 1 1 1\nLUT_1D_SIZE 2\n", "Line 1: Invalid domain"), "domain too many values");
+    check(Fails("DOMAIN_MIN 0 1 0\nDOMAIN_MAX 1 1 1\nLUT_1D_SIZE 2\n0 0 0\n", "Line 4: DOMAIN_MAX must be"),
+        "empty domain");
+    check(Fails("LUT_1D_INPUT_RANGE 0\nLUT_1D_SIZE 2\n", "Line 1: Invalid input range"), "input range");
+
+    // Table entry errors
+    check(Fails("LUT_1D_SIZE 3\n0 0 0\n1 1 1\n", "Line 3: Too few table entries"), "too few entries");
+    check(Fails("LUT_1D_SIZE 2\n", "Line 1: Too few table entries"), "no entries");
+    check(Fails("LUT_1D_SIZE 2\n0 0 0\n1 1 1\n1 1 1\n", "Line 4: Too many table entries"),
+        "too many entries");
+    check(Fails("LUT_1D_SIZE 2\n0 0 0\n1 1\n", "Line 3: Invalid table entry"), "entry with 2 values");
+    check(Fails("LUT_1D_SIZE 2\n0 0 0 0\n1 1 1\n", "Line 2: Invalid table entry"), "entry with 4 values");
+    check(Fails("LUT_1D_SIZE 2\n0 0x 0\n1 1 1\n", "Line 2: Invalid table entry"), "invalid number");
+    check(Fails("LUT_1D_SIZE 2\n0 0 0\n1 1 1e39\n", "Line 3: Invalid table entry"), "infinite value");
+    check(Fails("LUT_1D_SIZE 2\n0 0 0\nDOMAIN_MIN 0 0 0\n1 1 1\n", "Line 3: Invalid table entry"),
+        "keyword after entries");
+
+    // Tables with more entries than a single conversion batch, blue holds the entry index
+    string large = "LUT_3D_SIZE 17\n";
+    for (uint32_t i = 0; i < 17 * 17 * 17; ++i)
+    {
+        large += to_string(static_cast<float>(i % 17) / 16.0F) + " 0.5 " + to_string(i) + "e-4\n";
+    }
+    check(lut.parse(large, error) && Near(lut.evaluate({0.25F, 0.0F, 1.0F}), {0.25F, 0.5F, 0.4628F}),
+        "large table");
+
+    // Loading from a file, parsed tables are stored in the cache and reused
+    auto const root = filesystem::temp_directory_path()
+                    / ("capsaicin_cube_lut_test_" + to_string(random_device()()));
+    filesystem::remove_all(root);
+    filesystem::create_directories(root);
+    auto const file = root / "grade.cube";
+    ofstream(file, ios::binary) << "DOMAIN_MAX 2 2 2\n" << kCurve1D;
+    LutCache cache;
+    cache.setDirectory(root / "cache");
+    check(lut.load(file, error) && lut.getSize() == 3, "load");
+    check(!lut.load(root / "missing.cube", error) && error == "Failed to open file" && !lut.isValid(),
+        "load missing file");
+    check(lut.load(file, cache, error), "load uncached");
+    cache.flush();
+    CubeLut cached;
+    check(cached.load(file, cache, error) && cached.getType() == CubeLut::Type::LUT1D
+              && cached.getDomainMax() == CubeLut::Vector {2.0F, 2.0F, 2.0F}
+              && equal(cached.getTexels().begin(), cached.getTexels().end(), lut.getTexels().begin(),
+                  lut.getTexels().end()),
+        "load cached");
+    filesystem::remove_all(root);
+
+    printf("%u of %u CubeLut tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,248 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "lut_cache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/** Size of the header preceding the texture data of each entry */
+constexpr size_t kHeaderSize = 48;
+
+/**
+ * Creates a description of a small 2D texture along with its data.
+ * @param seed Value used to fill the texture data.
+ * @param data Output texture data.
+ * @return The description.
+ */
+LutCache::Description CreateEntry(uint8_t const seed, vector<byte> &data)
+{
+    LutCache::Description ret;
+    ret.format        = 2; // DXGI_FORMAT_R32G32B32A32_FLOAT
+    ret.width         = 2;
+    ret.height        = 2;
+    ret.bytesPerTexel = 16;
+    data.resize(ret.getSize());
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<byte>(seed + i);
+    }
+    return ret;
+}
+
+/**
+ * Checks whether an entry can be loaded and holds the expected values.
+ * @param cache       The cache.
+ * @param key         The key identifying the entry.
+ * @param description The expected description.
+ * @param data        The expected texture data.
+ * @return True if loaded and equal, False otherwise.
+ */
+bool Loads(LutCache const &cache, LutCache::Key const &key, LutCache::Description const &description,
+    vector<byte> const &data)
+{
+    LutCache::Description loadedDescription;
+    vector<byte>          loadedData;
+    return cache.load(key, loadedDescription, loadedData) && loadedDescription == description
+        && loadedData == data;
+}
+
+/**
+ * Modifies part of a file in place.
+ * @param file   Full path to the file.
+ * @param offset Offset of the bytes to overwrite.
+ * @param value  The value to write.
+ */
+void Patch(filesystem::path const &file, size_t const offset, uint32_t const value)
+{
+    fstream stream(file, ios::binary | ios::in | ios::out);
+    stream.seekp(static_cast<streamoff>(offset));
+    stream.write(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *name) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s\n", name);
+        }
+    };
+
+    // Keys depend on every added value and on the order they are added in
+    auto const key = [](uint64_t const size, string_view const &shader) {
+        return LutCache::Key().add(size).add(shader);
+    };
+    check(key(64, "brdf").getHash() == key(64, "brdf").getHash(), "key is deterministic");
+    check(key(64, "brdf").getHash() != key(32, "brdf").getHash(), "key depends on values");
+    check(key(64, "brdf").getHash() != key(64, "brdf2").getHash(), "key depends on strings");
+    check(LutCache::Key().add(1).add(2).getHash() != LutCache::Key().add(2).add(1).getHash(),
+        "key depends on order");
+    string const name = key(64, "brdf").getName();
+    check(name.size() == 16 && name.find_first_not_of("0123456789abcdef") == string::npos
+              && stoull(name, nullptr, 16) == key(64, "brdf").getHash(),
+        "key name");
+
+    // Hashes depend on every byte including the length, for sizes covering each tail of the unrolled loop
+    vector<byte> bytes(80);
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+        bytes[i] = static_cast<byte>(i * 7);
+    }
+    set<uint64_t> hashes;
+    bool          flipped = true;
+    for (size_t size = 0; size <= bytes.size(); ++size)
+    {
+        span<byte const> const data(bytes.data(), size);
+        hashes.insert(LutCache::Hash(data));
+        for (size_t i = 0; i < size; ++i)
+        {
+            vector<byte> modified(data.begin(), data.end());
+            modified[i] ^= byte {1};
+            flipped = flipped && LutCache::Hash(modified) != LutCache::Hash(data);
+        }
+    }
+    check(hashes.size() == bytes.size() + 1, "hash depends on length");
+    check(flipped, "hash depends on every byte");
+    check(LutCache::Hash(bytes, 1) != LutCache::Hash(bytes), "hash depends on seed");
+
+    // Mip offsets include every slice of each level
+    LutCache::Description cube;
+    cube.width         = 8;
+    cube.height        = 4;
+    cube.sliceCount    = 6;
+    cube.mipCount      = 4;
+    cube.bytesPerTexel = 4;
+    check(cube.getMipOffset(1) == 768 && cube.getMipOffset(3) == 768 + 192 + 48, "mip offsets");
+    check(cube.getSize() == 768 + 192 + 48 + 24, "texture size");
+
+    // Temporary cache directory, removed again at the end
+    auto const root = filesystem::temp_directory_path()
+                    / ("capsaicin_lut_cache_test_" + to_string(random_device()()));
+    filesystem::remove_all(root);
+    LutCache cache;
+    cache.setDirectory(root);
+    cache.setMaxSize(0);
+
+    // Round trip, an entry replaces any existing entry with the same key
+    vector<byte>                dataA;
+    vector<byte>                dataB;
+    LutCache::Description const description  = CreateEntry(1, dataA);
+    LutCache::Description const descriptionB = CreateEntry(2, dataB);
+    LutCache::Key const         keyA         = key(64, "a");
+    LutCache::Key const         keyB         = key(64, "b");
+    check(!Loads(cache, keyA, description, dataA), "missing entry");
+    check(cache.save(keyA, description, dataA) && Loads(cache, keyA, description, dataA), "round trip");
+    check(cache.save(keyA, descriptionB, dataB) && Loads(cache, keyA, descriptionB, dataB), "replace entry");
+    check(!cache.save(keyB, cube, dataA), "save with wrong data size");
+    check(!filesystem::exists(root / (keyA.getName() + ".lut.tmp")), "temporary file removed");
+
+    // Entries generated from a modified source file use a different key, the stale entry is never found
+    auto const source = root / "source.hdr";
+    ofstream(source, ios::binary) << "original";
+    uint64_t sourceHash = 0;
+    check(LutCache::HashFile(source, sourceHash)
+              && sourceHash == LutCache::Hash(as_bytes(span("original", 8))),
+        "hash file");
+    LutCache::Key const original = LutCache::Key().add(sourceHash);
+    check(cache.save(original, description, dataA), "save source entry");
+    ofstream(source, ios::binary) << "modified";
+    check(LutCache::HashFile(source, sourceHash), "hash modified file");
+    check(!Loads(cache, LutCache::Key().add(sourceHash), description, dataA), "stale entry");
+    check(!LutCache::HashFile(root / "missing.hdr", sourceHash), "hash missing file");
+
+    // Corrupted and truncated entries are rejected
+    auto const entryPath = root / (keyA.getName() + ".lut");
+    auto const corrupt   = [&](size_t const offset, uint32_t const value) {
+        if (!cache.save(keyA, description, dataA))
+        {
+            return false;
+        }
+        Patch(entryPath, offset, value);
+        return !Loads(cache, keyA, description, dataA);
+    };
+    check(corrupt(0, 0), "bad magic");
+    check(corrupt(4, LutCache::kVersion + 1), "bad version");
+    check(corrupt(12, 4), "description does not match size");
+    check(corrupt(kHeaderSize + 8, 0xDEADBEEF), "corrupted data");
+    check(cache.save(keyA, description, dataA), "save before truncation");
+    filesystem::resize_file(entryPath, kHeaderSize + dataA.size() - 1);
+    check(!Loads(cache, keyA, description, dataA), "truncated data");
+    filesystem::resize_file(entryPath, kHeaderSize - 1);
+    check(!Loads(cache, keyA, description, dataA), "truncated header");
+
+    // Least recently used entries are evicted first, loading an entry marks it as used
+    filesystem::remove_all(root);
+    uint64_t const entrySize = kHeaderSize + dataA.size();
+    cache.setMaxSize(3 * entrySize);
+    LutCache::Key const keys[]   = {key(1, "lru"), key(2, "lru"), key(3, "lru"), key(4, "lru")};
+    auto const          now      = filesystem::file_time_type::clock::now();
+    bool                savedAll = true;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        savedAll = savedAll && cache.save(keys[i], description, dataA);
+        filesystem::last_write_time(root / (keys[i].getName() + ".lut"), now - chrono::hours(3 - i));
+    }
+    check(savedAll, "save entries within cap");
+    check(Loads(cache, keys[0], description, dataA), "load oldest entry");
+    check(cache.save(keys[3], description, dataA), "save entry over cap");
+    check(Loads(cache, keys[0], description, dataA) && !Loads(cache, keys[1], description, dataA)
+              && Loads(cache, keys[2], description, dataA) && Loads(cache, keys[3], description, dataA),
+        "least recently used entry evicted");
+    cache.setMaxSize(entrySize / 2);
+    check(cache.save(keys[1], description, dataA) && Loads(cache, keys[1], description, dataA)
+              && !Loads(cache, keys[0], description, dataA) && !Loads(cache, keys[3], description, dataA),
+        "saved entry kept when over cap");
+
+    // Background saves are visible after a flush
+    cache.setMaxSize(0);
+    cache.saveAsync(keyB, descriptionB, dataB);
+    cache.flush();
+    check(Loads(cache, keyB, descriptionB, dataB), "async save");
+
+    // An empty directory disables the cache
+    cache.setDirectory({});
+    check(!cache.save(keyA, description, dataA) && !Loads(cache, keyB, descriptionB, dataB),
+        "disabled cache");
+
+    filesystem::remove_all(root);
+
+    printf("%u of %u LutCache tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,143 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "memory_tracker.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/**
+ * Compare a memory usage against expected values.
+ * @param usage           The usage to check.
+ * @param gpuBytes        Expected device local memory.
+ * @param gpuPeakBytes    Expected device local high-water mark.
+ * @param cpuBytes        Expected CPU visible memory.
+ * @param cpuPeakBytes    Expected CPU visible high-water mark.
+ * @param allocationCount Expected number of allocations.
+ * @return True if all values match, False otherwise.
+ */
+bool CheckUsage(MemoryUsage const &usage, uint64_t const gpuBytes, uint64_t const gpuPeakBytes,
+    uint64_t const cpuBytes, uint64_t const cpuPeakBytes, uint32_t const allocationCount)
+{
+    return usage.gpuBytes == gpuBytes && usage.gpuPeakBytes == gpuPeakBytes && usage.cpuBytes == cpuBytes
+        && usage.cpuPeakBytes == cpuPeakBytes && usage.allocationCount == allocationCount;
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *name) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s\n", name);
+        }
+    };
+
+    // Owner scopes nest and restore the previous owner when they end
+    check(MemoryTracker::GetCurrentOwner() == MemoryTracker::kDefaultOwner, "default owner");
+    {
+        MemoryTracker::OwnerScope const outer("Outer");
+        check(MemoryTracker::GetCurrentOwner() == "Outer", "outer scope");
+        {
+            MemoryTracker::OwnerScope const inner("Inner");
+            check(MemoryTracker::GetCurrentOwner() == "Inner", "inner scope");
+        }
+        check(MemoryTracker::GetCurrentOwner() == "Outer", "outer scope restored");
+    }
+    check(MemoryTracker::GetCurrentOwner() == MemoryTracker::kDefaultOwner, "default owner restored");
+
+    // Allocations are attributed to the owner current when they are added, not when they are removed
+    MemoryTracker tracker;
+    {
+        MemoryTracker::OwnerScope const outer("A");
+        tracker.addAllocation(MemoryTracker::GetBufferKey(0), 100, false);
+        tracker.addAllocation(MemoryTracker::GetBufferKey(1), 50, true);
+        {
+            MemoryTracker::OwnerScope const inner("B");
+            tracker.addAllocation(MemoryTracker::GetBufferKey(2), 30, false);
+        }
+        tracker.addAllocation(MemoryTracker::GetTextureKey(3), 1000, false);
+    }
+    tracker.addAllocation(MemoryTracker::GetTextureKey(4), 7, true);
+    check(CheckUsage(tracker.getUsage("A"), 1100, 1100, 50, 50, 3), "owner A usage");
+    check(CheckUsage(tracker.getUsage("B"), 30, 30, 0, 0, 1), "owner B usage");
+    check(CheckUsage(tracker.getUsage(MemoryTracker::kDefaultOwner), 0, 0, 7, 7, 1), "default owner usage");
+    check(CheckUsage(tracker.getUsage("Unknown"), 0, 0, 0, 0, 0), "unknown owner usage");
+    check(CheckUsage(tracker.getTotalUsage(), 1130, 1130, 57, 57, 5), "total usage");
+    check(tracker.getUsages().size() == 3, "owner count");
+
+    // Removing keeps the high-water marks until they are reset
+    {
+        MemoryTracker::OwnerScope const other("B");
+        tracker.removeAllocation(MemoryTracker::GetTextureKey(3));
+    }
+    tracker.removeAllocation(MemoryTracker::GetBufferKey(1));
+    check(CheckUsage(tracker.getUsage("A"), 100, 1100, 0, 50, 1), "owner A after remove");
+    check(CheckUsage(tracker.getUsage("B"), 30, 30, 0, 0, 1), "owner B after remove");
+    check(CheckUsage(tracker.getTotalUsage(), 130, 1130, 7, 57, 3), "total after remove");
+    tracker.resetPeaks();
+    check(CheckUsage(tracker.getUsage("A"), 100, 100, 0, 0, 1), "owner A after peak reset");
+    check(CheckUsage(tracker.getTotalUsage(), 130, 130, 7, 7, 3), "total after peak reset");
+    {
+        MemoryTracker::OwnerScope const owner("A");
+        tracker.addAllocation(MemoryTracker::GetBufferKey(5), 400, false);
+    }
+    tracker.removeAllocation(MemoryTracker::GetBufferKey(5));
+    check(CheckUsage(tracker.getUsage("A"), 100, 500, 0, 0, 1), "owner A new peak");
+
+    // Removing unknown or already removed keys is ignored
+    tracker.removeAllocation(MemoryTracker::GetBufferKey(3));
+    tracker.removeAllocation(MemoryTracker::GetBufferKey(5));
+    check(CheckUsage(tracker.getTotalUsage(), 130, 530, 7, 7, 3), "remove unknown key");
+
+    // Buffers and textures with the same index use separate keys
+    check(MemoryTracker::GetBufferKey(9) != MemoryTracker::GetTextureKey(9), "separate key ranges");
+    check(MemoryTracker::GetBufferKey(0xFFFFFFFFU) < MemoryTracker::GetTextureKey(0), "ordered key ranges");
+    {
+        MemoryTracker::OwnerScope const owner("C");
+        tracker.addAllocation(MemoryTracker::GetBufferKey(9), 10, false);
+        tracker.addAllocation(MemoryTracker::GetTextureKey(9), 20, false);
+    }
+    check(CheckUsage(tracker.getUsage("C"), 30, 30, 0, 0, 2), "buffer and texture with same index");
+    tracker.removeAllocation(MemoryTracker::GetBufferKey(9));
+    check(CheckUsage(tracker.getUsage("C"), 20, 30, 0, 0, 1), "remove buffer keeps texture");
+
+    // Re-using a key releases the previous allocation first
+    {
+        MemoryTracker::OwnerScope const owner("D");
+        tracker.addAllocation(MemoryTracker::GetTextureKey(9), 5, true);
+    }
+    check(CheckUsage(tracker.getUsage("C"), 0, 30, 0, 0, 0), "re-used key released from old owner");
+    check(CheckUsage(tracker.getUsage("D"), 0, 0, 5, 5, 1), "re-used key added to new owner");
+
+    printf("%u of %u MemoryTracker tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,341 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "pixel_conversion.h"
+
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/**
+ * Exact single precision value of a half, computed independently of the conversion code.
+ * @param half The half value.
+ * @return The value.
+ */
+float ReferenceHalfToFloat(uint16_t const half)
+{
+    uint32_t const exponent = (half >> 10) & 0x1FU;
+    uint32_t const mantissa = half & 0x3FFU;
+    float const    sign     = (half & 0x8000U) != 0 ? -1.0F : 1.0F;
+    if (exponent == 0x1FU)
+    {
+        float const special =
+            mantissa == 0 ? numeric_limits<float>::infinity() : numeric_limits<float>::quiet_NaN();
+        return copysign(special, sign);
+    }
+    if (exponent == 0)
+    {
+        return sign * ldexp(static_cast<float>(mantissa), -24);
+    }
+    return sign * ldexp(static_cast<float>(mantissa | 0x400U), static_cast<int>(exponent) - 25);
+}
+
+/**
+ * Checks whether 2 floats are identical, NaNs only need to match in sign as vector units may keep payloads.
+ * @param a The first value.
+ * @param b The second value.
+ * @return True if identical, False otherwise.
+ */
+bool SameFloat(float const a, float const b)
+{
+    if (isnan(a) || isnan(b))
+    {
+        return isnan(a) && isnan(b) && signbit(a) == signbit(b);
+    }
+    return bit_cast<uint32_t>(a) == bit_cast<uint32_t>(b);
+}
+
+/**
+ * Checks whether 2 halves are identical, NaNs only need to match in sign as vector units may keep payloads.
+ * @param a The first value.
+ * @param b The second value.
+ * @return True if identical, False otherwise.
+ */
+bool SameHalf(uint16_t const a, uint16_t const b)
+{
+    auto const isNaN = [](uint16_t const value) { return (value & 0x7FFFU) > 0x7C00U; };
+    if (isNaN(a) || isNaN(b))
+    {
+        return isNaN(a) && isNaN(b) && (a & 0x8000U) == (b & 0x8000U);
+    }
+    return a == b;
+}
+
+/**
+ * Converts values using the vector path for as much of the input as possible and compares the results with
+ * converting one value at a time, which only uses the scalar path. Every count up to the input size is
+ * checked so that each tail length is covered, a guard value checks nothing is written past the end.
+ * @param source  The input values.
+ * @param convert The conversion function.
+ * @param same    Comparison of 2 output values.
+ * @param guard   Value placed after the end of the output.
+ * @return True if all outputs match, False otherwise.
+ */
+template<typename In, typename Out, typename Convert, typename Same>
+bool MatchesScalar(vector<In> const &source, Convert const &convert, Same const &same, Out const guard)
+{
+    vector<Out> scalar(source.size());
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        convert(&source[i], &scalar[i], 1);
+    }
+    // Every tail length up to 2 full vectors followed by the entire input
+    vector<size_t> counts(18);
+    iota(counts.begin(), counts.end(), size_t {0});
+    counts.push_back(source.size());
+    for (size_t count : counts)
+    {
+        count = min(count, source.size());
+        vector<Out> converted(count + 1, guard);
+        convert(source.data(), converted.data(), count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!same(converted[i], scalar[i]))
+            {
+                return false;
+            }
+        }
+        if (memcmp(&converted[count], &guard, sizeof(Out)) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Splits interleaved pixels into planes and compares the results with a simple loop.
+ * @tparam T Type of each channel value.
+ * @param channelCount Number of channels in each pixel.
+ * @param pixelCount   Number of pixels.
+ * @param skipChannel  Channel whose destination is nullptr, ~0 to write every channel.
+ * @return True if the planes match, False otherwise.
+ */
+template<typename T>
+bool SplitMatches(uint32_t const channelCount, size_t const pixelCount, uint32_t const skipChannel)
+{
+    vector<T> source(channelCount * pixelCount);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<T>(i * 7 + 3);
+    }
+    T const           guard = static_cast<T>(0xA5);
+    vector<vector<T>> planes(channelCount, vector<T>(pixelCount + 1, guard));
+    T                *destinations[4] = {};
+    for (uint32_t channel = 0; channel < channelCount; ++channel)
+    {
+        destinations[channel] = channel != skipChannel ? planes[channel].data() : nullptr;
+    }
+    SplitChannels(source.data(), channelCount, destinations, pixelCount);
+    for (uint32_t channel = 0; channel < channelCount; ++channel)
+    {
+        for (size_t pixel = 0; pixel < pixelCount; ++pixel)
+        {
+            T const expected = channel != skipChannel ? source[pixel * channelCount + channel] : guard;
+            if (planes[channel][pixel] != expected)
+            {
+                return false;
+            }
+        }
+        if (planes[channel][pixelCount] != guard)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Checks SplitChannels against a simple loop for every channel count, tail length and skipped channel.
+ * @tparam T Type of each channel value.
+ * @return True if all results match, False otherwise.
+ */
+template<typename T>
+bool SplitAllMatch()
+{
+    for (uint32_t channelCount = 1; channelCount <= 4; ++channelCount)
+    {
+        for (size_t pixelCount = 0; pixelCount <= 40; ++pixelCount)
+        {
+            for (uint32_t skipChannel = 0; skipChannel <= channelCount; ++skipChannel)
+            {
+                uint32_t const skip = skipChannel < channelCount ? skipChannel : ~0U;
+                if (!SplitMatches<T>(channelCount, pixelCount, skip))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *name) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s\n", name);
+        }
+    };
+    auto const sameFloat = [](float const a, float const b) { return SameFloat(a, b); };
+    auto const sameHalf  = [](uint16_t const a, uint16_t const b) { return SameHalf(a, b); };
+    auto const sameExact = [](auto const a, auto const b) { return a == b; };
+
+    // Every half value, including denormals, infinities and NaNs
+    vector<uint16_t> halves(65536);
+    for (uint32_t i = 0; i < 65536; ++i)
+    {
+        halves[i] = static_cast<uint16_t>(i);
+    }
+    vector<float> floats(halves.size());
+    ConvertHalfToFloat(halves.data(), floats.data(), halves.size());
+    bool exact = true;
+    for (size_t i = 0; i < halves.size(); ++i)
+    {
+        exact = exact && SameFloat(floats[i], ReferenceHalfToFloat(halves[i]));
+    }
+    check(exact, "half to float exact for all halves");
+    check(MatchesScalar(halves, ConvertHalfToFloat, sameFloat, -1.0F), "half to float vector matches scalar");
+    vector<uint16_t> roundTrip(halves.size());
+    ConvertFloatToHalf(floats.data(), roundTrip.data(), floats.size());
+    check(equal(halves.cbegin(), halves.cend(), roundTrip.cbegin(), sameHalf), "half round trip");
+
+    // Float to half rounding, overflow, underflow to denormals and zero, and special values
+    vector<float> values = {0.0F, -0.0F, 1.0F, -1.0F, 65504.0F, 65519.99F, 65520.0F, -65520.0F, 1.0e10F,
+        numeric_limits<float>::infinity(), -numeric_limits<float>::infinity(),
+        numeric_limits<float>::quiet_NaN(), -numeric_limits<float>::quiet_NaN(),
+        bit_cast<float>(0x7F800001U), numeric_limits<float>::denorm_min(), numeric_limits<float>::min(),
+        ldexp(1.0F, -24), ldexp(1.0F, -25), ldexp(1.5F, -25), ldexp(1.0F, -26), ldexp(1.0F, -14),
+        ldexp(1023.5F, -24), 1.0F + ldexp(1.0F, -11), 1.0F + ldexp(3.0F, -11), 1.0F + ldexp(1.0F, -12)};
+    for (uint32_t i = 0; i < 65536; ++i)
+    {
+        // Exact halves, values half way between neighbouring halves and values either side of those
+        float const value = ReferenceHalfToFloat(static_cast<uint16_t>(i));
+        float const next  = ReferenceHalfToFloat(static_cast<uint16_t>(i + 1));
+        if (isfinite(value) && isfinite(next) && (i & 0x7FFFU) != 0x7BFFU)
+        {
+            float const midpoint = (value + next) * 0.5F;
+            values.insert(values.end(), {midpoint, nextafter(midpoint, value), nextafter(midpoint, next)});
+        }
+    }
+    check(MatchesScalar(values, ConvertFloatToHalf, sameHalf, uint16_t {0xA5A5}),
+        "float to half vector matches scalar");
+    vector<uint16_t> converted(values.size());
+    ConvertFloatToHalf(values.data(), converted.data(), values.size());
+    bool nearest = true;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        // The result must be the closest half with ties going to the even mantissa
+        float const value  = values[i];
+        float const result = ReferenceHalfToFloat(converted[i]);
+        if (isnan(value))
+        {
+            nearest = nearest && isnan(result) && signbit(value) == signbit(result);
+            continue;
+        }
+        if (abs(value) >= 65520.0F)
+        {
+            nearest = nearest && isinf(result) && signbit(value) == signbit(result);
+            continue;
+        }
+        uint16_t const magnitude = converted[i] & 0x7FFFU;
+        float const    error     = abs(abs(value) - abs(result));
+        float const    lower     = ReferenceHalfToFloat(static_cast<uint16_t>(magnitude - 1));
+        float const    upper     = ReferenceHalfToFloat(static_cast<uint16_t>(magnitude + 1));
+        float const    below =
+            magnitude > 0 ? abs(abs(value) - lower) : numeric_limits<float>::infinity();
+        float const    above = abs(abs(value) - upper);
+        nearest = nearest && signbit(value) == signbit(result) && error <= below && error <= above
+               && ((error != below && error != above) || (magnitude & 1U) == 0);
+    }
+    check(nearest, "float to half rounds to nearest even");
+
+    // Unorm conversion of every value
+    vector<uint16_t> unorm16(65536);
+    vector<uint8_t>  unorm8(256);
+    for (uint32_t i = 0; i < 65536; ++i)
+    {
+        unorm16[i] = static_cast<uint16_t>(i);
+        if (i < 256)
+        {
+            unorm8[i] = static_cast<uint8_t>(i);
+        }
+    }
+    auto const unorm16ToFloat = [](uint16_t const *source, float *destination, size_t const count) {
+        ConvertUnormToFloat(source, destination, count);
+    };
+    auto const unorm8ToFloat = [](uint8_t const *source, float *destination, size_t const count) {
+        ConvertUnormToFloat(source, destination, count);
+    };
+    check(MatchesScalar(unorm16, unorm16ToFloat, sameFloat, -1.0F), "unorm16 to float vector matches scalar");
+    check(MatchesScalar(unorm8, unorm8ToFloat, sameFloat, -1.0F), "unorm8 to float vector matches scalar");
+    vector<float> unormFloats(unorm16.size());
+    ConvertUnormToFloat(unorm16.data(), unormFloats.data(), unorm16.size());
+    check(unormFloats.front() == 0.0F && unormFloats.back() == 1.0F
+              && unormFloats[32768] == 32768.0F / 65535.0F,
+        "unorm16 to float range");
+    ConvertUnormToFloat(unorm8.data(), unormFloats.data(), unorm8.size());
+    check(unormFloats[0] == 0.0F && unormFloats[255] == 1.0F && unormFloats[51] == 0.2F,
+        "unorm8 to float range");
+
+    // Quantization clamps, rounds down and converts NaN to zero
+    vector<float> quantize = {numeric_limits<float>::quiet_NaN(), -numeric_limits<float>::quiet_NaN(),
+        -numeric_limits<float>::infinity(), numeric_limits<float>::infinity(), -1.0F, -0.0F, 2.0F,
+        numeric_limits<float>::denorm_min(), nextafter(1.0F, 0.0F)};
+    for (uint32_t i = 0; i <= 1024; ++i)
+    {
+        quantize.push_back(static_cast<float>(i) / 1024.0F);
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        quantize.insert(quantize.end(), {static_cast<float>(i) / 255.0F, nextafter(i / 255.0F, 0.0F)});
+    }
+    check(MatchesScalar(quantize, ConvertFloatToUnorm8, sameExact, uint8_t {0xA5}),
+        "float to unorm8 vector matches scalar");
+    vector<uint8_t> quantized(9);
+    ConvertFloatToUnorm8(quantize.data(), quantized.data(), quantized.size());
+    check(quantized == vector<uint8_t> {0, 0, 0, 255, 0, 0, 255, 0, 254}, "float to unorm8 special values");
+
+    // Channel splitting for each channel size, channel count and tail length
+    check(SplitAllMatch<uint8_t>(), "split uint8 channels");
+    check(SplitAllMatch<uint16_t>(), "split uint16 channels");
+    check(SplitAllMatch<uint32_t>(), "split uint32 channels");
+    check(SplitAllMatch<float>(), "split float channels");
+
+    printf("%u of %u PixelConversion tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
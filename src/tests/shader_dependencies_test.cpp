@@ -0,0 +1,262 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "shader_dependencies.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/**
+ * Create (or replace) a file along with any missing parent directories.
+ * @param file     Full path to the file.
+ * @param contents The file contents.
+ */
+void WriteFile(filesystem::path const &file, string_view const &contents)
+{
+    filesystem::create_directories(file.parent_path());
+    ofstream stream(file, ios::binary | ios::trunc);
+    stream.write(contents.data(), static_cast<streamsize>(contents.size()));
+}
+
+/**
+ * Gets the normalised form of a list of paths, in the same sorted order as the dependency queries.
+ * @param fileList The paths.
+ * @return The normalised paths.
+ */
+vector<filesystem::path> Normalised(vector<filesystem::path> const &fileList)
+{
+    vector<filesystem::path> ret;
+    for (auto const &file : fileList)
+    {
+        ret.emplace_back(ShaderDependencies::Normalise(file));
+    }
+    ranges::sort(ret);
+    return ret;
+}
+
+/**
+ * Gets the cache key of a shader compiled from a tree of source files.
+ * @param root    Root directory of the tree.
+ * @param defines The preprocessor defines.
+ * @return The key.
+ */
+string GetTreeKey(filesystem::path const &root, vector<string> const &defines)
+{
+    ShaderDependencies dependencies;
+    dependencies.setIncludePaths({root / "include"});
+    uint64_t const hash = dependencies.getHash(dependencies.getIncludeClosure(root / "shader.comp"));
+    return GetShaderCacheKey(hash, "main", defines, "dxc 1.8");
+}
+} // unnamed namespace
+
+int main()
+{
+    uint32_t failures = 0;
+    uint32_t tests    = 0;
+    auto     check    = [&](bool const passed, char const *name) {
+        ++tests;
+        if (!passed)
+        {
+            ++failures;
+            printf("FAILED: %s\n", name);
+        }
+    };
+
+    // Include parsing
+    check(ShaderDependencies::ParseIncludes("#include \"a.hlsl\"\n#include <b.hlsl>\n")
+              == vector<string> {"a.hlsl", "b.hlsl"},
+        "quoted and angled includes");
+    check(ShaderDependencies::ParseIncludes("  \t#  include\t \"dir/a.hlsl\"  // trailing\n#include<b.h>")
+              == vector<string> {"dir/a.hlsl", "b.h"},
+        "whitespace between tokens");
+    // A directive following a block comment on the same line is still a directive once the comment is removed
+    check(ShaderDependencies::ParseIncludes("// #include \"a.hlsl\"\n/* #include \"b.hlsl\"\n#include "
+                                            "\"c.hlsl\" */ #include \"d.hlsl\"\n#include \"e.hlsl\"")
+              == vector<string> {"d.hlsl", "e.hlsl"},
+        "commented out includes");
+    check(ShaderDependencies::ParseIncludes("/* a\nb */\n#include \"a.hlsl\"\nint x; // \"#include <b.h>\"")
+              == vector<string> {"a.hlsl"},
+        "includes after block comments");
+    check(ShaderDependencies::ParseIncludes("#include \"\"\n#include \"a.hlsl\n#include b.hlsl\n#included "
+                                            "<c.h>\nx #include <d.h>\n#pragma once")
+              .empty(),
+        "malformed includes");
+    check(ShaderDependencies::ParseIncludes("#include \"a.hlsl\"\r\n#include <b.hlsl>\r\n")
+              == vector<string> {"a.hlsl", "b.hlsl"},
+        "windows line endings");
+
+    // Temporary source tree, removed again at the end
+    auto const root = filesystem::temp_directory_path()
+                    / ("capsaicin_shader_dependencies_test_" + to_string(random_device()()));
+    filesystem::remove_all(root);
+    auto const shader     = root / "shader.comp";
+    auto const local      = root / "common.hlsl";
+    auto const first      = root / "first" / "common.hlsl";
+    auto const second     = root / "second" / "common.hlsl";
+    auto const secondOnly = root / "second" / "second_only.hlsl";
+    auto const cycleA     = root / "cycle_a.hlsl";
+    auto const cycleB     = root / "cycle_b.hlsl";
+    WriteFile(shader, "#include \"common.hlsl\"\n#include <second_only.hlsl>\n#include \"missing.hlsl\"\n");
+    WriteFile(local, "#include \"cycle_a.hlsl\"\n");
+    WriteFile(first, "// first include path\n");
+    WriteFile(second, "// second include path\n#include \"second_only.hlsl\"\n");
+    WriteFile(secondOnly, "// only in the second include path\n");
+    WriteFile(cycleA, "#include \"cycle_b.hlsl\"\n");
+    WriteFile(cycleB, "#include \"cycle_a.hlsl\"\n");
+
+    // Includes resolve relative to the including file first and then through each include path in order
+    ShaderDependencies dependencies;
+    dependencies.setIncludePaths({root / "first", root / "second"});
+    auto const scanned = dependencies.scanFile(shader);
+    check(scanned.exists, "scanned file exists");
+    check(scanned.includes.size() == 3 && scanned.includes[0] == ShaderDependencies::Normalise(local)
+              && scanned.includes[1] == ShaderDependencies::Normalise(secondOnly)
+              && scanned.includes[2] == ShaderDependencies::Normalise(root / "missing.hlsl"),
+        "include resolution relative to the including file");
+    check(!dependencies.scanFile(root / "other.comp").exists, "missing file");
+    ShaderDependencies pathDependencies;
+    pathDependencies.setIncludePaths({root / "second", root / "first"});
+    WriteFile(root / "nested" / "other.comp", "#include \"common.hlsl\"");
+    check(pathDependencies.scanFile(root / "nested" / "other.comp").includes
+              == vector {ShaderDependencies::Normalise(second)},
+        "include path order (second first)");
+    check(dependencies.scanFile(root / "nested" / "other.comp").includes
+              == vector {ShaderDependencies::Normalise(first)},
+        "include path order (first first)");
+
+    // Closures follow every resolved include once, even through cycles, and skip missing files
+    check(dependencies.getIncludeClosure(shader) == Normalised({shader, local, secondOnly, cycleA, cycleB}),
+        "include closure with cycle");
+    check(dependencies.getIncludeClosure(cycleB) == Normalised({cycleA, cycleB}), "closure of cycle");
+    check(dependencies.getProgramClosure(root / "shader") == dependencies.getIncludeClosure(shader),
+        "program closure");
+
+    // Dependents walk the include graph upwards through every level of nesting
+    auto const graph     = root / "graph";
+    auto const top       = graph / "top.comp";
+    auto const direct    = graph / "direct.comp";
+    auto const unrelated = graph / "unrelated.comp";
+    auto const mid       = graph / "mid.hlsl";
+    auto const leaf      = graph / "include" / "leaf.hlsl";
+    WriteFile(top, "#include \"mid.hlsl\"\n");
+    WriteFile(direct, "#include \"leaf.hlsl\"\n");
+    WriteFile(unrelated, "void main() {}\n");
+    WriteFile(mid, "#include \"leaf.hlsl\"\n");
+    WriteFile(leaf, "// leaf\n");
+    ShaderDependencies graphDependencies;
+    graphDependencies.setIncludePaths({graph / "include"});
+    for (auto const &file : ShaderDependencies::FindShaderFiles(graph))
+    {
+        graphDependencies.addFile(file, graphDependencies.scanFile(file));
+    }
+    check(graphDependencies.getDependents(leaf) == Normalised({leaf, mid, top, direct}),
+        "dependents through nested includes");
+    check(graphDependencies.getDependents(mid) == Normalised({mid, top}), "dependents of intermediate file");
+    check(graphDependencies.getDependents(unrelated) == Normalised({unrelated}), "dependents of program");
+    check(graphDependencies.updateModifiedFiles().empty(), "no modified files");
+
+    // Explicit write times are used so that the check does not depend on file system time granularity
+    auto const writeTime = filesystem::last_write_time(mid);
+    WriteFile(mid, "// no longer includes leaf\n");
+    filesystem::last_write_time(mid, writeTime + chrono::hours(1));
+    check(graphDependencies.updateModifiedFiles() == Normalised({mid}), "modified header reported");
+    check(graphDependencies.updateModifiedFiles().empty(), "modified header reported once");
+    check(graphDependencies.getDependents(leaf) == Normalised({leaf, direct}),
+        "dependents after modification");
+    filesystem::remove(leaf);
+    check(graphDependencies.updateModifiedFiles() == Normalised({leaf}), "deleted header reported");
+    check(graphDependencies.getIncludeClosure(direct) == Normalised({direct}), "closure after deletion");
+    check(graphDependencies.getDependents(leaf) == Normalised({leaf, direct}), "dependents after deletion");
+
+    // Unresolved includes are tracked at the including file's location and picked up once created there,
+    // whereas creating them within an include path changes resolution so requires the includer be rescanned
+    auto const later = graph / "later.hlsl";
+    auto const found = graph / "include" / "found.hlsl";
+    WriteFile(top, "#include \"later.hlsl\"\n#include \"found.hlsl\"\n");
+    filesystem::last_write_time(top, writeTime + chrono::hours(2));
+    check(graphDependencies.updateModifiedFiles() == Normalised({top}), "modified program reported");
+    check(graphDependencies.getIncludeClosure(top) == Normalised({top}), "closure with unresolved includes");
+    WriteFile(later, "// created later\n");
+    WriteFile(found, "// created later in include path\n");
+    check(graphDependencies.updateModifiedFiles() == Normalised({later}), "created include reported");
+    check(graphDependencies.getDependents(later) == Normalised({later, top}),
+        "dependents of created include");
+    check(graphDependencies.getIncludeClosure(top) == Normalised({top, later}),
+        "closure with created include");
+    graphDependencies.invalidate(top);
+    check(graphDependencies.getIncludeClosure(top) == Normalised({top, later, found}),
+        "closure after invalidation");
+    check(graphDependencies.getDependents(found) == Normalised({found, top}),
+        "dependents after invalidation");
+
+    // Keys are stable for identical sources wherever the tree is located and change with every input
+    auto const treeA = root / "tree_a";
+    auto const treeB = root / "tree_b";
+    for (auto const &tree : {treeA, treeB})
+    {
+        WriteFile(tree / "shader.comp", "#include \"header.hlsl\"\nvoid main() {}\n");
+        WriteFile(tree / "include" / "header.hlsl", "#define VALUE 1\n");
+    }
+    vector<string> const defines = {"A=1", "B"};
+    string const         key     = GetTreeKey(treeA, defines);
+    uint64_t const       hash    = ShaderDependencies().getHash({ShaderDependencies::Normalise(shader)});
+    check(key.size() == 16 && key.find_first_not_of("0123456789abcdef") == string::npos, "key format");
+    check(key == GetTreeKey(treeA, defines), "key stable between runs");
+    check(key == GetTreeKey(treeB, defines), "key independent of tree location");
+    check(key == GetTreeKey(treeA, {"B", "A=1"}), "key independent of define order");
+    check(key != GetTreeKey(treeA, {"A=2", "B"}), "key depends on define values");
+    check(key != GetTreeKey(treeA, {"A=1"}), "key depends on define count");
+    check(GetShaderCacheKey(hash, "main", {"AB", "C"}, "dxc")
+              != GetShaderCacheKey(hash, "main", {"A", "BC"}, "dxc"),
+        "key separates defines");
+    check(GetShaderCacheKey(hash, "main", defines, "dxc") != GetShaderCacheKey(hash, "other", defines, "dxc"),
+        "key depends on entry point");
+    check(GetShaderCacheKey(hash, "main", defines, "dxc 1")
+              != GetShaderCacheKey(hash, "main", defines, "dxc 2"),
+        "key depends on compiler version");
+    check(GetShaderCacheKey(hash, "main", defines, "dxc")
+              != GetShaderCacheKey(hash + 1, "main", defines, "dxc"),
+        "key depends on source hash");
+    WriteFile(treeB / "include" / "header.hlsl", "#define VALUE 2\n");
+    check(key != GetTreeKey(treeB, defines), "key depends on included file contents");
+    WriteFile(treeB / "include" / "header.hlsl", "#define VALUE 1\n");
+    WriteFile(treeB / "shader.comp", "#include \"header.hlsl\"\nvoid main() { }\n");
+    check(key != GetTreeKey(treeB, defines), "key depends on source contents");
+
+    filesystem::remove_all(root);
+
+    printf("%u of %u ShaderDependencies tests passed\n", tests - failures, tests);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}